@@ -0,0 +1,495 @@
+//**************************************************************************
+//
+// Benchmarks.cpp
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+//
+// Micro-benchmarks of the hot paths of the data model C++ helper library:
+// boxing and unboxing, iteration, key and field lookup, method dispatch and
+// the translation between HRESULTs and exceptions.
+//
+// The library is driven through the in-memory fakes of FakeDataModel.h.  What
+// is measured is therefore the cost of the library itself (and of the COM
+// calls it makes) and not that of a debugger's data model.  Numbers are only
+// meaningful relative to each other and to earlier runs on the same machine.
+//
+// Usage:
+//
+//     DbgModelClientExBenchmarks [filter]
+//
+//     Runs every benchmark whose name contains filter (all of them if no filter
+//     is given) and prints the best time per operation of several runs.
+//
+//**************************************************************************
+
+#include "FakeDataModel.h"
+#include <DbgModelClientEx.h>
+
+#include <cstdio>
+#include <cwchar>
+#include <exception>
+#include <stdexcept>
+
+namespace ClientEx = Debugger::DataModel::ClientEx;
+
+//
+// ClientEx brings Microsoft::WRL into scope with it.  Both have a Details namespace, so the library's is always
+// named as ClientEx::Details here.
+//
+using namespace ClientEx;
+
+namespace Benchmarks
+{
+
+ComPtr<IDataModelManager> g_spManager;
+ComPtr<IDebugHost> g_spHost;
+
+// g_sink:
+//
+// Every benchmark folds something from each operation into here so that the compiler cannot discard the work.
+//
+volatile ULONG64 g_sink = 0;
+
+// BenchmarkRunner:
+//
+// Times a loop of operations.  The iteration count is calibrated so that a run takes roughly RunTarget and the
+// best of RunCount runs is reported.
+//
+class BenchmarkRunner
+{
+public:
+
+    BenchmarkRunner(_In_opt_z_ const wchar_t *pFilter) :
+        m_pFilter(pFilter)
+    {
+        QueryPerformanceFrequency(&m_frequency);
+    }
+
+    // Run():
+    //
+    // Runs body(iterations), where each iteration performs opsPerIteration operations, and prints the time per
+    // operation.
+    //
+    template<typename TBody>
+    void Run(_In_z_ const wchar_t *pName, _In_ size_t opsPerIteration, _In_ const TBody& body)
+    {
+        if (m_pFilter != nullptr && wcsstr(pName, m_pFilter) == nullptr)
+        {
+            return;
+        }
+
+        //
+        // Warm the paths (and any thread local pools) before calibrating.
+        //
+        body(1);
+
+        size_t iterations = 1;
+        double elapsed = Time(body, iterations);
+        while (elapsed < CalibrationTarget && iterations < (static_cast<size_t>(1) << 30))
+        {
+            iterations *= 2;
+            elapsed = Time(body, iterations);
+        }
+
+        if (elapsed < RunTarget)
+        {
+            double scale = (elapsed > 0.0) ? (RunTarget / elapsed) : 1.0;
+            iterations = static_cast<size_t>(static_cast<double>(iterations) * scale) + 1;
+        }
+
+        double best = 0.0;
+        for (size_t i = 0; i < RunCount; ++i)
+        {
+            double runTime = Time(body, iterations);
+            if (i == 0 || runTime < best)
+            {
+                best = runTime;
+            }
+        }
+
+        double nsPerOp = (best * 1e9) / (static_cast<double>(iterations) * static_cast<double>(opsPerIteration));
+        wprintf(L"%-60s %12.1f ns/op\n", pName, nsPerOp);
+    }
+
+private:
+
+    static constexpr double CalibrationTarget = 0.05;
+    static constexpr double RunTarget = 0.25;
+    static constexpr size_t RunCount = 5;
+
+    template<typename TBody>
+    double Time(_In_ const TBody& body, _In_ size_t iterations)
+    {
+        LARGE_INTEGER start;
+        LARGE_INTEGER end;
+        QueryPerformanceCounter(&start);
+        body(iterations);
+        QueryPerformanceCounter(&end);
+        return static_cast<double>(end.QuadPart - start.QuadPart) / static_cast<double>(m_frequency.QuadPart);
+    }
+
+    const wchar_t *m_pFilter;
+    LARGE_INTEGER m_frequency;
+};
+
+//*************************************************
+// Boxing:
+//
+
+void BenchmarkBoxing(_In_ BenchmarkRunner& runner)
+{
+    runner.Run(L"BoxObject<int>", 1, [](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Object boxed = BoxObject(static_cast<int>(i));
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(boxed.GetObject());
+        }
+    });
+
+    runner.Run(L"BoxObject<ULONG64>", 1, [](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Object boxed = BoxObject(static_cast<ULONG64>(i));
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(boxed.GetObject());
+        }
+    });
+
+    runner.Run(L"BoxObject<std::wstring> (32 characters)", 1, [](size_t iterations)
+    {
+        std::wstring str(32, L'x');
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Object boxed = BoxObject(str);
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(boxed.GetObject());
+        }
+    });
+
+    Object boxedInt = BoxObject(42);
+    runner.Run(L"UnboxObject<int>", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            g_sink = g_sink + static_cast<ULONG64>(UnboxObject<int>(boxedInt));
+        }
+    });
+
+    Object boxedString = BoxObject(std::wstring(32, L'x'));
+    runner.Run(L"UnboxObject<std::wstring> (32 characters)", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            g_sink = g_sink + UnboxObject<std::wstring>(boxedString).size();
+        }
+    });
+}
+
+//*************************************************
+// Iteration:
+//
+
+void BenchmarkIteration(_In_ BenchmarkRunner& runner)
+{
+    constexpr size_t ElementCount = 1024;
+
+    std::vector<int> values(ElementCount);
+    for (size_t i = 0; i < ElementCount; ++i)
+    {
+        values[i] = static_cast<int>(i);
+    }
+
+    //
+    // A boxed std::vector is a synthetic object with a BoundIterable over the vector.  Iterating it through
+    // ObjectIterator measures ObjectIterator on top of the BoundIterator projection and element boxing.
+    //
+    Object boxedVector = BoxObject(values);
+    runner.Run(L"ObjectIterator over boxed std::vector<int> (per element)", ElementCount, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            for (const Object& element : boxedVector)
+            {
+                g_sink = g_sink + reinterpret_cast<ULONG_PTR>(element.GetObject());
+            }
+        }
+    });
+
+    runner.Run(L"ObjectIterator over boxed std::vector<int> with unbox (per element)", ElementCount, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            for (const Object& element : boxedVector)
+            {
+                g_sink = g_sink + static_cast<ULONG64>(UnboxObject<int>(element));
+            }
+        }
+    });
+
+    //
+    // The same iteration through the COM ABI: this is the BoundIterable / BoundIterator projection alone, without
+    // ObjectIterator.
+    //
+    runner.Run(L"BoundIterable projection via IModelIterator::GetNext (per element)", ElementCount, [&](size_t iterations)
+    {
+        ComPtr<IIterableConcept> spIterable;
+        CheckHr(boxedVector->GetConcept(__uuidof(IIterableConcept), &spIterable, nullptr));
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            ComPtr<IModelIterator> spIterator;
+            CheckHr(spIterable->GetIterator(boxedVector, &spIterator));
+            for (;;)
+            {
+                ComPtr<IModelObject> spElement;
+                if (FAILED(spIterator->GetNext(&spElement, 0, nullptr, nullptr)))
+                {
+                    break;
+                }
+                g_sink = g_sink + reinterpret_cast<ULONG_PTR>(spElement.Get());
+            }
+        }
+    });
+
+    runner.Run(L"Object::Slice(512, 16) of boxed std::vector<int>", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            g_sink = g_sink + boxedVector.Slice(512, 16).size();
+        }
+    });
+}
+
+//*************************************************
+// Key and Field Lookup:
+//
+
+void BenchmarkLookup(_In_ BenchmarkRunner& runner)
+{
+    constexpr size_t KeyCount = 16;
+
+    Object instance = Object::Create(HostContext());
+    ComPtr<Fakes::FakeModelObject> spFields = Make<Fakes::FakeModelObject>(ObjectTargetObject, nullptr, nullptr);
+    for (size_t i = 0; i < KeyCount; ++i)
+    {
+        std::wstring name = L"Key" + std::to_wstring(i);
+        Object value = BoxObject(static_cast<int>(i));
+        CheckHr(instance->SetKey(name.c_str(), value, nullptr));
+
+        std::wstring fieldName = L"Field" + std::to_wstring(i);
+        spFields->AddField(fieldName.c_str(), value);
+    }
+    Object fields(spFields.Get());
+
+    runner.Run(L"Object::KeyValue (16 keys, last key)", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Object value = instance.KeyValue(L"Key15");
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(value.GetObject());
+        }
+    });
+
+    runner.Run(L"Object::TryGetKeyValue (16 keys, missing key)", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            g_sink = g_sink + (instance.TryGetKeyValue(L"Missing").has_value() ? 1 : 0);
+        }
+    });
+
+    runner.Run(L"Object::FieldValue (16 fields, last field)", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Object value = fields.FieldValue(L"Field15");
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(value.GetObject());
+        }
+    });
+
+    //
+    // A key whose value is a boxed property: this measures BoxedProperty::GetValue dispatch (the accessor call
+    // scope and boxing of the result) under Object::KeyValue.
+    //
+    Object property = ClientEx::Details::BoxProperty([](const Object& /*instanceObject*/) { return 42; });
+    CheckHr(instance->SetKey(L"Property", property, nullptr));
+    runner.Run(L"Object::KeyValue of a boxed property", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Object value = instance.KeyValue(L"Property");
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(value.GetObject());
+        }
+    });
+}
+
+//*************************************************
+// Method Dispatch:
+//
+
+void BenchmarkDispatch(_In_ BenchmarkRunner& runner)
+{
+    Object instance = Object::Create(HostContext());
+    Object method = ClientEx::Details::BoxMethod([](const Object& /*contextObject*/, int x, int y) { return x + y; });
+
+    runner.Run(L"Object::Call of a boxed method (2 int arguments)", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Object result = method.Call(instance, 1, static_cast<int>(i));
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(result.GetObject());
+        }
+    });
+
+    //
+    // The same call with the arguments boxed once up front: this is BoxedMethod::Call dispatch (unboxing of the
+    // arguments, the call and boxing of the result) alone.
+    //
+    Object arg1 = BoxObject(1);
+    Object arg2 = BoxObject(2);
+    IModelObject *pArguments[] = { arg1, arg2 };
+    IModelMethod *pMethod = method.As<IModelMethod *>();
+    runner.Run(L"IModelMethod::Call of a boxed method (2 prepacked arguments)", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            ComPtr<IModelObject> spResult;
+            CheckHr(pMethod->Call(instance, ARRAYSIZE(pArguments), pArguments, &spResult, nullptr));
+            g_sink = g_sink + reinterpret_cast<ULONG_PTR>(spResult.Get());
+        }
+    });
+}
+
+//*************************************************
+// Error Translation:
+//
+
+void BenchmarkErrors(_In_ BenchmarkRunner& runner)
+{
+    runner.Run(L"Exceptions::ThrowHr (E_INVALIDARG) and catch", 1, [](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            try
+            {
+                ClientEx::Details::Exceptions::ThrowHr(E_INVALIDARG);
+            }
+            catch(const std::invalid_argument&)
+            {
+                g_sink = g_sink + 1;
+            }
+        }
+    });
+
+    Object errorObject;
+    {
+        ComPtr<IModelObject> spError;
+        CheckHr(g_spManager->CreateErrorObject(E_FAIL, L"Benchmark error", &spError));
+        errorObject = Object(std::move(spError));
+    }
+
+    runner.Run(L"Exceptions::ThrowHr (E_FAIL with error object) and catch", 1, [&](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            try
+            {
+                ClientEx::Details::Exceptions::ThrowHr(E_FAIL, errorObject);
+            }
+            catch(const std::exception&)
+            {
+                g_sink = g_sink + 1;
+            }
+        }
+    });
+
+    runner.Run(L"Exceptions::ReturnResult (std::invalid_argument)", 1, [](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            try
+            {
+                throw std::invalid_argument("Benchmark error");
+            }
+            catch(...)
+            {
+                g_sink = g_sink + static_cast<ULONG64>(ClientEx::Details::Exceptions::ReturnResult(std::current_exception()));
+            }
+        }
+    });
+
+    runner.Run(L"Exceptions::ReturnResult (std::invalid_argument with error object)", 1, [](size_t iterations)
+    {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            try
+            {
+                throw std::invalid_argument("Benchmark error");
+            }
+            catch(...)
+            {
+                ComPtr<IModelObject> spError;
+                g_sink = g_sink + static_cast<ULONG64>(ClientEx::Details::Exceptions::ReturnResult(std::current_exception(), &spError));
+                g_sink = g_sink + reinterpret_cast<ULONG_PTR>(spError.Get());
+            }
+        }
+    });
+}
+
+} // Benchmarks
+
+//**************************************************************************
+// Client Provided:
+//
+// The library acquires the data model manager and the host through these.  Here, they are the fakes.
+//
+
+namespace Debugger::DataModel::ClientEx
+{
+    IDataModelManager *GetManager()
+    {
+        return Benchmarks::g_spManager.Get();
+    }
+
+    IDebugHost *GetHost()
+    {
+        return Benchmarks::g_spHost.Get();
+    }
+}
+
+int __cdecl wmain(_In_ int argc, _In_reads_(argc) wchar_t **argv)
+{
+    using namespace Benchmarks;
+
+    ComPtr<Fakes::FakeDataModelManager> spManager = Make<Fakes::FakeDataModelManager>();
+    ComPtr<Fakes::FakeDebugHost> spHost = Make<Fakes::FakeDebugHost>();
+    if (spManager == nullptr || FAILED(spManager->InitializationResult()) || spHost == nullptr)
+    {
+        fwprintf(stderr, L"Unable to create the fake data model\n");
+        return 1;
+    }
+
+    g_spManager = spManager;
+    g_spHost = spHost;
+
+    int result = 0;
+    try
+    {
+        BenchmarkRunner runner(argc > 1 ? argv[1] : nullptr);
+        BenchmarkBoxing(runner);
+        BenchmarkIteration(runner);
+        BenchmarkLookup(runner);
+        BenchmarkDispatch(runner);
+        BenchmarkErrors(runner);
+    }
+    catch(const std::exception& ex)
+    {
+        fprintf(stderr, "Benchmark failed: %s\n", ex.what());
+        result = 1;
+    }
+
+    g_spManager->Close();
+    g_spHost = nullptr;
+    g_spManager = nullptr;
+    return result;
+}
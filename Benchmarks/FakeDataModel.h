@@ -0,0 +1,865 @@
+//**************************************************************************
+//
+// FakeDataModel.h
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+//
+// In-memory implementations of IDataModelManager, IDebugHost, IDebugHostContext and
+// IModelObject which are sufficient to drive the ClientEx / ProviderEx hot paths
+// without a debugger.
+//
+// NOTES:
+//
+//     These are not a data model.  They implement the methods which the benchmarked
+//     paths of the library call (key, field, concept and parent model storage and
+//     intrinsic values) and return E_NOTIMPL for everything else.  Nothing here
+//     touches a target: there are no types, locations or symbols.
+//
+//**************************************************************************
+
+#pragma once
+
+#ifndef _FAKEDATAMODEL_H_
+#define _FAKEDATAMODEL_H_
+
+#include <windows.h>
+#include <oleauto.h>
+#include <wrl/client.h>
+#include <wrl/implements.h>
+#include <DbgModel.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace Benchmarks
+{
+namespace Fakes
+{
+
+using namespace Microsoft::WRL;
+
+// FakeHostContext:
+//
+// A host context which is equal only to itself.
+//
+class FakeHostContext :
+    public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        IDebugHostContext
+        >
+{
+public:
+
+    IFACEMETHOD(IsEqualTo)(_In_ IDebugHostContext *pContext, _Out_ bool *pIsEqual)
+    {
+        *pIsEqual = (pContext == static_cast<IDebugHostContext *>(this));
+        return S_OK;
+    }
+};
+
+// FakeModelObject:
+//
+// An object which stores an intrinsic value, keys, fields, concepts, parent models and data model contexts.
+// Key and concept lookups search the object and then its parent models in order, as the data model does.  A key
+// whose value is a property accessor is resolved through the accessor by GetKeyValue / SetKeyValue.
+//
+class FakeModelObject :
+    public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        IModelObject
+        >
+{
+public:
+
+    FakeModelObject(_In_ ModelObjectKind kind, _In_opt_ const VARIANT *pValue, _In_opt_ IDebugHostContext *pContext) :
+        m_kind(kind),
+        m_spContext(pContext)
+    {
+        VariantInit(&m_value);
+        if (pValue != nullptr)
+        {
+            m_hrInit = VariantCopy(&m_value, pValue);
+        }
+    }
+
+    ~FakeModelObject()
+    {
+        VariantClear(&m_value);
+    }
+
+    // InitializationResult():
+    //
+    // Returns the result of copying the intrinsic value into the object.
+    //
+    HRESULT InitializationResult() const
+    {
+        return m_hrInit;
+    }
+
+    // AddField():
+    //
+    // Adds a "native field" which GetRawValue(SymbolField, ...) returns.
+    //
+    void AddField(_In_z_ const wchar_t *pFieldName, _In_ IModelObject *pFieldValue)
+    {
+        m_fields.emplace_back(pFieldName, pFieldValue);
+    }
+
+    //*************************************************
+    // IModelObject:
+    //
+
+    IFACEMETHOD(GetContext)(_COM_Outptr_result_maybenull_ IDebugHostContext **ppContext)
+    {
+        ComPtr<IDebugHostContext> spContext = m_spContext;
+        *ppContext = spContext.Detach();
+        return S_OK;
+    }
+
+    IFACEMETHOD(GetKind)(_Out_ ModelObjectKind *pKind)
+    {
+        *pKind = m_kind;
+        return S_OK;
+    }
+
+    IFACEMETHOD(GetIntrinsicValue)(_Out_ VARIANT *pIntrinsicData)
+    {
+        VariantInit(pIntrinsicData);
+        if (m_value.vt == VT_EMPTY)
+        {
+            return E_NOT_VALID_STATE;
+        }
+        return VariantCopy(pIntrinsicData, &m_value);
+    }
+
+    IFACEMETHOD(GetIntrinsicValueAs)(_In_ VARTYPE vt, _Out_ VARIANT *pIntrinsicData)
+    {
+        VariantInit(pIntrinsicData);
+        if (m_value.vt == VT_EMPTY)
+        {
+            return E_NOT_VALID_STATE;
+        }
+        return VariantChangeType(pIntrinsicData, &m_value, 0, vt);
+    }
+
+    IFACEMETHOD(GetKeyValue)(_In_ PCWSTR key,
+                             _COM_Outptr_result_maybenull_ IModelObject **ppObject,
+                             _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+    {
+        *ppObject = nullptr;
+        ComPtr<IModelObject> spValue;
+        HRESULT hr = GetKey(key, &spValue, ppMetadata);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        ComPtr<IModelPropertyAccessor> spAccessor;
+        if (IsPropertyAccessor(spValue.Get(), &spAccessor))
+        {
+            return spAccessor->GetValue(key, this, ppObject);
+        }
+
+        *ppObject = spValue.Detach();
+        return S_OK;
+    }
+
+    IFACEMETHOD(SetKeyValue)(_In_ PCWSTR key, _In_opt_ IModelObject *pObject)
+    {
+        ComPtr<IModelObject> spValue;
+        HRESULT hr = GetKey(key, &spValue, nullptr);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        ComPtr<IModelPropertyAccessor> spAccessor;
+        if (IsPropertyAccessor(spValue.Get(), &spAccessor))
+        {
+            return spAccessor->SetValue(key, this, pObject);
+        }
+
+        KeyEntry *pEntry = FindKey(key);
+        if (pEntry == nullptr)
+        {
+            return E_BOUNDS;
+        }
+        pEntry->Value = pObject;
+        return S_OK;
+    }
+
+    IFACEMETHOD(EnumerateKeyValues)(_COM_Outptr_ IKeyEnumerator **ppEnumerator)
+    {
+        *ppEnumerator = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetRawValue)(_In_ SymbolKind kind,
+                             _In_ PCWSTR name,
+                             _In_ ULONG /*searchFlags*/,
+                             _COM_Outptr_ IModelObject **ppObject)
+    {
+        *ppObject = nullptr;
+        if (kind != SymbolField)
+        {
+            return E_NOTIMPL;
+        }
+
+        for (auto&& field : m_fields)
+        {
+            if (field.first == name)
+            {
+                ComPtr<IModelObject> spValue = field.second;
+                *ppObject = spValue.Detach();
+                return S_OK;
+            }
+        }
+        return E_BOUNDS;
+    }
+
+    IFACEMETHOD(EnumerateRawValues)(_In_ SymbolKind /*kind*/, _In_ ULONG /*searchFlags*/, _COM_Outptr_ IRawEnumerator **ppEnumerator)
+    {
+        *ppEnumerator = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(Dereference)(_COM_Outptr_ IModelObject **ppObject)
+    {
+        *ppObject = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(TryCastToRuntimeType)(_COM_Outptr_ IModelObject **ppRuntimeTypedObject)
+    {
+        *ppRuntimeTypedObject = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetConcept)(_In_ REFIID conceptId,
+                            _COM_Outptr_ IUnknown **ppConceptInterface,
+                            _COM_Outptr_opt_result_maybenull_ IKeyStore **ppConceptMetadata)
+    {
+        *ppConceptInterface = nullptr;
+        if (ppConceptMetadata != nullptr)
+        {
+            *ppConceptMetadata = nullptr;
+        }
+
+        for (auto&& entry : m_concepts)
+        {
+            if (entry.Id == conceptId)
+            {
+                ComPtr<IUnknown> spConcept = entry.Interface;
+                *ppConceptInterface = spConcept.Detach();
+                if (ppConceptMetadata != nullptr)
+                {
+                    ComPtr<IKeyStore> spMetadata = entry.Metadata;
+                    *ppConceptMetadata = spMetadata.Detach();
+                }
+                return S_OK;
+            }
+        }
+
+        for (auto&& parent : m_parents)
+        {
+            if (SUCCEEDED(parent.Model->GetConcept(conceptId, ppConceptInterface, ppConceptMetadata)))
+            {
+                return S_OK;
+            }
+        }
+
+        return E_NOINTERFACE;
+    }
+
+    IFACEMETHOD(GetLocation)(_Out_ Location * /*pLocation*/)
+    {
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetTypeInfo)(_COM_Outptr_result_maybenull_ IDebugHostType **ppType)
+    {
+        *ppType = nullptr;
+        return S_OK;
+    }
+
+    IFACEMETHOD(GetTargetInfo)(_Out_ Location * /*pLocation*/, _COM_Outptr_ IDebugHostType **ppType)
+    {
+        *ppType = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetNumberOfParentModels)(_Out_ ULONG64 *pNumModels)
+    {
+        *pNumModels = static_cast<ULONG64>(m_parents.size());
+        return S_OK;
+    }
+
+    IFACEMETHOD(GetParentModel)(_In_ ULONG64 i,
+                                _COM_Outptr_ IModelObject **ppModel,
+                                _COM_Outptr_result_maybenull_ IModelObject **ppContextObject)
+    {
+        *ppModel = nullptr;
+        *ppContextObject = nullptr;
+        if (i >= m_parents.size())
+        {
+            return E_BOUNDS;
+        }
+
+        ComPtr<IModelObject> spModel = m_parents[static_cast<size_t>(i)].Model;
+        ComPtr<IModelObject> spContextObject = m_parents[static_cast<size_t>(i)].ContextObject;
+        *ppModel = spModel.Detach();
+        *ppContextObject = spContextObject.Detach();
+        return S_OK;
+    }
+
+    IFACEMETHOD(AddParentModel)(_In_ IModelObject *pModel, _In_opt_ IModelObject *pContextObject, _In_ bool isOverride)
+    {
+        ParentEntry entry { pModel, pContextObject };
+        if (isOverride)
+        {
+            m_parents.insert(m_parents.begin(), std::move(entry));
+        }
+        else
+        {
+            m_parents.push_back(std::move(entry));
+        }
+        return S_OK;
+    }
+
+    IFACEMETHOD(RemoveParentModel)(_In_ IModelObject *pModel)
+    {
+        for (auto it = m_parents.begin(); it != m_parents.end(); ++it)
+        {
+            if (it->Model.Get() == pModel)
+            {
+                m_parents.erase(it);
+                return S_OK;
+            }
+        }
+        return E_BOUNDS;
+    }
+
+    IFACEMETHOD(GetKey)(_In_ PCWSTR key,
+                        _COM_Outptr_result_maybenull_ IModelObject **ppObject,
+                        _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+    {
+        *ppObject = nullptr;
+        if (ppMetadata != nullptr)
+        {
+            *ppMetadata = nullptr;
+        }
+
+        KeyEntry *pEntry = FindKey(key);
+        if (pEntry != nullptr)
+        {
+            ComPtr<IModelObject> spValue = pEntry->Value;
+            *ppObject = spValue.Detach();
+            if (ppMetadata != nullptr)
+            {
+                ComPtr<IKeyStore> spMetadata = pEntry->Metadata;
+                *ppMetadata = spMetadata.Detach();
+            }
+            return S_OK;
+        }
+
+        for (auto&& parent : m_parents)
+        {
+            if (SUCCEEDED(parent.Model->GetKey(key, ppObject, ppMetadata)))
+            {
+                return S_OK;
+            }
+        }
+
+        return E_BOUNDS;
+    }
+
+    IFACEMETHOD(GetKeyReference)(_In_ PCWSTR /*key*/,
+                                 _COM_Outptr_result_maybenull_ IModelObject **ppObjectReference,
+                                 _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+    {
+        *ppObjectReference = nullptr;
+        if (ppMetadata != nullptr)
+        {
+            *ppMetadata = nullptr;
+        }
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(SetKey)(_In_ PCWSTR key, _In_opt_ IModelObject *pObject, _In_opt_ IKeyStore *pMetadata)
+    {
+        KeyEntry *pEntry = FindKey(key);
+        if (pEntry == nullptr)
+        {
+            m_keys.push_back(KeyEntry { key, pObject, pMetadata });
+        }
+        else
+        {
+            pEntry->Value = pObject;
+            pEntry->Metadata = pMetadata;
+        }
+        return S_OK;
+    }
+
+    IFACEMETHOD(ClearKeys)()
+    {
+        m_keys.clear();
+        return S_OK;
+    }
+
+    IFACEMETHOD(EnumerateKeys)(_COM_Outptr_ IKeyEnumerator **ppEnumerator)
+    {
+        *ppEnumerator = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(EnumerateKeyReferences)(_COM_Outptr_ IKeyEnumerator **ppEnumerator)
+    {
+        *ppEnumerator = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(SetConcept)(_In_ REFIID conceptId, _In_ IUnknown *pConceptInterface, _In_opt_ IKeyStore *pConceptMetadata)
+    {
+        for (auto&& entry : m_concepts)
+        {
+            if (entry.Id == conceptId)
+            {
+                entry.Interface = pConceptInterface;
+                entry.Metadata = pConceptMetadata;
+                return S_OK;
+            }
+        }
+
+        m_concepts.push_back(ConceptEntry { conceptId, pConceptInterface, pConceptMetadata });
+        return S_OK;
+    }
+
+    IFACEMETHOD(ClearConcepts)()
+    {
+        m_concepts.clear();
+        return S_OK;
+    }
+
+    IFACEMETHOD(GetRawReference)(_In_ SymbolKind /*kind*/,
+                                 _In_ PCWSTR /*name*/,
+                                 _In_ ULONG /*searchFlags*/,
+                                 _COM_Outptr_ IModelObject **ppObject)
+    {
+        *ppObject = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(EnumerateRawReferences)(_In_ SymbolKind /*kind*/, _In_ ULONG /*searchFlags*/, _COM_Outptr_ IRawEnumerator **ppEnumerator)
+    {
+        *ppEnumerator = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(SetContextForDataModel)(_In_ IModelObject *pDataModelObject, _In_ IUnknown *pContext)
+    {
+        for (auto&& entry : m_dataModelContexts)
+        {
+            if (entry.first.Get() == pDataModelObject)
+            {
+                entry.second = pContext;
+                return S_OK;
+            }
+        }
+
+        m_dataModelContexts.emplace_back(pDataModelObject, pContext);
+        return S_OK;
+    }
+
+    IFACEMETHOD(GetContextForDataModel)(_In_ IModelObject *pDataModelObject, _COM_Outptr_ IUnknown **ppContext)
+    {
+        *ppContext = nullptr;
+        for (auto&& entry : m_dataModelContexts)
+        {
+            if (entry.first.Get() == pDataModelObject)
+            {
+                ComPtr<IUnknown> spContext = entry.second;
+                *ppContext = spContext.Detach();
+                return S_OK;
+            }
+        }
+        return E_BOUNDS;
+    }
+
+    IFACEMETHOD(Compare)(_In_ IModelObject * /*pOther*/, _COM_Outptr_opt_result_maybenull_ IModelObject **ppResult)
+    {
+        if (ppResult != nullptr)
+        {
+            *ppResult = nullptr;
+        }
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(IsEqualTo)(_In_ IModelObject *pOther, _Out_ bool *pEqual)
+    {
+        *pEqual = (pOther == static_cast<IModelObject *>(this));
+        return S_OK;
+    }
+
+private:
+
+    struct KeyEntry
+    {
+        std::wstring Name;
+        ComPtr<IModelObject> Value;
+        ComPtr<IKeyStore> Metadata;
+    };
+
+    struct ConceptEntry
+    {
+        GUID Id;
+        ComPtr<IUnknown> Interface;
+        ComPtr<IKeyStore> Metadata;
+    };
+
+    struct ParentEntry
+    {
+        ComPtr<IModelObject> Model;
+        ComPtr<IModelObject> ContextObject;
+    };
+
+    KeyEntry *FindKey(_In_ PCWSTR key)
+    {
+        for (auto&& entry : m_keys)
+        {
+            if (entry.Name == key)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool IsPropertyAccessor(_In_ IModelObject *pValue, _COM_Outptr_result_maybenull_ IModelPropertyAccessor **ppAccessor)
+    {
+        *ppAccessor = nullptr;
+
+        ModelObjectKind kind;
+        if (pValue == nullptr || FAILED(pValue->GetKind(&kind)) || kind != ObjectPropertyAccessor)
+        {
+            return false;
+        }
+
+        VARIANT vtAccessor;
+        if (FAILED(pValue->GetIntrinsicValue(&vtAccessor)))
+        {
+            return false;
+        }
+
+        bool isAccessor = (vtAccessor.vt == VT_UNKNOWN && vtAccessor.punkVal != nullptr &&
+                           SUCCEEDED(vtAccessor.punkVal->QueryInterface(IID_PPV_ARGS(ppAccessor))));
+        VariantClear(&vtAccessor);
+        return isAccessor;
+    }
+
+    ModelObjectKind m_kind;
+    VARIANT m_value;
+    HRESULT m_hrInit = S_OK;
+    ComPtr<IDebugHostContext> m_spContext;
+    std::vector<KeyEntry> m_keys;
+    std::vector<std::pair<std::wstring, ComPtr<IModelObject>>> m_fields;
+    std::vector<ConceptEntry> m_concepts;
+    std::vector<ParentEntry> m_parents;
+    std::vector<std::pair<ComPtr<IModelObject>, ComPtr<IUnknown>>> m_dataModelContexts;
+};
+
+// CreateFakeObject():
+//
+// Creates a FakeModelObject of the given kind and intrinsic value.
+//
+inline HRESULT CreateFakeObject(_In_ ModelObjectKind kind,
+                                _In_opt_ const VARIANT *pValue,
+                                _In_opt_ IDebugHostContext *pContext,
+                                _COM_Outptr_ IModelObject **ppObject)
+{
+    *ppObject = nullptr;
+    ComPtr<FakeModelObject> spObject = Make<FakeModelObject>(kind, pValue, pContext);
+    if (spObject == nullptr)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    HRESULT hr = spObject->InitializationResult();
+    if (SUCCEEDED(hr))
+    {
+        *ppObject = spObject.Detach();
+    }
+    return hr;
+}
+
+// FakeDataModelManager:
+//
+// A manager which creates FakeModelObject instances and keeps a table of named models.  Everything which requires
+// type information (typed objects, type signatures) is not implemented.
+//
+class FakeDataModelManager :
+    public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        IDataModelManager
+        >
+{
+public:
+
+    FakeDataModelManager()
+    {
+        m_hrInit = CreateFakeObject(ObjectSynthetic, nullptr, nullptr, &m_spRootNamespace);
+    }
+
+    HRESULT InitializationResult() const
+    {
+        return m_hrInit;
+    }
+
+    //*************************************************
+    // IDataModelManager:
+    //
+
+    IFACEMETHOD(Close)()
+    {
+        m_namedModels.clear();
+        m_spRootNamespace = nullptr;
+        return S_OK;
+    }
+
+    IFACEMETHOD(CreateNoValue)(_COM_Outptr_ IModelObject **ppObject)
+    {
+        return CreateFakeObject(ObjectNoValue, nullptr, nullptr, ppObject);
+    }
+
+    IFACEMETHOD(CreateErrorObject)(_In_ HRESULT /*hrError*/, _In_opt_ PCWSTR pwszMessage, _COM_Outptr_ IModelObject **ppObject)
+    {
+        *ppObject = nullptr;
+
+        VARIANT vtMessage;
+        vtMessage.vt = VT_BSTR;
+        vtMessage.bstrVal = SysAllocString(pwszMessage != nullptr ? pwszMessage : L"");
+        if (vtMessage.bstrVal == nullptr)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        HRESULT hr = CreateFakeObject(ObjectError, &vtMessage, nullptr, ppObject);
+        VariantClear(&vtMessage);
+        return hr;
+    }
+
+    IFACEMETHOD(CreateTypedObject)(_In_opt_ IDebugHostContext * /*pContext*/,
+                                   _In_ Location /*objectLocation*/,
+                                   _In_ IDebugHostType * /*pObjectType*/,
+                                   _COM_Outptr_ IModelObject **ppObject)
+    {
+        *ppObject = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(CreateTypedObjectReference)(_In_opt_ IDebugHostContext * /*pContext*/,
+                                            _In_ Location /*objectLocation*/,
+                                            _In_ IDebugHostType * /*pObjectType*/,
+                                            _COM_Outptr_ IModelObject **ppObject)
+    {
+        *ppObject = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(CreateSyntheticObject)(_In_opt_ IDebugHostContext *pContext, _COM_Outptr_ IModelObject **ppObject)
+    {
+        return CreateFakeObject(ObjectSynthetic, nullptr, pContext, ppObject);
+    }
+
+    IFACEMETHOD(CreateDataModelObject)(_In_ IDataModelConcept *pDataModel, _COM_Outptr_ IModelObject **ppObject)
+    {
+        ComPtr<IModelObject> spObject;
+        HRESULT hr = CreateFakeObject(ObjectSynthetic, nullptr, nullptr, &spObject);
+        if (SUCCEEDED(hr))
+        {
+            hr = spObject->SetConcept(__uuidof(IDataModelConcept), pDataModel, nullptr);
+        }
+
+        *ppObject = SUCCEEDED(hr) ? spObject.Detach() : nullptr;
+        return hr;
+    }
+
+    IFACEMETHOD(CreateIntrinsicObject)(_In_ ModelObjectKind objectKind, _In_ VARIANT *pIntrinsicData, _COM_Outptr_ IModelObject **ppObject)
+    {
+        return CreateFakeObject(objectKind, pIntrinsicData, nullptr, ppObject);
+    }
+
+    IFACEMETHOD(CreateTypedIntrinsicObject)(_In_ VARIANT * /*pIntrinsicData*/, _In_ IDebugHostType * /*pType*/, _COM_Outptr_ IModelObject **ppObject)
+    {
+        *ppObject = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetModelForTypeSignature)(_In_ IDebugHostTypeSignature * /*pTypeSignature*/, _COM_Outptr_ IModelObject **ppDataModel)
+    {
+        *ppDataModel = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetModelForType)(_In_ IDebugHostType * /*pType*/,
+                                 _COM_Outptr_ IModelObject **ppDataModel,
+                                 _COM_Outptr_opt_ IDebugHostTypeSignature **ppTypeSignature,
+                                 _COM_Outptr_opt_ IDebugHostSymbolEnumerator **ppWildcardMatches)
+    {
+        *ppDataModel = nullptr;
+        if (ppTypeSignature != nullptr)
+        {
+            *ppTypeSignature = nullptr;
+        }
+        if (ppWildcardMatches != nullptr)
+        {
+            *ppWildcardMatches = nullptr;
+        }
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(RegisterModelForTypeSignature)(_In_ IDebugHostTypeSignature * /*pTypeSignature*/, _In_ IModelObject * /*pDataModel*/)
+    {
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(UnregisterModelForTypeSignature)(_In_ IModelObject * /*pDataModel*/, _In_opt_ IDebugHostTypeSignature * /*pTypeSignature*/)
+    {
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(RegisterExtensionForTypeSignature)(_In_ IDebugHostTypeSignature * /*pTypeSignature*/, _In_ IModelObject * /*pDataModel*/)
+    {
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(UnregisterExtensionForTypeSignature)(_In_ IModelObject * /*pDataModel*/, _In_opt_ IDebugHostTypeSignature * /*pTypeSignature*/)
+    {
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(CreateMetadataStore)(_In_opt_ IKeyStore * /*pParentStore*/, _COM_Outptr_ IKeyStore **ppMetadataStore)
+    {
+        *ppMetadataStore = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetRootNamespace)(_COM_Outptr_ IModelObject **ppRootNamespace)
+    {
+        ComPtr<IModelObject> spRootNamespace = m_spRootNamespace;
+        *ppRootNamespace = spRootNamespace.Detach();
+        return (*ppRootNamespace != nullptr) ? S_OK : E_UNEXPECTED;
+    }
+
+    IFACEMETHOD(RegisterNamedModel)(_In_ PCWSTR pModelName, _In_ IModelObject *pModelObject)
+    {
+        for (auto&& entry : m_namedModels)
+        {
+            if (entry.first == pModelName)
+            {
+                return E_INVALIDARG;
+            }
+        }
+
+        m_namedModels.emplace_back(pModelName, pModelObject);
+        return S_OK;
+    }
+
+    IFACEMETHOD(UnregisterNamedModel)(_In_ PCWSTR pModelName)
+    {
+        for (auto it = m_namedModels.begin(); it != m_namedModels.end(); ++it)
+        {
+            if (it->first == pModelName)
+            {
+                m_namedModels.erase(it);
+                return S_OK;
+            }
+        }
+        return E_BOUNDS;
+    }
+
+    IFACEMETHOD(AcquireNamedModel)(_In_ PCWSTR pModelName, _COM_Outptr_ IModelObject **ppModelObject)
+    {
+        *ppModelObject = nullptr;
+        for (auto&& entry : m_namedModels)
+        {
+            if (entry.first == pModelName)
+            {
+                ComPtr<IModelObject> spModel = entry.second;
+                *ppModelObject = spModel.Detach();
+                return S_OK;
+            }
+        }
+
+        //
+        // The data model hands out a placeholder for a model which has not yet been registered.  An empty
+        // synthetic object stands in for it here.
+        //
+        ComPtr<IModelObject> spModel;
+        HRESULT hr = CreateFakeObject(ObjectSynthetic, nullptr, nullptr, &spModel);
+        if (SUCCEEDED(hr))
+        {
+            m_namedModels.emplace_back(pModelName, spModel);
+            *ppModelObject = spModel.Detach();
+        }
+        return hr;
+    }
+
+private:
+
+    HRESULT m_hrInit;
+    ComPtr<IModelObject> m_spRootNamespace;
+    std::vector<std::pair<std::wstring, ComPtr<IModelObject>>> m_namedModels;
+};
+
+// FakeDebugHost:
+//
+// A host whose current context is a single FakeHostContext.  The host implements none of the optional host
+// interfaces (symbols, memory, evaluation); paths which query for them fail.
+//
+class FakeDebugHost :
+    public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        IDebugHost
+        >
+{
+public:
+
+    FakeDebugHost() :
+        m_spContext(Make<FakeHostContext>())
+    {
+    }
+
+    //*************************************************
+    // IDebugHost:
+    //
+
+    IFACEMETHOD(GetHostDefinedInterface)(_COM_Outptr_ IUnknown **ppHostUnk)
+    {
+        *ppHostUnk = nullptr;
+        return E_NOTIMPL;
+    }
+
+    IFACEMETHOD(GetCurrentContext)(_COM_Outptr_ IDebugHostContext **ppContext)
+    {
+        ComPtr<IDebugHostContext> spContext = m_spContext;
+        *ppContext = spContext.Detach();
+        return (*ppContext != nullptr) ? S_OK : E_OUTOFMEMORY;
+    }
+
+    IFACEMETHOD(GetDefaultMetadata)(_COM_Outptr_ IKeyStore **ppDefaultMetadataStore)
+    {
+        *ppDefaultMetadataStore = nullptr;
+        return E_NOTIMPL;
+    }
+
+private:
+
+    ComPtr<IDebugHostContext> m_spContext;
+};
+
+} // Fakes
+} // Benchmarks
+
+#endif // _FAKEDATAMODEL_H_
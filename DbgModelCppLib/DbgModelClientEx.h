@@ -23,12 +23,31 @@
 #define _DBGMODELCLIENTEX_H_
 
 #include <memory>
+#include <algorithm>
 #include <type_traits>
 #include <functional>
 #include <utility>
 #include <locale>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <typeinfo>
+#if _HAS_CXX20
+#include <span>
+#endif // _HAS_CXX20
+#ifdef DBGMODELCLIENTEX_TRACELOGGING
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+#endif // DBGMODELCLIENTEX_TRACELOGGING
 
 #ifdef GetObject
 #undef GetObject
@@ -72,6 +91,15 @@ IDataModelManager *GetManager();
 //
 IDebugHost *GetHost();
 
+#ifdef DBGMODELCLIENTEX_TRACELOGGING
+// GetTraceLoggingProvider():
+//
+// Gets the (registered) TraceLogging provider through which the library writes its events.  This is only required
+// if DBGMODELCLIENTEX_TRACELOGGING is defined.
+//
+TraceLoggingHProvider GetTraceLoggingProvider();
+#endif // DBGMODELCLIENTEX_TRACELOGGING
+
 //**************************************************************************
 // Exception Types:
 //
@@ -168,198 +196,724 @@ using bstr_ptr = std::unique_ptr<wchar_t, Details::BSTRDeleter>;
 
 using namespace Microsoft::WRL;
 
+// deferred_error:
+//
+// Base of the exceptions thrown for a failed HRESULT which came with a data model error object.  The error object
+// is held as is and is only converted to a message if what() is called.  Code which catches and discards such
+// exceptions never pays for formatting the message.
+//
+class deferred_error
+{
+public:
+
+    deferred_error(_In_ HRESULT hr, _In_ IModelObject *pError) : m_hr(hr), m_spError(pError) { }
+    HRESULT hr() const { return m_hr; }
+    IModelObject *error_object() const { return m_spError.Get(); }
+
+private:
+
+    HRESULT m_hr;
+    ComPtr<IModelObject> m_spError;
+
+};
+
+//**************************************************************************
+// Tracing:
+//
+// If DBGMODELCLIENTEX_TRACELOGGING is defined before including the header, the library emits TraceLogging events
+// through the provider returned by the client provided GetTraceLoggingProvider():
+//
+//     HResultFailure    : A failed HRESULT was converted to an exception (CheckHr or Exceptions::ThrowHr)
+//     ExceptionReturned : An exception was converted to an HRESULT returned from a data model callback (the type of
+//                         the exception is recorded)
+//     HostCall          : A call into the data model (GetNext, GetKeyValue, CreateTypedObject, etc...) along with
+//                         its result and latency
+//
+// Each event carries the model and accessor name of the bound property or method (if any) which is executing on
+// the calling thread.  Events are written at verbose level under the keywords below.  Unless a trace session has
+// enabled them, each instrumented site costs a single enabled check.  Without the macro, the instrumentation
+// compiles away entirely.
+//
+
 namespace Details
 {
-    // StringUtils:
-    //
-    // String helpers:
-    //
+#ifdef DBGMODELCLIENTEX_TRACELOGGING
 
-    struct StringUtils
+    struct Tracing
     {
-        static std::string GetNarrowString(_In_z_ const wchar_t *pString)
+        static constexpr ULONGLONG FailureKeyword = 0x1;
+        static constexpr ULONGLONG ExceptionKeyword = 0x2;
+        static constexpr ULONGLONG HostCallKeyword = 0x4;
+
+        // Attribution:
+        //
+        // The bound accessor which is executing on a thread.
+        //
+        struct Attribution
         {
-            std::string str;
-            int sz = WideCharToMultiByte(CP_ACP, 0, pString, static_cast<int>(wcslen(pString)), nullptr, 0, nullptr, nullptr);
-            if (sz == 0)
+            const wchar_t *ModelName;
+            const wchar_t *AccessorName;
+        };
+
+        // AccessorScope:
+        //
+        // Attributes the events written on this thread to a bound accessor for the duration of a call through it.
+        //
+        class AccessorScope
+        {
+        public:
+
+            AccessorScope(_In_opt_z_ const wchar_t *pModelName, _In_opt_z_ const wchar_t *pAccessorName) :
+                m_previous(Current())
             {
-                return str;
+                Current() = Attribution { pModelName, pAccessorName };
             }
-            str.resize(sz);
-            char *pData = const_cast<char *>(str.data()); // @TODO: C++17 should have a non-const overload
-            int sz2 = WideCharToMultiByte(CP_ACP, 0, pString, static_cast<int>(wcslen(pString)), pData, sz, nullptr, nullptr);
-            if (sz != sz2)
+
+            ~AccessorScope()
             {
-                throw unexpected_error();
+                Current() = m_previous;
             }
-            return str;
+
+            AccessorScope(_In_ const AccessorScope&) =delete;
+            AccessorScope& operator=(_In_ const AccessorScope&) =delete;
+
+        private:
+
+            Attribution m_previous;
+        };
+
+        // IsEnabled():
+        //
+        // Indicates whether a trace session is listening for events with the given keyword.
+        //
+        static bool IsEnabled(_In_ ULONGLONG keyword)
+        {
+            return TraceLoggingProviderEnabled(GetTraceLoggingProvider(), WINEVENT_LEVEL_VERBOSE, keyword);
         }
 
-        static std::wstring GetWideString(_In_z_ const char *pString)
+        // HResultFailure():
+        //
+        // Records a failed HRESULT which is about to be thrown as an exception.
+        //
+        static void HResultFailure(_In_ HRESULT hr, _In_ bool hasErrorObject)
         {
-            std::wstring str;
-            int sz = MultiByteToWideChar(CP_ACP, 0, pString, static_cast<int>(strlen(pString)), nullptr, 0);
-            if (sz == 0)
-            {
-                return str;
-            }
-            str.resize(sz);
-            wchar_t *pData = const_cast<wchar_t *>(str.data()); // @TODO: C++17 should have a non-const overload
-            int sz2 = MultiByteToWideChar(CP_ACP, 0, pString, static_cast<int>(strlen(pString)), pData, sz);
-            if (sz != sz2)
+            if (IsEnabled(FailureKeyword))
             {
-                throw unexpected_error();
+                const Attribution& attribution = Current();
+                TraceLoggingWrite(GetTraceLoggingProvider(),
+                                  "HResultFailure",
+                                  TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                  TraceLoggingKeyword(FailureKeyword),
+                                  TraceLoggingHResult(hr, "HResult"),
+                                  TraceLoggingBool(hasErrorObject, "HasErrorObject"),
+                                  TraceLoggingWideString(NameOf(attribution.ModelName), "ModelName"),
+                                  TraceLoggingWideString(NameOf(attribution.AccessorName), "AccessorName"));
             }
-            return str;
         }
-    };
-    // Exceptions:
-    //
-    // Exception helpers:
-    //
 
-    struct Exceptions
-    {
-        //*************************************************
-        // Conversion From HRESULT to Exception:
+        // ExceptionReturned():
         //
-
-        static void ThrowHr(_In_ HRESULT hr, _In_opt_ IModelObject *pError = nullptr)
+        // Records an exception which is being converted to an HRESULT.
+        //
+        static void ExceptionReturned(_In_ const std::exception_ptr& exception, _In_ HRESULT hr)
         {
-            std::string msg;
-
-            if (pError != nullptr)
+            if (IsEnabled(ExceptionKeyword))
             {
-                //
-                // If the data model produced a specific error message, pack it into the exception which
-                // is thrown.
-                //
-                BSTR bstrMsg;
-                bstr_ptr spMsg;
-
-                ComPtr<IStringDisplayableConcept> spStrConv;
-                if (SUCCEEDED(pError->GetConcept(__uuidof(IStringDisplayableConcept), &spStrConv, nullptr)) &&
-                    SUCCEEDED(spStrConv->ToDisplayString(pError, nullptr, &bstrMsg)))
+                const char *pExceptionType = "unknown";
+                try
+                {
+                    std::rethrow_exception(exception);
+                }
+                catch(std::exception& exc)
+                {
+                    pExceptionType = typeid(exc).name();
+                }
+                catch(...)
                 {
-                    spMsg.reset(bstrMsg);
-                    msg = StringUtils::GetNarrowString(reinterpret_cast<const wchar_t *>(bstrMsg));
                 }
+
+                const Attribution& attribution = Current();
+                TraceLoggingWrite(GetTraceLoggingProvider(),
+                                  "ExceptionReturned",
+                                  TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                  TraceLoggingKeyword(ExceptionKeyword),
+                                  TraceLoggingHResult(hr, "HResult"),
+                                  TraceLoggingString(pExceptionType, "ExceptionType"),
+                                  TraceLoggingWideString(NameOf(attribution.ModelName), "ModelName"),
+                                  TraceLoggingWideString(NameOf(attribution.AccessorName), "AccessorName"));
             }
+        }
 
-            switch(hr)
+        // HostCall():
+        //
+        // Makes a call into the data model (given as a functor returning HRESULT) and records its result and latency.
+        //
+        template<typename TCall>
+        static HRESULT HostCall(_In_z_ const char *pOperation, _In_ TCall&& call)
+        {
+            if (!IsEnabled(HostCallKeyword))
             {
-                case E_INVALIDARG:
-                case DISP_E_TYPEMISMATCH:
-                    throw std::invalid_argument(msg);
+                return call();
+            }
 
-                case E_OUTOFMEMORY:
-                    throw std::bad_alloc();
+            LARGE_INTEGER start;
+            LARGE_INTEGER end;
+            QueryPerformanceCounter(&start);
+            HRESULT hr = call();
+            QueryPerformanceCounter(&end);
+
+            const Attribution& attribution = Current();
+            TraceLoggingWrite(GetTraceLoggingProvider(),
+                              "HostCall",
+                              TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                              TraceLoggingKeyword(HostCallKeyword),
+                              TraceLoggingString(pOperation, "Operation"),
+                              TraceLoggingHResult(hr, "HResult"),
+                              TraceLoggingUInt64(ElapsedMicroseconds(start, end), "DurationMicroseconds"),
+                              TraceLoggingWideString(NameOf(attribution.ModelName), "ModelName"),
+                              TraceLoggingWideString(NameOf(attribution.AccessorName), "AccessorName"));
+            return hr;
+        }
 
-                case E_BOUNDS:
-                    throw std::range_error(msg);
+    private:
 
-                case E_NOTIMPL:
-                    throw not_implemented(msg);
+        static Attribution& Current()
+        {
+            thread_local Attribution s_current { nullptr, nullptr };
+            return s_current;
+        }
 
-                case E_UNEXPECTED:
-                    throw unexpected_error(msg);
+        static const wchar_t *NameOf(_In_opt_z_ const wchar_t *pName)
+        {
+            return pName != nullptr ? pName : L"";
+        }
 
-                case E_ILLEGAL_METHOD_CALL:
-                    throw illegal_operation(msg);
+        static ULONG64 ElapsedMicroseconds(_In_ const LARGE_INTEGER& start, _In_ const LARGE_INTEGER& end)
+        {
+            static const ULONG64 s_frequency = []()
+            {
+                LARGE_INTEGER frequency;
+                QueryPerformanceFrequency(&frequency);
+                return static_cast<ULONG64>(frequency.QuadPart);
+            }();
+            return static_cast<ULONG64>(end.QuadPart - start.QuadPart) * 1000000 / s_frequency;
+        }
+    };
 
-                case E_NOT_SET:
-                    throw not_set(msg);
+#else
 
-                default:
-                    throw hr_exception(hr, msg);
-            }
+    struct Tracing
+    {
+        class AccessorScope
+        {
+        public:
+
+            AccessorScope(_In_opt_z_ const wchar_t * /*pModelName*/, _In_opt_z_ const wchar_t * /*pAccessorName*/) { }
+
+            AccessorScope(_In_ const AccessorScope&) =delete;
+            AccessorScope& operator=(_In_ const AccessorScope&) =delete;
+        };
+
+        static void HResultFailure(_In_ HRESULT /*hr*/, _In_ bool /*hasErrorObject*/) { }
+        static void ExceptionReturned(_In_ const std::exception_ptr& /*exception*/, _In_ HRESULT /*hr*/) { }
+
+        template<typename TCall>
+        static HRESULT HostCall(_In_z_ const char * /*pOperation*/, _In_ TCall&& call)
+        {
+            return call();
         }
+    };
 
-        //*************************************************
-        // Conversion From Exception to HRESULT
-        //
+#endif // DBGMODELCLIENTEX_TRACELOGGING
+}
 
-        static HRESULT ReturnResult(_In_ const std::exception_ptr& exception, _COM_Errorptr_opt_ IModelObject **ppError = nullptr)
+namespace Details
+{
+    // StringUtils:
+    //
+    // String helpers:
+    //
+    // Conversions between narrow and wide strings are done in the code page given by DefaultCodePage unless one is
+    // explicitly passed.  This is the ANSI code page unless DBGMODELCLIENTEX_UTF8_STRINGS is defined, in which case
+    // narrow strings (including std::string boxing and exception messages) are treated as UTF-8.
+    //
+
+    struct StringUtils
+    {
+#ifdef DBGMODELCLIENTEX_UTF8_STRINGS
+        static constexpr UINT DefaultCodePage = CP_UTF8;
+#else
+        static constexpr UINT DefaultCodePage = CP_ACP;
+#endif // DBGMODELCLIENTEX_UTF8_STRINGS
+
+        // IsAscii():
+        //
+        // Returns whether the string consists solely of 7-bit ASCII.  Such strings convert identically in every
+        // code page we use and bypass the Win32 conversion APIs.  The check is done a machine word at a time.
+        //
+        static bool IsAscii(_In_reads_(length) const char *pString, _In_ size_t length)
         {
-            HRESULT hr = E_FAIL;
-            std::wstring errMsg;
-            try
-            {
-                std::rethrow_exception(exception);
-            }
-            catch(std::invalid_argument& invalidArg)
-            {
-                hr = E_INVALIDARG;
-                errMsg = StringUtils::GetWideString(invalidArg.what());
-            }
-            catch(std::bad_alloc& /*badAlloc*/)
+            const char *pEnd = pString + length;
+            for (; pEnd - pString >= static_cast<ptrdiff_t>(sizeof(unsigned __int64)); pString += sizeof(unsigned __int64))
             {
-                hr = E_OUTOFMEMORY;
+                unsigned __int64 chunk;
+                memcpy(&chunk, pString, sizeof(chunk));
+                if ((chunk & 0x8080808080808080ull) != 0)
+                {
+                    return false;
+                }
             }
-            catch(std::range_error& rangeError)
+
+            for (; pString < pEnd; ++pString)
             {
-                hr = E_BOUNDS;
-                errMsg = StringUtils::GetWideString(rangeError.what());
+                if ((static_cast<unsigned char>(*pString) & 0x80) != 0)
+                {
+                    return false;
+                }
             }
-            catch(not_implemented& notImplemented)
+
+            return true;
+        }
+
+        static bool IsAscii(_In_reads_(length) const wchar_t *pString, _In_ size_t length)
+        {
+            const wchar_t *pEnd = pString + length;
+            const size_t charsPerChunk = sizeof(unsigned __int64) / sizeof(wchar_t);
+            for (; static_cast<size_t>(pEnd - pString) >= charsPerChunk; pString += charsPerChunk)
             {
-                hr = E_NOTIMPL;
-                errMsg = StringUtils::GetWideString(notImplemented.what());
+                unsigned __int64 chunk;
+                memcpy(&chunk, pString, sizeof(chunk));
+                if ((chunk & 0xFF80FF80FF80FF80ull) != 0)
+                {
+                    return false;
+                }
             }
-            catch(unexpected_error& unexpectedError)
+
+            for (; pString < pEnd; ++pString)
             {
-                hr = E_UNEXPECTED;
-                errMsg = StringUtils::GetWideString(unexpectedError.what());
+                if ((*pString & 0xFF80) != 0)
+                {
+                    return false;
+                }
             }
-            catch(hr_exception& hrError)
+
+            return true;
+        }
+
+        // GetNarrowString():
+        //
+        // Converts a wide string to a narrow string in the given code page.
+        //
+        static std::string GetNarrowString(_In_reads_(length) const wchar_t *pString, _In_ size_t length, _In_ UINT codePage)
+        {
+            std::string str;
+            if (length == 0)
             {
-                hr = hrError.hr();
-                errMsg = StringUtils::GetWideString(hrError.what());
+                return str;
             }
-            catch(illegal_operation& illegalOperation)
+
+            if (IsAscii(pString, length))
             {
-                hr = E_ILLEGAL_METHOD_CALL;
-                errMsg = StringUtils::GetWideString(illegalOperation.what());
+                str.resize(length);
+                for (size_t i = 0; i < length; ++i)
+                {
+                    str[i] = static_cast<char>(pString[i]);
+                }
+                return str;
             }
-            catch(not_set& notSet)
+
+            int srcLength = CheckedLength(length);
+
+            //
+            // Most strings fit into a small stack buffer.  Try a single conversion into that before falling back to
+            // sizing the output.
+            //
+            char buffer[256];
+            int sz = WideCharToMultiByte(codePage, 0, pString, srcLength, buffer, ARRAYSIZE(buffer), nullptr, nullptr);
+            if (sz != 0)
             {
-                hr = E_NOT_SET;
-                errMsg = StringUtils::GetWideString(notSet.what());
+                str.assign(buffer, sz);
+                return str;
             }
-            catch(std::exception& exc)
+
+            sz = WideCharToMultiByte(codePage, 0, pString, srcLength, nullptr, 0, nullptr, nullptr);
+            if (sz == 0)
             {
-                hr = E_FAIL;
-                errMsg = StringUtils::GetWideString(exc.what());
+                return str;
             }
-            catch(...)
+            str.resize(sz);
+            int sz2 = WideCharToMultiByte(codePage, 0, pString, srcLength, str.data(), sz, nullptr, nullptr);
+            if (sz != sz2)
             {
-                hr = E_FAIL;
+                throw unexpected_error();
             }
+            return str;
+        }
 
-            if (ppError != nullptr && !errMsg.empty())
-            {
-                ComPtr<IModelObject> spError;
-                if (SUCCEEDED(GetManager()->CreateErrorObject(hr, errMsg.c_str(), &spError)))
-                {
-                    *ppError = spError.Detach();
-                }
-            }
+        static std::string GetNarrowString(_In_reads_(length) const wchar_t *pString, _In_ size_t length)
+        {
+            return GetNarrowString(pString, length, DefaultCodePage);
+        }
 
-            return hr;
+        static std::string GetNarrowString(_In_z_ const wchar_t *pString)
+        {
+            return GetNarrowString(pString, wcslen(pString), DefaultCodePage);
         }
-    };
-} // Details
 
-//**************************************************************************
-// Client Helpers:
-//
+        // GetUtf8String():
+        //
+        // Converts a wide string to UTF-8.
+        //
+        static std::string GetUtf8String(_In_reads_(length) const wchar_t *pString, _In_ size_t length)
+        {
+            return GetNarrowString(pString, length, CP_UTF8);
+        }
 
-// CheckHr():
-//
-// If the inpassed HRESULT indicates failure, this throws an exception based on the HRESULT
-//
-inline void CheckHr(_In_ HRESULT hr)
-{
+        static std::string GetUtf8String(_In_z_ const wchar_t *pString)
+        {
+            return GetNarrowString(pString, wcslen(pString), CP_UTF8);
+        }
+
+        // GetWideString():
+        //
+        // Converts a narrow string in the given code page to a wide string.
+        //
+        static std::wstring GetWideString(_In_reads_(length) const char *pString, _In_ size_t length, _In_ UINT codePage)
+        {
+            std::wstring str;
+            if (length == 0)
+            {
+                return str;
+            }
+
+            str.resize(length);
+            size_t sz = ConvertToWide(pString, length, codePage, str.data());
+            str.resize(sz);
+            return str;
+        }
+
+        static std::wstring GetWideString(_In_reads_(length) const char *pString, _In_ size_t length)
+        {
+            return GetWideString(pString, length, DefaultCodePage);
+        }
+
+        static std::wstring GetWideString(_In_z_ const char *pString)
+        {
+            return GetWideString(pString, strlen(pString), DefaultCodePage);
+        }
+
+        // GetWideStringFromUtf8():
+        //
+        // Converts a UTF-8 string to a wide string.
+        //
+        static std::wstring GetWideStringFromUtf8(_In_reads_(length) const char *pString, _In_ size_t length)
+        {
+            return GetWideString(pString, length, CP_UTF8);
+        }
+
+        static std::wstring GetWideStringFromUtf8(_In_z_ const char *pString)
+        {
+            return GetWideString(pString, strlen(pString), CP_UTF8);
+        }
+
+        // GetBstr():
+        //
+        // Converts a narrow string in the given code page directly into a newly allocated BSTR without going through
+        // an intermediate std::wstring.
+        //
+        static bstr_ptr GetBstr(_In_reads_(length) const char *pString, _In_ size_t length, _In_ UINT codePage = DefaultCodePage)
+        {
+            //
+            // A narrow string never produces more UTF-16 code units than it has bytes.
+            //
+            bstr_ptr spStr(SysAllocStringLen(nullptr, static_cast<UINT>(CheckedLength(length))));
+            if (spStr == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            size_t sz = ConvertToWide(pString, length, codePage, spStr.get());
+            if (sz != length)
+            {
+                BSTR bstrResized = SysAllocStringLen(spStr.get(), static_cast<UINT>(sz));
+                if (bstrResized == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+                spStr.reset(bstrResized);
+            }
+            return spStr;
+        }
+
+    private:
+
+        static int CheckedLength(_In_ size_t length)
+        {
+            if (length > static_cast<size_t>(INT_MAX))
+            {
+                throw std::invalid_argument("String is too long");
+            }
+            return static_cast<int>(length);
+        }
+
+        // ConvertToWide():
+        //
+        // Converts into a caller supplied buffer of at least 'length' wide characters and returns the number of
+        // characters written.
+        //
+        static size_t ConvertToWide(_In_reads_(length) const char *pString,
+                                    _In_ size_t length,
+                                    _In_ UINT codePage,
+                                    _Out_writes_to_(length, return) wchar_t *pBuffer)
+        {
+            if (length == 0)
+            {
+                return 0;
+            }
+
+            if (IsAscii(pString, length))
+            {
+                for (size_t i = 0; i < length; ++i)
+                {
+                    pBuffer[i] = static_cast<wchar_t>(pString[i]);
+                }
+                return length;
+            }
+
+            int srcLength = CheckedLength(length);
+            int sz = MultiByteToWideChar(codePage, 0, pString, srcLength, pBuffer, srcLength);
+            if (sz == 0)
+            {
+                throw unexpected_error();
+            }
+            return static_cast<size_t>(sz);
+        }
+    };
+    // DeferredErrorException:
+    //
+    // An exception of type TException which carries the data model error object which caused it.  The message of
+    // the exception is formatted from the error object on the first call to what().  An exception which is rethrown
+    // (e.g.: through an exception_ptr) may have what() called on several threads at once; the message is formatted
+    // exactly once.
+    //
+    template<typename TException>
+    class DeferredErrorException : public TException, public deferred_error
+    {
+    public:
+
+        template<typename... TArgs>
+        DeferredErrorException(_In_ HRESULT hr, _In_ IModelObject *pError, TArgs&&... exceptionArgs) :
+            TException(std::forward<TArgs>(exceptionArgs)...),
+            deferred_error(hr, pError)
+        {
+        }
+
+        //
+        // A copy formats its own message when asked.  Nothing is read from the source's message, which another
+        // thread may be formatting.
+        //
+        DeferredErrorException(_In_ const DeferredErrorException& src) :
+            TException(src),
+            deferred_error(src)
+        {
+        }
+
+        DeferredErrorException& operator=(_In_ const DeferredErrorException&) =delete;
+
+        using deferred_error::hr;
+
+        const char *what() const noexcept override
+        {
+            std::call_once(m_formatOnce, [this]()
+            {
+                //
+                // If the data model produced a specific error message, it becomes the message of the exception.
+                //
+                BSTR bstrMsg;
+                ComPtr<IStringDisplayableConcept> spStrConv;
+                IModelObject *pError = error_object();
+                if (SUCCEEDED(pError->GetConcept(__uuidof(IStringDisplayableConcept), &spStrConv, nullptr)) &&
+                    SUCCEEDED(spStrConv->ToDisplayString(pError, nullptr, &bstrMsg)))
+                {
+                    bstr_ptr spMsg(bstrMsg);
+                    try
+                    {
+                        m_msg = StringUtils::GetNarrowString(reinterpret_cast<const wchar_t *>(bstrMsg), SysStringLen(bstrMsg));
+                    }
+                    catch(...)
+                    {
+                        m_msg.clear();
+                    }
+                }
+            });
+
+            return m_msg.empty() ? TException::what() : m_msg.c_str();
+        }
+
+    private:
+
+        mutable std::once_flag m_formatOnce;
+        mutable std::string m_msg;
+    };
+
+    // Exceptions:
+    //
+    // Exception helpers:
+    //
+
+    struct Exceptions
+    {
+        //*************************************************
+        // Conversion From HRESULT to Exception:
+        //
+
+        static void ThrowHr(_In_ HRESULT hr, _In_opt_ IModelObject *pError = nullptr)
+        {
+            Tracing::HResultFailure(hr, pError != nullptr);
+            switch(hr)
+            {
+                case E_INVALIDARG:
+                case DISP_E_TYPEMISMATCH:
+                    ThrowError<std::invalid_argument>(hr, pError, "");
+
+                case E_OUTOFMEMORY:
+                    throw std::bad_alloc();
+
+                case E_BOUNDS:
+                    ThrowError<std::range_error>(hr, pError, "");
+
+                case E_NOTIMPL:
+                    ThrowError<not_implemented>(hr, pError, "");
+
+                case E_UNEXPECTED:
+                    ThrowError<unexpected_error>(hr, pError, "");
+
+                case E_ILLEGAL_METHOD_CALL:
+                    ThrowError<illegal_operation>(hr, pError, "");
+
+                case E_NOT_SET:
+                    ThrowError<not_set>(hr, pError, "");
+
+                default:
+                    ThrowError<hr_exception>(hr, pError, hr, "");
+            }
+        }
+
+        // ThrowError():
+        //
+        // Throws a TException.  If there is an error object, the thrown exception holds onto it and defers formatting
+        // its message until asked (see deferred_error).
+        //
+        template<typename TException, typename... TArgs>
+        [[noreturn]] static void ThrowError(_In_ HRESULT hr, _In_opt_ IModelObject *pError, TArgs&&... exceptionArgs)
+        {
+            if (pError != nullptr)
+            {
+                throw DeferredErrorException<TException>(hr, pError, std::forward<TArgs>(exceptionArgs)...);
+            }
+            throw TException(std::forward<TArgs>(exceptionArgs)...);
+        }
+
+        //*************************************************
+        // Conversion From Exception to HRESULT
+        //
+
+        static HRESULT ReturnResult(_In_ const std::exception_ptr& exception, _COM_Errorptr_opt_ IModelObject **ppError = nullptr)
+        {
+            HRESULT hr = E_FAIL;
+            std::wstring errMsg;
+            try
+            {
+                std::rethrow_exception(exception);
+            }
+            catch(deferred_error& deferredError)
+            {
+                //
+                // The exception came from the data model with an error object.  Hand that back as is rather than
+                // formatting it to a message and creating a new error object from that.
+                //
+                if (ppError != nullptr)
+                {
+                    ComPtr<IModelObject> spError = deferredError.error_object();
+                    *ppError = spError.Detach();
+                }
+                Tracing::ExceptionReturned(exception, deferredError.hr());
+                return deferredError.hr();
+            }
+            catch(std::invalid_argument& invalidArg)
+            {
+                hr = E_INVALIDARG;
+                errMsg = StringUtils::GetWideString(invalidArg.what());
+            }
+            catch(std::bad_alloc& /*badAlloc*/)
+            {
+                hr = E_OUTOFMEMORY;
+            }
+            catch(std::range_error& rangeError)
+            {
+                hr = E_BOUNDS;
+                errMsg = StringUtils::GetWideString(rangeError.what());
+            }
+            catch(not_implemented& notImplemented)
+            {
+                hr = E_NOTIMPL;
+                errMsg = StringUtils::GetWideString(notImplemented.what());
+            }
+            catch(unexpected_error& unexpectedError)
+            {
+                hr = E_UNEXPECTED;
+                errMsg = StringUtils::GetWideString(unexpectedError.what());
+            }
+            catch(hr_exception& hrError)
+            {
+                hr = hrError.hr();
+                errMsg = StringUtils::GetWideString(hrError.what());
+            }
+            catch(illegal_operation& illegalOperation)
+            {
+                hr = E_ILLEGAL_METHOD_CALL;
+                errMsg = StringUtils::GetWideString(illegalOperation.what());
+            }
+            catch(not_set& notSet)
+            {
+                hr = E_NOT_SET;
+                errMsg = StringUtils::GetWideString(notSet.what());
+            }
+            catch(std::exception& exc)
+            {
+                hr = E_FAIL;
+                errMsg = StringUtils::GetWideString(exc.what());
+            }
+            catch(...)
+            {
+                hr = E_FAIL;
+            }
+
+            if (ppError != nullptr && !errMsg.empty())
+            {
+                ComPtr<IModelObject> spError;
+                if (SUCCEEDED(GetManager()->CreateErrorObject(hr, errMsg.c_str(), &spError)))
+                {
+                    *ppError = spError.Detach();
+                }
+            }
+
+            Tracing::ExceptionReturned(exception, hr);
+            return hr;
+        }
+    };
+} // Details
+
+//**************************************************************************
+// Client Helpers:
+//
+
+// CheckHr():
+//
+// If the inpassed HRESULT indicates failure, this throws an exception based on the HRESULT
+//
+inline void CheckHr(_In_ HRESULT hr)
+{
     if (FAILED(hr))
     {
         Details::Exceptions::ThrowHr(hr, nullptr);
@@ -416,565 +970,994 @@ ComPtr<TInterface> GetHostAs()
     return spInterface;
 }
 
-//**************************************************************************
-// Forward Declarations:
+// Unexpected:
+//
+// The failure with which a failed Expected<TValue> is constructed (e.g.: return Unexpected(hr, std::move(spError))).
+// Failures are tagged so that they cannot be confused with a value when TValue is itself an HRESULT or integer.
 //
+struct Unexpected
+{
+    explicit Unexpected(_In_ HRESULT hr, _In_ ComPtr<IModelObject> spError = nullptr) : Result(hr), Error(std::move(spError))
+    {
+        AssertCondition(FAILED(hr));
+    }
 
-class Object;
-class Metadata;
-class Symbol;
-class Module;
-class Type;
-class Field;
-class BaseClass;
+    HRESULT Result;
+    ComPtr<IModelObject> Error;
+};
 
-template<typename T> Object BoxObject(_In_ T&& obj);
-template<typename T> decltype(auto) UnboxObject(_In_ const Object& src);
-
-//**************************************************************************
-// Basic Wrappers (Type System, Other Symbolic Access, Contexts, etc...):
+// Expected:
 //
-
-// symbol_cast:
-//
-// Convert from a generic symbol to a more specific symbol with type checking.
+// The result of a non-throwing operation (e.g.: Object::TryCall).  This holds either the value or the failing HRESULT
+// along with any error object the data model produced.  No exception is constructed (and no error message is
+// formatted) unless Value() is called on a failed result.
 //
-template<typename TDestSymbol>
-TDestSymbol symbol_cast(_In_ IDebugHostSymbol *pSymbol)
+template<typename TValue>
+class Expected
 {
-    if (!TDestSymbol::IsInstance(pSymbol))
+public:
+
+    Expected(_In_ const TValue& value) : m_hr(S_OK), m_value(value) { }
+    Expected(_In_ TValue&& value) : m_hr(S_OK), m_value(std::move(value)) { }
+    Expected(_In_ Unexpected failure) : m_hr(failure.Result), m_spError(std::move(failure.Error)) { }
+
+    // GetResult():
+    //
+    // Returns the HRESULT of the operation.
+    //
+    HRESULT GetResult() const { return m_hr; }
+
+    // Succeeded() / Failed():
+    //
+    // Returns whether the operation succeeded or failed.
+    //
+    bool Succeeded() const { return SUCCEEDED(m_hr); }
+    bool Failed() const { return FAILED(m_hr); }
+    explicit operator bool() const { return Succeeded(); }
+
+    // GetError():
+    //
+    // Returns the error object produced by a failed operation, if any.
+    //
+    const ComPtr<IModelObject>& GetError() const { return m_spError; }
+
+    // Value():
+    //
+    // Returns the value of a successful operation.  If the operation failed, this throws the exception which the
+    // throwing variant of the operation would have.
+    //
+    TValue& Value()
     {
-        throw std::bad_cast();
+        CheckValue();
+        return m_value.value();
     }
 
-    ComPtr<typename TDestSymbol::SymbolTypeInterface> spDerivedSymbolInterface;
-    CheckHr(pSymbol->QueryInterface(IID_PPV_ARGS(&spDerivedSymbolInterface)));
-    return TDestSymbol(std::move(spDerivedSymbolInterface));
-}
+    const TValue& Value() const
+    {
+        CheckValue();
+        return m_value.value();
+    }
 
-template<typename TDestSymbol> TDestSymbol symbol_cast(_In_ const ComPtr<IDebugHostSymbol>& spSymbol) { return symbol_cast<TDestSymbol>(spSymbol.Get()); }
-template<typename TDestSymbol> TDestSymbol symbol_cast(_In_ const Symbol& src);
+    // ValueOr():
+    //
+    // Returns the value of a successful operation or the given default if it failed.
+    //
+    TValue ValueOr(_In_ TValue defaultValue) const
+    {
+        return Succeeded() ? m_value.value() : std::move(defaultValue);
+    }
+
+    TValue& operator*() { return Value(); }
+    const TValue& operator*() const { return Value(); }
+    TValue *operator->() { return &Value(); }
+    const TValue *operator->() const { return &Value(); }
+
+private:
+
+    void CheckValue() const
+    {
+        if (FAILED(m_hr))
+        {
+            Details::Exceptions::ThrowHr(m_hr, m_spError.Get());
+        }
+    }
+
+    HRESULT m_hr;
+    ComPtr<IModelObject> m_spError;
+    std::optional<TValue> m_value;
+};
+
+//**************************************************************************
+// Parallel Evaluation:
+//
+// Object::ForEachElement and Object::TransformElements snapshot the elements of an iterable on the calling thread
+// and then evaluate a function over those elements.  By default, they do so sequentially on the calling thread.
+// Only a caller which opts in (see below) has them evaluated on a set of worker threads.
+//
+// Concurrency of host operations:
+//
+//     The data model and debug host interfaces make no general promise of being free threaded.  What may safely
+//     run concurrently depends on the host: some serialize parts of their work internally (target memory access
+//     in particular), some tolerate concurrent reads of keys, fields and values, and some must only be called
+//     from one thread at a time.  For this reason, calls to the function are serialized by default (see
+//     ParallelOptions::SerializeCallbacks).  Serialized calls are made one after another on the calling thread
+//     (holding the lock taken by SerializedHostAccess()) and no worker threads are created.  A parallel call
+//     made from within the function of another is therefore evaluated inline as well.
+//
+//     A caller which knows that its host, and everything its function does, tolerates concurrent calls may opt
+//     in to them by setting SerializeCallbacks to false.  Even then, operations which change host or shared state
+//     are *NOT* safe to run concurrently: changing the current process, thread or frame, executing commands or
+//     scripts, registering or unregistering models and modifying (SetKey, ClearKeys, SetConcept, etc...) objects
+//     which are visible to more than one worker.  Such operations must either be done outside the parallel call
+//     or be wrapped in SerializedHostAccess().
+//
+//     SerializedHostAccess() only excludes other code which takes the same lock.  Nothing else in this library
+//     takes it: the library's own paths which change state (setting keys, registering models, the current
+//     context cache, etc...) do not serialize against each other or against the host.
+//
+// Per-worker context:
+//
+//     A function which takes (const Object&, const HostContext&) is passed the context of the iterable.  Every
+//     worker is passed that same context rather than one of its own.  The host interfaces provide no way to
+//     create a new context which describes the same address space, and a context is an immutable description of
+//     one (it carries no per-call state), so sharing it between threads introduces no state which a per-worker
+//     context would isolate.
+//
+
+// ParallelOptions:
+//
+// Options which control ForEachElement and TransformElements.
+//
+struct ParallelOptions
+{
+    // The maximum number of threads (including the calling thread) to evaluate on.  Zero indicates the number of
+    // hardware threads.
+    size_t MaxConcurrency = 0;
+
+    // The number of consecutive elements a worker claims at a time.  Idle workers keep claiming chunks until every
+    // element is processed, so expensive elements do not leave the other workers idle.
+    size_t ChunkSize = 16;
+
+    // If true (the default), the function is called for each element in turn on the calling thread while holding
+    // the lock taken by SerializedHostAccess().  Setting this to false evaluates the elements across worker threads
+    // with concurrent calls and must only be done when the host and the function tolerate them (see "Parallel
+    // Evaluation").
+    bool SerializeCallbacks = true;
+};
 
 namespace Details
 {
-    // SymbolChildrenRef:
+    // GetHostSerializationLock():
     //
-    // Returned from Children() (or another such method) to represent all (or a subset of) children of
-    // a given symbol.
+    // Returns the process wide lock used to serialize host operations which are not safe to run concurrently.
     //
-    template<typename TSymParent, typename TSymChild>
-    class SymbolChildrenRef
+    inline std::recursive_mutex& GetHostSerializationLock()
     {
-    private:
+        static std::recursive_mutex s_lock;
+        return s_lock;
+    }
+}
 
-        // SymbolIterator():
-        //
-        // A C++ input iterator for the children of a symbol
-        //
-        class SymbolIterator
-        {
-        public:
+// SerializedHostAccess():
+//
+// Calls func while holding the process wide lock which parallel evaluation uses to serialize host operations which
+// are not safe to run concurrently.
+//
+template<typename TFunc>
+decltype(auto) SerializedHostAccess(_In_ TFunc&& func)
+{
+    std::lock_guard<std::recursive_mutex> lock(Details::GetHostSerializationLock());
+    return std::forward<TFunc>(func)();
+}
 
-            using value_type = TSymChild;
-            using reference = TSymChild;
-            using pointer = const TSymChild *;
-            using difference_type = size_t;
-            using iterator_category = std::input_iterator_tag;
+//**************************************************************************
+// Accessor Statistics:
+//
+// Properties and methods which are bound through ProviderEx (AddProperty, AddReadOnlyProperty, AddMethod and the
+// Bind* variants on ExtensionModel and TypedInstanceModel) each carry an AccessorStatsSlot.  While statistics are
+// enabled, every get, set and call through such an accessor records the number of calls, the number which failed
+// with an exception, the cumulative and maximum latency and the number of bytes of string and intrinsic data boxed
+// by property getters.  The accessor's statistics record is registered here on the first such call; accessors which
+// are never called while statistics are enabled have no record.  While disabled, the cost of an accessor call is a
+// single relaxed load.
+//
+// Statistics are initially disabled unless DBGMODELCLIENTEX_ACCESSOR_STATISTICS is defined.  They may be toggled
+// at any time with AccessorStatistics::Instance().Enable() or through the data model by way of
+// ProviderEx::ExtensionStatisticsModel.
+//
 
-            SymbolIterator() : m_pos(0) { }
+// AccessorKind:
+//
+// Indicates what kind of accessor a statistics record describes.
+//
+enum class AccessorKind
+{
+    Property,
+    Method
+};
 
-            SymbolIterator(_In_ IDebugHostSymbolEnumerator *pChildEnum) : SymbolIterator(pChildEnum, 0) { }
+// AccessorStats:
+//
+// The statistics for a single bound accessor.  Latencies are in QueryPerformanceCounter ticks.
+//
+struct AccessorStats
+{
+    AccessorStats(_In_ std::wstring modelName, _In_ std::wstring accessorName, _In_ AccessorKind kind) :
+        ModelName(std::move(modelName)),
+        AccessorName(std::move(accessorName)),
+        Kind(kind)
+    {
+    }
 
-            SymbolIterator(_In_ IDebugHostSymbolEnumerator *pChildEnum, _In_ size_t pos) :
-                m_spEnum(pChildEnum),
-                m_pos(pos)
-            {
-                MoveForward();
-            }
+    // Record():
+    //
+    // Records a single completed call through the accessor.
+    //
+    void Record(_In_ ULONG64 ticks, _In_ bool failed, _In_ ULONG64 bytesBoxed)
+    {
+        Calls.fetch_add(1, std::memory_order_relaxed);
+        TotalTicks.fetch_add(ticks, std::memory_order_relaxed);
+        if (failed)
+        {
+            Exceptions.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (bytesBoxed != 0)
+        {
+            BytesBoxed.fetch_add(bytesBoxed, std::memory_order_relaxed);
+        }
 
-            SymbolIterator(_In_ const SymbolIterator& rhs) =default;
-            SymbolIterator(SymbolIterator&& rhs) =default;
-            SymbolIterator& operator=(_In_ const SymbolIterator& rhs) =default;
-            SymbolIterator& operator=(SymbolIterator&& rhs) =default;
+        ULONG64 maxTicks = MaxTicks.load(std::memory_order_relaxed);
+        while (ticks > maxTicks && !MaxTicks.compare_exchange_weak(maxTicks, ticks, std::memory_order_relaxed))
+        {
+        }
+    }
 
-            bool operator==(_In_ const SymbolIterator& rhs)
-            {
-                return (m_value.GetSymbolInterface() == rhs.m_value.GetSymbolInterface() && m_pos == rhs.m_pos);
-            }
+    // Reset():
+    //
+    // Clears the statistics.
+    //
+    void Reset()
+    {
+        Calls.store(0, std::memory_order_relaxed);
+        Exceptions.store(0, std::memory_order_relaxed);
+        TotalTicks.store(0, std::memory_order_relaxed);
+        MaxTicks.store(0, std::memory_order_relaxed);
+        BytesBoxed.store(0, std::memory_order_relaxed);
+    }
 
-            bool operator!=(_In_ const SymbolIterator& rhs)
-            {
-                return !operator==(rhs);
-            }
+    const std::wstring ModelName;
+    const std::wstring AccessorName;
+    const AccessorKind Kind;
 
-            value_type operator*() const
-            {
-                return m_value;
-            }
+    std::atomic<ULONG64> Calls { 0 };
+    std::atomic<ULONG64> Exceptions { 0 };
+    std::atomic<ULONG64> TotalTicks { 0 };
+    std::atomic<ULONG64> MaxTicks { 0 };
+    std::atomic<ULONG64> BytesBoxed { 0 };
+};
 
-            pointer operator->() const
-            {
-                return &m_value;
-            }
+// AccessorStatistics:
+//
+// The process wide (or more precisely, module wide) registry of accessor statistics records.
+//
+class AccessorStatistics
+{
+public:
 
-            SymbolIterator operator++()
-            {
-                MoveForward();
-                return *this;
-            }
+    AccessorStatistics(_In_ const AccessorStatistics&) =delete;
+    AccessorStatistics& operator=(_In_ const AccessorStatistics&) =delete;
 
-            SymbolIterator operator++(int)
-            {
-                SymbolIterator cur = *this;
-                MoveForward();
-                return cur;
-            }
+    // Instance():
+    //
+    // Returns the registry.
+    //
+    static AccessorStatistics& Instance()
+    {
+        static AccessorStatistics s_statistics;
+        return s_statistics;
+    }
 
-        private:
+    // Enable():
+    //
+    // Enables or disables the recording of statistics for every accessor.
+    //
+    void Enable(_In_ bool enabled = true)
+    {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
 
-            void MoveForward()
-            {
-                ComPtr<IDebugHostSymbol> spSym;
-                HRESULT hr = m_spEnum->GetNext(&spSym);
-                if (SUCCEEDED(hr))
-                {
-                    m_value = symbol_cast<value_type>(std::move(spSym));
-                    ++m_pos;
-                }
-                else if (hr != E_BOUNDS)
-                {
-                    CheckHr(hr);
-                }
-                else
-                {
-                    m_value = value_type { };
-                    m_pos = 0;
-                }
-            }
+    // IsEnabled():
+    //
+    // Indicates whether statistics are currently being recorded.
+    //
+    bool IsEnabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
 
-            ComPtr<IDebugHostSymbolEnumerator> m_spEnum;
-            value_type m_value;
-            size_t m_pos;
+    // Register():
+    //
+    // Returns the statistics record for the given accessor, creating it if this is the first registration.  An
+    // accessor which is bound again (e.g.: a data model which is torn down and recreated) continues the same record.
+    //
+    std::shared_ptr<AccessorStats> Register(_In_ std::wstring modelName, _In_ std::wstring accessorName, _In_ AccessorKind kind)
+    {
+        Key key { std::move(modelName), std::move(accessorName), kind };
 
-        };
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            return m_records[it->second];
+        }
 
-    public:
+        auto spStats = std::make_shared<AccessorStats>(key.ModelName, key.AccessorName, kind);
+        m_records.push_back(spStats);
+        m_index.emplace(std::move(key), m_records.size() - 1);
+        return spStats;
+    }
 
-        using iterator = SymbolIterator;
+    // GetRecords():
+    //
+    // Returns every statistics record in the order of registration.
+    //
+    std::vector<std::shared_ptr<const AccessorStats>> GetRecords() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return std::vector<std::shared_ptr<const AccessorStats>>(m_records.begin(), m_records.end());
+    }
 
-        SymbolChildrenRef(_In_ const TSymParent& sym, SymbolKind enumKind) :
-            m_sym(sym),
-            m_enumKind(enumKind)
+    // Reset():
+    //
+    // Clears the statistics of every record.
+    //
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (auto& spStats : m_records)
         {
+            spStats->Reset();
         }
+    }
 
-        // operator[]:
-        //
-        // Returns a child symbol.
-        //
-        TSymChild operator[](_In_z_ const wchar_t *childName) const
+    // GetTicksPerSecond():
+    //
+    // Returns the frequency of the counter in which latencies are recorded.
+    //
+    static ULONG64 GetTicksPerSecond()
+    {
+        static const ULONG64 s_frequency = []()
         {
-            ComPtr<IDebugHostSymbolEnumerator> spEnum;
-            CheckHr(m_sym->EnumerateChildren(m_enumKind, childName, &spEnum));
-
-            ComPtr<IDebugHostSymbol> spSym;
-            CheckHr(spEnum->GetNext(&spSym));
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            return static_cast<ULONG64>(frequency.QuadPart);
+        }();
+        return s_frequency;
+    }
 
-            ComPtr<IDebugHostSymbol> spNext;
-            if (SUCCEEDED(spEnum->GetNext(&spNext)))
-            {
-                //
-                // The result is ambiguous.  Bail out.
-                //
-                throw std::runtime_error("The symbol name is not unique");
-            }
+private:
 
-            TSymChild childSymbol = symbol_cast<TSymChild>(std::move(spSym));
-            return childSymbol;
-        }
+    struct Key
+    {
+        std::wstring ModelName;
+        std::wstring AccessorName;
+        AccessorKind Kind;
 
-        TSymChild operator[](_In_ const std::wstring& fieldName) const
+        bool operator==(_In_ const Key& rhs) const
         {
-            if (fieldName.empty())
-            {
-                throw std::invalid_argument("Invalid fieldName");
-            }
-            return operator[](fieldName.c_str());
+            return Kind == rhs.Kind && AccessorName == rhs.AccessorName && ModelName == rhs.ModelName;
         }
+    };
 
-        iterator begin() const
+    struct KeyHash
+    {
+        size_t operator()(_In_ const Key& key) const
         {
-            ComPtr<IDebugHostSymbolEnumerator> spEnum;
-            CheckHr(m_sym->EnumerateChildren(m_enumKind, nullptr, &spEnum));
-            return iterator(spEnum.Get());
+            size_t hash = std::hash<std::wstring>()(key.ModelName);
+            hash ^= std::hash<std::wstring>()(key.AccessorName) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash ^ static_cast<size_t>(key.Kind);
         }
+    };
 
-        iterator end() const
-        {
-            return iterator();
-        }
+#ifdef DBGMODELCLIENTEX_ACCESSOR_STATISTICS
+    AccessorStatistics() : m_enabled(true) { }
+#else
+    AccessorStatistics() : m_enabled(false) { }
+#endif // DBGMODELCLIENTEX_ACCESSOR_STATISTICS
 
-    private:
+    std::atomic<bool> m_enabled;
+    mutable std::mutex m_lock;
+    std::vector<std::shared_ptr<AccessorStats>> m_records;
+    std::unordered_map<Key, size_t, KeyHash> m_index;
+};
 
-        TSymParent m_sym;
-        SymbolKind m_enumKind;
+// AccessorStatsSlot:
+//
+// The identity of a single bound accessor and, once a call through it has been recorded, its statistics record in
+// AccessorStatistics.
+//
+class AccessorStatsSlot
+{
+public:
 
-    };
+    AccessorStatsSlot(_In_ std::wstring modelName, _In_ std::wstring accessorName, _In_ AccessorKind kind) :
+        ModelName(std::move(modelName)),
+        AccessorName(std::move(accessorName)),
+        Kind(kind)
+    {
+    }
 
-    // GenericArgumentsRef:
+    AccessorStatsSlot(_In_ const AccessorStatsSlot&) =delete;
+    AccessorStatsSlot& operator=(_In_ const AccessorStatsSlot&) =delete;
+
+    // GetRecord():
     //
-    // Returned from GenericArguments() to represent a collection of the generic arguments of a given type.
+    // Returns the statistics record of the accessor, registering it on the first request.  Threads which race on
+    // the first request register the same key and so receive the same record.  Records are never removed from the
+    // registry, so the record outlives the slot.
     //
-    template<typename TSym>
-    class GenericArgumentsRef
+    AccessorStats *GetRecord()
     {
-    private:
-
-        // GenericArgumentsIterator():
-        //
-        // A C++ input iterator for the generic arguments of a symbol
-        //
-        class GenericArgumentsIterator
+        AccessorStats *pStats = m_pStats.load(std::memory_order_acquire);
+        if (pStats == nullptr)
         {
-        public:
-
-            using value_type = TSym;
-            using reference = TSym;
-            using pointer = const TSym *;
-            using difference_type = size_t;
-            using iterator_category = std::input_iterator_tag;
+            pStats = AccessorStatistics::Instance().Register(ModelName, AccessorName, Kind).get();
+            m_pStats.store(pStats, std::memory_order_release);
+        }
+        return pStats;
+    }
 
-            GenericArgumentsIterator() : m_pos(0) { }
+    const std::wstring ModelName;
+    const std::wstring AccessorName;
+    const AccessorKind Kind;
 
-            GenericArgumentsIterator(_In_ IDebugHostType *pType) : GenericArgumentsIterator(pType, 0) { }
+private:
 
-            GenericArgumentsIterator(_In_ IDebugHostType *pType, _In_ size_t pos) :
-                m_spType(pType),
-                m_pos(pos)
-            {
-                MoveForward();
-            }
+    std::atomic<AccessorStats *> m_pStats { nullptr };
+};
 
-            GenericArgumentsIterator(_In_ const GenericArgumentsIterator& rhs) =default;
-            GenericArgumentsIterator(GenericArgumentsIterator&& rhs) =default;
-            GenericArgumentsIterator& operator=(_In_ const GenericArgumentsIterator& rhs) =default;
-            GenericArgumentsIterator& operator=(GenericArgumentsIterator&& rhs) =default;
+namespace Details
+{
+    // AccessorCallScope:
+    //
+    // Times a single call through an instrumented accessor.  A scope which is destroyed without Complete() having
+    // been called (e.g.: because the accessor threw) is recorded as a failure.
+    //
+    class AccessorCallScope
+    {
+    public:
 
-            bool operator==(_In_ const GenericArgumentsIterator& rhs)
+        AccessorCallScope(_In_opt_ AccessorStatsSlot *pSlot) :
+            m_pStats(nullptr),
+            m_start(0),
+            m_bytesBoxed(0),
+            m_completed(false),
+            m_traceScope(pSlot != nullptr ? pSlot->ModelName.c_str() : nullptr,
+                         pSlot != nullptr ? pSlot->AccessorName.c_str() : nullptr)
+        {
+            if (pSlot != nullptr && AccessorStatistics::Instance().IsEnabled())
             {
-                if (m_value.GetSymbolInterface() == nullptr && rhs.m_value.GetSymbolInterface() == nullptr)
-                {
-                    return true;
-                }
-                else return (m_spType.Get() == rhs.m_spType.Get() &&
-                             m_value.GetSymbolInterface() == rhs.m_value.GetSymbolInterface() &&
-                             m_pos == rhs.m_pos);
-            }
+                m_pStats = pSlot->GetRecord();
 
-            bool operator!=(_In_ const GenericArgumentsIterator& rhs)
-            {
-                return !operator==(rhs);
+                LARGE_INTEGER start;
+                QueryPerformanceCounter(&start);
+                m_start = start.QuadPart;
             }
+        }
 
-            value_type operator*() const
+        ~AccessorCallScope()
+        {
+            if (m_pStats != nullptr)
             {
-                return m_value;
+                LARGE_INTEGER end;
+                QueryPerformanceCounter(&end);
+                m_pStats->Record(static_cast<ULONG64>(end.QuadPart - m_start), !m_completed, m_bytesBoxed);
             }
+        }
 
-            pointer operator->() const
-            {
-                return &m_value;
-            }
+        AccessorCallScope(_In_ const AccessorCallScope&) =delete;
+        AccessorCallScope& operator=(_In_ const AccessorCallScope&) =delete;
 
-            GenericArgumentsIterator operator++()
-            {
-                MoveForward();
-                return *this;
-            }
+        bool IsRecording() const
+        {
+            return m_pStats != nullptr;
+        }
 
-            GenericArgumentsIterator operator++(int)
-            {
-                GenericArgumentsIterator cur = *this;
-                MoveForward();
-                return cur;
-            }
+        void AddBytesBoxed(_In_ size_t bytesBoxed)
+        {
+            m_bytesBoxed += bytesBoxed;
+        }
 
-        private:
+        void Complete()
+        {
+            m_completed = true;
+        }
 
-            void MoveForward()
-            {
-                ULONG64 genericCount;
-                CheckHr(m_spType->GetGenericArgumentCount(&genericCount));
+    private:
 
-                if (m_pos >= genericCount)
-                {
-                    m_value = value_type { };
-                    m_pos = 0;
-                }
-                else
-                {
-                    ComPtr<IDebugHostSymbol> spSym;
-                    CheckHr(m_spType->GetGenericArgumentAt(m_pos, &spSym));
-                    m_value = std::move(spSym);
-                    ++m_pos;
-                }
-            }
+        AccessorStats *m_pStats;
+        LONGLONG m_start;
+        ULONG64 m_bytesBoxed;
+        bool m_completed;
+        Tracing::AccessorScope m_traceScope;
+    };
+}
 
-            ComPtr<IDebugHostType> m_spType;
-            value_type m_value;
-            size_t m_pos;
+//**************************************************************************
+// Object Pooling:
+//
+// The COM objects which the library creates at a high rate (the iterators returned from IIterableConcept::GetIterator
+// and the instance data storage behind each object created by a TypedInstanceModel) are allocated through
+// PoolAllocationTraits<T>.  The default implementation keeps a per-thread free list of released blocks for each size
+// of such object and reuses them for the next allocation rather than going back to the heap.  A free list holds at
+// most DBGMODELCLIENTEX_OBJECT_POOL_DEPTH blocks (32 by default).  Defining it as zero allocates every object from the
+// heap.
+//
+// A client may specialize PoolAllocationTraits for a given type to supply its own allocator (e.g.: an arena).  Blocks
+// are always returned to the traits which allocated them.
+//
 
-        };
+#ifndef DBGMODELCLIENTEX_OBJECT_POOL_DEPTH
+#define DBGMODELCLIENTEX_OBJECT_POOL_DEPTH 32
+#endif // DBGMODELCLIENTEX_OBJECT_POOL_DEPTH
 
+namespace Details
+{
+    // ThreadFreeList:
+    //
+    // A per-thread list of released blocks of BlockSize bytes.  The list is drained when the thread exits.  A block
+    // released on a thread after its list has been drained goes back to the heap.
+    //
+    template<size_t BlockSize>
+    class ThreadFreeList
+    {
     public:
 
-        using iterator = GenericArgumentsIterator;
+        static_assert(BlockSize >= sizeof(void *), "pooled blocks must be able to hold a link");
 
-        GenericArgumentsRef(_In_ IDebugHostType *pType) :
-            m_spType(pType)
+        // Pop():
+        //
+        // Removes a block from the calling thread's list.  Returns nullptr if the list is empty.
+        //
+        static void *Pop() noexcept
         {
+            State& state = t_state;
+            Block *pBlock = state.Head;
+            if (pBlock != nullptr)
+            {
+                state.Head = pBlock->Next;
+                --state.Count;
+            }
+            return pBlock;
         }
 
-        // size():
+        // Push():
         //
-        // The size of the list of generic parameters.
+        // Places a block on the calling thread's list.  Returns false if the list is full (or has already been
+        // drained) and the block was not taken.
         //
-        size_t size() const
+        static bool Push(_In_ void *pMemory) noexcept
         {
-            ULONG64 argCount;
-            CheckHr(m_spType->GetGenericArgumentCount(&argCount));
-            return static_cast<size_t>(argCount);
+            State& state = t_state;
+            if (state.Closed || state.Count >= DBGMODELCLIENTEX_OBJECT_POOL_DEPTH)
+            {
+                return false;
+            }
+
+            //
+            // The first block placed on a thread's list registers the drain for thread exit.
+            //
+            static thread_local Drain drain;
+            (void)drain;
+
+            Block *pBlock = reinterpret_cast<Block *>(pMemory);
+            pBlock->Next = state.Head;
+            state.Head = pBlock;
+            ++state.Count;
+            return true;
         }
 
-        // operator[]:
+    private:
+
+        struct Block
+        {
+            Block *Next;
+        };
+
         //
-        // Returns the n-th generic argument.
+        // The list itself is trivially destructible so that it remains usable (as closed) while other thread
+        // local objects are destroyed after the drain has run.
         //
-        TSym operator[](_In_ size_t n) const
+        struct State
         {
-            ComPtr<IDebugHostSymbol> spSym;
-            CheckHr(m_spType->GetGenericArgumentAt(n, &spSym));
-            TSym value = std::move(spSym);
-            return value;
-        }
+            Block *Head;
+            size_t Count;
+            bool Closed;
+        };
 
-        iterator begin() const
+        struct Drain
         {
-            return iterator(m_spType.Get());
-        }
+            ~Drain()
+            {
+                State& state = t_state;
+                state.Closed = true;
+                while (state.Head != nullptr)
+                {
+                    Block *pBlock = state.Head;
+                    state.Head = pBlock->Next;
+                    ::operator delete(pBlock);
+                }
+                state.Count = 0;
+            }
+        };
 
-        iterator end() const
+        static inline thread_local State t_state = { nullptr, 0, false };
+    };
+}
+
+// PoolAllocationTraits:
+//
+// Allocates and frees the memory for a pooled COM object of type T.  Allocate returns nullptr on failure.  Free is
+// given the size which was passed to Allocate.
+//
+template<typename T>
+struct PoolAllocationTraits
+{
+    static void *Allocate(_In_ size_t size) noexcept
+    {
+        void *pMemory = nullptr;
+        if (size == sizeof(T))
         {
-            return iterator();
+            pMemory = Details::ThreadFreeList<sizeof(T)>::Pop();
         }
+        return (pMemory != nullptr ? pMemory : ::operator new(size, std::nothrow));
+    }
 
-    private:
-
-        ComPtr<IDebugHostType> m_spType;
-
-    };
+    static void Free(_In_ void *pMemory, _In_ size_t size) noexcept
+    {
+        if (size != sizeof(T) || !Details::ThreadFreeList<sizeof(T)>::Push(pMemory))
+        {
+            ::operator delete(pMemory);
+        }
+    }
+};
 
-    // ArrayDimensionsRef:
+namespace Details
+{
+    // PooledObject:
     //
-    // Returned from ArrayDimensions() to represent a collection of the array dimensions.
+    // Inserted between a COM object (TDerived) and its WRL base (TBase) so that the object is allocated through
+    // PoolAllocationTraits<TDerived> and, on its final Release, returned there rather than to the heap.  Such an
+    // object must be created with MakePooled rather than Microsoft::WRL::Make.  Make will not compile against it.
     //
-    class ArrayDimensionsRef
+    template<typename TDerived, typename TBase>
+    class PooledObject : public TBase
     {
-    private:
+    public:
+
+        static void *operator new(_In_ size_t size)
+        {
+            void *pMemory = PooledObject::operator new(size, std::nothrow);
+            if (pMemory == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return pMemory;
+        }
+
+        static void *operator new(_In_ size_t size, _In_ const std::nothrow_t&) noexcept
+        {
+            static_assert(alignof(TDerived) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "pooled objects cannot be over-aligned");
+            return PoolAllocationTraits<TDerived>::Allocate(size);
+        }
+
+        static void operator delete(_In_ void *pMemory, _In_ size_t size) noexcept
+        {
+            PoolAllocationTraits<TDerived>::Free(pMemory, size);
+        }
 
-        // ArrayDimensionsIterator():
         //
-        // A C++ input iterator for the dimensions of an array
+        // Only called if the constructor of TDerived throws out of a MakePooled.
         //
-        class ArrayDimensionsIterator
+        static void operator delete(_In_ void *pMemory, _In_ const std::nothrow_t&) noexcept
         {
-        public:
+            PoolAllocationTraits<TDerived>::Free(pMemory, sizeof(TDerived));
+        }
+    };
 
-            using value_type = ArrayDimension;
-            using reference = ArrayDimension;
-            using pointer = const ArrayDimension *;
-            using difference_type = size_t;
-            using iterator_category = std::input_iterator_tag;
+    // MakePooled():
+    //
+    // The equivalent of Microsoft::WRL::Make for an object which derives from PooledObject.  Returns nullptr if the
+    // allocation fails.
+    //
+    template<typename T, typename... TArgs>
+    ComPtr<T> MakePooled(TArgs&&... args)
+    {
+        ComPtr<T> spObject;
+        spObject.Attach(new (std::nothrow) T(std::forward<TArgs>(args)...));
+        return spObject;
+    }
+}
 
-            ArrayDimensionsIterator() : m_pArrayDimensions(nullptr), m_dimsCount(0), m_pos(0) { }
+//**************************************************************************
+// Native List and Tree Walk Options:
+//
 
-            ArrayDimensionsIterator(_In_ ULONG64 dimsCount,
-                                    _In_reads_(dimsCount) pointer pArrayDimensions) :
-                                    ArrayDimensionsIterator(dimsCount, pArrayDimensions, 0) { }
+// WalkTermination:
+//
+// Why a walk of a native list or tree (see Object::WalkList and Object::WalkTree) stopped producing elements.
+//
+enum class WalkTermination
+{
+    InProgress,     // The walk has not reached its end
+    Complete,       // The list came back to its head (or reached a null link) or every node of the tree was visited
+    Cycle,          // A node was reached a second time.  The elements which follow would repeat.
+    NodeBudget      // The walk produced the maximum number of nodes it was allowed to
+};
 
-            ArrayDimensionsIterator(_In_ ULONG64 dimsCount,
-                                    _In_reads_(dimsCount) pointer pArrayDimensions,
-                                    _In_ ULONG64 pos) :
-                m_dimsCount(dimsCount),
-                m_pArrayDimensions(pArrayDimensions),
-                m_pos(pos)
-            {
-                MoveForward();
-            }
+// WalkOptions:
+//
+// Limits on a walk of a native list or tree.  Target data may be corrupt or change underneath a walk.  These keep a
+// walk from running forever or holding unbounded memory.
+//
+struct WalkOptions
+{
+    // The maximum number of elements which the walk will produce.
+    ULONG64 MaxNodes = 1048576;
 
-            ArrayDimensionsIterator(_In_ const ArrayDimensionsIterator& rhs) =default;
-            ArrayDimensionsIterator(ArrayDimensionsIterator&& rhs) =default;
-            ArrayDimensionsIterator& operator=(_In_ const ArrayDimensionsIterator& rhs) =default;
-            ArrayDimensionsIterator& operator=(ArrayDimensionsIterator&& rhs) =default;
+    // Whether each node address is recorded so that the walk stops when a node is reached a second time.
+    bool DetectCycles = true;
 
-            bool operator==(_In_ const ArrayDimensionsIterator& rhs)
-            {
-                return (m_dimsCount == rhs.m_dimsCount &&
-                        m_pArrayDimensions == rhs.m_pArrayDimensions &&
-                        m_pos == rhs.m_pos);
-            }
+    // The number of links of a list which are chased ahead of the element being consumed.
+    ULONG ReadAhead = 64;
+};
 
-            bool operator!=(_In_ const ArrayDimensionsIterator& rhs)
-            {
-                return !operator==(rhs);
-            }
+//**************************************************************************
+// Forward Declarations:
+//
 
-            value_type operator*() const
-            {
-                return m_value;
-            }
+class Object;
+class ObjectView;
+class Metadata;
+class Symbol;
+class Module;
+class Type;
+class Field;
+class BaseClass;
+class ListWalk;
+class TreeWalk;
 
-            pointer operator->() const
-            {
-                return &m_value;
-            }
+template<typename T> Object BoxObject(_In_ T&& obj);
+template<typename T> decltype(auto) UnboxObject(_In_ const Object& src);
+
+//**************************************************************************
+// Basic Wrappers (Type System, Other Symbolic Access, Contexts, etc...):
+//
+
+// symbol_cast:
+//
+// Convert from a generic symbol to a more specific symbol with type checking.
+//
+template<typename TDestSymbol>
+TDestSymbol symbol_cast(_In_ IDebugHostSymbol *pSymbol)
+{
+    if (!TDestSymbol::IsInstance(pSymbol))
+    {
+        throw std::bad_cast();
+    }
 
-            ArrayDimensionsIterator operator++()
+    ComPtr<typename TDestSymbol::SymbolTypeInterface> spDerivedSymbolInterface;
+    CheckHr(pSymbol->QueryInterface(IID_PPV_ARGS(&spDerivedSymbolInterface)));
+    return TDestSymbol(std::move(spDerivedSymbolInterface));
+}
+
+template<typename TDestSymbol> TDestSymbol symbol_cast(_In_ const ComPtr<IDebugHostSymbol>& spSymbol) { return symbol_cast<TDestSymbol>(spSymbol.Get()); }
+template<typename TDestSymbol> TDestSymbol symbol_cast(_In_ const Symbol& src);
+
+namespace Details
+{
+    // SymbolChildIndex:
+    //
+    // A name index over the children of a symbol which is built with a single enumeration (see
+    // SymbolChildrenRef::Indexed()).  Lookups hash the name into a flat open addressed table rather than asking the
+    // symbol engine for a filtered enumeration.  A name which is shared by more than one child is marked ambiguous
+    // and fails lookup in the same manner as SymbolChildrenRef::operator[].  Children without a name are iterable
+    // but cannot be looked up.
+    //
+    template<typename TSymChild>
+    class SymbolChildIndex
+    {
+    public:
+
+        using iterator = typename std::vector<TSymChild>::const_iterator;
+
+        template<typename TChildren>
+        explicit SymbolChildIndex(_In_ const TChildren& children)
+        {
+            for (auto&& child : children)
             {
-                MoveForward();
-                return *this;
+                BSTR name = nullptr;
+                if (FAILED(child.GetSymbolInterface()->GetName(&name)))
+                {
+                    name = nullptr;
+                }
+                bstr_ptr spName(name);
+
+                m_names.push_back(name == nullptr ? std::wstring() : std::wstring(name, SysStringLen(name)));
+                m_children.push_back(child);
             }
 
-            ArrayDimensionsIterator operator++(int)
+            BuildTable();
+        }
+
+        // Find():
+        //
+        // Returns the child of the given name or nullptr if there is no such child.  If the name is ambiguous, this
+        // will throw.
+        //
+        const TSymChild *Find(_In_ std::wstring_view childName) const
+        {
+            if (childName.empty())
             {
-                ArrayDimensionsIterator cur = *this;
-                MoveForward();
-                return cur;
+                return nullptr;
             }
 
-        private:
-
-            void MoveForward()
+            size_t hash = std::hash<std::wstring_view>()(childName);
+            size_t mask = m_buckets.size() - 1;
+            for (size_t slot = hash & mask; ; slot = (slot + 1) & mask)
             {
-                if (m_pos >= m_dimsCount)
+                const Bucket& bucket = m_buckets[slot];
+                if (bucket.Index == EmptyBucket)
                 {
-                    m_value = value_type { };
-                    m_dimsCount = 0;
-                    m_pArrayDimensions = nullptr;
-                    m_pos = 0;
+                    return nullptr;
                 }
-                else
+
+                if (bucket.Hash == hash && m_names[bucket.Index] == childName)
                 {
-                    m_value = m_pArrayDimensions[static_cast<size_t>(m_pos)];
-                    ++m_pos;
+                    if (bucket.IsAmbiguous)
+                    {
+                        throw std::runtime_error("The symbol name is not unique");
+                    }
+                    return &m_children[bucket.Index];
                 }
             }
-
-            ULONG64 m_dimsCount;
-            pointer m_pArrayDimensions;
-            ULONG64 m_pos;
-            value_type m_value;
-        };
-
-    public:
-
-        using iterator = ArrayDimensionsIterator;
-
-        ArrayDimensionsRef(_In_ IDebugHostType *pType) :
-            m_spType(pType)
-        {
-            CheckHr(m_spType->GetArrayDimensionality(&m_dimsCount));
-            m_spDims.reset(new ArrayDimension[static_cast<size_t>(m_dimsCount)]);
-            CheckHr(m_spType->GetArrayDimensions(m_dimsCount, m_spDims.get()));
         }
 
-        // size():
-        //
-        // The size of the list of dimensions.
-        //
-        size_t size() const { return static_cast<size_t>(m_dimsCount); }
-
         // operator[]:
         //
-        // Returns the n-th generic argument.
+        // Returns a child symbol.  If there is no such child, this will throw.
         //
-        ArrayDimension operator[](_In_ size_t n) const
+        TSymChild operator[](_In_z_ const wchar_t *childName) const
         {
-            if (n >= m_dimsCount)
+            const TSymChild *pChild = Find(childName);
+            if (pChild == nullptr)
             {
-                CheckHr(E_BOUNDS);
+                throw std::range_error("The symbol name was not found");
             }
-            return m_spDims[n];
+            return *pChild;
         }
 
-        iterator begin() const
+        TSymChild operator[](_In_ const std::wstring& childName) const
         {
-            return iterator(m_dimsCount, m_spDims.get());
+            if (childName.empty())
+            {
+                throw std::invalid_argument("Invalid childName");
+            }
+            return operator[](childName.c_str());
         }
 
-        iterator end() const
-        {
-            return iterator();
-        }
+        size_t Size() const { return m_children.size(); }
+        iterator begin() const { return m_children.begin(); }
+        iterator end() const { return m_children.end(); }
 
     private:
 
-        ComPtr<IDebugHostType> m_spType;
-        ULONG64 m_dimsCount;
-        std::unique_ptr<ArrayDimension[]> m_spDims;
+        static constexpr size_t EmptyBucket = static_cast<size_t>(-1);
+
+        struct Bucket
+        {
+            size_t Hash;
+            size_t Index;
+            bool IsAmbiguous;
+        };
+
+        void BuildTable()
+        {
+            //
+            // Keep the table at most half full so that probe sequences stay short.
+            //
+            size_t bucketCount = 8;
+            while (bucketCount < m_children.size() * 2)
+            {
+                bucketCount <<= 1;
+            }
+
+            m_buckets.assign(bucketCount, Bucket { 0, EmptyBucket, false });
+            size_t mask = bucketCount - 1;
+
+            for (size_t i = 0; i < m_names.size(); ++i)
+            {
+                const std::wstring& name = m_names[i];
+                if (name.empty())
+                {
+                    continue;
+                }
+
+                size_t hash = std::hash<std::wstring_view>()(name);
+                for (size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+                {
+                    Bucket& bucket = m_buckets[slot];
+                    if (bucket.Index == EmptyBucket)
+                    {
+                        bucket = Bucket { hash, i, false };
+                        break;
+                    }
 
+                    if (bucket.Hash == hash && m_names[bucket.Index] == name)
+                    {
+                        bucket.IsAmbiguous = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<TSymChild> m_children;
+        std::vector<std::wstring> m_names;
+        std::vector<Bucket> m_buckets;
     };
 
-    // ParameterTypesRef:
+    // SymbolChildrenRef:
     //
-    // Returned from ParameterTypes() to represent a collection of the parameter types for a function type.
+    // Returned from Children() (or another such method) to represent all (or a subset of) children of
+    // a given symbol.
     //
-    template<typename TSym>
-    class ParameterTypesRef
+    template<typename TSymParent, typename TSymChild>
+    class SymbolChildrenRef
     {
     private:
 
-        // ParameterTypesIterator():
+        // SymbolIterator():
         //
-        // A C++ input iterator for the parameter types of a function
+        // A C++ input iterator for the children of a symbol
         //
-        class ParameterTypesIterator
+        class SymbolIterator
         {
         public:
 
-            using value_type = TSym;
-            using reference = TSym;
-            using pointer = const TSym *;
+            using value_type = TSymChild;
+            using reference = const TSymChild&;
+            using pointer = const TSymChild *;
             using difference_type = size_t;
             using iterator_category = std::input_iterator_tag;
 
-            ParameterTypesIterator() : m_pos(0) { }
+            SymbolIterator() : m_pos(0) { }
 
-            ParameterTypesIterator(_In_ IDebugHostType *pType) : ParameterTypesIterator(pType, 0) { }
+            SymbolIterator(_In_ IDebugHostSymbolEnumerator *pChildEnum) : SymbolIterator(pChildEnum, 0) { }
 
-            ParameterTypesIterator(_In_ IDebugHostType *pType, _In_ size_t pos) :
-                m_spType(pType),
+            SymbolIterator(_In_ IDebugHostSymbolEnumerator *pChildEnum, _In_ size_t pos) :
+                m_spEnum(pChildEnum),
                 m_pos(pos)
             {
                 MoveForward();
             }
 
-            ParameterTypesIterator(_In_ const ParameterTypesIterator& rhs) =default;
-            ParameterTypesIterator(ParameterTypesIterator&& rhs) =default;
-            ParameterTypesIterator& operator=(_In_ const ParameterTypesIterator& rhs) =default;
-            ParameterTypesIterator& operator=(ParameterTypesIterator&& rhs) =default;
+            SymbolIterator(_In_ const SymbolIterator& rhs) =default;
+            SymbolIterator(SymbolIterator&& rhs) =default;
+            SymbolIterator& operator=(_In_ const SymbolIterator& rhs) =default;
+            SymbolIterator& operator=(SymbolIterator&& rhs) =default;
 
-            bool operator==(_In_ const ParameterTypesIterator& rhs)
+            bool operator==(_In_ const SymbolIterator& rhs) const
             {
                 return (m_value.GetSymbolInterface() == rhs.m_value.GetSymbolInterface() && m_pos == rhs.m_pos);
             }
 
-            bool operator!=(_In_ const ParameterTypesIterator& rhs)
+            bool operator!=(_In_ const SymbolIterator& rhs) const
             {
                 return !operator==(rhs);
             }
 
-            value_type operator*() const
+            reference operator*() const
             {
                 return m_value;
             }
@@ -984,15 +1967,15 @@ namespace Details
                 return &m_value;
             }
 
-            ParameterTypesIterator operator++()
+            SymbolIterator& operator++()
             {
                 MoveForward();
                 return *this;
             }
 
-            ParameterTypesIterator operator++(int)
+            SymbolIterator operator++(int)
             {
-                ParameterTypesIterator cur = *this;
+                SymbolIterator cur = *this;
                 MoveForward();
                 return cur;
             }
@@ -1001,24 +1984,25 @@ namespace Details
 
             void MoveForward()
             {
-                ULONG64 paramCount;
-                CheckHr(m_spType->GetFunctionParameterTypeCount(&paramCount));
-
-                if (m_pos >= paramCount)
+                ComPtr<IDebugHostSymbol> spSym;
+                HRESULT hr = m_spEnum->GetNext(&spSym);
+                if (SUCCEEDED(hr))
                 {
-                    m_value = value_type { };
-                    m_pos = 0;
+                    m_value = symbol_cast<value_type>(std::move(spSym));
+                    ++m_pos;
+                }
+                else if (hr != E_BOUNDS)
+                {
+                    CheckHr(hr);
                 }
                 else
                 {
-                    ComPtr<IDebugHostType> spType;
-                    CheckHr(m_spType->GetFunctionParameterTypeAt(m_pos, &spType));
-                    m_value = std::move(spType);
-                    ++m_pos;
+                    m_value = value_type { };
+                    m_pos = 0;
                 }
             }
 
-            ComPtr<IDebugHostType> m_spType;
+            ComPtr<IDebugHostSymbolEnumerator> m_spEnum;
             value_type m_value;
             size_t m_pos;
 
@@ -1026,40 +2010,64 @@ namespace Details
 
     public:
 
-        using iterator = ParameterTypesIterator;
+        using iterator = SymbolIterator;
 
-        ParameterTypesRef(_In_ IDebugHostType *pType) :
-            m_spType(pType)
+        SymbolChildrenRef(_In_ const TSymParent& sym, SymbolKind enumKind) :
+            m_sym(sym),
+            m_enumKind(enumKind)
         {
         }
 
-        // size():
+        // operator[]:
         //
-        // The size of the list of parameter types.
+        // Returns a child symbol.
         //
-        size_t size() const
+        TSymChild operator[](_In_z_ const wchar_t *childName) const
         {
-            ULONG64 paramCount;
-            CheckHr(m_spType->GetFunctionParameterTypeCount(&paramCount));
-            return static_cast<size_t>(paramCount);
+            ComPtr<IDebugHostSymbolEnumerator> spEnum;
+            CheckHr(m_sym->EnumerateChildren(m_enumKind, childName, &spEnum));
+
+            ComPtr<IDebugHostSymbol> spSym;
+            CheckHr(spEnum->GetNext(&spSym));
+
+            ComPtr<IDebugHostSymbol> spNext;
+            if (SUCCEEDED(spEnum->GetNext(&spNext)))
+            {
+                //
+                // The result is ambiguous.  Bail out.
+                //
+                throw std::runtime_error("The symbol name is not unique");
+            }
+
+            TSymChild childSymbol = symbol_cast<TSymChild>(std::move(spSym));
+            return childSymbol;
         }
 
-        // operator[]:
+        TSymChild operator[](_In_ const std::wstring& fieldName) const
+        {
+            if (fieldName.empty())
+            {
+                throw std::invalid_argument("Invalid fieldName");
+            }
+            return operator[](fieldName.c_str());
+        }
+
+        // Indexed():
         //
-        // Returns the n-th parameter type.
+        // Enumerates the children once into a name index.  Where a number of children are looked up by name, this
+        // avoids a filtered enumeration per lookup.
         //
-        TSym operator[](_In_ size_t n) const
+        SymbolChildIndex<TSymChild> Indexed() const
         {
-            ComPtr<IDebugHostType> spType;
-            CheckHr(m_spType->GetFunctionParameterTypeAt(n, &spType));
-            TSym value = std::move(spType);
-            return value;
+            return SymbolChildIndex<TSymChild>(*this);
         }
 
         iterator begin() const
         {
-            return iterator(m_spType.Get());
-        }
+            ComPtr<IDebugHostSymbolEnumerator> spEnum;
+            CheckHr(m_sym->EnumerateChildren(m_enumKind, nullptr, &spEnum));
+            return iterator(spEnum.Get());
+        }
 
         iterator end() const
         {
@@ -1068,1209 +2076,1501 @@ namespace Details
 
     private:
 
-        ComPtr<IDebugHostType> m_spType;
+        TSymParent m_sym;
+        SymbolKind m_enumKind;
 
     };
-}
 
+    // GenericArgumentsRef:
+    //
+    // Returned from GenericArguments() to represent a collection of the generic arguments of a given type.
+    //
+    template<typename TSym>
+    class GenericArgumentsRef
+    {
+    private:
 
-// HostContext:
-//
-// Represents a host context (information about what session/process/etc... an object
-// comes from)
-//
-class HostContext
-{
-public:
+        // GenericArgumentsIterator():
+        //
+        // A C++ input iterator for the generic arguments of a symbol
+        //
+        class GenericArgumentsIterator
+        {
+        public:
 
-    HostContext() : m_isDeferred(false) { }
+            using value_type = TSym;
+            using reference = const TSym&;
+            using pointer = const TSym *;
+            using difference_type = size_t;
+            using iterator_category = std::input_iterator_tag;
 
-    HostContext(_In_ IDebugHostContext *pHostContext)
-    {
-        m_isDeferred = (pHostContext == USE_CURRENT_HOST_CONTEXT);
-        if (!m_isDeferred)
-        {
-            m_spHostContext = pHostContext;
-        }
-    }
+            GenericArgumentsIterator() : m_pos(0) { }
 
-    HostContext(_In_ const ComPtr<IDebugHostContext>& spHostContext) : m_spHostContext(spHostContext), m_isDeferred(false) { }
-    HostContext(_In_ ComPtr<IDebugHostContext>&& spHostContext) : m_spHostContext(std::move(spHostContext)), m_isDeferred(false) { }
-    HostContext(_In_ const HostContext& src) : m_spHostContext(src.m_spHostContext), m_isDeferred(src.m_isDeferred) { }
-    HostContext(_In_ HostContext&& src) : m_spHostContext(std::move(src.m_spHostContext)), m_isDeferred(src.m_isDeferred) { }
+            GenericArgumentsIterator(_In_ IDebugHostType *pType) : GenericArgumentsIterator(pType, 0) { }
 
-    HostContext& operator=(_In_ const HostContext& src) { m_spHostContext = src.m_spHostContext; m_isDeferred = src.m_isDeferred; return *this; }
-    HostContext& operator=(_In_ HostContext&& src) { m_spHostContext = std::move(src.m_spHostContext); m_isDeferred = src.m_isDeferred; return *this; }
+            GenericArgumentsIterator(_In_ IDebugHostType *pType, _In_ size_t pos) :
+                m_spType(pType),
+                m_pos(pos)
+            {
+                MoveForward();
+            }
 
-    operator IDebugHostContext* () const
-    {
-        if (m_isDeferred) { return USE_CURRENT_HOST_CONTEXT; }
-        return m_spHostContext.Get();
-    }
+            GenericArgumentsIterator(_In_ const GenericArgumentsIterator& rhs) =default;
+            GenericArgumentsIterator(GenericArgumentsIterator&& rhs) =default;
+            GenericArgumentsIterator& operator=(_In_ const GenericArgumentsIterator& rhs) =default;
+            GenericArgumentsIterator& operator=(GenericArgumentsIterator&& rhs) =default;
 
-    IDebugHostContext* operator->() const
-    {
-        CheckObject();
-        return (IDebugHostContext *)(*this);
-    }
+            bool operator==(_In_ const GenericArgumentsIterator& rhs) const
+            {
+                if (m_value.GetSymbolInterface() == nullptr && rhs.m_value.GetSymbolInterface() == nullptr)
+                {
+                    return true;
+                }
+                else return (m_spType.Get() == rhs.m_spType.Get() &&
+                             m_value.GetSymbolInterface() == rhs.m_value.GetSymbolInterface() &&
+                             m_pos == rhs.m_pos);
+            }
 
-    // Current():
-    //
-    // Returns the current context of the host.
-    //
-    static HostContext Current()
-    {
-        ComPtr<IDebugHostContext> spContext;
-        CheckHr(GetHost()->GetCurrentContext(&spContext));
-        HostContext contextObject = std::move(spContext);
-        return contextObject;
-    }
+            bool operator!=(_In_ const GenericArgumentsIterator& rhs) const
+            {
+                return !operator==(rhs);
+            }
 
-    // DeferredCurrent():
-    //
-    // Returns an object that refers to the current context of the host *when used*.
-    //
-    static HostContext DeferredCurrent()
-    {
-        return HostContext(USE_CURRENT_HOST_CONTEXT);
-    }
+            reference operator*() const
+            {
+                return m_value;
+            }
 
-protected:
+            pointer operator->() const
+            {
+                return &m_value;
+            }
 
-    bool m_isDeferred;
-    ComPtr<IDebugHostContext> m_spHostContext;
+            GenericArgumentsIterator& operator++()
+            {
+                MoveForward();
+                return *this;
+            }
 
-    void CheckObject() const
-    {
-        if (m_spHostContext.Get() == nullptr)
+            GenericArgumentsIterator operator++(int)
+            {
+                GenericArgumentsIterator cur = *this;
+                MoveForward();
+                return cur;
+            }
+
+        private:
+
+            void MoveForward()
+            {
+                ULONG64 genericCount;
+                CheckHr(m_spType->GetGenericArgumentCount(&genericCount));
+
+                if (m_pos >= genericCount)
+                {
+                    m_value = value_type { };
+                    m_pos = 0;
+                }
+                else
+                {
+                    ComPtr<IDebugHostSymbol> spSym;
+                    CheckHr(m_spType->GetGenericArgumentAt(m_pos, &spSym));
+                    m_value = std::move(spSym);
+                    ++m_pos;
+                }
+            }
+
+            ComPtr<IDebugHostType> m_spType;
+            value_type m_value;
+            size_t m_pos;
+
+        };
+
+    public:
+
+        using iterator = GenericArgumentsIterator;
+
+        GenericArgumentsRef(_In_ IDebugHostType *pType) :
+            m_spType(pType)
         {
-            throw unexpected_error();
         }
-    }
-};
 
-// Symbol:
-//
-// Class for a generic symbol.  In addition to being the base class for more specific symbol types
-// (e.g.: Types, Modules, Fields, etc...), this can be instantiated over top any such symbol for base symbol
-// functionality.
-//
-class Symbol
-{
-public:
-
-    using SymbolTypeInterface = IDebugHostSymbol;
+        // size():
+        //
+        // The size of the list of generic parameters.
+        //
+        size_t size() const
+        {
+            ULONG64 argCount;
+            CheckHr(m_spType->GetGenericArgumentCount(&argCount));
+            return static_cast<size_t>(argCount);
+        }
 
-    // IsInstance():
-    //
-    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
-    //
-    static bool IsInstance(_In_ const Symbol& /*symbol*/)
-    {
-        return true;
-    }
+        // operator[]:
+        //
+        // Returns the n-th generic argument.
+        //
+        TSym operator[](_In_ size_t n) const
+        {
+            ComPtr<IDebugHostSymbol> spSym;
+            CheckHr(m_spType->GetGenericArgumentAt(n, &spSym));
+            TSym value = std::move(spSym);
+            return value;
+        }
 
-    static bool IsInstance(_In_ IDebugHostSymbol * /*pSymbol*/)
-    {
-        return true;
-    }
+        iterator begin() const
+        {
+            return iterator(m_spType.Get());
+        }
 
-    //*************************************************
-    // General Symbol Methods:
-    //
+        iterator end() const
+        {
+            return iterator();
+        }
 
-    Symbol() =default;
-    Symbol(_In_ IDebugHostSymbol *pSymbol) : m_spSymbol(pSymbol) { }
-    Symbol(_In_ ComPtr<IDebugHostSymbol> spSymbol) : m_spSymbol(std::move(spSymbol)) { }
-    Symbol(_In_ const Symbol& src) =default;
-    Symbol(_In_ Symbol&& src) =default;
+    private:
 
-    Symbol& operator=(_In_ IDebugHostSymbol *pSymbol) { AssignSymbol(pSymbol); return *this; }
-    Symbol& operator=(_In_ ComPtr<IDebugHostSymbol> spSymbol) { MoveSymbol(std::move(spSymbol)); return *this; }
-    Symbol& operator=(_In_ const Symbol& src) { AssignSymbol(src.m_spSymbol.Get()); return *this; }
-    Symbol& operator=(_In_ Symbol&& src) { MoveSymbol(std::move(src.m_spSymbol)); return *this; }
+        ComPtr<IDebugHostType> m_spType;
 
-    operator IDebugHostSymbol* () const { return m_spSymbol.Get(); }
-    IDebugHostSymbol *operator->() const { return m_spSymbol.Get(); }
+    };
 
-    // operator==/!=():
+    // ArrayDimensionsRef:
     //
-    // Compares two symbols for equality (not equivalence).  Two different typedefs to the same type
-    // will still not compare equally.
+    // Returned from ArrayDimensions() to represent a collection of the array dimensions.
     //
-    bool operator==(_In_ const IDebugHostSymbol *pOtherSymbol) const
+    class ArrayDimensionsRef
     {
-        if (m_spSymbol.Get() == pOtherSymbol) { return true; }
-        if (IsEmpty() || pOtherSymbol == nullptr) { return false; }
+    private:
 
-        bool result;
-        CheckHr(m_spSymbol->CompareAgainst(const_cast<IDebugHostSymbol *>(pOtherSymbol), 0, &result));
-        return result;
-    }
-    bool operator==(_In_ const Symbol& otherSymbol) const
-    {
-        if (m_spSymbol.Get() == otherSymbol.m_spSymbol.Get()) { return true; }
-        if (IsEmpty() || otherSymbol.IsEmpty()) { return false; }
+        // ArrayDimensionsIterator():
+        //
+        // A C++ input iterator for the dimensions of an array
+        //
+        class ArrayDimensionsIterator
+        {
+        public:
 
-        bool result;
-        CheckHr(m_spSymbol->CompareAgainst(otherSymbol, 0, &result));
-        return result;
-    }
+            using value_type = ArrayDimension;
+            using reference = const ArrayDimension&;
+            using pointer = const ArrayDimension *;
+            using difference_type = size_t;
+            using iterator_category = std::input_iterator_tag;
 
-    bool operator!=(_In_ const IDebugHostSymbol *pOtherSymbol) const
-    {
-        return !operator==(pOtherSymbol);
-    }
-    bool operator!=(_In_ const Symbol& otherSymbol) const
-    {
-        return !operator==(otherSymbol);
-    }
+            ArrayDimensionsIterator() : m_pArrayDimensions(nullptr), m_dimsCount(0), m_pos(0) { }
 
-    // IsEmpty():
-    //
-    // Indicates whether there is an underlying type or not.
-    //
-    bool IsEmpty() const { return m_spSymbol.Get() == nullptr; }
+            ArrayDimensionsIterator(_In_ ULONG64 dimsCount,
+                                    _In_reads_(dimsCount) pointer pArrayDimensions) :
+                                    ArrayDimensionsIterator(dimsCount, pArrayDimensions, 0) { }
 
-    // SymbolKind():
-    //
-    // Gets the kind of symbol that this is.
-    //
-    SymbolKind SymbolKind() const
-    {
-        ::SymbolKind kind;
-        CheckHr(m_spSymbol->GetSymbolKind(&kind));
-        return kind;
-    }
+            ArrayDimensionsIterator(_In_ ULONG64 dimsCount,
+                                    _In_reads_(dimsCount) pointer pArrayDimensions,
+                                    _In_ ULONG64 pos) :
+                m_dimsCount(dimsCount),
+                m_pArrayDimensions(pArrayDimensions),
+                m_pos(pos)
+            {
+                MoveForward();
+            }
 
-    // GetSymbolInterface():
-    //
-    // Gets the underlying interface for the symbol.
-    //
-    IDebugHostSymbol *GetSymbolInterface() const
-    {
-        return m_spSymbol.Get();
-    }
+            ArrayDimensionsIterator(_In_ const ArrayDimensionsIterator& rhs) =default;
+            ArrayDimensionsIterator(ArrayDimensionsIterator&& rhs) =default;
+            ArrayDimensionsIterator& operator=(_In_ const ArrayDimensionsIterator& rhs) =default;
+            ArrayDimensionsIterator& operator=(ArrayDimensionsIterator&& rhs) =default;
 
-    // Name():
-    //
-    // Gets the name of the symbol.
-    //
-    std::wstring Name() const
-    {
-        CheckObject();
+            bool operator==(_In_ const ArrayDimensionsIterator& rhs) const
+            {
+                return (m_dimsCount == rhs.m_dimsCount &&
+                        m_pArrayDimensions == rhs.m_pArrayDimensions &&
+                        m_pos == rhs.m_pos);
+            }
 
-        BSTR name;
-        CheckHr(m_spSymbol->GetName(&name));
-        bstr_ptr spName(name);
-        return std::wstring(name);
-    }
+            bool operator!=(_In_ const ArrayDimensionsIterator& rhs) const
+            {
+                return !operator==(rhs);
+            }
 
-    // Type():
-    //
-    // Gets the type of the symbol (if such has a type; an exception is thrown otherwise)
-    //
-    Type Type() const;
+            reference operator*() const
+            {
+                return m_value;
+            }
 
-    // ContainingModule():
-    //
-    // Gets the containing module of the symbol.
-    //
-    Module ContainingModule() const;
+            pointer operator->() const
+            {
+                return &m_value;
+            }
 
-    // Children():
-    //
-    // Returns a collection of all of the children of this symbol.
-    //
-    Details::SymbolChildrenRef<Symbol, Symbol> Children() const
-    {
-        CheckObject();
-        return Details::SymbolChildrenRef<Symbol, Symbol>(*this, SymbolKind::Symbol);
-    }
+            ArrayDimensionsIterator& operator++()
+            {
+                MoveForward();
+                return *this;
+            }
 
-    // Language():
-    //
-    // Returns the language in which the symbol is defined.  This may often return LanguageUnknown.
-    //
-    LanguageKind Language() const
-    {
-        CheckObject();
-        ComPtr<IDebugHostSymbol2> spSymbol2;
-        CheckHr(m_spSymbol.As(&spSymbol2));
-        LanguageKind lang;
-        CheckHr(spSymbol2->GetLanguage(&lang));
-        return lang;
-    }
+            ArrayDimensionsIterator operator++(int)
+            {
+                ArrayDimensionsIterator cur = *this;
+                MoveForward();
+                return cur;
+            }
 
-protected:
+        private:
 
-    void AssignSymbol(_In_ IDebugHostSymbol *pSymbol)
-    {
-        CheckSymbol(pSymbol);
-        m_spSymbol = pSymbol;
-    }
+            void MoveForward()
+            {
+                if (m_pos >= m_dimsCount)
+                {
+                    m_value = value_type { };
+                    m_dimsCount = 0;
+                    m_pArrayDimensions = nullptr;
+                    m_pos = 0;
+                }
+                else
+                {
+                    m_value = m_pArrayDimensions[static_cast<size_t>(m_pos)];
+                    ++m_pos;
+                }
+            }
 
-    void MoveSymbol(_In_ ComPtr<IDebugHostSymbol>&& srcSymbol)
-    {
-        CheckSymbol(srcSymbol.Get());
-        m_spSymbol = std::move(srcSymbol);
-    }
+            ULONG64 m_dimsCount;
+            pointer m_pArrayDimensions;
+            ULONG64 m_pos;
+            value_type m_value;
+        };
 
-    // VerifySymbol():
-    //
-    // Verifies that the given symbol can legally be assigned to the given instance.  Derived classes
-    // must type check the symbol.
-    //
-    virtual bool VerifySymbol(_In_ IDebugHostSymbol * /*pSymbol*/) noexcept
-    {
-        return true;
-    }
+    public:
 
-    void CheckObject() const
-    {
-        if (m_spSymbol.Get() == nullptr)
+        using iterator = ArrayDimensionsIterator;
+
+        ArrayDimensionsRef(_In_ IDebugHostType *pType) :
+            m_spType(pType)
         {
-            throw unexpected_error();
+            CheckHr(m_spType->GetArrayDimensionality(&m_dimsCount));
+            m_spDims.reset(new ArrayDimension[static_cast<size_t>(m_dimsCount)]);
+            CheckHr(m_spType->GetArrayDimensions(m_dimsCount, m_spDims.get()));
         }
-    }
 
-private:
+        // size():
+        //
+        // The size of the list of dimensions.
+        //
+        size_t size() const { return static_cast<size_t>(m_dimsCount); }
 
-    void CheckSymbol(_In_ IDebugHostSymbol *pSymbol)
-    {
-        if (pSymbol != nullptr && !VerifySymbol(pSymbol))
+        // operator[]:
+        //
+        // Returns the n-th generic argument.
+        //
+        ArrayDimension operator[](_In_ size_t n) const
         {
-            throw std::bad_cast();
+            if (n >= m_dimsCount)
+            {
+                CheckHr(E_BOUNDS);
+            }
+            return m_spDims[n];
         }
-    }
-
-    // Depending on the symbol, this *MAY* hold something which is IDebugHostSymbol derived.
-    ComPtr<IDebugHostSymbol> m_spSymbol;
 
-};
+        iterator begin() const
+        {
+            return iterator(m_dimsCount, m_spDims.get());
+        }
 
-// SymbolWithOffset:
-//
-// A symbol paired with an offset from that symbol.
-//
-typedef std::pair<Symbol, ULONG64> SymbolWithOffset;
+        iterator end() const
+        {
+            return iterator();
+        }
 
-// Module:
-//
-// Represents a module object.
-//
-class Module : public Symbol
-{
-public:
+    private:
 
-    using SymbolTypeInterface = IDebugHostModule;
+        ComPtr<IDebugHostType> m_spType;
+        ULONG64 m_dimsCount;
+        std::unique_ptr<ArrayDimension[]> m_spDims;
 
-    //*************************************************
-    // Factory Methods:
-    //
+    };
 
-    // IsInstance():
+    // ParameterTypesRef:
     //
-    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
+    // Returned from ParameterTypes() to represent a collection of the parameter types for a function type.
     //
-    static bool IsInstance(_In_ const Symbol& symbol)
+    template<typename TSym>
+    class ParameterTypesRef
     {
-        return (symbol.SymbolKind() == SymbolModule);
-    }
+    private:
 
-    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
-    {
-        ::SymbolKind symKind;
-        CheckHr(pSymbol->GetSymbolKind(&symKind));
-        return (symKind == SymbolModule);
-    }
+        // ParameterTypesIterator():
+        //
+        // A C++ input iterator for the parameter types of a function
+        //
+        class ParameterTypesIterator
+        {
+        public:
 
-    // FromLocation():
-    //
-    // Returns a module from a given location (address) within a context
-    //
-    static Module FromLocation(_In_ const HostContext& moduleContext, _In_ const Location& locationWithinModule)
-    {
-        ComPtr<IDebugHostSymbols> spHostSym;
-        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+            using value_type = TSym;
+            using reference = const TSym&;
+            using pointer = const TSym *;
+            using difference_type = size_t;
+            using iterator_category = std::input_iterator_tag;
 
-        ComPtr<IDebugHostModule> spModule;
-        CheckHr(spHostSym->FindModuleByLocation(moduleContext, locationWithinModule, &spModule));
-        return Module(std::move(spModule));
-    }
+            ParameterTypesIterator() : m_pos(0) { }
 
-    //*************************************************
-    // Module Methods:
-    //
+            ParameterTypesIterator(_In_ IDebugHostType *pType) : ParameterTypesIterator(pType, 0) { }
 
-    Module() { }
-    Module(_In_ IDebugHostModule *pModule) : Symbol(pModule) { }
-    Module(_In_ ComPtr<IDebugHostModule> spModule) : Symbol(spModule.Detach()) { }
-    Module(_In_ const Module& src) : Symbol(src) { }
-    Module(_In_ Module&& src) : Symbol(std::move(src)) { }
+            ParameterTypesIterator(_In_ IDebugHostType *pType, _In_ size_t pos) :
+                m_spType(pType),
+                m_pos(pos)
+            {
+                MoveForward();
+            }
 
-    Module& operator=(_In_ IDebugHostModule *pModule) { return static_cast<Module&>(Symbol::operator=(pModule)); }
-    Module& operator=(_In_ ComPtr<IDebugHostModule> spModule) { return static_cast<Module&>(Symbol::operator=(spModule.Detach())); }
-    Module& operator=(_In_ const Module& src) { return static_cast<Module&>(Symbol::operator=(src)); }
-    Module& operator=(_In_ Module&& src) { return static_cast<Module&>(Symbol::operator=(std::move(src))); }
+            ParameterTypesIterator(_In_ const ParameterTypesIterator& rhs) =default;
+            ParameterTypesIterator(ParameterTypesIterator&& rhs) =default;
+            ParameterTypesIterator& operator=(_In_ const ParameterTypesIterator& rhs) =default;
+            ParameterTypesIterator& operator=(ParameterTypesIterator&& rhs) =default;
 
-    operator IDebugHostModule* () const { return AsModule(); }
-    IDebugHostModule *operator->() const { return AsModule(); }
+            bool operator==(_In_ const ParameterTypesIterator& rhs) const
+            {
+                return (m_value.GetSymbolInterface() == rhs.m_value.GetSymbolInterface() && m_pos == rhs.m_pos);
+            }
 
-    template<typename TStr>
-    Module(_In_ const HostContext& moduleContext, TStr&& moduleName)
-    {
-        ComPtr<IDebugHostSymbols> spHostSym;
-        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+            bool operator!=(_In_ const ParameterTypesIterator& rhs) const
+            {
+                return !operator==(rhs);
+            }
 
-        ComPtr<IDebugHostModule> spModule;
-        CheckHr(spHostSym->FindModuleByName(moduleContext, Details::ExtractString(moduleName), &spModule));
-        AssignSymbol(spModule.Detach());
-    }
+            reference operator*() const
+            {
+                return m_value;
+            }
 
-    // BaseLocation():
-    //
-    // Gets the base location of the module.
-    //
-    Location BaseLocation() const
-    {
-        CheckObject();
+            pointer operator->() const
+            {
+                return &m_value;
+            }
 
-        Location moduleBase;
-        CheckHr(AsModule()->GetBaseLocation(&moduleBase));
-        return moduleBase;
-    }
+            ParameterTypesIterator& operator++()
+            {
+                MoveForward();
+                return *this;
+            }
 
-    // TryGetContainingSymbol():
-    //
-    // Attempts to lookup a symbol from a given offset into the module (an RVA).  If the symbol can be found,
-    // it and the delta to the base of the symbol are returned (along with true).  If the symbol cannot be found,
-    // false is returned.
-    //
-    std::optional<SymbolWithOffset> TryGetContainingSymbol(_In_ ULONG64 moduleOffset) const
-    {
-        std::optional<SymbolWithOffset> symbolWithOffset;
+            ParameterTypesIterator operator++(int)
+            {
+                ParameterTypesIterator cur = *this;
+                MoveForward();
+                return cur;
+            }
 
-        ComPtr<IDebugHostModule2> spModule2;
-        ComPtr<IDebugHostSymbol> spSym;
-        ULONG64 offset;
+        private:
 
-        if (SUCCEEDED(AsModule()->QueryInterface(IID_PPV_ARGS(&spModule2))) &&
-            SUCCEEDED(spModule2->FindContainingSymbolByRVA(moduleOffset, &spSym, &offset)))
+            void MoveForward()
+            {
+                ULONG64 paramCount;
+                CheckHr(m_spType->GetFunctionParameterTypeCount(&paramCount));
+
+                if (m_pos >= paramCount)
+                {
+                    m_value = value_type { };
+                    m_pos = 0;
+                }
+                else
+                {
+                    ComPtr<IDebugHostType> spType;
+                    CheckHr(m_spType->GetFunctionParameterTypeAt(m_pos, &spType));
+                    m_value = std::move(spType);
+                    ++m_pos;
+                }
+            }
+
+            ComPtr<IDebugHostType> m_spType;
+            value_type m_value;
+            size_t m_pos;
+
+        };
+
+    public:
+
+        using iterator = ParameterTypesIterator;
+
+        ParameterTypesRef(_In_ IDebugHostType *pType) :
+            m_spType(pType)
         {
-            symbolWithOffset = std::make_pair(Symbol(std::move(spSym)), offset);
         }
 
-        return symbolWithOffset;
-    }
-    bool TryGetContainingSymbol(_In_ ULONG64 moduleOffset, _Out_ SymbolWithOffset *pResultSymbol) const
-    {
-        auto sym = TryGetContainingSymbol(moduleOffset);
-        if (sym)
+        // size():
+        //
+        // The size of the list of parameter types.
+        //
+        size_t size() const
         {
-            *pResultSymbol = sym.value();
-            return true;
+            ULONG64 paramCount;
+            CheckHr(m_spType->GetFunctionParameterTypeCount(&paramCount));
+            return static_cast<size_t>(paramCount);
         }
-        return false;
-    }
 
-    // GetContainingSymbol():
-    //
-    // Looks up a symbol from a given offset into the module and returns the symbol and the delta to the base of
-    // the symbol.  If such symbol cannot be found (e.g.: symbols cannot be loaded or there is no symbol at the
-    // given offset), an exception is thrown.
-    //
-    SymbolWithOffset GetContainingSymbol(_In_ ULONG64 moduleOffset) const
-    {
-        SymbolWithOffset symOffs;
-        if (!TryGetContainingSymbol(moduleOffset, &symOffs))
+        // operator[]:
+        //
+        // Returns the n-th parameter type.
+        //
+        TSym operator[](_In_ size_t n) const
         {
-            CheckHr(E_FAIL);
+            ComPtr<IDebugHostType> spType;
+            CheckHr(m_spType->GetFunctionParameterTypeAt(n, &spType));
+            TSym value = std::move(spType);
+            return value;
         }
-        return symOffs;
-    }
-
-    // FindType():
-    //
-    // Finds a type by name within the module.
-    //
-    template<typename TStr>
-    ClientEx::Type FindType(_In_ TStr&& typeName) const;
 
-    // FindSymbol():
-    //
-    // Finds a symbol by name within the module.
-    //
-    template<typename TStr>
-    Symbol FindSymbol(_In_ TStr&& symbolName) const
-    {
-        ComPtr<IDebugHostSymbol> spSymbol;
-        CheckHr(AsModule()->FindSymbolByName(Details::ExtractString(symbolName), &spSymbol));
-        return Symbol(std::move(spSymbol));
-    }
+        iterator begin() const
+        {
+            return iterator(m_spType.Get());
+        }
 
-protected:
+        iterator end() const
+        {
+            return iterator();
+        }
 
-    virtual bool VerifySymbol(_In_ IDebugHostSymbol *pSymbol) noexcept
-    {
-        return pSymbol == nullptr || IsInstance(pSymbol);
-    }
+    private:
 
-private:
+        ComPtr<IDebugHostType> m_spType;
 
-    // AsModule():
-    //
-    // Returns the IDebugHostModule interface for the module.
-    //
-    IDebugHostModule *AsModule() const
-    {
-        return static_cast<IDebugHostModule *>(GetSymbolInterface());
-    }
+    };
+}
 
-};
 
-// Constant:
+// HostContext:
 //
-// Represents a constant within symbols...
+// Represents a host context (information about what session/process/etc... an object
+// comes from)
 //
-class Constant : public Symbol
+class HostContext
 {
 public:
 
-    using SymbolTypeInterface = IDebugHostConstant;
+    HostContext() : m_isDeferred(false) { }
 
-    // IsInstance():
-    //
-    // Returns whether a given generic symbol actually refers (and can be converted) to a constant.
-    //
-    static bool IsInstance(_In_ const Symbol& symbol)
+    HostContext(_In_ IDebugHostContext *pHostContext)
     {
-        return (symbol.SymbolKind() == SymbolConstant);
+        m_isDeferred = (pHostContext == USE_CURRENT_HOST_CONTEXT);
+        if (!m_isDeferred)
+        {
+            m_spHostContext = pHostContext;
+        }
     }
 
-    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    HostContext(_In_ const ComPtr<IDebugHostContext>& spHostContext) : m_spHostContext(spHostContext), m_isDeferred(false) { }
+    HostContext(_In_ ComPtr<IDebugHostContext>&& spHostContext) : m_spHostContext(std::move(spHostContext)), m_isDeferred(false) { }
+    HostContext(_In_ const HostContext& src) : m_spHostContext(src.m_spHostContext), m_isDeferred(src.m_isDeferred) { }
+    HostContext(_In_ HostContext&& src) : m_spHostContext(std::move(src.m_spHostContext)), m_isDeferred(src.m_isDeferred) { }
+
+    HostContext& operator=(_In_ const HostContext& src) { m_spHostContext = src.m_spHostContext; m_isDeferred = src.m_isDeferred; return *this; }
+    HostContext& operator=(_In_ HostContext&& src) { m_spHostContext = std::move(src.m_spHostContext); m_isDeferred = src.m_isDeferred; return *this; }
+
+    operator IDebugHostContext* () const
     {
-        ::SymbolKind symKind;
-        CheckHr(pSymbol->GetSymbolKind(&symKind));
-        return (symKind == SymbolConstant);
+        if (m_isDeferred) { return USE_CURRENT_HOST_CONTEXT; }
+        return m_spHostContext.Get();
     }
 
-    //*************************************************
-    // Constant Methods:
-    //
-
-    Constant() =default;
-    Constant(_In_ IDebugHostConstant *pConstant) : Symbol(pConstant) { }
-    Constant(_In_ ComPtr<IDebugHostConstant> spConstant) : Symbol(spConstant.Detach()) { }
-    Constant(_In_ const Constant& src) : Symbol(src) { }
-    Constant(_In_ Constant&& src) : Symbol(std::move(src)) { }
-
-    Constant& operator=(_In_ IDebugHostConstant *pConstant) { return static_cast<Constant&>(Symbol::operator=(pConstant)); }
-    Constant& operator=(_In_ ComPtr<IDebugHostConstant> spConstant) { return static_cast<Constant&>(Symbol::operator=(spConstant.Detach())); }
-    Constant& operator=(_In_ const Constant& src) { return static_cast<Constant&>(Symbol::operator=(src)); }
-    Constant& operator=(_In_ Constant&& src) { return static_cast<Constant&>(Symbol::operator=(std::move(src))); }
-
-    operator IDebugHostConstant* () const { return AsConstant(); }
-    IDebugHostConstant *operator->() const { return AsConstant(); }
+    IDebugHostContext* operator->() const
+    {
+        CheckObject();
+        return (IDebugHostContext *)(*this);
+    }
 
-    // Value():
+    // Current():
     //
-    // Returns an Object (boxed) representation of the value of the constant.
+    // Returns the current context of the host.  Within a ContextScope, this is the pinned context.  If the
+    // CurrentContextCache is enabled, this may not ask the host.
     //
-    Object Value() const;
-
-private:
+    static HostContext Current();
 
-    // AsConstant():
+    // DeferredCurrent():
     //
-    // Returns the IDebugHostConstant interface for the constant.
+    // Returns an object that refers to the current context of the host *when used*.
     //
-    IDebugHostConstant *AsConstant() const
+    static HostContext DeferredCurrent()
     {
-        return static_cast<IDebugHostConstant *>(GetSymbolInterface());
+        return HostContext(USE_CURRENT_HOST_CONTEXT);
+    }
+
+protected:
+
+    bool m_isDeferred;
+    ComPtr<IDebugHostContext> m_spHostContext;
+
+    void CheckObject() const
+    {
+        if (m_spHostContext.Get() == nullptr)
+        {
+            throw unexpected_error();
+        }
     }
 };
 
-// Field:
-//
-// Represents a field of a structure/union/class/etc...
+//**************************************************************************
+// Current Context Caching:
 //
-class Field : public Symbol
-{
-public:
 
-    using SymbolTypeInterface = IDebugHostField;
+namespace Details
+{
+    // CurrentObjectKind:
+    //
+    // The well known objects which are derived from the current context and may be cached along with it.
+    //
+    enum class CurrentObjectKind
+    {
+        RootNamespace,
+        Session,
+        Process,
+        Thread,
+        Count
+    };
 
-    // IsInstance():
+    // CurrentObjectSlots:
     //
-    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
+    // A cached context and the well known objects derived from it.
     //
-    static bool IsInstance(_In_ const Symbol& symbol)
+    struct CurrentObjectSlots
     {
-        return (symbol.SymbolKind() == SymbolField);
-    }
+        ComPtr<IDebugHostContext> Context;
+        ComPtr<IModelObject> Objects[static_cast<size_t>(CurrentObjectKind::Count)];
 
-    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+        ComPtr<IModelObject>& operator[](_In_ CurrentObjectKind kind)
+        {
+            return Objects[static_cast<size_t>(kind)];
+        }
+
+        void Clear()
+        {
+            Context = nullptr;
+            for (auto&& spObject : Objects)
+            {
+                spObject = nullptr;
+            }
+        }
+    };
+
+    inline ComPtr<IDebugHostContext> QueryCurrentContext()
     {
-        ::SymbolKind symKind;
-        CheckHr(pSymbol->GetSymbolKind(&symKind));
-        return (symKind == SymbolField);
+        ComPtr<IDebugHostContext> spContext;
+        CheckHr(GetHost()->GetCurrentContext(&spContext));
+        return spContext;
     }
+}
 
-    //*************************************************
-    // Field Methods:
-    //
-
-    Field() =default;
-    Field(_In_ IDebugHostField *pField) : Symbol(pField) { }
-    Field(_In_ ComPtr<IDebugHostField> spField) : Symbol(spField.Detach()) { }
-    Field(_In_ const Field& src) : Symbol(src) { }
-    Field(_In_ Field&& src) : Symbol(std::move(src)) { }
+// CurrentContextCache:
+//
+// An opt-in, process wide cache of the current context of the host (HostContext::Current()) and of the well known
+// objects derived from it (Object::RootNamespace(), CurrentSession(), CurrentProcess(), and CurrentThread()).  It is
+// disabled by default, in which case every such call asks the host.
+//
+// The data model does not report execution or changes of the current context.  Once enabled, the cache is kept
+// coherent by an epoch function (as with MaterializedIterable): every cached value is dropped whenever the epoch
+// changes.  The epoch must change whenever the target executes or the current context is changed (e.g.: from
+// event callbacks of the host).  Invalidate() drops every cached value explicitly.
+//
+class CurrentContextCache
+{
+public:
 
-    Field& operator=(_In_ IDebugHostField *pField) { return static_cast<Field&>(Symbol::operator=(pField)); }
-    Field& operator=(_In_ ComPtr<IDebugHostField> spField) { return static_cast<Field&>(Symbol::operator=(spField.Detach())); }
-    Field& operator=(_In_ const Field& src) { return static_cast<Field&>(Symbol::operator=(src)); }
-    Field& operator=(_In_ Field&& src) { return static_cast<Field&>(Symbol::operator=(std::move(src))); }
+    CurrentContextCache(_In_ const CurrentContextCache&) =delete;
+    CurrentContextCache& operator=(_In_ const CurrentContextCache&) =delete;
 
-    operator IDebugHostField* () const { return AsField(); }
-    IDebugHostField *operator->() const { return AsField(); }
+    static CurrentContextCache& Instance()
+    {
+        static CurrentContextCache s_cache;
+        return s_cache;
+    }
 
-    // GetLocationKind():
+    // Enable():
     //
-    // Returns the location kind of this field.
+    // Enables the cache with the given epoch function.
     //
-    LocationKind GetLocationKind() const
+    void Enable(_In_ std::function<ULONG64(void)> epochFunction)
     {
-        LocationKind locKind;
-        CheckHr(AsField()->GetLocationKind(&locKind));
-        return locKind;
+        if (!epochFunction)
+        {
+            throw std::invalid_argument("The current context cache requires an epoch function");
+        }
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_epochFunction = std::move(epochFunction);
+        m_epoch = m_epochFunction();
+        DiscardLocked();
+        m_enabled.store(true, std::memory_order_release);
     }
 
-    // GetLocation():
+    // Disable():
     //
-    // Gets the location of a field for a field which is static.
+    // Disables the cache and drops every cached value.
     //
-    Location GetLocation() const
+    void Disable()
     {
-        Location loc;
-        CheckHr(AsField()->GetLocation(&loc));
-        return loc;
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_enabled.store(false, std::memory_order_release);
+        m_epochFunction = nullptr;
+        DiscardLocked();
     }
 
-    // GetOffset():
+    bool IsEnabled() const
+    {
+        return m_enabled.load(std::memory_order_acquire);
+    }
+
+    // Invalidate():
     //
-    // Gets the offset of a field for a field which is a member.
+    // Drops every cached value.
     //
-    ULONG64 GetOffset() const
+    void Invalidate()
     {
-        ULONG64 offset;
-        CheckHr(AsField()->GetOffset(&offset));
-        return offset;
+        std::lock_guard<std::mutex> lock(m_lock);
+        DiscardLocked();
     }
 
-    // GetValue():
+    // GetContext():
     //
-    // Gets the value of a constant field as an object.
+    // Returns the current context of the host, from the cache if it is enabled and holds one for the current epoch.
     //
-    Object GetValue() const;
+    ComPtr<IDebugHostContext> GetContext()
+    {
+        if (!IsEnabled())
+        {
+            return Details::QueryCurrentContext();
+        }
 
-    bool IsMember() const { return GetLocationKind() == LocationMember; }
-    bool IsStatic() const { return GetLocationKind() == LocationStatic; }
-    bool IsConstant() const { return GetLocationKind() == LocationConstant; }
+        ULONG64 generation;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!SynchronizeLocked())
+            {
+                return Details::QueryCurrentContext();
+            }
+            if (m_slots.Context != nullptr)
+            {
+                return m_slots.Context;
+            }
+            generation = m_generation;
+        }
 
-protected:
+        ComPtr<IDebugHostContext> spContext = Details::QueryCurrentContext();
 
-    virtual bool VerifySymbol(_In_ IDebugHostSymbol *pSymbol) noexcept
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_generation == generation && m_slots.Context == nullptr)
+        {
+            m_slots.Context = spContext;
+        }
+        return spContext;
+    }
+
+    // GetCachedObject():
+    //
+    // Returns a well known object, from the cache if it is enabled and holds one for the current epoch.  compute is
+    // called without the lock held since it typically calls back into the cache.
+    //
+    ComPtr<IModelObject> GetCachedObject(_In_ Details::CurrentObjectKind kind,
+                                         _In_ const std::function<ComPtr<IModelObject>(void)>& compute)
     {
-        return pSymbol == nullptr || IsInstance(pSymbol);
+        if (!IsEnabled())
+        {
+            return compute();
+        }
+
+        ULONG64 generation;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!SynchronizeLocked())
+            {
+                return compute();
+            }
+            if (m_slots[kind] != nullptr)
+            {
+                return m_slots[kind];
+            }
+            generation = m_generation;
+        }
+
+        ComPtr<IModelObject> spObject = compute();
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_generation == generation && m_slots[kind] == nullptr)
+        {
+            m_slots[kind] = spObject;
+        }
+        return spObject;
     }
 
 private:
 
-    // AsField():
+    CurrentContextCache() : m_enabled(false), m_epoch(0), m_generation(0) { }
+
+    // SynchronizeLocked():
     //
-    // Returns the IDebugHostField interface for the module.
+    // Drops every cached value if the epoch has changed.  Returns false if the cache was disabled in the interim.
     //
-    IDebugHostField *AsField() const
+    bool SynchronizeLocked()
     {
-        return static_cast<IDebugHostField *>(GetSymbolInterface());
+        if (!m_epochFunction)
+        {
+            return false;
+        }
+
+        ULONG64 epoch = m_epochFunction();
+        if (epoch != m_epoch)
+        {
+            DiscardLocked();
+            m_epoch = epoch;
+        }
+        return true;
+    }
+
+    void DiscardLocked()
+    {
+        m_slots.Clear();
+        ++m_generation;
     }
+
+    std::atomic<bool> m_enabled;
+    std::mutex m_lock;
+    std::function<ULONG64(void)> m_epochFunction;
+    ULONG64 m_epoch;
+    ULONG64 m_generation;
+    Details::CurrentObjectSlots m_slots;
 };
 
-// BaseClass:
+// ContextScope:
 //
-// Represents a base class
+// Pins a context on the calling thread for the lifetime of the scope.  Within the scope, HostContext::Current()
+// returns the pinned context without asking the host.  Object::CurrentContext(), CurrentSession(), CurrentProcess(),
+// and CurrentThread() refer to the pinned context and are computed at most once per scope:
 //
-class BaseClass : public Symbol
+//     ContextScope scope;
+//     for (auto&& element : elements)
+//     {
+//         Object process = Object::CurrentProcess();      // Only the first iteration navigates the model
+//     }
+//
+// The default scope pins the current context (and shares what an enclosing scope has already computed).  Scopes
+// nest and must be destroyed in the reverse order of their creation.
+//
+class ContextScope
 {
 public:
 
-    using SymbolTypeInterface = IDebugHostBaseClass;
-
-    // IsInstance():
-    //
-    // Returns whether a given generic symbol actually refers (and can be converted) to a base class.
-    //
-    static bool IsInstance(_In_ const Symbol& symbol)
+    ContextScope() :
+        m_pPrevious(GetCurrentSlot())
     {
-        return (symbol.SymbolKind() == SymbolBaseClass);
+        if (m_pPrevious != nullptr)
+        {
+            m_slots = m_pPrevious->m_slots;
+        }
+        else
+        {
+            m_slots.Context = CurrentContextCache::Instance().GetContext();
+        }
+        GetCurrentSlot() = this;
     }
 
-    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    explicit ContextScope(_In_ const HostContext& context) :
+        m_pPrevious(GetCurrentSlot())
     {
-        ::SymbolKind symKind;
-        CheckHr(pSymbol->GetSymbolKind(&symKind));
-        return (symKind == SymbolBaseClass);
+        IDebugHostContext *pContext = context;
+        HostContext pinnedContext = (pContext == USE_CURRENT_HOST_CONTEXT ? HostContext::Current() : context);
+        m_slots.Context = static_cast<IDebugHostContext *>(pinnedContext);
+        GetCurrentSlot() = this;
     }
 
-    //*************************************************
-    // Base Class Methods:
-    //
+    ~ContextScope()
+    {
+        GetCurrentSlot() = m_pPrevious;
+    }
 
-    BaseClass() =default;
-    BaseClass(_In_ IDebugHostBaseClass *pBaseClass) : Symbol(pBaseClass) { }
-    BaseClass(_In_ ComPtr<IDebugHostBaseClass> spBaseClass) : Symbol(spBaseClass.Detach()) { }
-    BaseClass(_In_ const BaseClass& src) : Symbol(src) { }
-    BaseClass(_In_ BaseClass&& src) : Symbol(std::move(src)) { }
+    ContextScope(_In_ const ContextScope&) =delete;
+    ContextScope& operator=(_In_ const ContextScope&) =delete;
 
-    BaseClass& operator=(_In_ IDebugHostBaseClass *pBaseClass) { return static_cast<BaseClass&>(Symbol::operator=(pBaseClass)); }
-    BaseClass& operator=(_In_ ComPtr<IDebugHostBaseClass> spBaseClass) { return static_cast<BaseClass&>(Symbol::operator=(spBaseClass.Detach())); }
-    BaseClass& operator=(_In_ const BaseClass& src) { return static_cast<BaseClass&>(Symbol::operator=(src)); }
-    BaseClass& operator=(_In_ BaseClass&& src) { return static_cast<BaseClass&>(Symbol::operator=(std::move(src))); }
+    // GetCurrent():
+    //
+    // Returns the innermost scope on the calling thread or nullptr if there is none.
+    //
+    static ContextScope *GetCurrent()
+    {
+        return GetCurrentSlot();
+    }
 
-    operator IDebugHostBaseClass* () const { return AsBaseClass(); }
-    IDebugHostBaseClass *operator->() const { return AsBaseClass(); }
+    HostContext GetContext() const
+    {
+        return HostContext(m_slots.Context);
+    }
 
-    // GetOffset():
+    // GetCachedObject():
     //
-    // Gets the offset of a base class within its derived class.
+    // Returns a well known object for the pinned context, computing it on first use within the scope.
     //
-    ULONG64 GetOffset() const
+    ComPtr<IModelObject> GetCachedObject(_In_ Details::CurrentObjectKind kind,
+                                         _In_ const std::function<ComPtr<IModelObject>(void)>& compute)
     {
-        ULONG64 offset;
-        CheckHr(AsBaseClass()->GetOffset(&offset));
-        return offset;
+        if (m_slots[kind] == nullptr)
+        {
+            m_slots[kind] = compute();
+        }
+        return m_slots[kind];
     }
 
-protected:
+private:
 
-    virtual bool VerifySymbol(_In_ IDebugHostSymbol *pSymbol) noexcept
+    static ContextScope *& GetCurrentSlot()
     {
-        return pSymbol == nullptr || IsInstance(pSymbol);
+        static thread_local ContextScope *s_pCurrent = nullptr;
+        return s_pCurrent;
     }
 
-private:
+    ContextScope *m_pPrevious;
+    Details::CurrentObjectSlots m_slots;
+};
 
-    // AsBaseClass():
+inline HostContext HostContext::Current()
+{
+    ContextScope *pScope = ContextScope::GetCurrent();
+    if (pScope != nullptr)
+    {
+        return pScope->GetContext();
+    }
+    return HostContext(CurrentContextCache::Instance().GetContext());
+}
+
+namespace Details
+{
+    // GetCurrentObject():
     //
-    // Returns the IDebugHostBaseClass interface for the base class
+    // Returns a well known object from the innermost context scope or from the current context cache.
     //
-    IDebugHostBaseClass *AsBaseClass() const
+    inline ComPtr<IModelObject> GetCurrentObject(_In_ CurrentObjectKind kind,
+                                                 _In_ const std::function<ComPtr<IModelObject>(void)>& compute)
     {
-        return static_cast<IDebugHostBaseClass *>(GetSymbolInterface());
+        ContextScope *pScope = ContextScope::GetCurrent();
+        if (pScope != nullptr)
+        {
+            return pScope->GetCachedObject(kind, compute);
+        }
+        return CurrentContextCache::Instance().GetCachedObject(kind, compute);
     }
-};
+}
 
-// BitFieldInformation:
+//**************************************************************************
+// Named Model Caching:
 //
-// Defines a bitfield type.
+
+// NamedModelCache:
 //
-struct BitFieldInformation
-{
-    ULONG Lsb;
-    ULONG Length;
-};
-
-// Type:
+// A process wide cache of the models which are resolved by name through the data model manager
+// (Object::FromModelName() and the parent model records of ProviderEx: NamedModelParent, NamespacePropertyParent,
+// and FilteredNamespacePropertyParent).  The cache is disabled by default, in which case every resolution asks the
+// manager.  Defining DBGMODELCLIENTEX_NAMED_MODEL_CACHE before including the header enables it from the start.
 //
-// Represents a type object.
+// Registrations made through the library (ProviderEx::NamedModelRegistration and the namespaces acquired by the
+// namespace parents) refresh the cache as they are applied and unapplied.  A model which is registered or
+// unregistered directly through IDataModelManager must be dropped with Invalidate().  As the cache holds references
+// to models, it should be invalidated before the extension is unloaded (e.g.: in DebugExtensionUninitialize).
 //
-class Type : public Symbol
+// Whether or not the cache is enabled, it also tracks the parent models attached by the records of extensions.  A
+// model which is attached as a parent of the same object by more than one record is attached once, and the link is
+// only removed when the last record which attached it is unapplied.  Each outstanding attachment holds references
+// to both objects so that neither address can be reused by another object while it is tracked.
+//
+class NamedModelCache
 {
 public:
 
-    using SymbolTypeInterface = IDebugHostType;
-
-    // IsInstance():
-    //
-    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
-    //
-    static bool IsInstance(_In_ const Symbol& symbol)
-    {
-        return (symbol.SymbolKind() == SymbolType);
-    }
+    NamedModelCache(_In_ const NamedModelCache&) =delete;
+    NamedModelCache& operator=(_In_ const NamedModelCache&) =delete;
 
-    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    static NamedModelCache& Instance()
     {
-        ::SymbolKind symKind;
-        CheckHr(pSymbol->GetSymbolKind(&symKind));
-        return (symKind == SymbolType);
+        static NamedModelCache s_cache;
+        return s_cache;
     }
 
-    Type() =default;
-    Type(_In_ IDebugHostType *pType) : Symbol(pType) { }
-    Type(_In_ ComPtr<IDebugHostType> spType) : Symbol(spType.Detach()) { }
-    Type(_In_ const Type& src) : Symbol(src) { }
-    Type(_In_ Type&& src) : Symbol(std::move(src)) { }
-
-    Type& operator=(_In_ IDebugHostType *pType) { return static_cast<Type&>(Symbol::operator=(pType)); }
-    Type& operator=(_In_ ComPtr<IDebugHostType> spType) { return static_cast<Type&>(Symbol::operator=(spType.Detach())); }
-    Type& operator=(_In_ const Type& src) { return static_cast<Type&>(Symbol::operator=(src)); }
-    Type& operator=(_In_ Type&& src) { return static_cast<Type&>(Symbol::operator=(std::move(src))); }
-
-    operator IDebugHostType* () const { return AsType(); }
-    IDebugHostType *operator->() const { return AsType(); }
-
-    Type(_In_ const Module& module, _In_z_ const wchar_t *pTypeName)
+    // Enable():
+    //
+    // Enables or disables the cache.  Disabling it drops every cached model.
+    //
+    void Enable(_In_ bool enabled = true)
     {
-        ComPtr<IDebugHostType> spType;
-        CheckHr(module->FindTypeByName(pTypeName, &spType));
-        AssignSymbol(spType.Detach());
+        std::map<std::wstring, ComPtr<IModelObject>, std::less<>> discarded;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_enabled.store(enabled, std::memory_order_release);
+            if (!enabled)
+            {
+                discarded.swap(m_models);
+                ++m_generation;
+            }
+        }
     }
 
-    Type(_In_ const Module& module, _In_ const std::wstring& typeName) : Type(module, typeName.c_str()) { }
-
-    template<typename TStr1, typename TStr2>
-    Type(_In_ const HostContext& moduleContext, _In_ TStr1&& moduleName, _In_ TStr2&& typeName)
+    bool IsEnabled() const
     {
-        Module typeMod(moduleContext, Details::ExtractString(moduleName));
-        Type ty(typeMod, Details::ExtractString(typeName));
-        *this = ty;
+        return m_enabled.load(std::memory_order_acquire);
     }
 
-    // GetKind():
+    // AcquireNamedModel():
     //
-    // Gets the kind of type (e.g.: struct, pointer, etc...)
+    // Resolves a model by name, from the cache if it is enabled and has already resolved the name.  This has the
+    // semantics of IDataModelManager::AcquireNamedModel.
     //
-    TypeKind GetKind() const
+    HRESULT AcquireNamedModel(_In_z_ const wchar_t *pModelName, _COM_Outptr_ IModelObject **ppModel)
     {
-        CheckObject();
+        *ppModel = nullptr;
+        if (!IsEnabled())
+        {
+            return GetManager()->AcquireNamedModel(pModelName, ppModel);
+        }
 
-        TypeKind tk;
-        CheckHr(AsType()->GetTypeKind(&tk));
-        return tk;
-    }
+        try
+        {
+            ULONG64 generation;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto it = m_models.find(std::wstring_view(pModelName));
+                if (it != m_models.end())
+                {
+                    ComPtr<IModelObject> spModel = it->second;
+                    *ppModel = spModel.Detach();
+                    return S_OK;
+                }
+                generation = m_generation;
+            }
 
-    // BaseType():
-    //
-    // Gets the base type (e.g.: pointed-to-type, array-of-type, etc...)
-    //
-    Type BaseType() const
-    {
-        CheckObject();
+            ComPtr<IModelObject> spModel;
+            HRESULT hr = GetManager()->AcquireNamedModel(pModelName, &spModel);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
 
-        ComPtr<IDebugHostType> spType;
-        CheckHr(AsType()->GetBaseType(&spType));
-        return Type(std::move(spType));
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (m_generation == generation && IsEnabled())
+                {
+                    //
+                    // If another thread resolved the same name in the interim, the first insertion wins.
+                    //
+                    auto result = m_models.emplace(std::wstring(pModelName), spModel);
+                    spModel = result.first->second;
+                }
+            }
+
+            *ppModel = spModel.Detach();
+        }
+        catch(...)
+        {
+            return Details::Exceptions::ReturnResult(std::current_exception());
+        }
+
+        return S_OK;
     }
 
-    // Size():
+    // Update():
     //
-    // Gets the size of the type.
+    // Records the model which is now known by the given name (e.g.: because it was just registered).
     //
-    ULONG64 Size() const
+    void Update(_In_z_ const wchar_t *pModelName, _In_ IModelObject *pModel)
     {
-        CheckObject();
+        if (!IsEnabled())
+        {
+            return;
+        }
 
-        ULONG64 size;
-        CheckHr(AsType()->GetSize(&size));
-        return size;
+        ComPtr<IModelObject> spDiscarded;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto it = m_models.find(std::wstring_view(pModelName));
+            if (it != m_models.end())
+            {
+                spDiscarded = std::move(it->second);
+                it->second = pModel;
+            }
+            else
+            {
+                m_models.emplace(std::wstring(pModelName), pModel);
+            }
+            ++m_generation;
+        }
     }
 
-    //*************************************************
-    // Structure/Union/Class Methods:
-    //
-
-    // Fields():
+    // Invalidate():
     //
-    // Returns a collection of all of the fields within this type (*NOT* including those within base classes)
+    // Drops the cached model for the given name.
     //
-    Details::SymbolChildrenRef<Type, Field> Fields() const
+    void Invalidate(_In_z_ const wchar_t *pModelName)
     {
-        CheckObject();
-        return Details::SymbolChildrenRef<Type, Field>(*this, SymbolField);
+        ComPtr<IModelObject> spDiscarded;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto it = m_models.find(std::wstring_view(pModelName));
+            if (it != m_models.end())
+            {
+                spDiscarded = std::move(it->second);
+                m_models.erase(it);
+            }
+            ++m_generation;
+        }
     }
 
-    // BaseClasses():
+    // Invalidate():
     //
-    // Returns a collection of all of the base classes of this type (*NOT* including base classes of base classes)
+    // Drops every cached model.
     //
-    Details::SymbolChildrenRef<Type, BaseClass> BaseClasses() const
+    void Invalidate()
     {
-        CheckObject();
-        return Details::SymbolChildrenRef<Type, BaseClass>(*this, SymbolBaseClass);
+        std::map<std::wstring, ComPtr<IModelObject>, std::less<>> discarded;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            discarded.swap(m_models);
+            ++m_generation;
+        }
     }
 
-    //*************************************************
-    // Intrinsic Information:
-    //
-
-    // IsIntrinsic():
+    // AttachParentModel():
     //
-    // Returns whether the type represents an intrinsic.
+    // Adds pParentModel as a parent model of pObject unless a previous attachment of the same parent to the same
+    // object is still outstanding.
     //
-    bool IsIntrinsic() const
+    HRESULT AttachParentModel(_In_ IModelObject *pObject, _In_ IModelObject *pParentModel)
     {
-        CheckObject();
-        return (GetKind() == TypeIntrinsic);
+        try
+        {
+            //
+            // The lock is held across the call into the manager so that the attachment counts always reflect the
+            // links which actually exist.
+            //
+            std::lock_guard<std::mutex> lock(m_attachmentLock);
+            auto result = m_attachments.emplace(Attachment { pObject, pParentModel }, 0);
+            if (result.first->second == 0)
+            {
+                HRESULT hr = pObject->AddParentModel(pParentModel, nullptr, false);
+                if (FAILED(hr))
+                {
+                    m_attachments.erase(result.first);
+                    return hr;
+                }
+            }
+            ++result.first->second;
+        }
+        catch(...)
+        {
+            return Details::Exceptions::ReturnResult(std::current_exception());
+        }
+
+        return S_OK;
     }
 
-    // IntrinsicKind():
+    // DetachParentModel():
     //
-    // Returns the kind of an intrinsic.
+    // Releases an attachment made by AttachParentModel.  The parent model is removed from the object when the last
+    // outstanding attachment is released.
     //
-    ::IntrinsicKind IntrinsicKind() const
+    HRESULT DetachParentModel(_In_ IModelObject *pObject, _In_ IModelObject *pParentModel)
     {
-        CheckObject();
-        if (!IsIntrinsic())
+        std::lock_guard<std::mutex> lock(m_attachmentLock);
+        auto it = m_attachments.find(Attachment { pObject, pParentModel });
+        if (it != m_attachments.end() && --it->second != 0)
         {
-            throw illegal_operation("Object must be an intrinsic");
+            return S_OK;
         }
-
-        ::IntrinsicKind ik;
-        VARTYPE carrier;
-        CheckHr(AsType()->GetIntrinsicType(&ik, &carrier));
-        return ik;
+        if (it != m_attachments.end())
+        {
+            m_attachments.erase(it);
+        }
+        return pObject->RemoveParentModel(pParentModel);
     }
 
-    // IntrinsicCarrier():
+private:
+
+#ifdef DBGMODELCLIENTEX_NAMED_MODEL_CACHE
+    NamedModelCache() : m_enabled(true), m_generation(0) { }
+#else
+    NamedModelCache() : m_enabled(false), m_generation(0) { }
+#endif // DBGMODELCLIENTEX_NAMED_MODEL_CACHE
+
+    // Attachment:
     //
-    // Returns the carrier type for an intrinsic (how it packs)
+    // The key of an attachment.  It holds references to the object and its parent model.
     //
-    VARTYPE IntrinsicCarrier() const
+    struct Attachment
     {
-        CheckObject();
-        if (!IsIntrinsic())
+        ComPtr<IModelObject> AttachedObject;
+        ComPtr<IModelObject> ParentModel;
+
+        bool operator<(_In_ const Attachment& rhs) const
         {
-            throw illegal_operation("Object must be an intrinsic");
+            return std::make_pair(AttachedObject.Get(), ParentModel.Get()) < std::make_pair(rhs.AttachedObject.Get(), rhs.ParentModel.Get());
         }
+    };
 
-        ::IntrinsicKind ik;
-        VARTYPE carrier;
-        CheckHr(AsType()->GetIntrinsicType(&ik, &carrier));
-        return carrier;
-    }
+    std::atomic<bool> m_enabled;
+    std::mutex m_lock;
+    ULONG64 m_generation;
+    std::map<std::wstring, ComPtr<IModelObject>, std::less<>> m_models;
 
-    //*************************************************
-    // BitField Information:
-    //
+    std::mutex m_attachmentLock;
+    std::map<Attachment, ULONG> m_attachments;
+};
 
-    // IsBitField():
+// Symbol:
+//
+// Class for a generic symbol.  In addition to being the base class for more specific symbol types
+// (e.g.: Types, Modules, Fields, etc...), this can be instantiated over top any such symbol for base symbol
+// functionality.
+//
+class Symbol
+{
+public:
+
+    using SymbolTypeInterface = IDebugHostSymbol;
+
+    // IsInstance():
     //
-    // Returns whether the type represents a bitfield.
+    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
     //
-    bool IsBitField() const
+    static bool IsInstance(_In_ const Symbol& /*symbol*/)
     {
-        CheckObject();
-        ULONG lsb, length;
-        if (FAILED(AsType()->GetBitField(&lsb, &length)))
-        {
-            return false;
-        }
         return true;
     }
 
-    // BitField():
-    //
-    // Returns information about a bit field type.
-    //
-    BitFieldInformation BitField() const
+    static bool IsInstance(_In_ IDebugHostSymbol * /*pSymbol*/)
     {
-        CheckObject();
-        BitFieldInformation info;
-        CheckHr(AsType()->GetBitField(&info.Lsb, &info.Length));
-        return info;
+        return true;
     }
 
     //*************************************************
-    // Pointer Methods:
+    // General Symbol Methods:
     //
 
-    // IsPointer():
-    //
-    // Returns whether the type represents any kind of pointer.
-    //
-    bool IsPointer() const
-    {
-        CheckObject();
-        auto kind = GetKind();
-        return (kind == TypePointer || kind == TypeMemberPointer);
-    }
+    Symbol() =default;
+    Symbol(_In_ IDebugHostSymbol *pSymbol) : m_spSymbol(pSymbol) { }
+    Symbol(_In_ ComPtr<IDebugHostSymbol> spSymbol) : m_spSymbol(std::move(spSymbol)) { }
+    Symbol(_In_ const Symbol& src) =default;
+    Symbol(_In_ Symbol&& src) =default;
 
-    // GetPointerKind()
+    Symbol& operator=(_In_ IDebugHostSymbol *pSymbol) { AssignSymbol(pSymbol); return *this; }
+    Symbol& operator=(_In_ ComPtr<IDebugHostSymbol> spSymbol) { MoveSymbol(std::move(spSymbol)); return *this; }
+    Symbol& operator=(_In_ const Symbol& src) { AssignSymbol(src.m_spSymbol.Get()); return *this; }
+    Symbol& operator=(_In_ Symbol&& src) { MoveSymbol(std::move(src.m_spSymbol)); return *this; }
+
+    operator IDebugHostSymbol* () const { return m_spSymbol.Get(); }
+    IDebugHostSymbol *operator->() const { return m_spSymbol.Get(); }
+
+    // operator==/!=():
     //
-    // Gets the kind of pointer (e.g.: standard, reference, etc...).  This may only legally be called on a pointer.
+    // Compares two symbols for equality (not equivalence).  Two different typedefs to the same type
+    // will still not compare equally.
     //
-    PointerKind GetPointerKind() const
+    bool operator==(_In_ const IDebugHostSymbol *pOtherSymbol) const
     {
-        CheckObject();
+        if (m_spSymbol.Get() == pOtherSymbol) { return true; }
+        if (IsEmpty() || pOtherSymbol == nullptr) { return false; }
 
-        if (!IsPointer())
-        {
-            throw illegal_operation("Object must be a pointer");
-        }
-
-        PointerKind pk;
-        CheckHr(AsType()->GetPointerKind(&pk));
-        return pk;
+        bool result;
+        CheckHr(m_spSymbol->CompareAgainst(const_cast<IDebugHostSymbol *>(pOtherSymbol), 0, &result));
+        return result;
     }
-
-    // PointerMemberType():
-    //
-    // For pointer-to-member (of class), this returns the class which the pointer is a member of.
-    //
-    ClientEx::Type PointerMemberType() const
+    bool operator==(_In_ const Symbol& otherSymbol) const
     {
-        CheckObject();
-        if (GetKind() != TypeMemberPointer)
-        {
-            throw illegal_operation("Object must be a member pointer");
-        }
+        if (m_spSymbol.Get() == otherSymbol.m_spSymbol.Get()) { return true; }
+        if (IsEmpty() || otherSymbol.IsEmpty()) { return false; }
 
-        ComPtr<IDebugHostType> spMemberType;
-        CheckHr(AsType()->GetMemberType(&spMemberType));
-        return ClientEx::Type(std::move(spMemberType));
+        bool result;
+        CheckHr(m_spSymbol->CompareAgainst(otherSymbol, 0, &result));
+        return result;
     }
 
-    //*************************************************
-    // Array Methods:
-    //
+    bool operator!=(_In_ const IDebugHostSymbol *pOtherSymbol) const
+    {
+        return !operator==(pOtherSymbol);
+    }
+    bool operator!=(_In_ const Symbol& otherSymbol) const
+    {
+        return !operator==(otherSymbol);
+    }
 
-    // IsArray():
+    // IsEmpty():
     //
-    // Indicates whether the type represents any kind of array.
+    // Indicates whether there is an underlying type or not.
     //
-    bool IsArray() const
-    {
-        CheckObject();
-        return (GetKind() == TypeArray);
-    }
+    bool IsEmpty() const { return m_spSymbol.Get() == nullptr; }
 
-    // ArrayDimensions():
+    // SymbolKind():
     //
-    // Returns a collection of all of the array dimensions of the type.
+    // Gets the kind of symbol that this is.
     //
-    Details::ArrayDimensionsRef ArrayDimensions() const
+    SymbolKind SymbolKind() const
     {
-        CheckObject();
-
-        if (!IsArray())
-        {
-            throw illegal_operation("Object must be an array");
-        }
-
-        return Details::ArrayDimensionsRef(AsType());
+        ::SymbolKind kind;
+        CheckHr(m_spSymbol->GetSymbolKind(&kind));
+        return kind;
     }
 
-    //*************************************************
-    // Generics (Templates) Methods:
-    //
-
-    // IsGeneric():
+    // GetSymbolInterface():
     //
-    // An indication of whether the type is a generic (e.g.: a C++ template, a C# generic, etc...)
+    // Gets the underlying interface for the symbol.
     //
-    bool IsGeneric() const
+    IDebugHostSymbol *GetSymbolInterface() const
     {
-        CheckObject();
-
-        bool isGeneric;
-        CheckHr(AsType()->IsGeneric(&isGeneric));
-        return isGeneric;
+        return m_spSymbol.Get();
     }
 
-    // GenericArguments():
+    // Name():
     //
-    // Returns a collection of all of the generic arguments of this type (which are all symbols -- some may
-    // be types, some may be constants)
+    // Gets the name of the symbol.
     //
-    Details::GenericArgumentsRef<Symbol> GenericArguments() const
+    std::wstring Name() const
     {
         CheckObject();
 
-        if (!IsGeneric())
-        {
-            throw illegal_operation("Object must be a generic");
-        }
-
-        return Details::GenericArgumentsRef<Symbol>(AsType());
+        BSTR name;
+        CheckHr(m_spSymbol->GetName(&name));
+        bstr_ptr spName(name);
+        return std::wstring(name);
     }
 
-    //*************************************************
-    // Function Methods:
+    // Type():
+    //
+    // Gets the type of the symbol (if such has a type; an exception is thrown otherwise)
     //
+    Type Type() const;
 
-    // IsFunction():
+    // ContainingModule():
     //
-    // An indication of whether the type is a function type.
+    // Gets the containing module of the symbol.
     //
-    bool IsFunction() const
-    {
-        CheckObject();
-        return (GetKind() == TypeFunction);
-    }
+    Module ContainingModule() const;
 
-    // CallingConvention():
+    // Children():
     //
-    // Returns the calling convention of a function type.
+    // Returns a collection of all of the children of this symbol.
     //
-    CallingConventionKind CallingConvention() const
+    Details::SymbolChildrenRef<Symbol, Symbol> Children() const
     {
         CheckObject();
-        if (!IsFunction())
-        {
-            throw illegal_operation("Object must be a function");
-        }
-
-        CallingConventionKind convKind;
-        CheckHr(AsType()->GetFunctionCallingConvention(&convKind));
-        return convKind;
+        return Details::SymbolChildrenRef<Symbol, Symbol>(*this, SymbolKind::Symbol);
     }
 
-    // ReturnType():
+    // Language():
     //
-    // Retunrs the return type of a function type.
+    // Returns the language in which the symbol is defined.  This may often return LanguageUnknown.
     //
-    ClientEx::Type ReturnType() const
+    LanguageKind Language() const
     {
         CheckObject();
-        if (!IsFunction())
-        {
-            throw illegal_operation("Object must be a function");
-        }
-
-        ComPtr<IDebugHostType> spReturnType;
-        CheckHr(AsType()->GetFunctionReturnType(&spReturnType));
-        return ClientEx::Type(std::move(spReturnType));
+        ComPtr<IDebugHostSymbol2> spSymbol2;
+        CheckHr(m_spSymbol.As(&spSymbol2));
+        LanguageKind lang;
+        CheckHr(spSymbol2->GetLanguage(&lang));
+        return lang;
     }
 
-    // HasInstancePointerType():
-    //
-    // Returns whether or not a given function type has an instance pointer (implicit 'this' argument)
-    //
-    bool HasInstancePointerType() const
+protected:
+
+    void AssignSymbol(_In_ IDebugHostSymbol *pSymbol)
     {
-        CheckObject();
-        if (!IsFunction())
-        {
-            throw illegal_operation("Object must be a function");
-        }
-        ComPtr<IDebugHostType2> spType2;
-        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
-        ComPtr<IDebugHostType2> spInstancePointerType;
-        if (FAILED(spType2->GetFunctionInstancePointerType(&spInstancePointerType)))
-        {
-            return false;
-        }
-        return true;
+        CheckSymbol(pSymbol);
+        m_spSymbol = pSymbol;
     }
 
-    // InstancePointerType():
-    //
-    // Returns the type of any implicit instance pointer to the function type ('this' pointer)
-    //
-    ClientEx::Type InstancePointerType() const
+    void MoveSymbol(_In_ ComPtr<IDebugHostSymbol>&& srcSymbol)
     {
-        CheckObject();
-        if (!IsFunction())
-        {
-            throw illegal_operation("Object must be a function");
-        }
-        ComPtr<IDebugHostType2> spType2;
-        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
-        ComPtr<IDebugHostType2> spInstancePointerType;
-        CheckHr(spType2->GetFunctionInstancePointerType(&spInstancePointerType));
-        return ClientEx::Type(std::move(spInstancePointerType));
+        CheckSymbol(srcSymbol.Get());
+        m_spSymbol = std::move(srcSymbol);
     }
 
-    // IsVarArgs():
+    // VerifySymbol():
     //
-    // Returns whether a function type is varargs (of any style)
+    // Verifies that the given symbol can legally be assigned to the given instance.  Derived classes
+    // must type check the symbol.
     //
-    bool IsVarArgs() const
+    virtual bool VerifySymbol(_In_ IDebugHostSymbol * /*pSymbol*/) noexcept
     {
-        return VarArgsKind() != VarArgsNone;
+        return true;
     }
 
-    // VarArgsKind():
-    //
-    // Returns what style of varargs a given funtion type is.
-    //
-    ::VarArgsKind VarArgsKind() const
+    void CheckObject() const
     {
-        CheckObject();
-        if (!IsFunction())
+        if (m_spSymbol.Get() == nullptr)
         {
-            throw illegal_operation("Object must be a function");
+            throw unexpected_error();
         }
-        ComPtr<IDebugHostType2> spType2;
-        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
-        ::VarArgsKind varKind;
-        CheckHr(spType2->GetFunctionVarArgsKind(&varKind));
-        return varKind;
     }
 
-    // ParameterTypes():
-    //
-    // Returns a collection of the parameter types of a function type.
-    //
-    Details::ParameterTypesRef<ClientEx::Type> ParameterTypes() const
+private:
+
+    void CheckSymbol(_In_ IDebugHostSymbol *pSymbol)
     {
-        CheckObject();
-        if (!IsFunction())
+        if (pSymbol != nullptr && !VerifySymbol(pSymbol))
         {
-            throw illegal_operation("Object must be a function");
+            throw std::bad_cast();
         }
-        return Details::ParameterTypesRef<ClientEx::Type>(AsType());
     }
 
+    // Depending on the symbol, this *MAY* hold something which is IDebugHostSymbol derived.
+    ComPtr<IDebugHostSymbol> m_spSymbol;
+
+};
+
+// SymbolWithOffset:
+//
+// A symbol paired with an offset from that symbol.
+//
+typedef std::pair<Symbol, ULONG64> SymbolWithOffset;
+
+// Module:
+//
+// Represents a module object.
+//
+class Module : public Symbol
+{
+public:
+
+    using SymbolTypeInterface = IDebugHostModule;
+
     //*************************************************
-    // Typedef Methods:
+    // Factory Methods:
     //
 
-    // IsTypedef():
+    // IsInstance():
     //
-    // Returns whether the type is a typedef.  All other methods not specific to typedefs will behave
-    // as they would on the final underlying type.
+    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
     //
-    bool IsTypedef() const
+    static bool IsInstance(_In_ const Symbol& symbol)
     {
-        CheckObject();
-        ComPtr<IDebugHostType2> spType2;
-        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
-        bool isTypedef;
-        CheckHr(spType2->IsTypedef(&isTypedef));
-        return isTypedef;
+        return (symbol.SymbolKind() == SymbolModule);
     }
 
-    // TypedefBaseType():
+    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    {
+        ::SymbolKind symKind;
+        CheckHr(pSymbol->GetSymbolKind(&symKind));
+        return (symKind == SymbolModule);
+    }
+
+    // FromLocation():
     //
-    // For a type which is a typedef, this will return the type that the typedef refers to (which may itself
-    // be another typedef).
+    // Returns a module from a given location (address) within a context
     //
-    ClientEx::Type TypedefBaseType() const
+    static Module FromLocation(_In_ const HostContext& moduleContext, _In_ const Location& locationWithinModule)
     {
-        CheckObject();
-        ComPtr<IDebugHostType2> spType2;
-        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
-        ComPtr<IDebugHostType2> spBaseType;
-        CheckHr(spType2->GetTypedefBaseType(&spBaseType));
-        return ClientEx::Type(std::move(spBaseType));
+        ComPtr<IDebugHostSymbols> spHostSym;
+        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+
+        ComPtr<IDebugHostModule> spModule;
+        CheckHr(spHostSym->FindModuleByLocation(moduleContext, locationWithinModule, &spModule));
+        return Module(std::move(spModule));
     }
 
-    // TypedefFinalBaseType():
+    //*************************************************
+    // Module Methods:
     //
-    // For a type which is a typedef, this will return the final type that the typedef refers to (effectively
-    // doing TypedefBaseType until reaching something which is not a typedef).
+
+    Module() { }
+    Module(_In_ IDebugHostModule *pModule) : Symbol(pModule) { }
+    Module(_In_ ComPtr<IDebugHostModule> spModule) : Symbol(spModule.Detach()) { }
+    Module(_In_ const Module& src) : Symbol(src) { }
+    Module(_In_ Module&& src) : Symbol(std::move(src)) { }
+
+    Module& operator=(_In_ IDebugHostModule *pModule) { return static_cast<Module&>(Symbol::operator=(pModule)); }
+    Module& operator=(_In_ ComPtr<IDebugHostModule> spModule) { return static_cast<Module&>(Symbol::operator=(spModule.Detach())); }
+    Module& operator=(_In_ const Module& src) { return static_cast<Module&>(Symbol::operator=(src)); }
+    Module& operator=(_In_ Module&& src) { return static_cast<Module&>(Symbol::operator=(std::move(src))); }
+
+    operator IDebugHostModule* () const { return AsModule(); }
+    IDebugHostModule *operator->() const { return AsModule(); }
+
+    template<typename TStr>
+    Module(_In_ const HostContext& moduleContext, TStr&& moduleName)
+    {
+        ComPtr<IDebugHostSymbols> spHostSym;
+        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+
+        ComPtr<IDebugHostModule> spModule;
+        CheckHr(spHostSym->FindModuleByName(moduleContext, Details::ExtractString(moduleName), &spModule));
+        AssignSymbol(spModule.Detach());
+    }
+
+    // BaseLocation():
     //
-    ClientEx::Type TypedefFinalBaseType() const
+    // Gets the base location of the module.
+    //
+    Location BaseLocation() const
     {
         CheckObject();
-        ComPtr<IDebugHostType2> spType2;
-        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
-        ComPtr<IDebugHostType2> spFinalBaseType;
-        CheckHr(spType2->GetTypedefFinalBaseType(&spFinalBaseType));
-        return ClientEx::Type(std::move(spFinalBaseType));
+
+        Location moduleBase;
+        CheckHr(AsModule()->GetBaseLocation(&moduleBase));
+        return moduleBase;
+    }
+
+    // TryGetContainingSymbol():
+    //
+    // Attempts to lookup a symbol from a given offset into the module (an RVA).  If the symbol can be found,
+    // it and the delta to the base of the symbol are returned (along with true).  If the symbol cannot be found,
+    // false is returned.
+    //
+    std::optional<SymbolWithOffset> TryGetContainingSymbol(_In_ ULONG64 moduleOffset) const
+    {
+        std::optional<SymbolWithOffset> symbolWithOffset;
+
+        ComPtr<IDebugHostModule2> spModule2;
+        ComPtr<IDebugHostSymbol> spSym;
+        ULONG64 offset;
+
+        if (SUCCEEDED(AsModule()->QueryInterface(IID_PPV_ARGS(&spModule2))) &&
+            SUCCEEDED(spModule2->FindContainingSymbolByRVA(moduleOffset, &spSym, &offset)))
+        {
+            symbolWithOffset = std::make_pair(Symbol(std::move(spSym)), offset);
+        }
+
+        return symbolWithOffset;
+    }
+    bool TryGetContainingSymbol(_In_ ULONG64 moduleOffset, _Out_ SymbolWithOffset *pResultSymbol) const
+    {
+        auto sym = TryGetContainingSymbol(moduleOffset);
+        if (sym)
+        {
+            *pResultSymbol = sym.value();
+            return true;
+        }
+        return false;
+    }
+
+    // GetContainingSymbol():
+    //
+    // Looks up a symbol from a given offset into the module and returns the symbol and the delta to the base of
+    // the symbol.  If such symbol cannot be found (e.g.: symbols cannot be loaded or there is no symbol at the
+    // given offset), an exception is thrown.
+    //
+    SymbolWithOffset GetContainingSymbol(_In_ ULONG64 moduleOffset) const
+    {
+        SymbolWithOffset symOffs;
+        if (!TryGetContainingSymbol(moduleOffset, &symOffs))
+        {
+            CheckHr(E_FAIL);
+        }
+        return symOffs;
+    }
+
+    // FindType():
+    //
+    // Finds a type by name within the module.
+    //
+    template<typename TStr>
+    ClientEx::Type FindType(_In_ TStr&& typeName) const;
+
+    // FindSymbol():
+    //
+    // Finds a symbol by name within the module.
+    //
+    template<typename TStr>
+    Symbol FindSymbol(_In_ TStr&& symbolName) const
+    {
+        ComPtr<IDebugHostSymbol> spSymbol;
+        CheckHr(AsModule()->FindSymbolByName(Details::ExtractString(symbolName), &spSymbol));
+        return Symbol(std::move(spSymbol));
     }
 
 protected:
@@ -2282,5971 +3582,13269 @@ protected:
 
 private:
 
-    // AsType():
+    // AsModule():
     //
-    // Returns the IDebugHostType interface for the type.
+    // Returns the IDebugHostModule interface for the module.
     //
-    IDebugHostType *AsType() const
+    IDebugHostModule *AsModule() const
     {
-        return static_cast<IDebugHostType *>(GetSymbolInterface());
+        return static_cast<IDebugHostModule *>(GetSymbolInterface());
     }
-};
 
-template<typename TDestSymbol> TDestSymbol symbol_cast(_In_ const Symbol& src) { return symbol_cast<TDestSymbol>(src.GetSymbolInterface()); };
+};
 
-//**************************************************************************
-// Internal Implementation Details for Objects and Metadata:
+// Constant:
 //
-
-namespace Details
+// Represents a constant within symbols...
+//
+class Constant : public Symbol
 {
-    // PointerIndexerAdapter:
+public:
+
+    using SymbolTypeInterface = IDebugHostConstant;
+
+    // IsInstance():
     //
-    // An pointer math indexer adapter.  This is *NOT* a real concept which gets attached.  Rather it is an adapter
-    // such that IndexableReference<> can operate on pointers without being aware.
+    // Returns whether a given generic symbol actually refers (and can be converted) to a constant.
     //
-    class PointerIndexerAdapter :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IIndexableConcept
-            >
+    static bool IsInstance(_In_ const Symbol& symbol)
     {
-    public:
+        return (symbol.SymbolKind() == SymbolConstant);
+    }
 
-        //*************************************************
-        // IIndexableConcept:
-        //
+    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    {
+        ::SymbolKind symKind;
+        CheckHr(pSymbol->GetSymbolKind(&symKind));
+        return (symKind == SymbolConstant);
+    }
 
-        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
-                                       _In_ ULONG64 *pDimensionality)
-        {
-            *pDimensionality = 1;
-            return S_OK;
-        }
+    //*************************************************
+    // Constant Methods:
+    //
 
-        // GetAt():
-        //
-        // Abstraction for pointer[i] where i is the indexer set.
-        //
-        IFACEMETHOD(GetAt)(_In_ IModelObject *pContextObject,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject **ppIndexers,
-                           _COM_Errorptr_ IModelObject **ppObject,
-                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
-        {
-            *ppObject = nullptr;
-            if (ppMetadata != nullptr)
-            {
-                *ppMetadata = nullptr;
-            }
+    Constant() =default;
+    Constant(_In_ IDebugHostConstant *pConstant) : Symbol(pConstant) { }
+    Constant(_In_ ComPtr<IDebugHostConstant> spConstant) : Symbol(spConstant.Detach()) { }
+    Constant(_In_ const Constant& src) : Symbol(src) { }
+    Constant(_In_ Constant&& src) : Symbol(std::move(src)) { }
 
-            try
-            {
-                if (indexerCount != 1)
-                {
-                    throw illegal_operation("Pointer indexing may only be single dimensional");
-                }
+    Constant& operator=(_In_ IDebugHostConstant *pConstant) { return static_cast<Constant&>(Symbol::operator=(pConstant)); }
+    Constant& operator=(_In_ ComPtr<IDebugHostConstant> spConstant) { return static_cast<Constant&>(Symbol::operator=(spConstant.Detach())); }
+    Constant& operator=(_In_ const Constant& src) { return static_cast<Constant&>(Symbol::operator=(src)); }
+    Constant& operator=(_In_ Constant&& src) { return static_cast<Constant&>(Symbol::operator=(std::move(src))); }
 
-                ULONG64 ptrValue;
-                ComPtr<IDebugHostType> spBaseType;
-                GetAdjustedLocationAndBaseType(pContextObject, ppIndexers[0], &ptrValue, &spBaseType);
+    operator IDebugHostConstant* () const { return AsConstant(); }
+    IDebugHostConstant *operator->() const { return AsConstant(); }
 
+    // Value():
+    //
+    // Returns an Object (boxed) representation of the value of the constant.
+    //
+    Object Value() const;
 
-                ComPtr<IDebugHostContext> spCtx;
-                CheckHr(pContextObject->GetContext(&spCtx));
+private:
 
-                ComPtr<IModelObject> spObject;
-                CheckHr(GetManager()->CreateTypedObject(spCtx.Get(), ptrValue, spBaseType.Get(), &spObject));
+    // AsConstant():
+    //
+    // Returns the IDebugHostConstant interface for the constant.
+    //
+    IDebugHostConstant *AsConstant() const
+    {
+        return static_cast<IDebugHostConstant *>(GetSymbolInterface());
+    }
+};
 
-                *ppObject = spObject.Detach();
-                return S_OK;
-            }
-            catch(...)
-            {
-                return Exceptions::ReturnResult(std::current_exception(), ppObject);
-            }
-        }
+// Field:
+//
+// Represents a field of a structure/union/class/etc...
+//
+class Field : public Symbol
+{
+public:
 
-        // SetAt():
-        //
-        // Abstraction for pointer[i] = value where i is the indexer set.
-        //
-        IFACEMETHOD(SetAt)(_In_ IModelObject *pContextObject,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject **ppIndexers,
-                           _In_ IModelObject *pValue)
-        {
-            try
-            {
-                if (indexerCount != 1)
-                {
-                    throw illegal_operation("Pointer indexing may only be single dimensional");
-                }
+    using SymbolTypeInterface = IDebugHostField;
 
-                ULONG64 ptrValue;
-                ComPtr<IDebugHostType> spBaseType;
-                GetAdjustedLocationAndBaseType(pContextObject, ppIndexers[0], &ptrValue, &spBaseType);
+    // IsInstance():
+    //
+    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
+    //
+    static bool IsInstance(_In_ const Symbol& symbol)
+    {
+        return (symbol.SymbolKind() == SymbolField);
+    }
 
-                //
-                // Create a linguistic reference to the underlying value and ask the core EE to perform
-                // whatever assignment it can.
-                //
-                ComPtr<IDebugHostType> spRefType;
-                CheckHr(spBaseType->CreatePointerTo(PointerReference, &spRefType));
+    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    {
+        ::SymbolKind symKind;
+        CheckHr(pSymbol->GetSymbolKind(&symKind));
+        return (symKind == SymbolField);
+    }
 
-                VARIANT vtPtr;
-                vtPtr.ullVal = ptrValue;
-                vtPtr.vt = VT_UI8;
+    //*************************************************
+    // Field Methods:
+    //
 
-                ComPtr<IModelObject> spObject;
-                CheckHr(GetManager()->CreateTypedIntrinsicObject(&vtPtr, spRefType.Get(), &spObject));
+    Field() =default;
+    Field(_In_ IDebugHostField *pField) : Symbol(pField) { }
+    Field(_In_ ComPtr<IDebugHostField> spField) : Symbol(spField.Detach()) { }
+    Field(_In_ const Field& src) : Symbol(src) { }
+    Field(_In_ Field&& src) : Symbol(std::move(src)) { }
 
-                ComPtr<IDebugHostEvaluator2> spEval2;
-                CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval2)));
-                ComPtr<IModelObject> spEvalResult;
-                HRESULT hr = spEval2->AssignTo(spObject.Get(), pValue, &spEvalResult, nullptr);
-                CheckHr(hr, spEvalResult);
+    Field& operator=(_In_ IDebugHostField *pField) { return static_cast<Field&>(Symbol::operator=(pField)); }
+    Field& operator=(_In_ ComPtr<IDebugHostField> spField) { return static_cast<Field&>(Symbol::operator=(spField.Detach())); }
+    Field& operator=(_In_ const Field& src) { return static_cast<Field&>(Symbol::operator=(src)); }
+    Field& operator=(_In_ Field&& src) { return static_cast<Field&>(Symbol::operator=(std::move(src))); }
 
-                return S_OK;
-            }
-            catch(...)
-            {
-                return Exceptions::ReturnResult(std::current_exception());
-            }
-        }
+    operator IDebugHostField* () const { return AsField(); }
+    IDebugHostField *operator->() const { return AsField(); }
 
-    private:
+    // GetLocationKind():
+    //
+    // Returns the location kind of this field.
+    //
+    LocationKind GetLocationKind() const
+    {
+        LocationKind locKind;
+        CheckHr(AsField()->GetLocationKind(&locKind));
+        return locKind;
+    }
 
-        // GetAdjustedLocationAndBaseType():
-        //
-        // Performs the underlying pointer math and returns the pointer value (location) and the underlying
-        // type.
-        //
-        _Success_(true) void GetAdjustedLocationAndBaseType(_In_ IModelObject *pContextObject,
-                                                            _In_ IModelObject *pIndex,
-                                                            _Out_ ULONG64 *pAdjustedPointer,
-                                                            _COM_Outptr_ IDebugHostType **ppBaseType)
-        {
-            *ppBaseType = nullptr;
+    // GetLocation():
+    //
+    // Gets the location of a field for a field which is static.
+    //
+    Location GetLocation() const
+    {
+        Location loc;
+        CheckHr(AsField()->GetLocation(&loc));
+        return loc;
+    }
 
-            ComPtr<IDebugHostType> spType;
-            CheckHr(pContextObject->GetTypeInfo(&spType));
+    // GetOffset():
+    //
+    // Gets the offset of a field for a field which is a member.
+    //
+    ULONG64 GetOffset() const
+    {
+        ULONG64 offset;
+        CheckHr(AsField()->GetOffset(&offset));
+        return offset;
+    }
 
-            if (spType == nullptr)
-            {
-                throw unexpected_error();
-            }
+    // GetValue():
+    //
+    // Gets the value of a constant field as an object.
+    //
+    Object GetValue() const;
 
-            TypeKind tk;
-            CheckHr(spType->GetTypeKind(&tk));
+    bool IsMember() const { return GetLocationKind() == LocationMember; }
+    bool IsStatic() const { return GetLocationKind() == LocationStatic; }
+    bool IsConstant() const { return GetLocationKind() == LocationConstant; }
 
-            PointerKind pk;
-            CheckHr(spType->GetPointerKind(&pk));
+protected:
 
-            if (tk != TypePointer || pk != PointerStandard)
-            {
-                throw unexpected_error();
-            }
+    virtual bool VerifySymbol(_In_ IDebugHostSymbol *pSymbol) noexcept
+    {
+        return pSymbol == nullptr || IsInstance(pSymbol);
+    }
 
-            ComPtr<IDebugHostType> spBaseType;
-            CheckHr(spType->GetBaseType(&spBaseType));
+private:
 
-            ULONG64 baseSize;
-            CheckHr(spBaseType->GetSize(&baseSize));
+    // AsField():
+    //
+    // Returns the IDebugHostField interface for the module.
+    //
+    IDebugHostField *AsField() const
+    {
+        return static_cast<IDebugHostField *>(GetSymbolInterface());
+    }
+};
 
-            VARIANT vtPtr;
-            CheckHr(pContextObject->GetIntrinsicValueAs(VT_UI8, &vtPtr));
+// BaseClass:
+//
+// Represents a base class
+//
+class BaseClass : public Symbol
+{
+public:
 
-            VARIANT vtAdjustment;
-            CheckHr(pIndex->GetIntrinsicValueAs(VT_I8, &vtAdjustment));
+    using SymbolTypeInterface = IDebugHostBaseClass;
 
-            *pAdjustedPointer = vtPtr.ullVal + (baseSize * vtAdjustment.llVal);
-            *ppBaseType = spBaseType.Detach();
-        }
+    // IsInstance():
+    //
+    // Returns whether a given generic symbol actually refers (and can be converted) to a base class.
+    //
+    static bool IsInstance(_In_ const Symbol& symbol)
+    {
+        return (symbol.SymbolKind() == SymbolBaseClass);
+    }
 
-    };
+    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    {
+        ::SymbolKind symKind;
+        CheckHr(pSymbol->GetSymbolKind(&symKind));
+        return (symKind == SymbolBaseClass);
+    }
 
-    // IndexableReference:
-    //
-    // A type which represents a reference value to an index operator.  operator[] on objects
-    // returns this to provide both value conversion and back assignment.
+    //*************************************************
+    // Base Class Methods:
     //
-    // NOTE:
-    //     TObj  is expected to be ClientEx::Object
-    //     TPack is parameter pack for the indexing operation (a unique pointer of ClientEx::Object>
+
+    BaseClass() =default;
+    BaseClass(_In_ IDebugHostBaseClass *pBaseClass) : Symbol(pBaseClass) { }
+    BaseClass(_In_ ComPtr<IDebugHostBaseClass> spBaseClass) : Symbol(spBaseClass.Detach()) { }
+    BaseClass(_In_ const BaseClass& src) : Symbol(src) { }
+    BaseClass(_In_ BaseClass&& src) : Symbol(std::move(src)) { }
+
+    BaseClass& operator=(_In_ IDebugHostBaseClass *pBaseClass) { return static_cast<BaseClass&>(Symbol::operator=(pBaseClass)); }
+    BaseClass& operator=(_In_ ComPtr<IDebugHostBaseClass> spBaseClass) { return static_cast<BaseClass&>(Symbol::operator=(spBaseClass.Detach())); }
+    BaseClass& operator=(_In_ const BaseClass& src) { return static_cast<BaseClass&>(Symbol::operator=(src)); }
+    BaseClass& operator=(_In_ BaseClass&& src) { return static_cast<BaseClass&>(Symbol::operator=(std::move(src))); }
+
+    operator IDebugHostBaseClass* () const { return AsBaseClass(); }
+    IDebugHostBaseClass *operator->() const { return AsBaseClass(); }
+
+    // GetOffset():
     //
-    // @TODO: Reorganize and remove template parameters
+    // Gets the offset of a base class within its derived class.
     //
-    template<typename TObj, typename TPack>
-    class IndexableReference
+    ULONG64 GetOffset() const
     {
-    public:
+        ULONG64 offset;
+        CheckHr(AsBaseClass()->GetOffset(&offset));
+        return offset;
+    }
 
-        // IndexableReference():
-        //
-        // Creates an indexable reference taking ownership of the indexer pack and the indexable.
-        //
-        IndexableReference(_In_ size_t packSize,
-                           _In_ TPack&& indexers,
-                           _In_ ComPtr<IIndexableConcept>&& spIndexable,
-                           _In_ IModelObject *pSrcObject) :
-                           m_packSize(packSize),
-                           m_indexers(std::move(indexers)),
-                           m_spIndexable(std::move(spIndexable)),
-                           m_spSrcObject(pSrcObject)
-        {
-        }
+protected:
 
-        // operator Object
-        //
-        // Performs a get of the value
-        //
-        operator TObj() const
-        {
-            return GetValue();
-        }
-
-        // operator=
-        //
-        // Perform assignment to another value.
-        //
-        template<typename T>
-        void operator=(T&& assignmentValue)
-        {
-            TObj assignment = BoxObject(std::forward<T>(assignmentValue));
-            SetValue(assignment);
-        }
-
-        // GetValue():
-        //
-        // Gets a value from the indexer.
-        //
-        TObj GetValue() const
-        {
-            ComPtr<IModelObject> spResult;
-            HRESULT hr = m_spIndexable->GetAt(m_spSrcObject.Get(),
-                                              m_packSize,
-                                              reinterpret_cast<IModelObject **>(m_indexers.get()),
-                                              &spResult,
-                                              nullptr);
-            CheckHr(hr, spResult);
-
-            //
-            // @TODO: A number of indexers have a habit of returning a reference to the underlying object
-            //        since there is no such thing as an IModelIndex*Reference.  Paper over this and get the
-            //        underlying value since we are creating such an abstraction in C++.
-            //
-            ComPtr<IModelObject> spValue;
-
-            ModelObjectKind mk;
-            CheckHr(spResult->GetKind(&mk));
-            switch(mk)
-            {
-                case ObjectTargetObjectReference:
-                    CheckHr(spResult->Dereference(&spValue));
-                    break;
-
-                default:
-                    spValue = std::move(spResult);
-                    break;
-            }
+    virtual bool VerifySymbol(_In_ IDebugHostSymbol *pSymbol) noexcept
+    {
+        return pSymbol == nullptr || IsInstance(pSymbol);
+    }
 
-            return TObj(std::move(spValue));
-        }
+private:
 
-        // Conversions:
-        //
-        template<typename TType> TType As() const { return GetValue().As<TType>(); }
-        template<typename TType> explicit operator TType() const { return As<TType>(); }
+    // AsBaseClass():
+    //
+    // Returns the IDebugHostBaseClass interface for the base class
+    //
+    IDebugHostBaseClass *AsBaseClass() const
+    {
+        return static_cast<IDebugHostBaseClass *>(GetSymbolInterface());
+    }
+};
 
-    private:
+// BitFieldInformation:
+//
+// Defines a bitfield type.
+//
+struct BitFieldInformation
+{
+    ULONG Lsb;
+    ULONG Length;
+};
 
-        // SetValue():
-        //
-        // Sets a value on the indexer.
-        //
-        void SetValue(_In_ const TObj& value)
-        {
-            HRESULT hr = m_spIndexable->SetAt(m_spSrcObject.Get(),
-                                              m_packSize,
-                                              reinterpret_cast<IModelObject **>(m_indexers.get()),
-                                              value);
-            CheckHr(hr);
-        }
+// Type:
+//
+// Represents a type object.
+//
+class Type : public Symbol
+{
+public:
 
-        size_t m_packSize;
-        TPack m_indexers;
-        ComPtr<IIndexableConcept> m_spIndexable;
-        ComPtr<IModelObject> m_spSrcObject;
-    };
+    using SymbolTypeInterface = IDebugHostType;
 
-    // ObjectKeyRef:
+    // IsInstance():
     //
-    // Represents a reference to a key.  Keys()[name] returns this so that both value returns
-    // and back assignment to the key is supported.
+    // Returns whether a given generic symbol actually refers (and can be converted) to a module.
     //
-    template<typename TObj, typename TMeta>
-    class ObjectKeyRef
+    static bool IsInstance(_In_ const Symbol& symbol)
     {
-    public:
-
-        ObjectKeyRef() { }
-
-        ObjectKeyRef(_In_ TObj&& keyRef) :
-            m_keyRef(std::move(keyRef))
-        {
-        }
+        return (symbol.SymbolKind() == SymbolType);
+    }
 
-        IModelObject *GetObject() const
-        {
-            return m_keyRef;
-        }
+    static bool IsInstance(_In_ IDebugHostSymbol *pSymbol)
+    {
+        ::SymbolKind symKind;
+        CheckHr(pSymbol->GetSymbolKind(&symKind));
+        return (symKind == SymbolType);
+    }
 
-        operator TObj() const
-        {
-            return GetValue();
-        }
+    Type() =default;
+    Type(_In_ IDebugHostType *pType) : Symbol(pType) { }
+    Type(_In_ ComPtr<IDebugHostType> spType) : Symbol(spType.Detach()) { }
+    Type(_In_ const Type& src) : Symbol(src) { }
+    Type(_In_ Type&& src) : Symbol(std::move(src)) { }
 
-        operator TMeta() const
-        {
-            return GetMetadata();
-        }
+    Type& operator=(_In_ IDebugHostType *pType) { return static_cast<Type&>(Symbol::operator=(pType)); }
+    Type& operator=(_In_ ComPtr<IDebugHostType> spType) { return static_cast<Type&>(Symbol::operator=(spType.Detach())); }
+    Type& operator=(_In_ const Type& src) { return static_cast<Type&>(Symbol::operator=(src)); }
+    Type& operator=(_In_ Type&& src) { return static_cast<Type&>(Symbol::operator=(std::move(src))); }
 
-        template<typename T>
-        ObjectKeyRef& operator=(T&& val)
-        {
-            TObj boxedValue = BoxObject(std::forward<T>(val));
-            SetValue(boxedValue);
-            return *this;
-        }
+    operator IDebugHostType* () const { return AsType(); }
+    IDebugHostType *operator->() const { return AsType(); }
 
-        TObj GetValue() const
-        {
-            CheckObject();
-            IModelKeyReference *pKeyRef = m_keyRef.As<IModelKeyReference *>();
-            ComPtr<IModelObject> spValue;
-            HRESULT hr = pKeyRef->GetKeyValue(&spValue, nullptr);
-            CheckHr(hr, spValue);
-            return TObj(std::move(spValue));
-        }
+    Type(_In_ const Module& module, _In_z_ const wchar_t *pTypeName)
+    {
+        ComPtr<IDebugHostType> spType;
+        CheckHr(module->FindTypeByName(pTypeName, &spType));
+        AssignSymbol(spType.Detach());
+    }
 
-        TMeta GetMetadata() const
-        {
-            CheckObject();
-            IModelKeyReference *pKeyRef = m_keyRef.As<IModelKeyReference *>();
-            //
-            // @TODO: We should *NOT* have to get the value here.  The interface declares this _In_opt_ but
-            // it AV's if you pass nullptr for the value.
-            //
-            ComPtr<IKeyStore> spMetadata;
-            ComPtr<IModelObject> spValue;
-            HRESULT hr = pKeyRef->GetKeyValue(&spValue, &spMetadata);
-            CheckHr(hr);
-            return TMeta(std::move(spMetadata));
-        }
+    Type(_In_ const Module& module, _In_ const std::wstring& typeName) : Type(module, typeName.c_str()) { }
 
-        // Conversions:
-        //
-        template<typename TType> TType As() const { return GetValue().As<TType>(); }
-        template<typename TType> explicit operator TType() const { return As<TType>(); }
+    template<typename TStr1, typename TStr2>
+    Type(_In_ const HostContext& moduleContext, _In_ TStr1&& moduleName, _In_ TStr2&& typeName)
+    {
+        Module typeMod(moduleContext, Details::ExtractString(moduleName));
+        Type ty(typeMod, Details::ExtractString(typeName));
+        *this = ty;
+    }
 
-    private:
+    // GetKind():
+    //
+    // Gets the kind of type (e.g.: struct, pointer, etc...)
+    //
+    TypeKind GetKind() const
+    {
+        CheckObject();
 
-        void CheckObject() const
-        {
-            if (m_keyRef.GetObject() == nullptr)
-            {
-                throw ClientEx::unexpected_error();
-            }
-        }
+        TypeKind tk;
+        CheckHr(AsType()->GetTypeKind(&tk));
+        return tk;
+    }
 
-        void SetValue(_In_ const TObj& val) const
-        {
-            CheckObject();
-            IModelKeyReference *pKeyReference = m_keyRef.As<IModelKeyReference *>();
-            CheckHr(pKeyReference->SetKeyValue(val));
-        }
+    // BaseType():
+    //
+    // Gets the base type (e.g.: pointed-to-type, array-of-type, etc...)
+    //
+    Type BaseType() const
+    {
+        CheckObject();
 
-        TObj m_keyRef;
-    };
+        ComPtr<IDebugHostType> spType;
+        CheckHr(AsType()->GetBaseType(&spType));
+        return Type(std::move(spType));
+    }
 
-    // ObjectKeysRef():
+    // Size():
     //
-    // The object returned from Keys() to reference the set of keys on an object.
+    // Gets the size of the type.
     //
-    template<typename TObj, typename TMeta>
-    class ObjectKeysRef
+    ULONG64 Size() const
     {
-    public:
-
-        // KeyIterator():
-        //
-        // A C++ input iterator for the keys within an object.
-        //
-        class KeyIterator
-        {
-        public:
+        CheckObject();
 
-            using value_type = std::tuple<std::wstring, ObjectKeyRef<TObj, TMeta>, TMeta>;
+        ULONG64 size;
+        CheckHr(AsType()->GetSize(&size));
+        return size;
+    }
 
-            KeyIterator() : m_pos(0) { }
+    //*************************************************
+    // Structure/Union/Class Methods:
+    //
 
-            KeyIterator(_In_ IKeyEnumerator *pKeyEnum) : KeyIterator(pKeyEnum, 0) { }
-
-            KeyIterator(_In_ IKeyEnumerator *pKeyEnum, _In_ size_t pos) :
-                m_spEnum(pKeyEnum),
-                m_pos(pos)
-            {
-                MoveForward();
-            }
-
-            KeyIterator(_In_ const KeyIterator& rhs) :
-                m_spEnum(rhs.m_spEnum),
-                m_value(rhs.m_value),
-                m_pos(rhs.m_pos)
-            {
-            }
-
-            KeyIterator(_In_ KeyIterator&& rhs) :
-                m_spEnum(std::move(rhs.m_spEnum)),
-                m_value(std::move(rhs.m_value)),
-                m_pos(rhs.m_pos)
-            {
-                rhs.m_pos = 0;
-            }
-
-            KeyIterator& operator=(_In_ const KeyIterator& rhs)
-            {
-                m_spEnum = rhs.m_spEnum;
-                m_value = rhs.m_value;
-                m_pos = rhs.m_pos;
-                return *this;
-            }
-
-            KeyIterator& operator=(KeyIterator&& rhs)
-            {
-                m_spEnum = std::move(rhs.m_spEnum);
-                m_value = std::move(rhs.m_value);
-                m_pos = rhs.m_pos;
-                rhs.m_pos = 0;
-                return *this;
-            }
-
-            bool operator==(_In_ const KeyIterator& rhs)
-            {
-                if (std::get<1>(m_value).GetObject() == nullptr && std::get<1>(rhs.m_value).GetObject() == nullptr)
-                {
-                    return true;
-                }
-                else if (std::get<1>(m_value).GetObject() != nullptr && std::get<1>(rhs.m_value).GetObject() != nullptr && m_pos == rhs.m_pos)
-                {
-                    return true;
-                }
-
-                return false;
-            }
-
-            bool operator!=(_In_ const KeyIterator& rhs)
-            {
-                return !operator==(rhs);
-            }
-
-            value_type operator*() const
-            {
-                return m_value;
-            }
-
-            value_type* operator->() const
-            {
-                return &m_value;
-            }
-
-            KeyIterator operator++()
-            {
-                MoveForward();
-                return *this;
-            }
-
-            KeyIterator operator++(int)
-            {
-                KeyIterator cur = *this;
-                MoveForward();
-                return cur;
-            }
-
-        private:
-
-            void MoveForward()
-            {
-                BSTR keyName;
-                ComPtr<IModelObject> spValue;
-                ComPtr<IKeyStore> spMetadata;
-                HRESULT hr = m_spEnum->GetNext(&keyName, &spValue, &spMetadata);
-                if (SUCCEEDED(hr))
-                {
-                    bstr_ptr fldPtr(keyName);
-                    ObjectKeyRef<TObj, TMeta> keyRef(std::move(spValue));
-                    TMeta metadata = std::move(spMetadata);
-                    m_value = std::make_tuple(std::wstring(keyName), std::move(keyRef), std::move(metadata));
-                    ++m_pos;
-                }
-                else if (hr != E_BOUNDS)
-                {
-                    CheckHr(hr);
-                }
-                else
-                {
-                    m_value = std::make_tuple(std::wstring(), ObjectKeyRef<TObj, TMeta>(), TMeta());
-                    m_pos = 0;
-                }
-            }
+    // Fields():
+    //
+    // Returns a collection of all of the fields within this type (*NOT* including those within base classes)
+    //
+    Details::SymbolChildrenRef<Type, Field> Fields() const
+    {
+        CheckObject();
+        return Details::SymbolChildrenRef<Type, Field>(*this, SymbolField);
+    }
 
-            ComPtr<IKeyEnumerator> m_spEnum;
-            value_type m_value;
-            size_t m_pos;
+    // BaseClasses():
+    //
+    // Returns a collection of all of the base classes of this type (*NOT* including base classes of base classes)
+    //
+    Details::SymbolChildrenRef<Type, BaseClass> BaseClasses() const
+    {
+        CheckObject();
+        return Details::SymbolChildrenRef<Type, BaseClass>(*this, SymbolBaseClass);
+    }
 
-        };
+    //*************************************************
+    // Intrinsic Information:
+    //
 
-        using iterator = KeyIterator;
+    // IsIntrinsic():
+    //
+    // Returns whether the type represents an intrinsic.
+    //
+    bool IsIntrinsic() const
+    {
+        CheckObject();
+        return (GetKind() == TypeIntrinsic);
+    }
 
-        ObjectKeysRef(_In_ const TObj& obj) :
-            m_obj(obj)
+    // IntrinsicKind():
+    //
+    // Returns the kind of an intrinsic.
+    //
+    ::IntrinsicKind IntrinsicKind() const
+    {
+        CheckObject();
+        if (!IsIntrinsic())
         {
+            throw illegal_operation("Object must be an intrinsic");
         }
 
-        // operator[]:
-        //
-        // Returns a "reference" to a key.
-        //
-        ObjectKeyRef<TObj, TMeta> operator[](_In_z_ const wchar_t *keyName)
-        {
-            ComPtr<IModelObject> spKeyRef;
-            HRESULT hr = m_obj->GetKeyReference(keyName, &spKeyRef, nullptr);
-            CheckHr(hr, spKeyRef);
-            return ObjectKeyRef<TObj, TMeta>(std::move(spKeyRef));
-        }
+        ::IntrinsicKind ik;
+        VARTYPE carrier;
+        CheckHr(AsType()->GetIntrinsicType(&ik, &carrier));
+        return ik;
+    }
 
-        ObjectKeyRef<TObj, TMeta> operator[](_In_ const std::wstring& keyName)
+    // IntrinsicCarrier():
+    //
+    // Returns the carrier type for an intrinsic (how it packs)
+    //
+    VARTYPE IntrinsicCarrier() const
+    {
+        CheckObject();
+        if (!IsIntrinsic())
         {
-            if (keyName.empty())
-            {
-                throw std::invalid_argument("Invalid keyName");
-            }
-            return operator[](keyName.c_str());
+            throw illegal_operation("Object must be an intrinsic");
         }
 
-        iterator begin()
-        {
-            ComPtr<IKeyEnumerator> spEnum;
-            CheckHr(m_obj->EnumerateKeyReferences(&spEnum));
-            return iterator(spEnum.Get());
-        }
+        ::IntrinsicKind ik;
+        VARTYPE carrier;
+        CheckHr(AsType()->GetIntrinsicType(&ik, &carrier));
+        return carrier;
+    }
 
-        iterator end()
+    //*************************************************
+    // BitField Information:
+    //
+
+    // IsBitField():
+    //
+    // Returns whether the type represents a bitfield.
+    //
+    bool IsBitField() const
+    {
+        CheckObject();
+        ULONG lsb, length;
+        if (FAILED(AsType()->GetBitField(&lsb, &length)))
         {
-            return iterator();
+            return false;
         }
+        return true;
+    }
 
-    private:
-
-        TObj m_obj;
+    // BitField():
+    //
+    // Returns information about a bit field type.
+    //
+    BitFieldInformation BitField() const
+    {
+        CheckObject();
+        BitFieldInformation info;
+        CheckHr(AsType()->GetBitField(&info.Lsb, &info.Length));
+        return info;
+    }
 
-    };
+    //*************************************************
+    // Pointer Methods:
+    //
 
-    // ObjectFieldRef:
+    // IsPointer():
     //
-    // Represents a reference to a field as returned from Fields()[name] such that both value conversion
-    // and back assignment to the field can be supported.
+    // Returns whether the type represents any kind of pointer.
     //
-    template<typename TObj>
-    class ObjectFieldRef
+    bool IsPointer() const
     {
-    public:
-
-        ObjectFieldRef() { }
+        CheckObject();
+        auto kind = GetKind();
+        return (kind == TypePointer || kind == TypeMemberPointer);
+    }
 
-        ObjectFieldRef(_In_ TObj&& fieldRef) :
-            m_fieldRef(std::move(fieldRef))
-        {
-        }
+    // GetPointerKind()
+    //
+    // Gets the kind of pointer (e.g.: standard, reference, etc...).  This may only legally be called on a pointer.
+    //
+    PointerKind GetPointerKind() const
+    {
+        CheckObject();
 
-        operator TObj() const
+        if (!IsPointer())
         {
-            return GetValue();
+            throw illegal_operation("Object must be a pointer");
         }
 
-        IModelObject *GetObject() const
-        {
-            return m_fieldRef;
-        }
+        PointerKind pk;
+        CheckHr(AsType()->GetPointerKind(&pk));
+        return pk;
+    }
 
-        template<typename T>
-        ObjectFieldRef& operator=(T&& val)
+    // PointerMemberType():
+    //
+    // For pointer-to-member (of class), this returns the class which the pointer is a member of.
+    //
+    ClientEx::Type PointerMemberType() const
+    {
+        CheckObject();
+        if (GetKind() != TypeMemberPointer)
         {
-            TObj boxedValue = BoxObject(std::forward<T>(val));
-            SetValue(boxedValue);
-            return *this;
+            throw illegal_operation("Object must be a member pointer");
         }
 
-        TObj GetValue() const
-        {
-            CheckObject();
-            ComPtr<IModelObject> spDeref;
-            CheckHr(m_fieldRef->Dereference(&spDeref));
-            return TObj(std::move(spDeref));
-        }
+        ComPtr<IDebugHostType> spMemberType;
+        CheckHr(AsType()->GetMemberType(&spMemberType));
+        return ClientEx::Type(std::move(spMemberType));
+    }
 
-        // Conversions:
-        //
-        template<typename TType> TType As() const { return GetValue().As<TType>(); }
-        template<typename TType> explicit operator TType() const { return As<TType>(); }
+    //*************************************************
+    // Array Methods:
+    //
 
-    private:
+    // IsArray():
+    //
+    // Indicates whether the type represents any kind of array.
+    //
+    bool IsArray() const
+    {
+        CheckObject();
+        return (GetKind() == TypeArray);
+    }
 
-        void CheckObject() const
-        {
-            if (m_fieldRef.GetObject() == nullptr)
-            {
-                throw ClientEx::unexpected_error();
-            }
-        }
+    // ArrayDimensions():
+    //
+    // Returns a collection of all of the array dimensions of the type.
+    //
+    Details::ArrayDimensionsRef ArrayDimensions() const
+    {
+        CheckObject();
 
-        void SetValue(_In_ const TObj& val) const
+        if (!IsArray())
         {
-            CheckObject();
-            ComPtr<IDebugHostEvaluator2> spEval2;
-            CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval2)));
-            ComPtr<IModelObject> spEvalResult;
-            HRESULT hr = spEval2->AssignTo(GetObject(), val, &spEvalResult, nullptr);
-            CheckHr(hr, spEvalResult);
+            throw illegal_operation("Object must be an array");
         }
 
-        TObj m_fieldRef;
-    };
+        return Details::ArrayDimensionsRef(AsType());
+    }
 
-    // ObjectFieldsRef():
+    //*************************************************
+    // Generics (Templates) Methods:
     //
-    // Returned from Fields() to represent all native fields on an object.
+
+    // IsGeneric():
     //
-    template<typename TObj>
-    class ObjectFieldsRef
+    // An indication of whether the type is a generic (e.g.: a C++ template, a C# generic, etc...)
+    //
+    bool IsGeneric() const
     {
-    private:
+        CheckObject();
 
-        // FieldIterator():
-        //
-        // A C++ input iterator for the fields within an object.
-        //
-        class FieldIterator
-        {
-        public:
+        bool isGeneric;
+        CheckHr(AsType()->IsGeneric(&isGeneric));
+        return isGeneric;
+    }
 
-            using value = std::pair<std::wstring, ObjectFieldRef<TObj>>;
+    // GenericArguments():
+    //
+    // Returns a collection of all of the generic arguments of this type (which are all symbols -- some may
+    // be types, some may be constants)
+    //
+    Details::GenericArgumentsRef<Symbol> GenericArguments() const
+    {
+        CheckObject();
 
-            FieldIterator() : m_pos(0) { }
+        if (!IsGeneric())
+        {
+            throw illegal_operation("Object must be a generic");
+        }
 
-            FieldIterator(_In_ IRawEnumerator *pRawEnum) : FieldIterator(pRawEnum, 0) { }
+        return Details::GenericArgumentsRef<Symbol>(AsType());
+    }
 
-            FieldIterator(_In_ IRawEnumerator *pRawEnum, _In_ size_t pos) :
-                m_spEnum(pRawEnum),
-                m_pos(pos)
-            {
-                MoveForward();
-            }
+    //*************************************************
+    // Function Methods:
+    //
 
-            FieldIterator(_In_ const FieldIterator& rhs) :
-                m_spEnum(rhs.m_spEnum),
-                m_value(rhs.m_value),
-                m_pos(rhs.m_pos)
-            {
-            }
+    // IsFunction():
+    //
+    // An indication of whether the type is a function type.
+    //
+    bool IsFunction() const
+    {
+        CheckObject();
+        return (GetKind() == TypeFunction);
+    }
 
-            FieldIterator(_In_ FieldIterator&& rhs) :
-                m_spEnum(std::move(rhs.m_spEnum)),
-                m_value(std::move(rhs.m_value)),
-                m_pos(rhs.m_pos)
-            {
-                rhs.m_pos = 0;
-            }
+    // CallingConvention():
+    //
+    // Returns the calling convention of a function type.
+    //
+    CallingConventionKind CallingConvention() const
+    {
+        CheckObject();
+        if (!IsFunction())
+        {
+            throw illegal_operation("Object must be a function");
+        }
 
-            FieldIterator& operator=(_In_ const FieldIterator& rhs)
-            {
-                m_spEnum = rhs.m_spEnum;
-                m_value = rhs.m_value;
-                m_pos = rhs.m_pos;
-                return *this;
-            }
+        CallingConventionKind convKind;
+        CheckHr(AsType()->GetFunctionCallingConvention(&convKind));
+        return convKind;
+    }
 
-            FieldIterator& operator=(FieldIterator&& rhs)
-            {
-                m_spEnum = std::move(rhs.m_spEnum);
-                m_value = std::move(rhs.m_value);
-                m_pos = rhs.m_pos;
-                rhs.m_pos = 0;
-                return *this;
-            }
+    // ReturnType():
+    //
+    // Retunrs the return type of a function type.
+    //
+    ClientEx::Type ReturnType() const
+    {
+        CheckObject();
+        if (!IsFunction())
+        {
+            throw illegal_operation("Object must be a function");
+        }
 
-            bool operator==(_In_ const FieldIterator& rhs)
-            {
-                if (m_value.second.GetObject() == nullptr && rhs.m_value.second.GetObject() == nullptr)
-                {
-                    return true;
-                }
-                else if (m_value.second.GetObject() != nullptr && rhs.m_value.second.GetObject() != nullptr && m_pos == rhs.m_pos)
-                {
-                    return true;
-                }
+        ComPtr<IDebugHostType> spReturnType;
+        CheckHr(AsType()->GetFunctionReturnType(&spReturnType));
+        return ClientEx::Type(std::move(spReturnType));
+    }
 
-                return false;
-            }
+    // HasInstancePointerType():
+    //
+    // Returns whether or not a given function type has an instance pointer (implicit 'this' argument)
+    //
+    bool HasInstancePointerType() const
+    {
+        CheckObject();
+        if (!IsFunction())
+        {
+            throw illegal_operation("Object must be a function");
+        }
+        ComPtr<IDebugHostType2> spType2;
+        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
+        ComPtr<IDebugHostType2> spInstancePointerType;
+        if (FAILED(spType2->GetFunctionInstancePointerType(&spInstancePointerType)))
+        {
+            return false;
+        }
+        return true;
+    }
 
-            bool operator!=(_In_ const FieldIterator& rhs)
-            {
-                return !operator==(rhs);
-            }
+    // InstancePointerType():
+    //
+    // Returns the type of any implicit instance pointer to the function type ('this' pointer)
+    //
+    ClientEx::Type InstancePointerType() const
+    {
+        CheckObject();
+        if (!IsFunction())
+        {
+            throw illegal_operation("Object must be a function");
+        }
+        ComPtr<IDebugHostType2> spType2;
+        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
+        ComPtr<IDebugHostType2> spInstancePointerType;
+        CheckHr(spType2->GetFunctionInstancePointerType(&spInstancePointerType));
+        return ClientEx::Type(std::move(spInstancePointerType));
+    }
 
-            value operator*() const
-            {
-                return m_value;
-            }
+    // IsVarArgs():
+    //
+    // Returns whether a function type is varargs (of any style)
+    //
+    bool IsVarArgs() const
+    {
+        return VarArgsKind() != VarArgsNone;
+    }
 
-            value* operator->() const
-            {
-                return &m_value;
-            }
+    // VarArgsKind():
+    //
+    // Returns what style of varargs a given funtion type is.
+    //
+    ::VarArgsKind VarArgsKind() const
+    {
+        CheckObject();
+        if (!IsFunction())
+        {
+            throw illegal_operation("Object must be a function");
+        }
+        ComPtr<IDebugHostType2> spType2;
+        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
+        ::VarArgsKind varKind;
+        CheckHr(spType2->GetFunctionVarArgsKind(&varKind));
+        return varKind;
+    }
 
-            FieldIterator operator++()
-            {
-                MoveForward();
-                return *this;
-            }
+    // ParameterTypes():
+    //
+    // Returns a collection of the parameter types of a function type.
+    //
+    Details::ParameterTypesRef<ClientEx::Type> ParameterTypes() const
+    {
+        CheckObject();
+        if (!IsFunction())
+        {
+            throw illegal_operation("Object must be a function");
+        }
+        return Details::ParameterTypesRef<ClientEx::Type>(AsType());
+    }
 
-            FieldIterator operator++(int)
-            {
-                FieldIterator cur = *this;
-                MoveForward();
-                return cur;
-            }
+    //*************************************************
+    // Typedef Methods:
+    //
 
-        private:
+    // IsTypedef():
+    //
+    // Returns whether the type is a typedef.  All other methods not specific to typedefs will behave
+    // as they would on the final underlying type.
+    //
+    bool IsTypedef() const
+    {
+        CheckObject();
+        ComPtr<IDebugHostType2> spType2;
+        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
+        bool isTypedef;
+        CheckHr(spType2->IsTypedef(&isTypedef));
+        return isTypedef;
+    }
 
-            void MoveForward()
-            {
-                BSTR fldName;
-                SymbolKind sk;
-                ComPtr<IModelObject> spValue;
-                HRESULT hr = m_spEnum->GetNext(&fldName, &sk, &spValue);
-                if (SUCCEEDED(hr))
-                {
-                    bstr_ptr fldPtr(fldName);
-                    ObjectFieldRef<TObj> fldRef(std::move(spValue));
-                    m_value = std::make_pair(std::wstring(fldName), std::move(fldRef));
-                    ++m_pos;
-                }
-                else if (hr != E_BOUNDS)
-                {
-                    CheckHr(hr);
-                }
-                else
-                {
-                    m_value = std::make_pair(std::wstring(), ObjectFieldRef<TObj>());
-                    m_pos = 0;
-                }
-            }
+    // TypedefBaseType():
+    //
+    // For a type which is a typedef, this will return the type that the typedef refers to (which may itself
+    // be another typedef).
+    //
+    ClientEx::Type TypedefBaseType() const
+    {
+        CheckObject();
+        ComPtr<IDebugHostType2> spType2;
+        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
+        ComPtr<IDebugHostType2> spBaseType;
+        CheckHr(spType2->GetTypedefBaseType(&spBaseType));
+        return ClientEx::Type(std::move(spBaseType));
+    }
 
-            ComPtr<IRawEnumerator> m_spEnum;
-            value m_value;
-            size_t m_pos;
+    // TypedefFinalBaseType():
+    //
+    // For a type which is a typedef, this will return the final type that the typedef refers to (effectively
+    // doing TypedefBaseType until reaching something which is not a typedef).
+    //
+    ClientEx::Type TypedefFinalBaseType() const
+    {
+        CheckObject();
+        ComPtr<IDebugHostType2> spType2;
+        CheckHr(AsType()->QueryInterface(IID_PPV_ARGS(&spType2)));
+        ComPtr<IDebugHostType2> spFinalBaseType;
+        CheckHr(spType2->GetTypedefFinalBaseType(&spFinalBaseType));
+        return ClientEx::Type(std::move(spFinalBaseType));
+    }
 
-        };
+protected:
 
-    public:
+    virtual bool VerifySymbol(_In_ IDebugHostSymbol *pSymbol) noexcept
+    {
+        return pSymbol == nullptr || IsInstance(pSymbol);
+    }
 
-        using iterator = FieldIterator;
+private:
 
-        ObjectFieldsRef(_In_ const TObj& obj) :
-            m_obj(obj)
-        {
-        }
+    // AsType():
+    //
+    // Returns the IDebugHostType interface for the type.
+    //
+    IDebugHostType *AsType() const
+    {
+        return static_cast<IDebugHostType *>(GetSymbolInterface());
+    }
+};
 
-        // operator[]:
-        //
-        // Returns a "reference" to a native field.
-        //
-        ObjectFieldRef<TObj> operator[](_In_z_ const wchar_t *fieldName)
-        {
-            ComPtr<IModelObject> spFieldRef;
-            HRESULT hr = m_obj->GetRawReference(SymbolField, fieldName, RawSearchNone, &spFieldRef);
-            CheckHr(hr, spFieldRef);
-            return ObjectFieldRef<TObj>(std::move(spFieldRef));
-        }
+template<typename TDestSymbol> TDestSymbol symbol_cast(_In_ const Symbol& src) { return symbol_cast<TDestSymbol>(src.GetSymbolInterface()); };
 
-        TObj operator[](_In_ const std::wstring& fieldName)
+//**************************************************************************
+// Type Layout Caching:
+//
+
+namespace Details
+{
+    // IsSignedIntegralType():
+    //
+    // Determines whether a type (or the final base type of a typedef) is a signed integral intrinsic.
+    //
+    inline bool IsSignedIntegralType(_In_ const Type& srcType)
+    {
+        Type type = srcType;
+        if (type.GetKind() == TypeTypedef)
         {
-            if (fieldName.empty())
-            {
-                throw std::invalid_argument("Invalid fieldName");
-            }
-            return operator[](fieldName.c_str());
+            type = type.TypedefFinalBaseType();
         }
 
-        iterator begin()
+        if (type.GetKind() != TypeIntrinsic)
         {
-            ComPtr<IRawEnumerator> spEnum;
-            CheckHr(m_obj->EnumerateRawReferences(SymbolField, RawSearchNone, &spEnum));
-            return iterator(spEnum.Get());
+            return false;
         }
 
-        iterator end()
+        switch(type.IntrinsicCarrier())
         {
-            return iterator();
+            case VT_I1:
+            case VT_I2:
+            case VT_I4:
+            case VT_I8:
+                return true;
         }
 
-    private:
+        return false;
+    }
+}
 
-        TObj m_obj;
+// FieldLayout:
+//
+// A flattened description of a single data member of a type as recorded in a TypeLayout.  The offset is relative
+// to the start of the type the layout was computed for (base class offsets are already folded in).
+//
+struct FieldLayout
+{
+    std::wstring Name;
+    ULONG64 Offset;
+    ULONG64 Size;           // The size of the field's type (for a bitfield, the size of its carrier)
+    ClientEx::Type FieldType;
+    bool IsSigned;          // Whether the field's type is a signed integral intrinsic
+    bool IsBitField;
+    BitFieldInformation BitField;
+};
 
-    };
+// TypeLayout:
+//
+// The flat field table of a type.  Fields of the type itself come first, followed by the fields of each of its
+// base classes (depth first and in declaration order).
+//
+class TypeLayout
+{
+public:
 
-    // DereferenceReference:
-    //
-    // A class which represents a reference type returned from the Dereference call.  This allows both
-    // value conversion and back assignment to a dereference.
-    //
-    template<typename TObj>
-    class DereferenceReference
+    TypeLayout(_In_ const ClientEx::Type& type) :
+        m_type(type),
+        m_size(type.Size())
     {
-    public:
+        AddFields(type, 0);
 
-        DereferenceReference(_In_ const TObj& obj) : m_obj(obj) { }
-        DereferenceReference(_In_ const DereferenceReference& src) : m_obj(src.m_obj) { }
-        DereferenceReference(_In_ DereferenceReference&& src) : m_obj(std::move(src.m_obj)) { }
-
-        operator TObj() const
+        //
+        // The index refers to the names held in m_fields, so it is built only once m_fields stops growing.  The
+        // most derived field of a given name comes first, and emplace will not replace an existing entry.
+        //
+        for (size_t i = 0; i < m_fields.size(); ++i)
         {
-            return GetValue();
+            m_fieldIndex.emplace(std::wstring_view(m_fields[i].Name), i);
         }
+    }
 
-        TObj GetValue() const
+    TypeLayout(_In_ const TypeLayout&) =delete;
+    TypeLayout& operator=(_In_ const TypeLayout&) =delete;
+
+    const ClientEx::Type& GetType() const { return m_type; }
+    ULONG64 Size() const { return m_size; }
+    const std::vector<FieldLayout>& Fields() const { return m_fields; }
+
+    // FindField():
+    //
+    // Returns the layout of the named field or nullptr if there is no such field.  A field of a derived class hides
+    // any identically named field of a base class.
+    //
+    const FieldLayout *FindField(_In_ std::wstring_view fieldName) const
+    {
+        auto it = m_fieldIndex.find(fieldName);
+        if (it == m_fieldIndex.end())
         {
-            ComPtr<IModelObject> spDeref;
-            CheckHr(m_obj->Dereference(&spDeref));
-            return TObj(std::move(spDeref));
+            return nullptr;
         }
+        return &m_fields[it->second];
+    }
 
-        // operator=
-        //
-        // Perform assignment to another value.
-        //
-        template<typename T>
-        void operator=(T&& assignmentValue)
+    // GetField():
+    //
+    // Returns the layout of the named field.  If there is no such field, this will throw.
+    //
+    const FieldLayout& GetField(_In_ std::wstring_view fieldName) const
+    {
+        const FieldLayout *pField = FindField(fieldName);
+        if (pField == nullptr)
         {
-            TObj assignment = BoxObject(std::forward<T>(assignmentValue));
-            SetValue(assignment);
+            throw std::invalid_argument("Field not found");
         }
+        return *pField;
+    }
 
-        template<typename TType> TType As() const { return GetValue().As<TType>(); }
-        template<typename TType> explicit operator TType() const { return GetValue().As<TType>(); }
-
-    private:
+private:
 
-        void CheckObject() const
+    void AddFields(_In_ const ClientEx::Type& type, _In_ ULONG64 baseOffset)
+    {
+        for (auto&& field : type.Fields())
         {
-            if (m_obj.GetObject() == nullptr)
+            if (!field.IsMember())
             {
-                throw ClientEx::unexpected_error();
+                continue;
             }
+
+            FieldLayout layout;
+            layout.Name = field.Name();
+            layout.Offset = baseOffset + field.GetOffset();
+            layout.FieldType = field.Type();
+            layout.Size = layout.FieldType.Size();
+            layout.IsSigned = Details::IsSignedIntegralType(layout.FieldType);
+            layout.IsBitField = layout.FieldType.IsBitField();
+            layout.BitField = layout.IsBitField ? layout.FieldType.BitField() : BitFieldInformation { 0, 0 };
+            m_fields.push_back(std::move(layout));
         }
 
-        void SetValue(_In_ const TObj& val) const
+        for (auto&& baseClass : type.BaseClasses())
         {
-            CheckObject();
-
-            ComPtr<IDebugHostContext> spCtx;
-            ComPtr<IModelObject> spObj;
-            CheckHr(m_obj->GetContext(&spCtx));
-
-            TObj assignmentRef;
-
             //
-            // How we "assign this" depends on what it is.  We need to convert the dereference to
-            // an actual "reference" and pass that back to the evaluator to deal with as it sees fit.
+            // Virtual bases have no fixed offset.  They cannot be part of a flat layout.
             //
-            ModelObjectKind mkObject = m_obj.GetKind();
-            if (mkObject == ObjectIntrinsic)
+            ULONG64 baseClassOffset;
+            if (FAILED(baseClass->GetOffset(&baseClassOffset)))
             {
-                //
-                // If it's a pointer, get a reference to what's underneath.
-                //
-                Type ty = m_obj.Type();
-                if (ty != nullptr && ty.GetKind() == TypePointer)
-                {
-                    ULONG64 addr = (ULONG64)m_obj;
-                    Type baseType = ty.BaseType();
-                    CheckHr(GetManager()->CreateTypedObjectReference(spCtx.Get(), addr, baseType, &spObj));
-                    assignmentRef = std::move(spObj);
-                }
-            }
-            else if (mkObject == ObjectTargetObjectReference)
-            {
-                assignmentRef = m_obj;
+                continue;
             }
 
-            if (assignmentRef == nullptr)
-            {
-                TObj underlyingValue = GetValue();
-                ModelObjectKind mkUnderlyingValue = underlyingValue.GetKind();
-                switch(mkUnderlyingValue)
-                {
-                    case ObjectTargetObjectReference:
-                    {
-                        //
-                        // Probably not.  But this is easy.
-                        //
-                        assignmentRef = underlyingValue;
-                        break;
-                    }
-
-                    case ObjectTargetObject:
-                    {
-                        Location loc;
-                        ComPtr<IDebugHostType> spType;
-                        CheckHr(m_obj->GetTargetInfo(&loc, &spType));
+            AddFields(baseClass.Type(), baseOffset + baseClassOffset);
+        }
+    }
 
-                        CheckHr(GetManager()->CreateTypedObjectReference(spCtx.Get(), loc, spType.Get(), &spObj));
-                        assignmentRef = std::move(spObj);
-                        break;
-                    }
+    ClientEx::Type m_type;
+    ULONG64 m_size;
+    std::vector<FieldLayout> m_fields;
+    std::unordered_map<std::wstring_view, size_t> m_fieldIndex;       // Refers to the names in m_fields
+};
 
-                    default:
-                        throw not_implemented();
-                }
-            }
+// FieldIndex:
+//
+// A name index over the fields of a type (*NOT* including those within base classes).  See Type::Fields().Indexed()
+// and TypeLayoutCache::GetFieldIndex().
+//
+using FieldIndex = Details::SymbolChildIndex<Field>;
 
-            ComPtr<IDebugHostEvaluator2> spEval2;
-            CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval2)));
-            ComPtr<IModelObject> spEvalResult;
-            HRESULT hr = spEval2->AssignTo(assignmentRef, val, &spEvalResult, nullptr);
-            CheckHr(hr, spEvalResult);
+namespace Details
+{
+    // IsSameType():
+    //
+    // Compares two types by symbol identity.  The host may hand out a different type object each time the same type
+    // is requested, so the interface pointers alone do not identify it.  A failed comparison is treated as a mismatch
+    // so that this may be used where throwing is not acceptable (e.g.: from within a container's key comparison).
+    //
+    inline bool IsSameType(_In_opt_ IDebugHostType *pLeft, _In_opt_ IDebugHostType *pRight)
+    {
+        if (pLeft == pRight)
+        {
+            return true;
         }
 
-        TObj m_obj;
+        bool isSame;
+        return pLeft != nullptr && pRight != nullptr && SUCCEEDED(pLeft->CompareAgainst(pRight, 0, &isSame)) && isSame;
+    }
+}
 
-    };
+// TypeLayoutCache:
+//
+// Memoizes type lookups by (module base, type name) and the flat field table and field index of each such type.
+// The host does not notify clients of module unloads through the data model.  A client which holds a cache across
+// target changes must call InvalidateModule() (or Clear()) from its own module load/unload notifications.
+//
+// The cache is safe for concurrent use.
+//
+class TypeLayoutCache
+{
+public:
 
-    // ObjectIterator:
+    TypeLayoutCache() { }
+    TypeLayoutCache(_In_ const TypeLayoutCache&) =delete;
+    TypeLayoutCache& operator=(_In_ const TypeLayoutCache&) =delete;
+
+    // FindType():
     //
-    // A C++ forward iterator over an object.
+    // Finds a type by name within the module.  Repeated lookups of the same name within the same module are
+    // served from the cache.
     //
-    template<typename TObj>
-    class ObjectIterator
+    ClientEx::Type FindType(_In_ const Module& module, _In_ const std::wstring& typeName)
     {
-    public:
+        return GetEntry(module.BaseLocation().Offset, module, typeName).CachedType;
+    }
 
-        using value = TObj;
+    ClientEx::Type FindType(_In_ const Module& module, _In_z_ const wchar_t *pTypeName)
+    {
+        return FindType(module, std::wstring(pTypeName));
+    }
 
-        ObjectIterator() : m_pos(0) { }
-        ObjectIterator(_In_ const TObj& obj, _In_ IModelIterator *pIterator) : ObjectIterator(obj, pIterator, 0) { }
+    // GetLayout():
+    //
+    // Returns the flat field table for the named type within the module.  The table is computed on first request.
+    //
+    std::shared_ptr<const TypeLayout> GetLayout(_In_ const Module& module, _In_ const std::wstring& typeName)
+    {
+        return GetCached(module, typeName, &Entry::Layout, [](_In_ const ClientEx::Type& type)
+        {
+            return std::make_shared<const TypeLayout>(type);
+        });
+    }
 
-        ObjectIterator(_In_ const TObj& obj, _In_ IModelIterator *pIterator, _In_ size_t pos) :
-            m_obj(obj),
-            m_spIterator(pIterator),
-            m_pos(pos)
+    std::shared_ptr<const TypeLayout> GetLayout(_In_ const Module& module, _In_z_ const wchar_t *pTypeName)
+    {
+        return GetLayout(module, std::wstring(pTypeName));
+    }
+
+    // GetLayout():
+    //
+    // Returns the flat field table for the given type.  The table is always computed from the given type; its (module
+    // base, name) is only the key under which the table is cached.  See GetCachedForType() for the types whose table
+    // is computed but not cached.
+    //
+    std::shared_ptr<const TypeLayout> GetLayout(_In_ const ClientEx::Type& type)
+    {
+        return GetCachedForType(type, &Entry::Layout, [](_In_ const ClientEx::Type& layoutType)
         {
-            MoveForward();
-        }
+            return std::make_shared<const TypeLayout>(layoutType);
+        });
+    }
 
-        ObjectIterator(_In_ const ObjectIterator& rhs) :
-            m_obj(rhs.m_obj),
-            m_spIterator(rhs.m_spIterator),
-            m_value(rhs.m_value),
-            m_pos(rhs.m_pos)
+    // GetFieldIndex():
+    //
+    // Returns the field index for the named type within the module.  The index is built on first request.
+    //
+    std::shared_ptr<const FieldIndex> GetFieldIndex(_In_ const Module& module, _In_ const std::wstring& typeName)
+    {
+        return GetCached(module, typeName, &Entry::Index, [](_In_ const ClientEx::Type& type)
         {
-        }
+            return std::make_shared<const FieldIndex>(type.Fields());
+        });
+    }
 
-        ObjectIterator(_In_ ObjectIterator&& rhs) :
-            m_obj(std::move(rhs.m_obj)),
-            m_spIterator(std::move(rhs.m_spIterator)),
-            m_value(std::move(rhs.m_spValue)),
-            m_pos(rhs.m_pos)
+    std::shared_ptr<const FieldIndex> GetFieldIndex(_In_ const Module& module, _In_z_ const wchar_t *pTypeName)
+    {
+        return GetFieldIndex(module, std::wstring(pTypeName));
+    }
+
+    // GetFieldIndex():
+    //
+    // Returns the field index for the given type.  The index is always built from the given type; its (module base,
+    // name) is only the key under which the index is cached.  See GetCachedForType() for the types whose index is
+    // built but not cached.
+    //
+    std::shared_ptr<const FieldIndex> GetFieldIndex(_In_ const ClientEx::Type& type)
+    {
+        return GetCachedForType(type, &Entry::Index, [](_In_ const ClientEx::Type& indexedType)
         {
-            rhs.m_pos = 0;
-        }
+            return std::make_shared<const FieldIndex>(indexedType.Fields());
+        });
+    }
 
-        ObjectIterator& operator=(_In_ const ObjectIterator& rhs)
+    // InvalidateModule():
+    //
+    // Drops every cached type and layout which was resolved against the module at the given base.
+    //
+    void InvalidateModule(_In_ ULONG64 moduleBase)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_modules.erase(moduleBase);
+    }
+
+    void InvalidateModule(_In_ const Module& module)
+    {
+        InvalidateModule(module.BaseLocation().Offset);
+    }
+
+    // Clear():
+    //
+    // Drops everything in the cache.
+    //
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_modules.clear();
+    }
+
+private:
+
+    struct Entry
+    {
+        ClientEx::Type CachedType;
+        std::shared_ptr<const TypeLayout> Layout;
+        std::shared_ptr<const FieldIndex> Index;
+    };
+
+    // GetCached():
+    //
+    // Returns something computed from the named type (a layout or index) which is cached in the type's entry.  The
+    // value is computed outside the lock.  If two threads race on the same type, the first insertion wins.
+    //
+    template<typename TValue, typename TCompute>
+    std::shared_ptr<const TValue> GetCached(_In_ const Module& module,
+                                            _In_ const std::wstring& typeName,
+                                            _In_ std::shared_ptr<const TValue> Entry::*pMember,
+                                            _In_ const TCompute& compute)
+    {
+        ULONG64 moduleBase = module.BaseLocation().Offset;
+        Entry entry = GetEntry(moduleBase, module, typeName);
+        if (entry.*pMember != nullptr)
         {
-            m_obj = rhs.m_obj;
-            m_spIterator = rhs.m_spIterator;
-            m_value = rhs.m_value;
-            m_pos = rhs.m_pos;
-            return *this;
+            return entry.*pMember;
         }
 
-        ObjectIterator& operator=(_In_ ObjectIterator&& rhs)
+        std::shared_ptr<const TValue> spValue = compute(entry.CachedType);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto itModule = m_modules.find(moduleBase);
+        if (itModule != m_modules.end())
         {
-            m_obj = std::move(rhs.m_obj);
-            m_spIterator = std::move(rhs.m_spIterator);
-            m_value = std::move(rhs.m_value);
-            m_pos = rhs.m_pos;
-            rhs.m_pos = 0;
-            return *this;
+            auto itType = itModule->second.find(typeName);
+            if (itType != itModule->second.end())
+            {
+                if (itType->second.*pMember == nullptr)
+                {
+                    itType->second.*pMember = spValue;
+                }
+                return itType->second.*pMember;
+            }
         }
+        return spValue;
+    }
 
-        value operator*()
+    // GetCachedForType():
+    //
+    // As GetCached(), for a type which the caller already holds.  The value is computed from that type and never from
+    // a lookup of its name.  The value is computed but not cached for a type which does not belong to a module (e.g.:
+    // a synthetic type) or whose name cannot be determined, and for a type whose key is cached for a different type
+    // (e.g.: two same named types within one module).
+    //
+    template<typename TValue, typename TCompute>
+    std::shared_ptr<const TValue> GetCachedForType(_In_ const ClientEx::Type& type,
+                                                   _In_ std::shared_ptr<const TValue> Entry::*pMember,
+                                                   _In_ const TCompute& compute)
+    {
+        ComPtr<IDebugHostModule> spModule;
+        BSTR typeNameStr;
+        if (FAILED(type->GetContainingModule(&spModule)) || spModule == nullptr || FAILED(type->GetName(&typeNameStr)))
         {
-            return m_value;
+            return compute(type);
         }
 
-        value* operator->()
+        bstr_ptr spTypeName(typeNameStr);
+        std::wstring typeName(typeNameStr);
+        ULONG64 moduleBase = Module(std::move(spModule)).BaseLocation().Offset;
+
+        std::optional<Entry> cachedEntry;
         {
-            return &m_value;
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto itModule = m_modules.find(moduleBase);
+            if (itModule != m_modules.end())
+            {
+                auto itType = itModule->second.find(typeName);
+                if (itType != itModule->second.end())
+                {
+                    cachedEntry = itType->second;
+                }
+            }
         }
 
-        bool operator==(_In_ const ObjectIterator& rhs)
+        //
+        // Do not hold the lock across the comparison (which calls into the symbol engine) or the computation.
+        //
+        if (cachedEntry.has_value())
         {
-            if (m_value.GetObject() == nullptr && rhs.m_value.GetObject() == nullptr)
+            if (!Details::IsSameType(cachedEntry->CachedType, type))
             {
-                return true;
+                return compute(type);
             }
-            else if (m_value.GetObject() != nullptr && rhs.m_value.GetObject() != nullptr &&
-                     m_pos == rhs.m_pos)
+
+            if ((*cachedEntry).*pMember != nullptr)
             {
-                return true;
+                return (*cachedEntry).*pMember;
             }
-            return false;
         }
 
-        bool operator!=(_In_ const ObjectIterator& rhs)
-        {
-            return !operator==(rhs);
-        }
+        std::shared_ptr<const TValue> spValue = compute(type);
 
-        ObjectIterator operator++()
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto result = m_modules[moduleBase].emplace(typeName, Entry { type, nullptr, nullptr });
+        if (!result.second && !cachedEntry.has_value())
         {
-            MoveForward();
-            return *this;
+            //
+            // Another thread cached the key meanwhile.  It has not been compared against this type, so this value is
+            // not cached under it.
+            //
+            return spValue;
         }
 
-        ObjectIterator operator++(int)
+        Entry& entry = result.first->second;
+        if (entry.*pMember == nullptr)
         {
-            ObjectIterator cur = *this;
-            MoveForward();
-            return cur;
+            entry.*pMember = spValue;
         }
+        return entry.*pMember;
+    }
 
-    private:
-
-        void MoveForward()
+    Entry GetEntry(_In_ ULONG64 moduleBase, _In_ const Module& module, _In_ const std::wstring& typeName)
+    {
         {
-            ComPtr<IModelObject> spValue;
-            HRESULT hr = m_spIterator->GetNext(&spValue, 0, nullptr, nullptr);
-            if (SUCCEEDED(hr))
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto itModule = m_modules.find(moduleBase);
+            if (itModule != m_modules.end())
             {
-                m_value = TObj(std::move(spValue));
-            }
-            else if (hr != E_BOUNDS)
-            {
-                CheckHr(hr);
-            }
-            else
-            {
-                m_value = TObj();
-                m_pos = 0;
+                auto itType = itModule->second.find(typeName);
+                if (itType != itModule->second.end())
+                {
+                    return itType->second;
+                }
             }
         }
 
-        TObj m_obj;
-        TObj m_value;
-        ComPtr<IModelIterator> m_spIterator;
-        size_t m_pos;
-    };
+        //
+        // Do not hold the lock across the call into the symbol engine.  If two threads race on the same
+        // lookup, the first insertion wins.
+        //
+        ClientEx::Type type(module, typeName);
 
-    //*************************************************
-    // String Extraction:
-    //
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto result = m_modules[moduleBase].emplace(typeName, Entry { std::move(type), nullptr, nullptr });
+        return result.first->second;
+    }
 
-    template<typename TArg> struct StringExtractorHelper;
+    std::mutex m_lock;
+    std::unordered_map<ULONG64, std::unordered_map<std::wstring, Entry>> m_modules;
+};
 
-    template<>
-    struct StringExtractorHelper<wchar_t *>
-    {
-        static _Ret_z_ const wchar_t *GetString(_In_z_ const wchar_t *pc) { return pc; }
-    };
+//**************************************************************************
+// Bulk Symbolization:
+//
 
-    template<>
-    struct StringExtractorHelper<const wchar_t *>
-    {
-        static _Ret_z_ const wchar_t *GetString(_In_z_ const wchar_t *pc) { return pc; }
-    };
+// SymbolizationIndex:
+//
+// Symbolizes large sets of addresses (e.g.: stack samples or the return addresses of a trace) within a single
+// context.  The address ranges of the modules loaded in the context are read once into a sorted table.  Each address
+// is binary searched against that table locally rather than with a FindModuleByLocation query.  Within each module,
+// the result of each symbol lookup (including a failed one) is memoized by RVA, so an address which repeats (as the
+// return addresses of a trace do) is looked up in the symbols once.  The host does not report the extent of a
+// symbol, so a result is never applied to any address other than the one it was looked up for.  The number of
+// memoized addresses per module is bounded; once a module reaches the bound, its memoized results are dropped and
+// the memo starts over.  Modules whose range the host cannot report fall back to a query per address.
+//
+// The host does not notify clients of module loads and unloads through the data model.  A client which keeps an
+// index across target changes must call Rebuild() from its own module load/unload notifications.
+//
+// The index is safe for concurrent use.
+//
+class SymbolizationIndex
+{
+public:
 
-    template<>
-    struct StringExtractorHelper<std::wstring>
+    explicit SymbolizationIndex(_In_ const HostContext& symbolContext, _In_ size_t maxAddressesPerModule = 65536) :
+        m_context(symbolContext),
+        m_maxAddressesPerModule(maxAddressesPerModule)
     {
-        static _Ret_z_ const wchar_t *GetString(_In_ const std::wstring &str) { return str.c_str(); }
-    };
+        Rebuild();
+    }
 
-    // ExtractString():
+    SymbolizationIndex(_In_ const SymbolizationIndex&) =delete;
+    SymbolizationIndex& operator=(_In_ const SymbolizationIndex&) =delete;
+
+    // Rebuild():
     //
-    // Extracts a const wchar_t * from the incoming argument.  This allows generic passing of anything we
-    // can pull a string from (e.g.: wchar_t *, std::wstring).
+    // Rereads the modules loaded in the context and drops every memoized lookup.
     //
-    template<typename TArg>
-    _Ret_z_ const wchar_t *ExtractString(TArg&& str)
+    void Rebuild()
     {
-        return StringExtractorHelper<std::decay_t<TArg>>::GetString(std::forward<TArg>(str));
-    }
-
-    //*************************************************
-    // Key Filling:
-    //
+        ComPtr<IDebugHostSymbols> spHostSym;
+        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
 
-    template<typename TBase, typename... TArgs> struct KeyFiller;
+        ComPtr<IDebugHostSymbolEnumerator> spEnum;
+        CheckHr(spHostSym->EnumerateModules(m_context, &spEnum));
 
-    template<typename TBase>
-    struct KeyFiller<TBase>
-    {
-        static void Fill(_In_ TBase * /*pBase*/)
+        std::vector<ModuleRange> ranges;
+        for(;;)
         {
+            ComPtr<IDebugHostSymbol> spSymbol;
+            HRESULT hr = spEnum->GetNext(&spSymbol);
+            if (hr == E_BOUNDS)
+            {
+                break;
+            }
+            CheckHr(hr);
+
+            ComPtr<IDebugHostModule3> spModule3;
+            Location moduleStart;
+            Location moduleEnd;
+            if (FAILED(spSymbol.As(&spModule3)) || FAILED(spModule3->GetRange(&moduleStart, &moduleEnd)))
+            {
+                continue;
+            }
+
+            auto spEntry = std::make_shared<ModuleEntry>();
+            spEntry->ContainingModule = Module(spModule3.Get());
+            spEntry->BaseAddress = moduleStart.Offset;
+            ranges.push_back(ModuleRange { moduleStart.Offset, moduleEnd.Offset, std::move(spEntry) });
         }
-    };
 
-    // KeyFiller::Fill():
-    //
-    // Fills an IModelObject or IKeyStore with a set of keys/values provided by the variable
-    // argument pack.
-    //
-    // Each argument set in the pack must be: (stringExtractable, value)
+        std::sort(ranges.begin(), ranges.end(), [](_In_ const ModuleRange& lhs, _In_ const ModuleRange& rhs)
+        {
+            return lhs.Start < rhs.Start;
+        });
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_ranges = std::move(ranges);
+    }
+
+    // FindModule():
     //
-    //     where stringExtractable is the name and can be any type supported by ExtractString()
-    //       and value is the value of that key
+    // Returns the module containing the given address.  If no module contains the address, an empty optional is
+    // returned.
     //
-    template<typename TBase, typename TStr, typename TArg, typename... TArgs>
-    struct KeyFiller<TBase, TStr, TArg, TArgs...>
+    std::optional<Module> FindModule(_In_ ULONG64 address) const
     {
-        static void Fill(_In_ TBase *pBase, _In_ TStr&& keyName, _In_ TArg&& value, _In_ TArgs&&... remainingInitializers)
+        std::optional<Module> result;
+        std::shared_ptr<ModuleEntry> spEntry = FindEntry(address);
+        if (spEntry != nullptr)
         {
-            const wchar_t *pStr = ExtractString(keyName);
-            Object obj = BoxObject(std::forward<TArg>(value));
-            CheckHr(pBase->SetKey(pStr, obj, nullptr));
-            KeyFiller<TBase, TArgs...>::Fill(pBase, std::forward<TArgs>(remainingInitializers)...);
+            result = spEntry->ContainingModule;
         }
-    };
-
-    template<typename TBase, typename TStr, typename TArg, typename... TArgs>
-    struct KeyFiller<TBase, TStr, TArg, Metadata, TArgs...>
-
-    {
-        static void Fill(_In_ TBase *pBase, _In_ TStr&& keyName, _In_ TArg&& value, _In_ Metadata&& metadata,
-                         _In_ TArgs&&... remainingInitializers)
+        else
         {
-            const wchar_t *pStr = ExtractString(keyName);
-            Object obj = BoxObject(std::forward<TArg>(value));
-            CheckHr(pBase->SetKey(pStr, obj, metadata));
-            KeyFiller<TBase, TArgs...>::Fill(pBase, std::forward<TArgs>(remainingInitializers)...);
+            ComPtr<IDebugHostModule> spModule;
+            if (SUCCEEDED(FindModuleByQuery(address, &spModule)))
+            {
+                result = Module(std::move(spModule));
+            }
         }
-    };
-
+        return result;
+    }
 
-    //*************************************************
-    // C++ operator support on objects
+    // TrySymbolize():
     //
-
-    template<typename TObj>
-    struct ObjectOperators
+    // Returns the symbol containing the given address and the delta to the base of that symbol.  If the address
+    // cannot be symbolized, an empty optional is returned.
+    //
+    std::optional<SymbolWithOffset> TrySymbolize(_In_ ULONG64 address) const
     {
-        static TObj Increment(_In_ const TObj& src) { return Adjust(src, 1); }
-        static TObj IncrementBy(_In_ const TObj& src, LONG64 increment) { return Adjust(src, increment); }
-        static TObj Decrement(_In_ const TObj& src) { return Adjust(src, -1); }
-        static TObj DecrementBy(_In_ const TObj& src, LONG64 decrement) { return Adjust(src, decrement); }
-
-    private:
-
-        static TObj Adjust(_In_ const TObj& src, _In_ LONG64 adjustment)
+        std::shared_ptr<ModuleEntry> spEntry = FindEntry(address);
+        if (spEntry == nullptr)
         {
-            ModelObjectKind mk = src.GetKind();
-            switch(mk)
+            ComPtr<IDebugHostModule> spModule;
+            if (FAILED(FindModuleByQuery(address, &spModule)))
             {
-                case ObjectIntrinsic:
-                {
-                    Type ty = src.Type();
-                    if (ty != nullptr)
-                    {
-                        TypeKind tk = ty.GetKind();
-                        if (tk == TypePointer)
-                        {
-                            HostContext ctx = src;
-
-                            ULONG64 ptrVal = (ULONG64)src;
-                            return TObj::CreatePointer(ctx, ty, adjustment * ty.BaseType().Size() + ptrVal);
-                        }
-                    }
-                    break;
-                }
+                return std::optional<SymbolWithOffset>();
             }
 
-            throw not_implemented();
+            Module containingModule(std::move(spModule));
+            return containingModule.TryGetContainingSymbol(address - containingModule.BaseLocation().Offset);
         }
-    };
-
-    //*************************************************
-    // Universal reference constructor overloading:
-    //
 
-    template<typename... TArgs> struct VarTraits
-    {
-        using FirstType = void;
-    };
-    template<typename TArg> struct VarTraits<TArg>
-    {
-        using FirstType = TArg;
-    };
-    template<typename TArg, typename... TArgs> struct VarTraits<TArg, TArgs...>
-    {
-        using FirstType = TArg;
-    };
+        ULONG64 moduleOffset = address - spEntry->BaseAddress;
+        {
+            std::lock_guard<std::mutex> lock(spEntry->Lock);
+            auto it = spEntry->Symbols.find(moduleOffset);
+            if (it != spEntry->Symbols.end())
+            {
+                return it->second;
+            }
+        }
 
-    // IsCopyMove:
-    //
-    // Support for keeping a copy/move constructor and a universal reference constructor.
-    //
-    // Usage: (For a constructor which takes a universal reference TArg&&)
-    //
-    // template<typename TArg,
-    //          typename = std::enable_if_t<!Details::IsCopyMove_v<Object, TArg>>
-    //
-    template<typename T, typename... TArgs> struct IsCopyMove :
-        public std::bool_constant<sizeof...(TArgs) == 1 && std::is_same_v<T, std::decay_t<typename VarTraits<TArgs...>::FirstType>>> { };
-    template<typename T, typename... TArgs> constexpr bool IsCopyMove_v = IsCopyMove<T, TArgs...>::value;
+        //
+        // Do not hold the lock across the call into the symbol engine.  If two threads race on the same address,
+        // the first insertion wins.
+        //
+        std::optional<SymbolWithOffset> symbol = spEntry->ContainingModule.TryGetContainingSymbol(moduleOffset);
 
-    //*************************************************
-    // Other Detections:
+        std::lock_guard<std::mutex> lock(spEntry->Lock);
+        if (spEntry->Symbols.size() >= m_maxAddressesPerModule)
+        {
+            spEntry->Symbols.clear();
+        }
+        return spEntry->Symbols.emplace(moduleOffset, std::move(symbol)).first->second;
+    }
 
-    // IsSingleType:
+    // Symbolize():
     //
-    // Support for detecting whether an argument pack is a single argument of a given type.
+    // Symbolizes addressCount addresses in one pass.  Each result is the containing symbol and the delta to its
+    // base.  An address which cannot be symbolized has an empty symbol and a zero delta.  Returns the number of
+    // addresses which were symbolized.
     //
-    template<typename TType, typename... TArgs>
-    struct IsSingleType : public std::false_type { };
-
-    template<typename TType, typename TArg>
-    struct IsSingleType<TType, TArg> : public std::is_same<TArg, std::decay_t<TType>> { };
-
-    template<typename TType, typename... TArgs> constexpr bool IsSingleType_v = IsSingleType<TType, TArgs...>::value;
+    size_t Symbolize(_In_reads_(addressCount) const ULONG64 *pAddresses,
+                     _In_ size_t addressCount,
+                     _Out_writes_(addressCount) SymbolWithOffset *pResults) const
+    {
+        size_t symbolizedCount = 0;
+        for (size_t i = 0; i < addressCount; ++i)
+        {
+            //
+            // Neighboring samples frequently repeat an address.  Reuse the prior result without a lookup.
+            //
+            if (i > 0 && pAddresses[i] == pAddresses[i - 1])
+            {
+                pResults[i] = pResults[i - 1];
+            }
+            else
+            {
+                std::optional<SymbolWithOffset> symbol = TrySymbolize(pAddresses[i]);
+                pResults[i] = symbol ? std::move(symbol.value()) : SymbolWithOffset(Symbol(), 0);
+            }
 
-    //*************************************************
-    // ArgumentPacker:
-    //
-    // Recursive template unwind which takes a set of arbitrarily typed objects, boxes them into
-    // model objects, and returns a unique_ptr of Objects.
-    //
-    using ParameterPack = std::unique_ptr<Object[]>;
+            if (pResults[i].first.GetSymbolInterface() != nullptr)
+            {
+                ++symbolizedCount;
+            }
+        }
 
-    template<size_t i, typename... TArgs>
-    struct Packer;
+        return symbolizedCount;
+    }
 
-    template<size_t i>
-    struct Packer<i>
+#if _HAS_CXX20
+    size_t Symbolize(_In_ std::span<const ULONG64> addresses, _In_ std::span<SymbolWithOffset> results) const
     {
-        static void PackInto(ParameterPack& /*pack*/)
+        if (results.size() < addresses.size())
         {
+            throw std::invalid_argument("Result span is smaller than address span");
         }
-    };
+        return Symbolize(addresses.data(), addresses.size(), results.data());
+    }
+#endif // _HAS_CXX20
 
-    template<size_t i, typename TArg, typename... TArgs>
-    struct Packer<i, TArg, TArgs...>
+private:
+
+    struct ModuleEntry
     {
-        static void PackInto(ParameterPack& pack, TArg&& firstArg, TArgs&&... subsequentArgs)
-        {
-            pack[i] = BoxObject(std::forward<TArg>(firstArg));
-            return Packer<i + 1, TArgs...>::PackInto(pack, std::forward<TArgs>(subsequentArgs)...);
-        }
+        Module ContainingModule;
+        ULONG64 BaseAddress;
+        std::mutex Lock;
+        std::unordered_map<ULONG64, std::optional<SymbolWithOffset>> Symbols;
     };
 
-    template<typename T, typename... TArgs>
-    ParameterPack PackValuesHelper(TArgs&&... args)
+    struct ModuleRange
     {
-        size_t packSize = sizeof...(args);
-        ParameterPack argPack(new T[packSize]);
-        Packer<0, TArgs...>::PackInto(argPack, std::forward<TArgs>(args)...);
-        return argPack;
-    }
+        ULONG64 Start;
+        ULONG64 End;
+        std::shared_ptr<ModuleEntry> Entry;
+    };
 
-    // PackValues():
+    // FindEntry():
     //
-    // Packs a set of arguments into an allocated array of objects and returns it.
+    // Binary searches the module table for the module containing the address.
     //
-    template<typename... TArgs>
-    ParameterPack PackValues(TArgs&&... args)
+    std::shared_ptr<ModuleEntry> FindEntry(_In_ ULONG64 address) const
     {
-        return PackValuesHelper<Object>(std::forward<TArgs>(args)...);
-    }
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), address, [](_In_ ULONG64 value, _In_ const ModuleRange& range)
+        {
+            return value < range.Start;
+        });
 
-    template<size_t i, size_t count, typename TTuple>
-    struct TuplePacker
-    {
-        static void PackInto(ParameterPack& pack, const TTuple& tuple)
+        if (it == m_ranges.begin())
         {
-            pack[i] = BoxObject(std::get<i>(tuple));
-            return TuplePacker<i + 1, count, TTuple>::PackInto(pack, tuple);
+            return nullptr;
         }
-    };
 
-    template<size_t i, typename TTuple>
-    struct TuplePacker<i, i, TTuple>
-    {
-        static void PackInto(ParameterPack& /*pack*/, const TTuple& /*tuple*/)
+        --it;
+        if (address >= it->End)
         {
+            return nullptr;
         }
-    };
+        return it->Entry;
+    }
 
-    // PackTuple():
-    //
-    // Packs a tuple of arguments into an allocated array of objects and returns it.
-    //
-    template<typename TTuple>
-    ParameterPack PackTuple(const TTuple& tuple)
+    HRESULT FindModuleByQuery(_In_ ULONG64 address, _COM_Outptr_ IDebugHostModule **ppModule) const
     {
-        constexpr size_t packSize = std::tuple_size_v<TTuple>;
-        std::unique_ptr<Object[]> argPack(new Object[packSize]);
-        TuplePacker<0, packSize, TTuple>::PackInto(argPack, tuple);
-        return argPack;
+        *ppModule = nullptr;
+        ComPtr<IDebugHostSymbols> spHostSym;
+        HRESULT hr = GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym));
+        if (SUCCEEDED(hr))
+        {
+            hr = spHostSym->FindModuleByLocation(m_context, Location(address), ppModule);
+        }
+        return hr;
     }
 
-} // Details
+    HostContext m_context;
+    size_t m_maxAddressesPerModule;
+    mutable std::mutex m_lock;
+    std::vector<ModuleRange> m_ranges;
+};
 
 //**************************************************************************
-// Basic Wrappers:
+// Internal Implementation Details for Objects and Metadata:
 //
 
-// TypeSignature:
-//
-// Represents a type signature.
-//
-class TypeSignature
+namespace Details
 {
-public:
-
-    TypeSignature() { }
-    TypeSignature(_In_ IDebugHostTypeSignature *pTypeSignature) : m_spTypeSignature(pTypeSignature) { }
-    TypeSignature(_In_ const ComPtr<IDebugHostTypeSignature> &spTypeSignature) : m_spTypeSignature(spTypeSignature) { }
-    TypeSignature(_In_ ComPtr<IDebugHostTypeSignature>&& spTypeSignature) : m_spTypeSignature(std::move(spTypeSignature)) { }
-    TypeSignature(_In_ const TypeSignature& src) : m_spTypeSignature(src.m_spTypeSignature) { }
-    TypeSignature(_In_ TypeSignature&& src) : m_spTypeSignature(std::move(src.m_spTypeSignature)) { }
-
-    TypeSignature& operator=(_In_ const TypeSignature& src) { m_spTypeSignature = src.m_spTypeSignature; return *this; }
-    TypeSignature& operator=(_In_ TypeSignature&& src) { m_spTypeSignature = std::move(src.m_spTypeSignature); return *this; }
-
-    // TypeSignature(signature)
+    // PointerIndexerAdapter:
     //
-    // Creates a type signature for a type whose name matches the supplied string signature.  This matches regardless
-    // of module / version.
+    // An pointer math indexer adapter.  This is *NOT* a real concept which gets attached.  Rather it is an adapter
+    // such that IndexableReference<> can operate on pointers without being aware.
     //
-    TypeSignature(_In_z_ const wchar_t *signature)
+    class PointerIndexerAdapter :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IIndexableConcept
+            >
     {
-        ComPtr<IDebugHostSymbols> spHostSym;
-        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
-        ClientEx::CheckHr(spHostSym->CreateTypeSignature(signature, nullptr, &m_spTypeSignature));
-    }
+    public:
 
-    TypeSignature(_In_ std::wstring& signature)
-    {
-        ComPtr<IDebugHostSymbols> spHostSym;
-        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
-        ClientEx::CheckHr(spHostSym->CreateTypeSignature(signature.c_str(), nullptr, &m_spTypeSignature));
-    }
+        //*************************************************
+        // IIndexableConcept:
+        //
 
-    // TypeSignature(signature, module)
-    //
-    // Creates a type signature for a type whose name matches the supplied string signature within the given module.
-    //
-    template<typename TStr>
-    TypeSignature(_In_ TStr&& signature, _In_ const Module& module)
-    {
-        const wchar_t *pSignature = Details::ExtractString(signature);
-        ComPtr<IDebugHostSymbols> spHostSym;
-        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
-        ClientEx::CheckHr(spHostSym->CreateTypeSignature(pSignature, module, &m_spTypeSignature));
-    }
-
-    // TypeSignature(signature, moduleName)
-    //
-    // Creates a type signature for a type whose name and module name matches the supplied string signatures.
-    //
-    template<typename TStr1, typename TStr2,
-             typename = std::enable_if_t<!std::is_same_v<typename std::decay_t<TStr2>, Module>>>
-    TypeSignature(_In_ TStr1&& signature, _In_ TStr2&& moduleName)
-    {
-        const wchar_t *pSignature = Details::ExtractString(signature);
-        const wchar_t *pModuleName = Details::ExtractString(moduleName);
-        ComPtr<IDebugHostSymbols> spHostSym;
-        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
-        ClientEx::CheckHr(spHostSym->CreateTypeSignatureForModuleRange(pSignature,
-                                                                                pModuleName,
-                                                                                nullptr,
-                                                                                nullptr,
-                                                                                &m_spTypeSignature));
-    }
+        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                       _In_ ULONG64 *pDimensionality)
+        {
+            *pDimensionality = 1;
+            return S_OK;
+        }
 
-    // TypeSignature(signature, moduleName, minVersion)
-    //
-    // Creates a type signature for a type whose name and module name match the supplied signatures.  The module must
-    // be at least the specified version.
-    //
-    template<typename TStr1, typename TStr2, typename TStr3>
-    TypeSignature(_In_ TStr1&& signature, _In_ TStr2&& moduleName, _In_ TStr3&& minVersion)
-    {
-        const wchar_t *pSignature = Details::ExtractString(signature);
-        const wchar_t *pModuleName = Details::ExtractString(moduleName);
-        const wchar_t *pMinVersion = Details::ExtractString(minVersion);
-        ComPtr<IDebugHostSymbols> spHostSym;
-        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
-        ClientEx::CheckHr(spHostSym->CreateTypeSignatureForModuleRange(pSignature,
-                                                                                pModuleName,
-                                                                                pMinVersion,
-                                                                                nullptr,
-                                                                                &m_spTypeSignature));
-    }
+        // GetAt():
+        //
+        // Abstraction for pointer[i] where i is the indexer set.
+        //
+        IFACEMETHOD(GetAt)(_In_ IModelObject *pContextObject,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _COM_Errorptr_ IModelObject **ppObject,
+                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            *ppObject = nullptr;
+            if (ppMetadata != nullptr)
+            {
+                *ppMetadata = nullptr;
+            }
 
-    // TypeSignature(signature, moduleName, minVersion, maxVersion)
-    //
-    // Creates a type signature for a type whose name and module name match the supplied signatures.  The module must
-    // be at least the specified min version and no more than the max version.
-    //
-    template<typename TStr1, typename TStr2, typename TStr3, typename TStr4>
-    TypeSignature(_In_ TStr1&& signature, _In_ TStr2&& moduleName, _In_ TStr3&& minVersion, _In_ TStr4&& maxVersion)
-    {
-        const wchar_t *pSignature = Details::ExtractString(signature);
-        const wchar_t *pModuleName = Details::ExtractString(moduleName);
-        const wchar_t *pMinVersion = Details::ExtractString(minVersion);
-        const wchar_t *pMaxVersion = Details::ExtractString(maxVersion);
-        ComPtr<IDebugHostSymbols> spHostSym;
-        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
-        ClientEx::CheckHr(spHostSym->CreateTypeSignatureForModuleRange(pSignature,
-                                                                                pModuleName,
-                                                                                pMinVersion,
-                                                                                pMaxVersion,
-                                                                                &m_spTypeSignature));
-    }
+            try
+            {
+                if (indexerCount != 1)
+                {
+                    throw illegal_operation("Pointer indexing may only be single dimensional");
+                }
 
-    operator IDebugHostTypeSignature* () const { return m_spTypeSignature.Get(); }
+                ULONG64 ptrValue;
+                ComPtr<IDebugHostType> spBaseType;
+                GetAdjustedLocationAndBaseType(pContextObject, ppIndexers[0], &ptrValue, &spBaseType);
 
-protected:
 
-    ComPtr<IDebugHostTypeSignature> m_spTypeSignature;
-};
+                ComPtr<IDebugHostContext> spCtx;
+                CheckHr(pContextObject->GetContext(&spCtx));
 
-//**************************************************************************
-// Metadata:
-//
-// Represents metadata in the object model
-//
+                ComPtr<IModelObject> spObject;
+                CheckHr(Tracing::HostCall("CreateTypedObject", [&]() { return GetManager()->CreateTypedObject(spCtx.Get(), ptrValue, spBaseType.Get(), &spObject); }));
 
-// Metadata:
-//
-// Represents object metadata which can be set on keys or returned in various other contexts.
-//
-class Metadata
-{
-public:
+                *ppObject = spObject.Detach();
+                return S_OK;
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception(), ppObject);
+            }
+        }
 
-    Metadata() { }
-    Metadata(_In_ const Metadata &src) : m_spKeyStore(src.m_spKeyStore) { }
-    Metadata(_In_ Metadata&& src) : m_spKeyStore(std::move(src.m_spKeyStore)) { }
-    Metadata(_In_ IKeyStore *pKeyStore) : m_spKeyStore(pKeyStore) { }
-    Metadata(_In_ ComPtr<IKeyStore>& spKeyStore) : m_spKeyStore(spKeyStore) { }
-    Metadata(_In_ const ComPtr<IKeyStore>& spKeyStore) : m_spKeyStore(spKeyStore) { }
-    Metadata(_In_ ComPtr<IKeyStore>&& spKeyStore) : m_spKeyStore(std::move(spKeyStore)) { }
+        // SetAt():
+        //
+        // Abstraction for pointer[i] = value where i is the indexer set.
+        //
+        IFACEMETHOD(SetAt)(_In_ IModelObject *pContextObject,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _In_ IModelObject *pValue)
+        {
+            try
+            {
+                if (indexerCount != 1)
+                {
+                    throw illegal_operation("Pointer indexing may only be single dimensional");
+                }
 
-    Metadata& operator=(_In_ const Metadata& rhs)
-    {
-        m_spKeyStore = rhs.m_spKeyStore;
-        return *this;
-    }
+                ULONG64 ptrValue;
+                ComPtr<IDebugHostType> spBaseType;
+                GetAdjustedLocationAndBaseType(pContextObject, ppIndexers[0], &ptrValue, &spBaseType);
 
-    Metadata& operator=(_In_ Metadata&& rhs)
-    {
-        m_spKeyStore = std::move(rhs.m_spKeyStore);
-        return *this;
-    }
+                //
+                // Create a linguistic reference to the underlying value and ask the core EE to perform
+                // whatever assignment it can.
+                //
+                ComPtr<IDebugHostType> spRefType;
+                CheckHr(spBaseType->CreatePointerTo(PointerReference, &spRefType));
 
-    template<typename... TArgs,
-             typename = std::enable_if_t<!Details::IsCopyMove_v<Metadata, TArgs...>>>
-    explicit Metadata(_In_ TArgs&&... initializers);
+                VARIANT vtPtr;
+                vtPtr.ullVal = ptrValue;
+                vtPtr.vt = VT_UI8;
 
-    operator IKeyStore *() const { return m_spKeyStore.Get(); }
-    IKeyStore *operator->() const { return m_spKeyStore.Get(); }
-    IKeyStore *Detach() { return m_spKeyStore.Detach(); }
+                ComPtr<IModelObject> spObject;
+                CheckHr(GetManager()->CreateTypedIntrinsicObject(&vtPtr, spRefType.Get(), &spObject));
 
-    Object KeyValue(_In_z_ const wchar_t *keyName) const;
+                ComPtr<IDebugHostEvaluator2> spEval2;
+                CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval2)));
+                ComPtr<IModelObject> spEvalResult;
+                HRESULT hr = spEval2->AssignTo(spObject.Get(), pValue, &spEvalResult, nullptr);
+                CheckHr(hr, spEvalResult);
 
-    template<typename... TArgs,
-             typename = std::enable_if_t<!Details::IsCopyMove_v<Metadata, TArgs...>>>
-    void SetKeys(_In_ TArgs&&... initializers);
+                return S_OK;
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception());
+            }
+        }
 
-private:
+    private:
 
-    void EnsureCreated()
-    {
-        if (m_spKeyStore != nullptr)
+        // GetAdjustedLocationAndBaseType():
+        //
+        // Performs the underlying pointer math and returns the pointer value (location) and the underlying
+        // type.
+        //
+        _Success_(true) void GetAdjustedLocationAndBaseType(_In_ IModelObject *pContextObject,
+                                                            _In_ IModelObject *pIndex,
+                                                            _Out_ ULONG64 *pAdjustedPointer,
+                                                            _COM_Outptr_ IDebugHostType **ppBaseType)
         {
-            return;
-        }
+            *ppBaseType = nullptr;
 
-        CheckHr(GetManager()->CreateMetadataStore(nullptr, &m_spKeyStore));
-    }
+            ComPtr<IDebugHostType> spType;
+            CheckHr(pContextObject->GetTypeInfo(&spType));
 
-    ComPtr<IKeyStore> m_spKeyStore;
+            if (spType == nullptr)
+            {
+                throw unexpected_error();
+            }
 
-};
+            TypeKind tk;
+            CheckHr(spType->GetTypeKind(&tk));
 
-//**************************************************************************
-//
-// Object:
-//
-// Represents an object in the data model
-//
+            PointerKind pk;
+            CheckHr(spType->GetPointerKind(&pk));
 
-class Deconstruction;
+            if (tk != TypePointer || pk != PointerStandard)
+            {
+                throw unexpected_error();
+            }
 
-class Object
-{
-public:
+            ComPtr<IDebugHostType> spBaseType;
+            CheckHr(spType->GetBaseType(&spBaseType));
 
-    using iterator = Details::ObjectIterator<Object>;
-    using const_iterator = Details::ObjectIterator<Object>;
+            ULONG64 baseSize;
+            CheckHr(spBaseType->GetSize(&baseSize));
 
-    //*************************************************
-    // Factory Methods:
-    //
+            VARIANT vtPtr;
+            CheckHr(pContextObject->GetIntrinsicValueAs(VT_UI8, &vtPtr));
 
-    // RootNamespace():
+            VARIANT vtAdjustment;
+            CheckHr(pIndex->GetIntrinsicValueAs(VT_I8, &vtAdjustment));
+
+            *pAdjustedPointer = vtPtr.ullVal + (baseSize * vtAdjustment.llVal);
+            *ppBaseType = spBaseType.Detach();
+        }
+
+    };
+
+    // IndexableReference:
     //
-    // Returns the root namespace of the host.
+    // A type which represents a reference value to an index operator.  operator[] on objects
+    // returns this to provide both value conversion and back assignment.
     //
-    static Object RootNamespace()
-    {
-        ComPtr<IModelObject> spObj;
-        CheckHr(GetManager()->GetRootNamespace(&spObj));
-        return Object(std::move(spObj));
-    }
-
-    // CurrentContext():
-    //
-    // Returns a boxed representation of the current context of the host.
-    //
-    static Object CurrentContext()
-    {
-        ComPtr<IDebugHostContext> spCtx;
-        CheckHr(GetHost()->GetCurrentContext(&spCtx));
-        return Object(std::move(spCtx));
-    }
-
-    // SessionOf():
-    //
-    // Returns the session associated with the given object.  If no session is associated with the
-    // given object, an exception is thrown.
-    //
-    static Object SessionOf(_In_ const Object& obj)
-    {
-        return RootNamespace().KeyValue(L"Debugger").KeyValue(L"Sessions")[obj];
-    }
-
-    // ProcessOf():
-    //
-    // Returns the process associated with the given object.  If no process is associated with the
-    // given object, an exception is thrown.
+    // NOTE:
+    //     TObj  is expected to be ClientEx::Object
+    //     TPack is parameter pack for the indexing operation (a unique pointer of ClientEx::Object>
     //
-    static Object ProcessOf(_In_ const Object& obj)
-    {
-        return SessionOf(obj).KeyValue(L"Processes")[obj];
-    }
-
-    // ThreadOf():
+    // Indexers packed into an InlineParameterPack are held inline rather than in a TPack so that indexing with a
+    // few indexers does not allocate.
     //
-    // Returns the thread associated with the given object.  If no thread is associated with the
-    // given object, an exception is thrown.
+    // @TODO: Reorganize and remove template parameters
     //
-    static Object ThreadOf(_In_ const Object& obj)
-    {
-        return ProcessOf(obj).KeyValue(L"Threads")[obj];
-    }
+    template<size_t N> class InlineParameterPack;
+    constexpr size_t InlineParameterPackLimit = 8;
 
-    // CurrentSession():
-    //
-    // Returns the current session of the host.
-    //
-    static Object CurrentSession()
+    template<typename TObj, typename TPack>
+    class IndexableReference
     {
-        return SessionOf(CurrentContext());
-    }
+    public:
 
-    // CurrentProcess():
-    //
-    // Returns the current process of the host.
-    //
-    static Object CurrentProcess()
-    {
-        return ProcessOf(CurrentContext());
-    }
+        // IndexableReference():
+        //
+        // Creates an indexable reference taking ownership of the indexer pack and the indexable.
+        //
+        IndexableReference(_In_ size_t packSize,
+                           _In_ TPack&& indexers,
+                           _In_ ComPtr<IIndexableConcept>&& spIndexable,
+                           _In_ IModelObject *pSrcObject) :
+                           m_packSize(packSize),
+                           m_indexers(std::move(indexers)),
+                           m_spIndexable(std::move(spIndexable)),
+                           m_spSrcObject(pSrcObject)
+        {
+        }
 
-    // CurrentThread():
-    //
-    // Returns the current thread of the host.
-    //
-    static Object CurrentThread()
-    {
-        return ThreadOf(CurrentContext());
-    }
+        template<size_t N>
+        IndexableReference(_In_ size_t packSize,
+                           _In_ InlineParameterPack<N>&& indexers,
+                           _In_ ComPtr<IIndexableConcept>&& spIndexable,
+                           _In_ IModelObject *pSrcObject) :
+                           m_packSize(packSize),
+                           m_spIndexable(std::move(spIndexable)),
+                           m_spSrcObject(pSrcObject)
+        {
+            static_assert(N <= InlineParameterPackLimit, "Inline indexer pack is too large");
+            for (size_t i = 0; i < N; ++i)
+            {
+                m_inlineIndexers[i] = std::move(indexers[i]);
+            }
+        }
 
-    // Create():
-    //
-    // Creates a new empty object with the given context.
-    //
-    template<typename... TArgs>
-    static Object Create(_In_ const HostContext& hostContext, _In_ TArgs&&... initializers)
-    {
-        ComPtr<IModelObject> spObj;
-        CheckHr(GetManager()->CreateSyntheticObject(hostContext, &spObj));
-        Details::KeyFiller<IModelObject, TArgs...>::Fill(spObj.Get(), std::forward<TArgs>(initializers)...);
-        return Object(std::move(spObj));
-    }
+        // operator Object
+        //
+        // Performs a get of the value
+        //
+        operator TObj() const
+        {
+            return GetValue();
+        }
 
-    // Create():
-    //
-    // Creates a new empty object from metadata (key store) with the given context .
-    //
-    template<typename... TArgs>
-    static Object Create(_In_ const HostContext& hostContext, _In_ const Metadata& metadata, _In_ TArgs&&... initializers)
-    {
-        Microsoft::WRL::ComPtr<IDataModelManager4> spDataModelManager4;
+        // operator=
+        //
+        // Perform assignment to another value.
+        //
+        template<typename T>
+        void operator=(T&& assignmentValue)
         {
-            Microsoft::WRL::ComPtr<IDataModelManager> spDataModelManager = GetManager();
-            CheckHr(spDataModelManager.As(&spDataModelManager4));
+            TObj assignment = BoxObject(std::forward<T>(assignmentValue));
+            SetValue(assignment);
         }
 
-        ComPtr<IModelObject> spObj;
-        CheckHr(spDataModelManager4->CreateSyntheticObjectFromKeyStore(hostContext, metadata, &spObj));
-        Details::KeyFiller<IModelObject, TArgs...>::Fill(spObj.Get(), std::forward<TArgs>(initializers)...);
-        return Object(std::move(spObj));
-    }
+        // GetValue():
+        //
+        // Gets a value from the indexer.
+        //
+        TObj GetValue() const
+        {
+            ComPtr<IModelObject> spResult;
+            HRESULT hr = m_spIndexable->GetAt(m_spSrcObject.Get(),
+                                              m_packSize,
+                                              GetIndexers(),
+                                              &spResult,
+                                              nullptr);
+            CheckHr(hr, spResult);
 
-    // CreateTyped():
-    //
-    // Creates a new typed object.
-    //
-    static Object CreateTyped(_In_ const Type& objectType, _In_ const Location& objectLocation)
-    {
-        ComPtr<IModelObject> spObj;
-        CheckHr(GetManager()->CreateTypedObject(nullptr, objectLocation, objectType, &spObj));
-        return Object(std::move(spObj));
-    }
+            //
+            // @TODO: A number of indexers have a habit of returning a reference to the underlying object
+            //        since there is no such thing as an IModelIndex*Reference.  Paper over this and get the
+            //        underlying value since we are creating such an abstraction in C++.
+            //
+            ComPtr<IModelObject> spValue;
 
-    // CreateTyped():
-    //
-    // Creates a new typed object.
-    //
-    static Object CreateTyped(_In_ const HostContext& hostContext, _In_ const Type& objectType, _In_ const Location& objectLocation)
-    {
-        ComPtr<IModelObject> spObj;
-        CheckHr(GetManager()->CreateTypedObject(hostContext, objectLocation, objectType, &spObj));
-        return Object(std::move(spObj));
-    }
+            ModelObjectKind mk;
+            CheckHr(spResult->GetKind(&mk));
+            switch(mk)
+            {
+                case ObjectTargetObjectReference:
+                    CheckHr(spResult->Dereference(&spValue));
+                    break;
 
-    // CreatePointer():
-    //
-    // Creates a new pointer object.
-    //
-    static Object CreatePointer(_In_ const Type& pointerType, _In_ ULONG64 ptrValue)
-    {
-        if (pointerType.GetKind() != TypePointer)
+                default:
+                    spValue = std::move(spResult);
+                    break;
+            }
+
+            return TObj(std::move(spValue));
+        }
+
+        // Conversions:
+        //
+        template<typename TType> TType As() const { return GetValue().As<TType>(); }
+        template<typename TType> explicit operator TType() const { return As<TType>(); }
+
+    private:
+
+        // SetValue():
+        //
+        // Sets a value on the indexer.
+        //
+        void SetValue(_In_ const TObj& value)
         {
-            throw std::invalid_argument("Supplied type is not a pointer");
+            HRESULT hr = m_spIndexable->SetAt(m_spSrcObject.Get(),
+                                              m_packSize,
+                                              GetIndexers(),
+                                              value);
+            CheckHr(hr);
         }
 
-        VARIANT vtPtr; vtPtr.vt = VT_UI8; vtPtr.ullVal = ptrValue;
+        // GetIndexers():
+        //
+        // Returns the indexers as an argument array, wherever they are held.
+        //
+        IModelObject **GetIndexers() const
+        {
+            const TObj *pIndexers = (m_indexers ? m_indexers.get() : m_inlineIndexers);
+            return reinterpret_cast<IModelObject **>(const_cast<TObj *>(pIndexers));
+        }
 
-        ComPtr<IModelObject> spObj;
-        CheckHr(GetManager()->CreateTypedIntrinsicObject(&vtPtr, pointerType, &spObj));
-        return Object(std::move(spObj));
-    }
+        size_t m_packSize;
+        TPack m_indexers;
+        TObj m_inlineIndexers[InlineParameterPackLimit];
+        ComPtr<IIndexableConcept> m_spIndexable;
+        ComPtr<IModelObject> m_spSrcObject;
+    };
 
-    // CreatePointer():
+    // ObjectKeyRef:
     //
-    // Creates a new pointer object.
+    // Represents a reference to a key.  Keys()[name] returns this so that both value returns
+    // and back assignment to the key is supported.
     //
-    static Object CreatePointer(_In_ const HostContext& hostContext, _In_ const Type& pointerType, _In_ ULONG64 ptrValue)
+    template<typename TObj, typename TMeta>
+    class ObjectKeyRef
     {
-        if (pointerType.GetKind() != TypePointer)
+    public:
+
+        ObjectKeyRef() { }
+
+        ObjectKeyRef(_In_ TObj&& keyRef) :
+            m_keyRef(std::move(keyRef))
         {
-            throw std::invalid_argument("Supplied type is not a pointer");
         }
 
-        VARIANT vtPtr; vtPtr.vt = VT_UI8; vtPtr.ullVal = ptrValue;
+        IModelObject *GetObject() const
+        {
+            return m_keyRef;
+        }
 
-        ComPtr<IDataModelManager2> spManager2;
+        operator TObj() const
         {
-            ComPtr<IDataModelManager> spManager = GetManager();
+            return GetValue();
+        }
 
-            CheckHr(spManager.As(&spManager2));
+        operator TMeta() const
+        {
+            return GetMetadata();
         }
 
-        ComPtr<IModelObject> spObj;
-        CheckHr(spManager2->CreateTypedIntrinsicObjectEx(hostContext, &vtPtr, pointerType, &spObj));
-        return Object(std::move(spObj));
-    }
+        template<typename T>
+        ObjectKeyRef& operator=(T&& val)
+        {
+            TObj boxedValue = BoxObject(std::forward<T>(val));
+            SetValue(boxedValue);
+            return *this;
+        }
 
-    // CreateNoValue():
-    //
-    // Creates a "No Value" object.
-    //
-    static Object CreateNoValue()
-    {
-        ComPtr<IModelObject> spObj;
-        CheckHr(GetManager()->CreateNoValue(&spObj));
-        return Object(std::move(spObj));
-    }
+        TObj GetValue() const
+        {
+            CheckObject();
+            IModelKeyReference *pKeyRef = m_keyRef.As<IModelKeyReference *>();
+            ComPtr<IModelObject> spValue;
+            HRESULT hr = Tracing::HostCall("GetKeyValue", [&]() { return pKeyRef->GetKeyValue(&spValue, nullptr); });
+            CheckHr(hr, spValue);
+            return TObj(std::move(spValue));
+        }
 
-    // CreateError():
-    //
-    // Creates an error object from an hresult and a string.
-    //
-    template<typename TStr>
-    static Object CreateError(_In_ HRESULT hr, _In_ TStr &&str)
-    {
-        ComPtr<IModelObject> spError;
-        CheckHr(GetManager()->CreateErrorObject(hr, Details::ExtractString(str), &spError));
-        return Object(std::move(spError));
-    }
+        TMeta GetMetadata() const
+        {
+            CheckObject();
+            IModelKeyReference *pKeyRef = m_keyRef.As<IModelKeyReference *>();
+            //
+            // @TODO: We should *NOT* have to get the value here.  The interface declares this _In_opt_ but
+            // it AV's if you pass nullptr for the value.
+            //
+            ComPtr<IKeyStore> spMetadata;
+            ComPtr<IModelObject> spValue;
+            HRESULT hr = Tracing::HostCall("GetKeyValue", [&]() { return pKeyRef->GetKeyValue(&spValue, &spMetadata); });
+            CheckHr(hr);
+            return TMeta(std::move(spMetadata));
+        }
 
-    // CreateError():
-    //
-    // Creates an error object from an exception pointer.
-    //
-    static Object CreateError(_In_ const std::exception_ptr& exptr)
-    {
-        ComPtr<IModelObject> spError;
-        auto hr = Details::Exceptions::ReturnResult(exptr, &spError);
-        if (!spError) {
-            CheckHr(GetManager()->CreateErrorObject(hr, nullptr, &spError));
+        // Conversions:
+        //
+        template<typename TType> TType As() const { return GetValue().As<TType>(); }
+        template<typename TType> explicit operator TType() const { return As<TType>(); }
+
+    private:
+
+        void CheckObject() const
+        {
+            if (m_keyRef.GetObject() == nullptr)
+            {
+                throw ClientEx::unexpected_error();
+            }
         }
 
-        return Object(std::move(spError));
-    }
+        void SetValue(_In_ const TObj& val) const
+        {
+            CheckObject();
+            IModelKeyReference *pKeyReference = m_keyRef.As<IModelKeyReference *>();
+            CheckHr(pKeyReference->SetKeyValue(val));
+        }
 
-    // FromExpressionEvaluation():
+        TObj m_keyRef;
+    };
+
+    // KeyNameEnumerator:
     //
-    // Creates an object from a language expression evaluation.  This may only use the underlying
-    // syntax of the language.  There is a guarantee that such is portable from host to host (as long as both hosts
-    // debug the same language)
+    // Adapts IKeyEnumerator for NameIterator<>.  No value or metadata is fetched.
     //
-    template<typename TStr>
-    static Object FromExpressionEvaluation(_In_ const HostContext& evaluationContext, _In_ TStr&& expression)
+    struct KeyNameEnumerator
     {
-        ComPtr<IModelObject> spObj;
-        ComPtr<IDebugHostEvaluator> spEval;
-        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval)));
-        CheckHr(spEval->EvaluateExpression(evaluationContext, Details::ExtractString(expression), nullptr, &spObj, nullptr));
-        return Object(std::move(spObj));
-    }
+        using EnumeratorType = IKeyEnumerator;
 
-    // FromExtendedExpressionEvaluation():
+        static HRESULT GetNextName(_In_ IKeyEnumerator *pEnum, _Out_ BSTR *pName)
+        {
+            return pEnum->GetNext(pName, nullptr, nullptr);
+        }
+    };
+
+    // FieldNameEnumerator:
     //
-    // Creates an object from a host specific expression evaluation.  This may use any syntax the underlying host supports; however,
-    // there is *NO GUARANTEE* that such is portable from host to host.
+    // Adapts IRawEnumerator for NameIterator<>.  No value is fetched.
     //
-    template<typename TStr>
-    static Object FromExtendedExpressionEvaluation(_In_ const HostContext& evaluationContext, _In_ TStr&& expression)
+    struct FieldNameEnumerator
     {
-        ComPtr<IModelObject> spObj;
-        ComPtr<IDebugHostEvaluator> spEval;
-        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval)));
-        CheckHr(spEval->EvaluateExtendedExpression(evaluationContext, Details::ExtractString(expression), nullptr, &spObj, nullptr));
-        return Object(std::move(spObj));
-    }
+        using EnumeratorType = IRawEnumerator;
+
+        static HRESULT GetNextName(_In_ IRawEnumerator *pEnum, _Out_ BSTR *pName)
+        {
+            SymbolKind sk;
+            return pEnum->GetNext(pName, &sk, nullptr);
+        }
+    };
 
+    // NameIterator:
     //
-    // @TODO: This is **NOT** complete.
+    // A C++ input iterator which yields only the names of the keys or fields of an object.  The yielded
+    // std::wstring_view refers to the BSTR owned by the iterator and is only valid until the iterator is
+    // advanced.  Copy it into a std::wstring to keep it.
     //
-    static Object FromSymbol(_In_ IDebugHostSymbol *pSymbol)
+    template<typename TNameEnumerator>
+    class NameIterator
     {
-        SymbolKind sk;
-        CheckHr(pSymbol->GetSymbolKind(&sk));
+    public:
 
-        switch(sk)
+        using EnumeratorType = typename TNameEnumerator::EnumeratorType;
+        using value_type = std::wstring_view;
+
+        NameIterator() : m_pos(0) { }
+
+        NameIterator(_In_ EnumeratorType *pEnum) :
+            m_spEnum(pEnum),
+            m_pos(0)
         {
-            case SymbolData:
+            MoveForward();
+        }
+
+        NameIterator(_In_ const NameIterator& rhs) :
+            m_spEnum(rhs.m_spEnum),
+            m_pos(rhs.m_pos)
+        {
+            if (rhs.m_spName != nullptr)
             {
-                ComPtr<IDebugHostData> spData;
-                CheckHr(pSymbol->QueryInterface(IID_PPV_ARGS(&spData)));
+                m_spName.reset(SysAllocStringLen(rhs.m_spName.get(), SysStringLen(rhs.m_spName.get())));
+                if (m_spName == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+        }
 
-                ComPtr<IDebugHostType> spType;
-                Location loc;
+        NameIterator(_In_ NameIterator&& rhs) :
+            m_spEnum(std::move(rhs.m_spEnum)),
+            m_spName(std::move(rhs.m_spName)),
+            m_pos(rhs.m_pos)
+        {
+            rhs.m_pos = 0;
+        }
 
-                CheckHr(spData->GetType(&spType));
-                CheckHr(spData->GetLocation(&loc));
+        NameIterator& operator=(_In_ const NameIterator& rhs)
+        {
+            NameIterator copy(rhs);
+            return operator=(std::move(copy));
+        }
 
-                ComPtr<IModelObject> spObj;
-                CheckHr(GetManager()->CreateTypedObject(nullptr, loc, spType.Get(), &spObj));
-                return Object(std::move(spObj));
+        NameIterator& operator=(_In_ NameIterator&& rhs)
+        {
+            m_spEnum = std::move(rhs.m_spEnum);
+            m_spName = std::move(rhs.m_spName);
+            m_pos = rhs.m_pos;
+            rhs.m_pos = 0;
+            return *this;
+        }
+
+        bool operator==(_In_ const NameIterator& rhs) const
+        {
+            if (m_spName == nullptr || rhs.m_spName == nullptr)
+            {
+                return m_spName == nullptr && rhs.m_spName == nullptr;
             }
+            return m_pos == rhs.m_pos;
+        }
 
-            default:
-                // @TODO:
-                throw not_implemented();
+        bool operator!=(_In_ const NameIterator& rhs) const
+        {
+            return !operator==(rhs);
         }
-    }
 
-    template<typename TStr1, typename TStr2>
-    static Object FromGlobalSymbol(const HostContext& symbolContext,
-                                   TStr1&& moduleName,
-                                   TStr2&& symbolName)
-    {
-        Module symMod(symbolContext, Details::ExtractString(moduleName));
+        value_type operator*() const
+        {
+            return value_type(m_spName.get(), SysStringLen(m_spName.get()));
+        }
 
-        ComPtr<IDebugHostSymbols> spSymbols;
-        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spSymbols)));
+        NameIterator& operator++()
+        {
+            MoveForward();
+            return *this;
+        }
 
-        ComPtr<IDebugHostSymbol> spSymbol;
-        CheckHr(symMod->FindSymbolByName(Details::ExtractString(symbolName), &spSymbol));
+    private:
 
-        return FromSymbol(spSymbol.Get());
-    }
+        void MoveForward()
+        {
+            BSTR name;
+            HRESULT hr = TNameEnumerator::GetNextName(m_spEnum.Get(), &name);
+            if (SUCCEEDED(hr))
+            {
+                m_spName.reset(name);
+                ++m_pos;
+            }
+            else if (hr != E_BOUNDS)
+            {
+                CheckHr(hr);
+            }
+            else
+            {
+                m_spName.reset();
+                m_pos = 0;
+            }
+        }
 
-    // FromModelName():
-    //
-    // Returns an object based on a lookup from a registered model name.
-    //
-    template<typename TStr>
-    static Object FromModelName(TStr&& modelName)
-    {
-        std::wstring name = Details::ExtractString(modelName);
-        ComPtr<IModelObject> spModel;
-        CheckHr(GetManager()->AcquireNamedModel(name.c_str(), &spModel));
-        return Object(std::move(spModel));
-    }
+        ComPtr<EnumeratorType> m_spEnum;
+        bstr_ptr m_spName;
+        size_t m_pos;
+    };
 
-    // CreateInstanceOf():
+    // ObjectNamesRef:
     //
-    // Creates a synthetic object which is an instance of a particular data model.
+    // The object returned from Keys().NamesOnly() and Fields().NamesOnly() to reference the names of the keys or
+    // fields of an object.
     //
-    static Object CreateInstanceOf(_In_ const Object& model,
-                                   _In_ const HostContext& hostContext)
+    template<typename TNameEnumerator>
+    class ObjectNamesRef
     {
-        Object o = Create(hostContext);
-        CheckHr(o->AddParentModel(model, nullptr, false));
+    public:
 
-        return o;
-    }
+        using iterator = NameIterator<TNameEnumerator>;
+        using EnumeratorType = typename TNameEnumerator::EnumeratorType;
 
-    // ConstructModelInstance():
-    //
-    // Creates an instance of a named model which supports the constructable concept.
-    //
-    template<typename TStr, typename... TArgs>
-    static Object ConstructModelInstance(TStr&& name, TArgs&&... args)
-    {
-        Object dataModel = Object::FromModelName(std::forward<TStr>(name));
-        return dataModel.ConstructInstance(std::forward<TArgs>(args)...);
-    }
+        ObjectNamesRef(_In_ ComPtr<EnumeratorType> spEnum) :
+            m_spEnum(std::move(spEnum)),
+            m_started(false)
+        {
+        }
 
-    //*************************************************
-    // Object Methods:
-    //
+        iterator begin()
+        {
+            if (m_started)
+            {
+                CheckHr(m_spEnum->Reset());
+            }
+            m_started = true;
+            return iterator(m_spEnum.Get());
+        }
 
-    Object() { }
-    Object(_In_ IModelObject *pObject) : m_spObject(pObject) { }
-    Object(_In_ const Object& src) : m_spObject(src.m_spObject) { }
-    Object(_In_ Object&& src) : m_spObject(std::move(src.m_spObject)) { }
-    Object(_In_ ComPtr<IModelObject>& src) : m_spObject(src) { }
-    Object(_In_ const ComPtr<IModelObject>& src) : m_spObject(src) { }
-    Object(_In_ ComPtr<IModelObject>&& src) : m_spObject(std::move(src)) { }
-    Object(_In_ std::nullptr_t) { }
+        iterator end()
+        {
+            return iterator();
+        }
 
-    // Constructor:
-    //
-    // Construct from arbitrary type.
-    //
-    template<typename TArg,
-             typename = std::enable_if_t<!Details::IsCopyMove_v<Object, TArg>>>
-    Object(_In_ TArg&& value);
+    private:
 
-    template<typename TArg> explicit operator TArg() const { return As<TArg>(); }
+        ComPtr<EnumeratorType> m_spEnum;
+        bool m_started;
+    };
+
+    // ObjectKeysRef():
+    //
+    // The object returned from Keys() to reference the set of keys on an object.
+    //
+    template<typename TObj, typename TMeta>
+    class ObjectKeysRef
+    {
+    public:
+
+        // KeyIterator():
+        //
+        // A C++ input iterator for the keys within an object.
+        //
+        class KeyIterator
+        {
+        public:
+
+            using value_type = std::tuple<std::wstring, ObjectKeyRef<TObj, TMeta>, TMeta>;
+
+            KeyIterator() : m_pos(0) { }
+
+            KeyIterator(_In_ IKeyEnumerator *pKeyEnum) : KeyIterator(pKeyEnum, 0) { }
+
+            KeyIterator(_In_ IKeyEnumerator *pKeyEnum, _In_ size_t pos) :
+                m_spEnum(pKeyEnum),
+                m_pos(pos)
+            {
+                MoveForward();
+            }
+
+            KeyIterator(_In_ const KeyIterator& rhs) :
+                m_spEnum(rhs.m_spEnum),
+                m_value(rhs.m_value),
+                m_pos(rhs.m_pos)
+            {
+            }
+
+            KeyIterator(_In_ KeyIterator&& rhs) :
+                m_spEnum(std::move(rhs.m_spEnum)),
+                m_value(std::move(rhs.m_value)),
+                m_pos(rhs.m_pos)
+            {
+                rhs.m_pos = 0;
+            }
+
+            KeyIterator& operator=(_In_ const KeyIterator& rhs)
+            {
+                m_spEnum = rhs.m_spEnum;
+                m_value = rhs.m_value;
+                m_pos = rhs.m_pos;
+                return *this;
+            }
+
+            KeyIterator& operator=(KeyIterator&& rhs)
+            {
+                m_spEnum = std::move(rhs.m_spEnum);
+                m_value = std::move(rhs.m_value);
+                m_pos = rhs.m_pos;
+                rhs.m_pos = 0;
+                return *this;
+            }
+
+            bool operator==(_In_ const KeyIterator& rhs) const
+            {
+                if (std::get<1>(m_value).GetObject() == nullptr && std::get<1>(rhs.m_value).GetObject() == nullptr)
+                {
+                    return true;
+                }
+                else if (std::get<1>(m_value).GetObject() != nullptr && std::get<1>(rhs.m_value).GetObject() != nullptr && m_pos == rhs.m_pos)
+                {
+                    return true;
+                }
+
+                return false;
+            }
+
+            bool operator!=(_In_ const KeyIterator& rhs) const
+            {
+                return !operator==(rhs);
+            }
+
+            //
+            // The value is returned by reference.  Through a non-const iterator, the key reference within it may be
+            // assigned to (setting the key on the object).
+            //
+            value_type& operator*()
+            {
+                return m_value;
+            }
+
+            const value_type& operator*() const
+            {
+                return m_value;
+            }
+
+            const value_type* operator->() const
+            {
+                return &m_value;
+            }
+
+            KeyIterator& operator++()
+            {
+                MoveForward();
+                return *this;
+            }
+
+            KeyIterator operator++(int)
+            {
+                KeyIterator cur = *this;
+                MoveForward();
+                return cur;
+            }
+
+        private:
+
+            void MoveForward()
+            {
+                BSTR keyName;
+                ComPtr<IModelObject> spValue;
+                ComPtr<IKeyStore> spMetadata;
+                HRESULT hr = Tracing::HostCall("GetNext", [&]() { return m_spEnum->GetNext(&keyName, &spValue, &spMetadata); });
+                if (SUCCEEDED(hr))
+                {
+                    bstr_ptr fldPtr(keyName);
+                    ObjectKeyRef<TObj, TMeta> keyRef(std::move(spValue));
+                    TMeta metadata = std::move(spMetadata);
+                    m_value = std::make_tuple(std::wstring(keyName), std::move(keyRef), std::move(metadata));
+                    ++m_pos;
+                }
+                else if (hr != E_BOUNDS)
+                {
+                    CheckHr(hr);
+                }
+                else
+                {
+                    m_value = std::make_tuple(std::wstring(), ObjectKeyRef<TObj, TMeta>(), TMeta());
+                    m_pos = 0;
+                }
+            }
+
+            ComPtr<IKeyEnumerator> m_spEnum;
+            value_type m_value;
+            size_t m_pos;
+
+        };
+
+        using iterator = KeyIterator;
+
+        ObjectKeysRef(_In_ const TObj& obj) :
+            m_obj(obj)
+        {
+        }
+
+        // operator[]:
+        //
+        // Returns a "reference" to a key.
+        //
+        ObjectKeyRef<TObj, TMeta> operator[](_In_z_ const wchar_t *keyName)
+        {
+            ComPtr<IModelObject> spKeyRef;
+            HRESULT hr = m_obj->GetKeyReference(keyName, &spKeyRef, nullptr);
+            CheckHr(hr, spKeyRef);
+            return ObjectKeyRef<TObj, TMeta>(std::move(spKeyRef));
+        }
+
+        ObjectKeyRef<TObj, TMeta> operator[](_In_ const std::wstring& keyName)
+        {
+            if (keyName.empty())
+            {
+                throw std::invalid_argument("Invalid keyName");
+            }
+            return operator[](keyName.c_str());
+        }
+
+        iterator begin()
+        {
+            ComPtr<IKeyEnumerator> spEnum;
+            CheckHr(m_obj->EnumerateKeyReferences(&spEnum));
+            return iterator(spEnum.Get());
+        }
+
+        // NamesOnly():
+        //
+        // Returns an iterable of just the key names.  Neither values nor metadata are fetched.
+        //
+        ObjectNamesRef<KeyNameEnumerator> NamesOnly()
+        {
+            ComPtr<IKeyEnumerator> spEnum;
+            CheckHr(m_obj->EnumerateKeys(&spEnum));
+            return ObjectNamesRef<KeyNameEnumerator>(std::move(spEnum));
+        }
+
+        iterator end()
+        {
+            return iterator();
+        }
+
+    private:
+
+        TObj m_obj;
+
+    };
+
+    // ObjectFieldRef:
+    //
+    // Represents a reference to a field as returned from Fields()[name] such that both value conversion
+    // and back assignment to the field can be supported.
+    //
+    template<typename TObj>
+    class ObjectFieldRef
+    {
+    public:
+
+        ObjectFieldRef() { }
+
+        ObjectFieldRef(_In_ TObj&& fieldRef) :
+            m_fieldRef(std::move(fieldRef))
+        {
+        }
+
+        operator TObj() const
+        {
+            return GetValue();
+        }
+
+        IModelObject *GetObject() const
+        {
+            return m_fieldRef;
+        }
+
+        template<typename T>
+        ObjectFieldRef& operator=(T&& val)
+        {
+            TObj boxedValue = BoxObject(std::forward<T>(val));
+            SetValue(boxedValue);
+            return *this;
+        }
+
+        TObj GetValue() const
+        {
+            CheckObject();
+            ComPtr<IModelObject> spDeref;
+            CheckHr(m_fieldRef->Dereference(&spDeref));
+            return TObj(std::move(spDeref));
+        }
+
+        // Conversions:
+        //
+        template<typename TType> TType As() const { return GetValue().As<TType>(); }
+        template<typename TType> explicit operator TType() const { return As<TType>(); }
+
+    private:
+
+        void CheckObject() const
+        {
+            if (m_fieldRef.GetObject() == nullptr)
+            {
+                throw ClientEx::unexpected_error();
+            }
+        }
+
+        void SetValue(_In_ const TObj& val) const
+        {
+            CheckObject();
+            ComPtr<IDebugHostEvaluator2> spEval2;
+            CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval2)));
+            ComPtr<IModelObject> spEvalResult;
+            HRESULT hr = spEval2->AssignTo(GetObject(), val, &spEvalResult, nullptr);
+            CheckHr(hr, spEvalResult);
+        }
+
+        TObj m_fieldRef;
+    };
+
+    // ObjectFieldsRef():
+    //
+    // Returned from Fields() to represent all native fields on an object.
+    //
+    template<typename TObj>
+    class ObjectFieldsRef
+    {
+    private:
+
+        // FieldIterator():
+        //
+        // A C++ input iterator for the fields within an object.
+        //
+        class FieldIterator
+        {
+        public:
+
+            using value = std::pair<std::wstring, ObjectFieldRef<TObj>>;
+
+            FieldIterator() : m_pos(0) { }
+
+            FieldIterator(_In_ IRawEnumerator *pRawEnum) : FieldIterator(pRawEnum, 0) { }
+
+            FieldIterator(_In_ IRawEnumerator *pRawEnum, _In_ size_t pos) :
+                m_spEnum(pRawEnum),
+                m_pos(pos)
+            {
+                MoveForward();
+            }
+
+            FieldIterator(_In_ const FieldIterator& rhs) :
+                m_spEnum(rhs.m_spEnum),
+                m_value(rhs.m_value),
+                m_pos(rhs.m_pos)
+            {
+            }
+
+            FieldIterator(_In_ FieldIterator&& rhs) :
+                m_spEnum(std::move(rhs.m_spEnum)),
+                m_value(std::move(rhs.m_value)),
+                m_pos(rhs.m_pos)
+            {
+                rhs.m_pos = 0;
+            }
+
+            FieldIterator& operator=(_In_ const FieldIterator& rhs)
+            {
+                m_spEnum = rhs.m_spEnum;
+                m_value = rhs.m_value;
+                m_pos = rhs.m_pos;
+                return *this;
+            }
+
+            FieldIterator& operator=(FieldIterator&& rhs)
+            {
+                m_spEnum = std::move(rhs.m_spEnum);
+                m_value = std::move(rhs.m_value);
+                m_pos = rhs.m_pos;
+                rhs.m_pos = 0;
+                return *this;
+            }
+
+            bool operator==(_In_ const FieldIterator& rhs) const
+            {
+                if (m_value.second.GetObject() == nullptr && rhs.m_value.second.GetObject() == nullptr)
+                {
+                    return true;
+                }
+                else if (m_value.second.GetObject() != nullptr && rhs.m_value.second.GetObject() != nullptr && m_pos == rhs.m_pos)
+                {
+                    return true;
+                }
+
+                return false;
+            }
+
+            bool operator!=(_In_ const FieldIterator& rhs) const
+            {
+                return !operator==(rhs);
+            }
+
+            const value& operator*() const
+            {
+                return m_value;
+            }
+
+            const value* operator->() const
+            {
+                return &m_value;
+            }
+
+            FieldIterator& operator++()
+            {
+                MoveForward();
+                return *this;
+            }
+
+            FieldIterator operator++(int)
+            {
+                FieldIterator cur = *this;
+                MoveForward();
+                return cur;
+            }
+
+        private:
+
+            void MoveForward()
+            {
+                BSTR fldName;
+                SymbolKind sk;
+                ComPtr<IModelObject> spValue;
+                HRESULT hr = Tracing::HostCall("GetNext", [&]() { return m_spEnum->GetNext(&fldName, &sk, &spValue); });
+                if (SUCCEEDED(hr))
+                {
+                    bstr_ptr fldPtr(fldName);
+                    ObjectFieldRef<TObj> fldRef(std::move(spValue));
+                    m_value = std::make_pair(std::wstring(fldName), std::move(fldRef));
+                    ++m_pos;
+                }
+                else if (hr != E_BOUNDS)
+                {
+                    CheckHr(hr);
+                }
+                else
+                {
+                    m_value = std::make_pair(std::wstring(), ObjectFieldRef<TObj>());
+                    m_pos = 0;
+                }
+            }
+
+            ComPtr<IRawEnumerator> m_spEnum;
+            value m_value;
+            size_t m_pos;
+
+        };
+
+    public:
+
+        using iterator = FieldIterator;
+
+        ObjectFieldsRef(_In_ const TObj& obj) :
+            m_obj(obj)
+        {
+        }
+
+        // operator[]:
+        //
+        // Returns a "reference" to a native field.
+        //
+        ObjectFieldRef<TObj> operator[](_In_z_ const wchar_t *fieldName)
+        {
+            ComPtr<IModelObject> spFieldRef;
+            HRESULT hr = m_obj->GetRawReference(SymbolField, fieldName, RawSearchNone, &spFieldRef);
+            CheckHr(hr, spFieldRef);
+            return ObjectFieldRef<TObj>(std::move(spFieldRef));
+        }
+
+        TObj operator[](_In_ const std::wstring& fieldName)
+        {
+            if (fieldName.empty())
+            {
+                throw std::invalid_argument("Invalid fieldName");
+            }
+            return operator[](fieldName.c_str());
+        }
+
+        iterator begin()
+        {
+            ComPtr<IRawEnumerator> spEnum;
+            CheckHr(m_obj->EnumerateRawReferences(SymbolField, RawSearchNone, &spEnum));
+            return iterator(spEnum.Get());
+        }
+
+        // NamesOnly():
+        //
+        // Returns an iterable of just the native field names.  No field values are fetched.
+        //
+        ObjectNamesRef<FieldNameEnumerator> NamesOnly()
+        {
+            ComPtr<IRawEnumerator> spEnum;
+            CheckHr(m_obj->EnumerateRawReferences(SymbolField, RawSearchNone, &spEnum));
+            return ObjectNamesRef<FieldNameEnumerator>(std::move(spEnum));
+        }
+
+        iterator end()
+        {
+            return iterator();
+        }
+
+    private:
+
+        TObj m_obj;
+
+    };
+
+    // DereferenceReference:
+    //
+    // A class which represents a reference type returned from the Dereference call.  This allows both
+    // value conversion and back assignment to a dereference.
+    //
+    template<typename TObj>
+    class DereferenceReference
+    {
+    public:
+
+        DereferenceReference(_In_ const TObj& obj) : m_obj(obj) { }
+        DereferenceReference(_In_ const DereferenceReference& src) : m_obj(src.m_obj) { }
+        DereferenceReference(_In_ DereferenceReference&& src) : m_obj(std::move(src.m_obj)) { }
+
+        operator TObj() const
+        {
+            return GetValue();
+        }
+
+        TObj GetValue() const
+        {
+            ComPtr<IModelObject> spDeref;
+            CheckHr(m_obj->Dereference(&spDeref));
+            return TObj(std::move(spDeref));
+        }
+
+        // operator=
+        //
+        // Perform assignment to another value.
+        //
+        template<typename T>
+        void operator=(T&& assignmentValue)
+        {
+            TObj assignment = BoxObject(std::forward<T>(assignmentValue));
+            SetValue(assignment);
+        }
+
+        template<typename TType> TType As() const { return GetValue().As<TType>(); }
+        template<typename TType> explicit operator TType() const { return GetValue().As<TType>(); }
+
+    private:
+
+        void CheckObject() const
+        {
+            if (m_obj.GetObject() == nullptr)
+            {
+                throw ClientEx::unexpected_error();
+            }
+        }
+
+        void SetValue(_In_ const TObj& val) const
+        {
+            CheckObject();
+
+            ComPtr<IDebugHostContext> spCtx;
+            ComPtr<IModelObject> spObj;
+            CheckHr(m_obj->GetContext(&spCtx));
+
+            TObj assignmentRef;
+
+            //
+            // How we "assign this" depends on what it is.  We need to convert the dereference to
+            // an actual "reference" and pass that back to the evaluator to deal with as it sees fit.
+            //
+            ModelObjectKind mkObject = m_obj.GetKind();
+            if (mkObject == ObjectIntrinsic)
+            {
+                //
+                // If it's a pointer, get a reference to what's underneath.
+                //
+                Type ty = m_obj.Type();
+                if (ty != nullptr && ty.GetKind() == TypePointer)
+                {
+                    ULONG64 addr = (ULONG64)m_obj;
+                    Type baseType = ty.BaseType();
+                    CheckHr(GetManager()->CreateTypedObjectReference(spCtx.Get(), addr, baseType, &spObj));
+                    assignmentRef = std::move(spObj);
+                }
+            }
+            else if (mkObject == ObjectTargetObjectReference)
+            {
+                assignmentRef = m_obj;
+            }
+
+            if (assignmentRef == nullptr)
+            {
+                TObj underlyingValue = GetValue();
+                ModelObjectKind mkUnderlyingValue = underlyingValue.GetKind();
+                switch(mkUnderlyingValue)
+                {
+                    case ObjectTargetObjectReference:
+                    {
+                        //
+                        // Probably not.  But this is easy.
+                        //
+                        assignmentRef = underlyingValue;
+                        break;
+                    }
+
+                    case ObjectTargetObject:
+                    {
+                        Location loc;
+                        ComPtr<IDebugHostType> spType;
+                        CheckHr(m_obj->GetTargetInfo(&loc, &spType));
+
+                        CheckHr(GetManager()->CreateTypedObjectReference(spCtx.Get(), loc, spType.Get(), &spObj));
+                        assignmentRef = std::move(spObj);
+                        break;
+                    }
+
+                    default:
+                        throw not_implemented();
+                }
+            }
+
+            ComPtr<IDebugHostEvaluator2> spEval2;
+            CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval2)));
+            ComPtr<IModelObject> spEvalResult;
+            HRESULT hr = spEval2->AssignTo(assignmentRef, val, &spEvalResult, nullptr);
+            CheckHr(hr, spEvalResult);
+        }
+
+        TObj m_obj;
+
+    };
+
+    // 0x11ac8461, 0x7ff4, 0x4f9f, 0x85, 0xe3, 0x3b, 0x82, 0x1e, 0xeb, 0xed, 0x33);
+    struct DECLSPEC_UUID("11AC8461-7FF4-4F9F-85E3-3B821EEBED33") ISeekableModelIterator : public IUnknown
+    {
+        // Skip():
+        //
+        // Moves the iterator forward by up to 'count' elements without producing them.  On success, *pSkipped
+        // indicates how many elements were skipped.  Fewer than 'count' means that the iterator is exhausted.
+        //
+        IFACEMETHOD(Skip)(_In_ ULONG64 count, _Out_ ULONG64 *pSkipped) PURE;
+    };
+
+    // IsDenseArray():
+    //
+    // Determines whether an object is known to be indexable by the position of its elements in iteration order.  Only
+    // one dimensional, zero based native arrays are assumed to be: their elements are dense and their length is known.
+    // Other indexables may be keyed (e.g.: by a process or thread id) or sparse.  Iterators produced by this library
+    // are instead positioned through ISeekableModelIterator.  On success, the indexable concept and the length of the
+    // array are returned.
+    //
+    inline bool IsDenseArray(_In_ IModelObject *pObject,
+                             _COM_Outptr_result_maybenull_ IIndexableConcept **ppIndexable,
+                             _Out_ ULONG64 *pLength)
+    {
+        *ppIndexable = nullptr;
+        *pLength = 0;
+
+        ModelObjectKind mk;
+        ComPtr<IDebugHostType> spType;
+        if (FAILED(pObject->GetKind(&mk)) || mk != ObjectTargetObject ||
+            FAILED(pObject->GetTypeInfo(&spType)) || spType == nullptr)
+        {
+            return false;
+        }
+
+        Type type(std::move(spType));
+        if (type.GetKind() == TypeTypedef)
+        {
+            type = type.TypedefFinalBaseType();
+        }
+
+        ULONG64 dimensionality;
+        ArrayDimension dimension;
+        if (type.GetKind() != TypeArray ||
+            FAILED(type->GetArrayDimensionality(&dimensionality)) || dimensionality != 1 ||
+            FAILED(type->GetArrayDimensions(1, &dimension)) || dimension.LowerBound != 0)
+        {
+            return false;
+        }
+
+        ComPtr<IIndexableConcept> spIndexable;
+        if (FAILED(pObject->GetConcept(__uuidof(IIndexableConcept), &spIndexable, nullptr)))
+        {
+            return false;
+        }
+
+        *ppIndexable = spIndexable.Detach();
+        *pLength = dimension.Length;
+        return true;
+    }
+
+    // ObjectIterator:
+    //
+    // A C++ forward iterator over an object.
+    //
+    template<typename TObj>
+    class ObjectIterator
+    {
+    public:
+
+        using value = TObj;
+
+        ObjectIterator() : m_length(0), m_pos(0) { }
+        ObjectIterator(_In_ const TObj& obj, _In_ IModelIterator *pIterator) : ObjectIterator(obj, pIterator, 0) { }
+
+        ObjectIterator(_In_ const TObj& obj, _In_ IModelIterator *pIterator, _In_ size_t pos) :
+            m_obj(obj),
+            m_spIterator(pIterator),
+            m_length(0),
+            m_pos(pos)
+        {
+            MoveForward();
+        }
+
+        ObjectIterator(_In_ const ObjectIterator& rhs) :
+            m_obj(rhs.m_obj),
+            m_value(rhs.m_value),
+            m_spIterator(rhs.m_spIterator),
+            m_spIndexable(rhs.m_spIndexable),
+            m_length(rhs.m_length),
+            m_pos(rhs.m_pos)
+        {
+        }
+
+        ObjectIterator(_In_ ObjectIterator&& rhs) :
+            m_obj(std::move(rhs.m_obj)),
+            m_value(std::move(rhs.m_value)),
+            m_spIterator(std::move(rhs.m_spIterator)),
+            m_spIndexable(std::move(rhs.m_spIndexable)),
+            m_length(rhs.m_length),
+            m_pos(rhs.m_pos)
+        {
+            rhs.m_pos = 0;
+        }
+
+        ObjectIterator& operator=(_In_ const ObjectIterator& rhs)
+        {
+            m_obj = rhs.m_obj;
+            m_spIterator = rhs.m_spIterator;
+            m_spIndexable = rhs.m_spIndexable;
+            m_length = rhs.m_length;
+            m_value = rhs.m_value;
+            m_pos = rhs.m_pos;
+            return *this;
+        }
+
+        ObjectIterator& operator=(_In_ ObjectIterator&& rhs)
+        {
+            m_obj = std::move(rhs.m_obj);
+            m_spIterator = std::move(rhs.m_spIterator);
+            m_spIndexable = std::move(rhs.m_spIndexable);
+            m_length = rhs.m_length;
+            m_value = std::move(rhs.m_value);
+            m_pos = rhs.m_pos;
+            rhs.m_pos = 0;
+            return *this;
+        }
+
+        // operator*():
+        //
+        // Returns the current value by reference.  Binding the result to a const reference (e.g.: for (const
+        // Object& value : obj)) does not reference the value again; only copying it out of the iterator does.
+        //
+        const value& operator*() const
+        {
+            return m_value;
+        }
+
+        const value* operator->() const
+        {
+            return &m_value;
+        }
+
+        value* operator->()
+        {
+            return &m_value;
+        }
+
+        bool operator==(_In_ const ObjectIterator& rhs) const
+        {
+            if (m_value.GetObject() == nullptr && rhs.m_value.GetObject() == nullptr)
+            {
+                return true;
+            }
+            else if (m_value.GetObject() != nullptr && rhs.m_value.GetObject() != nullptr &&
+                     m_pos == rhs.m_pos)
+            {
+                return true;
+            }
+            return false;
+        }
+
+        bool operator!=(_In_ const ObjectIterator& rhs) const
+        {
+            return !operator==(rhs);
+        }
+
+        ObjectIterator& operator++()
+        {
+            ++m_pos;
+            MoveForward();
+            return *this;
+        }
+
+        ObjectIterator operator++(int)
+        {
+            ObjectIterator cur = *this;
+            ++m_pos;
+            MoveForward();
+            return cur;
+        }
+
+        // Advance():
+        //
+        // Moves the iterator forward by n elements.  If the underlying iterator is one of our own (BoundIterator),
+        // the skipped elements are never produced and, for a random access iterator, this takes constant time.  If
+        // the object is a native array (see IsDenseArray), the iterator moves to the new position through the indexer
+        // and continues from there by index.  Otherwise, the skipped elements are fetched and discarded.
+        //
+        ObjectIterator& Advance(_In_ ULONG64 n)
+        {
+            if (n == 0 || m_value.GetObject() == nullptr)
+            {
+                return *this;
+            }
+
+            if (m_spIndexable == nullptr)
+            {
+                ComPtr<ISeekableModelIterator> spSeekable;
+                if (SUCCEEDED(m_spIterator.As(&spSeekable)))
+                {
+                    //
+                    // The underlying iterator is already past the current element.
+                    //
+                    ULONG64 skipped;
+                    CheckHr(spSeekable->Skip(n - 1, &skipped));
+                    if (skipped < n - 1)
+                    {
+                        SetEnd();
+                        return *this;
+                    }
+                    m_pos += static_cast<size_t>(n);
+                    MoveForward();
+                    return *this;
+                }
+
+                ComPtr<IIndexableConcept> spIndexable;
+                if (!IsDenseArray(m_obj, &spIndexable, &m_length))
+                {
+                    for (ULONG64 i = 0; i < n && m_value.GetObject() != nullptr; ++i)
+                    {
+                        operator++();
+                    }
+                    return *this;
+                }
+
+                m_spIndexable = std::move(spIndexable);
+                m_spIterator = nullptr;
+            }
+
+            m_pos += static_cast<size_t>(n);
+            MoveForward();
+            return *this;
+        }
+
+    private:
+
+        void MoveForward()
+        {
+            ComPtr<IModelObject> spValue;
+            HRESULT hr;
+            if (m_spIndexable != nullptr)
+            {
+                //
+                // The length of the array is known.  The indexer is never asked for an element past its end.
+                //
+                if (static_cast<ULONG64>(m_pos) >= m_length)
+                {
+                    SetEnd();
+                    return;
+                }
+                hr = GetAtPosition(&spValue);
+                CheckHr(hr);
+            }
+            else
+            {
+                hr = Tracing::HostCall("GetNext", [&]() { return m_spIterator->GetNext(&spValue, 0, nullptr, nullptr); });
+            }
+
+            if (SUCCEEDED(hr))
+            {
+                m_value = TObj(std::move(spValue));
+            }
+            else if (hr != E_BOUNDS)
+            {
+                CheckHr(hr);
+            }
+            else
+            {
+                SetEnd();
+            }
+        }
+
+        // GetAtPosition():
+        //
+        // Fetches the element at the current position through the indexer.
+        //
+        HRESULT GetAtPosition(_COM_Outptr_ IModelObject **ppValue)
+        {
+            VARIANT vtIndex;
+            vtIndex.vt = VT_UI8;
+            vtIndex.ullVal = static_cast<ULONG64>(m_pos);
+
+            ComPtr<IModelObject> spIndex;
+            CheckHr(GetManager()->CreateIntrinsicObject(ObjectIntrinsic, &vtIndex, &spIndex));
+
+            IModelObject *pIndex = spIndex.Get();
+            return Tracing::HostCall("GetAt", [&]() { return m_spIndexable->GetAt(m_obj, 1, &pIndex, ppValue, nullptr); });
+        }
+
+        void SetEnd()
+        {
+            m_value = TObj();
+            m_pos = 0;
+        }
+
+        TObj m_obj;
+        TObj m_value;
+        ComPtr<IModelIterator> m_spIterator;
+        ComPtr<IIndexableConcept> m_spIndexable;
+        ULONG64 m_length;
+        size_t m_pos;
+    };
+
+    // 0x6c1f3b2a, 0x94d7, 0x4e0b, 0xa1, 0x58, 0x3e, 0x7d, 0x02, 0xc9, 0x4b, 0x16);
+    struct DECLSPEC_UUID("6C1F3B2A-94D7-4E0B-A158-3E7D02C94B16") IBatchedModelIterator : public IUnknown
+    {
+        // GetNextBatch():
+        //
+        // Fetches up to 'count' values from the iterator.  On success, *pFetched indicates how many of ppObjects
+        // were filled.  E_BOUNDS is returned when the iterator is exhausted and nothing was fetched.  No indexers
+        // or metadata are returned through this path.
+        //
+        IFACEMETHOD(GetNextBatch)(_In_ ULONG64 count,
+                                  _Out_writes_to_(count, *pFetched) IModelObject **ppObjects,
+                                  _Out_ ULONG64 *pFetched) PURE;
+    };
+
+    // ObjectBatchIterator:
+    //
+    // An input iterator which returns runs of up to a given number of values from an underlying model iterator.
+    // The vector returned from operator* is reused from batch to batch.  If the underlying iterator is one of
+    // our own (BoundIterator), the batch is fetched in a single call via IBatchedModelIterator; otherwise, this
+    // falls back to IModelIterator::GetNext per element.
+    //
+    template<typename TObj>
+    class ObjectBatchIterator
+    {
+    public:
+
+        using value = std::vector<TObj>;
+
+        ObjectBatchIterator() : m_batchSize(0), m_pos(0) { }
+
+        ObjectBatchIterator(_In_ IModelIterator *pIterator, _In_ size_t batchSize) :
+            m_spIterator(pIterator),
+            m_batchSize(batchSize),
+            m_pos(0)
+        {
+            if (m_batchSize == 0)
+            {
+                throw std::invalid_argument("Batch size must be non-zero");
+            }
+
+            (void)m_spIterator.As(&m_spBatchIterator);
+            m_batch.reserve(m_batchSize);
+            MoveForward();
+        }
+
+        ObjectBatchIterator(_In_ const ObjectBatchIterator& rhs) = default;
+        ObjectBatchIterator(_In_ ObjectBatchIterator&& rhs) = default;
+        ObjectBatchIterator& operator=(_In_ const ObjectBatchIterator& rhs) = default;
+        ObjectBatchIterator& operator=(_In_ ObjectBatchIterator&& rhs) = default;
+
+        const value& operator*() const
+        {
+            return m_batch;
+        }
+
+        const value* operator->() const
+        {
+            return &m_batch;
+        }
+
+        bool operator==(_In_ const ObjectBatchIterator& rhs) const
+        {
+            if (m_batch.empty() || rhs.m_batch.empty())
+            {
+                return m_batch.empty() && rhs.m_batch.empty();
+            }
+            return m_pos == rhs.m_pos;
+        }
+
+        bool operator!=(_In_ const ObjectBatchIterator& rhs) const
+        {
+            return !operator==(rhs);
+        }
+
+        ObjectBatchIterator& operator++()
+        {
+            MoveForward();
+            return *this;
+        }
+
+    private:
+
+        void MoveForward()
+        {
+            m_batch.clear();
+
+            if (m_spBatchIterator != nullptr)
+            {
+                //
+                // TObj is a thin wrapper around a single ComPtr<IModelObject>.  Fill the vector directly.
+                //
+                m_batch.resize(m_batchSize);
+                ULONG64 fetched = 0;
+                HRESULT hr = Tracing::HostCall("GetNextBatch", [&]() { return m_spBatchIterator->GetNextBatch(m_batchSize, reinterpret_cast<IModelObject **>(m_batch.data()), &fetched); });
+                if (hr == E_BOUNDS)
+                {
+                    fetched = 0;
+                }
+                else
+                {
+                    CheckHr(hr);
+                }
+                m_batch.resize(static_cast<size_t>(fetched));
+            }
+            else
+            {
+                while (m_batch.size() < m_batchSize)
+                {
+                    ComPtr<IModelObject> spValue;
+                    HRESULT hr = Tracing::HostCall("GetNext", [&]() { return m_spIterator->GetNext(&spValue, 0, nullptr, nullptr); });
+                    if (hr == E_BOUNDS)
+                    {
+                        break;
+                    }
+                    CheckHr(hr);
+                    m_batch.push_back(TObj(std::move(spValue)));
+                }
+            }
+
+            m_pos += m_batch.size();
+        }
+
+        ComPtr<IModelIterator> m_spIterator;
+        ComPtr<IBatchedModelIterator> m_spBatchIterator;
+        size_t m_batchSize;
+        size_t m_pos;
+        value m_batch;
+    };
+
+    // ObjectBatchesRef():
+    //
+    // The object returned from IterateBatched() to reference the batched iteration of an object.
+    //
+    template<typename TObj>
+    class ObjectBatchesRef
+    {
+    public:
+
+        using iterator = ObjectBatchIterator<TObj>;
+
+        ObjectBatchesRef(_In_ const TObj& obj, _In_ size_t batchSize) :
+            m_obj(obj),
+            m_batchSize(batchSize)
+        {
+        }
+
+        iterator begin()
+        {
+            ComPtr<IIterableConcept> spIterable;
+            CheckHr(m_obj->GetConcept(__uuidof(IIterableConcept), &spIterable, nullptr));
+            ComPtr<IModelIterator> spIterator;
+            CheckHr(spIterable->GetIterator(m_obj, &spIterator));
+            return iterator(spIterator.Get(), m_batchSize);
+        }
+
+        iterator end()
+        {
+            return iterator();
+        }
+
+    private:
+
+        TObj m_obj;
+        size_t m_batchSize;
+    };
+
+    //*************************************************
+    // String Extraction:
+    //
+
+    template<typename TArg> struct StringExtractorHelper;
+
+    template<>
+    struct StringExtractorHelper<wchar_t *>
+    {
+        static _Ret_z_ const wchar_t *GetString(_In_z_ const wchar_t *pc) { return pc; }
+    };
+
+    template<>
+    struct StringExtractorHelper<const wchar_t *>
+    {
+        static _Ret_z_ const wchar_t *GetString(_In_z_ const wchar_t *pc) { return pc; }
+    };
+
+    template<>
+    struct StringExtractorHelper<std::wstring>
+    {
+        static _Ret_z_ const wchar_t *GetString(_In_ const std::wstring &str) { return str.c_str(); }
+    };
+
+    // ExtractString():
+    //
+    // Extracts a const wchar_t * from the incoming argument.  This allows generic passing of anything we
+    // can pull a string from (e.g.: wchar_t *, std::wstring).
+    //
+    template<typename TArg>
+    _Ret_z_ const wchar_t *ExtractString(TArg&& str)
+    {
+        return StringExtractorHelper<std::decay_t<TArg>>::GetString(std::forward<TArg>(str));
+    }
+
+    //*************************************************
+    // Key Filling:
+    //
+
+    template<typename TBase, typename... TArgs> struct KeyFiller;
+
+    template<typename TBase>
+    struct KeyFiller<TBase>
+    {
+        static void Fill(_In_ TBase * /*pBase*/)
+        {
+        }
+    };
+
+    // KeyFiller::Fill():
+    //
+    // Fills an IModelObject or IKeyStore with a set of keys/values provided by the variable
+    // argument pack.
+    //
+    // Each argument set in the pack must be: (stringExtractable, value)
+    //
+    //     where stringExtractable is the name and can be any type supported by ExtractString()
+    //       and value is the value of that key
+    //
+    template<typename TBase, typename TStr, typename TArg, typename... TArgs>
+    struct KeyFiller<TBase, TStr, TArg, TArgs...>
+    {
+        static void Fill(_In_ TBase *pBase, _In_ TStr&& keyName, _In_ TArg&& value, _In_ TArgs&&... remainingInitializers)
+        {
+            const wchar_t *pStr = ExtractString(keyName);
+            Object obj = BoxObject(std::forward<TArg>(value));
+            CheckHr(pBase->SetKey(pStr, obj, nullptr));
+            KeyFiller<TBase, TArgs...>::Fill(pBase, std::forward<TArgs>(remainingInitializers)...);
+        }
+    };
+
+    template<typename TBase, typename TStr, typename TArg, typename... TArgs>
+    struct KeyFiller<TBase, TStr, TArg, Metadata, TArgs...>
+
+    {
+        static void Fill(_In_ TBase *pBase, _In_ TStr&& keyName, _In_ TArg&& value, _In_ Metadata&& metadata,
+                         _In_ TArgs&&... remainingInitializers)
+        {
+            const wchar_t *pStr = ExtractString(keyName);
+            Object obj = BoxObject(std::forward<TArg>(value));
+            CheckHr(pBase->SetKey(pStr, obj, metadata));
+            KeyFiller<TBase, TArgs...>::Fill(pBase, std::forward<TArgs>(remainingInitializers)...);
+        }
+    };
+
+
+    //*************************************************
+    // C++ operator support on objects
+    //
+
+    template<typename TObj>
+    struct ObjectOperators
+    {
+        static TObj Increment(_In_ const TObj& src) { return Adjust(src, 1); }
+        static TObj IncrementBy(_In_ const TObj& src, LONG64 increment) { return Adjust(src, increment); }
+        static TObj Decrement(_In_ const TObj& src) { return Adjust(src, -1); }
+        static TObj DecrementBy(_In_ const TObj& src, LONG64 decrement) { return Adjust(src, decrement); }
+
+    private:
+
+        static TObj Adjust(_In_ const TObj& src, _In_ LONG64 adjustment)
+        {
+            ModelObjectKind mk = src.GetKind();
+            switch(mk)
+            {
+                case ObjectIntrinsic:
+                {
+                    Type ty = src.Type();
+                    if (ty != nullptr)
+                    {
+                        TypeKind tk = ty.GetKind();
+                        if (tk == TypePointer)
+                        {
+                            HostContext ctx = src;
+
+                            ULONG64 ptrVal = (ULONG64)src;
+                            return TObj::CreatePointer(ctx, ty, adjustment * ty.BaseType().Size() + ptrVal);
+                        }
+                    }
+                    break;
+                }
+            }
+
+            throw not_implemented();
+        }
+    };
+
+    //*************************************************
+    // Universal reference constructor overloading:
+    //
+
+    template<typename... TArgs> struct VarTraits
+    {
+        using FirstType = void;
+    };
+    template<typename TArg> struct VarTraits<TArg>
+    {
+        using FirstType = TArg;
+    };
+    template<typename TArg, typename... TArgs> struct VarTraits<TArg, TArgs...>
+    {
+        using FirstType = TArg;
+    };
+
+    // IsCopyMove:
+    //
+    // Support for keeping a copy/move constructor and a universal reference constructor.
+    //
+    // Usage: (For a constructor which takes a universal reference TArg&&)
+    //
+    // template<typename TArg,
+    //          typename = std::enable_if_t<!Details::IsCopyMove_v<Object, TArg>>
+    //
+    template<typename T, typename... TArgs> struct IsCopyMove :
+        public std::bool_constant<sizeof...(TArgs) == 1 && std::is_same_v<T, std::decay_t<typename VarTraits<TArgs...>::FirstType>>> { };
+    template<typename T, typename... TArgs> constexpr bool IsCopyMove_v = IsCopyMove<T, TArgs...>::value;
+
+    // IsObjectView:
+    //
+    // Detects a borrowed view of an object.  A view converts to the object which it borrows rather than being
+    // treated as an arbitrary value by the universal reference constructor and assignment of Object.
+    //
+    template<typename T> struct IsObjectView : public std::is_same<std::decay_t<T>, ObjectView> { };
+    template<typename T> constexpr bool IsObjectView_v = IsObjectView<T>::value;
+
+    //*************************************************
+    // Other Detections:
+
+    // IsSingleType:
+    //
+    // Support for detecting whether an argument pack is a single argument of a given type.
+    //
+    template<typename TType, typename... TArgs>
+    struct IsSingleType : public std::false_type { };
+
+    template<typename TType, typename TArg>
+    struct IsSingleType<TType, TArg> : public std::is_same<TArg, std::decay_t<TType>> { };
+
+    template<typename TType, typename... TArgs> constexpr bool IsSingleType_v = IsSingleType<TType, TArgs...>::value;
+
+    //*************************************************
+    // ArgumentPacker:
+    //
+    // Recursive template unwind which takes a set of arbitrarily typed objects, boxes them into
+    // model objects, and returns a pack of Objects.  Packs of up to InlineParameterPackLimit objects
+    // are stored inline (InlineParameterPack); larger ones are a unique_ptr of Objects.
+    //
+    using ParameterPack = std::unique_ptr<Object[]>;
+
+    // InlineParameterPack:
+    //
+    // A pack of N objects stored inline rather than on the heap.  As with ParameterPack, get() returns the
+    // objects laid out such that they can be passed to the data model as an array of IModelObject *.
+    //
+    template<size_t N>
+    class InlineParameterPack
+    {
+    public:
+
+        //
+        // Constness is shallow as it is for a ParameterPack: a const pack still yields the objects for passing
+        // as an IModelObject ** argument array.
+        //
+        Object *get() const { return const_cast<Object *>(m_objects); }
+        Object& operator[](_In_ size_t i) { return m_objects[i]; }
+        const Object& operator[](_In_ size_t i) const { return m_objects[i]; }
+
+    private:
+
+        Object m_objects[N > 0 ? N : 1];
+    };
+
+    template<size_t N>
+    using PackStorage_t = std::conditional_t<(N <= InlineParameterPackLimit), InlineParameterPack<N>, ParameterPack>;
+
+    template<size_t i, typename... TArgs>
+    struct Packer;
+
+    template<size_t i>
+    struct Packer<i>
+    {
+        template<typename TPack>
+        static void PackInto(TPack& /*pack*/)
+        {
+        }
+    };
+
+    template<size_t i, typename TArg, typename... TArgs>
+    struct Packer<i, TArg, TArgs...>
+    {
+        template<typename TPack>
+        static void PackInto(TPack& pack, TArg&& firstArg, TArgs&&... subsequentArgs)
+        {
+            pack[i] = BoxObject(std::forward<TArg>(firstArg));
+            return Packer<i + 1, TArgs...>::PackInto(pack, std::forward<TArgs>(subsequentArgs)...);
+        }
+    };
+
+    template<typename T, typename... TArgs>
+    ParameterPack PackValuesHelper(TArgs&&... args)
+    {
+        size_t packSize = sizeof...(args);
+        ParameterPack argPack(new T[packSize]);
+        Packer<0, TArgs...>::PackInto(argPack, std::forward<TArgs>(args)...);
+        return argPack;
+    }
+
+    // PackValues():
+    //
+    // Packs a set of arguments into an array of objects and returns it.  Small packs do not allocate.
+    //
+    template<typename... TArgs>
+    PackStorage_t<sizeof...(TArgs)> PackValues(TArgs&&... args)
+    {
+        if constexpr(sizeof...(TArgs) <= InlineParameterPackLimit)
+        {
+            InlineParameterPack<sizeof...(TArgs)> argPack;
+            Packer<0, TArgs...>::PackInto(argPack, std::forward<TArgs>(args)...);
+            return argPack;
+        }
+        else
+        {
+            return PackValuesHelper<Object>(std::forward<TArgs>(args)...);
+        }
+    }
+
+    template<size_t i, size_t count, typename TTuple>
+    struct TuplePacker
+    {
+        template<typename TPack>
+        static void PackInto(TPack& pack, const TTuple& tuple)
+        {
+            pack[i] = BoxObject(std::get<i>(tuple));
+            return TuplePacker<i + 1, count, TTuple>::PackInto(pack, tuple);
+        }
+    };
+
+    template<size_t i, typename TTuple>
+    struct TuplePacker<i, i, TTuple>
+    {
+        template<typename TPack>
+        static void PackInto(TPack& /*pack*/, const TTuple& /*tuple*/)
+        {
+        }
+    };
+
+    // PackTuple():
+    //
+    // Packs a tuple of arguments into an array of objects and returns it.  Small packs do not allocate.
+    //
+    template<typename TTuple>
+    PackStorage_t<std::tuple_size_v<TTuple>> PackTuple(const TTuple& tuple)
+    {
+        constexpr size_t packSize = std::tuple_size_v<TTuple>;
+        PackStorage_t<packSize> argPack;
+        if constexpr(packSize > InlineParameterPackLimit)
+        {
+            argPack.reset(new Object[packSize]);
+        }
+        TuplePacker<0, packSize, TTuple>::PackInto(argPack, tuple);
+        return argPack;
+    }
+
+    // 0x5b8e2f17, 0x3c6a, 0x4d91, 0xa2, 0x4e, 0x8f, 0x13, 0x6b, 0xc0, 0x5d, 0x72);
+    struct DECLSPEC_UUID("5B8E2F17-3C6A-4D91-A24E-8F136BC05D72") IDeconstructionArgumentSink : public IUnknown
+    {
+        // SetArgumentCount():
+        //
+        // Indicates the number of constructor arguments which will follow.  This is called once, before any argument.
+        //
+        IFACEMETHOD(SetArgumentCount)(_In_ ULONG64 argCount) PURE;
+
+        // SetArgument():
+        //
+        // Passes a single constructor argument.  Arguments are passed in order.  The sink must reference the argument
+        // if it keeps it past the call.
+        //
+        IFACEMETHOD(SetArgument)(_In_ ULONG64 index, _In_ IModelObject *pArgument) PURE;
+    };
+
+    // 0x9d04c6e3, 0x71b8, 0x4a2f, 0xb5, 0x69, 0x0e, 0x4c, 0x83, 0xd2, 0x1a, 0xf6);
+    struct DECLSPEC_UUID("9D04C6E3-71B8-4A2F-B569-0E4C83D21AF6") IStreamingDeconstructableConcept : public IUnknown
+    {
+        // GetConstructorArgumentsInto():
+        //
+        // Produces the constructor arguments of the object one at a time into the sink.  Each argument is released
+        // before the next one is created.
+        //
+        IFACEMETHOD(GetConstructorArgumentsInto)(_In_ IModelObject *pContextObject, _In_ IDeconstructionArgumentSink *pSink) PURE;
+    };
+
+    template<size_t i, size_t count, typename TTuple>
+    struct TupleSinker
+    {
+        static void SinkInto(_In_ IDeconstructionArgumentSink *pSink, const TTuple& tuple)
+        {
+            {
+                Object argument = BoxObject(std::get<i>(tuple));
+                CheckHr(pSink->SetArgument(i, argument));
+            }
+            return TupleSinker<i + 1, count, TTuple>::SinkInto(pSink, tuple);
+        }
+    };
+
+    template<size_t i, typename TTuple>
+    struct TupleSinker<i, i, TTuple>
+    {
+        static void SinkInto(_In_ IDeconstructionArgumentSink * /*pSink*/, const TTuple& /*tuple*/)
+        {
+        }
+    };
+
+    // SinkTuple():
+    //
+    // Boxes each element of a tuple of arguments in turn and passes it to the sink.  Unlike PackTuple, only one
+    // boxed argument is alive at a time.
+    //
+    template<typename TTuple>
+    void SinkTuple(_In_ IDeconstructionArgumentSink *pSink, const TTuple& tuple)
+    {
+        constexpr size_t argCount = std::tuple_size_v<TTuple>;
+        CheckHr(pSink->SetArgumentCount(argCount));
+        TupleSinker<0, argCount, TTuple>::SinkInto(pSink, tuple);
+    }
+
+} // Details
+
+//**************************************************************************
+// Basic Wrappers:
+//
+
+// TypeSignature:
+//
+// Represents a type signature.
+//
+class TypeSignature
+{
+public:
+
+    TypeSignature() { }
+    TypeSignature(_In_ IDebugHostTypeSignature *pTypeSignature) : m_spTypeSignature(pTypeSignature) { }
+    TypeSignature(_In_ const ComPtr<IDebugHostTypeSignature> &spTypeSignature) : m_spTypeSignature(spTypeSignature) { }
+    TypeSignature(_In_ ComPtr<IDebugHostTypeSignature>&& spTypeSignature) : m_spTypeSignature(std::move(spTypeSignature)) { }
+    TypeSignature(_In_ const TypeSignature& src) : m_spTypeSignature(src.m_spTypeSignature) { }
+    TypeSignature(_In_ TypeSignature&& src) : m_spTypeSignature(std::move(src.m_spTypeSignature)) { }
+
+    TypeSignature& operator=(_In_ const TypeSignature& src) { m_spTypeSignature = src.m_spTypeSignature; return *this; }
+    TypeSignature& operator=(_In_ TypeSignature&& src) { m_spTypeSignature = std::move(src.m_spTypeSignature); return *this; }
+
+    // TypeSignature(signature)
+    //
+    // Creates a type signature for a type whose name matches the supplied string signature.  This matches regardless
+    // of module / version.
+    //
+    TypeSignature(_In_z_ const wchar_t *signature)
+    {
+        ComPtr<IDebugHostSymbols> spHostSym;
+        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+        ClientEx::CheckHr(spHostSym->CreateTypeSignature(signature, nullptr, &m_spTypeSignature));
+    }
+
+    TypeSignature(_In_ std::wstring& signature)
+    {
+        ComPtr<IDebugHostSymbols> spHostSym;
+        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+        ClientEx::CheckHr(spHostSym->CreateTypeSignature(signature.c_str(), nullptr, &m_spTypeSignature));
+    }
+
+    // TypeSignature(signature, module)
+    //
+    // Creates a type signature for a type whose name matches the supplied string signature within the given module.
+    //
+    template<typename TStr>
+    TypeSignature(_In_ TStr&& signature, _In_ const Module& module)
+    {
+        const wchar_t *pSignature = Details::ExtractString(signature);
+        ComPtr<IDebugHostSymbols> spHostSym;
+        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+        ClientEx::CheckHr(spHostSym->CreateTypeSignature(pSignature, module, &m_spTypeSignature));
+    }
+
+    // TypeSignature(signature, moduleName)
+    //
+    // Creates a type signature for a type whose name and module name matches the supplied string signatures.
+    //
+    template<typename TStr1, typename TStr2,
+             typename = std::enable_if_t<!std::is_same_v<typename std::decay_t<TStr2>, Module>>>
+    TypeSignature(_In_ TStr1&& signature, _In_ TStr2&& moduleName)
+    {
+        const wchar_t *pSignature = Details::ExtractString(signature);
+        const wchar_t *pModuleName = Details::ExtractString(moduleName);
+        ComPtr<IDebugHostSymbols> spHostSym;
+        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+        ClientEx::CheckHr(spHostSym->CreateTypeSignatureForModuleRange(pSignature,
+                                                                                pModuleName,
+                                                                                nullptr,
+                                                                                nullptr,
+                                                                                &m_spTypeSignature));
+    }
+
+    // TypeSignature(signature, moduleName, minVersion)
+    //
+    // Creates a type signature for a type whose name and module name match the supplied signatures.  The module must
+    // be at least the specified version.
+    //
+    template<typename TStr1, typename TStr2, typename TStr3>
+    TypeSignature(_In_ TStr1&& signature, _In_ TStr2&& moduleName, _In_ TStr3&& minVersion)
+    {
+        const wchar_t *pSignature = Details::ExtractString(signature);
+        const wchar_t *pModuleName = Details::ExtractString(moduleName);
+        const wchar_t *pMinVersion = Details::ExtractString(minVersion);
+        ComPtr<IDebugHostSymbols> spHostSym;
+        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+        ClientEx::CheckHr(spHostSym->CreateTypeSignatureForModuleRange(pSignature,
+                                                                                pModuleName,
+                                                                                pMinVersion,
+                                                                                nullptr,
+                                                                                &m_spTypeSignature));
+    }
+
+    // TypeSignature(signature, moduleName, minVersion, maxVersion)
+    //
+    // Creates a type signature for a type whose name and module name match the supplied signatures.  The module must
+    // be at least the specified min version and no more than the max version.
+    //
+    template<typename TStr1, typename TStr2, typename TStr3, typename TStr4>
+    TypeSignature(_In_ TStr1&& signature, _In_ TStr2&& moduleName, _In_ TStr3&& minVersion, _In_ TStr4&& maxVersion)
+    {
+        const wchar_t *pSignature = Details::ExtractString(signature);
+        const wchar_t *pModuleName = Details::ExtractString(moduleName);
+        const wchar_t *pMinVersion = Details::ExtractString(minVersion);
+        const wchar_t *pMaxVersion = Details::ExtractString(maxVersion);
+        ComPtr<IDebugHostSymbols> spHostSym;
+        ClientEx::CheckHr(ClientEx::GetHost()->QueryInterface(IID_PPV_ARGS(&spHostSym)));
+        ClientEx::CheckHr(spHostSym->CreateTypeSignatureForModuleRange(pSignature,
+                                                                                pModuleName,
+                                                                                pMinVersion,
+                                                                                pMaxVersion,
+                                                                                &m_spTypeSignature));
+    }
+
+    operator IDebugHostTypeSignature* () const { return m_spTypeSignature.Get(); }
+
+protected:
+
+    ComPtr<IDebugHostTypeSignature> m_spTypeSignature;
+};
+
+//**************************************************************************
+// Metadata:
+//
+// Represents metadata in the object model
+//
+
+// Metadata:
+//
+// Represents object metadata which can be set on keys or returned in various other contexts.
+//
+class Metadata
+{
+public:
+
+    Metadata() { }
+    Metadata(_In_ const Metadata &src) : m_spKeyStore(src.m_spKeyStore) { }
+    Metadata(_In_ Metadata&& src) : m_spKeyStore(std::move(src.m_spKeyStore)) { }
+    Metadata(_In_ IKeyStore *pKeyStore) : m_spKeyStore(pKeyStore) { }
+    Metadata(_In_ ComPtr<IKeyStore>& spKeyStore) : m_spKeyStore(spKeyStore) { }
+    Metadata(_In_ const ComPtr<IKeyStore>& spKeyStore) : m_spKeyStore(spKeyStore) { }
+    Metadata(_In_ ComPtr<IKeyStore>&& spKeyStore) : m_spKeyStore(std::move(spKeyStore)) { }
+
+    Metadata& operator=(_In_ const Metadata& rhs)
+    {
+        m_spKeyStore = rhs.m_spKeyStore;
+        return *this;
+    }
+
+    Metadata& operator=(_In_ Metadata&& rhs)
+    {
+        m_spKeyStore = std::move(rhs.m_spKeyStore);
+        return *this;
+    }
+
+    template<typename... TArgs,
+             typename = std::enable_if_t<!Details::IsCopyMove_v<Metadata, TArgs...>>>
+    explicit Metadata(_In_ TArgs&&... initializers);
+
+    operator IKeyStore *() const { return m_spKeyStore.Get(); }
+    IKeyStore *operator->() const { return m_spKeyStore.Get(); }
+    IKeyStore *Detach() { return m_spKeyStore.Detach(); }
+
+    Object KeyValue(_In_z_ const wchar_t *keyName) const;
+
+    template<typename... TArgs,
+             typename = std::enable_if_t<!Details::IsCopyMove_v<Metadata, TArgs...>>>
+    void SetKeys(_In_ TArgs&&... initializers);
+
+private:
+
+    void EnsureCreated()
+    {
+        if (m_spKeyStore != nullptr)
+        {
+            return;
+        }
+
+        CheckHr(GetManager()->CreateMetadataStore(nullptr, &m_spKeyStore));
+    }
+
+    ComPtr<IKeyStore> m_spKeyStore;
+
+};
+
+//**************************************************************************
+//
+// Object:
+//
+// Represents an object in the data model
+//
+
+class Deconstruction;
+class DeconstructionSink;
+
+namespace Details
+{
+    // ParallelResult:
+    //
+    // The result type of a function passed to TransformElements.
+    //
+    template<typename TFunc, typename = void>
+    struct ParallelResult
+    {
+        using type = std::decay_t<std::invoke_result_t<TFunc&, const Object&>>;
+    };
+
+    template<typename TFunc>
+    struct ParallelResult<TFunc, std::enable_if_t<std::is_invocable_v<TFunc&, const Object&, const HostContext&>>>
+    {
+        using type = std::decay_t<std::invoke_result_t<TFunc&, const Object&, const HostContext&>>;
+    };
+
+    template<typename TFunc> using ParallelResult_t = typename ParallelResult<TFunc>::type;
+}
+
+class Object
+{
+public:
+
+    using iterator = Details::ObjectIterator<Object>;
+    using const_iterator = Details::ObjectIterator<Object>;
+
+    //*************************************************
+    // Factory Methods:
+    //
+
+    // RootNamespace():
+    //
+    // Returns the root namespace of the host.
+    //
+    static Object RootNamespace()
+    {
+        return Object(Details::GetCurrentObject(Details::CurrentObjectKind::RootNamespace, []()
+        {
+            ComPtr<IModelObject> spObj;
+            CheckHr(GetManager()->GetRootNamespace(&spObj));
+            return spObj;
+        }));
+    }
+
+    // CurrentContext():
+    //
+    // Returns a boxed representation of the current context of the host (see HostContext::Current()).
+    //
+    static Object CurrentContext()
+    {
+        HostContext currentContext = HostContext::Current();
+        ComPtr<IDebugHostContext> spCtx = static_cast<IDebugHostContext *>(currentContext);
+        return Object(std::move(spCtx));
+    }
+
+    // SessionOf():
+    //
+    // Returns the session associated with the given object.  If no session is associated with the
+    // given object, an exception is thrown.
+    //
+    static Object SessionOf(_In_ const Object& obj)
+    {
+        return RootNamespace().KeyValue(L"Debugger").KeyValue(L"Sessions")[obj];
+    }
+
+    // ProcessOf():
+    //
+    // Returns the process associated with the given object.  If no process is associated with the
+    // given object, an exception is thrown.
+    //
+    static Object ProcessOf(_In_ const Object& obj)
+    {
+        return SessionOf(obj).KeyValue(L"Processes")[obj];
+    }
+
+    // ThreadOf():
+    //
+    // Returns the thread associated with the given object.  If no thread is associated with the
+    // given object, an exception is thrown.
+    //
+    static Object ThreadOf(_In_ const Object& obj)
+    {
+        return ProcessOf(obj).KeyValue(L"Threads")[obj];
+    }
+
+    // CurrentSession():
+    //
+    // Returns the current session of the host.
+    //
+    static Object CurrentSession()
+    {
+        return Object(Details::GetCurrentObject(Details::CurrentObjectKind::Session, []()
+        {
+            return ComPtr<IModelObject>(SessionOf(CurrentContext()).GetObject());
+        }));
+    }
+
+    // CurrentProcess():
+    //
+    // Returns the current process of the host.
+    //
+    static Object CurrentProcess()
+    {
+        return Object(Details::GetCurrentObject(Details::CurrentObjectKind::Process, []()
+        {
+            return ComPtr<IModelObject>(ProcessOf(CurrentContext()).GetObject());
+        }));
+    }
+
+    // CurrentThread():
+    //
+    // Returns the current thread of the host.
+    //
+    static Object CurrentThread()
+    {
+        return Object(Details::GetCurrentObject(Details::CurrentObjectKind::Thread, []()
+        {
+            return ComPtr<IModelObject>(ThreadOf(CurrentContext()).GetObject());
+        }));
+    }
+
+    // Create():
+    //
+    // Creates a new empty object with the given context.
+    //
+    template<typename... TArgs>
+    static Object Create(_In_ const HostContext& hostContext, _In_ TArgs&&... initializers)
+    {
+        ComPtr<IModelObject> spObj;
+        CheckHr(GetManager()->CreateSyntheticObject(hostContext, &spObj));
+        Details::KeyFiller<IModelObject, TArgs...>::Fill(spObj.Get(), std::forward<TArgs>(initializers)...);
+        return Object(std::move(spObj));
+    }
+
+    // Create():
+    //
+    // Creates a new empty object from metadata (key store) with the given context .
+    //
+    template<typename... TArgs>
+    static Object Create(_In_ const HostContext& hostContext, _In_ const Metadata& metadata, _In_ TArgs&&... initializers)
+    {
+        Microsoft::WRL::ComPtr<IDataModelManager4> spDataModelManager4;
+        {
+            Microsoft::WRL::ComPtr<IDataModelManager> spDataModelManager = GetManager();
+            CheckHr(spDataModelManager.As(&spDataModelManager4));
+        }
+
+        ComPtr<IModelObject> spObj;
+        CheckHr(spDataModelManager4->CreateSyntheticObjectFromKeyStore(hostContext, metadata, &spObj));
+        Details::KeyFiller<IModelObject, TArgs...>::Fill(spObj.Get(), std::forward<TArgs>(initializers)...);
+        return Object(std::move(spObj));
+    }
+
+    // CreateTyped():
+    //
+    // Creates a new typed object.
+    //
+    static Object CreateTyped(_In_ const Type& objectType, _In_ const Location& objectLocation)
+    {
+        ComPtr<IModelObject> spObj;
+        CheckHr(Details::Tracing::HostCall("CreateTypedObject", [&]() { return GetManager()->CreateTypedObject(nullptr, objectLocation, objectType, &spObj); }));
+        return Object(std::move(spObj));
+    }
+
+    // CreateTyped():
+    //
+    // Creates a new typed object.
+    //
+    static Object CreateTyped(_In_ const HostContext& hostContext, _In_ const Type& objectType, _In_ const Location& objectLocation)
+    {
+        ComPtr<IModelObject> spObj;
+        CheckHr(Details::Tracing::HostCall("CreateTypedObject", [&]() { return GetManager()->CreateTypedObject(hostContext, objectLocation, objectType, &spObj); }));
+        return Object(std::move(spObj));
+    }
+
+    // CreatePointer():
+    //
+    // Creates a new pointer object.
+    //
+    static Object CreatePointer(_In_ const Type& pointerType, _In_ ULONG64 ptrValue)
+    {
+        if (pointerType.GetKind() != TypePointer)
+        {
+            throw std::invalid_argument("Supplied type is not a pointer");
+        }
+
+        VARIANT vtPtr; vtPtr.vt = VT_UI8; vtPtr.ullVal = ptrValue;
+
+        ComPtr<IModelObject> spObj;
+        CheckHr(GetManager()->CreateTypedIntrinsicObject(&vtPtr, pointerType, &spObj));
+        return Object(std::move(spObj));
+    }
+
+    // CreatePointer():
+    //
+    // Creates a new pointer object.
+    //
+    static Object CreatePointer(_In_ const HostContext& hostContext, _In_ const Type& pointerType, _In_ ULONG64 ptrValue)
+    {
+        if (pointerType.GetKind() != TypePointer)
+        {
+            throw std::invalid_argument("Supplied type is not a pointer");
+        }
+
+        VARIANT vtPtr; vtPtr.vt = VT_UI8; vtPtr.ullVal = ptrValue;
+
+        ComPtr<IDataModelManager2> spManager2;
+        {
+            ComPtr<IDataModelManager> spManager = GetManager();
+
+            CheckHr(spManager.As(&spManager2));
+        }
+
+        ComPtr<IModelObject> spObj;
+        CheckHr(spManager2->CreateTypedIntrinsicObjectEx(hostContext, &vtPtr, pointerType, &spObj));
+        return Object(std::move(spObj));
+    }
+
+    // CreateNoValue():
+    //
+    // Creates a "No Value" object.
+    //
+    static Object CreateNoValue()
+    {
+        ComPtr<IModelObject> spObj;
+        CheckHr(GetManager()->CreateNoValue(&spObj));
+        return Object(std::move(spObj));
+    }
+
+    // CreateError():
+    //
+    // Creates an error object from an hresult and a string.
+    //
+    template<typename TStr>
+    static Object CreateError(_In_ HRESULT hr, _In_ TStr &&str)
+    {
+        ComPtr<IModelObject> spError;
+        CheckHr(GetManager()->CreateErrorObject(hr, Details::ExtractString(str), &spError));
+        return Object(std::move(spError));
+    }
+
+    // CreateError():
+    //
+    // Creates an error object from an exception pointer.
+    //
+    static Object CreateError(_In_ const std::exception_ptr& exptr)
+    {
+        ComPtr<IModelObject> spError;
+        auto hr = Details::Exceptions::ReturnResult(exptr, &spError);
+        if (!spError) {
+            CheckHr(GetManager()->CreateErrorObject(hr, nullptr, &spError));
+        }
+
+        return Object(std::move(spError));
+    }
+
+    // FromExpressionEvaluation():
+    //
+    // Creates an object from a language expression evaluation.  This may only use the underlying
+    // syntax of the language.  There is a guarantee that such is portable from host to host (as long as both hosts
+    // debug the same language)
+    //
+    template<typename TStr>
+    static Object FromExpressionEvaluation(_In_ const HostContext& evaluationContext, _In_ TStr&& expression)
+    {
+        ComPtr<IModelObject> spObj;
+        ComPtr<IDebugHostEvaluator> spEval;
+        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval)));
+        CheckHr(spEval->EvaluateExpression(evaluationContext, Details::ExtractString(expression), nullptr, &spObj, nullptr));
+        return Object(std::move(spObj));
+    }
+
+    // FromExtendedExpressionEvaluation():
+    //
+    // Creates an object from a host specific expression evaluation.  This may use any syntax the underlying host supports; however,
+    // there is *NO GUARANTEE* that such is portable from host to host.
+    //
+    template<typename TStr>
+    static Object FromExtendedExpressionEvaluation(_In_ const HostContext& evaluationContext, _In_ TStr&& expression)
+    {
+        ComPtr<IModelObject> spObj;
+        ComPtr<IDebugHostEvaluator> spEval;
+        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spEval)));
+        CheckHr(spEval->EvaluateExtendedExpression(evaluationContext, Details::ExtractString(expression), nullptr, &spObj, nullptr));
+        return Object(std::move(spObj));
+    }
+
+    //
+    // @TODO: This is **NOT** complete.
+    //
+    static Object FromSymbol(_In_ IDebugHostSymbol *pSymbol)
+    {
+        SymbolKind sk;
+        CheckHr(pSymbol->GetSymbolKind(&sk));
+
+        switch(sk)
+        {
+            case SymbolData:
+            {
+                ComPtr<IDebugHostData> spData;
+                CheckHr(pSymbol->QueryInterface(IID_PPV_ARGS(&spData)));
+
+                ComPtr<IDebugHostType> spType;
+                Location loc;
+
+                CheckHr(spData->GetType(&spType));
+                CheckHr(spData->GetLocation(&loc));
+
+                ComPtr<IModelObject> spObj;
+                CheckHr(Details::Tracing::HostCall("CreateTypedObject", [&]() { return GetManager()->CreateTypedObject(nullptr, loc, spType.Get(), &spObj); }));
+                return Object(std::move(spObj));
+            }
+
+            default:
+                // @TODO:
+                throw not_implemented();
+        }
+    }
+
+    template<typename TStr1, typename TStr2>
+    static Object FromGlobalSymbol(const HostContext& symbolContext,
+                                   TStr1&& moduleName,
+                                   TStr2&& symbolName)
+    {
+        Module symMod(symbolContext, Details::ExtractString(moduleName));
+
+        ComPtr<IDebugHostSymbols> spSymbols;
+        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&spSymbols)));
+
+        ComPtr<IDebugHostSymbol> spSymbol;
+        CheckHr(symMod->FindSymbolByName(Details::ExtractString(symbolName), &spSymbol));
+
+        return FromSymbol(spSymbol.Get());
+    }
+
+    // FromModelName():
+    //
+    // Returns an object based on a lookup from a registered model name.  The lookup goes through the
+    // NamedModelCache.
+    //
+    template<typename TStr>
+    static Object FromModelName(TStr&& modelName)
+    {
+        ComPtr<IModelObject> spModel;
+        CheckHr(NamedModelCache::Instance().AcquireNamedModel(Details::ExtractString(modelName), &spModel));
+        return Object(std::move(spModel));
+    }
+
+    // CreateInstanceOf():
+    //
+    // Creates a synthetic object which is an instance of a particular data model.
+    //
+    static Object CreateInstanceOf(_In_ const Object& model,
+                                   _In_ const HostContext& hostContext)
+    {
+        Object o = Create(hostContext);
+        CheckHr(o->AddParentModel(model, nullptr, false));
+
+        return o;
+    }
+
+    // ConstructModelInstance():
+    //
+    // Creates an instance of a named model which supports the constructable concept.
+    //
+    template<typename TStr, typename... TArgs>
+    static Object ConstructModelInstance(TStr&& name, TArgs&&... args)
+    {
+        Object dataModel = Object::FromModelName(std::forward<TStr>(name));
+        return dataModel.ConstructInstance(std::forward<TArgs>(args)...);
+    }
+
+    //*************************************************
+    // Object Methods:
+    //
+
+    Object() { }
+    Object(_In_ IModelObject *pObject) : m_spObject(pObject) { }
+    Object(_In_ const Object& src) : m_spObject(src.m_spObject) { }
+    Object(_In_ Object&& src) : m_spObject(std::move(src.m_spObject)) { }
+    Object(_In_ ComPtr<IModelObject>& src) : m_spObject(src) { }
+    Object(_In_ const ComPtr<IModelObject>& src) : m_spObject(src) { }
+    Object(_In_ ComPtr<IModelObject>&& src) : m_spObject(std::move(src)) { }
+    Object(_In_ std::nullptr_t) { }
+
+    // Constructor:
+    //
+    // Construct from arbitrary type.
+    //
+    template<typename TArg,
+             typename = std::enable_if_t<!Details::IsCopyMove_v<Object, TArg> && !Details::IsObjectView_v<TArg>>>
+    Object(_In_ TArg&& value);
+
+    template<typename TArg> explicit operator TArg() const { return As<TArg>(); }
 
     IModelObject *Detach()
     {
-        return Steal();
-    }
+        return Steal();
+    }
+
+    IModelObject *GetObject() const
+    {
+        return m_spObject.Get();
+    }
+
+    operator IModelObject *() const
+    {
+        return GetObject();
+    }
+
+    operator HostContext() const
+    {
+        ComPtr<IDebugHostContext> spCtx;
+        CheckHr(m_spObject->GetContext(&spCtx));
+        return HostContext(std::move(spCtx));
+    }
+
+    IModelObject *operator->() const
+    {
+        return GetObject();
+    }
+
+    // operator++:
+    //
+    // Pre-increment (for pointer types and the like)
+    //
+    Object& operator++()
+    {
+        Object incremented = Details::ObjectOperators<Object>::Increment(*this);
+        *this = std::move(incremented);
+        return *this;
+    }
+
+    // operator++:
+    //
+    // Post-increment (for pointer types and the like)
+    //
+    Object operator++(int)
+    {
+        Object original = *this;
+        ++(*this);
+        return original;
+    }
+
+    // operator+=:
+    //
+    // Increment by operation.
+    //
+    Object& operator+=(_In_ LONG64 offset)
+    {
+        Object incremented = Details::ObjectOperators<Object>::IncrementBy(*this, static_cast<LONG64>(offset));
+        *this = std::move(incremented);
+        return *this;
+    }
+
+    // operator--:
+    //
+    // Pre-decrement (for pointer types and the like)
+    //
+    Object& operator--()
+    {
+        Object decremented = Details::ObjectOperators<Object>::Decrement(*this);
+        *this = std::move(decremented);
+        return *this;
+    }
+
+    // operator--:
+    //
+    // Post-decrement (for pointer types and the like)
+    //
+    Object operator--(int)
+    {
+        Object original = *this;
+        --(*this);
+        return original;
+    }
+
+    // operator-=:
+    //
+    // Decrement by operation.
+    //
+    Object& operator-=(_In_ LONG64 offset)
+    {
+        Object decremented = Details::ObjectOperators<Object>::DecrementBy(*this, static_cast<LONG64>(offset));
+        *this = std::move(decremented);
+        return *this;
+    }
+
+    // operator==:
+    //
+    // Compare to another object for equality.
+    //
+    template<typename TArg>
+    bool operator==(_In_ TArg&& other) const { return IsEqualTo(std::forward<TArg>(other)); }
+
+    // operator!=
+    //
+    // Compare to another object for lack of equality.
+    //
+    template<typename TArg>
+    bool operator!=(_In_ TArg&& other) const { return !operator==(std::forward<TArg>(other)); }
+
+    // Comparison operators:
+    //
+    // Performs comparison with another objects.  If there is no path by which the objects can be compared,
+    // an exception will be thrown.
+    //
+    template<typename TArg> bool operator<(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) < 0; }
+    template<typename TArg> bool operator>(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) > 0; }
+    template<typename TArg> bool operator<=(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) <= 0; }
+    template<typename TArg> bool operator>=(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) >= 0; }
+
+    // GetKind():
+    //
+    // Gets the kind of object this is (according to the data model).
+    //
+    ModelObjectKind GetKind() const
+    {
+        ModelObjectKind mk;
+        ClientEx::CheckHr(m_spObject->GetKind(&mk));
+        return mk;
+    }
+
+    // Type():
+    //
+    // The type of object.  This will return an empty Type() for objects that have no native type.
+    //
+    Type Type() const
+    {
+        ComPtr<IDebugHostType> spType;
+        CheckHr(m_spObject->GetTypeInfo(&spType));
+        return ClientEx::Type(std::move(spType));
+    }
+
+    // GetLocation():
+    //
+    // The location of the object.  This will throw for objects which have no location.
+    //
+    Location GetLocation() const
+    {
+        Location objLocation;
+        CheckHr(m_spObject->GetLocation(&objLocation));
+        return objLocation;
+    }
+
+    // ReadArray():
+    //
+    // Reads count contiguous elements of type T from the target into caller supplied memory.  The object must be
+    // a standard pointer (elements are read from the pointed-to address), an array (at most the array's element
+    // count is read from the array's location), or a typed object with a location (count must be 1).  The element
+    // type is resolved once and must be compatible with T.  The read is a single memory request rather than one
+    // typed object per element.
+    //
+    template<typename T> void ReadArray(_In_ ULONG64 count, _Out_writes_all_(count) T *pDest) const;
+
+    // ReadValues():
+    //
+    // Reads count contiguous elements of type T from the target and returns them.  See ReadArray().
+    //
+    template<typename T> std::vector<T> ReadValues(_In_ ULONG64 count) const;
+
+    // WalkList():
+    //
+    // Walks a native doubly linked (LIST_ENTRY) or singly linked (SINGLE_LIST_ENTRY) list whose head is this object
+    // (or is pointed to by this object).  Each element is an object of containingType whose entry field links it into
+    // the list (the CONTAINING_RECORD of the entry).  Offsets are resolved once and links are chased with raw memory
+    // reads.  A typed object is only created for an element which is actually consumed.  See ListWalk.
+    //
+    ListWalk WalkList(_In_z_ const wchar_t *entryFieldName,
+                      _In_ const ClientEx::Type& containingType,
+                      _In_ const WalkOptions& options = WalkOptions()) const;
+
+    ListWalk WalkList(_In_ const FieldLayout& entryField,
+                      _In_ const ClientEx::Type& containingType,
+                      _In_ const WalkOptions& options = WalkOptions()) const;
+
+    // WalkTree():
+    //
+    // Walks, in order, a native binary tree (e.g.: RTL_BALANCED_NODE) whose root node is this object (or is pointed to
+    // by this object).  Each element is an object of containingType whose node field links it into the tree.  The
+    // left and right links of each node are fetched by a single memory read.  See TreeWalk.
+    //
+    TreeWalk WalkTree(_In_z_ const wchar_t *nodeFieldName,
+                      _In_ const ClientEx::Type& containingType,
+                      _In_ const WalkOptions& options = WalkOptions()) const;
+
+    TreeWalk WalkTree(_In_z_ const wchar_t *nodeFieldName,
+                      _In_ const ClientEx::Type& containingType,
+                      _In_z_ const wchar_t *leftFieldName,
+                      _In_z_ const wchar_t *rightFieldName,
+                      _In_ const WalkOptions& options = WalkOptions()) const;
+
+    // Keys():
+    //
+    // Returns a collection of the keys on the object.
+    //
+    Details::ObjectKeysRef<Object, Metadata> Keys() const
+    {
+        return Details::ObjectKeysRef<Object, Metadata>(*this);
+    }
+
+    // KeyValue():
+    //
+    // Fetches a key value without the overhead of returning key references.
+    //
+    Object KeyValue(_In_z_ const wchar_t *keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
+    {
+        if (pMetadata != nullptr)
+        {
+            *pMetadata = Metadata();
+        }
+
+        ComPtr<IModelObject> spValue;
+        ComPtr<IKeyStore> spMetadata;
+        IKeyStore **ppMetadata = (pMetadata != nullptr) ? (IKeyStore **)&spMetadata : nullptr;
+        CheckHr(Details::Tracing::HostCall("GetKeyValue", [&]() { return m_spObject->GetKeyValue(keyName, &spValue, ppMetadata); }));
+
+        if (pMetadata != nullptr)
+        {
+            *pMetadata = Metadata(std::move(spMetadata));
+        }
+        return Object(std::move(spValue));
+    }
+
+    // KeyValue():
+    //
+    // Fetches a key value without the overhead of returning key references.
+    //
+    Object KeyValue(_In_ const std::wstring& keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
+    {
+        return KeyValue(keyName.c_str(), pMetadata);
+    }
+
+    // TryGetKeyValue():
+    //
+    // Fetches a key value, if it exists, without the overhead of returning key references.
+    //
+    std::optional<Object> TryGetKeyValue(_In_z_ const wchar_t *keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
+    {
+        if (pMetadata != nullptr)
+        {
+            *pMetadata = Metadata();
+        }
+
+        ComPtr<IModelObject> spValue;
+        ComPtr<IKeyStore> spMetadata;
+        IKeyStore **ppMetadata = (pMetadata != nullptr) ? (IKeyStore **)&spMetadata : nullptr;
+        if (SUCCEEDED(Details::Tracing::HostCall("GetKeyValue", [&]() { return m_spObject->GetKeyValue(keyName, &spValue, ppMetadata); })))
+        {
+            if (pMetadata != nullptr)
+            {
+                *pMetadata = Metadata(std::move(spMetadata));
+            }
+
+            return Object(std::move(spValue));
+        }
+
+        return std::nullopt;
+    }
+
+    // TryGetKeyValue():
+    //
+    // Fetches a key value, if it exists, without the overhead of returning key references.
+    //
+    std::optional<Object> TryGetKeyValue(_In_ const std::wstring& keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
+    {
+        return TryGetKeyValue(keyName.c_str(), pMetadata);
+    }
+
+    // Fields():
+    //
+    // Returns a collection of the native fields on the object.
+    //
+    Details::ObjectFieldsRef<Object> Fields() const
+    {
+        return Details::ObjectFieldsRef<Object>(*this);
+    }
+
+    // FieldValue():
+    //
+    // Fetches a field value without the overhead of returning field references.
+    //
+    Object FieldValue(_In_z_ const wchar_t *fieldName) const
+    {
+        ComPtr<IModelObject> spValue;
+        CheckHr(m_spObject->GetRawValue(SymbolField, fieldName, RawSearchNone, &spValue));
+        return Object(std::move(spValue));
+    }
+
+    // FieldValue():
+    //
+    // Fetches a field value without the overhead of returning field references.
+    //
+    Object FieldValue(_In_ const std::wstring& fieldName) const
+    {
+        return FieldValue(fieldName.c_str());
+    }
+
+    // FieldValue():
+    //
+    // Fetches a field value from a precomputed layout (see TypeLayoutCache).  The field is created directly at its
+    // offset from this object's location rather than searched for by name.  The layout must have been computed for
+    // the type of this object.
+    //
+    Object FieldValue(_In_ const FieldLayout& fieldLayout) const
+    {
+        Location fieldLocation = GetLocation();
+        fieldLocation.Offset += fieldLayout.Offset;
+
+        ComPtr<IDebugHostContext> spCtx;
+        CheckHr(m_spObject->GetContext(&spCtx));
+
+        ComPtr<IModelObject> spValue;
+        CheckHr(Details::Tracing::HostCall("CreateTypedObject", [&]() { return GetManager()->CreateTypedObject(spCtx.Get(), fieldLocation, fieldLayout.FieldType, &spValue); }));
+        return Object(std::move(spValue));
+    }
+
+    // TryGetFieldValue():
+    //
+    // Fetches a field, if it exists, without the overhead of returning field
+    // references.
+    //
+    std::optional<Object> TryGetFieldValue(_In_z_ const wchar_t *fieldName) const
+    {
+        ComPtr<IModelObject> spValue;
+        if (SUCCEEDED(m_spObject->GetRawValue(SymbolField, fieldName, RawSearchNone, &spValue)))
+        {
+            return Object(std::move(spValue));
+        }
+
+        return std::nullopt;
+    }
+
+    // TryGetFieldValue():
+    //
+    // Fetches a field, if it exists, without the overhead of returning field
+    // references.
+    //
+    std::optional<Object> TryGetFieldValue(_In_ const std::wstring& fieldName) const
+    {
+        return TryGetFieldValue(fieldName.c_str());
+    }
+
+    // Dereference():
+    //
+    // Returns a "reference" to the dereferenced object.
+    //
+    Details::DereferenceReference<Object> Dereference() const
+    {
+        return Details::DereferenceReference<Object>(*this);
+    }
+
+    // TryDereference():
+    //
+    // Dereferences the object without throwing on failure.
+    //
+    Expected<Object> TryDereference() const;
+
+    // operator=:
+    //
+    // Copy another object.
+    //
+    Object& operator=(const Object& src)
+    {
+        m_spObject = src.m_spObject;
+        return *this;
+    }
+
+    // operator=:
+    //
+    // Move another object.
+    //
+    Object& operator=(Object&& src)
+    {
+        m_spObject = std::move(src.m_spObject);
+        return *this;
+    }
+
+    // operator=:
+    //
+    // Perform assignment to an object.
+    //
+    template<typename TArg,
+             typename = std::enable_if_t<!Details::IsCopyMove_v<Object, TArg> && !Details::IsObjectView_v<TArg>>>
+    Object& operator=(TArg&& assignmentValue);
+
+    // As():
+    //
+    // Converts the object too something else.
+    //
+    template<typename TType> TType As() const;
+
+    // Call():
+    //
+    // Calls an object which represents a method and returns a new object representing the result.
+    // If the object is not a method or the call fails, an exception is thrown.
+    //
+    // The original "this" pointer must be passed into this method.
+    //
+    template<typename... TArgs> Object Call(_In_ const Object& instance, TArgs&&... callArguments) const;
+
+    // CallMethod():
+    //
+    // Finds a method of the given name on this object and calls it as an instance method.
+    //
+    template<typename... TArgs> Object CallMethod(_In_z_ const wchar_t *methodName, TArgs&&... callArguments) const
+    {
+        Object method = this->Keys()[methodName];
+        return method.Call(*this, std::forward<TArgs>(callArguments)...);
+    }
+    template<typename... TArgs> Object CallMethod(_In_ const std::wstring& methodName, TArgs&&... callArguments) const
+    {
+        return CallMethod(methodName.c_str(), std::forward<TArgs>(callArguments)...);
+    }
+
+    // TryCall():
+    //
+    // Calls an object which represents a method without throwing if the object is not a method or the call fails.
+    // The failing HRESULT and any error object produced by the method are returned instead.
+    //
+    // The original "this" pointer must be passed into this method.
+    //
+    template<typename... TArgs> Expected<Object> TryCall(_In_ const Object& instance, TArgs&&... callArguments) const;
+
+    // TryCallMethod():
+    //
+    // Finds a method of the given name on this object and calls it as an instance method without throwing if
+    // the method does not exist or the call fails.
+    //
+    template<typename... TArgs> Expected<Object> TryCallMethod(_In_z_ const wchar_t *methodName, TArgs&&... callArguments) const
+    {
+        ComPtr<IModelObject> spMethod;
+        HRESULT hr = Details::Tracing::HostCall("GetKeyValue", [&]() { return m_spObject->GetKeyValue(methodName, &spMethod, nullptr); });
+        if (FAILED(hr))
+        {
+            return Unexpected(hr, std::move(spMethod));
+        }
+        return Object(std::move(spMethod)).TryCall(*this, std::forward<TArgs>(callArguments)...);
+    }
+    template<typename... TArgs> Expected<Object> TryCallMethod(_In_ const std::wstring& methodName, TArgs&&... callArguments) const
+    {
+        return TryCallMethod(methodName.c_str(), std::forward<TArgs>(callArguments)...);
+    }
+
+    // operator[]():
+    //
+    // Indexes an object
+    //
+    template<typename... TArgs> Details::IndexableReference<Object, Details::ParameterPack> operator[](TArgs&&... indexers) const
+    {
+        return Index(std::forward<TArgs>(indexers)...);
+    }
+
+    template<typename... TArgs> Details::IndexableReference<Object, Details::ParameterPack> Index(TArgs&&... indexers) const;
+
+
+    // begin():
+    //
+    // Returns a starting iterator.  If the object is not iterable, this will throw an exception.  The returned
+    // iterator is a forward iterator.
+    //
+    iterator begin()
+    {
+        ComPtr<IIterableConcept> spIterable;
+        CheckHr(m_spObject->GetConcept(__uuidof(IIterableConcept), &spIterable, nullptr));
+        ComPtr<IModelIterator> spIterator;
+        CheckHr(spIterable->GetIterator(GetObject(), &spIterator));
+        return iterator(*this, spIterator.Get());
+    }
+    const_iterator begin() const { return cbegin(); }
+
+    // end():
+    //
+    // Returns the ending iterator.
+    //
+    iterator end()
+    {
+        return iterator();
+    }
+    const_iterator end() const { return cend(); }
+
+    // cbegin():
+    //
+    // Returns a constant starting iterator.  If the object is not iterable, this will throw an exception.  The
+    // returned iterator is a forward iterator.
+    //
+    const_iterator cbegin() const
+    {
+        ComPtr<IIterableConcept> spIterable;
+        CheckHr(m_spObject->GetConcept(__uuidof(IIterableConcept), &spIterable, nullptr));
+        ComPtr<IModelIterator> spIterator;
+        CheckHr(spIterable->GetIterator(GetObject(), &spIterator));
+        return iterator(*this, spIterator.Get());
+    }
+
+    // cend():
+    //
+    // Returns the constant end iterator.
+    //
+    const_iterator cend() const
+    {
+        return iterator();
+    }
+
+    // IterateBatched():
+    //
+    // Returns an iterable whose elements are runs (std::vector<Object>) of up to batchSize values of this
+    // object.  The vector is reused between steps.  If the object is not iterable, this will throw an exception
+    // when iteration begins.  Indexers and metadata are not returned through batched iteration.
+    //
+    Details::ObjectBatchesRef<Object> IterateBatched(_In_ size_t batchSize = 256) const
+    {
+        return Details::ObjectBatchesRef<Object>(*this, batchSize);
+    }
+
+    // Slice():
+    //
+    // Returns up to count elements of this iterable object starting at the element at position begin.  The
+    // elements before begin are skipped without being fetched where the object allows it (see
+    // ObjectIterator::Advance).  If the object is not iterable, this will throw an exception.
+    //
+    std::vector<Object> Slice(_In_ ULONG64 begin, _In_ ULONG64 count) const
+    {
+        std::vector<Object> values;
+        if (count == 0)
+        {
+            return values;
+        }
+
+        const_iterator it = cbegin();
+        const_iterator itEnd = cend();
+        it.Advance(begin);
+        while (it != itEnd)
+        {
+            values.push_back(*it);
+            if (values.size() == count)
+            {
+                //
+                // Do not fetch the element past the end of the slice.
+                //
+                break;
+            }
+            ++it;
+        }
+        return values;
+    }
+
+    // ForEachElement():
+    //
+    // Calls func on each element sequentially on the calling thread unless options opt in to worker threads (by
+    // clearing ParallelOptions::SerializeCallbacks).  The elements of this iterable object are snapshotted first.
+    // func takes either (const Object& element) or (const Object& element, const HostContext& workerContext).
+    // workerContext is the context of this object; it is the same host context for every worker and is passed so
+    // that func need not capture it.  The order of calls is unspecified.  If any call throws, remaining work is
+    // abandoned and the first exception is rethrown here.  See "Parallel Evaluation" for which host operations may be
+    // performed from func.
+    //
+    template<typename TFunc> void ForEachElement(_In_ TFunc&& func, _In_ const ParallelOptions& options = ParallelOptions()) const;
+
+    // TransformElements():
+    //
+    // As ForEachElement (sequential on the calling thread unless options opt in to worker threads), returning the
+    // results of func for each element in the order of the elements.
+    //
+    template<typename TFunc> auto TransformElements(_In_ TFunc&& func, _In_ const ParallelOptions& options = ParallelOptions()) const
+        -> std::vector<Details::ParallelResult_t<TFunc>>;
+
+    // CompareTo():
+    //
+    // Compares this object to another.  If there is no comparison defined between the two object types, this
+    // will throw.
+    //
+    template<typename TArg> int CompareTo(TArg&& other) const;
+
+    // IsEqualTo():
+    //
+    // Compares this object to another.  If there is no equality defined between the two object types, this
+    // will throw.
+    //
+    template<typename TArg> bool IsEqualTo(TArg&& other) const;
+
+    // ToDisplayString():
+    //
+    // If the object has a string conversion, it is returned; otherwise, an exception is thrown.
+    //
+    std::wstring ToDisplayString(_In_ const Metadata& metadata) const
+    {
+        ComPtr<IStringDisplayableConcept> spStringDisplayable;
+        CheckHr(m_spObject->GetConcept(__uuidof(IStringDisplayableConcept), &spStringDisplayable, nullptr));
+        BSTR str;
+        CheckHr(spStringDisplayable->ToDisplayString(GetObject(), metadata, &str));
+        bstr_ptr spStr(str);
+        return std::wstring(str);
+    }
+    std::wstring ToDisplayString() const { return ToDisplayString(Metadata()); }
+
+    // TryToDisplayString():
+    //
+    // Check if the object has a string conversion.  If so, true is returned and the string is filled into
+    // the output 'pDisplayString' argument; otherwise, false is returned.  If the string fails to fetch,
+    // for reasons other than there is no display string, an exception is thrown.
+    //
+    std::optional<std::wstring> TryToDisplayString(_In_ const Metadata& metadata) const
+    {
+        std::optional<std::wstring> displayString;
+
+        ComPtr<IStringDisplayableConcept> spStringDisplayable;
+        if (SUCCEEDED(m_spObject->GetConcept(__uuidof(IStringDisplayableConcept), &spStringDisplayable, nullptr)))
+        {
+            BSTR str;
+            HRESULT hr = spStringDisplayable->ToDisplayString(GetObject(), metadata, &str);
+
+            //
+            // E_NOT_SET is a special code which indicates that there is no display string despite the fact
+            // that the concept is implemented.  This is *NOT* a failure to fetch per-se.
+            //
+            if (hr != E_NOT_SET)
+            {
+                CheckHr(hr);
+            }
+            bstr_ptr spStr(str);
+            displayString = std::wstring(str);
+        }
+        return displayString;
+    }
+    std::optional<std::wstring> TryToDisplayString() const
+    {
+        return TryToDisplayString(Metadata());
+    }
+    bool TryToDisplayString(_Out_ std::wstring *pDisplayString, _In_ const Metadata& metadata) const
+    {
+        auto displayString = TryToDisplayString(metadata);
+        if (displayString)
+        {
+            *pDisplayString = std::move(displayString.value());
+            return true;
+        }
+        return false;
+    }
+    bool TryToDisplayString(_Out_ std::wstring *pDisplayString)
+    {
+        return TryToDisplayString(pDisplayString, Metadata());
+    }
+
+    // ConstructInstance():
+    //
+    // If the object is constructable, this will invoke the constructor with the given set of arguments.
+    //
+    template<typename... TArgs,
+             typename = std::enable_if_t<!Details::IsSingleType_v<Deconstruction, TArgs...>>>
+    Object ConstructInstance(_In_ TArgs&&... args)
+    {
+        ComPtr<IConstructableConcept> spConstructable;
+        CheckHr(m_spObject->GetConcept(__uuidof(IConstructableConcept), &spConstructable, nullptr));
+        auto pack = Details::PackValues(std::forward<TArgs>(args)...);
+        ComPtr<IModelObject> spInstance;
+        CheckHr(spConstructable->CreateInstance(sizeof...(args), reinterpret_cast<IModelObject **>(pack.get()), &spInstance));
+        return Object(std::move(spInstance));
+    }
+
+    Object ConstructInstance(_In_ Deconstruction& deconstruction);
+
+    // Deconstruct():
+    //
+    // If the object is deconstructable, this returns a deconstruction of the object (a set of constructor
+    // arguments which, if supplied back to the constructor, will recreate the object).
+    //
+    Deconstruction Deconstruct();
+
+    // Deconstruct():
+    //
+    // If the object is deconstructable, this passes the deconstruction of the object to the sink one argument at
+    // a time rather than collecting the arguments.  If the deconstructable concept is one implemented by this
+    // library (BindDeconstructable / AddDeconstructableFunction), each argument is boxed, passed and released in
+    // turn.
+    //
+    void Deconstruct(_In_ DeconstructionSink& sink);
+
+private:
+
+    // Steal():
+    //
+    // Steals the reference of this object.
+    //
+    IModelObject *Steal()
+    {
+        return m_spObject.Detach();
+    }
+
+    ComPtr<IModelObject> m_spObject;
+
+};
+
+// ObjectView:
+//
+// A non-owning view of an object.  A view borrows the reference held by whoever supplied the underlying
+// IModelObject (the caller of a provider callback, an argument pack, an iterator, etc...) and never touches
+// the reference count itself.  It is usable anywhere a const Object& is expected; a reference is only taken
+// when the value escapes the view (it is copied into an Object).  A view must not outlive the reference it
+// borrows.
+//
+class ObjectView
+{
+public:
+
+    ObjectView() { }
+    ObjectView(_In_opt_ IModelObject *pObject) : m_object(Borrow(pObject)) { }
+    ObjectView(_In_ const Object& src) : m_object(Borrow(src.GetObject())) { }
+    ObjectView(_In_ const ObjectView& src) : m_object(Borrow(src.GetObject())) { }
+
+    //
+    // A view of a temporary would borrow a reference which is released at the end of the full expression.
+    //
+    ObjectView(_In_ Object&&) =delete;
+
+    ~ObjectView()
+    {
+        m_object.Detach();
+    }
+
+    ObjectView& operator=(_In_ const ObjectView& src)
+    {
+        m_object.Detach();
+        m_object = Borrow(src.GetObject());
+        return *this;
+    }
+
+    // GetObject():
+    //
+    // Gets the borrowed object interface.
+    //
+    IModelObject *GetObject() const
+    {
+        return m_object.GetObject();
+    }
+
+    // Get():
+    //
+    // Gets the view as an object.  The returned reference is valid for the lifetime of the view.
+    //
+    const Object& Get() const
+    {
+        return m_object;
+    }
+
+    operator const Object&() const
+    {
+        return m_object;
+    }
+
+    const Object *operator->() const
+    {
+        return &m_object;
+    }
+
+    // ToObject():
+    //
+    // Returns an owning object for the view.  This is the point at which a borrowed value escapes and is
+    // referenced.
+    //
+    Object ToObject() const
+    {
+        return m_object;
+    }
+
+private:
+
+    // Borrow():
+    //
+    // Wraps an interface in an object without taking a reference on it.
+    //
+    static Object Borrow(_In_opt_ IModelObject *pObject)
+    {
+        ComPtr<IModelObject> spObject;
+        spObject.Attach(pObject);
+        return Object(std::move(spObject));
+    }
+
+    Object m_object;
+
+};
+
+// IndexedValue:
+//
+// A value which is at a specific index.
+//
+template<typename TValue, typename... TIndicies>
+class IndexedValue
+{
+public:
+
+    using ValueType = TValue;
+    using IndiciesType = std::tuple<TIndicies...>;
+    static constexpr size_t Dimensionality = sizeof...(TIndicies);
+
+    IndexedValue() { }
+
+    IndexedValue(_In_ const TValue &value, _In_ TIndicies... indicies) :
+        m_value(value),
+        m_indicies(std::forward<TIndicies>(indicies)...)
+    {
+    }
+
+    IndexedValue(_In_ const IndexedValue& src) : m_value(src.m_value), m_indicies(src.m_indicies) { }
+    IndexedValue(_In_ IndexedValue&& src) : m_value(std::move(src.m_value)), m_indicies(std::move(src.m_indicies)) { }
+
+    IndexedValue operator=(_In_ const IndexedValue& src) { m_value = src.m_value; m_indicies = src.m_indicies; return *this; }
+    IndexedValue operator=(_In_ IndexedValue&& src) { m_value = std::move(src.m_value); m_indicies = std::move(src.m_indicies); return *this; }
+
+    const ValueType& GetValue() const { return m_value; }
+    const IndiciesType& GetIndicies() const { return m_indicies; }
+
+private:
+
+    ValueType m_value;
+    IndiciesType m_indicies;
+
+};
+
+// GeneratedIterable:
+//
+// A value which represents the deferred acquisition of an iterable through a method call.  This is a helper
+// intended to allow the adaptation of an iterable described by a C++ input iterator which can be regenerated
+// to the notion of a data model iterable.  Frequently, this is used to defer the acquisition of a generator
+// which is the result of a property binding or method binding.
+//
+// If you have a property which is bound and looks thus:
+//
+//     std::experimental::generator<T> MyProperty(...) { co_yield x; }
+//
+// When the property is fetched, the generator is boxed and the resulting object may only be iterated a single
+// time.  This may or may not be the intent of the caller.
+//
+// Instead, if this object is used:
+//
+//     GeneratedIterable<std::experimental::generator<T>> MyProperty(...)
+//     {
+//          return GeneratedIterable<std::experimental::generator<T>>(
+//              [...](){ co_yield x; }
+//              );
+//     }
+//
+// When the property is fetched, the calling of the method is deferred until the actual iterator fetch.  This way,
+// while a given instance of the iterator behaves akin to a C++ input iterator, the iterator can be fetched
+// multiple times.
+//
+// It is important that the returned iterator produce the same elements (aside any semantic manipulations between
+// iterations) so that the caller's expectations are met.  In other words, a caller which operates as follows:
+//
+//     Object container = someObject.KeyValue(L"MyProperty");
+//     int count1 = (int)container.CallMethod(L"Count");
+//     int count2 = (int)container.CallMethod(L"Count");
+//
+// should not see differing values of count1 and count2.
+//
+template<typename TContainer>
+class GeneratedIterable
+{
+public:
+
+    explicit GeneratedIterable(_In_ std::function<TContainer(void)> acquireContainer) :
+        m_acquireContainer(acquireContainer)
+    {
+    }
+
+    std::function<TContainer(void)> const& GetAcquireFunction() const { return m_acquireContainer; }
+
+private:
+
+    std::function<TContainer(void)> m_acquireContainer;
+};
+
+// MaterializedIterable:
+//
+// A value which, like GeneratedIterable, represents the deferred acquisition of an iterable.  Unlike
+// GeneratedIterable, the container is acquired and walked only once.  Its elements are stored in a contiguous
+// buffer and every later iteration is served from that buffer.  The boxed object is also indexable by position
+// from the same buffer.
+//
+// The buffer is discarded and the container acquired again when the optional epoch function returns a value
+// other than the one returned when the buffer was filled.  The epoch is typically a counter which changes
+// whenever the target executes.
+//
+// Copies of a MaterializedIterable share a single buffer.  To share one walk across repeated fetches of a
+// property, keep an instance (e.g.: as a member of the extension class) and return copies of it from the
+// property.
+//
+template<typename TContainer>
+class MaterializedIterable
+{
+public:
+
+    using ValueType = std::decay_t<decltype(*(std::declval<std::decay_t<TContainer>>().begin()))>;
+    using BufferType = std::vector<ValueType>;
+
+    explicit MaterializedIterable(_In_ std::function<TContainer(void)> acquireContainer,
+                                  _In_ std::function<ULONG64(void)> epochFunction = nullptr) :
+        m_spState(std::make_shared<State>())
+    {
+        m_spState->AcquireContainer = std::move(acquireContainer);
+        m_spState->EpochFunction = std::move(epochFunction);
+    }
+
+    // GetElements():
+    //
+    // Returns the buffer of elements.  The container is walked if this is the first request or if the epoch has
+    // changed since the buffer was filled.  A returned buffer remains valid even if a later call refills it.
+    //
+    // The container is acquired and walked without any lock held, so the elements may refer back to this iterable.
+    // If two threads race to fill the buffer, both walk and the first insertion wins.
+    //
+    std::shared_ptr<const BufferType> GetElements() const
+    {
+        ULONG64 epoch = m_spState->EpochFunction ? m_spState->EpochFunction() : 0;
+
+        ULONG64 generation;
+        {
+            std::lock_guard<std::mutex> lock(m_spState->Lock);
+            if (m_spState->Elements != nullptr && m_spState->Epoch == epoch)
+            {
+                return m_spState->Elements;
+            }
+            generation = m_spState->Generation;
+        }
+
+        std::shared_ptr<const BufferType> spElements = Walk();
+
+        std::shared_ptr<const BufferType> spDiscarded;
+        std::lock_guard<std::mutex> lock(m_spState->Lock);
+        if (m_spState->Generation != generation)
+        {
+            //
+            // The buffer was invalidated during the walk.  The elements may predate the invalidation.
+            //
+            return spElements;
+        }
+        if (m_spState->Elements != nullptr && m_spState->Epoch == epoch)
+        {
+            return m_spState->Elements;
+        }
+
+        spDiscarded = std::move(m_spState->Elements);
+        m_spState->Elements = spElements;
+        m_spState->Epoch = epoch;
+        return spElements;
+    }
+
+    // Invalidate():
+    //
+    // Discards the buffer.  The next request walks the container again.
+    //
+    void Invalidate()
+    {
+        std::shared_ptr<const BufferType> spDiscarded;
+        std::lock_guard<std::mutex> lock(m_spState->Lock);
+        spDiscarded = std::move(m_spState->Elements);
+        ++m_spState->Generation;
+    }
+
+private:
+
+    struct State
+    {
+        std::function<TContainer(void)> AcquireContainer;
+        std::function<ULONG64(void)> EpochFunction;
+        std::mutex Lock;
+        ULONG64 Epoch = 0;
+        ULONG64 Generation = 0;         // Incremented by each Invalidate()
+        std::shared_ptr<const BufferType> Elements;
+    };
+
+    // Walk():
+    //
+    // Acquires the container and copies its elements into a new buffer.
+    //
+    std::shared_ptr<const BufferType> Walk() const
+    {
+        auto spElements = std::make_shared<BufferType>();
+        auto&& container = m_spState->AcquireContainer();
+        for (auto&& element : container)
+        {
+            spElements->push_back(element);
+        }
+        return spElements;
+    }
+
+    std::shared_ptr<State> m_spState;
+};
+
+template<typename TValue>
+class ValueWithMetadata
+{
+public:
+
+    using ValueType = TValue;
+
+    ValueWithMetadata() = default;
+
+    ValueWithMetadata(_In_ const TValue &value, _In_ Metadata metadata) :
+        m_value(value),
+        m_metadata(std::move(metadata))
+    {
+    }
+    ValueWithMetadata(TValue&& value, Metadata metadata) :
+        m_value(std::move(value)),
+        m_metadata(std::move(metadata))
+    {
+    }
+
+    ValueWithMetadata(_In_ const ValueWithMetadata& src) = default;
+    ValueWithMetadata(_In_ ValueWithMetadata&& src) = default;
+
+    ValueWithMetadata& operator=(_In_ const ValueWithMetadata& src) = default;
+    ValueWithMetadata& operator=(_In_ ValueWithMetadata&& src) = default;
+
+    const ValueType& GetValue() const { return m_value; }
+    ValueType& GetValue() { return m_value; }
+    const Metadata& GetMetadata() const { return m_metadata; }
+    Metadata& GetMetadata() { return m_metadata; }
+
+private:
+
+    ValueType m_value;
+    Metadata m_metadata;
+};
+
+// DeconstructionSink:
+//
+// Receives the deconstruction of an object one argument at a time (see Object::Deconstruct(DeconstructionSink&)).
+// BeginDeconstruction is called once, then Argument is called for each of the argCount arguments in order, then
+// EndDeconstruction is called.  An argument which is itself deconstructable is passed as an object; it is not
+// deconstructed on the sink's behalf.
+//
+class DeconstructionSink
+{
+public:
+
+    virtual ~DeconstructionSink() = default;
+
+    virtual void BeginDeconstruction(_In_z_ const wchar_t *pConstructableModel, _In_ ULONG64 argCount) = 0;
+    virtual void Argument(_In_ ULONG64 index, _In_ const Object& argument) = 0;
+    virtual void EndDeconstruction() = 0;
+};
+
+// Deconstruction:
+//
+// Represents the deconstruction of an object from the deconstructable concept.  It is effectively a
+// "limited serialization" of the object.
+//
+class Deconstruction
+{
+public:
+
+    Deconstruction(_In_z_ const wchar_t *pConstructableModel,
+                   _In_ ULONG64 argCount,
+                   _In_reads_(argCount) IModelObject **ppArguments) :
+        m_constructableModel(pConstructableModel),
+        m_arguments(ppArguments, ppArguments + argCount)
+    {
+    }
+
+    Deconstruction(_In_ std::wstring constructableModel,
+                   _In_ std::vector<Object> arguments) :
+        m_constructableModel(std::move(constructableModel)),
+        m_arguments(std::move(arguments))
+    {
+    }
+
+    using iterator = std::vector<Object>::iterator;
+    using const_iterator = std::vector<Object>::const_iterator;
+
+    const std::wstring& GetConstructableModelName() const { return m_constructableModel; }
+    iterator begin() { return m_arguments.begin(); }
+    iterator end() { return m_arguments.end(); }
+    const_iterator begin() const { return m_arguments.begin(); }
+    const_iterator end() const { return m_arguments.end(); }
+
+    // ConstructInstance():
+    //
+    // Constructs a new instance of the original object from the deconstructed set of arguments.
+    //
+    Object ConstructInstance()
+    {
+        Object model = Object::FromModelName(m_constructableModel);
+        return model.ConstructInstance(*this);
+    }
+
+private:
+
+    friend class Object;
+
+    std::wstring m_constructableModel;
+    std::vector<Object> m_arguments;
+
+};
+
+// IncrementalConstruction:
+//
+// Gathers the constructor arguments for a constructable model one at a time and then constructs the instance.
+// Nothing beyond the arguments themselves is held.  The arguments are released once the instance is constructed.
+//
+class IncrementalConstruction
+{
+public:
+
+    IncrementalConstruction(_In_ std::wstring constructableModel, _In_ ULONG64 argCount) :
+        m_constructableModel(std::move(constructableModel)),
+        m_argCount(argCount),
+        m_added(0)
+    {
+        if (argCount > static_cast<size_t>(-1) / sizeof(Object))
+        {
+            throw std::invalid_argument("Too many arguments for an incremental construction");
+        }
+        m_pack.reset(new Object[static_cast<size_t>(argCount)]);
+    }
+
+    const std::wstring& GetConstructableModelName() const { return m_constructableModel; }
+    ULONG64 GetArgumentCount() const { return m_argCount; }
+
+    // AddArgument():
+    //
+    // Supplies the next constructor argument.
+    //
+    void AddArgument(_In_ Object argument)
+    {
+        if (m_added >= m_argCount)
+        {
+            throw std::out_of_range("Too many arguments supplied to an incremental construction");
+        }
+        m_pack[static_cast<size_t>(m_added++)] = std::move(argument);
+    }
+
+    // ConstructInstance():
+    //
+    // Constructs the instance once every argument has been supplied.
+    //
+    Object ConstructInstance()
+    {
+        if (m_added != m_argCount)
+        {
+            throw illegal_operation("An incremental construction is missing arguments");
+        }
+
+        Object model = Object::FromModelName(m_constructableModel);
+        ComPtr<IConstructableConcept> spConstructable;
+        CheckHr(model->GetConcept(__uuidof(IConstructableConcept), &spConstructable, nullptr));
+
+        ComPtr<IModelObject> spInstance;
+        CheckHr(spConstructable->CreateInstance(m_argCount, reinterpret_cast<IModelObject **>(m_pack.get()), &spInstance));
+
+        m_pack.reset();
+        m_added = 0;
+        m_argCount = 0;
+        return Object(std::move(spInstance));
+    }
+
+private:
+
+    std::wstring m_constructableModel;
+    ULONG64 m_argCount;
+    ULONG64 m_added;
+    Details::ParameterPack m_pack;
+};
+
+namespace Details
+{
+    // DeconstructionSinkAdapter:
+    //
+    // Passes the arguments from an IStreamingDeconstructableConcept to a DeconstructionSink.  An exception thrown
+    // by the sink is held so that it can be rethrown as is once the call through the concept returns.
+    //
+    class DeconstructionSinkAdapter :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IDeconstructionArgumentSink
+            >
+    {
+    public:
+
+        DeconstructionSinkAdapter(_In_z_ const wchar_t *pConstructableModel, _In_ DeconstructionSink *pSink) :
+            m_pConstructableModel(pConstructableModel),
+            m_pSink(pSink),
+            m_argCount(0),
+            m_begun(false)
+        {
+        }
+
+        //*************************************************
+        // IDeconstructionArgumentSink:
+        //
+
+        IFACEMETHOD(SetArgumentCount)(_In_ ULONG64 argCount)
+        {
+            if (m_begun)
+            {
+                return E_ILLEGAL_METHOD_CALL;
+            }
+
+            return Invoke([&]()
+            {
+                m_pSink->BeginDeconstruction(m_pConstructableModel, argCount);
+                m_argCount = argCount;
+                m_begun = true;
+            });
+        }
+
+        IFACEMETHOD(SetArgument)(_In_ ULONG64 index, _In_ IModelObject *pArgument)
+        {
+            if (!m_begun || index >= m_argCount)
+            {
+                return E_BOUNDS;
+            }
+
+            return Invoke([&]()
+            {
+                ObjectView argument(pArgument);
+                m_pSink->Argument(index, argument);
+            });
+        }
+
+        //*************************************************
+        // Internal Methods:
+        //
+
+        bool HasBegun() const
+        {
+            return m_begun;
+        }
+
+        void RethrowIfThrown() const
+        {
+            if (m_thrown)
+            {
+                std::rethrow_exception(m_thrown);
+            }
+        }
+
+    private:
+
+        template<typename TFunc>
+        HRESULT Invoke(_In_ TFunc&& func)
+        {
+            try
+            {
+                func();
+            }
+            catch(...)
+            {
+                m_thrown = std::current_exception();
+                return Exceptions::ReturnResult(m_thrown);
+            }
+            return S_OK;
+        }
+
+        const wchar_t *m_pConstructableModel;
+        DeconstructionSink *m_pSink;
+        ULONG64 m_argCount;
+        bool m_begun;
+        std::exception_ptr m_thrown;
+    };
+
+    // DeconstructionCollector:
+    //
+    // A sink which collects a deconstruction into a Deconstruction.
+    //
+    class DeconstructionCollector : public DeconstructionSink
+    {
+    public:
+
+        void BeginDeconstruction(_In_z_ const wchar_t *pConstructableModel, _In_ ULONG64 argCount) override
+        {
+            m_constructableModel = pConstructableModel;
+            m_arguments.reserve(static_cast<size_t>(argCount));
+        }
+
+        void Argument(_In_ ULONG64 /*index*/, _In_ const Object& argument) override
+        {
+            m_arguments.push_back(argument);
+        }
+
+        void EndDeconstruction() override
+        {
+        }
+
+        Deconstruction TakeDeconstruction()
+        {
+            return Deconstruction(std::move(m_constructableModel), std::move(m_arguments));
+        }
+
+    private:
+
+        std::wstring m_constructableModel;
+        std::vector<Object> m_arguments;
+    };
+
+    // Deconstruction Stream Format:
+    //
+    // All integers are little endian.  A stream is a DeconstructionStreamHeader followed by any number of
+    // deconstruction records.  Each record starts with a ULONG tag (DeconstructionRecordTag):
+    //
+    //     Deconstruction: ULONG64 NameLength, wchar_t[NameLength] (the constructable model name), ULONG64 ArgCount,
+    //                     then ArgCount argument records
+    //     Intrinsic:      ULONG VariantType, then the value as the C++ type it boxes from (see
+    //                     DispatchSerializableIntrinsic)
+    //     String:         ULONG64 Length, wchar_t[Length]
+    //     NoValue:        (nothing)
+    //
+    // An argument which is itself deconstructable is written as a nested deconstruction record and is
+    // constructed again when it is read.
+    //
+    constexpr ULONG DeconstructionStreamMagic = 0x43444244;      // 'DBDC'
+    constexpr ULONG DeconstructionStreamVersion = 1;
+
+    struct DeconstructionStreamHeader
+    {
+        ULONG Magic;
+        ULONG Version;
+    };
+
+    enum class DeconstructionRecordTag : ULONG
+    {
+        Deconstruction = 1,
+        Intrinsic = 2,
+        String = 3,
+        NoValue = 4
+    };
+
+    // DispatchSerializableIntrinsic():
+    //
+    // Calls func with a default value of the C++ type which boxes to the given variant type.  Throws if the
+    // variant type cannot be serialized.
+    //
+    template<typename TFunc>
+    void DispatchSerializableIntrinsic(_In_ VARTYPE vt, _In_ TFunc&& func)
+    {
+        switch(vt)
+        {
+            case VT_I1: func(char()); break;
+            case VT_UI1: func((unsigned char)0); break;
+            case VT_I2: func(short()); break;
+            case VT_UI2: func((unsigned short)0); break;
+            case VT_I4: func(int()); break;
+            case VT_UI4: func((unsigned int)0); break;
+            case VT_I8: func(__int64()); break;
+            case VT_UI8: func((unsigned __int64)0); break;
+            case VT_R4: func(float()); break;
+            case VT_R8: func(double()); break;
+            case VT_BOOL: func(bool()); break;
+            default:
+                throw std::invalid_argument("Deconstruction argument is an intrinsic which cannot be serialized");
+        }
+    }
+}
+
+// DeconstructionWriter:
+//
+// Serializes deconstructions into a binary stream (see Details::DeconstructionStreamHeader) which is passed to the
+// write function in pieces as it is produced.  Intrinsic and string arguments are written as values.  Arguments
+// which are themselves deconstructable are written as nested deconstructions.  Any other argument cannot be
+// serialized and will throw.  No more than one level of arguments is alive at a time.
+//
+class DeconstructionWriter : public DeconstructionSink
+{
+public:
+
+    using WriteFunction = std::function<void(_In_reads_bytes_(size) const void *pData, _In_ size_t size)>;
+
+    DeconstructionWriter(_In_ WriteFunction writeFunction) :
+        m_write(std::move(writeFunction)),
+        m_wroteRecord(false),
+        m_failed(false)
+    {
+        Details::DeconstructionStreamHeader header = { Details::DeconstructionStreamMagic, Details::DeconstructionStreamVersion };
+        WriteValue(header);
+    }
+
+    // Write():
+    //
+    // Deconstructs the object and writes it to the stream.  If this throws after any of the deconstruction was passed
+    // to the write function, that part is not taken back.  The stream does not record the length of each
+    // deconstruction, so a reader cannot skip that partial record and the stream is unusable: every later Write()
+    // throws illegal_operation.  If this throws before anything was written (e.g.: the object is not
+    // deconstructable), the stream is unaffected.
+    //
+    void Write(_In_ Object& object)
+    {
+        if (m_failed)
+        {
+            throw illegal_operation("The stream holds a partially written deconstruction");
+        }
+        if (!m_remaining.empty())
+        {
+            throw illegal_operation("A deconstruction is already being written");
+        }
+
+        m_wroteRecord = false;
+        try
+        {
+            object.Deconstruct(*this);
+        }
+        catch(...)
+        {
+            m_remaining.clear();
+            m_failed = m_wroteRecord;
+            throw;
+        }
+    }
+
+    //*************************************************
+    // DeconstructionSink:
+    //
+
+    void BeginDeconstruction(_In_z_ const wchar_t *pConstructableModel, _In_ ULONG64 argCount) override
+    {
+        WriteValue(Details::DeconstructionRecordTag::Deconstruction);
+        WriteString(pConstructableModel, wcslen(pConstructableModel));
+        WriteValue(argCount);
+        m_remaining.push_back(argCount);
+    }
+
+    void Argument(_In_ ULONG64 /*index*/, _In_ const Object& argument) override
+    {
+        if (m_remaining.empty() || m_remaining.back() == 0)
+        {
+            throw illegal_operation("Deconstruction argument written outside its arguments");
+        }
+        --m_remaining.back();
+
+        ComPtr<IDeconstructableConcept> spDeconstructable;
+        if (SUCCEEDED(argument->GetConcept(__uuidof(IDeconstructableConcept), &spDeconstructable, nullptr)))
+        {
+            Object nestedObject = argument;
+            nestedObject.Deconstruct(*this);
+            return;
+        }
+
+        ModelObjectKind mk = argument.GetKind();
+        if (mk == ObjectNoValue)
+        {
+            WriteValue(Details::DeconstructionRecordTag::NoValue);
+            return;
+        }
+        else if (mk != ObjectIntrinsic)
+        {
+            throw std::invalid_argument("Deconstruction argument is neither an intrinsic nor deconstructable");
+        }
+
+        VARIANT vtValue;
+        CheckHr(argument->GetIntrinsicValue(&vtValue));
+        VARTYPE vt = vtValue.vt;
+        VariantClear(&vtValue);
+
+        if (vt == VT_BSTR)
+        {
+            std::wstring str = argument.As<std::wstring>();
+            WriteValue(Details::DeconstructionRecordTag::String);
+            WriteString(str.c_str(), str.size());
+            return;
+        }
+
+        Details::DispatchSerializableIntrinsic(vt, [&](auto defaultValue)
+        {
+            using TValue = decltype(defaultValue);
+            TValue value = argument.As<TValue>();
+            WriteValue(Details::DeconstructionRecordTag::Intrinsic);
+            WriteValue(static_cast<ULONG>(vt));
+            WriteValue(value);
+        });
+    }
+
+    void EndDeconstruction() override
+    {
+        if (m_remaining.empty() || m_remaining.back() != 0)
+        {
+            throw illegal_operation("Deconstruction ended before all of its arguments were written");
+        }
+        m_remaining.pop_back();
+    }
+
+private:
+
+    template<typename T>
+    void WriteValue(_In_ const T& value)
+    {
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteString(_In_reads_(length) const wchar_t *pString, _In_ size_t length)
+    {
+        WriteValue(static_cast<ULONG64>(length));
+        if (length > 0)
+        {
+            WriteBytes(pString, length * sizeof(wchar_t));
+        }
+    }
+
+    void WriteBytes(_In_reads_bytes_(size) const void *pData, _In_ size_t size)
+    {
+        m_wroteRecord = true;
+        m_write(pData, size);
+    }
+
+    WriteFunction m_write;
+
+    // The number of arguments yet to be written for each deconstruction being written (outermost first).
+    std::vector<ULONG64> m_remaining;
+
+    // Whether the current Write() has passed anything to the write function.
+    bool m_wroteRecord;
+
+    // Whether a Write() failed and left a partial deconstruction in the stream.
+    bool m_failed;
+};
+
+// DeconstructionReadLimits:
+//
+// Bounds on what a DeconstructionReader accepts from a stream.  Counts and lengths in the stream are checked against
+// these before anything is allocated for them so that a corrupt or truncated stream cannot cause an unbounded
+// allocation or recursion.
+//
+struct DeconstructionReadLimits
+{
+    // The maximum number of arguments of a single deconstruction.
+    ULONG64 MaxArguments = 65536;
+
+    // The maximum length (in characters) of a constructable model name or string argument.
+    ULONG64 MaxStringLength = 1048576;
+
+    // The maximum nesting of deconstructions within the arguments of others (the outermost is at depth one).
+    ULONG MaxDepth = 64;
+};
+
+// DeconstructionReader:
+//
+// Reads a stream written by DeconstructionWriter from the read function and constructs the objects it describes.
+// The read function must fill the entire buffer or throw.  Nested deconstructions are constructed as soon as their
+// arguments have been read.  Only the arguments of the deconstructions between the outermost one and the current
+// one are alive at a time.  A stream which exceeds the read limits is rejected as corrupt.
+//
+class DeconstructionReader
+{
+public:
+
+    using ReadFunction = std::function<void(_Out_writes_bytes_all_(size) void *pBuffer, _In_ size_t size)>;
+
+    DeconstructionReader(_In_ ReadFunction readFunction, _In_ const DeconstructionReadLimits& limits = DeconstructionReadLimits()) :
+        m_read(std::move(readFunction)),
+        m_limits(limits),
+        m_headerRead(false),
+        m_depth(0)
+    {
+    }
+
+    // ConstructInstance():
+    //
+    // Reads the next deconstruction from the stream and constructs it.
+    //
+    Object ConstructInstance()
+    {
+        if (!m_headerRead)
+        {
+            auto header = ReadValue<Details::DeconstructionStreamHeader>();
+            if (header.Magic != Details::DeconstructionStreamMagic || header.Version != Details::DeconstructionStreamVersion)
+            {
+                throw std::invalid_argument("The stream is not a serialized deconstruction");
+            }
+            m_headerRead = true;
+        }
+
+        if (ReadValue<Details::DeconstructionRecordTag>() != Details::DeconstructionRecordTag::Deconstruction)
+        {
+            throw std::invalid_argument("Serialized deconstruction is corrupt");
+        }
+
+        m_depth = 0;
+        return ReadDeconstruction();
+    }
+
+private:
+
+    Object ReadDeconstruction()
+    {
+        if (m_depth >= m_limits.MaxDepth)
+        {
+            throw std::invalid_argument("Serialized deconstruction is nested too deeply");
+        }
+
+        std::wstring constructableModel = ReadString();
+        ULONG64 argCount = ReadValue<ULONG64>();
+        if (argCount > m_limits.MaxArguments)
+        {
+            throw std::invalid_argument("Serialized deconstruction has too many arguments");
+        }
+
+        ++m_depth;
+        IncrementalConstruction construction(std::move(constructableModel), argCount);
+        for (ULONG64 i = 0; i < argCount; ++i)
+        {
+            construction.AddArgument(ReadArgument());
+        }
+        --m_depth;
+        return construction.ConstructInstance();
+    }
+
+    Object ReadArgument()
+    {
+        switch(ReadValue<Details::DeconstructionRecordTag>())
+        {
+            case Details::DeconstructionRecordTag::Deconstruction:
+                return ReadDeconstruction();
+
+            case Details::DeconstructionRecordTag::String:
+                return BoxObject(ReadString());
+
+            case Details::DeconstructionRecordTag::NoValue:
+                return Object::CreateNoValue();
+
+            case Details::DeconstructionRecordTag::Intrinsic:
+            {
+                ULONG variantType = ReadValue<ULONG>();
+                if (variantType > static_cast<VARTYPE>(-1))
+                {
+                    throw std::invalid_argument("Serialized deconstruction is corrupt");
+                }
+
+                VARTYPE vt = static_cast<VARTYPE>(variantType);
+                Object value;
+                Details::DispatchSerializableIntrinsic(vt, [&](auto defaultValue)
+                {
+                    using TValue = decltype(defaultValue);
+                    value = BoxObject(ReadValue<TValue>());
+                });
+                return value;
+            }
+        }
+
+        throw std::invalid_argument("Serialized deconstruction is corrupt");
+    }
+
+    template<typename T>
+    T ReadValue()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            //
+            // Any byte other than zero or one is not a valid bool.
+            //
+            unsigned char byteValue = ReadValue<unsigned char>();
+            if (byteValue > 1)
+            {
+                throw std::invalid_argument("Serialized deconstruction is corrupt");
+            }
+            return byteValue != 0;
+        }
+        else
+        {
+            T value;
+            m_read(&value, sizeof(T));
+            return value;
+        }
+    }
+
+    std::wstring ReadString()
+    {
+        ULONG64 length = ReadValue<ULONG64>();
+        if (length > m_limits.MaxStringLength)
+        {
+            throw std::invalid_argument("Serialized deconstruction has a string which is too long");
+        }
+
+        std::wstring str(static_cast<size_t>(length), L'\0');
+        if (length > 0)
+        {
+            m_read(&str[0], static_cast<size_t>(length) * sizeof(wchar_t));
+        }
+        return str;
+    }
+
+    ReadFunction m_read;
+    DeconstructionReadLimits m_limits;
+    bool m_headerRead;
+    ULONG m_depth;
+};
+
+
+//
+// ResourceString:
+//
+// A string which is dynamically pulled from the resources of the binary containing the header.
+// A ResourceString is pulled from the resource file immediately upon boxing.
+//
+struct ResourceString
+{
+    explicit ResourceString(_In_ ULONG id) : Id(id),
+                                             ResourceType(nullptr),
+                                             Module(nullptr)
+    { }
+
+    ResourceString(_In_ ULONG id, _In_ PCWSTR resourceType) : Id(id),
+                                                              ResourceType(resourceType),
+                                                              Module(nullptr)
+    { }
+
+    ResourceString(_In_ ULONG id, _In_ HMODULE hModule) : Id(id),
+                                                          ResourceType(nullptr),
+                                                          Module(hModule)
+    { }
+
+    ResourceString(_In_ ULONG id,
+                   _In_ PCWSTR resourceType,
+                   _In_ HMODULE hModule) : Id(id),
+                                           ResourceType(resourceType),
+                                           Module(hModule)
+    { }
+
+    ResourceString(_In_ const ResourceString& src) : Id(src.Id),
+                                                     ResourceType(src.ResourceType),
+                                                     Module(src.Module)
+    { }
+
+    ULONG Id;
+    PCWSTR ResourceType;
+    HMODULE Module;
+};
+
+//
+// DeferredResourceString:
+//
+// A string which is dynamically pulled from the resources of the binary containing the header.
+// A DeferredResourceString is boxes into a property accessor which pulls from the resource
+// string upon being fetched.
+//
+struct DeferredResourceString : public ResourceString
+{
+    template<typename... TArgs> DeferredResourceString(TArgs&&... args) : ResourceString(std::forward<TArgs>(args)...) { }
+};
+
+//
+// SharedArrayView:
+//
+// A read-only view of Size elements of T at Data whose storage is kept alive by Storage.  Boxing a SharedArrayView
+// produces an iterable and indexable array which reads directly from that storage rather than copying it.
+//
+template<typename T>
+struct SharedArrayView
+{
+    SharedArrayView(_In_ std::shared_ptr<const T[]> spArray, _In_ size_t size) :
+        Data(spArray.get()),
+        Size(size),
+        Storage(std::move(spArray))
+    { }
+
+    SharedArrayView(_In_reads_(size) const T *pData, _In_ size_t size, _In_ std::shared_ptr<const void> spStorage) :
+        Data(pData),
+        Size(size),
+        Storage(std::move(spStorage))
+    { }
+
+#if _HAS_CXX20
+    SharedArrayView(_In_ std::span<const T> data, _In_ std::shared_ptr<const void> spStorage) :
+        Data(data.data()),
+        Size(data.size()),
+        Storage(std::move(spStorage))
+    { }
+#endif // _HAS_CXX20
+
+    // SharedArrayView:
+    //
+    // Adopts the storage of the vector.
+    //
+    explicit SharedArrayView(_In_ std::vector<T>&& data)
+    {
+        static_assert(!std::is_same_v<T, bool>, "std::vector<bool> has no contiguous storage to adopt");
+        auto spVector = std::make_shared<const std::vector<T>>(std::move(data));
+        Data = spVector->data();
+        Size = spVector->size();
+        Storage = std::move(spVector);
+    }
+
+    const T *Data;
+    size_t Size;
+    std::shared_ptr<const void> Storage;
+};
+
+//
+// ResourceStringCache:
+//
+// A process wide cache of the strings extracted for ResourceString and DeferredResourceString boxing.  Each
+// (module, id, resource type) is pulled from the binary's resources once rather than going through the loader
+// on every box.
+//
+// The boxed string objects can optionally be cached as well.  Such objects hold references into the data model.
+// A client which enables this must call Clear() before its reference to the data model manager is released
+// (e.g.: as the extension uninitializes).
+//
+class ResourceStringCache
+{
+public:
+
+    ResourceStringCache(_In_ const ResourceStringCache&) =delete;
+    ResourceStringCache& operator=(_In_ const ResourceStringCache&) =delete;
+
+    // Instance():
+    //
+    // Returns the process wide cache.
+    //
+    static ResourceStringCache& Instance()
+    {
+        static ResourceStringCache s_cache;
+        return s_cache;
+    }
+
+    // GetString():
+    //
+    // Returns the string for the given resource, pulling it from the binary on first request.
+    //
+    std::shared_ptr<const std::wstring> GetString(_In_ const ResourceString& rscString)
+    {
+        Key key = MakeKey(rscString);
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto it = m_entries.find(key);
+            if (it != m_entries.end())
+            {
+                return it->second.String;
+            }
+        }
+
+        //
+        // Do not hold the lock across the calls into the loader.  If two threads race on the same resource, the
+        // first insertion wins.
+        //
+        auto spString = std::make_shared<const std::wstring>(PullString(key.Module, rscString.Id, rscString.ResourceType));
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto result = m_entries.emplace(std::move(key), Entry { std::move(spString), Object() });
+        return result.first->second.String;
+    }
+
+    // GetBoxedString():
+    //
+    // Returns a boxed string object for the given resource.  If object caching is enabled, the same object is
+    // returned on each call.
+    //
+    Object GetBoxedString(_In_ const ResourceString& rscString);
+
+    // SetObjectCaching():
+    //
+    // Enables or disables caching of the boxed string objects.  Disabling object caching releases any objects
+    // which are presently cached.
+    //
+    void SetObjectCaching(_In_ bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_cacheObjects = enabled;
+        if (!enabled)
+        {
+            for (auto& entry : m_entries)
+            {
+                entry.second.BoxedString = Object();
+            }
+        }
+    }
+
+    // Clear():
+    //
+    // Drops everything in the cache.
+    //
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_entries.clear();
+    }
+
+private:
+
+    ResourceStringCache() { }
+
+    struct Key
+    {
+        HMODULE Module;
+        ULONG Id;
+        ULONG_PTR TypeId;           // The resource type if it is an integer resource (or 0 for the string table)
+        std::wstring TypeName;      // The resource type if it is named
+
+        bool operator==(_In_ const Key& rhs) const
+        {
+            return Module == rhs.Module && Id == rhs.Id && TypeId == rhs.TypeId && TypeName == rhs.TypeName;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(_In_ const Key& key) const
+        {
+            size_t hash = std::hash<void *>()(key.Module);
+            hash = hash * 31 + std::hash<ULONG>()(key.Id);
+            hash = hash * 31 + std::hash<ULONG_PTR>()(key.TypeId);
+            hash = hash * 31 + std::hash<std::wstring>()(key.TypeName);
+            return hash;
+        }
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<const std::wstring> String;
+        Object BoxedString;
+    };
+
+    // GetCurrentModule():
+    //
+    // Returns the handle of the binary containing the header.  The module cannot unload while code within it is
+    // executing so the reference count is left unchanged.
+    //
+    static HMODULE GetCurrentModule()
+    {
+        static HMODULE s_hModule = []()
+        {
+            HMODULE hModule;
+            if (!GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                   reinterpret_cast<LPCTSTR>(&ResourceStringCache::GetCurrentModule),
+                                   &hModule))
+            {
+                throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Unable to retrieve resource string");
+            }
+            return hModule;
+        }();
+        return s_hModule;
+    }
+
+    static Key MakeKey(_In_ const ResourceString& rscString)
+    {
+        Key key { rscString.Module != nullptr ? rscString.Module : GetCurrentModule(), rscString.Id, 0, std::wstring() };
+        if (rscString.ResourceType != nullptr)
+        {
+            if (IS_INTRESOURCE(rscString.ResourceType))
+            {
+                key.TypeId = reinterpret_cast<ULONG_PTR>(rscString.ResourceType);
+            }
+            else
+            {
+                key.TypeName = rscString.ResourceType;
+            }
+        }
+        return key;
+    }
+
+    // PullString():
+    //
+    // Pulls the string from the resources of the given module.
+    //
+    static std::wstring PullString(_In_ HMODULE hModule, _In_ ULONG id, _In_opt_ PCWSTR resourceType)
+    {
+        std::wstring extractedString;
+
+        if (resourceType == nullptr)
+        {
+            PWSTR pString;
+            INT result = ::LoadStringW(hModule, id, reinterpret_cast<PWSTR>(&pString), 0);
+            if (!result)
+            {
+                throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Unable to retrieve resource string");
+            }
+
+            extractedString.append(pString, static_cast<size_t>(result));
+        }
+        else
+        {
+            HRSRC resourceInfo = FindResourceW(hModule, MAKEINTRESOURCEW(id), resourceType);
+
+            if (resourceInfo == NULL)
+            {
+                throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Unable to retrieve find resource");
+            }
+
+            DWORD dwResourceSize = SizeofResource(hModule, resourceInfo);
+            if (dwResourceSize == 0)
+            {
+                throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Failed to get length of the resource");
+            }
+
+            HGLOBAL resourceHandle = LoadResource(hModule, resourceInfo);
+            if (resourceHandle == NULL)
+            {
+                throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Failed to load resource for module.");
+            }
+
+            LPWSTR data = static_cast<LPWSTR>(LockResource(resourceHandle));
+            if (data == nullptr)
+            {
+                throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Failed to lock resource");
+            }
+
+            DWORD cchData = dwResourceSize / sizeof(wchar_t);
+
+            // Check for a UTF-16 little endian byte-order mark and skip it if there is one
+            if ((cchData > 0) && (data[0] == 0xfeff))
+            {
+                data += 1;
+                cchData -= 1;
+
+                extractedString.assign(data, wcsnlen(data, cchData));
+            }
+            else
+            {
+                LPSTR stringData = reinterpret_cast<LPSTR>(data);
+                cchData = dwResourceSize;
+
+                extractedString = Details::StringUtils::GetWideString(stringData, strnlen(stringData, cchData));
+            }
+        }
+
+        return extractedString;
+    }
+
+    std::mutex m_lock;
+    bool m_cacheObjects = false;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+};
+
+//**************************************************************************
+// Private Implementation Details:
+//
+
+namespace Details
+{
+
+    //*************************************************
+    // Type Traits:
+    //
+    // Defines common traits for auto-boxing and auto-unboxing of intrinsic (and intrinsic-like) values.
+    //
+
+    template<typename TIntrinsic> struct BaseIntrinsicTypeTraits { };
+
+    template<> struct BaseIntrinsicTypeTraits<char>
+    {
+        static const VARTYPE VariantType = VT_I1;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<unsigned char>
+    {
+        static const VARTYPE VariantType = VT_UI1;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<short>
+    {
+        static const VARTYPE VariantType = VT_I2;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<unsigned short>
+    {
+        static const VARTYPE VariantType = VT_UI2;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<int>
+    {
+        static const VARTYPE VariantType = VT_I4;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<unsigned int>
+    {
+        static const VARTYPE VariantType = VT_UI4;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<long>
+    {
+        static const VARTYPE VariantType = VT_UI4;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<unsigned long>
+    {
+        static const VARTYPE VariantType = VT_UI4;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<__int64>
+    {
+        static const VARTYPE VariantType = VT_I8;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<unsigned __int64>
+    {
+        static const VARTYPE VariantType = VT_UI8;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<float>
+    {
+        static const VARTYPE VariantType = VT_R4;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<double>
+    {
+        static const VARTYPE VariantType = VT_R8;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<> struct BaseIntrinsicTypeTraits<bool>
+    {
+        static const VARTYPE VariantType = VT_BOOL;
+        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+    };
+
+    template<typename TIntrinsic> struct IntrinsicTypeTraits : public BaseIntrinsicTypeTraits<TIntrinsic>
+    {
+        static void FillVariant(VARIANT *pVar, TIntrinsic val)
+        {
+            VariantInit(pVar);
+            pVar->vt = BaseIntrinsicTypeTraits<TIntrinsic>::VariantType;
+            TIntrinsic *pVal = reinterpret_cast<TIntrinsic *>(&pVar->bVal);
+            *pVal = val;
+        }
+
+        static TIntrinsic ExtractFromVariant(VARIANT *pVar)
+        {
+            TIntrinsic *pVal = reinterpret_cast<TIntrinsic *>(&pVar->bVal);
+            return *pVal;
+        }
+    };
+
+    template<> struct IntrinsicTypeTraits<bool> : public BaseIntrinsicTypeTraits<bool>
+    {
+
+        static void FillVariant(VARIANT *pVar, bool val)
+        {
+            VariantInit(pVar);
+            pVar->vt = VT_BOOL;
+            VARIANT_BOOL *pVal = reinterpret_cast<VARIANT_BOOL *>(&pVar->boolVal);
+            *pVal = val ? VARIANT_TRUE : VARIANT_FALSE;
+        }
+
+        static bool ExtractFromVariant(VARIANT *pVar)
+        {
+            VARIANT_BOOL *pVal = reinterpret_cast<VARIANT_BOOL *>(&pVar->boolVal);
+            return *pVal == VARIANT_TRUE;
+        }
+    };
+
+    //*************************************************
+    // Trait Helpers for Boxing and Unboxing:
+    //
+
+    template<typename TRet, typename... TArgs, typename TClass>
+    auto GetFunctionType(_In_ TRet (TClass::*)(TArgs...) const) -> std::function<TRet(TArgs...)>;
+
+    template<typename TRet, typename... TArgs, typename TClass>
+    auto GetFunctionType(_In_ TRet (TClass::*)(TArgs...)) -> std::function<TRet(TArgs...)>;
+
+    template<size_t argNum, size_t i, typename TArg, typename... TArgs>
+    struct ArgumentTraitHelper : public ArgumentTraitHelper<argNum, i + 1, TArgs...> { };
+
+    template<size_t argNum, typename TArg, typename... TArgs>
+    struct ArgumentTraitHelper<argNum, argNum, TArg, TArgs...>
+    {
+        using ArgumentType = TArg;
+    };
+
+    template<typename TRet, typename... TArgs>
+    struct StdFunctionTraits
+    {
+        using ReturnType = TRet;
+        template<size_t i> struct ArgumentTraits : public ArgumentTraitHelper<i, 0, TArgs...> { };
+    };
+
+    template<typename TRet, typename... TArgs>
+    StdFunctionTraits<TRet, TArgs...> GetFunctionTraits(_In_ const std::function<TRet(TArgs...)>&);
+
+    //
+    // Boy wouldn't it be fun if I didn't have to workaround multiple bugs in the C++ compiler to get this to work.  It's
+    // a song and dance of moving code into and out of function bodies and sprinkling the pixie dust of typename around.
+    //
+    template<size_t i, typename TRet, typename... TArgs>
+    auto GetArgumentType(_In_ const std::function<TRet(TArgs...)>&)
+    {
+        using ArgumentType = typename StdFunctionTraits<TRet, TArgs...>::template ArgumentTraits<i>::ArgumentType;
+        using ValueType = std::remove_reference_t<ArgumentType>;
+
+        ValueType v{};
+        ArgumentType t = v;
+        return t;
+    }
+
+    template<typename TRet, typename... TArgs>
+    auto GetReturnType(_In_ const std::function<TRet(TArgs...)>&) -> TRet;
+
+    template<typename TRet, typename... TArgs> struct StdFunctionCountArguments;
+    template<typename TRet, typename... TArgs>
+    struct StdFunctionCountArguments<std::function<TRet(TArgs...)>>
+    {
+        static constexpr size_t ArgumentCount = sizeof...(TArgs);
+    };
+
+    template<typename TFunc>
+    struct FunctorTraits
+    {
+        using FunctionType = decltype(GetFunctionType(&TFunc::operator()));
+        using ReturnType = decltype(GetReturnType(FunctionType{}));
+        static constexpr size_t ArgumentCount = StdFunctionCountArguments<FunctionType>::ArgumentCount;
+
+        template<size_t i>
+        struct ArgumentType
+        {
+            using Type = decltype(GetArgumentType<i>(FunctionType{}));
+        };
+
+        template<size_t i> using ArgumentType_t = typename ArgumentType<i>::Type;
+    };
+
+    template<typename TRet, typename... TArgs>
+    struct FunctorTraits<TRet(*)(TArgs...)>
+    {
+        using FunctionType = std::function<TRet(TArgs...)>;
+        using ReturnType = TRet;
+        static constexpr size_t ArgumentCount = sizeof...(TArgs);
+
+        template<size_t i>
+        struct ArgumentType
+        {
+            using Type = decltype(GetArgumentType<i>(FunctionType{}));
+        };
+
+        template<size_t i> using ArgumentType_t = typename ArgumentType<i>::Type;
+    };
+
+    template<typename TClass, typename TRet, typename... TArgs>
+    struct ClassMethodTraits
+    {
+        using FunctionType = std::function<TRet(TArgs...)>;
+        using ReturnType = TRet;
+        static constexpr size_t ArgumentCount = sizeof...(TArgs);
+
+        template<size_t i>
+        struct ArgumentType
+        {
+            using Type = decltype(GetArgumentType<i>(FunctionType{}));
+        };
+
+        template<size_t i> using ArgumentType_t = typename ArgumentType<i>::Type;
+    };
+
+    template<typename TClass, typename TRet, typename... TArgs>
+    ClassMethodTraits<TClass, TRet, TArgs...> GetClassMethodTraits(_In_ TRet (TClass::*)(TArgs...));
+
+
+    //
+    // NOTE: The following multiple definitions of void_t (as priv_void_t1, _t2, etc...) are to work around
+    //       a compiler bug involving alias templates.  Without this, only the first has_* which uses the *void_t
+    //       will function correctly.
+    //
+    template<class ...> using priv_void_t1 = void;
+    template<class ...> using priv_void_t2 = void;
+    template<class ...> using priv_void_t3 = void;
+    template<class ...> using priv_void_t4 = void;
+    template<class ...> using priv_void_t5 = void;
+    template<class ...> using priv_void_t6 = void;
+
+    template<class, class = priv_void_t1<> > struct has_call_operator : std::false_type { };
+    template<class T> struct has_call_operator<T, priv_void_t1<decltype(&T::operator())>> : std::true_type { };
+    template<class T> constexpr bool has_call_operator_v = has_call_operator<T>::value;
+
+    template<class, typename TArg, class = priv_void_t2<> > struct has_box_method : std::false_type { };
+    template<class T, typename TArg> struct has_box_method<T, TArg, priv_void_t2<decltype(T::Box(std::declval<TArg>()))>> : std::true_type { };
+    template<class T, typename TArg> constexpr bool has_box_method_v = has_box_method<T, TArg>::value;
+
+    template<class, class = priv_void_t3<> > struct has_unbox_method : std::false_type { };
+    template<class T> struct has_unbox_method<T, priv_void_t3<decltype(&T::Unbox)>> : std::true_type { };
+    template<class T> constexpr bool has_unbox_method_v = has_unbox_method<T>::value;
+
+    template<class, class = priv_void_t6<> > struct has_varianttype_field : std::false_type { };
+    template<class T> struct has_varianttype_field<T, priv_void_t6<decltype(T::VariantType)>> : std::true_type { };
+    template<class T> constexpr bool has_varianttype_field_v = has_varianttype_field<T>::value;
+
+    template<typename T> struct ArrayTraits
+    {
+        using Type = T;
+        static constexpr size_t Size = 0;
+    };
+
+    template<typename T, size_t N>
+    struct ArrayTraits<T[N]>
+    {
+        using Type = T;
+        static constexpr size_t Size = N;
+    };
+
+    template<typename T> using ArrayTraits_t = typename ArrayTraits<T>::Type;
+
+    template<typename T> struct MetadataTraits
+    {
+        static void FillMetadata(T const&, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            if (ppMetadata)
+            {
+                *ppMetadata = nullptr;
+            }
+        }
+    };
+
+    template<typename TVal> struct MetadataTraits<ValueWithMetadata<TVal>>
+    {
+        static void FillMetadata(ValueWithMetadata<TVal>& val, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            if (ppMetadata)
+            {
+                *ppMetadata = val.GetMetadata().Detach();
+            }
+        }
+
+        // For boxed arrays, metadata might end up copied out multiple times, rather than being a transient object that can be detached
+        static void FillMetadata(ValueWithMetadata<TVal> const& val, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            if (ppMetadata)
+            {
+                *ppMetadata = val.GetMetadata();
+                val.GetMetadata()->AddRef();
+            }
+        }
+    };
+
+    // Enable IndexedValue<ValueWithMetadata<...>, ...>
+    template<typename TVal, typename... TIndices> struct MetadataTraits<IndexedValue<TVal, TIndices...>>
+    {
+        static void FillMetadata(IndexedValue<TVal, TIndices...>& val, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            MetadataTraits<TVal>::FillMetadata(val.GetValue(), ppMetadata);
+        }
+    };
+
+    template<typename T, typename = void> struct IsIterable : std::false_type { };
+    template<typename T> struct IsIterable<T, ClientEx::Details::priv_void_t4<decltype(std::declval<T>().begin()), decltype(std::declval<T>().end())>> : std::true_type { };
+
+    template<typename TCatTag> struct IsRandomAccessTag : std::false_type {};
+    template<> struct IsRandomAccessTag<std::random_access_iterator_tag> : std::true_type { };
+
+    template<typename T, typename = void> struct IsRandomAccessIterator : std::false_type { };
+    template<typename T> struct IsRandomAccessIterator<T, ClientEx::Details::priv_void_t5<typename std::iterator_traits<T>::iterator_category>> :
+        IsRandomAccessTag<typename std::iterator_traits<T>::iterator_category> { };
+
+    template<typename T> struct IsRandomAccessIterable : IsRandomAccessIterator<decltype(std::declval<T>().begin())> { };
+
+    template<typename T> constexpr bool IsIterable_v = IsIterable<T>::value;
+    template<typename T> constexpr bool IsRandomAccessTag_v = IsRandomAccessTag<T>::value;
+    template<typename T> constexpr bool IsRandomAccessIterator_v = IsRandomAccessIterator<T>::value;
+    template<typename T> constexpr bool IsRandomAccessIterable_v = IsRandomAccessIterable<T>::value;
+
+    template<typename TVal, typename TIter, bool IsRandom>
+    struct IndexerTraits
+    {
+        static bool CheckDimensions(_In_ ULONG64 dimensionality)
+        {
+            return dimensionality == 0;
+        }
+
+        static void FillIndexers(_In_ const TVal& /*val*/,
+                                 _In_ const TIter& /*itBegin*/,
+                                 _In_ const TIter& /*itCur*/,
+                                 _In_ ULONG64 /*dimensionality*/,
+                                 _Out_opt_ IModelObject ** /*ppIndexers*/)
+        {
+        }
+
+        static constexpr ULONG64 Dimensionality = 0;
+    };
+
+    //
+    // An iterable which returns IndexedValue<> is declaring that it **DIRECTLY** supports providing the indicies
+    // itself.
+    //
+    template<typename TIter, bool IsRandom, typename TVal, typename... TIndicies>
+    struct IndexerTraits<ClientEx::IndexedValue<TVal, TIndicies...>, TIter, IsRandom>
+    {
+        static bool CheckDimensions(_In_ ULONG64 dimensionality)
+        {
+            return (dimensionality == 0 || dimensionality == sizeof...(TIndicies));
+        }
+
+        static void FillIndexers(_In_ const ClientEx::IndexedValue<TVal, TIndicies...>& indexedValue,
+                                 _In_ const TIter& /*itBegin*/,
+                                 _In_ const TIter& /*itCur*/,
+                                 _In_ ULONG64 dimensionality,
+                                 _Out_writes_opt_(dimensionality) IModelObject **ppIndexers)
+        {
+            if (dimensionality == sizeof...(TIndicies))
+            {
+                auto pack = ClientEx::Details::PackTuple(indexedValue.GetIndicies());
+                for (ULONG64 i = 0; i < dimensionality; ++i)
+                {
+                    ppIndexers[i] = pack[static_cast<size_t>(i)].Detach();
+                }
+            }
+        }
+
+        static constexpr ULONG64 Dimensionality = sizeof...(TIndicies);
+    };
+
+    template<typename TVal, typename TIter>
+    struct IndexerTraits<TVal, TIter, true>
+    {
+        static bool CheckDimensions(_In_ ULONG64 dimensionality)
+        {
+            return (dimensionality == 0 || dimensionality == 1);
+        }
+
+        //
+        // The index is only boxed if the caller asked for it.  Callers which simply walk the values (the common
+        // case for a C++ range for loop) never pay for the creation of an index object.
+        //
+        static void FillIndexers(_In_ const TVal& /*val*/,
+                                 _In_ const TIter& itBegin,
+                                 _In_ const TIter& itCur,
+                                 _In_ ULONG64 dimensionality,
+                                 _Out_writes_opt_(dimensionality) IModelObject **ppIndexers)
+        {
+            if (dimensionality == 1)
+            {
+                ClientEx::Object idx;
+                idx = static_cast<ULONG64>(itCur - itBegin);
+                ppIndexers[0] = idx.Detach();
+            }
+        }
+
+        static const ULONG64 Dimensionality = 1;
+    };
+
+    //*************************************************
+    // VarArgs unpack analysis:
+    //
+    // If the last two arguments to any method we bind to are
+    //
+    //     (size_t, Object *)
+    //
+    // the function is varargs. We unpack and type match the static types before
+    // the size_t, Object * and then put the remainder of the arguments in the
+    // list defined by those two arguments.
+    //
+    // These helpers analyze the type signature of a method to determine if it is
+    // a var args method and whether a given position is the var args position.
+    //
+
+    // bool IsVariableArgumentPosition_v<TArgs...>
+    //     determines whether the position at TArgs is a variable argument position (a size_t, Object *) at the end of pack
+    //
+    // bool HasVariableArguments_v<TArgs...>
+    //     determines whether the pack contains a terminating (size_t, Object *) -- a signature of varargs
+
+    template<typename... TArgs> struct IsVariableArgumentPosition : public std::false_type { };
+    template<> struct IsVariableArgumentPosition<size_t, Object *> : public std::true_type { };
+    template<typename... TArgs> struct HasVariableArgumentHelper2;
+    template<typename TArg1, typename TArg2, typename... TArgs> struct HasVariableArgumentHelper2<TArg1, TArg2, TArgs...> : public HasVariableArgumentHelper2<TArg2, TArgs...> { };
+    template<typename TArg1, typename TArg2> struct HasVariableArgumentHelper2<TArg1, TArg2> : public IsVariableArgumentPosition<TArg1, TArg2> { };
+    template<size_t i, typename... TArgs> struct HasVariableArgumentHelper : public HasVariableArgumentHelper2<TArgs...> {};
+    template<typename... TArgs> struct HasVariableArgumentHelper<0, TArgs...> : public std::false_type { };
+    template<typename... TArgs> struct HasVariableArgumentHelper<1, TArgs...> : public std::false_type { };
+    template<typename... TArgs> struct HasVariableArguments : public HasVariableArgumentHelper<sizeof...(TArgs), TArgs...> {};
+
+    template<typename... TArgs> constexpr bool IsVariableArgumentPosition_v = IsVariableArgumentPosition<TArgs...>::value;
+    template<typename... TArgs> constexpr bool HasVariableArguments_v = HasVariableArguments<TArgs...>::value;
+
+    //*************************************************
+    // Optional unpack analysis:
+    //
+    // If any argument in the function is std::optional<T>, it is optional and does not need an
+    // argument in the incoming dynamic pack to bind against the static one.  This performs analysis
+    // to determine optional arguments, positions, and whether there is illegality (static arguments
+    // after optional ones)
+    //
+
+    // bool IsOptionalArgument_v<T>
+    //     true iff T is std::optional<TOpt>
+    //
+    // bool IsNonOptionalARgument_v<T>
+    //     true iff T is not std::optional<TOpt>
+
+    template<typename T> struct IsOptionalArgument : public std::false_type { };
+    template<typename TOpt> struct IsOptionalArgument<std::optional<TOpt>> : public std::true_type { };
+    template<typename T> struct IsNonOptionalArgument : public std::true_type { };
+    template<typename TOpt> struct IsNonOptionalArgument<std::optional<TOpt>> : public std::false_type { };
+
+    template<typename T> constexpr bool IsOptionalArgument_v = IsOptionalArgument<T>::value;
+    template<typename T> constexpr bool IsNonOptionalArgument_v = IsNonOptionalArgument<T>::value;
+
+    // bool HasNonOptionalArguments_v<TArgs...>
+    //     determines whether the argument pack in TArgs contains a non optional argument.  That is, it contains a
+    //     non std::optional<TOpt> **UNLESS** that non optional argument is a final size_t, Object * in the
+    //     argument pack.
+
+    template<typename... TArgs> struct HasNonOptionalArguments : public std::true_type { };
+    template<typename T> struct HasNonOptionalArguments<T> : public IsNonOptionalArgument<T> { };
+    template<typename T, typename... TArgs> struct HasNonOptionalArguments<T, TArgs...>
+    {
+    private:
+
+        static constexpr bool GetHasNonOptional()
+        {
+            //
+            // If the argument set <T, TArgs...> is VarArgs (size_t, Object *) with nothing following, there are no non-optional arguments
+            //
+            if (IsVariableArgumentPosition_v<T, TArgs...>) { return false; }
+
+            //
+            // If the current argument is non-optional (we've already checked a VarArgs slot), we have non-optional arguments in the set.
+            //
+            if (IsNonOptionalArgument_v<T>) { return true; }
+
+            //
+            // Subsequently, everything is repeated recursively on TArgs... as an argument set.
+            //
+            return HasNonOptionalArguments<TArgs...>::value;
+        }
+
+    public:
+
+        static constexpr bool value = GetHasNonOptional();
+    };
+    template<typename... TArgs> constexpr bool HasNonOptionalArguments_v = HasNonOptionalArguments<TArgs...>::value;
+
+    // bool HasOptionalArguments_v<TArgs...>
+    //     determines whether the argument pack contains a legal optional argument (one or more std::optional<TOpt>
+    //     arguments after which there are no non std::optional<TOpt> arguments unless those arguments are a varargs
+    //     pack -- a final size_t, Object *)
+    //
+    //     If there is a violation of ordering of the std::optional<TOpt>, this will fire a static assert.
+    //
+
+    template<typename... TArgs> struct HasOptionalArguments : public std::false_type { };
+    template<typename T> struct HasOptionalArguments<T> : public IsOptionalArgument<T> { };
+    template<typename T, typename... TArgs> struct HasOptionalArguments<T, TArgs...>
+    {
+    public:
+        static constexpr bool isCurrentOptional = IsOptionalArgument_v<T>;
+        static constexpr bool HasNextOptional()
+        {
+            constexpr bool nextOptional = HasOptionalArguments<TArgs...>::value;
+            constexpr bool allNextOptional = !HasNonOptionalArguments_v<TArgs...>;
+            static_assert(!isCurrentOptional || allNextOptional, "Any std::optional<T> must come before any non optional (or non varArgs) argument");
+            return nextOptional;
+        }
+
+    public:
+        static constexpr bool value = (isCurrentOptional | HasNextOptional());
+    };
+    template<typename... TArgs> constexpr bool HasOptionalArguments_v = HasOptionalArguments<TArgs...>::value;
+
+    // size_t FirstOptionalArgumentPosition_v<TArgs...>
+    //
+    // Gives the 0-based position of the first std::optional<T> within the pack.  If there is no such value, the
+    // size of the pack is returned in lieu.
+    //
+
+    template<size_t i, typename... TArgs> struct FirstOptionalArgumentPositionHelper : public std::integral_constant<size_t, i + sizeof...(TArgs)> { };
+    template<size_t i, typename T, typename... TArgs> struct FirstOptionalArgumentPositionHelper<i, T, TArgs...> : public FirstOptionalArgumentPositionHelper<i + 1, TArgs...> { };
+    template<size_t i, typename T> struct FirstOptionalArgumentPositionHelper<i, T> : public std::integral_constant<size_t, i + 1> { };
+    template<size_t i, typename TOpt> struct FirstOptionalArgumentPositionHelper<i, std::optional<TOpt>> : public std::integral_constant<size_t, i> { };
+    template<size_t i, typename TOpt, typename... TArgs> struct FirstOptionalArgumentPositionHelper<i, std::optional<TOpt>, TArgs...> : public std::integral_constant<size_t, i> { };
+    template<typename... TArgs> struct FirstOptionalArgumentPosition : public FirstOptionalArgumentPositionHelper<0, TArgs...> { };
+    template<typename... TArgs> constexpr size_t FirstOptionalArgumentPosition_v = FirstOptionalArgumentPosition<TArgs...>::value;
+
+    //*************************************************
+    // General unpack
+    //
+
+    // size_t PackMatchingSize_v<TArgs...>
+    //
+    // Computes how many static arguments we need to have within a dynamic argument set to statically bind against
+    // a given argument pack.
+    //
+    // In effect, this set of templates is looking at a C++ method signature which is comprised of three things:
+    //
+    //     - Some types T
+    //     - Some optional types, std::optional<T>
+    //     - VarArgs at the end (size_t, Object *)
+    //
+    // and determining how many *REQUIRED* arguments there are in order to make a call to the method from the data model.
+    // The number of required arguments is the number of types T that come before any optional argument or VarArgs position.
+    //
+    template<typename... TArgs> struct PackMatchingSize
+    {
+    private:
+
+        static constexpr size_t GetMatchingSize()
+        {
+            //
+            // If we have a std::optional<T>, we can stop there.  It is illegal to have static arguments
+            // after that.  If not, and we have variable arguments defined by (size_t, Object *) at the
+            // end, the position is the pack size minus two (for the two varargs "arguments")
+            //
+            constexpr bool hasOptional = HasOptionalArguments_v<TArgs...>;
+            constexpr bool hasVarArgs = HasVariableArguments_v<TArgs...>;
+
+            if (hasOptional)
+            {
+                return FirstOptionalArgumentPosition_v<TArgs...>;
+            }
+
+            if (hasVarArgs)
+            {
+                return sizeof...(TArgs) - 2;
+            }
+
+            return sizeof...(TArgs);
+        }
+
+    public:
+
+        static constexpr size_t value = GetMatchingSize();
+    };
+    template<typename... TArgs> constexpr size_t PackMatchingSize_v = PackMatchingSize<TArgs...>::value;
+
+    // size_t PackMatchingSize_WithIgnore_v<size_t ignoreCount, TArgs...>
+    //
+    // Ignores the first 'ignoreCount' arguments in TArgs... and then computes PackMatchingSize_v of the remaining
+    // argument pack.
+    //
+    template<size_t i, size_t ignoreCount, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper;
+    template<size_t i, size_t ignoreCount, typename TArg1, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper2 : public PackMatchingSize_WithIgnore_Helper<i + 1, ignoreCount, TArgs...> { };
+    template<size_t i, size_t ignoreCount, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper : public PackMatchingSize_WithIgnore_Helper2<i, ignoreCount, TArgs...> { };
+    template<size_t i, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper<i, i, TArgs...> : public PackMatchingSize<TArgs...> { };
+    template<size_t ignoreCount, typename... TArgs> struct PackMatchingSize_WithIgnore : public PackMatchingSize_WithIgnore_Helper<0, ignoreCount, TArgs...> { };
+    template<typename... TArgs> struct PackMatchingSize_WithIgnore<0, TArgs...> : public PackMatchingSize<TArgs...> { };
+    template<size_t ignoreCount, typename... TArgs> constexpr size_t PackMatchingSize_WithIgnore_v = PackMatchingSize_WithIgnore<ignoreCount, TArgs...>::value;
+
+    // Unpack helpers:
+
+    template<typename TTuple, size_t i, size_t remaining>
+    struct RegularUnpacker
+    {
+        static void UnpackInto(_In_ size_t packSize,
+                               _In_reads_(packSize) IModelObject **ppArgumentPack,
+                               TTuple& tuple);
+    };
+
+    template<typename TTuple, size_t i, size_t remaining> struct Unpacker : public RegularUnpacker<TTuple, i, remaining> { };
+
+    template<typename TTuple, size_t i, size_t remaining>
+    struct VariableUnpacker
+    {
+        static void UnpackInto(_In_ size_t packSize, _In_reads_(packSize) IModelObject **ppArgumentPack, TTuple& tuple)
+        {
+            if (i >= packSize)
+            {
+                return;
+            }
+
+            size_t variableArgumentCount = packSize - i;
+            std::get<i>(tuple) = variableArgumentCount;
+
+            //
+            // @TODO: Perhaps Object * isn't the right thing.  This reinterpret is *PROBABLY* safe given the structural
+            // requirements on Object (it must lay out in memory as a single IModelObject *.
+            //
+            std::get<i + 1>(tuple) = reinterpret_cast<Object *>(ppArgumentPack + i);
+        }
+    };
+
+    //
+    // If the last 2 arguments are a variable argument pack, perform a special packing.
+    //
+    template<typename TTuple, size_t i>
+    struct Unpacker<TTuple, i, 2> : std::conditional_t<IsVariableArgumentPosition_v<typename std::tuple_element_t<i, TTuple>, std::tuple_element_t<i + 1, TTuple>>, VariableUnpacker<TTuple, i, 2>, RegularUnpacker<TTuple, i, 2>>
+    {
+    };
+
+    template<typename TTuple, size_t i>
+    struct Unpacker<TTuple, i, 0>
+    {
+        static void UnpackInto(_In_ size_t /*packSize*/, _In_ IModelObject ** /*ppArgumentPack*/, TTuple& /*tuple*/)
+        {
+        }
+    };
+
+    template<size_t i, size_t extractCount, typename... TArgs> struct TupleTypeExtractorHelper;
+
+    template<size_t i, size_t extractCount, typename TArg1, typename... TArgs>
+    struct TupleTypeExtractorHelper2
+    {
+        using Type = typename TupleTypeExtractorHelper<i + 1, extractCount, TArgs...>::Type;
+    };
+
+    template<size_t i, size_t extractCount, typename... TArgs>
+    struct TupleTypeExtractorHelper
+    {
+        using Type = typename TupleTypeExtractorHelper2<i, extractCount, TArgs...>::Type;
+    };
+
+    template<size_t i, typename... TArgs>
+    struct TupleTypeExtractorHelper<i, i, TArgs...>
+    {
+        using Type = std::tuple<TArgs...>;
+    };
+
+    // TupleTypeExtractor:
+    //
+    // Removes the first 'extractCount' arguments from TArgs... and returns a tuple of said
+    // arguments.
+    //
+    template<size_t extractCount, typename... TArgs>
+    struct TupleTypeExtractor
+    {
+        using Type = typename TupleTypeExtractorHelper<0, extractCount, TArgs...>::Type;
+    };
+
+    template<typename... TArgs>
+    struct TupleTypeExtractor<0, TArgs...>
+    {
+        using Type = typename std::tuple<TArgs...>;
+    };
+
+    template<size_t tupleExtractionCount, typename... TArgs>
+    using TupleTypeExtractor_t = typename TupleTypeExtractor<tupleExtractionCount, TArgs...>::Type;
+
+    // UnpackedArgument:
+    //
+    // The type into which an argument for a bound function parameter of type TArg is unpacked.  Parameters which
+    // are taken as const Object& are unpacked into views which borrow the references held by the argument pack;
+    // all others are unpacked by value.
+    //
+    template<typename TArg> struct UnpackedArgument { using Type = std::decay_t<TArg>; };
+    template<> struct UnpackedArgument<const Object&> { using Type = ObjectView; };
+    template<typename TArg> using UnpackedArgument_t = typename UnpackedArgument<TArg>::Type;
+
+    // UnpackValues():
+    //
+    // Takes a model parameter pack and expands it out into a std::tuple with extraction by type
+    // as determined by the TArgs... types.  The first "tupleExtractionCount" arguments will be
+    // skipped when creating the tuple.
+    //
+    template<size_t tupleExtractionCount, typename... TArgs>
+    decltype(auto) UnpackValues(_In_ size_t packSize, _In_reads_(packSize) IModelObject **ppArgumentPack)
+    {
+        using ArgumentTypes = TupleTypeExtractor_t<tupleExtractionCount, UnpackedArgument_t<TArgs>...>;
+        ArgumentTypes tuple;
+        Unpacker<ArgumentTypes, 0, sizeof...(TArgs) - tupleExtractionCount>::UnpackInto(packSize, ppArgumentPack, tuple);
+        return tuple;
+    }
+
+//
+// @TODO: The compiler insists that 't' is unreferenced in the below.  It is not.  Remove the warning
+//        by pragma for now.
+//
+#pragma warning(push)
+#pragma warning(disable: 4100)
+
+    template <class F, class Tuple, std::size_t... I, typename... TExtraValues>
+    constexpr decltype(auto) ApplyImpl(F&& f,
+                                       const Object& contextObj,
+                                       Tuple&& t,
+                                       std::index_sequence<I...>,
+                                       TExtraValues&&... extraValues)
+    {
+        return std::invoke(std::forward<F>(f), contextObj, std::forward<TExtraValues>(extraValues)..., std::get<I>(std::forward<Tuple>(t))...);
+    }
+
+    // PassArgument():
+    //
+    // Passes an unpacked argument to a bound function parameter of type TParam.  Unless the parameter is a
+    // non-const lvalue reference, the unpacked value is moved into the call rather than copied.
+    //
+    template<typename TParam, typename TValue>
+    constexpr decltype(auto) PassArgument(TValue& value)
+    {
+        if constexpr(std::is_lvalue_reference_v<TParam> && !std::is_const_v<std::remove_reference_t<TParam>>)
+        {
+            return (value);
+        }
+        else
+        {
+            return std::move(value);
+        }
+    }
+
+    // ContextArgument_t:
+    //
+    // The type which holds the context object for a bound function parameter of type TParam.  A parameter which is
+    // a non-const lvalue reference is given an object of its own (which takes a reference on the context object) so
+    // that it has an lvalue to bind to.  Any other parameter is given a view which borrows the caller's reference.
+    //
+    template<typename TParam>
+    using ContextArgument_t = std::conditional_t<std::is_lvalue_reference_v<TParam> && !std::is_const_v<std::remove_reference_t<TParam>>,
+                                                 Object,
+                                                 ObjectView>;
+
+    // PassContextArgument():
+    //
+    // Passes the context object held by a ContextArgument_t to the bound function parameter.
+    //
+    inline const Object& PassContextArgument(_In_ const ObjectView& contextView)
+    {
+        return contextView.Get();
+    }
+
+    inline Object& PassContextArgument(_Inout_ Object& contextObject)
+    {
+        return contextObject;
+    }
+
+    template <class TParamTypes, class F, class Tuple, std::size_t... I, typename... TExtraValues>
+    constexpr decltype(auto) ApplyUnpackedImpl(F&& f,
+                                               const Object& contextObj,
+                                               Tuple& t,
+                                               std::index_sequence<I...>,
+                                               TExtraValues&&... extraValues)
+    {
+        return std::invoke(std::forward<F>(f), contextObj, std::forward<TExtraValues>(extraValues)...,
+                           PassArgument<std::tuple_element_t<I, TParamTypes>>(std::get<I>(t))...);
+    }
+
+    template <class F, class Tuple, std::size_t... I>
+    constexpr decltype(auto) LiteralApplyImpl(F&& f, Tuple&& t, std::index_sequence<I...>)
+    {
+        return std::invoke(std::forward<F>(f), std::get<I>(std::forward<Tuple>(t))...);
+    }
+
+    template<class T>
+    struct ConstructorApplyImpl
+    {
+        template<class Tuple, std::size_t... I>
+        static constexpr decltype(auto) Apply(Tuple&& t, std::index_sequence<I...>)
+        {
+            return T(std::get<I>(std::forward<Tuple>(t))...);
+        }
+    };
+
+    template <class F, class Tuple, typename... TExtraValues>
+    constexpr decltype(auto) Apply(F&& f, const Object& contextObj, Tuple&& t, TExtraValues&&... extraValues)
+    {
+        return ApplyImpl(
+            std::forward<F>(f), contextObj, std::forward<Tuple>(t),
+            std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{},
+            std::forward<TExtraValues>(extraValues)...);
+    }
+
+    // ApplyUnpacked():
+    //
+    // As Apply for a tuple of values unpacked from a data model argument pack which is consumed by the call.
+    // TParamTypes is a tuple of the declared types of the parameters which the tuple's values are passed to.
+    //
+    template <class TParamTypes, class F, class Tuple, typename... TExtraValues>
+    constexpr decltype(auto) ApplyUnpacked(F&& f, const Object& contextObj, Tuple& t, TExtraValues&&... extraValues)
+    {
+        return ApplyUnpackedImpl<TParamTypes>(
+            std::forward<F>(f), contextObj, t,
+            std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{},
+            std::forward<TExtraValues>(extraValues)...);
+    }
+
+    template <class F, class Tuple>
+    constexpr decltype(auto) LiteralApply(F&& f, Tuple&& t)
+    {
+        return LiteralApplyImpl(
+            std::forward<F>(f), std::forward<Tuple>(t),
+            std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{});
+    }
+
+    template <class T, class Tuple>
+    constexpr decltype(auto) ConstructorApply(Tuple&& t)
+    {
+        return ConstructorApplyImpl<T>::Apply(
+            std::forward<Tuple>(t),
+            std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{}
+            );
+    }
+
+#pragma warning(pop)
+
+    // InvokeAndBox():
+    //
+    // Calls a function with a tuple of arguments and boxes the return value into an Object.  The tuple is
+    // consumed: its values are moved into parameters (of the types in TParamTypes) which are taken by value.
+    //
+    template<typename TRet, typename TFunc, typename TTuple, typename TParamTypes = TTuple>
+    struct InvokeAndBox
+    {
+        template<typename... TExtraValues>
+        static Object Call(_In_ const TFunc& func,
+                           _In_ const Object& contextObj,
+                           _In_ TTuple& parameters,
+                           _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
+                           _In_ TExtraValues&&... extraValues)
+        {
+            TRet result = ApplyUnpacked<TParamTypes>(func, contextObj, parameters, std::forward<TExtraValues>(extraValues)...);
+            Object resultObject = BoxObject(std::move(result));
+            MetadataTraits<TRet>::FillMetadata(result, ppMetadata);
+            return resultObject;
+        }
+    };
+
+    // InvokeAndBox():
+    //
+    // Calls a void returning function with a tuple of arguments.  Boxes "NoValue" into an Object
+    // and returns it to represent the void value.
+    //
+    template<typename TFunc, typename TTuple, typename TParamTypes>
+    struct InvokeAndBox<void, TFunc, TTuple, TParamTypes>
+    {
+        template<typename... TExtraValues>
+        static Object Call(_In_ const TFunc& func,
+                           _In_ const Object& contextObj,
+                           _In_ TTuple& parameters,
+                           _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
+                           _In_ TExtraValues&&... extraValues)
+        {
+            ApplyUnpacked<TParamTypes>(func, contextObj, parameters, std::forward<TExtraValues>(extraValues)...);
+            if (ppMetadata)
+            {
+                *ppMetadata = nullptr;
+            }
+            ComPtr<IModelObject> spNoValue;
+            CheckHr(GetManager()->CreateNoValue(&spNoValue));
+            return Object(std::move(spNoValue));
+        }
+    };
+
+
+    // LiteralInvokeAndBox():
+    //
+    // Calls a function with a tuple of arguments and boxes the result into an Object.  This does not
+    // inject the usual "methods" signature bindings of the data model's "context object" and any such
+    // extra parameters.
+    //
+    template<typename TRet, typename TFunc, typename TTuple>
+    struct LiteralInvokeAndBox
+    {
+        static Object Call(_In_ const TFunc& func, _In_ const TTuple& parameters)
+        {
+            TRet result = LiteralApply(func, parameters);
+            Object resultObject = BoxObject(result);
+            return resultObject;
+        }
+    };
+
+    // ConstructAndBox:
+    //
+    // Calls a constructor and boxes the resulting object into an Object.
+    //
+    template<typename TInstance, typename TTuple>
+    struct ConstructAndBox
+    {
+        static Object Construct(_In_ const TTuple& arguments)
+        {
+            TInstance result = ConstructorApply(arguments);
+            Object resultObject = BoxObject(result);
+            return resultObject;
+        }
+
+    };
+
+    // InvokeFunctionFromPack:
+    //
+    // For a std::function<TRet(TArgs...), convert a dynamic set of arguments from the data model and
+    // a set of static additional arguments to the types within the TArgs... signature, call the function,
+    // and box the result.
+    //
+    // The expected signature of the function is TRet(const Object&, convert_if_possible<TExtraValues>..., convert_if_possible<UNPACK>)
+    //
+    template<typename TRet, typename... TArgs, typename... TExtraValues>
+    Object InvokeFunctionFromPack(_In_ const std::function<TRet(TArgs...)>& func,
+                                  _In_ const Object& contextObj,
+                                  _In_ size_t packSize,
+                                  _In_reads_(packSize) IModelObject **ppArgumentPack,
+                                  _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
+                                  _In_ TExtraValues&&... extraValues)
+
+    {
+        // We need to determine the minimum number of arguments which will correctly match against the incoming
+        // argument list.  The signature of the std::function must be Object&, TExtraValues(convertable)..., TArgs...
+        //
+        // There can be std::optional<T> arguments (which stops the mandatory static argument count)
+        // There can be VarArgs (a TArgs... which ends with size_t, Object *)
+        //
+
+        //
+        // Compute the minimum pack size via a helper:
+        //
+        constexpr size_t extraArgumentCount = sizeof...(extraValues);
+        constexpr size_t packIgnoreCount = extraArgumentCount + 1;          // + 1 == const Object& (instanceObject)
+        constexpr size_t minPackSize = PackMatchingSize_WithIgnore_v<packIgnoreCount, TArgs...>;
+
+        //
+        // Compute the maximum pack size (it's either the static size of the pack minus the ignore count or it's infinite
+        // (if we have varargs)
+        //
+        constexpr size_t maxStaticPack = sizeof...(TArgs) - packIgnoreCount;
+        constexpr bool isVarArgs = HasVariableArguments_v<TArgs...>;
+
+        //
+        // If the caller has not passed an argument list which can match the pack via size, immediately throw.
+        //
+        if (packSize < minPackSize || (packSize > maxStaticPack && !isVarArgs))
+        {
+            throw std::invalid_argument("Illegal number of arguments to method call");
+        }
+
+        auto parameters = UnpackValues<packIgnoreCount, TArgs...>(packSize, ppArgumentPack);
+        using ParameterTypes = TupleTypeExtractor_t<packIgnoreCount, TArgs...>;
+
+        return InvokeAndBox<TRet, decltype(func), decltype(parameters), ParameterTypes>::
+            template Call<TExtraValues...>(func, contextObj, parameters, ppMetadata, std::forward<TExtraValues>(extraValues)...);
+    }
+
+    // LiteralInvokeFunctionFromPack:
+    //
+    // For a std::function<TRet(TArgs...), convert a dynamic set of arguments from the data model to the types
+    // within the TArgs... signature, call the function, and box the result.
+    //
+    // The expected signature of the function is TRet(convert_if_possible<UNPACK>)
+    //
+    template<typename TRet, typename... TArgs>
+    Object LiteralInvokeFunctionFromPack(_In_ const std::function<TRet(TArgs...)>& func,
+                                         _In_ size_t packSize,
+                                         _In_reads_(packSize) IModelObject **ppArgumentPack)
+    {
+        // We need to determine the minimum number of arguments which will correctly match against the incoming
+        // argument list.  The signature of the std::function must be TArgs...
+        //
+        // There can be std::optional<T> arguments (which stops the mandatory static argument count)
+        // There can be VarArgs (a TArgs... which ends with size_t, Object *)
+        //
+
+        //
+        // Compute the minimum pack size via a helper:
+        //
+        constexpr size_t extraArgumentCount = 0;
+        constexpr size_t packIgnoreCount = extraArgumentCount + 0;
+        constexpr size_t minPackSize = PackMatchingSize_WithIgnore_v<packIgnoreCount, TArgs...>;
+
+        //
+        // Compute the maximum pack size (it's either the static size of the pack minus the ignore count or it's infinite
+        // (if we have varargs)
+        //
+        constexpr size_t maxStaticPack = sizeof...(TArgs) - packIgnoreCount;
+        constexpr bool isVarArgs = HasVariableArguments_v<TArgs...>;
+
+        //
+        // If the caller has not passed an argument list which can match the pack via size, immediately throw.
+        //
+        if (packSize < minPackSize || (packSize > maxStaticPack && !isVarArgs))
+        {
+            throw std::invalid_argument("Illegal number of arguments to method call");
+        }
+
+        auto parameters = UnpackValues<packIgnoreCount, TArgs...>(packSize, ppArgumentPack);
+        return LiteralInvokeAndBox<TRet, decltype(func), decltype(parameters)>::Call(func, parameters);
+    }
+
+    // InvokeMethodFromPack:
+    //
+    // Invokes a functor from a data model parameter pack matching all the static types.  In addition,
+    // passes a set of extra arguments as determined by TExtraValues... to the function.
+    //
+    template<typename TFunc, typename... TExtraValues>
+    Object InvokeMethodFromPack(_In_ const TFunc& func,
+                                _In_ const Object& contextObj,
+                                _In_ size_t packSize,
+                                _In_reads_(packSize) IModelObject **pArgumentPack,
+                                _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
+                                _In_ TExtraValues&&... extraValues)
+    {
+        return InvokeFunctionFromPack(FunctorTraits<TFunc>::FunctionType(func),
+                                      contextObj,
+                                      packSize,
+                                      pArgumentPack,
+                                      ppMetadata,
+                                      std::forward<TExtraValues>(extraValues)...);
+    }
+
+    //*************************************************
+    // Instance Data Packer:
+    //
+
+    template<typename TInstance, typename TType>
+    struct is_member_data_pointer_of : std::false_type { };
+
+    template<typename TInstance, typename TData>
+    struct is_member_data_pointer_of<TInstance, TData TInstance::*> : std::true_type { };
+
+    template<typename TInstance, typename TData>
+    constexpr bool is_member_data_pointer_of_v = is_member_data_pointer_of<TInstance, TData>::value;
+
+    template<typename TArg>
+    struct MemberPointerDataTypeExtractor
+    {
+    };
+
+    template<typename TInstance, typename TData>
+    struct MemberPointerDataTypeExtractor<TData TInstance::*>
+    {
+        using DataType = TData;
+    };
+
+    template<typename TInstance, typename TData>
+    struct MemberPointerDataTypeExtractor<TData TInstance::* const>
+    {
+        using DataType = TData;
+    };
+
+    template<typename... TArgs>
+    struct MemberPointerCollectionTupleTypeExtractor
+    {
+        using TupleType = std::tuple<typename MemberPointerDataTypeExtractor<std::decay_t<TArgs>>::DataType...>;
+    };
+
+    template<size_t i, typename TInstance, typename TTuple, typename... TArgs>
+    struct TupleInstancePacker;
+
+    template<size_t i, typename TInstance, typename TTuple>
+    struct TupleInstancePacker<i, TInstance, TTuple>
+    {
+        static void PackInto(TTuple& /* tuple */, TInstance * /*pInstance*/)
+        {
+        }
+    };
+
+    template<size_t i, typename TInstance, typename TTuple, typename TArg, typename... TArgs>
+    struct TupleInstancePacker<i, TInstance, TTuple, TArg, TArgs...>
+    {
+        static void PackInto(TTuple& tuple, TInstance *pInstance, TArg&& firstArg, TArgs&&... subsequentArgs)
+        {
+            static_assert(is_member_data_pointer_of_v<TInstance, std::decay_t<TArg>>, "Supplied data must be a pointer-to-member of the instance type");
+
+            std::get<i>(tuple) = pInstance->*firstArg;
+            TupleInstancePacker<i + 1, TInstance, TTuple, TArgs...>::PackInto(tuple, pInstance, std::forward<TArgs>(subsequentArgs)...);
+        }
+    };
+
+    // PackTupleInstanceData():
+    //
+    // Takes a series of "pointer-to-member-data" of TInstance, resolves them into data, and packs that data
+    // into a tuple<DataTypes...> and returns it.
+    //
+    template<typename TInstance, typename... TArgs>
+    decltype(auto) PackTupleInstanceData(TInstance *pInstance, TArgs&&... args)
+    {
+        using TupleType = typename MemberPointerCollectionTupleTypeExtractor<TArgs...>::TupleType;
+
+        TupleType tuple;
+        TupleInstancePacker<0, TInstance, TupleType, TArgs...>::PackInto(
+            tuple, pInstance, std::forward<TArgs>(args)...
+            );
+        return tuple;
+    }
+
+    //*************************************************
+    // Box and Unbox Helpers:
+    //
+
+    // BoxedPayloadSize():
+    //
+    // Returns the number of bytes of string or intrinsic data which boxing a value produced by an accessor copies
+    // into the data model.  Anything else (objects, containers, etc...) is not counted.
+    //
+    template<typename T>
+    size_t BoxedPayloadSize(_In_ const T& value)
+    {
+        if constexpr (std::is_same_v<T, std::wstring>)
+        {
+            return value.size() * sizeof(wchar_t);
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            return value.size();
+        }
+        else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        {
+            return sizeof(T);
+        }
+        else
+        {
+            UNREFERENCED_PARAMETER(value);
+            return 0;
+        }
+    }
+
+    // BoxedProperty:
+    //
+    // A data model implementation of a property which is bound to a C++ functor.  If a statistics slot is
+    // supplied, gets and sets of the property are recorded against it.
+    //
+    template<typename TGetter, typename TSetter>
+    class BoxedProperty : public
+        Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IModelPropertyAccessor
+            >
+    {
+    public:
+
+        BoxedProperty(_In_ const TGetter& getterFunc, _In_ const TSetter& setterFunc, _In_ std::shared_ptr<AccessorStatsSlot> spStats = nullptr) :
+            m_getterFunc(getterFunc), m_setterFunc(setterFunc), m_spStats(std::move(spStats))
+        {
+            using TGetRet = std::decay_t<typename FunctorTraits<TGetter>::ReturnType>;
+            using TSetRet = typename FunctorTraits<TSetter>::ReturnType;
+            static_assert(!std::is_same_v<TGetRet, void>, L"Property getter must return a value");
+            static_assert(std::is_same_v<TSetRet, void>, L"Property setter must not return a value");
+        }
+
+        //*************************************************
+        // IModelPropertyAccessor:
+        //
+
+        // GetValue():
+        //
+        // Gets the value of the underlying property by calling the functor.
+        //
+        IFACEMETHOD(GetValue)(_In_ PCWSTR /*propertyName*/, _In_opt_ IModelObject *pContextObject, _COM_Outptr_ IModelObject **ppValue)
+        {
+            try
+            {
+                AccessorCallScope callScope(m_spStats.get());
+                using ContextType = typename FunctorTraits<TGetter>::template ArgumentType_t<0>;
+                ContextArgument_t<ContextType> contextArgument(pContextObject);
+                auto result = m_getterFunc(PassContextArgument(contextArgument));
+                if (callScope.IsRecording())
+                {
+                    callScope.AddBytesBoxed(BoxedPayloadSize(result));
+                }
+                ClientEx::Object resultObject = ClientEx::BoxObject(std::move(result));
+                *ppValue = resultObject.Detach();
+                callScope.Complete();
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception(), ppValue);
+            }
+
+            return S_OK;
+        }
+
+        // SetValue():
+        //
+        // Sets the value of the underlying property by calling the functor.
+        //
+        IFACEMETHOD(SetValue)(_In_ PCWSTR /*propertyName*/, _In_opt_ IModelObject *pContextObject, _In_ IModelObject *pValue)
+        {
+            //
+            // The function must have a signature of (Object[&], T) where T is the value being set.  Unbox to T.
+            //
+            try
+            {
+                AccessorCallScope callScope(m_spStats.get());
+                using ContextType = typename FunctorTraits<TSetter>::template ArgumentType_t<0>;
+                using ArgumentType = typename FunctorTraits<TSetter>::template ArgumentType_t<1>;
+                ArgumentType val = ClientEx::UnboxObject<ArgumentType>(pValue);
+                ContextArgument_t<ContextType> contextArgument(pContextObject);
+                m_setterFunc(PassContextArgument(contextArgument), val);
+                callScope.Complete();
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception());
+            }
+
+            return S_OK;
+        }
+
+    private:
+
+        TGetter m_getterFunc;
+        TSetter m_setterFunc;
+        std::shared_ptr<AccessorStatsSlot> m_spStats;
+
+    };
+
+    // BoxedMethod:
+    //
+    // A data model implementation of a method which is bound to a C++ functor.  If a statistics slot is supplied,
+    // calls of the method are recorded against it.
+    //
+    template<typename TFunc>
+    class BoxedMethod : public
+        Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IModelMethod
+            >
+    {
+    public:
+
+        BoxedMethod(_In_ const TFunc& func, _In_ std::shared_ptr<AccessorStatsSlot> spStats = nullptr) :
+            m_func(func), m_spStats(std::move(spStats))
+        {
+        }
+
+        //*************************************************
+        // IModelMethod:
+        //
+
+        // Call():
+        //
+        // Calls the method.
+        //
+        IFACEMETHOD(Call)(_In_opt_ IModelObject *pContextObject,
+                          _In_ ULONG64 argCount,
+                          _In_reads_(argCount) IModelObject **ppArguments,
+                          _COM_Errorptr_ IModelObject ** ppResult,
+                          _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            Object result;
+            try
+            {
+                AccessorCallScope callScope(m_spStats.get());
+                ObjectView contextObj = pContextObject;
+                result = InvokeMethodFromPack(m_func, contextObj, static_cast<size_t>(argCount), ppArguments, ppMetadata);
+                callScope.Complete();
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception(), ppResult);
+            }
+
+            *ppResult = result.Detach();
+            return S_OK;
+        }
+
+    private:
+
+        TFunc m_func;
+        std::shared_ptr<AccessorStatsSlot> m_spStats;
+
+    };
+
+    // BoxedArray:
+    //
+    // A class which represents the conceptual structure necessary to represent a boxed array
+    // of some type T.
+    //
+    template<typename T>
+    class BoxedArray :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IIterableConcept,
+            IIndexableConcept
+            >
+    {
+    public:
+
+        // BoxedArray:
+        //
+        // Construct a new boxed array.
+        //
+        BoxedArray(_In_ const Object &arrayObject,_In_ const T *pArray, _In_ size_t arraySize) :
+            m_arraySize(arraySize)
+        {
+            std::shared_ptr<T[]> spArray(new T[arraySize]);
+            std::copy(pArray, pArray + arraySize, spArray.get());
+            m_pArray = m_pWritableArray = spArray.get();
+            m_spStorage = std::move(spArray);
+            CheckHr(arrayObject->SetConcept(__uuidof(IIterableConcept), static_cast<IIterableConcept *>(this), nullptr));
+            CheckHr(arrayObject->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr));
+        }
+
+        // BoxedArray:
+        //
+        // Construct a new boxed array which aliases existing storage rather than copying it.  spStorage keeps the
+        // storage alive for the lifetime of the boxed array.  The array is read-only.
+        //
+        BoxedArray(_In_ const Object &arrayObject,
+                   _In_reads_(arraySize) const T *pArray,
+                   _In_ size_t arraySize,
+                   _In_ std::shared_ptr<const void> spStorage) :
+            m_spStorage(std::move(spStorage)),
+            m_pArray(pArray),
+            m_pWritableArray(nullptr),
+            m_arraySize(arraySize)
+        {
+            CheckHr(arrayObject->SetConcept(__uuidof(IIterableConcept), static_cast<IIterableConcept *>(this), nullptr));
+            CheckHr(arrayObject->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr));
+        }
+
+        //*************************************************
+        // IIterableConcept:
+        //
+
+        IFACEMETHOD(GetDefaultIndexDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                                   _Out_ ULONG64 *pDimensionality)
+        {
+            *pDimensionality = 1;
+            return S_OK;
+        }
+
+        IFACEMETHOD(GetIterator)(_In_ IModelObject * /*pContextObject*/,
+                                 _Out_ IModelIterator **ppIterator)
+        {
+            *ppIterator = nullptr;
+            try
+            {
+                ComPtr<Iterator> spIterator = MakePooled<Iterator>(this, m_pArray, m_arraySize);
+                *ppIterator = spIterator.Detach();
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
+        }
+
+        //*************************************************
+        // IIndexableConcept:
+        //
+
+        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                       _Out_ ULONG64 *pDimensionality)
+        {
+            *pDimensionality = 1;
+            return S_OK;
+        }
+
+        IFACEMETHOD(GetAt)(_In_ IModelObject * /*pContextObject*/,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _COM_Errorptr_ IModelObject **ppObject,
+                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            *ppObject = nullptr;
+            if (ppMetadata != nullptr)
+            {
+                *ppMetadata = nullptr;
+            }
+
+            try
+            {
+                if (indexerCount != 1)
+                {
+                    return E_INVALIDARG;
+                }
+
+                Object idxObj = ppIndexers[0];
+                ULONG64 idx = (ULONG64)idxObj;
+                if (idx >= m_arraySize)
+                {
+                    throw std::range_error("Out of bounds array index");
+                }
+
+                T const& val = m_pArray[static_cast<size_t>(idx)];
+                ClientEx::Object result = val;
+
+                MetadataTraits<T>::FillMetadata(val, ppMetadata);
+                *ppObject = result.Detach();
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception(), ppObject);
+            }
+
+            return S_OK;
+        }
+
+        IFACEMETHOD(SetAt)(_In_ IModelObject * /*pContextObject*/,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _In_ IModelObject *pValue)
+        {
+            if (m_pWritableArray == nullptr)
+            {
+                return E_NOTIMPL;
+            }
+
+            try
+            {
+                if (indexerCount != 1)
+                {
+                    return E_INVALIDARG;
+                }
+
+                Object idxObj = ppIndexers[0];
+                ULONG64 idx = (ULONG64)idxObj;
+                if (idx >= m_arraySize)
+                {
+                    throw std::range_error("Out of bounds array index");
+                }
+
+                Object val = pValue;
+                m_pWritableArray[static_cast<size_t>(idx)] = (T)val;
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+
+            return S_OK;
+        }
+
+    private:
+
+        // Iterator:
+        //
+        // A model based iterator for boxed arrays.
+        //
+        class Iterator :
+            public PooledObject<Iterator, Microsoft::WRL::RuntimeClass<
+                Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+                IModelIterator
+                >>
+        {
+        public:
+
+            Iterator(_In_ IIterableConcept *pIterable, _In_ const T *pArray, _In_ size_t arraySize) :
+                m_spIterable(pIterable), m_pArray(pArray), m_arraySize(arraySize), m_pos(0)
+            {
+            }
+
+            //*************************************************
+            // IModelIterator
+            //
+
+            IFACEMETHOD(Reset)()
+            {
+                m_pos = 0;
+                return S_OK;
+            }
+
+            IFACEMETHOD(GetNext)(_In_ IModelObject ** ppObject,
+                                 _In_ ULONG64 dimensions,
+                                 _Out_writes_opt_(dimensions) IModelObject ** ppIndexers,
+                                 _COM_Outptr_opt_result_maybenull_ IKeyStore ** ppMetadata)
+            {
+                *ppObject = nullptr;
+                if (dimensions > 0)
+                {
+                    for (ULONG64 i = 0; i < dimensions; ++i)
+                    {
+                        ppIndexers[i] = nullptr;
+                    }
+                }
+                if (ppMetadata != nullptr)
+                {
+                    *ppMetadata = nullptr;
+                }
+
+                if (dimensions != 0 && dimensions != 1)
+                {
+                    return E_INVALIDARG;
+                }
+
+                try
+                {
+                    if (m_pos >= m_arraySize)
+                    {
+                        return E_BOUNDS;
+                    }
+
+                    T const& val = m_pArray[m_pos];
+                    ClientEx::Object objVal = val;
+
+                    if (dimensions == 1)
+                    {
+                        Object idx = (ULONG64)m_pos;
+                        ppIndexers[0] = idx.Detach();
+                    }
+
+                    ++m_pos;
+                    MetadataTraits<T>::FillMetadata(val, ppMetadata);
+                    *ppObject = objVal.Detach();
+                }
+                catch(...)
+                {
+                    return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+                }
+
+                return S_OK;
+            }
+
+        private:
+
+            ComPtr<IIterableConcept> m_spIterable;
+            const T *m_pArray;
+            size_t m_arraySize;
+            size_t m_pos;
+
+        };
+
+        std::shared_ptr<const void> m_spStorage;
+        const T *m_pArray;
+        T *m_pWritableArray;
+        size_t m_arraySize;
+
+    };
+
+    // MaterializedContainer:
+    //
+    // The conceptual structure of a boxed MaterializedIterable.  Iteration and indexing are both served from the
+    // buffer of elements held by the MaterializedIterable.
+    //
+    template<typename TContainer>
+    class MaterializedContainer :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IIterableConcept,
+            IIndexableConcept
+            >
+    {
+    public:
+
+        using TValue = typename MaterializedIterable<TContainer>::ValueType;
+        using TBuffer = typename MaterializedIterable<TContainer>::BufferType;
+
+        MaterializedContainer(_In_ const Object& containerObject, _In_ const MaterializedIterable<TContainer>& iterable) :
+            m_iterable(iterable)
+        {
+            CheckHr(containerObject->SetConcept(__uuidof(IIterableConcept), static_cast<IIterableConcept *>(this), nullptr));
+            CheckHr(containerObject->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr));
+        }
+
+        //*************************************************
+        // IIterableConcept:
+        //
+
+        IFACEMETHOD(GetDefaultIndexDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                                   _Out_ ULONG64 *pDimensionality)
+        {
+            *pDimensionality = 1;
+            return S_OK;
+        }
+
+        IFACEMETHOD(GetIterator)(_In_ IModelObject * /*pContextObject*/,
+                                 _Out_ IModelIterator **ppIterator)
+        {
+            *ppIterator = nullptr;
+            try
+            {
+                ComPtr<Iterator> spIterator = MakePooled<Iterator>(m_iterable.GetElements());
+                *ppIterator = spIterator.Detach();
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
+        }
+
+        //*************************************************
+        // IIndexableConcept:
+        //
+
+        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                       _Out_ ULONG64 *pDimensionality)
+        {
+            *pDimensionality = 1;
+            return S_OK;
+        }
+
+        IFACEMETHOD(GetAt)(_In_ IModelObject * /*pContextObject*/,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _COM_Errorptr_ IModelObject **ppObject,
+                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            *ppObject = nullptr;
+            if (ppMetadata != nullptr)
+            {
+                *ppMetadata = nullptr;
+            }
+
+            try
+            {
+                if (indexerCount != 1)
+                {
+                    return E_INVALIDARG;
+                }
+
+                std::shared_ptr<const TBuffer> spElements = m_iterable.GetElements();
+
+                Object idxObj = ppIndexers[0];
+                ULONG64 idx = (ULONG64)idxObj;
+                if (idx >= spElements->size())
+                {
+                    throw std::range_error("Out of bounds array index");
+                }
+
+                TValue const& val = (*spElements)[static_cast<size_t>(idx)];
+                ClientEx::Object result = val;
+
+                MetadataTraits<TValue>::FillMetadata(val, ppMetadata);
+                *ppObject = result.Detach();
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception(), ppObject);
+            }
+
+            return S_OK;
+        }
+
+        IFACEMETHOD(SetAt)(_In_ IModelObject * /*pContextObject*/,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject ** /*ppIndexers*/,
+                           _In_ IModelObject * /*pValue*/)
+        {
+            UNREFERENCED_PARAMETER(indexerCount);
+            return E_NOTIMPL;
+        }
+
+    private:
+
+        // Iterator:
+        //
+        // A model based iterator over one buffer of elements.  The iterator holds the buffer so that it remains
+        // valid if the MaterializedIterable is refilled during iteration.
+        //
+        class Iterator :
+            public PooledObject<Iterator, Microsoft::WRL::RuntimeClass<
+                Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+                IModelIterator
+                >>
+        {
+        public:
+
+            Iterator(_In_ std::shared_ptr<const TBuffer> spElements) :
+                m_spElements(std::move(spElements)), m_pos(0)
+            {
+            }
+
+            //*************************************************
+            // IModelIterator
+            //
+
+            IFACEMETHOD(Reset)()
+            {
+                m_pos = 0;
+                return S_OK;
+            }
+
+            IFACEMETHOD(GetNext)(_In_ IModelObject ** ppObject,
+                                 _In_ ULONG64 dimensions,
+                                 _Out_writes_opt_(dimensions) IModelObject ** ppIndexers,
+                                 _COM_Outptr_opt_result_maybenull_ IKeyStore ** ppMetadata)
+            {
+                *ppObject = nullptr;
+                for (ULONG64 i = 0; i < dimensions; ++i)
+                {
+                    ppIndexers[i] = nullptr;
+                }
+                if (ppMetadata != nullptr)
+                {
+                    *ppMetadata = nullptr;
+                }
 
-    IModelObject *GetObject() const
-    {
-        return m_spObject.Get();
-    }
+                if (dimensions != 0 && dimensions != 1)
+                {
+                    return E_INVALIDARG;
+                }
 
-    operator IModelObject *() const
+                try
+                {
+                    if (m_pos >= m_spElements->size())
+                    {
+                        return E_BOUNDS;
+                    }
+
+                    TValue const& val = (*m_spElements)[m_pos];
+                    ClientEx::Object objVal = val;
+
+                    if (dimensions == 1)
+                    {
+                        Object idx = (ULONG64)m_pos;
+                        ppIndexers[0] = idx.Detach();
+                    }
+
+                    ++m_pos;
+                    MetadataTraits<TValue>::FillMetadata(val, ppMetadata);
+                    *ppObject = objVal.Detach();
+                }
+                catch(...)
+                {
+                    return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+                }
+
+                return S_OK;
+            }
+
+        private:
+
+            std::shared_ptr<const TBuffer> m_spElements;
+            size_t m_pos;
+
+        };
+
+        MaterializedIterable<TContainer> m_iterable;
+
+    };
+
+    //*************************************************
+    // Class Link References
+    //
+
+    struct DataModelReferenceInfo
     {
-        return GetObject();
-    }
+        DataModelReferenceInfo() : TypeIsLive(true) { }
 
-    operator HostContext() const
+        bool TypeIsLive;
+    };
+
+    using DataModelReference = std::shared_ptr<DataModelReferenceInfo>;
+
+    inline void ThrowIfDetached(_In_ const DataModelReference& linkRef)
     {
-        ComPtr<IDebugHostContext> spCtx;
-        CheckHr(m_spObject->GetContext(&spCtx));
-        return HostContext(std::move(spCtx));
+        if (!linkRef->TypeIsLive)
+        {
+            throw ClientEx::object_detached();
+        }
     }
 
-    IModelObject *operator->() const
+    //*************************************************
+    // Iterators:
+    //
+
+    template<typename TGen, typename TIter, typename TProjector, bool IsRandom>
+    class BoundIterator :
+        public PooledObject<BoundIterator<TGen, TIter, TProjector, IsRandom>, Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IModelIterator,
+            IBatchedModelIterator,
+            ISeekableModelIterator
+            >>
     {
-        return GetObject();
-    }
+    public:
+
+        using TGenBaseType = std::decay_t<TGen>;
+
+        BoundIterator(_In_ DataModelReference&& transferredLinkReference,
+                      _In_ TGenBaseType& generator,
+                      _In_ const TIter& itBegin,
+                      _In_ const TIter& itEnd,
+                      _In_ const ClientEx::Object& srcObject,
+                      _In_ const TProjector& projectionFunction
+                      ) :
+            m_generator(generator),
+            m_itBegin(itBegin),
+            m_itEnd(itEnd),
+            m_itCur(itBegin),
+            m_srcObject(srcObject),
+            m_projector(projectionFunction),
+            m_linkReference(std::move(transferredLinkReference))
+        {
+        }
+
+        BoundIterator(_In_ DataModelReference&& transferredLinkReference,
+                      _In_ TGenBaseType&& generator,
+                      _In_ const TIter& itBegin,
+                      _In_ const TIter& itEnd,
+                      _In_ const ClientEx::Object& srcObject,
+                      _In_ const TProjector& projectionFunction
+                      ) :
+            m_generator(std::move(generator)),
+            m_itBegin(itBegin),
+            m_itEnd(itEnd),
+            m_itCur(itBegin),
+            m_srcObject(srcObject),
+            m_projector(projectionFunction),
+            m_linkReference(std::move(transferredLinkReference))
+        {
+        }
+
+        //*************************************************
+        // IModelIterator():
+        //
+
+        IFACEMETHOD(Reset)()
+        {
+            m_itCur = m_itBegin;
+            return S_OK;
+        }
+
+        IFACEMETHOD(GetNext)(_In_ IModelObject ** ppObject,
+                             _In_ ULONG64 dimensions,
+                             _Out_writes_opt_(dimensions) IModelObject ** ppIndexers,
+                             _COM_Outptr_opt_result_maybenull_ IKeyStore ** ppMetadata)
+        {
+            *ppObject = nullptr;
+            if (dimensions > 0)
+            {
+                for (ULONG64 i = 0; i < dimensions; ++i)
+                {
+                    ppIndexers[i] = nullptr;
+                }
+            }
+            if (ppMetadata != nullptr)
+            {
+                *ppMetadata = nullptr;
+            }
+
+            using TVal = decltype(m_projector(*m_itCur));
+            IndexerTraits<TVal, TIter, IsRandom>::CheckDimensions(dimensions);
+
+            try
+            {
+                ThrowIfDetached(m_linkReference);
+
+                //
+                // It is illegal to reference a generator iterator which has rethrown.  Make
+                // sure that a throw out of the underlying iterator continues to throw the
+                // same exception if it is rereferenced.
+                //
+                if (m_thrown)
+                {
+                    std::rethrow_exception(m_thrown);
+                }
+
+                if (m_itCur == m_itEnd)
+                {
+                    return E_BOUNDS;
+                }
+
+                auto val = m_projector(*m_itCur);
+
+                ClientEx::Object objVal = ClientEx::BoxObject(val);
+
+                IndexerTraits<TVal, TIter, IsRandom>::FillIndexers(val, m_itBegin, m_itCur, dimensions, ppIndexers);
+                ++m_itCur;
+
+                MetadataTraits<TVal>::FillMetadata(val, ppMetadata);
+                *ppObject = objVal.Detach();
+            }
+            catch(...)
+            {
+                for (ULONG64 i = 0; i < dimensions; ++i)
+                {
+                    if (ppIndexers[i] != nullptr)
+                    {
+                        ppIndexers[i]->Release();
+                        ppIndexers[i] = nullptr;
+                    }
+                }
+
+                m_thrown = std::current_exception();
+                return ClientEx::Details::Exceptions::ReturnResult(m_thrown);
+            }
+
+            return S_OK;
+        }
+
+        //*************************************************
+        // IBatchedModelIterator():
+        //
+
+        IFACEMETHOD(GetNextBatch)(_In_ ULONG64 count,
+                                  _Out_writes_to_(count, *pFetched) IModelObject **ppObjects,
+                                  _Out_ ULONG64 *pFetched)
+        {
+            *pFetched = 0;
+            for (ULONG64 i = 0; i < count; ++i)
+            {
+                ppObjects[i] = nullptr;
+            }
+
+            ULONG64 fetched = 0;
+            try
+            {
+                ThrowIfDetached(m_linkReference);
+
+                if (m_thrown)
+                {
+                    std::rethrow_exception(m_thrown);
+                }
+
+                //
+                // This is the C++ to C++ path: walk the underlying iterator directly and box each value without
+                // a trip through IModelIterator::GetNext per element.
+                //
+                while (fetched < count && m_itCur != m_itEnd)
+                {
+                    auto val = m_projector(*m_itCur);
+                    ClientEx::Object objVal = ClientEx::BoxObject(val);
+                    ++m_itCur;
+                    ppObjects[fetched++] = objVal.Detach();
+                }
+            }
+            catch(...)
+            {
+                m_thrown = std::current_exception();
+
+                //
+                // If we have already produced values, hand them back.  The next call will rethrow.
+                //
+                if (fetched == 0)
+                {
+                    return ClientEx::Details::Exceptions::ReturnResult(m_thrown);
+                }
+            }
+
+            *pFetched = fetched;
+            return (fetched == 0) ? E_BOUNDS : S_OK;
+        }
+
+        //*************************************************
+        // ISeekableModelIterator():
+        //
+
+        IFACEMETHOD(Skip)(_In_ ULONG64 count, _Out_ ULONG64 *pSkipped)
+        {
+            *pSkipped = 0;
+
+            ULONG64 skipped = 0;
+            try
+            {
+                ThrowIfDetached(m_linkReference);
+
+                if (m_thrown)
+                {
+                    std::rethrow_exception(m_thrown);
+                }
+
+                //
+                // Skipped elements are neither projected nor boxed.  A random access iterator moves directly to the
+                // new position.
+                //
+                if constexpr (IsRandom)
+                {
+                    ULONG64 remaining = static_cast<ULONG64>(m_itEnd - m_itCur);
+                    skipped = (count < remaining ? count : remaining);
+                    m_itCur += static_cast<typename std::iterator_traits<TIter>::difference_type>(skipped);
+                }
+                else
+                {
+                    while (skipped < count && m_itCur != m_itEnd)
+                    {
+                        ++m_itCur;
+                        ++skipped;
+                    }
+                }
+            }
+            catch(...)
+            {
+                m_thrown = std::current_exception();
+                return ClientEx::Details::Exceptions::ReturnResult(m_thrown);
+            }
 
-    // operator++:
-    //
-    // Pre-increment (for pointer types and the like)
-    //
-    Object& operator++()
-    {
-        Object incremented = Details::ObjectOperators<Object>::Increment(*this);
-        *this = std::move(incremented);
-        return *this;
-    }
+            *pSkipped = skipped;
+            return S_OK;
+        }
 
-    // operator++:
-    //
-    // Post-increment (for pointer types and the like)
-    //
-    Object operator++(int)
-    {
-        Object original = *this;
-        ++(*this);
-        return original;
-    }
+    private:
 
-    // operator+=:
-    //
-    // Increment by operation.
-    //
-    Object& operator+=(_In_ LONG64 offset)
-    {
-        Object incremented = Details::ObjectOperators<Object>::IncrementBy(*this, static_cast<LONG64>(offset));
-        *this = std::move(incremented);
-        return *this;
-    }
+        //
+        // If this is instance data for a TypedInstanceData<T>, this should be a T& (or the underlying U of T where T is
+        // std::shared_ptr<U> or std::unique_ptr<U>.
+        //
+        // It is imperative that this **STAYS** a reference if the generator returned a reference and a value if the generator
+        // returned a value.  Otherwise, we will incur a significant number of copies.
+        //
+        // For generators that return a value, is a move constructed version of that data.
+        //
+        TGen m_generator;
 
-    // operator--:
-    //
-    // Pre-decrement (for pointer types and the like)
-    //
-    Object& operator--()
-    {
-        Object decremented = Details::ObjectOperators<Object>::Decrement(*this);
-        *this = std::move(decremented);
-        return *this;
-    }
+        std::exception_ptr m_thrown;
+        TIter m_itBegin;
+        TIter m_itEnd;
+        TIter m_itCur;
+        TProjector m_projector;
+        ClientEx::Object m_srcObject;
+        DataModelReference m_linkReference;
+    };
 
-    // operator--:
-    //
-    // Post-decrement (for pointer types and the like)
-    //
-    Object operator--(int)
+    template<typename TClass, typename TGenProjector, typename TItemProjector>
+    class BoundIterableBase :
+        public Microsoft::WRL::Implements<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IIterableConcept
+            >
     {
-        Object original = *this;
-        --(*this);
-        return original;
-    }
+    public:
 
-    // operator-=:
-    //
-    // Decrement by operation.
-    //
-    Object& operator-=(_In_ LONG64 offset)
-    {
-        Object decremented = Details::ObjectOperators<Object>::DecrementBy(*this, static_cast<LONG64>(offset));
-        *this = std::move(decremented);
-        return *this;
-    }
+        using ItemProjectorFunction = typename FunctorTraits<TItemProjector>::FunctionType;
+        using GenProjectorFunction = typename FunctorTraits<TGenProjector>::FunctionType;
+        using GeneratorType = typename FunctorTraits<TGenProjector>::ReturnType;
+        using CIterator = decltype(std::declval<GeneratorType>().begin());
+        using CIteratorValue = std::decay_t<decltype(*(std::declval<CIterator>()))>;
+        using ModelIndexerTraits = IndexerTraits<CIteratorValue, CIterator, IsRandomAccessIterator_v<CIterator>>;
 
-    // operator==:
-    //
-    // Compare to another object for equality.
-    //
-    template<typename TArg>
-    bool operator==(_In_ TArg&& other) const { return IsEqualTo(std::forward<TArg>(other)); }
+        //*************************************************
+        // IIterableConcept:
+        //
 
-    // operator!=
-    //
-    // Compare to another object for lack of equality.
-    //
-    template<typename TArg>
-    bool operator!=(_In_ TArg&& other) const { return !operator==(std::forward<TArg>(other)); }
+        // GetDefaultIndexDimensionality():
+        //
+        // Gets the dimensionality of the indexer.  For random access iterators, we provide a linear
+        // implementation; otherwise, we provide no indexer and the return is zero.
+        //
+        IFACEMETHOD(GetDefaultIndexDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                                   _Out_ ULONG64 *pDimensionality)
+        {
+            *pDimensionality = ModelIndexerTraits::Dimensionality;
+            return S_OK;
+        }
 
-    // Comparison operators:
-    //
-    // Performs comparison with another objects.  If there is no path by which the objects can be compared,
-    // an exception will be thrown.
-    //
-    template<typename TArg> bool operator<(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) < 0; }
-    template<typename TArg> bool operator>(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) > 0; }
-    template<typename TArg> bool operator<=(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) <= 0; }
-    template<typename TArg> bool operator>=(_In_ TArg&& other) const { return CompareTo(std::forward<TArg>(other)) >= 0; }
+        // GetIterator():
+        //
+        // Gets an iterator for a given object.
+        //
+        IFACEMETHOD(GetIterator)(_In_ IModelObject *pContextObject,
+                                 _Out_ IModelIterator **ppIterator)
+        {
+            *ppIterator = nullptr;
+            try
+            {
+                ThrowIfDetached(m_linkReference);
+                Object obj(pContextObject);
 
-    // GetKind():
-    //
-    // Gets the kind of object this is (according to the data model).
-    //
-    ModelObjectKind GetKind() const
-    {
-        ModelObjectKind mk;
-        ClientEx::CheckHr(m_spObject->GetKind(&mk));
-        return mk;
-    }
+                //
+                // Subtle semantics:
+                //
+                // If GetGenerator() returns a reference, it must be preserved as a reference into BoundIterator<>.  We must
+                // hold the reference and not *MOVE* the underlying object into the iterator.  The reference may be the underlying
+                // data of a TTypedInstance<...> to which we are bound.
+                //
+                // On the other hand, if GetGenerator() returns a value, the value *MUST* be moved into BoundIterator().  It
+                // may be a generator that cannot be copy constructed.
+                //
+                GeneratorType generator = GetGenerator(obj);
 
-    // Type():
-    //
-    // The type of object.  This will return an empty Type() for objects that have no native type.
-    //
-    Type Type() const
-    {
-        ComPtr<IDebugHostType> spType;
-        CheckHr(m_spObject->GetTypeInfo(&spType));
-        return ClientEx::Type(std::move(spType));
-    }
+                using TGenBase = std::decay_t<GeneratorType>;
+                using TGenPass = std::conditional_t<std::is_reference_v<GeneratorType>, GeneratorType, GeneratorType&&>;
 
-    // GetLocation():
-    //
-    // The location of the object.  This will throw for objects which have no location.
-    //
-    Location GetLocation() const
-    {
-        Location objLocation;
-        CheckHr(m_spObject->GetLocation(&objLocation));
-        return objLocation;
-    }
+                using ModelIterator = BoundIterator<GeneratorType,
+                                                    CIterator,
+                                                    ItemProjectorFunction,
+                                                    IsRandomAccessIterator_v<CIterator>>;
 
-    // Keys():
-    //
-    // Returns a collection of the keys on the object.
-    //
-    Details::ObjectKeysRef<Object, Metadata> Keys() const
-    {
-        return Details::ObjectKeysRef<Object, Metadata>(*this);
-    }
+                auto itBegin = generator.begin();
+                auto itEnd = generator.end();
 
-    // KeyValue():
-    //
-    // Fetches a key value without the overhead of returning key references.
-    //
-    Object KeyValue(_In_z_ const wchar_t *keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
-    {
-        if (pMetadata != nullptr)
-        {
-            *pMetadata = Metadata();
-        }
+                DataModelReference iterRef = GetLinkReference();
+                ComPtr<ModelIterator> spIter = MakePooled<ModelIterator>(std::move(iterRef), (TGenPass)generator, itBegin, itEnd, obj, m_itemProjector);
+                if (spIter == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
 
-        ComPtr<IModelObject> spValue;
-        ComPtr<IKeyStore> spMetadata;
-        IKeyStore **ppMetadata = (pMetadata != nullptr) ? (IKeyStore **)&spMetadata : nullptr;
-        CheckHr(m_spObject->GetKeyValue(keyName, &spValue, ppMetadata));
+                *ppIterator = spIter.Detach();
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception());
+            }
 
-        if (pMetadata != nullptr)
-        {
-            *pMetadata = Metadata(std::move(spMetadata));
+            return S_OK;
         }
-        return Object(std::move(spValue));
-    }
 
-    // KeyValue():
-    //
-    // Fetches a key value without the overhead of returning key references.
-    //
-    Object KeyValue(_In_ const std::wstring& keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
-    {
-        return KeyValue(keyName.c_str(), pMetadata);
-    }
+        //*************************************************
+        // Internal Methods
+        //
 
-    // TryGetKeyValue():
-    //
-    // Fetches a key value, if it exists, without the overhead of returning key references.
-    //
-    std::optional<Object> TryGetKeyValue(_In_z_ const wchar_t *keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
-    {
-        if (pMetadata != nullptr)
+        const DataModelReference& GetLinkReference() const
         {
-            *pMetadata = Metadata();
+            return m_linkReference;
         }
 
-        ComPtr<IModelObject> spValue;
-        ComPtr<IKeyStore> spMetadata;
-        IKeyStore **ppMetadata = (pMetadata != nullptr) ? (IKeyStore **)&spMetadata : nullptr;
-        if (SUCCEEDED(m_spObject->GetKeyValue(keyName, &spValue, ppMetadata)))
+    protected:
+
+        virtual IModelObject *GetObject(_In_opt_ IModelObject *pOverrideObject = nullptr)
         {
-            if (pMetadata != nullptr)
+            if (pOverrideObject != nullptr)
             {
-                *pMetadata = Metadata(std::move(spMetadata));
+                return pOverrideObject;
             }
 
-            return Object(std::move(spValue));
+            return m_pClass->GetObject();
         }
 
-        return std::nullopt;
-    }
+        GeneratorType GetGenerator(_In_ const Object& instanceObject)
+        {
+            return m_genProjector(instanceObject);
+        }
 
-    // TryGetKeyValue():
-    //
-    // Fetches a key value, if it exists, without the overhead of returning key references.
-    //
-    std::optional<Object> TryGetKeyValue(_In_ const std::wstring& keyName, _Out_opt_ Metadata *pMetadata = nullptr) const
-    {
-        return TryGetKeyValue(keyName.c_str(), pMetadata);
-    }
+        virtual void Apply(_In_opt_ IModelObject *pOverrideObject = nullptr)
+        {
+            GetObject(pOverrideObject)->SetConcept(__uuidof(IIterableConcept), static_cast<IIterableConcept *>(this), nullptr);
+        }
 
-    // Fields():
-    //
-    // Returns a collection of the native fields on the object.
-    //
-    Details::ObjectFieldsRef<Object> Fields() const
-    {
-        return Details::ObjectFieldsRef<Object>(*this);
-    }
+        TClass *m_pClass;
+        GenProjectorFunction m_genProjector;
+        ItemProjectorFunction m_itemProjector;
+        DataModelReference m_linkReference;
 
-    // FieldValue():
-    //
-    // Fetches a field value without the overhead of returning field references.
-    //
-    Object FieldValue(_In_z_ const wchar_t *fieldName) const
-    {
-        ComPtr<IModelObject> spValue;
-        CheckHr(m_spObject->GetRawValue(SymbolField, fieldName, RawSearchNone, &spValue));
-        return Object(std::move(spValue));
-    }
+    };
 
-    // FieldValue():
+    // BoundIterableIndexableBase:
     //
-    // Fetches a field value without the overhead of returning field references.
+    // A class which implements both iterator and indexer based solely on an iterator (one which is a C++ random access iterator).
+    // The indexer is a linear 0-based indexer as an offset from the base iterator (.begin())
     //
-    Object FieldValue(_In_ const std::wstring& fieldName) const
+    template<typename TClass, typename TGenProjector, typename TItemProjector>
+    class BoundIterableIndexableBase :
+        public Microsoft::WRL::Implements<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IIndexableConcept,
+            BoundIterableBase<TClass, TGenProjector, TItemProjector>
+            >
     {
-        return FieldValue(fieldName.c_str());
-    }
+    private:
 
-    // TryGetFieldValue():
-    //
-    // Fetches a field, if it exists, without the overhead of returning field
-    // references.
-    //
-    std::optional<Object> TryGetFieldValue(_In_z_ const wchar_t *fieldName) const
-    {
-        ComPtr<IModelObject> spValue;
-        if (SUCCEEDED(m_spObject->GetRawValue(SymbolField, fieldName, RawSearchNone, &spValue)))
+        using Base = Microsoft::WRL::Implements<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IIndexableConcept,
+            BoundIterableBase<TClass, TGenProjector, TItemProjector>
+            >;
+
+    public:
+
+        //*************************************************
+        // IIndexableConcept:
+        //
+
+        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                       _Out_ ULONG64 *pDimensionality)
         {
-            return Object(std::move(spValue));
+            *pDimensionality = 1;
+            return S_OK;
         }
 
-        return std::nullopt;
-    }
+        IFACEMETHOD(GetAt)(_In_ IModelObject *pContextObject,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _COM_Errorptr_ IModelObject **ppObject,
+                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            *ppObject = nullptr;
+            if (ppMetadata != nullptr)
+            {
+                *ppMetadata = nullptr;
+            }
 
-    // TryGetFieldValue():
-    //
-    // Fetches a field, if it exists, without the overhead of returning field
-    // references.
-    //
-    std::optional<Object> TryGetFieldValue(_In_ const std::wstring& fieldName) const
-    {
-        return TryGetFieldValue(fieldName.c_str());
-    }
+            try
+            {
+                ThrowIfDetached(this->m_linkReference);
+                if (indexerCount != 1)
+                {
+                    return E_INVALIDARG;
+                }
 
-    // Dereference():
-    //
-    // Returns a "reference" to the dereferenced object.
-    //
-    Details::DereferenceReference<Object> Dereference() const
-    {
-        return Details::DereferenceReference<Object>(*this);
-    }
+                Object obj = pContextObject;
+                auto&& instanceRef = this->GetGenerator(obj);
+                auto itBegin = instanceRef.begin();
 
-    // operator=:
-    //
-    // Copy another object.
-    //
-    Object& operator=(const Object& src)
-    {
-        m_spObject = src.m_spObject;
-        return *this;
-    }
+                VARIANT vtIdx;
+                CheckHr(ppIndexers[0]->GetIntrinsicValueAs(VT_UI8, &vtIdx));
+                size_t stIdx = static_cast<size_t>(vtIdx.ullVal);
+                size_t delta = instanceRef.end() - itBegin;
+                if (stIdx >= delta)
+                {
+                    return E_BOUNDS;
+                }
 
-    // operator=:
-    //
-    // Move another object.
-    //
-    Object& operator=(Object&& src)
-    {
-        m_spObject = std::move(src.m_spObject);
-        return *this;
-    }
+                auto itCur = itBegin + stIdx;
+                auto val = this->m_itemProjector(*itCur);
+                Object valObject = BoxObject(val);
 
-    // operator=:
-    //
-    // Perform assignment to an object.
-    //
-    template<typename TArg,
-             typename = std::enable_if_t<!Details::IsCopyMove_v<Object, TArg>>>
-    Object& operator=(TArg&& assignmentValue);
+                MetadataTraits<std::decay_t<decltype(val)>>::FillMetadata(val, ppMetadata);
+                *ppObject = valObject.Detach();
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception(), ppObject);
+            }
 
-    // As():
-    //
-    // Converts the object too something else.
-    //
-    template<typename TType> TType As() const;
+            return S_OK;
+        }
 
-    // Call():
-    //
-    // Calls an object which represents a method and returns a new object representing the result.
-    // If the object is not a method or the call fails, an exception is thrown.
-    //
-    // The original "this" pointer must be passed into this method.
-    //
-    template<typename... TArgs> Object Call(_In_ const Object& instance, TArgs&&... callArguments) const;
+        IFACEMETHOD(SetAt)(_In_ IModelObject * /*pContextObject*/,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject ** /*ppIndexers*/,
+                           _In_ IModelObject * /*pValue*/)
+        {
+            UNREFERENCED_PARAMETER(indexerCount);
+            return E_NOTIMPL;
+        }
 
-    // CallMethod():
-    //
-    // Finds a method of the given name on this object and calls it as an instance method.
-    //
-    template<typename... TArgs> Object CallMethod(_In_z_ const wchar_t *methodName, TArgs&&... callArguments) const
-    {
-        Object method = this->Keys()[methodName];
-        return method.Call(*this, std::forward<TArgs>(callArguments)...);
-    }
-    template<typename... TArgs> Object CallMethod(_In_ const std::wstring& methodName, TArgs&&... callArguments) const
-    {
-        return CallMethod(methodName.c_str(), std::forward<TArgs>(callArguments)...);
-    }
+    protected:
 
-    // operator[]():
-    //
-    // Indexes an object
-    //
-    template<typename... TArgs> Details::IndexableReference<Object, std::unique_ptr<Object[]>> operator[](TArgs&&... indexers) const
+        virtual void Apply(_In_opt_ IModelObject *pOverrideObject = nullptr)
+        {
+            Base::Apply(pOverrideObject);
+            this->GetObject(pOverrideObject)->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr);
+        }
+
+    };
+
+    template<typename TClass, typename TGenProjector, typename TItemProjector, typename TGetAt, typename TSetAt>
+    class BoundIterableWithIndexable :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            BoundIterableBase<TClass, TGenProjector, TItemProjector>,
+            IIndexableConcept
+            >
     {
-        return Index(std::forward<TArgs>(indexers)...);
-    }
+    public:
 
-    template<typename... TArgs> Details::IndexableReference<Object, std::unique_ptr<Object[]>> Index(TArgs&&... indexers) const;
+        using TGeneratorType = typename FunctorTraits<TGenProjector>::ReturnType;
+        using TIterator = decltype(std::declval<TGeneratorType>().begin());
+        using TIndexedValue = decltype(*(std::declval<TIterator>()));
+        using TIndexedValueBase = std::decay_t<TIndexedValue>;
+        using TIndicies = typename TIndexedValueBase::IndiciesType;
+        static constexpr ULONG64 Dimensionality = (ULONG64)(TIndexedValueBase::Dimensionality);
 
+        using TGetAtFunction = typename FunctorTraits<TGetAt>::FunctionType;
+        using TSetAtFunction = typename FunctorTraits<TSetAt>::FunctionType;
 
-    // begin():
-    //
-    // Returns a starting iterator.  If the object is not iterable, this will throw an exception.  The returned
-    // iterator is a forward iterator.
-    //
-    iterator begin()
-    {
-        ComPtr<IIterableConcept> spIterable;
-        CheckHr(m_spObject->GetConcept(__uuidof(IIterableConcept), &spIterable, nullptr));
-        ComPtr<IModelIterator> spIterator;
-        CheckHr(spIterable->GetIterator(GetObject(), &spIterator));
-        return iterator(*this, spIterator.Get());
-    }
-    const_iterator begin() const { return cbegin(); }
+        BoundIterableWithIndexable(_In_ DataModelReference&& transferredLinkReference,
+                                   _In_ TClass *pClass,
+                                   _In_ const TGenProjector& genProjectionFunction,
+                                   _In_ const TItemProjector& itemProjectionFunction,
+                                   _In_ const TGetAt& getAtProjectionFunction,
+                                   _In_ const TSetAt& setAtProjectionFunction)
+        {
+            //
+            // This isn't done through base initializers because of the flow through WRL::RuntimeClass.
+            //
+            this->m_pClass = pClass;
+            this->m_itemProjector = itemProjectionFunction;
+            this->m_genProjector = genProjectionFunction;
+            this->m_getAtFunction = getAtProjectionFunction;
+            this->m_setAtFunction = setAtProjectionFunction;
+            this->m_linkReference = std::move(transferredLinkReference);
+            this->Apply();
+        }
 
-    // end():
-    //
-    // Returns the ending iterator.
-    //
-    iterator end()
-    {
-        return iterator();
-    }
-    const_iterator end() const { return cend(); }
+        //*************************************************
+        // IIndexableConcept:
+        //
 
-    // cbegin():
-    //
-    // Returns a constant starting iterator.  If the object is not iterable, this will throw an exception.  The
-    // returned iterator is a forward iterator.
-    //
-    const_iterator cbegin() const
-    {
-        ComPtr<IIterableConcept> spIterable;
-        CheckHr(m_spObject->GetConcept(__uuidof(IIterableConcept), &spIterable, nullptr));
-        ComPtr<IModelIterator> spIterator;
-        CheckHr(spIterable->GetIterator(GetObject(), &spIterator));
-        return iterator(*this, spIterator.Get());
-    }
+        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
+                                       _Out_ ULONG64 *pDimensionality)
+        {
+            *pDimensionality = Dimensionality;
+            return S_OK;
+        }
 
-    // cend():
-    //
-    // Returns the constant end iterator.
-    //
-    const_iterator cend() const
-    {
-        return iterator();
-    }
+        IFACEMETHOD(GetAt)(_In_ IModelObject *pContextObject,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _COM_Errorptr_ IModelObject **ppObject,
+                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            *ppObject = nullptr;
+            if (ppMetadata != nullptr)
+            {
+                *ppMetadata = nullptr;
+            }
 
-    // CompareTo():
-    //
-    // Compares this object to another.  If there is no comparison defined between the two object types, this
-    // will throw.
-    //
-    template<typename TArg> int CompareTo(TArg&& other) const;
+            try
+            {
+                ThrowIfDetached(this->m_linkReference);
+                if (indexerCount != Dimensionality)
+                {
+                    return E_INVALIDARG;
+                }
 
-    // IsEqualTo():
-    //
-    // Compares this object to another.  If there is no equality defined between the two object types, this
-    // will throw.
-    //
-    template<typename TArg> bool IsEqualTo(TArg&& other) const;
+                ObjectView contextObj = pContextObject;
+                Object idxVal = InvokeFunctionFromPack(m_getAtFunction, contextObj, static_cast<size_t>(indexerCount), ppIndexers, ppMetadata);
 
-    // ToDisplayString():
-    //
-    // If the object has a string conversion, it is returned; otherwise, an exception is thrown.
-    //
-    std::wstring ToDisplayString(_In_ const Metadata& metadata) const
-    {
-        ComPtr<IStringDisplayableConcept> spStringDisplayable;
-        CheckHr(m_spObject->GetConcept(__uuidof(IStringDisplayableConcept), &spStringDisplayable, nullptr));
-        BSTR str;
-        CheckHr(spStringDisplayable->ToDisplayString(GetObject(), metadata, &str));
-        bstr_ptr spStr(str);
-        return std::wstring(str);
-    }
-    std::wstring ToDisplayString() const { return ToDisplayString(Metadata()); }
+                *ppObject = idxVal.Detach();
+            }
+            catch(...)
+            {
+                return Exceptions::ReturnResult(std::current_exception(), ppObject);
+            }
 
-    // TryToDisplayString():
-    //
-    // Check if the object has a string conversion.  If so, true is returned and the string is filled into
-    // the output 'pDisplayString' argument; otherwise, false is returned.  If the string fails to fetch,
-    // for reasons other than there is no display string, an exception is thrown.
-    //
-    std::optional<std::wstring> TryToDisplayString(_In_ const Metadata& metadata) const
-    {
-        std::optional<std::wstring> displayString;
+            return S_OK;
+        }
 
-        ComPtr<IStringDisplayableConcept> spStringDisplayable;
-        if (SUCCEEDED(m_spObject->GetConcept(__uuidof(IStringDisplayableConcept), &spStringDisplayable, nullptr)))
+        IFACEMETHOD(SetAt)(_In_ IModelObject *pContextObject,
+                           _In_ ULONG64 indexerCount,
+                           _In_reads_(indexerCount) IModelObject **ppIndexers,
+                           _In_ IModelObject *pValue)
         {
-            BSTR str;
-            HRESULT hr = spStringDisplayable->ToDisplayString(GetObject(), metadata, &str);
+            try
+            {
+                ThrowIfDetached(this->m_linkReference);
+                if (indexerCount != Dimensionality)
+                {
+                    return E_INVALIDARG;
+                }
 
-            //
-            // E_NOT_SET is a special code which indicates that there is no display string despite the fact
-            // that the concept is implemented.  This is *NOT* a failure to fetch per-se.
-            //
-            if (hr != E_NOT_SET)
+                //
+                // The value has to be type matched to the second argument of the functor.  A setAt signature is
+                // (const Object& contextObject, TValue val, <indexers>)
+                //
+                using ValueType = typename FunctorTraits<TSetAt>::template ArgumentType_t<1>;
+
+                Object valueObj = pValue;
+                ValueType val = (ValueType)valueObj;
+
+                ObjectView contextObj = pContextObject;
+                Object dummyReturn = InvokeFunctionFromPack(m_setAtFunction, contextObj, static_cast<size_t>(indexerCount), ppIndexers, nullptr, val);
+            }
+            catch(...)
             {
-                CheckHr(hr);
+                return Exceptions::ReturnResult(std::current_exception());
             }
-            bstr_ptr spStr(str);
-            displayString = std::wstring(str);
+            return S_OK;
         }
-        return displayString;
-    }
-    std::optional<std::wstring> TryToDisplayString() const
-    {
-        return TryToDisplayString(Metadata());
-    }
-    bool TryToDisplayString(_Out_ std::wstring *pDisplayString, _In_ const Metadata& metadata) const
-    {
-        auto displayString = TryToDisplayString(metadata);
-        if (displayString)
+
+    protected:
+
+        virtual void Apply(_In_opt_ IModelObject *pOverrideObject = nullptr)
         {
-            *pDisplayString = std::move(displayString.value());
-            return true;
+            BoundIterableBase<TClass, TGenProjector, TItemProjector>::Apply(pOverrideObject);
+            this->GetObject(pOverrideObject)->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr);
         }
-        return false;
-    }
-    bool TryToDisplayString(_Out_ std::wstring *pDisplayString)
-    {
-        return TryToDisplayString(pDisplayString, Metadata());
-    }
-
-    // ConstructInstance():
-    //
-    // If the object is constructable, this will invoke the constructor with the given set of arguments.
-    //
-    template<typename... TArgs,
-             typename = std::enable_if_t<!Details::IsSingleType_v<Deconstruction, TArgs...>>>
-    Object ConstructInstance(_In_ TArgs&&... args)
-    {
-        ComPtr<IConstructableConcept> spConstructable;
-        CheckHr(m_spObject->GetConcept(__uuidof(IConstructableConcept), &spConstructable, nullptr));
-        Details::ParameterPack pack = Details::PackValues(std::forward<TArgs>(args)...);
-        ComPtr<IModelObject> spInstance;
-        CheckHr(spConstructable->CreateInstance(sizeof...(args), reinterpret_cast<IModelObject **>(pack.get()), &spInstance));
-        return Object(std::move(spInstance));
-    }
 
-    Object ConstructInstance(_In_ Deconstruction& deconstruction);
+    private:
 
-    // Deconstruct():
-    //
-    // If the object is deconstructable, this returns a deconstruction of the object (a set of constructor
-    // arguments which, if supplied back to the constructor, will recreate the object).
-    //
-    Deconstruction Deconstruct();
+        TGetAtFunction m_getAtFunction;
+        TSetAtFunction m_setAtFunction;
 
-private:
+    };
 
-    // Steal():
-    //
-    // Steals the reference of this object.
-    //
-    IModelObject *Steal()
+    template<typename TClass, typename TGenProjector, typename TItemProjector>
+    class BoundIterable :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            std::conditional_t<IsRandomAccessIterable_v<typename FunctorTraits<TGenProjector>::ReturnType>,
+                               BoundIterableIndexableBase<TClass, TGenProjector, TItemProjector>,
+                               BoundIterableBase<TClass, TGenProjector, TItemProjector>>
+            >
     {
-        return m_spObject.Detach();
-    }
-
-    ComPtr<IModelObject> m_spObject;
+    public:
 
-};
+        BoundIterable(_In_ DataModelReference&& transferredLinkReference,
+                      _In_ const TGenProjector& genProjectionFunction,
+                      _In_ const TItemProjector& itemProjectionFunction,
+                      _In_ IModelObject *pOverrideObject) : BoundIterable(std::move(transferredLinkReference),
+                                                                          nullptr,
+                                                                          genProjectionFunction,
+                                                                          itemProjectionFunction,
+                                                                          pOverrideObject) { }
 
-// IndexedValue:
-//
-// A value which is at a specific index.
-//
-template<typename TValue, typename... TIndicies>
-class IndexedValue
-{
-public:
+        BoundIterable(_In_ DataModelReference&& transferredLinkReference,
+                      _In_ TClass *pClass,
+                      _In_ const TGenProjector& genProjectionFunction,
+                      _In_ const TItemProjector& itemProjectionFunction) : BoundIterable(std::move(transferredLinkReference),
+                                                                                         pClass,
+                                                                                         genProjectionFunction,
+                                                                                         itemProjectionFunction,
+                                                                                         nullptr) { }
 
-    using ValueType = TValue;
-    using IndiciesType = std::tuple<TIndicies...>;
-    static constexpr size_t Dimensionality = sizeof...(TIndicies);
+        BoundIterable(_In_ DataModelReference&& transferredLinkReference,
+                      _In_ TClass *pClass,
+                      _In_ const TGenProjector& genProjectionFunction,
+                      _In_ const TItemProjector& itemProjectionFunction,
+                      _In_ IModelObject *pOverrideObject)
+        {
+            //
+            // This isn't done through base initializers because of the flow through WRL::RuntimeClass.
+            //
+            this->m_pClass = pClass;
+            this->m_itemProjector = itemProjectionFunction;
+            this->m_genProjector = genProjectionFunction;
+            this->m_linkReference = std::move(transferredLinkReference);
+            this->Apply(pOverrideObject);
+        }
+    };
 
-    IndexedValue() { }
+    //*************************************************
+    // Custom Comparison and Equality:
+    //
 
-    IndexedValue(_In_ const TValue &value, _In_ TIndicies... indicies) :
-        m_value(value),
-        m_indicies(std::forward<TIndicies>(indicies)...)
+    template<typename TClass, typename TEquatableProjector>
+    class BoundEquatable :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IEquatableConcept
+            >
     {
-    }
+    public:
 
-    IndexedValue(_In_ const IndexedValue& src) : m_value(src.m_value), m_indicies(src.m_indicies) { }
-    IndexedValue(_In_ IndexedValue&& src) : m_value(std::move(src.m_value)), m_indicies(std::move(src.m_indicies)) { }
+        using EquatableProjectorFunction = typename ClientEx::Details::FunctorTraits<TEquatableProjector>::FunctionType;
 
-    IndexedValue operator=(_In_ const IndexedValue& src) { m_value = src.m_value; m_indicies = src.m_indicies; return *this; }
-    IndexedValue operator=(_In_ IndexedValue&& src) { m_value = std::move(src.m_value); m_indicies = std::move(src.m_indicies); return *this; }
+        BoundEquatable(_In_ TClass *pClass,
+                       _In_ const TEquatableProjector& equatableProjectorFunction)
+        {
+            m_pClass = pClass;
+            m_equatableProjector = equatableProjectorFunction;
+            Apply();
+        }
 
-    const ValueType& GetValue() const { return m_value; }
-    const IndiciesType& GetIndicies() const { return m_indicies; }
+        //*************************************************
+        // IEquatableConcept:
+        //
 
-private:
+        // AreObjectsEqual():
+        //
+        // Compares this object to another (of arbitrary type) for equality.  If
+        // the comparison cannot be performed, E_NOT_SET should be returned.
+        //
+        IFACEMETHOD(AreObjectsEqual)(_In_ IModelObject *pContextObject,
+                                     _In_ IModelObject *pOtherObject,
+                                     _Out_ bool *pIsEqual)
+        {
+            try
+            {
+                ClientEx::Object contextObj = pContextObject;
+                ClientEx::Object otherObj = pOtherObject;
+                *pIsEqual = m_equatableProjector(contextObj, otherObj);
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
+        }
 
-    ValueType m_value;
-    IndiciesType m_indicies;
+    private:
 
-};
+        void Apply()
+        {
+            m_pClass->GetObject()->SetConcept(__uuidof(IEquatableConcept), static_cast<IEquatableConcept *>(this), nullptr);
+        }
 
-// GeneratedIterable:
-//
-// A value which represents the deferred acquisition of an iterable through a method call.  This is a helper
-// intended to allow the adaptation of an iterable described by a C++ input iterator which can be regenerated
-// to the notion of a data model iterable.  Frequently, this is used to defer the acquisition of a generator
-// which is the result of a property binding or method binding.
-//
-// If you have a property which is bound and looks thus:
-//
-//     std::experimental::generator<T> MyProperty(...) { co_yield x; }
-//
-// When the property is fetched, the generator is boxed and the resulting object may only be iterated a single
-// time.  This may or may not be the intent of the caller.
-//
-// Instead, if this object is used:
-//
-//     GeneratedIterable<std::experimental::generator<T>> MyProperty(...)
-//     {
-//          return GeneratedIterable<std::experimental::generator<T>>(
-//              [...](){ co_yield x; }
-//              );
-//     }
-//
-// When the property is fetched, the calling of the method is deferred until the actual iterator fetch.  This way,
-// while a given instance of the iterator behaves akin to a C++ input iterator, the iterator can be fetched
-// multiple times.
-//
-// It is important that the returned iterator produce the same elements (aside any semantic manipulations between
-// iterations) so that the caller's expectations are met.  In other words, a caller which operates as follows:
-//
-//     Object container = someObject.KeyValue(L"MyProperty");
-//     int count1 = (int)container.CallMethod(L"Count");
-//     int count2 = (int)container.CallMethod(L"Count");
-//
-// should not see differing values of count1 and count2.
-//
-template<typename TContainer>
-class GeneratedIterable
-{
-public:
+        TClass *m_pClass;
+        EquatableProjectorFunction m_equatableProjector;
+    };
 
-    explicit GeneratedIterable(_In_ std::function<TContainer(void)> acquireContainer) :
-        m_acquireContainer(acquireContainer)
+    template<typename TClass, typename TComparableProjector>
+    class BoundComparable :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IComparableConcept
+            >
     {
-    }
-
-    std::function<TContainer(void)> const& GetAcquireFunction() const { return m_acquireContainer; }
-
-private:
-
-    std::function<TContainer(void)> m_acquireContainer;
-};
-
-template<typename TValue>
-class ValueWithMetadata
-{
-public:
+    public:
 
-    using ValueType = TValue;
+        using ComparableProjectorFunction = typename ClientEx::Details::FunctorTraits<TComparableProjector>::FunctionType;
 
-    ValueWithMetadata() = default;
+        BoundComparable(_In_ TClass *pClass,
+                       _In_ const TComparableProjector& comparableProjectorFunction)
+        {
+            m_pClass = pClass;
+            m_comparableProjector = comparableProjectorFunction;
+            Apply();
+        }
 
-    ValueWithMetadata(_In_ const TValue &value, _In_ Metadata metadata) :
-        m_value(value),
-        m_metadata(std::move(metadata))
-    {
-    }
-    ValueWithMetadata(TValue&& value, Metadata metadata) :
-        m_value(std::move(value)),
-        m_metadata(std::move(metadata))
-    {
-    }
+        //*************************************************
+        // IComparableConcept:
+        //
 
-    ValueWithMetadata(_In_ const ValueWithMetadata& src) = default;
-    ValueWithMetadata(_In_ ValueWithMetadata&& src) = default;
+        // CompareObjects():
+        //
+        // Compares this object to another (of arbitrary type).  If the comparison
+        // cannot be performed, E_NOT_SET should be returned.
+        //
+        // The return value passed in comparison result has the following meaning:
+        //
+        //    < 0 : contextObject < otherObject
+        //      0 : contextObject == otherObject
+        //    > 0 : contextObject > otherObject
+        //
+        IFACEMETHOD(CompareObjects)(_In_ IModelObject *pContextObject,
+                                    _In_ IModelObject *pOtherObject,
+                                    _Out_ int *pComparisonResult)
+        {
+            try
+            {
+                ClientEx::Object contextObj = pContextObject;
+                ClientEx::Object otherObj = pOtherObject;
+                *pComparisonResult = m_comparableProjector(contextObj, otherObj);
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
+        }
 
-    ValueWithMetadata& operator=(_In_ const ValueWithMetadata& src) = default;
-    ValueWithMetadata& operator=(_In_ ValueWithMetadata&& src) = default;
+    private:
 
-    const ValueType& GetValue() const { return m_value; }
-    ValueType& GetValue() { return m_value; }
-    const Metadata& GetMetadata() const { return m_metadata; }
-    Metadata& GetMetadata() { return m_metadata; }
+        void Apply()
+        {
+            m_pClass->GetObject()->SetConcept(__uuidof(IComparableConcept), static_cast<IComparableConcept *>(this), nullptr);
+        }
 
-private:
+        TClass *m_pClass;
+        ComparableProjectorFunction m_comparableProjector;
+    };
 
-    ValueType m_value;
-    Metadata m_metadata;
-};
+    // BoxObjectBase:
+    //
+    // Base class for the object boxer.  Provides a set of helpers for unboxing.
+    //
+    struct BoxObjectBase
+    {
+    protected:
 
-// Deconstruction:
-//
-// Represents the deconstruction of an object from the deconstructable concept.  It is effectively a
-// "limited serialization" of the object.
-//
-class Deconstruction
-{
-public:
+        // CheckType():
+        //
+        // Checks whether the object is of a "kind" as passed in.  If not, throws
+        // InvalidArgument.
+        //
+        static void CheckType(_In_ const Object& src, _In_ ModelObjectKind requiredKind)
+        {
+            ModelObjectKind mk;
+            HRESULT hr = src->GetKind(&mk);
+            CheckHr(hr);
 
-    Deconstruction(_In_z_ const wchar_t *pConstructableModel,
-                   _In_ ULONG64 argCount,
-                   _In_reads_(argCount) IModelObject **ppArguments) :
-        m_constructableModel(pConstructableModel),
-        m_arguments(ppArguments, ppArguments + argCount)
-    {
-    }
+            if (mk != requiredKind)
+            {
+                throw std::invalid_argument("Illegal object type");
+            }
+        }
 
-    using iterator = std::vector<Object>::iterator;
-    using const_iterator = std::vector<Object>::const_iterator;
+        // ExtractInterface():
+        //
+        // Extracts a raw interface from a boxed interface.
+        //
+        template<typename TInterface>
+        static TInterface *ExtractInterface(_In_ const Object& src)
+        {
+            VARIANT vtVal;
+            HRESULT hr = src->GetIntrinsicValue(&vtVal);
+            CheckHr(hr);
+            if (vtVal.vt != VT_UNKNOWN)
+            {
+                VariantClear(&vtVal);
+                throw std::invalid_argument("Illegal object type");
+            }
 
-    const std::wstring& GetConstructableModelName() const { return m_constructableModel; }
-    iterator begin() { return m_arguments.begin(); }
-    iterator end() { return m_arguments.end(); }
-    const_iterator begin() const { return m_arguments.begin(); }
-    const_iterator end() const { return m_arguments.end(); }
+            //
+            // It is safe to VariantClear and return the raw interface because it is still held by src.
+            //
+            TInterface *pRawInterface = static_cast<TInterface *>(vtVal.punkVal);
+            VariantClear(&vtVal);
+            return pRawInterface;
+        }
+    };
 
-    // ConstructInstance():
+    // BoxObjectIntrinsic:
     //
-    // Constructs a new instance of the original object from the deconstructed set of arguments.
+    // For a given T which is intrinsic, box/unbox the intrinsic
     //
-    Object ConstructInstance()
+    template<typename T>
+    struct BoxObjectIntrinsic : public BoxObjectBase
     {
-        Object model = Object::FromModelName(m_constructableModel);
-        return model.ConstructInstance(*this);
-    }
-
-private:
-
-    std::wstring m_constructableModel;
-    std::vector<Object> m_arguments;
-
-};
-
-//
-// ResourceString:
-//
-// A string which is dynamically pulled from the resources of the binary containing the header.
-// A ResourceString is pulled from the resource file immediately upon boxing.
-//
-struct ResourceString
-{
-    explicit ResourceString(_In_ ULONG id) : Id(id),
-                                             ResourceType(nullptr),
-                                             Module(nullptr)
-    { }
-
-    ResourceString(_In_ ULONG id, _In_ PCWSTR resourceType) : Id(id),
-                                                              ResourceType(resourceType),
-                                                              Module(nullptr)
-    { }
-
-    ResourceString(_In_ ULONG id, _In_ HMODULE hModule) : Id(id),
-                                                          ResourceType(nullptr),
-                                                          Module(hModule)
-    { }
-
-    ResourceString(_In_ ULONG id,
-                   _In_ PCWSTR resourceType,
-                   _In_ HMODULE hModule) : Id(id),
-                                           ResourceType(resourceType),
-                                           Module(hModule)
-    { }
+        static Object Box(_In_ const T& obj)
+        {
+            using ValueType = std::remove_reference_t<T>;
+            using IntrinsicTraits = IntrinsicTypeTraits<ValueType>;
+            static_assert(has_varianttype_field_v<IntrinsicTraits>, "No BoxObject<T>::Box exists for the given type.  Unable to box.");
 
-    ResourceString(_In_ const ResourceString& src) : Id(src.Id),
-                                                     ResourceType(src.ResourceType),
-                                                     Module(src.Module)
-    { }
+            VARIANT vtVal;
+            IntrinsicTraits::FillVariant(&vtVal, obj);
 
-    ULONG Id;
-    PCWSTR ResourceType;
-    HMODULE Module;
-};
+            ComPtr<IModelObject> spObj;
+            HRESULT hr = GetManager()->CreateIntrinsicObject(IntrinsicTraits::ObjectKind, &vtVal, &spObj);
+            CheckHr(hr, spObj);
 
-//
-// DeferredResourceString:
-//
-// A string which is dynamically pulled from the resources of the binary containing the header.
-// A DeferredResourceString is boxes into a property accessor which pulls from the resource
-// string upon being fetched.
-//
-struct DeferredResourceString : public ResourceString
-{
-    template<typename... TArgs> DeferredResourceString(TArgs&&... args) : ResourceString(std::forward<TArgs>(args)...) { }
-};
+            return Object(std::move(spObj));
+        }
 
-//**************************************************************************
-// Private Implementation Details:
-//
+        static T Unbox(_In_ const Object& src)
+        {
+            using IntrinsicTraits = IntrinsicTypeTraits<T>;
+            static_assert(has_varianttype_field_v<IntrinsicTraits>, "No BoxObject<T>::Unbox exists for the given type.  Unable to unbox.");
 
-namespace Details
-{
+            VARIANT vtVal;
+            HRESULT hr = src->GetIntrinsicValueAs(IntrinsicTraits::VariantType, &vtVal);
+            CheckHr(hr);
+            T val = IntrinsicTraits::ExtractFromVariant(&vtVal);
+            VariantClear(&vtVal);
+            return val;
+        }
+    };
 
-    //*************************************************
-    // Type Traits:
+    // BoxMethod:
     //
-    // Defines common traits for auto-boxing and auto-unboxing of intrinsic (and intrinsic-like) values.
+    // For a functor, make a method and box it.  If a statistics slot is supplied, calls of the method are
+    // recorded against it.
     //
+    template<typename TFunc>
+    inline Object BoxMethod(_In_ const TFunc& func, _In_ const std::shared_ptr<AccessorStatsSlot>& spStats = nullptr)
+    {
+        ComPtr<BoxedMethod<TFunc>> spMethodInterface = Make<BoxedMethod<TFunc>>(func, spStats);
+        if (spMethodInterface == nullptr)
+        {
+            throw std::bad_alloc();
+        }
 
-    template<typename TIntrinsic> struct BaseIntrinsicTypeTraits { };
+        // @TODO: This should be part of the boxer.
+        VARIANT vtVal;
+        vtVal.vt = VT_UNKNOWN;
+        vtVal.punkVal = static_cast<IModelMethod *>(spMethodInterface.Get());
+        ComPtr<IModelObject> spMethod;
+        CheckHr(GetManager()->CreateIntrinsicObject(ObjectMethod, &vtVal, &spMethod));
+        return Object(std::move(spMethod));
+    }
 
-    template<> struct BaseIntrinsicTypeTraits<char>
+    // MethodBoxer:
+    //
+    // For an object which is a functor, box/unbox the functor.
+    //
+    template<typename T>
+    struct BoxObjectMethod
     {
-        static const VARTYPE VariantType = VT_I1;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+        static Object Box(_In_ const T& obj)
+        {
+            return BoxMethod(obj);
+        }
     };
 
-    template<> struct BaseIntrinsicTypeTraits<unsigned char>
-    {
-        static const VARTYPE VariantType = VT_UI1;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
-    };
+    // NotImplementedSetFunction:
+    //
+    // A set function that throws not-implemented, used for read-only
+    // properties.
+    //
 
-    template<> struct BaseIntrinsicTypeTraits<short>
+    inline void NotImplementedSetFunction(_In_ const Object& /*instanceObject*/, _In_ const Object& /*value*/)
     {
-        static const VARTYPE VariantType = VT_I2;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
-    };
+        throw not_implemented();
+    }
 
-    template<> struct BaseIntrinsicTypeTraits<unsigned short>
+    // BoxProperty:
+    //
+    // For a pair of get/set functors, make a property and box it.  If a statistics slot is supplied, gets and
+    // sets of the property are recorded against it.
+    //
+    template<typename TGetFunc, typename TSetFunc>
+    inline Object BoxProperty(_In_ const TGetFunc& getFunc,
+                              _In_ const TSetFunc& setFunc,
+                              _In_ const std::shared_ptr<AccessorStatsSlot>& spStats = nullptr)
     {
-        static const VARTYPE VariantType = VT_UI2;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
-    };
+        using GetterTraits = FunctorTraits<TGetFunc>;
+        using SetterTraits = FunctorTraits<TSetFunc>;
+        using Getter0Decay = std::decay_t<typename SetterTraits::template ArgumentType_t<0>>;
+        using Setter0Decay = std::decay_t<typename SetterTraits::template ArgumentType_t<0>>;
 
-    template<> struct BaseIntrinsicTypeTraits<int>
-    {
-        static const VARTYPE VariantType = VT_I4;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
-    };
+        static_assert(SetterTraits::ArgumentCount == 2, "Invalid signature for property set functor");
+        static_assert(GetterTraits::ArgumentCount == 1, "Invalid signature for property get functor");
+        static_assert(std::is_same_v<Getter0Decay, Object>, "Invalid signature for property get functor");
+        static_assert(std::is_same_v<Setter0Decay, Object>, "Invalid signature for property set functor");
 
-    template<> struct BaseIntrinsicTypeTraits<unsigned int>
+        ComPtr<BoxedProperty<TGetFunc, TSetFunc>> spPropertyInterface = Make<BoxedProperty<TGetFunc, TSetFunc>>(getFunc, setFunc, spStats);
+        if (spPropertyInterface == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        // @TODO: This should be part of the boxer.
+        VARIANT vtVal;
+        vtVal.vt = VT_UNKNOWN;
+        vtVal.punkVal = static_cast<IModelPropertyAccessor *>(spPropertyInterface.Get());
+        ComPtr<IModelObject> spProperty;
+        CheckHr(GetManager()->CreateIntrinsicObject(ObjectPropertyAccessor, &vtVal, &spProperty));
+        return Object(std::move(spProperty));
+    }
+
+    // BoxProperty:
+    //
+    // For a get functor, make a property and box it. The implicit set functor
+    // will throw not_implemented.
+    //
+    template <typename TGetFunc>
+    inline Object BoxProperty(_In_ const TGetFunc& getFunc)
     {
-        static const VARTYPE VariantType = VT_UI4;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
-    };
+        return BoxProperty(getFunc, &NotImplementedSetFunction);
+    }
 
-    template<> struct BaseIntrinsicTypeTraits<long>
+    template <typename TGetFunc>
+    inline Object BoxProperty(_In_ const TGetFunc& getFunc, _In_ const std::shared_ptr<AccessorStatsSlot>& spStats)
     {
-        static const VARTYPE VariantType = VT_UI4;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
-    };
+        return BoxProperty(getFunc, &NotImplementedSetFunction, spStats);
+    }
 
-    template<> struct BaseIntrinsicTypeTraits<unsigned long>
+    // BoxObjectArray:
+    //
+    // For a T[N] array, box/unbox it.
+    //
+    template<typename T, size_t N>
+    struct BoxObjectArray
     {
-        static const VARTYPE VariantType = VT_UI4;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+        static Object Box(_In_ const T tArray[N])
+        {
+            Object arrayObject = Object::Create(HostContext());
+            Microsoft::WRL::Make<BoxedArray<T>>(arrayObject, tArray, N);
+            return arrayObject;
+        }
     };
 
-    template<> struct BaseIntrinsicTypeTraits<__int64>
+    template<typename T>
+    struct InterfaceTraits
     {
-        static const VARTYPE VariantType = VT_I8;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
     };
 
-    template<> struct BaseIntrinsicTypeTraits<unsigned __int64>
+    template<> struct InterfaceTraits<IModelMethod>
     {
-        static const VARTYPE VariantType = VT_UI8;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+        static const ModelObjectKind ObjectKind = ObjectMethod;
     };
 
-    template<> struct BaseIntrinsicTypeTraits<float>
+    template<> struct InterfaceTraits<IModelPropertyAccessor>
     {
-        static const VARTYPE VariantType = VT_R4;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+        static const ModelObjectKind ObjectKind = ObjectPropertyAccessor;
     };
 
-    template<> struct BaseIntrinsicTypeTraits<double>
+    template<> struct InterfaceTraits<IModelKeyReference>
     {
-        static const VARTYPE VariantType = VT_R8;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+        static const ModelObjectKind ObjectKind = ObjectKeyReference;
     };
 
-    template<> struct BaseIntrinsicTypeTraits<bool>
+    template<> struct InterfaceTraits<IDebugHostContext>
     {
-        static const VARTYPE VariantType = VT_BOOL;
-        static const ModelObjectKind ObjectKind = ObjectIntrinsic;
+        static const ModelObjectKind ObjectKind = ObjectContext;
     };
 
-    template<typename TIntrinsic> struct IntrinsicTypeTraits : public BaseIntrinsicTypeTraits<TIntrinsic>
+    // BoxObjectInterface:
+    //
+    // Helper class which acts as a boxer/unboxer for various interfaces.
+    //
+    template<typename TInterface>
+    struct BoxObjectInterface : public BoxObjectBase
     {
-        static void FillVariant(VARIANT *pVar, TIntrinsic val)
+        static Object Box(_In_ TInterface *interfacePointer)
         {
-            VariantInit(pVar);
-            pVar->vt = BaseIntrinsicTypeTraits<TIntrinsic>::VariantType;
-            TIntrinsic *pVal = reinterpret_cast<TIntrinsic *>(&pVar->bVal);
-            *pVal = val;
+            ModelObjectKind mk = Details::InterfaceTraits<TInterface>::ObjectKind;
+            VARIANT vtUnk; vtUnk.vt = VT_UNKNOWN; vtUnk.punkVal = interfacePointer;
+            ComPtr<IModelObject> spInterface;
+            CheckHr(GetManager()->CreateIntrinsicObject(mk, &vtUnk, &spInterface));
+            return Object(std::move(spInterface));
         }
 
-        static TIntrinsic ExtractFromVariant(VARIANT *pVar)
+        static TInterface *Unbox(_In_ const Object& src)
         {
-            TIntrinsic *pVal = reinterpret_cast<TIntrinsic *>(&pVar->bVal);
-            return *pVal;
+            CheckType(src, InterfaceTraits<TInterface>::ObjectKind);
+            return ExtractInterface<TInterface>(src);
         }
     };
 
-    template<> struct IntrinsicTypeTraits<bool> : public BaseIntrinsicTypeTraits<bool>
+    // SpotLinkReference:
+    //
+    // Link reference helper class for bindings without an associated model class.
+    //
+    class SpotLinkReference
     {
+    public:
 
-        static void FillVariant(VARIANT *pVar, bool val)
+        SpotLinkReference() : m_dataRef(std::make_shared<DataModelReferenceInfo>()) { }
+        SpotLinkReference(_In_ SpotLinkReference&& src) : m_dataRef(std::move(src.m_dataRef)) { }
+        SpotLinkReference& operator=(_In_ SpotLinkReference&& src) { m_dataRef = std::move(src.m_dataRef); return *this; }
+
+        ~SpotLinkReference()
         {
-            VariantInit(pVar);
-            pVar->vt = VT_BOOL;
-            VARIANT_BOOL *pVal = reinterpret_cast<VARIANT_BOOL *>(&pVar->boolVal);
-            *pVal = val ? VARIANT_TRUE : VARIANT_FALSE;
+            if (m_dataRef != nullptr)
+            {
+                m_dataRef->TypeIsLive = false;
+            }
         }
 
-        static bool ExtractFromVariant(VARIANT *pVar)
+        const DataModelReference& GetLinkReference() const
         {
-            VARIANT_BOOL *pVal = reinterpret_cast<VARIANT_BOOL *>(&pVar->boolVal);
-            return *pVal == VARIANT_TRUE;
+            return m_dataRef;
         }
-    };
-
-    //*************************************************
-    // Trait Helpers for Boxing and Unboxing:
-    //
-
-    template<typename TRet, typename... TArgs, typename TClass>
-    auto GetFunctionType(_In_ TRet (TClass::*)(TArgs...) const) -> std::function<TRet(TArgs...)>;
 
-    template<typename TRet, typename... TArgs, typename TClass>
-    auto GetFunctionType(_In_ TRet (TClass::*)(TArgs...)) -> std::function<TRet(TArgs...)>;
+    private:
 
-    template<size_t argNum, size_t i, typename TArg, typename... TArgs>
-    struct ArgumentTraitHelper : public ArgumentTraitHelper<argNum, i + 1, TArgs...> { };
+        SpotLinkReference(_In_ const SpotLinkReference&) =delete;
+        SpotLinkReference& operator=(_In_ const SpotLinkReference&) =delete;
 
-    template<size_t argNum, typename TArg, typename... TArgs>
-    struct ArgumentTraitHelper<argNum, argNum, TArg, TArgs...>
-    {
-        using ArgumentType = TArg;
+        DataModelReference m_dataRef;
     };
 
-    template<typename TRet, typename... TArgs>
-    struct StdFunctionTraits
+    // EmptyBinding:
+    //
+    // Helper class for bindings without an associated model class.
+    //
+    struct EmptyBinding
     {
-        using ReturnType = TRet;
-        template<size_t i> struct ArgumentTraits : public ArgumentTraitHelper<i, 0, TArgs...> { };
+        IModelObject *GetObject() { throw not_implemented(); }
     };
 
-    template<typename TRet, typename... TArgs>
-    StdFunctionTraits<TRet, TArgs...> GetFunctionTraits(_In_ const std::function<TRet(TArgs...)>&);
-
+    // BoxObjectIterable:
     //
-    // Boy wouldn't it be fun if I didn't have to workaround multiple bugs in the C++ compiler to get this to work.  It's
-    // a song and dance of moving code into and out of function bodies and sprinkling the pixie dust of typename around.
+    // Helper class which acts as a boxer for iterables which have no other specific
+    // boxer.
     //
-    template<size_t i, typename TRet, typename... TArgs>
-    auto GetArgumentType(_In_ const std::function<TRet(TArgs...)>&)
+    template<typename TIterable>
+    struct BoxObjectIterable : public BoxObjectBase
     {
-        using ArgumentType = typename StdFunctionTraits<TRet, TArgs...>::template ArgumentTraits<i>::ArgumentType;
-        using ValueType = std::remove_reference_t<ArgumentType>;
+    public:
 
-        ValueType v{};
-        ArgumentType t = v;
-        return t;
-    }
+        //
+        // We have some move only iterables (e.g.: generators).  Deal with boxing them by moving the container
+        // into the projector and requiring that it live for the lifetime of the iterable (via a linkref)
+        //
+        template<typename TObj>
+        static Object Box(_In_ TObj&& iterable)
+        {
+            static_assert(
+                std::is_same_v<std::decay_t<TObj>, std::decay_t<TIterable>> ||
+                std::is_same_v<std::decay_t<TObj>, std::shared_ptr<TIterable>>,
+                "Illegal argument to BoxObject<T>::Box for an iterable");
+            //
+            // genProjectorFunc is the *HOLDER* of the iterable until such time as it is
+            // used.  It remains the holder during iteration.
+            //
+            // Because we embody the functors in std::function, the lambdas must be copy constructable.  We
+            // cannot directly move iterable into the lambda body.  We must enclose it in something which can be
+            // copied but holds a singular unique moved reference to iterable.
+            //
+            std::shared_ptr<TIterable> spSharedIterable;
+            if constexpr(std::is_same_v<std::decay_t<TObj>, std::shared_ptr<TIterable>>)
+            {
+                spSharedIterable = std::forward<TObj>(iterable);
+            }
+            else
+            {
+                spSharedIterable.reset(new TIterable(std::forward<TObj>(iterable)));
+            }
+            std::shared_ptr<SpotLinkReference> spSpotRef = std::make_shared<SpotLinkReference>();
 
-    template<typename TRet, typename... TArgs>
-    auto GetReturnType(_In_ const std::function<TRet(TArgs...)>&) -> TRet;
+            DataModelReference linkRef = spSpotRef->GetLinkReference();
 
-    template<typename TRet, typename... TArgs> struct StdFunctionCountArguments;
-    template<typename TRet, typename... TArgs>
-    struct StdFunctionCountArguments<std::function<TRet(TArgs...)>>
-    {
-        static constexpr size_t ArgumentCount = sizeof...(TArgs);
-    };
+            auto genProjectorFunc = [heldSpotRef = std::move(spSpotRef),
+                                     mvIterable = std::move(spSharedIterable)](_In_ const Object& /*emptyObject*/) -> TIterable&
+            {
+                return *(mvIterable.get());
+            };
 
-    template<typename TFunc>
-    struct FunctorTraits
-    {
-        using FunctionType = decltype(GetFunctionType(&TFunc::operator()));
-        using ReturnType = decltype(GetReturnType(FunctionType{}));
-        static constexpr size_t ArgumentCount = StdFunctionCountArguments<FunctionType>::ArgumentCount;
+            using TItem = decltype(*(std::declval<std::decay_t<TIterable>>().begin()));
+            auto itemProjectorFunc = [](_In_ TItem eref) { return eref; };
 
-        template<size_t i>
-        struct ArgumentType
-        {
-            using Type = decltype(GetArgumentType<i>(FunctionType{}));
-        };
+            //
+            // Create an empty object which represents this container and place and iterable upon it.
+            // @TODO: It might be better performance to create a data model with this and attach.
+            //
+            Object container = Object::Create(HostContext());
 
-        template<size_t i> using ArgumentType_t = typename ArgumentType<i>::Type;
-    };
+            using TGenProjector = decltype(genProjectorFunc);
+            using TItemProjector = decltype(itemProjectorFunc);
 
-    template<typename TRet, typename... TArgs>
-    struct FunctorTraits<TRet(*)(TArgs...)>
-    {
-        using FunctionType = std::function<TRet(TArgs...)>;
-        using ReturnType = TRet;
-        static constexpr size_t ArgumentCount = sizeof...(TArgs);
+            ComPtr<BoundIterable<EmptyBinding, TGenProjector, TItemProjector>> spIterable;
 
-        template<size_t i>
-        struct ArgumentType
-        {
-            using Type = decltype(GetArgumentType<i>(FunctionType{}));
-        };
+            // NOTE:
+            //
+            // The construction of the binding will apply it to the object 'container'.  After
+            // the below line, the iterable concept on 'container' is spIterable.
+            //
+            spIterable = Make<BoundIterable<EmptyBinding, TGenProjector, TItemProjector>>(
+                std::move(linkRef), genProjectorFunc, itemProjectorFunc, container
+                );
 
-        template<size_t i> using ArgumentType_t = typename ArgumentType<i>::Type;
+            return container;
+        }
     };
 
-    template<typename TClass, typename TRet, typename... TArgs>
-    struct ClassMethodTraits
-    {
-        using FunctionType = std::function<TRet(TArgs...)>;
-        using ReturnType = TRet;
-        static constexpr size_t ArgumentCount = sizeof...(TArgs);
-
-        template<size_t i>
-        struct ArgumentType
-        {
-            using Type = decltype(GetArgumentType<i>(FunctionType{}));
-        };
-
-        template<size_t i> using ArgumentType_t = typename ArgumentType<i>::Type;
-    };
+} // Details
 
-    template<typename TClass, typename TRet, typename... TArgs>
-    ClassMethodTraits<TClass, TRet, TArgs...> GetClassMethodTraits(_In_ TRet (TClass::*)(TArgs...));
+//**************************************************************************
+// Object Boxing and Unboxing
+//
 
+namespace Boxing
+{
+    namespace Details = Debugger::DataModel::ClientEx::Details;
 
+    // Function and Method Boxing and Unboxing:
     //
-    // NOTE: The following multiple definitions of void_t (as priv_void_t1, _t2, etc...) are to work around
-    //       a compiler bug involving alias templates.  Without this, only the first has_* which uses the *void_t
-    //       will function correctly.
-    //
-    template<class ...> using priv_void_t1 = void;
-    template<class ...> using priv_void_t2 = void;
-    template<class ...> using priv_void_t3 = void;
-    template<class ...> using priv_void_t4 = void;
-    template<class ...> using priv_void_t5 = void;
-    template<class ...> using priv_void_t6 = void;
-
-    template<class, class = priv_void_t1<> > struct has_call_operator : std::false_type { };
-    template<class T> struct has_call_operator<T, priv_void_t1<decltype(&T::operator())>> : std::true_type { };
-    template<class T> constexpr bool has_call_operator_v = has_call_operator<T>::value;
 
-    template<class, typename TArg, class = priv_void_t2<> > struct has_box_method : std::false_type { };
-    template<class T, typename TArg> struct has_box_method<T, TArg, priv_void_t2<decltype(T::Box(std::declval<TArg>()))>> : std::true_type { };
-    template<class T, typename TArg> constexpr bool has_box_method_v = has_box_method<T, TArg>::value;
+    template<typename T, typename = void>
+    struct BoxObject : public std::conditional_t<Details::has_call_operator_v<T>,
+                                                 Details::BoxObjectMethod<T>,
+                                                 std::conditional_t<Details::IsIterable_v<T>,
+                                                                    Details::BoxObjectIterable<T>,
+                                                                    Details::BoxObjectIntrinsic<T>>>
+    {
+    };
 
-    template<class, class = priv_void_t3<> > struct has_unbox_method : std::false_type { };
-    template<class T> struct has_unbox_method<T, priv_void_t3<decltype(&T::Unbox)>> : std::true_type { };
-    template<class T> constexpr bool has_unbox_method_v = has_unbox_method<T>::value;
+    template<typename T>
+    struct BoxObject<std::shared_ptr<T>, std::enable_if_t<Details::IsIterable_v<T>>> : Details::BoxObjectIterable<T>
+    {
+    };
 
-    template<class, class = priv_void_t6<> > struct has_varianttype_field : std::false_type { };
-    template<class T> struct has_varianttype_field<T, priv_void_t6<decltype(T::VariantType)>> : std::true_type { };
-    template<class T> constexpr bool has_varianttype_field_v = has_varianttype_field<T>::value;
+    // Array View Boxing:
+    //
+    // A SharedArrayView boxes into an iterable and indexable array which aliases the viewed storage.
+    //
+    template<typename T>
+    struct BoxObject<SharedArrayView<T>>
+    {
+        static Object Box(_In_ const SharedArrayView<T>& arrayView)
+        {
+            Object arrayObject = Object::Create(HostContext());
+            Microsoft::WRL::Make<Details::BoxedArray<T>>(arrayObject, arrayView.Data, arrayView.Size, arrayView.Storage);
+            return arrayObject;
+        }
+    };
 
-    template<typename T> struct ArrayTraits
+    template<typename TRet, typename... TArgs>
+    struct BoxObject<TRet (*)(TArgs...)> : public Details::BoxObjectMethod<TRet (*)(TArgs...)>
     {
-        using Type = T;
-        static constexpr size_t Size = 0;
     };
 
-    template<typename T, size_t N>
-    struct ArrayTraits<T[N]>
+    template<typename TRet, typename... TArgs>
+    struct BoxObject<TRet(TArgs...)> : public Details::BoxObjectMethod<TRet (*)(TArgs...)>
     {
-        using Type = T;
-        static constexpr size_t Size = N;
     };
 
-    template<typename T> using ArrayTraits_t = typename ArrayTraits<T>::Type;
+    // Details Reference Type Boxing/Unboxing:
+    //
+    // Specializations of BoxObject<T> for types returned as C++ references.
+    //
 
-    template<typename T> struct MetadataTraits
+    template<typename TVal, typename... TIndicies>
+    struct BoxObject<IndexedValue<TVal, TIndicies...>>
     {
-        static void FillMetadata(T const&, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        static Object Box(_In_ const IndexedValue<TVal, TIndicies...>& src)
         {
-            if (ppMetadata)
-            {
-                *ppMetadata = nullptr;
-            }
+            return BoxObject<TVal>::Box(src.GetValue());
         }
     };
 
-    template<typename TVal> struct MetadataTraits<ValueWithMetadata<TVal>>
+    template<typename TVal>
+    struct BoxObject<ValueWithMetadata<TVal>>
     {
-        static void FillMetadata(ValueWithMetadata<TVal>& val, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        static Object Box(_In_ const ValueWithMetadata<TVal>& src)
         {
-            if (ppMetadata)
-            {
-                *ppMetadata = val.GetMetadata().Detach();
-            }
+            return BoxObject<TVal>::Box(src.GetValue());
         }
+    };
 
-        // For boxed arrays, metadata might end up copied out multiple times, rather than being a transient object that can be detached
-        static void FillMetadata(ValueWithMetadata<TVal> const& val, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+    template<>
+    struct BoxObject<Details::ObjectKeyRef<Object, Metadata>>
+    {
+        static Object Box(_In_ const Details::ObjectKeyRef<Object, Metadata>& keyRef)
         {
-            if (ppMetadata)
-            {
-                *ppMetadata = val.GetMetadata();
-                val.GetMetadata()->AddRef();
-            }
+            return keyRef.GetValue();
         }
     };
 
-    // Enable IndexedValue<ValueWithMetadata<...>, ...>
-    template<typename TVal, typename... TIndices> struct MetadataTraits<IndexedValue<TVal, TIndices...>>
+    template<>
+    struct BoxObject<Details::ObjectFieldRef<Object>>
     {
-        static void FillMetadata(IndexedValue<TVal, TIndices...>& val, _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        static Object Box(_In_ const Details::ObjectFieldRef<Object>& fieldRef)
         {
-            MetadataTraits<TVal>::FillMetadata(val.GetValue(), ppMetadata);
+            return fieldRef.GetValue();
         }
     };
 
-    template<typename T, typename = void> struct IsIterable : std::false_type { };
-    template<typename T> struct IsIterable<T, ClientEx::Details::priv_void_t4<decltype(std::declval<T>().begin()), decltype(std::declval<T>().end())>> : std::true_type { };
-
-    template<typename TCatTag> struct IsRandomAccessTag : std::false_type {};
-    template<> struct IsRandomAccessTag<std::random_access_iterator_tag> : std::true_type { };
-
-    template<typename T, typename = void> struct IsRandomAccessIterator : std::false_type { };
-    template<typename T> struct IsRandomAccessIterator<T, ClientEx::Details::priv_void_t5<typename std::iterator_traits<T>::iterator_category>> :
-        IsRandomAccessTag<typename std::iterator_traits<T>::iterator_category> { };
-
-    template<typename T> struct IsRandomAccessIterable : IsRandomAccessIterator<decltype(std::declval<T>().begin())> { };
-
-    template<typename T> constexpr bool IsIterable_v = IsIterable<T>::value;
-    template<typename T> constexpr bool IsRandomAccessTag_v = IsRandomAccessTag<T>::value;
-    template<typename T> constexpr bool IsRandomAccessIterator_v = IsRandomAccessIterator<T>::value;
-    template<typename T> constexpr bool IsRandomAccessIterable_v = IsRandomAccessIterable<T>::value;
-
-    template<typename TVal, typename TIter, bool IsRandom>
-    struct IndexerTraits
+    template<>
+    struct BoxObject<Details::DereferenceReference<Object>>
     {
-        static bool CheckDimensions(_In_ ULONG64 dimensionality)
+        static Object Box(_In_ const Details::DereferenceReference<Object>& derefRef)
         {
-            return dimensionality == 0;
+            return derefRef.GetValue();
         }
+    };
 
-        static void CreateIndexers(_In_ const TVal& /*val*/,
-                                   _In_ const TIter& /*itBegin*/,
-                                   _In_ const TIter& /*itCur*/,
-                                   _In_ ULONG64 /*dimensionality*/,
-                                   _Out_opt_ ClientEx::Object * /*pIndexers*/)
+    template<typename TPack>
+    struct BoxObject<Details::IndexableReference<Object, TPack>>
+    {
+        static Object Box(_In_ const Details::IndexableReference<Object, TPack>& indexableRef)
         {
+            return indexableRef.GetValue();
         }
+    };
 
-        static void FillIndexers(_In_ ULONG64 /*dimensionality*/,
-                                 _In_ ClientEx::Object * /*pIndexers*/,
-                                 _Out_ IModelObject ** /*ppIndexers*/)
+    // String Boxing/Unboxing:
+    //
+    // Specializations of BoxObject<T> for string types.
+    //
+    template<>
+    struct BoxObject<const wchar_t *>
+    {
+        static Object Box(_In_z_ const wchar_t *pString)
         {
+            //
+            // @TODO: It would be nice to have a better mechanism of string creation in DbgModel.  This is a double
+            // alloc.  Wasteful.
+            //
+            BSTR bstrStr = SysAllocString(pString);
+            if (bstrStr == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return BoxBstr(bstr_ptr(bstrStr));
         }
 
-        static constexpr ULONG64 Dimensionality = 0;
+        // BoxBstr():
+        //
+        // Boxes an already allocated BSTR (e.g.: one produced directly from a narrow string or a counted buffer).
+        //
+        static Object BoxBstr(_In_ bstr_ptr spStr)
+        {
+            VARIANT vtVal;
+            vtVal.vt = VT_BSTR;
+            vtVal.bstrVal = spStr.get();
+            ComPtr<IModelObject> spString;
+            ClientEx::CheckHr(GetManager()->CreateIntrinsicObject(ObjectIntrinsic, &vtVal, &spString));
+            return Object(std::move(spString));
+        }
     };
 
-    //
-    // An iterable which returns IndexedValue<> is declaring that it **DIRECTLY** supports providing the indicies
-    // itself.
-    //
-    template<typename TIter, bool IsRandom, typename TVal, typename... TIndicies>
-    struct IndexerTraits<ClientEx::IndexedValue<TVal, TIndicies...>, TIter, IsRandom>
+    template<>
+    struct BoxObject<wchar_t *>
     {
-        static bool CheckDimensions(_In_ ULONG64 dimensionality)
+        static Object Box(_In_z_ const wchar_t *pString)
         {
-            return (dimensionality == 0 || dimensionality == sizeof...(TIndicies));
+            return BoxObject<const wchar_t *>::Box(pString);
         }
+    };
 
-        static void CreateIndexers(_In_ const ClientEx::IndexedValue<TVal, TIndicies...>& indexedValue,
-                                   _In_ const TIter& /*itBegin*/,
-                                   _In_ const TIter& /*itCur*/,
-                                   _In_ ULONG64 dimensionality,
-                                   _Out_opt_ ClientEx::Object *pIndexers)
+    template<>
+    struct BoxObject<std::wstring>
+    {
+        static Object Box(_In_ const std::wstring& str)
         {
-            if (dimensionality == sizeof...(TIndicies))
+            BSTR bstrStr = SysAllocStringLen(str.data(), static_cast<UINT>(str.size()));
+            if (bstrStr == nullptr)
             {
-                ClientEx::Details::ParameterPack pack = ClientEx::Details::PackTuple(indexedValue.GetIndicies());
-                for (ULONG64 i = 0; i < dimensionality; ++i)
-                {
-                    pIndexers[static_cast<size_t>(i)] = std::move(pack[static_cast<size_t>(i)]);
-                }
+                throw std::bad_alloc();
             }
+            return BoxObject<const wchar_t *>::BoxBstr(bstr_ptr(bstrStr));
         }
 
-        static void FillIndexers(_In_ ULONG64 dimensionality,
-                                 _In_reads_(dimensionality) ClientEx::Object *pIndexers,
-                                 _Out_writes_opt_(dimensionality) IModelObject ** ppIndexers)
+        static std::wstring Unbox(_In_ const Object& src)
         {
-            if (dimensionality == sizeof...(TIndicies))
-            {
-                for (ULONG64 i = 0; i < dimensionality; ++i)
-                {
-                    ppIndexers[i] = pIndexers[i].Detach();
-                }
-            }
+            VARIANT vtVal;
+            CheckHr(src->GetIntrinsicValueAs(VT_BSTR, &vtVal));
+            bstr_ptr spvVal(vtVal.bstrVal);
+            return std::wstring(vtVal.bstrVal, SysStringLen(vtVal.bstrVal));
         }
-
-        static constexpr ULONG64 Dimensionality = sizeof...(TIndicies);
     };
 
-    template<typename TVal, typename TIter>
-    struct IndexerTraits<TVal, TIter, true>
+    template<>
+    struct BoxObject<std::string>
     {
-        static bool CheckDimensions(_In_ ULONG64 dimensionality)
+        static Object Box(_In_ const std::string& str)
         {
-            return (dimensionality == 0 || dimensionality == 1);
+            //
+            // Convert straight into the BSTR handed to the data model rather than through an intermediate wide string.
+            //
+            return BoxObject<const wchar_t *>::BoxBstr(Details::StringUtils::GetBstr(str.data(), str.size()));
         }
 
-        static void CreateIndexers(_In_ const TVal& /*val*/,
-                                   _In_ const TIter& itBegin,
-                                   _In_ const TIter& itCur,
-                                   _In_ ULONG64 dimensionality,
-                                   _Out_opt_ ClientEx::Object *pIndexers)
+        static std::string Unbox(_In_ const Object& src)
         {
-            if (dimensionality == 1)
-            {
-                ClientEx::Object idx;
-                idx = static_cast<ULONG64>(itCur - itBegin);
-                pIndexers[0] = std::move(idx);
-            }
+            VARIANT vtVal;
+            CheckHr(src->GetIntrinsicValueAs(VT_BSTR, &vtVal));
+            bstr_ptr spvVal(vtVal.bstrVal);
+            return Details::StringUtils::GetNarrowString(vtVal.bstrVal, SysStringLen(vtVal.bstrVal));
         }
+    };
+
+    //
+    // Enum class Boxing/Unboxing:
+    //
+    // TEnum is an enum class
+    //
+    // Example use (make TTD::SequenceId projectable to data model):
+    //     namespace Debugger::DataModel::ClientEx::Boxing
+    //     {
+    //         template <> struct BoxObject<TTD::SequenceId> : UnderlyingTypeBoxObject<TTD::SequenceId> {};
+    //     }
 
-        static void FillIndexers(_In_ ULONG64 dimensionality,
-                                 _In_reads_(dimensionality) ClientEx::Object *pIndexers,
-                                 _Out_writes_opt_(dimensionality) IModelObject ** ppIndexers)
+    template <typename TEnum>
+    struct UnderlyingTypeBoxObject
+    {
+        static Object Box(_In_ const TEnum& obj)
         {
-            if (dimensionality == 1)
-            {
-                ppIndexers[0] = pIndexers[0].Detach();
-            }
+            return BoxObject<std::underlying_type_t<TEnum>>::Box(static_cast<std::underlying_type_t<TEnum>>(obj));
         }
 
-        static const ULONG64 Dimensionality = 1;
+        static TEnum Unbox(_In_ const Object& src)
+        {
+            return static_cast<TEnum>(static_cast<std::underlying_type_t<TEnum>>(src));
+        }
     };
 
-    //*************************************************
-    // VarArgs unpack analysis:
-    //
-    // If the last two arguments to any method we bind to are
-    //
-    //     (size_t, Object *)
     //
-    // the function is varargs. We unpack and type match the static types before
-    // the size_t, Object * and then put the remainder of the arguments in the
-    // list defined by those two arguments.
+    // String Resource Boxing/Unboxing:
     //
-    // These helpers analyze the type signature of a method to determine if it is
-    // a var args method and whether a given position is the var args position.
+    // ResourceString is pulled upon boxing (once per process through ResourceStringCache)
+    // DeferredResourceString is boxed into a property which pulls upon GetValue.
     //
 
-    // bool IsVariableArgumentPosition_v<TArgs...>
-    //     determines whether the position at TArgs is a variable argument position (a size_t, Object *) at the end of pack
-    //
-    // bool HasVariableArguments_v<TArgs...>
-    //     determines whether the pack contains a terminating (size_t, Object *) -- a signature of varargs
+    template<>
+    struct BoxObject<ResourceString>
+    {
+        static Object Box(_In_ const ResourceString& rscString)
+        {
+            return ResourceStringCache::Instance().GetBoxedString(rscString);
+        }
+    };
 
-    template<typename... TArgs> struct IsVariableArgumentPosition : public std::false_type { };
-    template<> struct IsVariableArgumentPosition<size_t, Object *> : public std::true_type { };
-    template<typename... TArgs> struct HasVariableArgumentHelper2;
-    template<typename TArg1, typename TArg2, typename... TArgs> struct HasVariableArgumentHelper2<TArg1, TArg2, TArgs...> : public HasVariableArgumentHelper2<TArg2, TArgs...> { };
-    template<typename TArg1, typename TArg2> struct HasVariableArgumentHelper2<TArg1, TArg2> : public IsVariableArgumentPosition<TArg1, TArg2> { };
-    template<size_t i, typename... TArgs> struct HasVariableArgumentHelper : public HasVariableArgumentHelper2<TArgs...> {};
-    template<typename... TArgs> struct HasVariableArgumentHelper<0, TArgs...> : public std::false_type { };
-    template<typename... TArgs> struct HasVariableArgumentHelper<1, TArgs...> : public std::false_type { };
-    template<typename... TArgs> struct HasVariableArguments : public HasVariableArgumentHelper<sizeof...(TArgs), TArgs...> {};
+    template<>
+    struct BoxObject<DeferredResourceString>
+    {
+        static Object Box(_In_ const DeferredResourceString& rscString)
+        {
+            auto getFunc = [rscString](_In_ const Object& /*instanceObject*/)
+            {
+                ResourceString activePull = rscString;
+                return BoxObject<ResourceString>::Box(activePull);
+            };
 
-    template<typename... TArgs> constexpr bool IsVariableArgumentPosition_v = IsVariableArgumentPosition<TArgs...>::value;
-    template<typename... TArgs> constexpr bool HasVariableArguments_v = HasVariableArguments<TArgs...>::value;
+            auto setFunc = [](_In_ const Object& /*instanceObject*/, _In_ const Object& /*value*/)
+            {
+                throw not_implemented();
+            };
 
-    //*************************************************
-    // Optional unpack analysis:
-    //
-    // If any argument in the function is std::optional<T>, it is optional and does not need an
-    // argument in the incoming dynamic pack to bind against the static one.  This performs analysis
-    // to determine optional arguments, positions, and whether there is illegality (static arguments
-    // after optional ones)
-    //
+            return Details::BoxProperty(getFunc, setFunc);
+        }
+    };
 
-    // bool IsOptionalArgument_v<T>
-    //     true iff T is std::optional<TOpt>
+    // Interface Boxing/Unboxing:
+    //
+    // Specializations of BoxObject<T> for known interface pointers.
     //
-    // bool IsNonOptionalARgument_v<T>
-    //     true iff T is not std::optional<TOpt>
-
-    template<typename T> struct IsOptionalArgument : public std::false_type { };
-    template<typename TOpt> struct IsOptionalArgument<std::optional<TOpt>> : public std::true_type { };
-    template<typename T> struct IsNonOptionalArgument : public std::true_type { };
-    template<typename TOpt> struct IsNonOptionalArgument<std::optional<TOpt>> : public std::false_type { };
 
-    template<typename T> constexpr bool IsOptionalArgument_v = IsOptionalArgument<T>::value;
-    template<typename T> constexpr bool IsNonOptionalArgument_v = IsNonOptionalArgument<T>::value;
+    template<> struct BoxObject<IDebugHostContext *> : public Details::BoxObjectInterface<IDebugHostContext> { };
+    template<> struct BoxObject<IModelMethod *> : public Details::BoxObjectInterface<IModelMethod> { };
+    template<> struct BoxObject<IModelPropertyAccessor *> : public Details::BoxObjectInterface<IModelPropertyAccessor> { };
+    template<> struct BoxObject<IModelKeyReference *> : public Details::BoxObjectInterface<IModelKeyReference> { };
 
-    // bool HasNonOptionalArguments_v<TArgs...>
-    //     determines whether the argument pack in TArgs contains a non optional argument.  That is, it contains a
-    //     non std::optional<TOpt> **UNLESS** that non optional argument is a final size_t, Object * in the
-    //     argument pack.
+    // ComPtr<T>
+    //
+    // Specializations of BoxObject<T> for ComPtr<Known Interface>
+    //
 
-    template<typename... TArgs> struct HasNonOptionalArguments : public std::true_type { };
-    template<typename T> struct HasNonOptionalArguments<T> : public IsNonOptionalArgument<T> { };
-    template<typename T, typename... TArgs> struct HasNonOptionalArguments<T, TArgs...>
+    template<typename T>
+    struct BoxObject<ComPtr<T>>
     {
-    private:
-
-        static constexpr bool GetHasNonOptional()
+        static Object Box(_In_ const ComPtr<T>& cptr)
         {
-            //
-            // If the argument set <T, TArgs...> is VarArgs (size_t, Object *) with nothing following, there are no non-optional arguments
-            //
-            if (IsVariableArgumentPosition_v<T, TArgs...>) { return false; }
-
-            //
-            // If the current argument is non-optional (we've already checked a VarArgs slot), we have non-optional arguments in the set.
-            //
-            if (IsNonOptionalArgument_v<T>) { return true; }
-
-            //
-            // Subsequently, everything is repeated recursively on TArgs... as an argument set.
-            //
-            return HasNonOptionalArguments<TArgs...>::value;
+            return BoxObject<T*>::Box(cptr.Get());
         }
 
-    public:
-
-        static constexpr bool value = GetHasNonOptional();
+        static ComPtr<T> Unbox(_In_ const Object& src)
+        {
+            T *pRawInterface = BoxObject<T*>::Unbox(src);
+            return ComPtr<T>(pRawInterface);
+        }
     };
-    template<typename... TArgs> constexpr bool HasNonOptionalArguments_v = HasNonOptionalArguments<TArgs...>::value;
 
-    // bool HasOptionalArguments_v<TArgs...>
-    //     determines whether the argument pack contains a legal optional argument (one or more std::optional<TOpt>
-    //     arguments after which there are no non std::optional<TOpt> arguments unless those arguments are a varargs
-    //     pack -- a final size_t, Object *)
+    // No Operation Boxing/Unboxing
     //
-    //     If there is a violation of ordering of the std::optional<TOpt>, this will fire a static assert.
+    // Specializations of BoxObject<T> for objects and interfaces which are already boxed.
     //
 
-    template<typename... TArgs> struct HasOptionalArguments : public std::false_type { };
-    template<typename T> struct HasOptionalArguments<T> : public IsOptionalArgument<T> { };
-    template<typename T, typename... TArgs> struct HasOptionalArguments<T, TArgs...>
+    template<>
+    struct BoxObject<IModelObject *>
     {
-    public:
-        static constexpr bool isCurrentOptional = IsOptionalArgument_v<T>;
-        static constexpr bool HasNextOptional()
+        static Object Box(_In_ IModelObject * src)
         {
-            constexpr bool nextOptional = HasOptionalArguments<TArgs...>::value;
-            constexpr bool allNextOptional = !HasNonOptionalArguments_v<TArgs...>;
-            static_assert(!isCurrentOptional || allNextOptional, "Any std::optional<T> must come before any non optional (or non varArgs) argument");
-            return nextOptional;
+            return Object(src);
         }
 
-    public:
-        static constexpr bool value = (isCurrentOptional | HasNextOptional());
+        static IModelObject *Unbox(_In_ const Object& src)
+        {
+            return src.GetObject();
+        }
     };
-    template<typename... TArgs> constexpr bool HasOptionalArguments_v = HasOptionalArguments<TArgs...>::value;
 
-    // size_t FirstOptionalArgumentPosition_v<TArgs...>
-    //
-    // Gives the 0-based position of the first std::optional<T> within the pack.  If there is no such value, the
-    // size of the pack is returned in lieu.
-    //
+    template<>
+    struct BoxObject<Object>
+    {
+        static Object Box(_In_ const Object& src)
+        {
+            return src;
+        }
 
-    template<size_t i, typename... TArgs> struct FirstOptionalArgumentPositionHelper : public std::integral_constant<size_t, i + sizeof...(TArgs)> { };
-    template<size_t i, typename T, typename... TArgs> struct FirstOptionalArgumentPositionHelper<i, T, TArgs...> : public FirstOptionalArgumentPositionHelper<i + 1, TArgs...> { };
-    template<size_t i, typename T> struct FirstOptionalArgumentPositionHelper<i, T> : public std::integral_constant<size_t, i + 1> { };
-    template<size_t i, typename TOpt> struct FirstOptionalArgumentPositionHelper<i, std::optional<TOpt>> : public std::integral_constant<size_t, i> { };
-    template<size_t i, typename TOpt, typename... TArgs> struct FirstOptionalArgumentPositionHelper<i, std::optional<TOpt>, TArgs...> : public std::integral_constant<size_t, i> { };
-    template<typename... TArgs> struct FirstOptionalArgumentPosition : public FirstOptionalArgumentPositionHelper<0, TArgs...> { };
-    template<typename... TArgs> constexpr size_t FirstOptionalArgumentPosition_v = FirstOptionalArgumentPosition<TArgs...>::value;
+        static Object Unbox(_In_ const Object& src)
+        {
+            return src;
+        }
+    };
 
-    //*************************************************
-    // General unpack
-    //
+    template<> struct BoxObject<const Object&> : public BoxObject<Object> { };
 
-    // size_t PackMatchingSize_v<TArgs...>
-    //
-    // Computes how many static arguments we need to have within a dynamic argument set to statically bind against
-    // a given argument pack.
-    //
-    // In effect, this set of templates is looking at a C++ method signature which is comprised of three things:
-    //
-    //     - Some types T
-    //     - Some optional types, std::optional<T>
-    //     - VarArgs at the end (size_t, Object *)
-    //
-    // and determining how many *REQUIRED* arguments there are in order to make a call to the method from the data model.
-    // The number of required arguments is the number of types T that come before any optional argument or VarArgs position.
-    //
-    template<typename... TArgs> struct PackMatchingSize
+    template<> struct BoxObject<std::nullptr_t>
     {
-    private:
+        static Object Box(_In_ std::nullptr_t)
+        {
+            return Object();
+        }
 
-        static constexpr size_t GetMatchingSize()
+        static std::nullptr_t Unbox(_In_ const Object& src)
         {
-            //
-            // If we have a std::optional<T>, we can stop there.  It is illegal to have static arguments
-            // after that.  If not, and we have variable arguments defined by (size_t, Object *) at the
-            // end, the position is the pack size minus two (for the two varargs "arguments")
-            //
-            constexpr bool hasOptional = HasOptionalArguments_v<TArgs...>;
-            constexpr bool hasVarArgs = HasVariableArguments_v<TArgs...>;
+            if (src.GetObject() != nullptr)
+            {
+                throw std::invalid_argument("Only an empty object can unbox to nullptr_t");
+            }
+            return nullptr;
+        }
+    };
 
-            if (hasOptional)
+    //
+    // Optional Boxing/Unboxing:
+    //
+
+    template<typename T>
+    struct BoxObject<std::optional<T>>
+    {
+        static Object Box(_In_ const std::optional<T>& src)
+        {
+            if (src.has_value())
             {
-                return FirstOptionalArgumentPosition_v<TArgs...>;
+                return BoxObject<T>::Box(src.value());
+            }
+            else
+            {
+                return Object::CreateNoValue();
             }
+        }
 
-            if (hasVarArgs)
+        static Object Box(_Inout_ std::optional<T>&& src)
+        {
+            if (src.has_value())
             {
-                return sizeof...(TArgs) - 2;
+                return BoxObject<T>::Box(*std::move(src));
+            }
+            else
+            {
+                return Object::CreateNoValue();
             }
+        }
 
-            return sizeof...(TArgs);
+        static std::optional<T> Unbox(_In_ const Object& src)
+        {
+            ModelObjectKind mk;
+            CheckHr(src->GetKind(&mk));
+            if (mk == ObjectNoValue)
+            {
+                return std::nullopt;
+            }
+            else
+            {
+                return BoxObject<T>::Unbox(src);
+            }
         }
+    };
 
-    public:
+    template<>
+    struct BoxObject<HostContext>
+    {
+        static Object Box(_In_ const HostContext& src)
+        {
+            Object boxedObject = static_cast<IDebugHostContext *>(src);
+            return boxedObject;
+        }
 
-        static constexpr size_t value = GetMatchingSize();
+        static HostContext Unbox(_In_ const Object& src)
+        {
+            return src;
+        }
     };
-    template<typename... TArgs> constexpr size_t PackMatchingSize_v = PackMatchingSize<TArgs...>::value;
 
-    // size_t PackMatchingSize_WithIgnore_v<size_t ignoreCount, TArgs...>
     //
-    // Ignores the first 'ignoreCount' arguments in TArgs... and then computes PackMatchingSize_v of the remaining
-    // argument pack.
+    // Deferred container boxing for generators:
     //
-    template<size_t i, size_t ignoreCount, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper;
-    template<size_t i, size_t ignoreCount, typename TArg1, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper2 : public PackMatchingSize_WithIgnore_Helper<i + 1, ignoreCount, TArgs...> { };
-    template<size_t i, size_t ignoreCount, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper : public PackMatchingSize_WithIgnore_Helper2<i, ignoreCount, TArgs...> { };
-    template<size_t i, typename... TArgs> struct PackMatchingSize_WithIgnore_Helper<i, i, TArgs...> : public PackMatchingSize<TArgs...> { };
-    template<size_t ignoreCount, typename... TArgs> struct PackMatchingSize_WithIgnore : public PackMatchingSize_WithIgnore_Helper<0, ignoreCount, TArgs...> { };
-    template<typename... TArgs> struct PackMatchingSize_WithIgnore<0, TArgs...> : public PackMatchingSize<TArgs...> { };
-    template<size_t ignoreCount, typename... TArgs> constexpr size_t PackMatchingSize_WithIgnore_v = PackMatchingSize_WithIgnore<ignoreCount, TArgs...>::value;
-
-    // Unpack helpers:
-
-    template<typename TTuple, size_t i, size_t remaining>
-    struct RegularUnpacker
+    template<typename TContainer>
+    struct BoxObject<GeneratedIterable<TContainer>>
     {
-        static void UnpackInto(_In_ size_t packSize,
-                               _In_reads_(packSize) IModelObject **ppArgumentPack,
-                               TTuple& tuple);
-    };
+        //
+        // We have some move only iterables (e.g.: generators).  Deal with boxing them by moving the container
+        // into the projector and requiring that it live for the lifetime of the iterable (via a linkref)
+        //
+        template<typename TContainer>
+        static Object Box(_In_ const GeneratedIterable<TContainer>& src)
+        {
+            //
+            // genProjectorFunc holds the functor and calls it to produce the iterable for the
+            // BoundIterable.
+            //
+            std::shared_ptr<Details::SpotLinkReference> spSpotRef = std::make_shared<Details::SpotLinkReference>();
+            std::function<TContainer(void)> acquireFunction = src.GetAcquireFunction();
 
-    template<typename TTuple, size_t i, size_t remaining> struct Unpacker : public RegularUnpacker<TTuple, i, remaining> { };
+            Details::DataModelReference linkRef = spSpotRef->GetLinkReference();
 
-    template<typename TTuple, size_t i, size_t remaining>
-    struct VariableUnpacker
-    {
-        static void UnpackInto(_In_ size_t packSize, _In_reads_(packSize) IModelObject **ppArgumentPack, TTuple& tuple)
-        {
-            if (i >= packSize)
+            auto genProjectorFunc = [heldSpotRef = std::move(spSpotRef),
+                                     acquireFunction = std::move(acquireFunction)](_In_ const Object& /*emptyObject*/) -> TContainer
             {
-                return;
-            }
+                return acquireFunction();
+            };
+
+            using TItem = decltype(*(std::declval<std::decay_t<TContainer>>().begin()));
+            auto itemProjectorFunc = [](_In_ TItem eref) { return eref; };
+
+            //
+            // Create an empty object which represents this container and place and iterable upon it.
+            // @TODO: It might be better performance to create a data model with this and attach.
+            //
+            Object container = Object::Create(HostContext());
 
-            size_t variableArgumentCount = packSize - i;
-            std::get<i>(tuple) = variableArgumentCount;
+            using TGenProjector = decltype(genProjectorFunc);
+            using TItemProjector = decltype(itemProjectorFunc);
+
+            ComPtr<Details::BoundIterable<Details::EmptyBinding, TGenProjector, TItemProjector>> spIterable;
 
+            // NOTE:
             //
-            // @TODO: Perhaps Object * isn't the right thing.  This reinterpret is *PROBABLY* safe given the structural
-            // requirements on Object (it must lay out in memory as a single IModelObject *.
+            // The construction of the binding will apply it to the object 'container'.  After
+            // the below line, the iterable concept on 'container' is spIterable.
             //
-            std::get<i + 1>(tuple) = reinterpret_cast<Object *>(ppArgumentPack + i);
+            spIterable = Make<Details::BoundIterable<Details::EmptyBinding, TGenProjector, TItemProjector>>(
+                std::move(linkRef), genProjectorFunc, itemProjectorFunc, container
+                );
+
+            return container;
         }
     };
 
     //
-    // If the last 2 arguments are a variable argument pack, perform a special packing.
+    // Memoized container boxing:
     //
-    template<typename TTuple, size_t i>
-    struct Unpacker<TTuple, i, 2> : std::conditional_t<IsVariableArgumentPosition_v<typename std::tuple_element_t<i, TTuple>, std::tuple_element_t<i + 1, TTuple>>, VariableUnpacker<TTuple, i, 2>, RegularUnpacker<TTuple, i, 2>>
-    {
-    };
-
-    template<typename TTuple, size_t i>
-    struct Unpacker<TTuple, i, 0>
+    template<typename TContainer>
+    struct BoxObject<MaterializedIterable<TContainer>>
     {
-        static void UnpackInto(_In_ size_t /*packSize*/, _In_ IModelObject ** /*ppArgumentPack*/, TTuple& /*tuple*/)
+        static Object Box(_In_ const MaterializedIterable<TContainer>& src)
         {
+            Object container = Object::Create(HostContext());
+            Make<Details::MaterializedContainer<TContainer>>(container, src);
+            return container;
         }
     };
 
-    template<size_t i, size_t extractCount, typename... TArgs> struct TupleTypeExtractorHelper;
+#ifdef DBGMODELCLIENTEX_NO_GENERATOR_BOXING
 
-    template<size_t i, size_t extractCount, typename TArg1, typename... TArgs>
-    struct TupleTypeExtractorHelper2
-    {
-        using Type = typename TupleTypeExtractorHelper<i + 1, extractCount, TArgs...>::Type;
-    };
+    template<typename TGen>
+    struct IsGenerator : public std::false_type { };
 
-    template<size_t i, size_t extractCount, typename... TArgs>
-    struct TupleTypeExtractorHelper
-    {
-        using Type = typename TupleTypeExtractorHelper2<i, extractCount, TArgs...>::Type;
-    };
+    template<typename TGen>
+    struct IsGenerator<std::experimental::generator<TGen>> : public std::true_type { };
 
-    template<size_t i, typename... TArgs>
-    struct TupleTypeExtractorHelper<i, i, TArgs...>
+    template<typename TGen> constexpr bool IsGenerator_v = IsGenerator<TGen>::value;
+
+    template<typename TGen>
+    struct BoxObject<std::experimental::generator<TGen>>
     {
-        using Type = std::tuple<TArgs...>;
+        static Object Box(_In_ const std::experimental::generator<TGen>& src)
+        {
+            static_assert(!IsGenerator_v<std::experimental::generator<TGen>>, "Boxing of a std::experimental::generator<T> results in an object which can only ever be iterated once!");
+            return Object();
+        }
     };
 
-    // TupleTypeExtractor:
+#endif // DBGMODELCLIENTEX_NO_GENERATOR_BOXING
+
+} // Boxing
+
+namespace Details
+{
     //
-    // Removes the first 'extractCount' arguments from TArgs... and returns a tuple of said
-    // arguments.
+    // char[] and wchar_t[] will box as strings rather than arrays of characters!
     //
-    template<size_t extractCount, typename... TArgs>
-    struct TupleTypeExtractor
-    {
-        using Type = typename TupleTypeExtractorHelper<0, extractCount, TArgs...>::Type;
-    };
+    template<size_t N> struct BoxObjectArray<char, N> : public Boxing::BoxObject<const char *> { };
+    template<size_t N> struct BoxObjectArray<const char, N> : public Boxing::BoxObject<const char *> { };
+    template<size_t N> struct BoxObjectArray<wchar_t, N> : public Boxing::BoxObject<const wchar_t *> { };
+    template<size_t N> struct BoxObjectArray<const wchar_t, N> : public Boxing::BoxObject<const wchar_t *> { };
 
-    template<typename... TArgs>
-    struct TupleTypeExtractor<0, TArgs...>
+    // BoxSelector:
+    //
+    // Class which redirects array types to BoxObjectArray if T is an array and to BoxObject<std::decay_t<T>> for non
+    // array types.
+    //
+    template<typename T> struct BoxSelector :
+        public std::conditional_t<std::is_array_v<T>,
+                                  typename Details::BoxObjectArray<Details::ArrayTraits_t<T>, Details::ArrayTraits<T>::Size>,
+                                  Boxing::BoxObject<std::decay_t<T>>>
     {
-        using Type = typename std::tuple<TArgs...>;
     };
+} // Boxing
 
-    template<size_t tupleExtractionCount, typename... TArgs>
-    using TupleTypeExtractor_t = typename TupleTypeExtractor<tupleExtractionCount, TArgs...>::Type;
+//*************************************************
+// Direct Boxing and Unboxing Method Calls:
+//
 
-    // UnpackValues():
+// BoxObject():
+//
+// Takes any object and packs it into a data model object, returning an Object instance.
+//
+// New types can be added to the boxer by adding an explicit template specialization.
+//
+template<typename T>
+Object BoxObject(T&& obj)
+{
     //
-    // Takes a model parameter pack and expands it out into a std::tuple with extraction by type
-    // as determined by the TArgs... types.  The first "tupleExtractionCount" arguments will be
-    // skipped when creating the tuple.
+    // template<typename T> ... T&& can bind T to TX& or TX.  We want the base type.
+    // We do *NOT* want to std::decay_t<T> to get the base because we want to preserve any
+    // array types.  Instead, we effectively want std::remove_cvref_t.  Unfortunately, that
+    // is C++20 and this is a C++17 lib.  Go the verbose route.
     //
-    template<size_t tupleExtractionCount, typename... TArgs>
-    decltype(auto) UnpackValues(_In_ size_t packSize, _In_reads_(packSize) IModelObject **ppArgumentPack)
-    {
-        using ArgumentTypes = TupleTypeExtractor_t<tupleExtractionCount, std::decay_t<TArgs>...>;
-        ArgumentTypes tuple;
-        Unpacker<ArgumentTypes, 0, sizeof...(TArgs) - tupleExtractionCount>::UnpackInto(packSize, ppArgumentPack, tuple);
-        return tuple;
-    }
+    using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    //
+    // We do not want to decay arrays in order to box them.  Delegate to a box selector which will specially
+    // handle array types.
+    //
+    using TBox = Details::BoxSelector<TBase>;
+    using TFwd = decltype(std::forward<T>(obj));
+    static_assert(Details::has_box_method_v<TBox, TFwd>, "No BoxObject<T>::Box exists for the given type.  Unable to box.");
+
+    return TBox::Box(std::forward<T>(obj));
+}
 
+// UnboxObject():
 //
-// @TODO: The compiler insists that 't' is unreferenced in the below.  It is not.  Remove the warning
-//        by pragma for now.
+// Takes a data model Object instance and unboxes it into a value of the type T.
 //
-#pragma warning(push)
-#pragma warning(disable: 4100)
+// New types can be added to the unboxer by adding an explicit template specialization.
+//
+template<typename T>
+decltype(auto) UnboxObject(_In_ const Object& src)
+{
+    using TBox = Boxing::BoxObject<T>;
+    static_assert(Details::has_unbox_method_v<TBox>, "No BoxObject<T>::Unbox exists for the given type.  Unable to unbox.");
 
-    template <class F, class Tuple, std::size_t... I, typename... TExtraValues>
-    constexpr decltype(auto) ApplyImpl(F&& f,
-                                       const Object& contextObj,
-                                       Tuple&& t,
-                                       std::index_sequence<I...>,
-                                       TExtraValues&&... extraValues)
-    {
-        return std::invoke(std::forward<F>(f), contextObj, std::forward<TExtraValues>(extraValues)..., std::get<I>(std::forward<Tuple>(t))...);
-    }
+    return TBox::Unbox(src);
+};
 
-    template <class F, class Tuple, std::size_t... I>
-    constexpr decltype(auto) LiteralApplyImpl(F&& f, Tuple&& t, std::index_sequence<I...>)
+//**************************************************************************
+// Forward Implementations:
+//
+
+inline Type Symbol::Type() const
+{
+    ComPtr<IDebugHostType> spType;
+    CheckHr(m_spSymbol->GetType(&spType));
+    return ClientEx::Type(std::move(spType));
+}
+
+inline Module Symbol::ContainingModule() const
+{
+    ComPtr<IDebugHostModule> spModule;
+    CheckHr(m_spSymbol->GetContainingModule(&spModule));
+    return Module(std::move(spModule));
+}
+
+inline Expected<Object> Object::TryDereference() const
+{
+    ComPtr<IModelObject> spDeref;
+    HRESULT hr = m_spObject->Dereference(&spDeref);
+    if (FAILED(hr))
     {
-        return std::invoke(std::forward<F>(f), std::get<I>(std::forward<Tuple>(t))...);
+        return Unexpected(hr);
     }
+    return Object(std::move(spDeref));
+}
 
-    template<class T>
-    struct ConstructorApplyImpl
+inline Object ResourceStringCache::GetBoxedString(_In_ const ResourceString& rscString)
+{
     {
-        template<class Tuple, std::size_t... I>
-        static constexpr decltype(auto) Apply(Tuple&& t, std::index_sequence<I...>)
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_cacheObjects)
         {
-            return T(std::get<I>(std::forward<Tuple>(t))...);
+            auto it = m_entries.find(MakeKey(rscString));
+            if (it != m_entries.end() && it->second.BoxedString.GetObject() != nullptr)
+            {
+                return it->second.BoxedString;
+            }
         }
-    };
+    }
 
-    template <class F, class Tuple, typename... TExtraValues>
-    constexpr decltype(auto) Apply(F&& f, const Object& contextObj, Tuple&& t, TExtraValues&&... extraValues)
+    std::shared_ptr<const std::wstring> spString = GetString(rscString);
+    Object boxedString = Boxing::BoxObject<std::wstring>::Box(*spString);
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_cacheObjects)
     {
-        return ApplyImpl(
-            std::forward<F>(f), contextObj, std::forward<Tuple>(t),
-            std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{},
-            std::forward<TExtraValues>(extraValues)...);
+        auto it = m_entries.find(MakeKey(rscString));
+        if (it != m_entries.end())
+        {
+            if (it->second.BoxedString.GetObject() == nullptr)
+            {
+                it->second.BoxedString = boxedString;
+            }
+            return it->second.BoxedString;
+        }
     }
+    return boxedString;
+}
+
+//**************************************************************************
+// Template Function Implementations:
+//
+
+template<typename TStr>
+Type Module::FindType(_In_ TStr&& typeName) const
+{
+    ComPtr<IDebugHostType> spType;
+    CheckHr(AsModule()->FindTypeByName(ClientEx::Details::ExtractString(typeName), &spType));
+    return ClientEx::Type(std::move(spType));
+}
+
+inline Object Constant::Value() const
+{
+    VARIANT vtValue;
+    CheckHr(AsConstant()->GetValue(&vtValue));
+    ComPtr<IModelObject> spObj;
+    HRESULT hr = GetManager()->CreateIntrinsicObject(ObjectIntrinsic, &vtValue, &spObj);
+    VariantClear(&vtValue);
+    CheckHr(hr);
+    return Object(std::move(spObj));
+}
+
+inline Object Field::GetValue() const
+{
+    VARIANT vtValue;
+    CheckHr(AsField()->GetValue(&vtValue));
+    ComPtr<IModelObject> spObj;
+    HRESULT hr = GetManager()->CreateIntrinsicObject(ObjectIntrinsic, &vtValue, &spObj);
+    VariantClear(&vtValue);
+    CheckHr(hr);
+    return Object(std::move(spObj));
+}
+
+inline Object Metadata::KeyValue(_In_z_ const wchar_t *keyName) const
+{
+    ComPtr<IModelObject> spValue;
+    CheckHr(Details::Tracing::HostCall("GetKeyValue", [&]() { return m_spKeyStore->GetKeyValue(keyName, &spValue, nullptr); }));
+    Object value = std::move(spValue);
+    return value;
+}
+
+template<typename TArg, typename TEnable>
+Object::Object(TArg&& value)
+{
+    Object assignment = BoxObject(std::forward<TArg>(value));
+    m_spObject.Attach(assignment.Steal());
+}
+
+template<typename TArg, typename TEnable>
+Object& Object::operator=(TArg&& assignmentValue)
+{
+    Object assignment = BoxObject(std::forward<TArg>(assignmentValue));
+    m_spObject.Attach(assignment.Steal());
+    return *this;
+}
 
-    template <class F, class Tuple>
-    constexpr decltype(auto) LiteralApply(F&& f, Tuple&& t)
-    {
-        return LiteralApplyImpl(
-            std::forward<F>(f), std::forward<Tuple>(t),
-            std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{});
-    }
+template<typename TType>
+TType Object::As() const
+{
+    return UnboxObject<TType>(m_spObject.Get());
+}
 
-    template <class T, class Tuple>
-    constexpr decltype(auto) ConstructorApply(Tuple&& t)
-    {
-        return ConstructorApplyImpl<T>::Apply(
-            std::forward<Tuple>(t),
-            std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>{}
-            );
-    }
+template<typename... TArgs>
+Object Object::Call(_In_ const Object& instance, TArgs&&... callArguments) const
+{
+    auto pack = Details::PackValues(std::forward<TArgs>(callArguments)...);
 
-#pragma warning(pop)
+    ComPtr<IModelObject> spObject;
+    HRESULT hr = As<IModelMethod *>()->Call(instance, sizeof...(callArguments), reinterpret_cast<IModelObject **>(pack.get()), &spObject, nullptr);
+    CheckHr(hr, spObject);
 
-    // InvokeAndBox():
+    Object result(std::move(spObject));
+    return result;
+}
+
+namespace Details
+{
+    // ParallelInvoke():
     //
-    // Calls a function with a tuple of arguments and boxes the return value into an Object.
+    // Invokes the function of a parallel evaluation on an element.  The function may either take just the element
+    // or the element and the context of the worker.
     //
-    template<typename TRet, typename TFunc, typename TTuple>
-    struct InvokeAndBox
+    template<typename TFunc>
+    decltype(auto) ParallelInvoke(_In_ TFunc& func, _In_ const Object& element, _In_ const HostContext& workerContext)
     {
-        template<typename... TExtraValues>
-        static Object Call(_In_ const TFunc& func,
-                           _In_ const Object& contextObj,
-                           _In_ const TTuple& parameters,
-                           _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
-                           _In_ TExtraValues&&... extraValues)
+        if constexpr(std::is_invocable_v<TFunc&, const Object&, const HostContext&>)
         {
-            TRet result = Apply(func, contextObj, parameters, std::forward<TExtraValues>(extraValues)...);
-            Object resultObject = BoxObject(std::move(result));
-            MetadataTraits<TRet>::FillMetadata(result, ppMetadata);
-            return resultObject;
+            return func(element, workerContext);
         }
-    };
+        else
+        {
+            return func(element);
+        }
+    }
 
-    // InvokeAndBox():
+    // ParallelEvaluate():
     //
-    // Calls a void returning function with a tuple of arguments.  Boxes "NoValue" into an Object
-    // and returns it to represent the void value.
+    // Calls elementFunc(index, context) for every index in [0, count) across a set of threads.  The
+    // first exception thrown by any call stops the remaining work and is rethrown on the calling thread.
     //
-    template<typename TFunc, typename TTuple>
-    struct InvokeAndBox<void, TFunc, TTuple>
+    // Serialized calls are made inline on the calling thread.  Worker threads would only queue on the lock, and a
+    // nested parallel call from within elementFunc would join workers waiting for the lock its caller holds.
+    //
+    template<typename TElementFunc>
+    void ParallelEvaluate(_In_ size_t count,
+                          _In_ const HostContext& context,
+                          _In_ const ParallelOptions& options,
+                          _In_ const TElementFunc& elementFunc)
     {
-        template<typename... TExtraValues>
-        static Object Call(_In_ const TFunc& func,
-                           _In_ const Object& contextObj,
-                           _In_ const TTuple& parameters,
-                           _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
-                           _In_ TExtraValues&&... extraValues)
+        if (options.SerializeCallbacks)
         {
-            Apply(func, contextObj, parameters, std::forward<TExtraValues>(extraValues)...);
-            if (ppMetadata)
+            for (size_t i = 0; i < count; ++i)
             {
-                *ppMetadata = nullptr;
+                std::lock_guard<std::recursive_mutex> lock(GetHostSerializationLock());
+                elementFunc(i, context);
             }
-            ComPtr<IModelObject> spNoValue;
-            CheckHr(GetManager()->CreateNoValue(&spNoValue));
-            return Object(std::move(spNoValue));
+            return;
         }
-    };
-
 
-    // LiteralInvokeAndBox():
-    //
-    // Calls a function with a tuple of arguments and boxes the result into an Object.  This does not
-    // inject the usual "methods" signature bindings of the data model's "context object" and any such
-    // extra parameters.
-    //
-    template<typename TRet, typename TFunc, typename TTuple>
-    struct LiteralInvokeAndBox
-    {
-        static Object Call(_In_ const TFunc& func, _In_ const TTuple& parameters)
+        size_t chunkSize = (options.ChunkSize != 0) ? options.ChunkSize : 1;
+        size_t concurrency = options.MaxConcurrency;
+        if (concurrency == 0)
         {
-            TRet result = LiteralApply(func, parameters);
-            Object resultObject = BoxObject(result);
-            return resultObject;
+            concurrency = std::thread::hardware_concurrency();
         }
-    };
-
-    // ConstructAndBox:
-    //
-    // Calls a constructor and boxes the resulting object into an Object.
-    //
-    template<typename TInstance, typename TTuple>
-    struct ConstructAndBox
-    {
-        static Object Construct(_In_ const TTuple& arguments)
+        size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+        if (concurrency > chunkCount)
         {
-            TInstance result = ConstructorApply(arguments);
-            Object resultObject = BoxObject(result);
-            return resultObject;
+            concurrency = chunkCount;
         }
 
-    };
-
-    // InvokeFunctionFromPack:
-    //
-    // For a std::function<TRet(TArgs...), convert a dynamic set of arguments from the data model and
-    // a set of static additional arguments to the types within the TArgs... signature, call the function,
-    // and box the result.
-    //
-    // The expected signature of the function is TRet(const Object&, convert_if_possible<TExtraValues>..., convert_if_possible<UNPACK>)
-    //
-    template<typename TRet, typename... TArgs, typename... TExtraValues>
-    Object InvokeFunctionFromPack(_In_ const std::function<TRet(TArgs...)>& func,
-                                  _In_ const Object& contextObj,
-                                  _In_ size_t packSize,
-                                  _In_reads_(packSize) IModelObject **ppArgumentPack,
-                                  _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
-                                  _In_ TExtraValues&&... extraValues)
-
-    {
-        // We need to determine the minimum number of arguments which will correctly match against the incoming
-        // argument list.  The signature of the std::function must be Object&, TExtraValues(convertable)..., TArgs...
-        //
-        // There can be std::optional<T> arguments (which stops the mandatory static argument count)
-        // There can be VarArgs (a TArgs... which ends with size_t, Object *)
-        //
+        std::atomic<size_t> nextElement(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr firstException;
+        std::mutex exceptionLock;
 
-        //
-        // Compute the minimum pack size via a helper:
-        //
-        constexpr size_t extraArgumentCount = sizeof...(extraValues);
-        constexpr size_t packIgnoreCount = extraArgumentCount + 1;          // + 1 == const Object& (instanceObject)
-        constexpr size_t minPackSize = PackMatchingSize_WithIgnore_v<packIgnoreCount, TArgs...>;
+        auto workerFunc = [&]()
+        {
+            //
+            // Every worker shares the caller's host context (see "Per-worker context").  The copy only saves the
+            // function from reaching back into the caller's frame.
+            //
+            HostContext workerContext = context;
+            try
+            {
+                while (!failed.load(std::memory_order_relaxed))
+                {
+                    size_t start = nextElement.fetch_add(chunkSize);
+                    if (start >= count)
+                    {
+                        break;
+                    }
 
-        //
-        // Compute the maximum pack size (it's either the static size of the pack minus the ignore count or it's infinite
-        // (if we have varargs)
-        //
-        constexpr size_t maxStaticPack = sizeof...(TArgs) - packIgnoreCount;
-        constexpr bool isVarArgs = HasVariableArguments_v<TArgs...>;
+                    size_t end = (count - start > chunkSize) ? start + chunkSize : count;
+                    for (size_t i = start; i < end && !failed.load(std::memory_order_relaxed); ++i)
+                    {
+                        elementFunc(i, workerContext);
+                    }
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionLock);
+                if (!firstException)
+                {
+                    firstException = std::current_exception();
+                }
+                failed = true;
+            }
+        };
 
         //
-        // If the caller has not passed an argument list which can match the pack via size, immediately throw.
+        // The calling thread is one of the workers.  If a thread cannot be created, the evaluation proceeds
+        // with however many were.
         //
-        if (packSize < minPackSize || (packSize > maxStaticPack && !isVarArgs))
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < concurrency; ++i)
         {
-            throw std::invalid_argument("Illegal number of arguments to method call");
+            try
+            {
+                workers.emplace_back(workerFunc);
+            }
+            catch(const std::system_error&)
+            {
+                break;
+            }
         }
 
-        auto parameters = UnpackValues<packIgnoreCount, TArgs...>(packSize, ppArgumentPack);
-
-        return InvokeAndBox<TRet, decltype(func), decltype(parameters)>::
-            template Call<TExtraValues...>(func, contextObj, parameters, ppMetadata, std::forward<TExtraValues>(extraValues)...);
-    }
-
-    // LiteralInvokeFunctionFromPack:
-    //
-    // For a std::function<TRet(TArgs...), convert a dynamic set of arguments from the data model to the types
-    // within the TArgs... signature, call the function, and box the result.
-    //
-    // The expected signature of the function is TRet(convert_if_possible<UNPACK>)
-    //
-    template<typename TRet, typename... TArgs>
-    Object LiteralInvokeFunctionFromPack(_In_ const std::function<TRet(TArgs...)>& func,
-                                         _In_ size_t packSize,
-                                         _In_reads_(packSize) IModelObject **ppArgumentPack)
-    {
-        // We need to determine the minimum number of arguments which will correctly match against the incoming
-        // argument list.  The signature of the std::function must be TArgs...
-        //
-        // There can be std::optional<T> arguments (which stops the mandatory static argument count)
-        // There can be VarArgs (a TArgs... which ends with size_t, Object *)
-        //
-
-        //
-        // Compute the minimum pack size via a helper:
-        //
-        constexpr size_t extraArgumentCount = 0;
-        constexpr size_t packIgnoreCount = extraArgumentCount + 0;
-        constexpr size_t minPackSize = PackMatchingSize_WithIgnore_v<packIgnoreCount, TArgs...>;
-
-        //
-        // Compute the maximum pack size (it's either the static size of the pack minus the ignore count or it's infinite
-        // (if we have varargs)
-        //
-        constexpr size_t maxStaticPack = sizeof...(TArgs) - packIgnoreCount;
-        constexpr bool isVarArgs = HasVariableArguments_v<TArgs...>;
+        workerFunc();
 
-        //
-        // If the caller has not passed an argument list which can match the pack via size, immediately throw.
-        //
-        if (packSize < minPackSize || (packSize > maxStaticPack && !isVarArgs))
+        for (auto& worker : workers)
         {
-            throw std::invalid_argument("Illegal number of arguments to method call");
+            worker.join();
         }
 
-        auto parameters = UnpackValues<packIgnoreCount, TArgs...>(packSize, ppArgumentPack);
-        return LiteralInvokeAndBox<TRet, decltype(func), decltype(parameters)>::Call(func, parameters);
+        if (firstException)
+        {
+            std::rethrow_exception(firstException);
+        }
     }
 
-    // InvokeMethodFromPack:
+    // SnapshotElements():
     //
-    // Invokes a functor from a data model parameter pack matching all the static types.  In addition,
-    // passes a set of extra arguments as determined by TExtraValues... to the function.
+    // Collects the elements of an iterable object.
     //
-    template<typename TFunc, typename... TExtraValues>
-    Object InvokeMethodFromPack(_In_ const TFunc& func,
-                                _In_ const Object& contextObj,
-                                _In_ size_t packSize,
-                                _In_reads_(packSize) IModelObject **pArgumentPack,
-                                _Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
-                                _In_ TExtraValues&&... extraValues)
+    inline std::vector<Object> SnapshotElements(_In_ const Object& iterable)
     {
-        return InvokeFunctionFromPack(FunctorTraits<TFunc>::FunctionType(func),
-                                      contextObj,
-                                      packSize,
-                                      pArgumentPack,
-                                      ppMetadata,
-                                      std::forward<TExtraValues>(extraValues)...);
+        std::vector<Object> elements;
+        for (const std::vector<Object>& batch : iterable.IterateBatched())
+        {
+            elements.insert(elements.end(), batch.begin(), batch.end());
+        }
+        return elements;
     }
+}
 
-    //*************************************************
-    // Instance Data Packer:
-    //
-
-    template<typename TInstance, typename TType>
-    struct is_member_data_pointer_of : std::false_type { };
-
-    template<typename TInstance, typename TData>
-    struct is_member_data_pointer_of<TInstance, TData TInstance::*> : std::true_type { };
-
-    template<typename TInstance, typename TData>
-    constexpr bool is_member_data_pointer_of_v = is_member_data_pointer_of<TInstance, TData>::value;
-
-    template<typename TArg>
-    struct MemberPointerDataTypeExtractor
-    {
-    };
-
-    template<typename TInstance, typename TData>
-    struct MemberPointerDataTypeExtractor<TData TInstance::*>
-    {
-        using DataType = TData;
-    };
-
-    template<typename TInstance, typename TData>
-    struct MemberPointerDataTypeExtractor<TData TInstance::* const>
-    {
-        using DataType = TData;
-    };
-
-    template<typename... TArgs>
-    struct MemberPointerCollectionTupleTypeExtractor
+template<typename TFunc>
+void Object::ForEachElement(_In_ TFunc&& func, _In_ const ParallelOptions& options) const
+{
+    std::vector<Object> elements = Details::SnapshotElements(*this);
+    HostContext context = *this;
+    Details::ParallelEvaluate(elements.size(), context, options, [&](_In_ size_t index, _In_ const HostContext& workerContext)
     {
-        using TupleType = std::tuple<typename MemberPointerDataTypeExtractor<std::decay_t<TArgs>>::DataType...>;
-    };
+        Details::ParallelInvoke(func, elements[index], workerContext);
+    });
+}
 
-    template<size_t i, typename TInstance, typename TTuple, typename... TArgs>
-    struct TupleInstancePacker;
+template<typename TFunc>
+auto Object::TransformElements(_In_ TFunc&& func, _In_ const ParallelOptions& options) const
+    -> std::vector<Details::ParallelResult_t<TFunc>>
+{
+    using TResult = Details::ParallelResult_t<TFunc>;
+    static_assert(!std::is_same_v<TResult, bool>, "TransformElements cannot produce std::vector<bool>.  Return a different type");
+    static_assert(std::is_default_constructible_v<TResult>, "The result of a TransformElements function must be default constructible");
+
+    std::vector<Object> elements = Details::SnapshotElements(*this);
+    std::vector<TResult> results(elements.size());
+    HostContext context = *this;
+    Details::ParallelEvaluate(elements.size(), context, options, [&](_In_ size_t index, _In_ const HostContext& workerContext)
+    {
+        results[index] = Details::ParallelInvoke(func, elements[index], workerContext);
+    });
+    return results;
+}
 
-    template<size_t i, typename TInstance, typename TTuple>
-    struct TupleInstancePacker<i, TInstance, TTuple>
+template<typename... TArgs>
+Expected<Object> Object::TryCall(_In_ const Object& instance, TArgs&&... callArguments) const
+{
+    auto pack = Details::PackValues(std::forward<TArgs>(callArguments)...);
+
+    ModelObjectKind mk;
+    HRESULT hr = m_spObject->GetKind(&mk);
+    if (SUCCEEDED(hr) && mk != ObjectMethod)
     {
-        static void PackInto(TTuple& /* tuple */, TInstance * /*pInstance*/)
-        {
-        }
-    };
+        hr = E_INVALIDARG;
+    }
 
-    template<size_t i, typename TInstance, typename TTuple, typename TArg, typename... TArgs>
-    struct TupleInstancePacker<i, TInstance, TTuple, TArg, TArgs...>
+    ComPtr<IModelMethod> spMethod;
+    if (SUCCEEDED(hr))
     {
-        static void PackInto(TTuple& tuple, TInstance *pInstance, TArg&& firstArg, TArgs&&... subsequentArgs)
+        VARIANT vtVal;
+        hr = m_spObject->GetIntrinsicValue(&vtVal);
+        if (SUCCEEDED(hr))
         {
-            static_assert(is_member_data_pointer_of_v<TInstance, std::decay_t<TArg>>, "Supplied data must be a pointer-to-member of the instance type");
-
-            std::get<i>(tuple) = pInstance->*firstArg;
-            TupleInstancePacker<i + 1, TInstance, TTuple, TArgs...>::PackInto(tuple, pInstance, std::forward<TArgs>(subsequentArgs)...);
+            if (vtVal.vt == VT_UNKNOWN)
+            {
+                hr = vtVal.punkVal->QueryInterface(IID_PPV_ARGS(&spMethod));
+            }
+            else
+            {
+                hr = E_INVALIDARG;
+            }
+            VariantClear(&vtVal);
         }
-    };
+    }
 
-    // PackTupleInstanceData():
-    //
-    // Takes a series of "pointer-to-member-data" of TInstance, resolves them into data, and packs that data
-    // into a tuple<DataTypes...> and returns it.
-    //
-    template<typename TInstance, typename... TArgs>
-    decltype(auto) PackTupleInstanceData(TInstance *pInstance, TArgs&&... args)
+    if (FAILED(hr))
     {
-        using TupleType = typename MemberPointerCollectionTupleTypeExtractor<TArgs...>::TupleType;
+        return Unexpected(hr);
+    }
 
-        TupleType tuple;
-        TupleInstancePacker<0, TInstance, TupleType, TArgs...>::PackInto(
-            tuple, pInstance, std::forward<TArgs>(args)...
-            );
-        return tuple;
+    ComPtr<IModelObject> spObject;
+    hr = spMethod->Call(instance, sizeof...(callArguments), reinterpret_cast<IModelObject **>(pack.get()), &spObject, nullptr);
+    if (FAILED(hr))
+    {
+        return Unexpected(hr, std::move(spObject));
     }
 
-    //*************************************************
-    // Box and Unbox Helpers:
-    //
+    return Object(std::move(spObject));
+}
 
-    // BoxedProperty:
-    //
-    // A data model implementation of a property which is bound to a C++ functor.
-    //
-    template<typename TGetter, typename TSetter>
-    class BoxedProperty : public
-        Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IModelPropertyAccessor
-            >
+template<typename... TArgs>
+Details::IndexableReference<Object, Details::ParameterPack> Object::Index(TArgs&&... indexers) const
+{
+    auto pack = Details::PackValues(std::forward<TArgs>(indexers)...);
+
+    ComPtr<IIndexableConcept> spIndexable;
+    HRESULT hr = m_spObject->GetConcept(__uuidof(IIndexableConcept), &spIndexable, nullptr);
+    if (FAILED(hr))
     {
-    public:
+        ClientEx::Type objectType = Type();
 
-        BoxedProperty(_In_ const TGetter& getterFunc, _In_ const TSetter& setterFunc) :
-            m_getterFunc(getterFunc), m_setterFunc(setterFunc)
+        //
+        // If the type is a pointer and the pack size is one and it's a standard pointer (not a C++ reference or other
+        // pseudo-pointer), we can still deal with this as "indexable" through plain old pointer math.
+        //
+        // Create an adapter object that makes it look like any other indexable object to the underlying IndexableReference<>
+        //
+#pragma warning(push)
+#pragma warning(disable: 4127)
+        if (sizeof...(indexers) == 1 && objectType.GetKind() == TypePointer && objectType.GetPointerKind() == PointerStandard)
         {
-            using TGetRet = std::decay_t<typename FunctorTraits<TGetter>::ReturnType>;
-            using TSetRet = typename FunctorTraits<TSetter>::ReturnType;
-            static_assert(!std::is_same_v<TGetRet, void>, L"Property getter must return a value");
-            static_assert(std::is_same_v<TSetRet, void>, L"Property setter must not return a value");
+            spIndexable = Make<Details::PointerIndexerAdapter>();
+            hr = S_OK;
         }
+#pragma warning(pop)
+    }
+    CheckHr(hr);
 
-        //*************************************************
-        // IModelPropertyAccessor:
-        //
+    return Details::IndexableReference<Object, Details::ParameterPack>(sizeof...(indexers), std::move(pack), std::move(spIndexable), GetObject());
+}
 
-        // GetValue():
-        //
-        // Gets the value of the underlying property by calling the functor.
-        //
-        IFACEMETHOD(GetValue)(_In_ PCWSTR /*propertyName*/, _In_opt_ IModelObject *pContextObject, _COM_Outptr_ IModelObject **ppValue)
+namespace Details
+{
+    // IsCompatibleElementType():
+    //
+    // Determines whether elements of the given native type can be copied byte for byte into a T.
+    //
+    template<typename T>
+    bool IsCompatibleElementType(_In_ const Type& srcElementType)
+    {
+        Type elementType = srcElementType;
+        if (elementType.GetKind() == TypeTypedef)
         {
-            try
-            {
-                auto result = m_getterFunc(ClientEx::Object(pContextObject));
-                ClientEx::Object resultObject = ClientEx::BoxObject(std::move(result));
-                *ppValue = resultObject.Detach();
-            }
-            catch(...)
-            {
-                return Exceptions::ReturnResult(std::current_exception(), ppValue);
-            }
+            elementType = elementType.TypedefFinalBaseType();
+        }
 
-            return S_OK;
+        if (elementType.Size() != sizeof(T))
+        {
+            return false;
         }
 
-        // SetValue():
-        //
-        // Sets the value of the underlying property by calling the functor.
-        //
-        IFACEMETHOD(SetValue)(_In_ PCWSTR /*propertyName*/, _In_opt_ IModelObject *pContextObject, _In_ IModelObject *pValue)
+        switch(elementType.GetKind())
         {
-            //
-            // The function must have a signature of (Object[&], T) where T is the value being set.  Unbox to T.
-            //
-            try
-            {
-                using ArgumentType = typename FunctorTraits<TSetter>::template ArgumentType_t<1>;
-                ArgumentType val = ClientEx::UnboxObject<ArgumentType>(pValue);
-                m_setterFunc(ClientEx::Object(pContextObject), val);
-            }
-            catch(...)
+            case TypePointer:
+                return std::is_integral_v<T> && std::is_unsigned_v<T>;
+
+            case TypeEnum:
+                return std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+            case TypeIntrinsic:
             {
-                return Exceptions::ReturnResult(std::current_exception());
-            }
+                VARTYPE carrier = elementType.IntrinsicCarrier();
+                if (carrier == IntrinsicTypeTraits<T>::VariantType)
+                {
+                    return true;
+                }
 
-            return S_OK;
+                //
+                // Integral carriers of the same size differ only in signedness.  Anything else (floating point
+                // or boolean) must match exactly.
+                //
+                bool isIntegralCarrier = (carrier != VT_R4 && carrier != VT_R8 && carrier != VT_BOOL);
+                return isIntegralCarrier && std::is_integral_v<T> && !std::is_same_v<T, bool>;
+            }
         }
 
-    private:
+        return false;
+    }
+}
 
-        TGetter m_getterFunc;
-        TSetter m_setterFunc;
+template<typename T>
+void Object::ReadArray(_In_ ULONG64 count, _Out_writes_all_(count) T *pDest) const
+{
+    static_assert(std::is_trivially_copyable_v<T>, "ReadArray<T> requires a trivially copyable element type");
 
-    };
+    if (count == 0)
+    {
+        return;
+    }
+
+    ClientEx::Type objectType = Type();
+    if (objectType == nullptr)
+    {
+        throw illegal_operation("Object must have a native type to read its elements");
+    }
 
-    // BoxedMethod:
     //
-    // A data model implementation of a method which is bound to a C++ functor.
+    // A typedef of a pointer or array (e.g.: PBYTE) reads through the type it names.
     //
-    template<typename TFunc>
-    class BoxedMethod : public
-        Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IModelMethod
-            >
+    if (objectType.GetKind() == TypeTypedef)
     {
-    public:
+        objectType = objectType.TypedefFinalBaseType();
+    }
+
+    Location readLocation;
+    ClientEx::Type elementType;
 
-        BoxedMethod(_In_ const TFunc& func) :
-            m_func(func)
+    TypeKind tk = objectType.GetKind();
+    if (tk == TypePointer && GetKind() == ObjectIntrinsic)
+    {
+        if (objectType.GetPointerKind() != PointerStandard)
         {
+            throw illegal_operation("Only standard pointers may be read as arrays");
         }
-
-        //*************************************************
-        // IModelMethod:
-        //
-
-        // Call():
+        readLocation = Location(static_cast<ULONG64>(*this));
+        elementType = objectType.BaseType();
+    }
+    else if (tk == TypeArray)
+    {
         //
-        // Calls the method.
+        // The read must stay within the array: count may not exceed the total number of elements across all
+        // of its dimensions.
         //
-        IFACEMETHOD(Call)(_In_opt_ IModelObject *pContextObject,
-                          _In_ ULONG64 argCount,
-                          _In_reads_(argCount) IModelObject **ppArguments,
-                          _COM_Errorptr_ IModelObject ** ppResult,
-                          _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        ULONG64 arrayLength = 1;
+        for (const ArrayDimension& dimension : objectType.ArrayDimensions())
         {
-            Object result;
-            try
-            {
-                Object contextObj = pContextObject;
-                result = InvokeMethodFromPack(m_func, contextObj, static_cast<size_t>(argCount), ppArguments, ppMetadata);
-            }
-            catch(...)
+            if (dimension.Length != 0 && arrayLength > static_cast<ULONG64>(-1) / dimension.Length)
             {
-                return Exceptions::ReturnResult(std::current_exception(), ppResult);
+                throw std::range_error("Array is too large");
             }
+            arrayLength *= dimension.Length;
+        }
 
-            *ppResult = result.Detach();
-            return S_OK;
+        if (count > arrayLength)
+        {
+            throw std::range_error("Requested read extends beyond the end of the array");
         }
 
-    private:
+        readLocation = GetLocation();
+        elementType = objectType.BaseType();
+    }
+    else
+    {
+        //
+        // A located object which is neither a pointer nor an array is a single element.
+        //
+        if (count != 1)
+        {
+            throw std::range_error("Only a single element may be read from an object which is not a pointer or array");
+        }
 
-        TFunc m_func;
+        readLocation = GetLocation();
+        elementType = objectType;
+    }
 
-    };
+    if (!Details::IsCompatibleElementType<T>(elementType))
+    {
+        throw std::invalid_argument("Element type is not compatible with the requested read type");
+    }
 
-    // BoxedArray:
-    //
-    // A class which represents the conceptual structure necessary to represent a boxed array
-    // of some type T.
-    //
-    template<typename T>
-    class BoxedArray :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IIterableConcept,
-            IIndexableConcept
-            >
+    if (count > static_cast<ULONG64>(-1) / sizeof(T))
     {
-    public:
+        throw std::invalid_argument("Requested read is too large");
+    }
+
+    ULONG64 readSize = count * sizeof(T);
+    HostContext objContext = *this;
+    ComPtr<IDebugHostMemory> spMemory = GetHostAs<IDebugHostMemory>();
+
+    ULONG64 bytesRead;
+    CheckHr(spMemory->ReadBytes(objContext, readLocation, pDest, readSize, &bytesRead));
+    if (bytesRead != readSize)
+    {
+        throw hr_exception(HRESULT_FROM_WIN32(ERROR_PARTIAL_COPY), "Unable to read the full set of requested elements");
+    }
+}
+
+template<typename T>
+std::vector<T> Object::ReadValues(_In_ ULONG64 count) const
+{
+    static_assert(!std::is_same_v<T, bool>, "ReadValues<bool> cannot fill std::vector<bool>.  Use ReadArray<bool>");
+    std::vector<T> values(static_cast<size_t>(count));
+    ReadArray(count, values.data());
+    return values;
+}
+
+template<typename TArg>
+int Object::CompareTo(TArg&& other) const
+{
+    Object otherObj = BoxObject(other);
+    ComPtr<IModelObject> spResult;
+    CheckHr(m_spObject->Compare(otherObj, &spResult));
+    Object resultObj = std::move(spResult);
+    return (int)resultObj;
+}
+
+template<typename TArg>
+bool Object::IsEqualTo(TArg&& other) const
+{
+    Object otherObj = BoxObject(other);
+    if (GetObject() == otherObj.GetObject()) { return true; }
+    if (GetObject() == nullptr || otherObj.GetObject() == nullptr) { return false; }
+    bool isEqual;
+    CheckHr(m_spObject->IsEqualTo(otherObj, &isEqual));
+    return isEqual;
+}
+
+template<typename... TArgs, typename TEnable>
+Metadata::Metadata(_In_ TArgs&&... initializers)
+{
+    SetKeys(std::forward<TArgs>(initializers)...);
+}
 
-        // BoxedArray:
-        //
-        // Construct a new boxed array.
-        //
-        BoxedArray(_In_ const Object &arrayObject,_In_ const T *pArray, _In_ size_t arraySize) :
-            m_spArray(new T[arraySize]),
-            m_arraySize(arraySize)
-        {
-            std::copy(pArray, pArray + arraySize, m_spArray.get());
-            CheckHr(arrayObject->SetConcept(__uuidof(IIterableConcept), static_cast<IIterableConcept *>(this), nullptr));
-            CheckHr(arrayObject->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr));
-            m_allowWrite = true;
-        }
+template<typename... TArgs, typename TEnable>
+void Metadata::SetKeys(_In_ TArgs&&... initializers)
+{
+    EnsureCreated();
+    Details::KeyFiller<IKeyStore, TArgs...>::Fill(m_spKeyStore.Get(), std::forward<TArgs>(initializers)...);
+}
 
-        //*************************************************
-        // IIterableConcept:
-        //
+inline Deconstruction Object::Deconstruct()
+{
+    Details::DeconstructionCollector collector;
+    Deconstruct(collector);
+    return collector.TakeDeconstruction();
+}
 
-        IFACEMETHOD(GetDefaultIndexDimensionality)(_In_ IModelObject * /*pContextObject*/,
-                                                   _Out_ ULONG64 *pDimensionality)
+inline void Object::Deconstruct(_In_ DeconstructionSink& sink)
+{
+    ComPtr<IDeconstructableConcept> spDeconstructable;
+    CheckHr(m_spObject->GetConcept(__uuidof(IDeconstructableConcept), &spDeconstructable, nullptr));
+
+    BSTR ctorName;
+    CheckHr(spDeconstructable->GetConstructableModelName(m_spObject.Get(), &ctorName));
+    bstr_ptr spCtorName(ctorName);
+
+    ComPtr<Details::IStreamingDeconstructableConcept> spStreaming;
+    if (SUCCEEDED(spDeconstructable.As(&spStreaming)))
+    {
+        ComPtr<Details::DeconstructionSinkAdapter> spAdapter = Make<Details::DeconstructionSinkAdapter>(ctorName, &sink);
+        if (spAdapter == nullptr)
         {
-            *pDimensionality = 1;
-            return S_OK;
+            throw std::bad_alloc();
         }
 
-        IFACEMETHOD(GetIterator)(_In_ IModelObject * /*pContextObject*/,
-                                 _Out_ IModelIterator **ppIterator)
+        HRESULT hr = spStreaming->GetConstructorArgumentsInto(m_spObject.Get(), spAdapter.Get());
+        spAdapter->RethrowIfThrown();
+        CheckHr(hr);
+        if (!spAdapter->HasBegun())
         {
-            *ppIterator = nullptr;
-            try
-            {
-                ComPtr<Iterator> spIterator = Make<Iterator>(this, m_spArray.get(), m_arraySize);
-                *ppIterator = spIterator.Detach();
-            }
-            catch(...)
-            {
-                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
-            }
-            return S_OK;
+            sink.BeginDeconstruction(ctorName, 0);
         }
-
-        //*************************************************
-        // IIndexableConcept:
+    }
+    else
+    {
+        //
+        // The arguments of any other deconstructable concept come back together.  They are still passed to the sink
+        // and released one at a time.
         //
+        ULONG64 argCount;
+        CheckHr(spDeconstructable->GetConstructorArgumentCount(m_spObject.Get(), &argCount));
 
-        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
-                                       _Out_ ULONG64 *pDimensionality)
-        {
-            *pDimensionality = 1;
-            return S_OK;
-        }
+        Details::ParameterPack pack(new Object[static_cast<size_t>(argCount)]);
+        CheckHr(spDeconstructable->GetConstructorArguments(m_spObject.Get(), argCount, reinterpret_cast<IModelObject **>(pack.get())));
 
-        IFACEMETHOD(GetAt)(_In_ IModelObject * /*pContextObject*/,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject **ppIndexers,
-                           _COM_Errorptr_ IModelObject **ppObject,
-                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        sink.BeginDeconstruction(ctorName, argCount);
+        for (ULONG64 i = 0; i < argCount; ++i)
         {
-            *ppObject = nullptr;
-            if (ppMetadata != nullptr)
-            {
-                *ppMetadata = nullptr;
-            }
-
-            try
-            {
-                if (indexerCount != 1)
-                {
-                    return E_INVALIDARG;
-                }
-
-                Object idxObj = ppIndexers[0];
-                ULONG64 idx = (ULONG64)idxObj;
-                if (idx >= m_arraySize)
-                {
-                    throw std::range_error("Out of bounds array index");
-                }
-
-                T const& val = m_spArray[static_cast<size_t>(idx)];
-                ClientEx::Object result = val;
-
-                MetadataTraits<T>::FillMetadata(val, ppMetadata);
-                *ppObject = result.Detach();
-            }
-            catch(...)
-            {
-                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception(), ppObject);
-            }
-
-            return S_OK;
+            Object argument = std::move(pack[static_cast<size_t>(i)]);
+            sink.Argument(i, argument);
         }
+    }
 
-        IFACEMETHOD(SetAt)(_In_ IModelObject * /*pContextObject*/,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject **ppIndexers,
-                           _In_ IModelObject *pValue)
-        {
-            if (!m_allowWrite)
-            {
-                return E_NOTIMPL;
-            }
-
-            try
-            {
-                if (indexerCount != 1)
-                {
-                    return E_INVALIDARG;
-                }
+    sink.EndDeconstruction();
+}
 
-                Object idxObj = ppIndexers[0];
-                ULONG64 idx = (ULONG64)idxObj;
-                if (idx >= m_arraySize)
-                {
-                    throw std::range_error("Out of bounds array index");
-                }
+inline Object Object::ConstructInstance(Deconstruction& deconstruction)
+{
+    ComPtr<IConstructableConcept> spConstructable;
+    CheckHr(m_spObject->GetConcept(__uuidof(IConstructableConcept), &spConstructable, nullptr));
 
-                Object val = pValue;
-                m_spArray[static_cast<size_t>(idx)] = (T)val;
-            }
-            catch(...)
-            {
-                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
-            }
+    //
+    // Object is structurally an IModelObject pointer.  The arguments are passed in place rather than copied into a
+    // separate pack.
+    //
+    std::vector<Object>& arguments = deconstruction.m_arguments;
 
-            return S_OK;
-        }
+    ComPtr<IModelObject> spInstance;
+    CheckHr(spConstructable->CreateInstance(arguments.size(), reinterpret_cast<IModelObject **>(arguments.data()), &spInstance));
+    return Object(std::move(spInstance));
+}
 
-    private:
+namespace Details
+{
+    template<typename TTuple, size_t i, size_t remaining>
+    void RegularUnpacker<TTuple, i, remaining>::UnpackInto(_In_ size_t packSize,
+                                                           _In_reads_(packSize) IModelObject **ppArgumentPack,
+                                                           TTuple& tuple)
+    {
+        using ArgType = std::tuple_element_t<i, TTuple>;
 
-        // Iterator:
+        // As we have already checked the pack size matches the minimum static argument set before
+        // reaching this point, a 0 packSize is a non-supplied argument in the dynamic pack
+        // matching against a std::optional<TOpt> in the argument pack.
         //
-        // A model based iterator for boxed arrays.
+        // The tuple will have default constructed the std::optional<TOpt>.  Simply not touching
+        // that value will leave it as no value (std::nullopt).  This is exactly the behavior
+        // that we want.
         //
-        class Iterator :
-            public Microsoft::WRL::RuntimeClass<
-                Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-                IModelIterator
-                >
+        // The argument is unboxed in place from the pack rather than through a referenced copy.  This relies
+        // on the same structural requirement on Object as the variable argument unpacker.
+        //
+        if (i < packSize)
         {
-        public:
-
-            Iterator(_In_ IIterableConcept *pIterable, _In_ T *pArray, _In_ size_t arraySize) :
-                m_spIterable(pIterable), m_pArray(pArray), m_arraySize(arraySize), m_pos(0)
+            if constexpr(std::is_same_v<ArgType, ObjectView>)
             {
+                std::get<i>(tuple) = ObjectView(ppArgumentPack[i]);
             }
-
-            //*************************************************
-            // IModelIterator
-            //
-
-            IFACEMETHOD(Reset)()
+            else
             {
-                m_pos = 0;
-                return S_OK;
+                const Object& obj = *reinterpret_cast<const Object *>(ppArgumentPack + i);
+                std::get<i>(tuple) = UnboxObject<ArgType>(obj);
             }
+        }
 
-            IFACEMETHOD(GetNext)(_In_ IModelObject ** ppObject,
-                                 _In_ ULONG64 dimensions,
-                                 _Out_writes_opt_(dimensions) IModelObject ** ppIndexers,
-                                 _COM_Outptr_opt_result_maybenull_ IKeyStore ** ppMetadata)
-            {
-                *ppObject = nullptr;
-                if (dimensions > 0)
-                {
-                    for (ULONG64 i = 0; i < dimensions; ++i)
-                    {
-                        ppIndexers[i] = nullptr;
-                    }
-                }
-                if (ppMetadata != nullptr)
-                {
-                    *ppMetadata = nullptr;
-                }
+        Unpacker<TTuple, i + 1, remaining - 1>::UnpackInto(packSize, ppArgumentPack, tuple);
+    }
+}
 
-                if (dimensions != 0 && dimensions != 1)
-                {
-                    return E_INVALIDARG;
-                }
+//**************************************************************************
+// Struct Mirrors:
+//
+// A struct mirror is a plain C++ struct whose members are mapped by name onto the fields of a native target type.
+// The mapping is declared once with DBGMODEL_STRUCT_MIRROR:
+//
+//     struct ProcessMirror
+//     {
+//         ULONG64 Pid;
+//         ULONG Flags;
+//         ULONG ProtectedProcess;   // a bitfield in the target
+//     };
+//
+//     DBGMODEL_STRUCT_MIRROR(ProcessMirror,
+//                            DBGMODEL_MIRROR_FIELD(Pid, L"UniqueProcessId"),
+//                            DBGMODEL_MIRROR_FIELD(Flags, L"Flags"),
+//                            DBGMODEL_MIRROR_FIELD(ProtectedProcess, L"ProtectedProcess"));
+//
+// A StructMirror<T> takes the offset, size, signedness and bitfield information of each mapped field from a
+// TypeLayout, which resolves them once per type, and then fills the mirror from a single memory read of the type's
+// size.  Bitfields are unpacked locally.  The macro also provides a Boxing::BoxObject<T> for the mirror.  Boxing
+// produces a synthetic object with one key per mapped field.  DBGMODEL_STRUCT_MIRROR must be used at global
+// namespace scope.
+//
 
-                try
-                {
-                    if (m_pos >= m_arraySize)
-                    {
-                        return E_BOUNDS;
-                    }
+namespace Details
+{
+    template<typename TMirror, typename TValue>
+    struct MirrorFieldDescriptor
+    {
+        TValue TMirror::*Member;
+        const wchar_t *FieldName;
+    };
 
-                    T const& val = m_pArray[m_pos];
-                    ClientEx::Object objVal = val;
+    struct MirrorFieldPlan
+    {
+        ULONG64 Offset;
+        ULONG64 Size;
+        bool IsBitField;
+        BitFieldInformation BitField;
+        bool IsSigned;
+    };
 
-                    if (dimensions == 1)
-                    {
-                        Object idx = (ULONG64)m_pos;
-                        ppIndexers[0] = idx.Detach();
-                    }
+    inline ULONG64 SignExtend(_In_ ULONG64 value, _In_ ULONG bitCount)
+    {
+        if (bitCount == 0 || bitCount >= 64)
+        {
+            return value;
+        }
 
-                    ++m_pos;
-                    MetadataTraits<T>::FillMetadata(val, ppMetadata);
-                    *ppObject = objVal.Detach();
-                }
-                catch(...)
-                {
-                    return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
-                }
+        ULONG64 signBit = 1ull << (bitCount - 1);
+        return (value ^ signBit) - signBit;
+    }
 
-                return S_OK;
-            }
+    inline Type FinalType(_In_ const Type& srcType)
+    {
+        return srcType.GetKind() == TypeTypedef ? srcType.TypedefFinalBaseType() : srcType;
+    }
+}
 
-        private:
+// MirrorField():
+//
+// Creates the descriptor which maps a member of a mirror struct to a named field of the target type.
+//
+template<typename TMirror, typename TValue>
+constexpr Details::MirrorFieldDescriptor<TMirror, TValue> MirrorField(_In_ TValue TMirror::*member, _In_z_ const wchar_t *fieldName)
+{
+    return Details::MirrorFieldDescriptor<TMirror, TValue> { member, fieldName };
+}
 
-            ComPtr<IIterableConcept> m_spIterable;
-            T *m_pArray;
-            size_t m_arraySize;
-            size_t m_pos;
+// StructMirrorTraits:
+//
+// Specialized (through DBGMODEL_STRUCT_MIRROR) for each mirror struct.  The specialization provides a static Fields()
+// method which returns a tuple of MirrorField descriptors.
+//
+template<typename TMirror> struct StructMirrorTraits;
+
+// StructMirror:
+//
+// The resolved mapping of a mirror struct onto a particular target type.  Construct one per (module, type) and
+// keep it for as long as the layout is valid.
+//
+template<typename TMirror>
+class StructMirror
+{
+public:
 
-        };
+    using FieldsType = decltype(StructMirrorTraits<TMirror>::Fields());
+    static constexpr size_t FieldCount = std::tuple_size_v<FieldsType>;
 
-        std::unique_ptr<T[]> m_spArray;
-        size_t m_arraySize;
-        bool m_allowWrite;
+    StructMirror(_In_ std::shared_ptr<const TypeLayout> spLayout) :
+        m_spLayout(std::move(spLayout)),
+        m_fields(StructMirrorTraits<TMirror>::Fields())
+    {
+        static_assert(std::is_trivially_copyable_v<TMirror>, "A struct mirror must be trivially copyable");
+        BuildPlan(std::make_index_sequence<FieldCount>());
+    }
 
-    };
+    StructMirror(_In_ TypeLayoutCache& layoutCache, _In_ const Type& type) :
+        StructMirror(layoutCache.GetLayout(type))
+    {
+    }
 
-    //*************************************************
-    // Class Link References
+    StructMirror(_In_ TypeLayoutCache& layoutCache, _In_ const Module& module, _In_z_ const wchar_t *pTypeName) :
+        StructMirror(layoutCache.GetLayout(module, pTypeName))
+    {
+    }
+
+    const TypeLayout& GetLayout() const { return *m_spLayout; }
+
+    // UnboxLayoutCache():
+    //
+    // Returns the layout cache through which UnboxObject<TMirror> resolves the layout of the objects it unboxes.  As
+    // with any TypeLayoutCache, a client which sees modules unload must invalidate them here.
     //
+    static TypeLayoutCache& UnboxLayoutCache()
+    {
+        static TypeLayoutCache s_layoutCache;
+        return s_layoutCache;
+    }
 
-    struct DataModelReferenceInfo
+    // Read():
+    //
+    // Fills a mirror from the given object.  The object may either be an instance of the mirrored type or a
+    // standard pointer to one.  Throws std::invalid_argument if the object is of any other type.
+    //
+    TMirror Read(_In_ const Object& obj) const
     {
-        DataModelReferenceInfo() : TypeIsLive(true) { }
+        TMirror mirror { };
+        Read(obj, mirror);
+        return mirror;
+    }
 
-        bool TypeIsLive;
-    };
+    void Read(_In_ const Object& obj, _Out_ TMirror& mirror) const
+    {
+        Location readLocation;
+        ClientEx::Type objType = obj.Type();
+        if (objType == nullptr)
+        {
+            throw std::invalid_argument("Object is not of the mirrored type");
+        }
 
-    using DataModelReference = std::shared_ptr<DataModelReferenceInfo>;
+        objType = Details::FinalType(objType);
+        ClientEx::Type instanceType = objType;
+        if (objType.GetKind() == TypePointer && obj.GetKind() == ObjectIntrinsic)
+        {
+            readLocation = Location(static_cast<ULONG64>(obj));
+            instanceType = Details::FinalType(objType.BaseType());
+        }
+        else
+        {
+            readLocation = obj.GetLocation();
+        }
 
-    inline void ThrowIfDetached(_In_ const DataModelReference& linkRef)
-    {
-        if (!linkRef->TypeIsLive)
+        if (!Details::IsSameType(instanceType, Details::FinalType(m_spLayout->GetType())))
         {
-            throw ClientEx::object_detached();
+            throw std::invalid_argument("Object is not of the mirrored type");
         }
+
+        Read(obj, readLocation, mirror);
     }
 
-    //*************************************************
-    // Iterators:
+    // Read():
     //
-
-    template<typename TGen, typename TIter, typename TProjector, bool IsRandom>
-    class BoundIterator :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IModelIterator
-            >
+    // Fills a mirror from an instance of the mirrored type at the given location.
+    //
+    void Read(_In_ const HostContext& context, _In_ const Location& location, _Out_ TMirror& mirror) const
     {
-    public:
-
-        using TGenBaseType = std::decay_t<TGen>;
+        size_t size = static_cast<size_t>(m_spLayout->Size());
 
-        BoundIterator(_In_ DataModelReference&& transferredLinkReference,
-                      _In_ TGenBaseType& generator,
-                      _In_ const TIter& itBegin,
-                      _In_ const TIter& itEnd,
-                      _In_ const ClientEx::Object& srcObject,
-                      _In_ const TProjector& projectionFunction
-                      ) :
-            m_generator(generator),
-            m_itBegin(itBegin),
-            m_itEnd(itEnd),
-            m_itCur(itBegin),
-            m_srcObject(srcObject),
-            m_projector(projectionFunction),
-            m_linkReference(std::move(transferredLinkReference))
+        unsigned char stackBuffer[256];
+        std::unique_ptr<unsigned char[]> spHeapBuffer;
+        unsigned char *pBuffer = stackBuffer;
+        if (size > sizeof(stackBuffer))
         {
+            spHeapBuffer.reset(new unsigned char[size]);
+            pBuffer = spHeapBuffer.get();
         }
 
-        BoundIterator(_In_ DataModelReference&& transferredLinkReference,
-                      _In_ TGenBaseType&& generator,
-                      _In_ const TIter& itBegin,
-                      _In_ const TIter& itEnd,
-                      _In_ const ClientEx::Object& srcObject,
-                      _In_ const TProjector& projectionFunction
-                      ) :
-            m_generator(std::move(generator)),
-            m_itBegin(itBegin),
-            m_itEnd(itEnd),
-            m_itCur(itBegin),
-            m_srcObject(srcObject),
-            m_projector(projectionFunction),
-            m_linkReference(std::move(transferredLinkReference))
+        ComPtr<IDebugHostMemory> spMemory = GetHostAs<IDebugHostMemory>();
+
+        ULONG64 bytesRead;
+        CheckHr(spMemory->ReadBytes(context, location, pBuffer, size, &bytesRead));
+        if (bytesRead != size)
         {
+            throw hr_exception(HRESULT_FROM_WIN32(ERROR_PARTIAL_COPY), "Unable to read the mirrored structure");
         }
 
-        //*************************************************
-        // IModelIterator():
-        //
+        Unpack(pBuffer, mirror, std::make_index_sequence<FieldCount>());
+    }
 
-        IFACEMETHOD(Reset)()
+private:
+
+    template<size_t... i>
+    void BuildPlan(std::index_sequence<i...>)
+    {
+        (BuildFieldPlan<i>(), ...);
+    }
+
+    template<size_t i>
+    void BuildFieldPlan()
+    {
+        auto& descriptor = std::get<i>(m_fields);
+        using TValue = std::remove_reference_t<decltype(std::declval<TMirror&>().*(descriptor.Member))>;
+
+        const FieldLayout& field = m_spLayout->GetField(descriptor.FieldName);
+
+        Details::MirrorFieldPlan& plan = m_plan[i];
+        plan.Offset = field.Offset;
+        plan.Size = field.Size;
+        plan.IsBitField = field.IsBitField;
+        plan.BitField = field.BitField;
+        plan.IsSigned = field.IsSigned;
+
+        if (plan.Offset + plan.Size > m_spLayout->Size())
         {
-            m_itCur = m_itBegin;
-            return S_OK;
+            throw unexpected_error("Mirrored field lies outside of its type");
         }
 
-        IFACEMETHOD(GetNext)(_In_ IModelObject ** ppObject,
-                             _In_ ULONG64 dimensions,
-                             _Out_writes_opt_(dimensions) IModelObject ** ppIndexers,
-                             _COM_Outptr_opt_result_maybenull_ IKeyStore ** ppMetadata)
+        if constexpr (std::is_integral_v<TValue> || std::is_enum_v<TValue>)
         {
-            *ppObject = nullptr;
-            if (dimensions > 0)
+            if (plan.Size > sizeof(ULONG64))
             {
-                for (ULONG64 i = 0; i < dimensions; ++i)
-                {
-                    ppIndexers[i] = nullptr;
-                }
+                throw std::invalid_argument("Mirrored field is too large for an integral member");
             }
-            if (ppMetadata != nullptr)
+        }
+        else
+        {
+            if (plan.IsBitField || plan.Size != sizeof(TValue))
             {
-                *ppMetadata = nullptr;
+                throw std::invalid_argument("Mirrored field does not match the size of its member");
             }
+        }
+    }
 
-            using TVal = decltype(m_projector(*m_itCur));
-            IndexerTraits<TVal, TIter, IsRandom>::CheckDimensions(dimensions);
+    template<size_t... i>
+    void Unpack(_In_ const unsigned char *pBuffer, _Out_ TMirror& mirror, std::index_sequence<i...>) const
+    {
+        (UnpackField<i>(pBuffer, mirror), ...);
+    }
 
-            try
-            {
-                ThrowIfDetached(m_linkReference);
+    template<size_t i>
+    void UnpackField(_In_ const unsigned char *pBuffer, _Out_ TMirror& mirror) const
+    {
+        auto& descriptor = std::get<i>(m_fields);
+        auto& member = mirror.*(descriptor.Member);
+        using TValue = std::remove_reference_t<decltype(member)>;
 
-                //
-                // It is illegal to reference a generator iterator which has rethrown.  Make
-                // sure that a throw out of the underlying iterator continues to throw the
-                // same exception if it is rereferenced.
-                //
-                if (m_thrown)
+        const Details::MirrorFieldPlan& plan = m_plan[i];
+
+        if constexpr (std::is_integral_v<TValue> || std::is_enum_v<TValue>)
+        {
+            ULONG64 value = 0;
+            memcpy(&value, pBuffer + plan.Offset, static_cast<size_t>(plan.Size));
+
+            if (plan.IsBitField)
+            {
+                value >>= plan.BitField.Lsb;
+                if (plan.BitField.Length < 64)
                 {
-                    std::rethrow_exception(m_thrown);
+                    value &= (1ull << plan.BitField.Length) - 1;
                 }
-
-                if (m_itCur == m_itEnd)
+                if (plan.IsSigned)
                 {
-                    return E_BOUNDS;
+                    value = Details::SignExtend(value, plan.BitField.Length);
                 }
+            }
+            else if (plan.IsSigned)
+            {
+                value = Details::SignExtend(value, static_cast<ULONG>(plan.Size * 8));
+            }
 
-                auto val = m_projector(*m_itCur);
-
-                ClientEx::Object objVal = ClientEx::BoxObject(val);
+            member = static_cast<TValue>(value);
+        }
+        else
+        {
+            memcpy(&member, pBuffer + plan.Offset, sizeof(TValue));
+        }
+    }
 
-                Object idx;
-                std::unique_ptr<Object[]> idxs;
-                Object *pIdxs = &idx;
-                if (dimensions > 1)
-                {
-                    idxs.reset(new Object[static_cast<size_t>(dimensions)]);
-                    pIdxs = idxs.get();
-                }
+    std::shared_ptr<const TypeLayout> m_spLayout;
+    FieldsType m_fields;
+    Details::MirrorFieldPlan m_plan[FieldCount > 0 ? FieldCount : 1];
+};
 
-                IndexerTraits<TVal, TIter, IsRandom>::CreateIndexers(val, m_itBegin, m_itCur, dimensions, pIdxs);
-                ++m_itCur;
+namespace Details
+{
+    // BoxStructMirror:
+    //
+    // The boxer for struct mirrors declared through DBGMODEL_STRUCT_MIRROR.  A mirror boxes to a synthetic object
+    // with one key per mapped field (named as the target field).  Unboxing a native object of the mirrored type reads
+    // it directly; unboxing anything else reads back the keys.
+    //
+    template<typename TMirror>
+    struct BoxStructMirror
+    {
+        static Object Box(_In_ const TMirror& mirror)
+        {
+            Object boxedMirror = Object::Create(HostContext());
+            std::apply([&](auto&&... descriptors)
+            {
+                (CheckHr(boxedMirror->SetKey(descriptors.FieldName, BoxObject(mirror.*(descriptors.Member)), nullptr)), ...);
+            }, StructMirrorTraits<TMirror>::Fields());
+            return boxedMirror;
+        }
 
-                IndexerTraits<TVal, TIter, IsRandom>::FillIndexers(dimensions, pIdxs, ppIndexers);
-                MetadataTraits<TVal>::FillMetadata(val, ppMetadata);
-                *ppObject = objVal.Detach();
-            }
-            catch(...)
+        static TMirror Unbox(_In_ const Object& src)
+        {
+            ModelObjectKind mk = src.GetKind();
+            if (mk == ObjectTargetObject || mk == ObjectTargetObjectReference)
             {
-                m_thrown = std::current_exception();
-                return ClientEx::Details::Exceptions::ReturnResult(m_thrown);
+                StructMirror<TMirror> mirror(StructMirror<TMirror>::UnboxLayoutCache(), src.Type());
+                return mirror.Read(src);
             }
 
-            return S_OK;
+            TMirror mirror { };
+            std::apply([&](auto&&... descriptors)
+            {
+                ((mirror.*(descriptors.Member) = UnboxObject<std::remove_reference_t<decltype(mirror.*(descriptors.Member))>>(src.KeyValue(descriptors.FieldName))), ...);
+            }, StructMirrorTraits<TMirror>::Fields());
+            return mirror;
         }
+    };
+}
 
-    private:
+// DBGMODEL_STRUCT_MIRROR():
+//
+// Declares the mapping of the mirror struct TMirror onto a target type.  The variable arguments are a list of
+// DBGMODEL_MIRROR_FIELD(member, fieldName) entries.
+//
+#define DBGMODEL_STRUCT_MIRROR(TMirror, ...)                                                            \
+    template<> struct Debugger::DataModel::ClientEx::StructMirrorTraits<TMirror>                        \
+    {                                                                                                   \
+        using MirrorType = TMirror;                                                                     \
+        static auto Fields() { return std::make_tuple(__VA_ARGS__); }                                   \
+    };                                                                                                  \
+    template<> struct Debugger::DataModel::ClientEx::Boxing::BoxObject<TMirror> :                       \
+        public Debugger::DataModel::ClientEx::Details::BoxStructMirror<TMirror>                         \
+    {                                                                                                   \
+    }
 
-        //
-        // If this is instance data for a TypedInstanceData<T>, this should be a T& (or the underlying U of T where T is
-        // std::shared_ptr<U> or std::unique_ptr<U>.
-        //
-        // It is imperative that this **STAYS** a reference if the generator returned a reference and a value if the generator
-        // returned a value.  Otherwise, we will incur a significant number of copies.
-        //
-        // For generators that return a value, is a move constructed version of that data.
-        //
-        TGen m_generator;
+#define DBGMODEL_MIRROR_FIELD(member, fieldName) \
+    Debugger::DataModel::ClientEx::MirrorField(&MirrorType::member, fieldName)
+
+//**************************************************************************
+// Expressions:
+//
+
+namespace Details
+{
+
+// IsSameHostContext():
+//
+// Determines whether two host contexts refer to the same context.  Two empty contexts are the same.
+//
+inline bool IsSameHostContext(_In_ const HostContext& lhs, _In_ const HostContext& rhs)
+{
+    IDebugHostContext *pLhs = lhs;
+    IDebugHostContext *pRhs = rhs;
+    if (pLhs == pRhs)
+    {
+        return true;
+    }
+    if (pLhs == nullptr || pRhs == nullptr)
+    {
+        return false;
+    }
+
+    bool isEqual;
+    return SUCCEEDED(pLhs->IsEqualTo(pRhs, &isEqual)) && isEqual;
+}
+
+} // Details
+
+// ExpressionSyntax:
+//
+// The syntax in which an Expression is written.  Language expressions may only use the syntax of the language being
+// debugged (see Object::FromExpressionEvaluation); extended expressions may use anything the host supports (see
+// Object::FromExtendedExpressionEvaluation).
+//
+enum class ExpressionSyntax
+{
+    Language,
+    Extended
+};
+
+// Expression:
+//
+// An expression which is prepared once and evaluated any number of times against any number of contexts.
+//
+// The debug host interfaces do not offer a way to parse an expression ahead of its evaluation.  What is prepared is
+// everything around the evaluation: the evaluator interface is acquired once and the text of the expression never
+// changes between evaluations.  Values which vary are passed as arguments bound by name to objects rather than being
+// formatted into the text.  They are set as keys on a binding object against which the evaluator resolves names:
+//
+//     Expression threadCount(ExpressionSyntax::Extended, L"proc.Threads.Count()", { L"proc" });
+//     for (auto&& process : processes)
+//     {
+//         ULONG64 count = (ULONG64)threadCount.Evaluate(static_cast<HostContext>(process), process);
+//     }
+//
+// If an epoch function is given, the results of evaluations without arguments are cached per host context until the
+// epoch changes.  As with MaterializedIterable, the epoch is typically a counter which changes whenever the target
+// executes.  Without an epoch function, nothing is cached.
+//
+class Expression
+{
+public:
+
+    Expression(_In_ ExpressionSyntax syntax,
+               _In_ std::wstring text,
+               _In_ std::vector<std::wstring> parameterNames = std::vector<std::wstring>(),
+               _In_ std::function<ULONG64(void)> epochFunction = nullptr) :
+        m_spState(std::make_shared<State>())
+    {
+        m_spState->Syntax = syntax;
+        m_spState->Text = std::move(text);
+        m_spState->ParameterNames = std::move(parameterNames);
+        m_spState->EpochFunction = std::move(epochFunction);
+        CheckHr(GetHost()->QueryInterface(IID_PPV_ARGS(&m_spState->Evaluator)));
+    }
+
+    ExpressionSyntax GetSyntax() const { return m_spState->Syntax; }
+    const std::wstring& GetText() const { return m_spState->Text; }
+    const std::vector<std::wstring>& GetParameterNames() const { return m_spState->ParameterNames; }
+
+    // Evaluate():
+    //
+    // Evaluates the expression in the given context.  Arguments are bound, in order, to the parameter names given at
+    // construction.
+    //
+    Object Evaluate(_In_ const HostContext& evaluationContext) const
+    {
+        if (!m_spState->ParameterNames.empty())
+        {
+            throw std::invalid_argument("Expression requires arguments");
+        }
+
+        if (!m_spState->EpochFunction)
+        {
+            return EvaluateWithBinding(evaluationContext, nullptr);
+        }
+
+        return EvaluateCached(evaluationContext);
+    }
+
+    template<typename... TArgs>
+    Object Evaluate(_In_ const HostContext& evaluationContext, _In_ TArgs&&... args) const
+    {
+        static_assert(sizeof...(TArgs) > 0, "Use Evaluate(evaluationContext) for an expression without arguments");
+        if (m_spState->ParameterNames.size() != sizeof...(TArgs))
+        {
+            throw std::invalid_argument("Incorrect number of arguments for expression");
+        }
+
+        Object bindingObject = Object::Create(evaluationContext);
+        size_t argumentIndex = 0;
+        (BindArgument(bindingObject, argumentIndex++, std::forward<TArgs>(args)), ...);
+        return EvaluateWithBinding(evaluationContext, bindingObject);
+    }
+
+    // EvaluateWithBinding():
+    //
+    // Evaluates the expression in the given context with names resolved against an arbitrary binding object.  The
+    // result is never cached.
+    //
+    Object EvaluateWithBinding(_In_ const HostContext& evaluationContext, _In_opt_ IModelObject *pBindingObject) const
+    {
+        ComPtr<IModelObject> spResult;
+        HRESULT hr;
+        if (m_spState->Syntax == ExpressionSyntax::Language)
+        {
+            hr = m_spState->Evaluator->EvaluateExpression(evaluationContext, m_spState->Text.c_str(), pBindingObject, &spResult, nullptr);
+        }
+        else
+        {
+            hr = m_spState->Evaluator->EvaluateExtendedExpression(evaluationContext, m_spState->Text.c_str(), pBindingObject, &spResult, nullptr);
+        }
+        CheckHr(hr, spResult);
+        return Object(std::move(spResult));
+    }
+
+    // Invalidate():
+    //
+    // Discards every cached result.
+    //
+    void Invalidate()
+    {
+        std::lock_guard<std::mutex> lock(m_spState->Lock);
+        m_spState->Results.clear();
+        m_spState->ResultIndex.clear();
+    }
+
+private:
+
+    struct CachedResult
+    {
+        HostContext Context;
+        Object Result;
+    };
 
-        std::exception_ptr m_thrown;
-        TIter m_itBegin;
-        TIter m_itEnd;
-        TIter m_itCur;
-        TProjector m_projector;
-        ClientEx::Object m_srcObject;
-        DataModelReference m_linkReference;
+    // ContextAlias:
+    //
+    // A context interface under which a cached result has been found.  The reference keeps the interface pointer
+    // from being reused by another context while it is a key.
+    //
+    struct ContextAlias
+    {
+        HostContext Context;
+        size_t ResultIndex;
     };
 
-    template<typename TClass, typename TGenProjector, typename TItemProjector>
-    class BoundIterableBase :
-        public Microsoft::WRL::Implements<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IIterableConcept
-            >
+    struct State
     {
-    public:
+        ExpressionSyntax Syntax;
+        std::wstring Text;
+        std::vector<std::wstring> ParameterNames;
+        std::function<ULONG64(void)> EpochFunction;
+        ComPtr<IDebugHostEvaluator> Evaluator;
 
-        using ItemProjectorFunction = typename FunctorTraits<TItemProjector>::FunctionType;
-        using GenProjectorFunction = typename FunctorTraits<TGenProjector>::FunctionType;
-        using GeneratorType = typename FunctorTraits<TGenProjector>::ReturnType;
-        using CIterator = decltype(std::declval<GeneratorType>().begin());
-        using CIteratorValue = std::decay_t<decltype(*(std::declval<CIterator>()))>;
-        using ModelIndexerTraits = IndexerTraits<CIteratorValue, CIterator, IsRandomAccessIterator_v<CIterator>>;
+        std::mutex Lock;
+        ULONG64 Epoch = 0;
+        std::vector<CachedResult> Results;                                          // One per distinct context
+        std::unordered_map<IDebugHostContext *, ContextAlias> ResultIndex;          // By context interface
+    };
 
-        //*************************************************
-        // IIterableConcept:
-        //
+    template<typename TArg>
+    void BindArgument(_In_ Object& bindingObject, _In_ size_t argumentIndex, _In_ TArg&& arg) const
+    {
+        Object argumentObject = BoxObject(std::forward<TArg>(arg));
+        CheckHr(bindingObject->SetKey(m_spState->ParameterNames[argumentIndex].c_str(), argumentObject, nullptr));
+    }
 
-        // GetDefaultIndexDimensionality():
-        //
-        // Gets the dimensionality of the indexer.  For random access iterators, we provide a linear
-        // implementation; otherwise, we provide no indexer and the return is zero.
-        //
-        IFACEMETHOD(GetDefaultIndexDimensionality)(_In_ IModelObject * /*pContextObject*/,
-                                                   _Out_ ULONG64 *pDimensionality)
+    // EvaluateCached():
+    //
+    // Evaluates the expression or returns the result of a prior evaluation in an equal context within the current
+    // epoch.  A deferred context is resolved to the current context of the host so that it is cached under the
+    // context it actually evaluates in.
+    //
+    // Results are found by context interface without calling the host.  Only a context interface which has not been
+    // seen in the current epoch is compared (through IDebugHostContext::IsEqualTo) against the contexts of the
+    // cached results.  If an equal one is found, the interface becomes another key for that result.
+    //
+    Object EvaluateCached(_In_ const HostContext& evaluationContext) const
+    {
+        HostContext context = evaluationContext;
+        if (static_cast<IDebugHostContext *>(context) == USE_CURRENT_HOST_CONTEXT)
         {
-            *pDimensionality = ModelIndexerTraits::Dimensionality;
-            return S_OK;
+            context = HostContext::Current();
         }
+        IDebugHostContext *pContext = context;
 
-        // GetIterator():
-        //
-        // Gets an iterator for a given object.
-        //
-        IFACEMETHOD(GetIterator)(_In_ IModelObject *pContextObject,
-                                 _Out_ IModelIterator **ppIterator)
+        ULONG64 epoch = m_spState->EpochFunction();
         {
-            *ppIterator = nullptr;
-            try
+            std::lock_guard<std::mutex> lock(m_spState->Lock);
+            if (m_spState->Epoch != epoch)
             {
-                ThrowIfDetached(m_linkReference);
-                Object obj(pContextObject);
-
-                //
-                // Subtle semantics:
-                //
-                // If GetGenerator() returns a reference, it must be preserved as a reference into BoundIterator<>.  We must
-                // hold the reference and not *MOVE* the underlying object into the iterator.  The reference may be the underlying
-                // data of a TTypedInstance<...> to which we are bound.
-                //
-                // On the other hand, if GetGenerator() returns a value, the value *MUST* be moved into BoundIterator().  It
-                // may be a generator that cannot be copy constructed.
-                //
-                GeneratorType generator = GetGenerator(obj);
-
-                using TGenBase = std::decay_t<GeneratorType>;
-                using TGenPass = std::conditional_t<std::is_reference_v<GeneratorType>, GeneratorType, GeneratorType&&>;
-
-                using ModelIterator = BoundIterator<GeneratorType,
-                                                    CIterator,
-                                                    ItemProjectorFunction,
-                                                    IsRandomAccessIterator_v<CIterator>>;
+                m_spState->Results.clear();
+                m_spState->ResultIndex.clear();
+                m_spState->Epoch = epoch;
+            }
 
-                auto itBegin = generator.begin();
-                auto itEnd = generator.end();
+            auto it = m_spState->ResultIndex.find(pContext);
+            if (it != m_spState->ResultIndex.end())
+            {
+                return m_spState->Results[it->second.ResultIndex].Result;
+            }
 
-                DataModelReference iterRef = GetLinkReference();
-                ComPtr<ModelIterator> spIter = Make<ModelIterator>(std::move(iterRef), (TGenPass)generator, itBegin, itEnd, obj, m_itemProjector);
-                if (spIter == nullptr)
+            for (size_t i = 0; i < m_spState->Results.size(); ++i)
+            {
+                if (Details::IsSameHostContext(m_spState->Results[i].Context, context))
                 {
-                    throw std::bad_alloc();
+                    m_spState->ResultIndex.emplace(pContext, ContextAlias { context, i });
+                    return m_spState->Results[i].Result;
                 }
-
-                *ppIterator = spIter.Detach();
             }
-            catch(...)
+        }
+
+        //
+        // Do not hold the lock across the evaluation.  If two threads race on the same context interface, both
+        // evaluate and the first insertion wins.
+        //
+        Object result = EvaluateWithBinding(context, nullptr);
+
+        std::lock_guard<std::mutex> lock(m_spState->Lock);
+        if (m_spState->Epoch == epoch)
+        {
+            auto it = m_spState->ResultIndex.find(pContext);
+            if (it != m_spState->ResultIndex.end())
             {
-                return Exceptions::ReturnResult(std::current_exception());
+                return m_spState->Results[it->second.ResultIndex].Result;
             }
 
-            return S_OK;
+            m_spState->Results.push_back(CachedResult { context, result });
+            m_spState->ResultIndex.emplace(pContext, ContextAlias { context, m_spState->Results.size() - 1 });
         }
+        return result;
+    }
 
-        //*************************************************
-        // Internal Methods
-        //
+    std::shared_ptr<State> m_spState;
+};
 
-        const DataModelReference& GetLinkReference() const
+//**************************************************************************
+// Cached Property Values:
+//
+
+// PropertyValueCache:
+//
+// A bounded cache of property values used by the AddCachedReadOnlyProperty methods of ExtensionModel and
+// TypedInstanceModel.  Values are cached per (instance object, property).  The host creates a new object each time
+// the same target data is evaluated, so an instance which is a target object is identified by its context, location,
+// and type (compared by symbol identity, so same named types of different modules are distinct).  Any other instance
+// is identified by the object itself (which the cache holds a reference to).
+//
+// At most maxEntries values are held; past that, the least recently used value is evicted.  All values are dropped
+// whenever the epoch returned by epochFunction changes.  As with MaterializedIterable, the epoch is typically a counter
+// which changes whenever the target executes or the current context changes.  The data model does not report either,
+// so the cache cannot detect them on its own and an epoch function is required.  Invalidate() drops all values
+// explicitly.
+//
+// A single cache may be shared by any number of properties (and models) so that they share one budget:
+//
+//     auto spCache = std::make_shared<PropertyValueCache>(8192, []() { return g_executionEpoch.load(); });
+//     AddCachedReadOnlyProperty(L"Signature", this, &MyExtension::GetSignature, spCache);
+//
+class PropertyValueCache
+{
+public:
+
+    PropertyValueCache(_In_ size_t maxEntries, _In_ std::function<ULONG64(void)> epochFunction) :
+        m_maxEntries(maxEntries == 0 ? 1 : maxEntries),
+        m_epochFunction(std::move(epochFunction))
+    {
+        if (!m_epochFunction)
         {
-            return m_linkReference;
+            throw std::invalid_argument("PropertyValueCache requires an epoch function");
         }
+    }
 
-    protected:
+    PropertyValueCache(_In_ const PropertyValueCache&) = delete;
+    PropertyValueCache& operator=(_In_ const PropertyValueCache&) = delete;
 
-        virtual IModelObject *GetObject(_In_opt_ IModelObject *pOverrideObject = nullptr)
+    // CreatePropertyId():
+    //
+    // Returns an identifier which distinguishes one property from every other property which uses this cache.
+    //
+    ULONG64 CreatePropertyId()
+    {
+        return ++m_nextPropertyId;
+    }
+
+    // GetValue():
+    //
+    // Returns the cached value of a property for an instance object.  If there is none, compute is called (without any
+    // lock held) to produce the value, which is then cached.  If two threads race on the same value, both compute and
+    // the first insertion wins.  Exceptions thrown by compute propagate and nothing is cached.
+    //
+    template<typename TCompute>
+    Object GetValue(_In_ ULONG64 propertyId, _In_ const Object& instanceObject, _In_ const TCompute& compute)    // Object compute();
+    {
+        Key key = MakeKey(propertyId, instanceObject);
+        HostContext instanceContext = (key.pObject == nullptr ? static_cast<HostContext>(instanceObject) : HostContext());
+        ULONG64 epoch = m_epochFunction();
+
+        std::list<Entry> discardedEntries;
+        ULONG64 generation;
         {
-            if (pOverrideObject != nullptr)
+            std::lock_guard<std::mutex> lock(m_lock);
+            SynchronizeEpoch(epoch, discardedEntries);
+            generation = m_generation;
+
+            auto it = m_index.find(key);
+            if (it != m_index.end() && Details::IsSameHostContext(it->second->Context, instanceContext))
             {
-                return pOverrideObject;
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                return it->second->Value;
             }
+        }
 
-            return m_pClass->GetObject();
+        Object value = compute();
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_generation != generation)
+        {
+            //
+            // The cache was invalidated while the value was computed.  The value may predate the invalidation.
+            //
+            return value;
         }
 
-        GeneratorType GetGenerator(_In_ const Object& instanceObject)
+        auto it = m_index.find(key);
+        if (it != m_index.end())
         {
-            return m_genProjector(instanceObject);
+            if (Details::IsSameHostContext(it->second->Context, instanceContext))
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                return it->second->Value;
+            }
+
+            discardedEntries.splice(discardedEntries.end(), m_entries, it->second);
+            m_index.erase(it);
         }
 
-        virtual void Apply(_In_opt_ IModelObject *pOverrideObject = nullptr)
+        ComPtr<IModelObject> spInstanceObject = key.pObject;
+        m_entries.push_front(Entry { key, std::move(instanceContext), std::move(spInstanceObject), value });
+        m_index.emplace(std::move(key), m_entries.begin());
+
+        while (m_entries.size() > m_maxEntries)
         {
-            GetObject(pOverrideObject)->SetConcept(__uuidof(IIterableConcept), static_cast<IIterableConcept *>(this), nullptr);
+            m_index.erase(m_entries.back().EntryKey);
+            discardedEntries.splice(discardedEntries.end(), m_entries, std::prev(m_entries.end()));
         }
 
-        TClass *m_pClass;
-        GenProjectorFunction m_genProjector;
-        ItemProjectorFunction m_itemProjector;
-        DataModelReference m_linkReference;
+        return value;
+    }
 
-    };
+    // Invalidate():
+    //
+    // Drops every cached value.
+    //
+    void Invalidate()
+    {
+        std::list<Entry> discardedEntries;
+        std::lock_guard<std::mutex> lock(m_lock);
+        Discard(discardedEntries);
+    }
 
-    // BoundIterableIndexableBase:
+    // GetSize():
     //
-    // A class which implements both iterator and indexer based solely on an iterator (one which is a C++ random access iterator).
-    // The indexer is a linear 0-based indexer as an offset from the base iterator (.begin())
+    // Returns the number of values currently cached.
     //
-    template<typename TClass, typename TGenProjector, typename TItemProjector>
-    class BoundIterableIndexableBase :
-        public Microsoft::WRL::Implements<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IIndexableConcept,
-            BoundIterableBase<TClass, TGenProjector, TItemProjector>
-            >
+    size_t GetSize() const
     {
-    private:
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_entries.size();
+    }
 
-        using Base = Microsoft::WRL::Implements<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IIndexableConcept,
-            BoundIterableBase<TClass, TGenProjector, TItemProjector>
-            >;
+    size_t GetMaxEntries() const
+    {
+        return m_maxEntries;
+    }
 
-    public:
+private:
 
-        //*************************************************
-        // IIndexableConcept:
-        //
+    struct Key
+    {
+        ULONG64 PropertyId;
+        IModelObject *pObject;
+        ULONG64 HostDefined;
+        ULONG64 Offset;
+        ComPtr<IDebugHostType> spType;
 
-        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
-                                       _Out_ ULONG64 *pDimensionality)
+        bool operator==(_In_ const Key& other) const
         {
-            *pDimensionality = 1;
-            return S_OK;
+            return PropertyId == other.PropertyId &&
+                   pObject == other.pObject &&
+                   HostDefined == other.HostDefined &&
+                   Offset == other.Offset &&
+                   Details::IsSameType(spType.Get(), other.spType.Get());
         }
+    };
 
-        IFACEMETHOD(GetAt)(_In_ IModelObject *pContextObject,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject **ppIndexers,
-                           _COM_Errorptr_ IModelObject **ppObject,
-                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+    //
+    // The type is not hashed: it has no identity which can be hashed without asking the host.  Instances at the same
+    // location with different types (e.g.: a structure and its first field) only share a bucket.
+    //
+    struct KeyHash
+    {
+        size_t operator()(_In_ const Key& key) const
         {
-            *ppObject = nullptr;
-            if (ppMetadata != nullptr)
-            {
-                *ppMetadata = nullptr;
-            }
-
-            try
-            {
-                ThrowIfDetached(this->m_linkReference);
-                if (indexerCount != 1)
-                {
-                    return E_INVALIDARG;
-                }
-
-                Object obj = pContextObject;
-                auto&& instanceRef = this->GetGenerator(obj);
-                auto itBegin = instanceRef.begin();
-
-                VARIANT vtIdx;
-                CheckHr(ppIndexers[0]->GetIntrinsicValueAs(VT_UI8, &vtIdx));
-                size_t stIdx = static_cast<size_t>(vtIdx.ullVal);
-                size_t delta = instanceRef.end() - itBegin;
-                if (stIdx > delta)
-                {
-                    return E_BOUNDS;
-                }
+            size_t hash = std::hash<ULONG64>()(key.PropertyId);
+            hash = hash * 31 + std::hash<IModelObject *>()(key.pObject);
+            hash = hash * 31 + std::hash<ULONG64>()(key.HostDefined);
+            hash = hash * 31 + std::hash<ULONG64>()(key.Offset);
+            return hash;
+        }
+    };
 
-                auto itCur = itBegin + stIdx;
-                auto val = this->m_itemProjector(*itCur);
-                Object valObject = BoxObject(val);
+    struct Entry
+    {
+        Key EntryKey;
+        HostContext Context;
+        ComPtr<IModelObject> InstanceObject;
+        Object Value;
+    };
 
-                MetadataTraits<std::decay_t<decltype(val)>>::FillMetadata(val, ppMetadata);
-                *ppObject = valObject.Detach();
-            }
-            catch(...)
-            {
-                return Exceptions::ReturnResult(std::current_exception(), ppObject);
-            }
+    static Key MakeKey(_In_ ULONG64 propertyId, _In_ const Object& instanceObject)
+    {
+        Key key { propertyId, nullptr, 0, 0, nullptr };
 
-            return S_OK;
+        ModelObjectKind kind = instanceObject.GetKind();
+        Location instanceLocation;
+        if ((kind == ObjectTargetObject || kind == ObjectTargetObjectReference) &&
+            SUCCEEDED(instanceObject->GetLocation(&instanceLocation)) &&
+            SUCCEEDED(instanceObject->GetTypeInfo(&key.spType)) && key.spType != nullptr)
+        {
+            key.HostDefined = instanceLocation.HostDefined;
+            key.Offset = instanceLocation.Offset;
+        }
+        else
+        {
+            key.pObject = instanceObject;
         }
 
-        IFACEMETHOD(SetAt)(_In_ IModelObject * /*pContextObject*/,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject ** /*ppIndexers*/,
-                           _In_ IModelObject * /*pValue*/)
+        return key;
+    }
+
+    // SynchronizeEpoch():
+    //
+    // Drops every cached value if the epoch has changed.  The caller must hold the lock.  Discarded entries are moved
+    // to the given list so that the objects they hold are released after the lock is dropped.
+    //
+    void SynchronizeEpoch(_In_ ULONG64 epoch, _Inout_ std::list<Entry>& discardedEntries)
+    {
+        if (m_epoch != epoch)
         {
-            UNREFERENCED_PARAMETER(indexerCount);
-            return E_NOTIMPL;
+            Discard(discardedEntries);
+            m_epoch = epoch;
         }
+    }
 
-    protected:
+    void Discard(_Inout_ std::list<Entry>& discardedEntries)
+    {
+        discardedEntries.splice(discardedEntries.end(), m_entries);
+        m_index.clear();
+        ++m_generation;
+    }
+
+    size_t m_maxEntries;
+    std::function<ULONG64(void)> m_epochFunction;
+    std::atomic<ULONG64> m_nextPropertyId { 0 };
+
+    mutable std::mutex m_lock;
+    ULONG64 m_epoch = 0;
+    ULONG64 m_generation = 0;
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+};
 
-        virtual void Apply(_In_opt_ IModelObject *pOverrideObject = nullptr)
-        {
-            Base::Apply(pOverrideObject);
-            this->GetObject(pOverrideObject)->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr);
-        }
+//**************************************************************************
+// Native List and Tree Walking:
+//
 
+namespace Details
+{
+    // NativeWalkState:
+    //
+    // Everything about a walk of a native list or tree which is resolved once: where it starts, which links are read
+    // from each node and how wide they are, and the record each node is embedded in.  It is shared (and never
+    // modified) by every pass over the walk.  The progress of a pass, including why it ended, is held by its cursor.
+    //
+    struct NativeWalkState
+    {
+        HostContext Context;
+        ClientEx::Type ContainingType;
+        ULONG64 EntryOffset;                // Offset of the node within the containing type
+        ULONG64 RootAddress;                // The list head or tree root
+        ULONG LinkSize;                     // 4 or 8
+        std::vector<ULONG64> LinkOffsets;   // Offsets of the links within a node
+        WalkOptions Options;
     };
 
-    template<typename TClass, typename TGenProjector, typename TItemProjector, typename TGetAt, typename TSetAt>
-    class BoundIterableWithIndexable :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            BoundIterableBase<TClass, TGenProjector, TItemProjector>,
-            IIndexableConcept
-            >
+    // NativeLinkReader:
+    //
+    // Reads the links of a node in a single memory request which spans all of them.
+    //
+    class NativeLinkReader
     {
     public:
 
-        using TGeneratorType = typename FunctorTraits<TGenProjector>::ReturnType;
-        using TIterator = decltype(std::declval<TGeneratorType>().begin());
-        using TIndexedValue = decltype(*(std::declval<TIterator>()));
-        using TIndexedValueBase = std::decay_t<TIndexedValue>;
-        using TIndicies = typename TIndexedValueBase::IndiciesType;
-        static constexpr ULONG64 Dimensionality = (ULONG64)(TIndexedValueBase::Dimensionality);
-
-        using TGetAtFunction = typename FunctorTraits<TGetAt>::FunctionType;
-        using TSetAtFunction = typename FunctorTraits<TSetAt>::FunctionType;
-
-        BoundIterableWithIndexable(_In_ DataModelReference&& transferredLinkReference,
-                                   _In_ TClass *pClass,
-                                   _In_ const TGenProjector& genProjectionFunction,
-                                   _In_ const TItemProjector& itemProjectionFunction,
-                                   _In_ const TGetAt& getAtProjectionFunction,
-                                   _In_ const TSetAt& setAtProjectionFunction)
+        NativeLinkReader(_In_ const NativeWalkState& state) :
+            m_context(state.Context),
+            m_spMemory(GetHostAs<IDebugHostMemory>()),
+            m_linkSize(state.LinkSize),
+            m_linkOffsets(state.LinkOffsets)
         {
-            //
-            // This isn't done through base initializers because of the flow through WRL::RuntimeClass.
-            //
-            this->m_pClass = pClass;
-            this->m_itemProjector = itemProjectionFunction;
-            this->m_genProjector = genProjectionFunction;
-            this->m_getAtFunction = getAtProjectionFunction;
-            this->m_setAtFunction = setAtProjectionFunction;
-            this->m_linkReference = std::move(transferredLinkReference);
-            this->Apply();
-        }
-
-        //*************************************************
-        // IIndexableConcept:
-        //
+            ULONG64 spanStart = static_cast<ULONG64>(-1);
+            ULONG64 spanEnd = 0;
+            for (ULONG64 linkOffset : m_linkOffsets)
+            {
+                spanStart = (linkOffset < spanStart ? linkOffset : spanStart);
+                spanEnd = (linkOffset + m_linkSize > spanEnd ? linkOffset + m_linkSize : spanEnd);
+            }
 
-        IFACEMETHOD(GetDimensionality)(_In_ IModelObject * /*pContextObject*/,
-                                       _Out_ ULONG64 *pDimensionality)
-        {
-            *pDimensionality = Dimensionality;
-            return S_OK;
+            m_spanStart = spanStart;
+            m_span.resize(static_cast<size_t>(spanEnd - spanStart));
         }
 
-        IFACEMETHOD(GetAt)(_In_ IModelObject *pContextObject,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject **ppIndexers,
-                           _COM_Errorptr_ IModelObject **ppObject,
-                           _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        // Read():
+        //
+        // Reads the links of the node at the given address into pLinks (one per link offset, in order).
+        //
+        void Read(_In_ ULONG64 nodeAddress, _Out_writes_(m_linkOffsets.size()) ULONG64 *pLinks)
         {
-            *ppObject = nullptr;
-            if (ppMetadata != nullptr)
+            ULONG64 bytesRead;
+            CheckHr(m_spMemory->ReadBytes(m_context, Location(nodeAddress + m_spanStart), m_span.data(), m_span.size(), &bytesRead));
+            if (bytesRead != m_span.size())
             {
-                *ppMetadata = nullptr;
+                throw hr_exception(HRESULT_FROM_WIN32(ERROR_PARTIAL_COPY), "Unable to read the links of a node");
             }
 
-            try
+            for (size_t i = 0; i < m_linkOffsets.size(); ++i)
             {
-                ThrowIfDetached(this->m_linkReference);
-                if (indexerCount != Dimensionality)
+                const unsigned char *pLink = m_span.data() + (m_linkOffsets[i] - m_spanStart);
+                if (m_linkSize == sizeof(ULONG64))
                 {
-                    return E_INVALIDARG;
+                    memcpy(&pLinks[i], pLink, sizeof(ULONG64));
+                }
+                else
+                {
+                    ULONG link;
+                    memcpy(&link, pLink, sizeof(ULONG));
+                    pLinks[i] = link;
                 }
+            }
+        }
 
-                Object contextObj = pContextObject;
-                Object idxVal = InvokeFunctionFromPack(m_getAtFunction, contextObj, static_cast<size_t>(indexerCount), ppIndexers, ppMetadata);
+    private:
 
-                *ppObject = idxVal.Detach();
-            }
-            catch(...)
-            {
-                return Exceptions::ReturnResult(std::current_exception(), ppObject);
-            }
+        HostContext m_context;
+        ComPtr<IDebugHostMemory> m_spMemory;
+        ULONG m_linkSize;
+        std::vector<ULONG64> m_linkOffsets;
+        ULONG64 m_spanStart;
+        std::vector<unsigned char> m_span;
+    };
 
-            return S_OK;
-        }
+    // NativeWalkCursor:
+    //
+    // The position of a single pass over a native list or tree.  It tracks the node budget and visited nodes and
+    // creates the typed object for the current node on demand.
+    //
+    class NativeWalkCursor
+    {
+    public:
 
-        IFACEMETHOD(SetAt)(_In_ IModelObject *pContextObject,
-                           _In_ ULONG64 indexerCount,
-                           _In_reads_(indexerCount) IModelObject **ppIndexers,
-                           _In_ IModelObject *pValue)
+        NativeWalkCursor(_In_ std::shared_ptr<const NativeWalkState> spState) :
+            m_spState(std::move(spState)),
+            m_reader(*m_spState),
+            m_termination(WalkTermination::InProgress),
+            m_discovered(0),
+            m_currentNode(0)
         {
-            try
-            {
-                ThrowIfDetached(this->m_linkReference);
-                if (indexerCount != Dimensionality)
-                {
-                    return E_INVALIDARG;
-                }
-
-                //
-                // The value has to be type matched to the second argument of the functor.  A setAt signature is
-                // (const Object& contextObject, TValue val, <indexers>)
-                //
-                using ValueType = typename FunctorTraits<TSetAt>::template ArgumentType_t<1>;
+        }
 
-                Object valueObj = pValue;
-                ValueType val = (ValueType)valueObj;
+        NativeWalkCursor(_In_ const NativeWalkCursor&) =delete;
+        NativeWalkCursor& operator=(_In_ const NativeWalkCursor&) =delete;
 
-                Object contextObj = pContextObject;
-                Object dummyReturn = InvokeFunctionFromPack(m_setAtFunction, contextObj, static_cast<size_t>(indexerCount), ppIndexers, nullptr, val);
-            }
-            catch(...)
+        // GetCurrent():
+        //
+        // Returns the containing record of the current node, creating it on first use.
+        //
+        const Object& GetCurrent()
+        {
+            if (m_current.GetObject() == nullptr)
             {
-                return Exceptions::ReturnResult(std::current_exception());
+                Location recordLocation(m_currentNode - m_spState->EntryOffset);
+                m_current = Object::CreateTyped(m_spState->Context, m_spState->ContainingType, recordLocation);
             }
-            return S_OK;
+            return m_current;
+        }
+
+        // GetTermination():
+        //
+        // Returns why this pass stopped producing elements (or WalkTermination::InProgress if it has not).
+        //
+        WalkTermination GetTermination() const
+        {
+            return m_termination;
         }
 
     protected:
 
-        virtual void Apply(_In_opt_ IModelObject *pOverrideObject = nullptr)
+        void SetCurrent(_In_ ULONG64 nodeAddress)
         {
-            BoundIterableBase<TClass, TGenProjector, TItemProjector>::Apply(pOverrideObject);
-            this->GetObject(pOverrideObject)->SetConcept(__uuidof(IIndexableConcept), static_cast<IIndexableConcept *>(this), nullptr);
+            m_currentNode = nodeAddress;
+            m_current = Object();
         }
 
-    private:
+        void Terminate(_In_ WalkTermination termination)
+        {
+            m_termination = termination;
+        }
 
-        TGetAtFunction m_getAtFunction;
-        TSetAtFunction m_setAtFunction;
+        bool IsInProgress() const
+        {
+            return m_termination == WalkTermination::InProgress;
+        }
 
-    };
+        // Discover():
+        //
+        // Accounts for a newly reached node.  If the node cannot be produced because of the node budget or because it
+        // was already visited, the walk is terminated and false is returned.
+        //
+        bool Discover(_In_ ULONG64 nodeAddress)
+        {
+            if (m_discovered >= m_spState->Options.MaxNodes)
+            {
+                Terminate(WalkTermination::NodeBudget);
+                return false;
+            }
 
-    template<typename TClass, typename TGenProjector, typename TItemProjector>
-    class BoundIterable :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            std::conditional_t<IsRandomAccessIterable_v<typename FunctorTraits<TGenProjector>::ReturnType>,
-                               BoundIterableIndexableBase<TClass, TGenProjector, TItemProjector>,
-                               BoundIterableBase<TClass, TGenProjector, TItemProjector>>
-            >
-    {
-    public:
+            if (m_spState->Options.DetectCycles && !m_visited.insert(nodeAddress).second)
+            {
+                Terminate(WalkTermination::Cycle);
+                return false;
+            }
 
-        BoundIterable(_In_ DataModelReference&& transferredLinkReference,
-                      _In_ const TGenProjector& genProjectionFunction,
-                      _In_ const TItemProjector& itemProjectionFunction,
-                      _In_ IModelObject *pOverrideObject) : BoundIterable(std::move(transferredLinkReference),
-                                                                          nullptr,
-                                                                          genProjectionFunction,
-                                                                          itemProjectionFunction,
-                                                                          pOverrideObject) { }
+            ++m_discovered;
+            return true;
+        }
 
-        BoundIterable(_In_ DataModelReference&& transferredLinkReference,
-                      _In_ TClass *pClass,
-                      _In_ const TGenProjector& genProjectionFunction,
-                      _In_ const TItemProjector& itemProjectionFunction) : BoundIterable(std::move(transferredLinkReference),
-                                                                                         pClass,
-                                                                                         genProjectionFunction,
-                                                                                         itemProjectionFunction,
-                                                                                         nullptr) { }
+        std::shared_ptr<const NativeWalkState> m_spState;
+        NativeLinkReader m_reader;
 
-        BoundIterable(_In_ DataModelReference&& transferredLinkReference,
-                      _In_ TClass *pClass,
-                      _In_ const TGenProjector& genProjectionFunction,
-                      _In_ const TItemProjector& itemProjectionFunction,
-                      _In_ IModelObject *pOverrideObject)
-        {
-            //
-            // This isn't done through base initializers because of the flow through WRL::RuntimeClass.
-            //
-            this->m_pClass = pClass;
-            this->m_itemProjector = itemProjectionFunction;
-            this->m_genProjector = genProjectionFunction;
-            this->m_linkReference = std::move(transferredLinkReference);
-            this->Apply(pOverrideObject);
-        }
+    private:
+
+        WalkTermination m_termination;
+        ULONG64 m_discovered;
+        std::unordered_set<ULONG64> m_visited;
+        ULONG64 m_currentNode;
+        Object m_current;
     };
 
-    //*************************************************
-    // Custom Comparison and Equality:
+    // ListWalkCursor:
     //
-
-    template<typename TClass, typename TEquatableProjector>
-    class BoundEquatable :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IEquatableConcept
-            >
+    // A pass over a native list.  Links are chased in batches of up to ReadAhead entries ahead of the consumer.  If
+    // a read fails after some entries were chased, the failure is deferred until those entries are consumed.
+    //
+    class ListWalkCursor : public NativeWalkCursor
     {
     public:
 
-        using EquatableProjectorFunction = typename ClientEx::Details::FunctorTraits<TEquatableProjector>::FunctionType;
+        ListWalkCursor(_In_ std::shared_ptr<const NativeWalkState> spState) :
+            NativeWalkCursor(std::move(spState)),
+            m_lastEntry(m_spState->RootAddress)
+        {
+        }
 
-        BoundEquatable(_In_ TClass *pClass,
-                       _In_ const TEquatableProjector& equatableProjectorFunction)
+        bool MoveNext()
         {
-            m_pClass = pClass;
-            m_equatableProjector = equatableProjectorFunction;
-            Apply();
+            if (m_pendingEntries.empty())
+            {
+                ReadAhead();
+                if (m_pendingEntries.empty())
+                {
+                    return false;
+                }
+            }
+
+            SetCurrent(m_pendingEntries.front());
+            m_pendingEntries.pop_front();
+            return true;
         }
 
-        //*************************************************
-        // IEquatableConcept:
-        //
+    private:
 
-        // AreObjectsEqual():
-        //
-        // Compares this object to another (of arbitrary type) for equality.  If
-        // the comparison cannot be performed, E_NOT_SET should be returned.
-        //
-        IFACEMETHOD(AreObjectsEqual)(_In_ IModelObject *pContextObject,
-                                     _In_ IModelObject *pOtherObject,
-                                     _Out_ bool *pIsEqual)
+        void ReadAhead()
         {
-            try
+            if (m_deferredFailure)
             {
-                ClientEx::Object contextObj = pContextObject;
-                ClientEx::Object otherObj = pOtherObject;
-                *pIsEqual = m_equatableProjector(contextObj, otherObj);
+                std::rethrow_exception(m_deferredFailure);
             }
-            catch(...)
+
+            ULONG readAhead = (m_spState->Options.ReadAhead == 0 ? 1 : m_spState->Options.ReadAhead);
+            while (m_pendingEntries.size() < readAhead && IsInProgress())
+            {
+                ULONG64 nextEntry;
+                try
+                {
+                    m_reader.Read(m_lastEntry, &nextEntry);
+                }
+                catch(...)
+                {
+                    if (m_pendingEntries.empty())
+                    {
+                        throw;
+                    }
+                    m_deferredFailure = std::current_exception();
+                    return;
+                }
+
+                if (nextEntry == 0 || nextEntry == m_spState->RootAddress)
+                {
+                    Terminate(WalkTermination::Complete);
+                }
+                else if (Discover(nextEntry))
+                {
+                    m_pendingEntries.push_back(nextEntry);
+                    m_lastEntry = nextEntry;
+                }
+            }
+        }
+
+        ULONG64 m_lastEntry;
+        std::deque<ULONG64> m_pendingEntries;
+        std::exception_ptr m_deferredFailure;
+    };
+
+    // TreeWalkCursor:
+    //
+    // An in order pass over a native binary tree using an explicit stack of the nodes whose left subtrees are being
+    // visited.  Each node is read once and its right link is kept on the stack.
+    //
+    class TreeWalkCursor : public NativeWalkCursor
+    {
+    public:
+
+        TreeWalkCursor(_In_ std::shared_ptr<const NativeWalkState> spState) :
+            NativeWalkCursor(std::move(spState)),
+            m_started(false),
+            m_currentRight(0)
+        {
+        }
+
+        bool MoveNext()
+        {
+            PushLeftSpine(m_started ? m_currentRight : m_spState->RootAddress);
+            m_started = true;
+
+            if (m_stack.empty())
             {
-                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+                if (IsInProgress())
+                {
+                    Terminate(WalkTermination::Complete);
+                }
+                return false;
             }
-            return S_OK;
+
+            SetCurrent(m_stack.back().Node);
+            m_currentRight = m_stack.back().Right;
+            m_stack.pop_back();
+            return true;
         }
 
     private:
 
-        void Apply()
+        struct PendingNode
         {
-            m_pClass->GetObject()->SetConcept(__uuidof(IEquatableConcept), static_cast<IEquatableConcept *>(this), nullptr);
+            ULONG64 Node;
+            ULONG64 Right;
+        };
+
+        void PushLeftSpine(_In_ ULONG64 node)
+        {
+            while (node != 0 && IsInProgress() && Discover(node))
+            {
+                ULONG64 links[2];
+                m_reader.Read(node, links);
+                m_stack.push_back(PendingNode { node, links[1] });
+                node = links[0];
+            }
         }
 
-        TClass *m_pClass;
-        EquatableProjectorFunction m_equatableProjector;
+        bool m_started;
+        ULONG64 m_currentRight;
+        std::vector<PendingNode> m_stack;
     };
 
-    template<typename TClass, typename TComparableProjector>
-    class BoundComparable :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IComparableConcept
-            >
+    // NativeWalkIterator:
+    //
+    // A C++ input iterator over a native list or tree.  Copies of an iterator share the same position.  Once an
+    // iterator reaches the end, it still reports why its pass ended through GetTermination().
+    //
+    template<typename TCursor>
+    class NativeWalkIterator
     {
     public:
 
-        using ComparableProjectorFunction = typename ClientEx::Details::FunctorTraits<TComparableProjector>::FunctionType;
+        using value_type = Object;
+        using reference = const Object&;
+        using pointer = const Object *;
+        using difference_type = size_t;
+        using iterator_category = std::input_iterator_tag;
 
-        BoundComparable(_In_ TClass *pClass,
-                       _In_ const TComparableProjector& comparableProjectorFunction)
+        NativeWalkIterator() :
+            m_termination(WalkTermination::InProgress)
         {
-            m_pClass = pClass;
-            m_comparableProjector = comparableProjectorFunction;
-            Apply();
         }
 
-        //*************************************************
-        // IComparableConcept:
-        //
+        NativeWalkIterator(_In_ std::shared_ptr<TCursor> spCursor) :
+            m_spCursor(std::move(spCursor)),
+            m_termination(WalkTermination::InProgress)
+        {
+            MoveForward();
+        }
 
-        // CompareObjects():
-        //
-        // Compares this object to another (of arbitrary type).  If the comparison
-        // cannot be performed, E_NOT_SET should be returned.
-        //
-        // The return value passed in comparison result has the following meaning:
-        //
-        //    < 0 : contextObject < otherObject
-        //      0 : contextObject == otherObject
-        //    > 0 : contextObject > otherObject
-        //
-        IFACEMETHOD(CompareObjects)(_In_ IModelObject *pContextObject,
-                                    _In_ IModelObject *pOtherObject,
-                                    _Out_ int *pComparisonResult)
+        bool operator==(_In_ const NativeWalkIterator& rhs) const
         {
-            try
-            {
-                ClientEx::Object contextObj = pContextObject;
-                ClientEx::Object otherObj = pOtherObject;
-                *pComparisonResult = m_comparableProjector(contextObj, otherObj);
-            }
-            catch(...)
-            {
-                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
-            }
-            return S_OK;
+            return m_spCursor == rhs.m_spCursor;
         }
 
-    private:
+        bool operator!=(_In_ const NativeWalkIterator& rhs) const
+        {
+            return !operator==(rhs);
+        }
 
-        void Apply()
+        reference operator*() const
         {
-            m_pClass->GetObject()->SetConcept(__uuidof(IComparableConcept), static_cast<IComparableConcept *>(this), nullptr);
+            return m_spCursor->GetCurrent();
         }
 
-        TClass *m_pClass;
-        ComparableProjectorFunction m_comparableProjector;
-    };
+        pointer operator->() const
+        {
+            return &m_spCursor->GetCurrent();
+        }
 
-    // BoxObjectBase:
-    //
-    // Base class for the object boxer.  Provides a set of helpers for unboxing.
-    //
-    struct BoxObjectBase
-    {
-    protected:
+        NativeWalkIterator& operator++()
+        {
+            MoveForward();
+            return *this;
+        }
 
-        // CheckType():
+        // GetTermination():
         //
-        // Checks whether the object is of a "kind" as passed in.  If not, throws
-        // InvalidArgument.
+        // Returns why the pass of this iterator stopped producing elements.  For the iterator returned from end(),
+        // this is always WalkTermination::InProgress.
         //
-        static void CheckType(_In_ const Object& src, _In_ ModelObjectKind requiredKind)
+        WalkTermination GetTermination() const
         {
-            ModelObjectKind mk;
-            HRESULT hr = src->GetKind(&mk);
-            CheckHr(hr);
-
-            if (mk != requiredKind)
-            {
-                throw std::invalid_argument("Illegal object type");
-            }
+            return (m_spCursor != nullptr ? m_spCursor->GetTermination() : m_termination);
         }
 
-        // ExtractInterface():
-        //
-        // Extracts a raw interface from a boxed interface.
-        //
-        template<typename TInterface>
-        static TInterface *ExtractInterface(_In_ const Object& src)
+    private:
+
+        void MoveForward()
         {
-            VARIANT vtVal;
-            HRESULT hr = src->GetIntrinsicValue(&vtVal);
-            CheckHr(hr);
-            if (vtVal.vt != VT_UNKNOWN)
+            if (!m_spCursor->MoveNext())
             {
-                VariantClear(&vtVal);
-                throw std::invalid_argument("Illegal object type");
+                m_termination = m_spCursor->GetTermination();
+                m_spCursor = nullptr;
             }
-
-            //
-            // It is safe to VariantClear and return the raw interface because it is still held by src.
-            //
-            TInterface *pRawInterface = static_cast<TInterface *>(vtVal.punkVal);
-            VariantClear(&vtVal);
-            return pRawInterface;
         }
+
+        std::shared_ptr<TCursor> m_spCursor;
+        WalkTermination m_termination;
     };
 
-    // BoxObjectIntrinsic:
+    // NativeWalk:
     //
-    // For a given T which is intrinsic, box/unbox the intrinsic
+    // An iterable over a native list or tree.  Each call to begin() starts a new pass which is independent of any
+    // other (including one on another thread).
     //
-    template<typename T>
-    struct BoxObjectIntrinsic : public BoxObjectBase
+    template<typename TCursor>
+    class NativeWalk
     {
-        static Object Box(_In_ const T& obj)
-        {
-            using ValueType = std::remove_reference_t<T>;
-            using IntrinsicTraits = IntrinsicTypeTraits<ValueType>;
-            static_assert(has_varianttype_field_v<IntrinsicTraits>, "No BoxObject<T>::Box exists for the given type.  Unable to box.");
-
-            VARIANT vtVal;
-            IntrinsicTraits::FillVariant(&vtVal, obj);
+    public:
 
-            ComPtr<IModelObject> spObj;
-            HRESULT hr = GetManager()->CreateIntrinsicObject(IntrinsicTraits::ObjectKind, &vtVal, &spObj);
-            CheckHr(hr, spObj);
+        using iterator = NativeWalkIterator<TCursor>;
 
-            return Object(std::move(spObj));
+        NativeWalk(_In_ std::shared_ptr<const NativeWalkState> spState) :
+            m_spState(std::move(spState))
+        {
         }
 
-        static T Unbox(_In_ const Object& src)
+        iterator begin() const
         {
-            using IntrinsicTraits = IntrinsicTypeTraits<T>;
-            static_assert(has_varianttype_field_v<IntrinsicTraits>, "No BoxObject<T>::Unbox exists for the given type.  Unable to unbox.");
+            return iterator(std::make_shared<TCursor>(m_spState));
+        }
 
-            VARIANT vtVal;
-            HRESULT hr = src->GetIntrinsicValueAs(IntrinsicTraits::VariantType, &vtVal);
-            CheckHr(hr);
-            T val = IntrinsicTraits::ExtractFromVariant(&vtVal);
-            VariantClear(&vtVal);
-            return val;
+        iterator end() const
+        {
+            return iterator();
         }
+
+    protected:
+
+        std::shared_ptr<const NativeWalkState> m_spState;
     };
 
-    // MethodBoxer:
+    // FindNativeWalkField():
     //
-    // For an object which is a functor, box/unbox the functor.
+    // Looks up a single data member of a type by name and returns its layout (or std::nullopt if there is no such
+    // member).  As with a TypeLayout, a field of the type itself hides any identically named field of a base class
+    // and offsets of base classes are folded in.  Unlike a TypeLayout, no other field of the type is enumerated.
     //
-    template<typename T>
-    struct BoxObjectMethod
+    inline std::optional<FieldLayout> FindNativeWalkField(_In_ const ClientEx::Type& type, _In_z_ const wchar_t *fieldName)
     {
-        static Object Box(_In_ const T& obj)
+        ComPtr<IDebugHostSymbolEnumerator> spEnum;
+        if (SUCCEEDED(type->EnumerateChildren(SymbolField, fieldName, &spEnum)))
         {
-            ComPtr<BoxedMethod<T>> spMethodInterface = Make<BoxedMethod<T>>(obj);
-            if (spMethodInterface == nullptr)
+            ComPtr<IDebugHostSymbol> spSym;
+            while (SUCCEEDED(spEnum->GetNext(&spSym)))
             {
-                throw std::bad_alloc();
+                Field field = symbol_cast<Field>(std::move(spSym));
+                if (!field.IsMember())
+                {
+                    continue;
+                }
+
+                FieldLayout layout;
+                layout.Name = fieldName;
+                layout.Offset = field.GetOffset();
+                layout.FieldType = field.Type();
+                layout.IsBitField = layout.FieldType.IsBitField();
+                layout.BitField = layout.IsBitField ? layout.FieldType.BitField() : BitFieldInformation { 0, 0 };
+                return layout;
             }
+        }
 
-            // @TODO: This should be part of the boxer.
-            VARIANT vtVal;
-            vtVal.vt = VT_UNKNOWN;
-            vtVal.punkVal = static_cast<IModelMethod *>(spMethodInterface.Get());
-            ComPtr<IModelObject> spMethod;
-            CheckHr(GetManager()->CreateIntrinsicObject(ObjectMethod, &vtVal, &spMethod));
-            return Object(std::move(spMethod));
+        for (auto&& baseClass : type.BaseClasses())
+        {
+            //
+            // Virtual bases have no fixed offset.  See TypeLayout.
+            //
+            ULONG64 baseClassOffset;
+            if (FAILED(baseClass->GetOffset(&baseClassOffset)))
+            {
+                continue;
+            }
+
+            std::optional<FieldLayout> baseField = FindNativeWalkField(baseClass.Type(), fieldName);
+            if (baseField.has_value())
+            {
+                baseField->Offset += baseClassOffset;
+                return baseField;
+            }
         }
-    };
 
-    // NotImplementedSetFunction:
+        return std::nullopt;
+    }
+
+    // GetNativeWalkField():
     //
-    // A set function that throws not-implemented, used for read-only
-    // properties.
+    // As FindNativeWalkField().  If there is no such field, this will throw.
     //
-
-    inline void NotImplementedSetFunction(_In_ const Object& /*instanceObject*/, _In_ const Object& /*value*/)
+    inline FieldLayout GetNativeWalkField(_In_ const ClientEx::Type& type, _In_z_ const wchar_t *fieldName)
     {
-        throw not_implemented();
+        std::optional<FieldLayout> field = FindNativeWalkField(type, fieldName);
+        if (!field.has_value())
+        {
+            throw std::invalid_argument("Field not found");
+        }
+        return std::move(*field);
     }
 
-    // BoxProperty:
+    // GetNativeLinkSize():
     //
-    // For a pair of get/set functors, make a property and box it.
+    // Returns the width of a link of the given (pointer) type.
     //
-    template<typename TGetFunc, typename TSetFunc>
-    inline Object BoxProperty(_In_ const TGetFunc& getFunc, _In_ const TSetFunc& setFunc)
+    inline ULONG GetNativeLinkSize(_In_ const ClientEx::Type& linkType)
     {
-        using GetterTraits = FunctorTraits<TGetFunc>;
-        using SetterTraits = FunctorTraits<TSetFunc>;
-        using Getter0Decay = std::decay_t<typename SetterTraits::template ArgumentType_t<0>>;
-        using Setter0Decay = std::decay_t<typename SetterTraits::template ArgumentType_t<0>>;
-
-        static_assert(SetterTraits::ArgumentCount == 2, "Invalid signature for property set functor");
-        static_assert(GetterTraits::ArgumentCount == 1, "Invalid signature for property get functor");
-        static_assert(std::is_same_v<Getter0Decay, Object>, "Invalid signature for property get functor");
-        static_assert(std::is_same_v<Setter0Decay, Object>, "Invalid signature for property set functor");
+        ULONG64 linkSize = linkType.Size();
+        if (linkSize != sizeof(ULONG) && linkSize != sizeof(ULONG64))
+        {
+            throw std::invalid_argument("Link fields must be 32 or 64-bit pointers");
+        }
+        return static_cast<ULONG>(linkSize);
+    }
 
-        ComPtr<BoxedProperty<TGetFunc, TSetFunc>> spPropertyInterface = Make<BoxedProperty<TGetFunc, TSetFunc>>(getFunc, setFunc);
-        if (spPropertyInterface == nullptr)
+    // GetNativeWalkRoot():
+    //
+    // Returns the address of the node which an object is or points to.
+    //
+    inline ULONG64 GetNativeWalkRoot(_In_ const Object& rootObject)
+    {
+        ClientEx::Type rootType = rootObject.Type();
+        if (rootType != nullptr && rootType.IsPointer() && rootObject.GetKind() == ObjectIntrinsic)
         {
-            throw std::bad_alloc();
+            return static_cast<ULONG64>(rootObject);
         }
+        return rootObject.GetLocation().Offset;
+    }
+}
 
-        // @TODO: This should be part of the boxer.
-        VARIANT vtVal;
-        vtVal.vt = VT_UNKNOWN;
-        vtVal.punkVal = static_cast<IModelPropertyAccessor *>(spPropertyInterface.Get());
-        ComPtr<IModelObject> spProperty;
-        CheckHr(GetManager()->CreateIntrinsicObject(ObjectPropertyAccessor, &vtVal, &spProperty));
-        return Object(std::move(spProperty));
+// ListWalk:
+//
+// An iterable over the elements of a native list (see Object::WalkList):
+//
+//     Type processType = Type(Module(HostContext::DeferredCurrent(), L"nt"), L"_EPROCESS");
+//     Object listHead = Object::FromGlobalSymbol(HostContext::DeferredCurrent(), L"nt", L"PsActiveProcessHead");
+//     for (auto&& process : listHead.WalkList(L"ActiveProcessLinks", processType))
+//     {
+//         ...
+//     }
+//
+// The walk ends when a link returns to the head or is null.  It also ends if a node is reached twice or the node
+// budget of the walk options is exhausted.  GetTermination() on the iterator of the pass tells which.
+//
+class ListWalk : public Details::NativeWalk<Details::ListWalkCursor>
+{
+public:
+
+    using Details::NativeWalk<Details::ListWalkCursor>::NativeWalk;
+};
+
+// TreeWalk:
+//
+// An in order iterable over the elements of a native binary tree (see Object::WalkTree).  The walk ends when every
+// node has been visited.  It also ends if a node is reached twice or the node budget of the walk options is
+// exhausted.  GetTermination() on the iterator of the pass tells which.
+//
+class TreeWalk : public Details::NativeWalk<Details::TreeWalkCursor>
+{
+public:
+
+    using Details::NativeWalk<Details::TreeWalkCursor>::NativeWalk;
+};
+
+inline ListWalk Object::WalkList(_In_z_ const wchar_t *entryFieldName,
+                                 _In_ const ClientEx::Type& containingType,
+                                 _In_ const WalkOptions& options) const
+{
+    return WalkList(Details::GetNativeWalkField(containingType, entryFieldName), containingType, options);
+}
+
+inline ListWalk Object::WalkList(_In_ const FieldLayout& entryField,
+                                 _In_ const ClientEx::Type& containingType,
+                                 _In_ const WalkOptions& options) const
+{
+    std::optional<FieldLayout> linkField = Details::FindNativeWalkField(entryField.FieldType, L"Flink");
+    if (!linkField.has_value())
+    {
+        linkField = Details::FindNativeWalkField(entryField.FieldType, L"Next");
+    }
+    if (!linkField.has_value())
+    {
+        throw std::invalid_argument("List entry field must be a LIST_ENTRY or SINGLE_LIST_ENTRY");
     }
 
-    // BoxProperty:
+    auto spState = std::make_shared<Details::NativeWalkState>();
+    spState->Context = *this;
+    spState->ContainingType = containingType;
+    spState->EntryOffset = entryField.Offset;
+    spState->RootAddress = Details::GetNativeWalkRoot(*this);
+    spState->LinkSize = Details::GetNativeLinkSize(linkField->FieldType);
+    spState->LinkOffsets.push_back(linkField->Offset);
+    spState->Options = options;
+    return ListWalk(std::move(spState));
+}
+
+inline TreeWalk Object::WalkTree(_In_z_ const wchar_t *nodeFieldName,
+                                 _In_ const ClientEx::Type& containingType,
+                                 _In_ const WalkOptions& options) const
+{
+    return WalkTree(nodeFieldName, containingType, L"Left", L"Right", options);
+}
+
+inline TreeWalk Object::WalkTree(_In_z_ const wchar_t *nodeFieldName,
+                                 _In_ const ClientEx::Type& containingType,
+                                 _In_z_ const wchar_t *leftFieldName,
+                                 _In_z_ const wchar_t *rightFieldName,
+                                 _In_ const WalkOptions& options) const
+{
+    FieldLayout nodeField = Details::GetNativeWalkField(containingType, nodeFieldName);
+    FieldLayout leftField = Details::GetNativeWalkField(nodeField.FieldType, leftFieldName);
+    FieldLayout rightField = Details::GetNativeWalkField(nodeField.FieldType, rightFieldName);
+
+    ULONG linkSize = Details::GetNativeLinkSize(leftField.FieldType);
+    if (Details::GetNativeLinkSize(rightField.FieldType) != linkSize)
+    {
+        throw std::invalid_argument("Left and right links must be the same width");
+    }
+
+    auto spState = std::make_shared<Details::NativeWalkState>();
+    spState->Context = *this;
+    spState->ContainingType = containingType;
+    spState->EntryOffset = nodeField.Offset;
+    spState->RootAddress = Details::GetNativeWalkRoot(*this);
+    spState->LinkSize = linkSize;
+    spState->LinkOffsets.push_back(leftField.Offset);
+    spState->LinkOffsets.push_back(rightField.Offset);
+    spState->Options = options;
+    return TreeWalk(std::move(spState));
+}
+
+//**************************************************************************
+// Native Queries:
+//
+
+namespace Details
+{
+    // QuerySourceCursor:
     //
-    // For a get functor, make a property and box it. The implicit set functor
-    // will throw not_implemented.
+    // The first stage of a query: pulls elements from any C++ iterable (including an iterable Object).  The source is
+    // not begun until the first element is requested.
     //
-    template <typename TGetFunc>
-    inline Object BoxProperty(_In_ const TGetFunc& getFunc)
+    template<typename TIterable>
+    class QuerySourceCursor
     {
-        return BoxProperty(getFunc, &NotImplementedSetFunction);
-    }
+    public:
 
-    // BoxObjectArray:
-    //
-    // For a T[N] array, box/unbox it.
-    //
-    template<typename T, size_t N>
-    struct BoxObjectArray
-    {
-        static Object Box(_In_ const T tArray[N])
+        using IteratorType = decltype(std::declval<const TIterable&>().begin());
+        using ValueType = std::decay_t<decltype(*std::declval<IteratorType&>())>;
+
+        QuerySourceCursor(_In_ std::shared_ptr<const TIterable> spSource) :
+            m_spSource(std::move(spSource))
         {
-            Object arrayObject = Object::Create(HostContext());
-            Microsoft::WRL::Make<BoxedArray<T>>(arrayObject, tArray, N);
-            return arrayObject;
         }
-    };
 
-    template<typename T>
-    struct InterfaceTraits
-    {
-    };
+        bool MoveNext()
+        {
+            m_current.reset();
+            if (!m_itCur.has_value())
+            {
+                m_itCur.emplace(m_spSource->begin());
+                m_itEnd.emplace(m_spSource->end());
+            }
+            else
+            {
+                ++(*m_itCur);
+            }
 
-    template<> struct InterfaceTraits<IModelMethod>
-    {
-        static const ModelObjectKind ObjectKind = ObjectMethod;
-    };
+            if (*m_itCur == *m_itEnd)
+            {
+                return false;
+            }
 
-    template<> struct InterfaceTraits<IModelPropertyAccessor>
-    {
-        static const ModelObjectKind ObjectKind = ObjectPropertyAccessor;
-    };
+            m_current.emplace(**m_itCur);
+            return true;
+        }
 
-    template<> struct InterfaceTraits<IModelKeyReference>
-    {
-        static const ModelObjectKind ObjectKind = ObjectKeyReference;
-    };
+        const ValueType& Current() const
+        {
+            return *m_current;
+        }
 
-    template<> struct InterfaceTraits<IDebugHostContext>
-    {
-        static const ModelObjectKind ObjectKind = ObjectContext;
+    private:
+
+        std::shared_ptr<const TIterable> m_spSource;
+        std::optional<IteratorType> m_itCur;
+        std::optional<IteratorType> m_itEnd;
+        std::optional<ValueType> m_current;
     };
 
-    // BoxObjectInterface:
+    // QueryWhereCursor:
     //
-    // Helper class which acts as a boxer/unboxer for various interfaces.
+    // A filtering stage of a query.  Elements for which the predicate is false are skipped.
     //
-    template<typename TInterface>
-    struct BoxObjectInterface : public BoxObjectBase
+    template<typename TInner, typename TPredicate>
+    class QueryWhereCursor
     {
-        static Object Box(_In_ TInterface *interfacePointer)
+    public:
+
+        using ValueType = typename TInner::ValueType;
+
+        QueryWhereCursor(_In_ const TInner& inner, _In_ TPredicate predicate) :
+            m_inner(inner),
+            m_predicate(std::move(predicate))
         {
-            ModelObjectKind mk = Details::InterfaceTraits<TInterface>::ObjectKind;
-            VARIANT vtUnk; vtUnk.vt = VT_UNKNOWN; vtUnk.punkVal = interfacePointer;
-            ComPtr<IModelObject> spInterface;
-            CheckHr(GetManager()->CreateIntrinsicObject(mk, &vtUnk, &spInterface));
-            return Object(std::move(spInterface));
         }
 
-        static TInterface *Unbox(_In_ const Object& src)
+        bool MoveNext()
         {
-            CheckType(src, InterfaceTraits<TInterface>::ObjectKind);
-            return ExtractInterface<TInterface>(src);
+            while (m_inner.MoveNext())
+            {
+                if (m_predicate(m_inner.Current()))
+                {
+                    return true;
+                }
+            }
+            return false;
         }
+
+        const ValueType& Current() const
+        {
+            return m_inner.Current();
+        }
+
+    private:
+
+        TInner m_inner;
+        TPredicate m_predicate;
     };
 
-    // SpotLinkReference:
+    // QuerySelectCursor:
     //
-    // Link reference helper class for bindings without an associated model class.
+    // A projecting stage of a query.  The projected value is native and is only boxed if it is the final element
+    // handed back through the data model.
     //
-    class SpotLinkReference
+    template<typename TInner, typename TSelector>
+    class QuerySelectCursor
     {
     public:
 
-        SpotLinkReference() : m_dataRef(std::make_shared<DataModelReferenceInfo>()) { }
-        SpotLinkReference(_In_ SpotLinkReference&& src) : m_dataRef(std::move(src.m_dataRef)) { }
-        SpotLinkReference& operator=(_In_ SpotLinkReference&& src) { m_dataRef = std::move(src.m_dataRef); return *this; }
+        using ValueType = std::decay_t<std::invoke_result_t<const TSelector&, const typename TInner::ValueType&>>;
 
-        ~SpotLinkReference()
+        QuerySelectCursor(_In_ const TInner& inner, _In_ TSelector selector) :
+            m_inner(inner),
+            m_selector(std::move(selector))
         {
-            if (m_dataRef != nullptr)
+        }
+
+        bool MoveNext()
+        {
+            m_current.reset();
+            if (!m_inner.MoveNext())
             {
-                m_dataRef->TypeIsLive = false;
+                return false;
             }
+
+            m_current.emplace(m_selector(m_inner.Current()));
+            return true;
         }
 
-        const DataModelReference& GetLinkReference() const
+        const ValueType& Current() const
         {
-            return m_dataRef;
+            return *m_current;
         }
 
     private:
 
-        SpotLinkReference(_In_ const SpotLinkReference&) =delete;
-        SpotLinkReference& operator=(_In_ const SpotLinkReference&) =delete;
-
-        DataModelReference m_dataRef;
+        TInner m_inner;
+        TSelector m_selector;
+        std::optional<ValueType> m_current;
     };
 
-    // EmptyBinding:
+    // QueryTakeCursor:
     //
-    // Helper class for bindings without an associated model class.
+    // A limiting stage of a query.  Once count elements have been produced, nothing more is pulled from the stages
+    // before it (or from the source).
     //
-    struct EmptyBinding
+    template<typename TInner>
+    class QueryTakeCursor
     {
-        IModelObject *GetObject() { throw not_implemented(); }
+    public:
+
+        using ValueType = typename TInner::ValueType;
+
+        QueryTakeCursor(_In_ const TInner& inner, _In_ ULONG64 count) :
+            m_inner(inner),
+            m_remaining(count)
+        {
+        }
+
+        bool MoveNext()
+        {
+            if (m_remaining == 0)
+            {
+                return false;
+            }
+
+            if (!m_inner.MoveNext())
+            {
+                m_remaining = 0;
+                return false;
+            }
+
+            --m_remaining;
+            return true;
+        }
+
+        const ValueType& Current() const
+        {
+            return m_inner.Current();
+        }
+
+    private:
+
+        TInner m_inner;
+        ULONG64 m_remaining;
     };
 
-    // BoxObjectIterable:
+    // QueryIterator:
     //
-    // Helper class which acts as a boxer for iterables which have no other specific
-    // boxer.
+    // A C++ input iterator over the results of a query.  An iterator owns a copy of the fused cursor of every stage.
     //
-    template<typename TIterable>
-    struct BoxObjectIterable : public BoxObjectBase
+    template<typename TCursor>
+    class QueryIterator
     {
     public:
 
+        using value_type = typename TCursor::ValueType;
+        using reference = const value_type&;
+        using pointer = const value_type *;
+        using difference_type = size_t;
+        using iterator_category = std::input_iterator_tag;
+
+        QueryIterator() : m_pos(0) { }
+
+        QueryIterator(_In_ const TCursor& cursor) :
+            m_cursor(cursor),
+            m_pos(0)
+        {
+            MoveForward();
+        }
+
+        QueryIterator(_In_ const QueryIterator& rhs) =default;
+        QueryIterator(QueryIterator&& rhs) =default;
+
         //
-        // We have some move only iterables (e.g.: generators).  Deal with boxing them by moving the container
-        // into the projector and requiring that it live for the lifetime of the iterable (via a linkref)
+        // The stages hold lambdas which are copy constructible but not assignable.  Assignment reconstructs the
+        // cursor instead.
         //
-        template<typename TObj>
-        static Object Box(_In_ TObj&& iterable)
+        QueryIterator& operator=(_In_ const QueryIterator& rhs)
         {
-            static_assert(
-                std::is_same_v<std::decay_t<TObj>, std::decay_t<TIterable>> ||
-                std::is_same_v<std::decay_t<TObj>, std::shared_ptr<TIterable>>,
-                "Illegal argument to BoxObject<T>::Box for an iterable");
-            //
-            // genProjectorFunc is the *HOLDER* of the iterable until such time as it is
-            // used.  It remains the holder during iteration.
-            //
-            // Because we embody the functors in std::function, the lambdas must be copy constructable.  We
-            // cannot directly move iterable into the lambda body.  We must enclose it in something which can be
-            // copied but holds a singular unique moved reference to iterable.
-            //
-            std::shared_ptr<TIterable> spSharedIterable;
-            if constexpr(std::is_same_v<std::decay_t<TObj>, std::shared_ptr<TIterable>>)
+            if (this != &rhs)
             {
-                spSharedIterable = std::forward<TObj>(iterable);
+                m_cursor.reset();
+                if (rhs.m_cursor.has_value())
+                {
+                    m_cursor.emplace(*rhs.m_cursor);
+                }
+                m_pos = rhs.m_pos;
             }
-            else
+            return *this;
+        }
+
+        QueryIterator& operator=(QueryIterator&& rhs)
+        {
+            if (this != &rhs)
             {
-                spSharedIterable.reset(new TIterable(std::forward<TObj>(iterable)));
+                m_cursor.reset();
+                if (rhs.m_cursor.has_value())
+                {
+                    m_cursor.emplace(std::move(*rhs.m_cursor));
+                }
+                m_pos = rhs.m_pos;
             }
-            std::shared_ptr<SpotLinkReference> spSpotRef = std::make_shared<SpotLinkReference>();
-
-            DataModelReference linkRef = spSpotRef->GetLinkReference();
+            return *this;
+        }
 
-            auto genProjectorFunc = [heldSpotRef = std::move(spSpotRef),
-                                     mvIterable = std::move(spSharedIterable)](_In_ const Object& /*emptyObject*/) -> TIterable&
-            {
-                return *(mvIterable.get());
-            };
+        bool operator==(_In_ const QueryIterator& rhs) const
+        {
+            return (m_cursor.has_value() == rhs.m_cursor.has_value() && (!m_cursor.has_value() || m_pos == rhs.m_pos));
+        }
 
-            using TItem = decltype(*(std::declval<std::decay_t<TIterable>>().begin()));
-            auto itemProjectorFunc = [](_In_ TItem eref) { return eref; };
+        bool operator!=(_In_ const QueryIterator& rhs) const
+        {
+            return !operator==(rhs);
+        }
 
-            //
-            // Create an empty object which represents this container and place and iterable upon it.
-            // @TODO: It might be better performance to create a data model with this and attach.
-            //
-            Object container = Object::Create(HostContext());
+        reference operator*() const
+        {
+            return m_cursor->Current();
+        }
 
-            using TGenProjector = decltype(genProjectorFunc);
-            using TItemProjector = decltype(itemProjectorFunc);
+        pointer operator->() const
+        {
+            return &m_cursor->Current();
+        }
 
-            ComPtr<BoundIterable<EmptyBinding, TGenProjector, TItemProjector>> spIterable;
+        QueryIterator& operator++()
+        {
+            MoveForward();
+            return *this;
+        }
 
-            // NOTE:
-            //
-            // The construction of the binding will apply it to the object 'container'.  After
-            // the below line, the iterable concept on 'container' is spIterable.
-            //
-            spIterable = Make<BoundIterable<EmptyBinding, TGenProjector, TItemProjector>>(
-                std::move(linkRef), genProjectorFunc, itemProjectorFunc, container
-                );
+    private:
 
-            return container;
+        void MoveForward()
+        {
+            if (m_cursor->MoveNext())
+            {
+                ++m_pos;
+            }
+            else
+            {
+                m_cursor.reset();
+            }
         }
-    };
 
-} // Details
+        std::optional<TCursor> m_cursor;
+        size_t m_pos;
+    };
+}
 
-//**************************************************************************
-// Object Boxing and Unboxing
+// QueryRange:
 //
-
-namespace Boxing
+// A query over a C++ iterable or an iterable Object (see Query()).  Each stage added by Where(), Select(), or Take()
+// returns a new QueryRange whose cursor wraps the cursor of the stage before it.  The stages are fused by type into a
+// single loop: values stay native C++ types between stages and nothing pulls an element until the consumer asks for
+// one.  A QueryRange is itself a C++ iterable which can be iterated directly or returned from a property or generator
+// (in which case only the final elements are boxed).
+//
+template<typename TCursor>
+class QueryRange
 {
-    namespace Details = Debugger::DataModel::ClientEx::Details;
-
-    // Function and Method Boxing and Unboxing:
-    //
-
-    template<typename T, typename = void>
-    struct BoxObject : public std::conditional_t<Details::has_call_operator_v<T>,
-                                                 Details::BoxObjectMethod<T>,
-                                                 std::conditional_t<Details::IsIterable_v<T>,
-                                                                    Details::BoxObjectIterable<T>,
-                                                                    Details::BoxObjectIntrinsic<T>>>
-    {
-    };
-
-    template<typename T>
-    struct BoxObject<std::shared_ptr<T>, std::enable_if_t<Details::IsIterable_v<T>>> : Details::BoxObjectIterable<T>
-    {
-    };
+public:
 
-    template<typename TRet, typename... TArgs>
-    struct BoxObject<TRet (*)(TArgs...)> : public Details::BoxObjectMethod<TRet (*)(TArgs...)>
+    using iterator = Details::QueryIterator<TCursor>;
+    using ValueType = typename TCursor::ValueType;
+
+    explicit QueryRange(_In_ TCursor cursor) :
+        m_cursor(std::move(cursor))
     {
-    };
+    }
 
-    template<typename TRet, typename... TArgs>
-    struct BoxObject<TRet(TArgs...)> : public Details::BoxObjectMethod<TRet (*)(TArgs...)>
+    // Where():
+    //
+    // Returns a query which produces only the elements for which predicate returns true.
+    //
+    template<typename TPredicate>
+    auto Where(_In_ TPredicate&& predicate) const    // bool predicate(const ValueType&);
     {
-    };
+        using TWhere = Details::QueryWhereCursor<TCursor, std::decay_t<TPredicate>>;
+        return QueryRange<TWhere>(TWhere(m_cursor, std::forward<TPredicate>(predicate)));
+    }
 
-    // Details Reference Type Boxing/Unboxing:
+    // Select():
     //
-    // Specializations of BoxObject<T> for types returned as C++ references.
+    // Returns a query which produces the result of selector for each element.
     //
+    template<typename TSelector>
+    auto Select(_In_ TSelector&& selector) const     // TResult selector(const ValueType&);
+    {
+        using TSelect = Details::QuerySelectCursor<TCursor, std::decay_t<TSelector>>;
+        return QueryRange<TSelect>(TSelect(m_cursor, std::forward<TSelector>(selector)));
+    }
 
-    template<typename TVal, typename... TIndicies>
-    struct BoxObject<IndexedValue<TVal, TIndicies...>>
+    // Take():
+    //
+    // Returns a query which produces at most the first count elements.
+    //
+    QueryRange<Details::QueryTakeCursor<TCursor>> Take(_In_ ULONG64 count) const
     {
-        static Object Box(_In_ const IndexedValue<TVal, TIndicies...>& src)
-        {
-            return BoxObject<TVal>::Box(src.GetValue());
-        }
-    };
+        using TTake = Details::QueryTakeCursor<TCursor>;
+        return QueryRange<TTake>(TTake(m_cursor, count));
+    }
 
-    template<typename TVal>
-    struct BoxObject<ValueWithMetadata<TVal>>
+    // ToVector():
+    //
+    // Runs the query to completion and returns its results.
+    //
+    std::vector<ValueType> ToVector() const
     {
-        static Object Box(_In_ const ValueWithMetadata<TVal>& src)
+        std::vector<ValueType> results;
+        for (auto&& result : *this)
         {
-            return BoxObject<TVal>::Box(src.GetValue());
+            results.push_back(result);
         }
-    };
+        return results;
+    }
 
-    template<>
-    struct BoxObject<Details::ObjectKeyRef<Object, Metadata>>
+    iterator begin() const
     {
-        static Object Box(_In_ const Details::ObjectKeyRef<Object, Metadata>& keyRef)
-        {
-            return keyRef.GetValue();
-        }
-    };
+        return iterator(m_cursor);
+    }
 
-    template<>
-    struct BoxObject<Details::ObjectFieldRef<Object>>
+    iterator end() const
     {
-        static Object Box(_In_ const Details::ObjectFieldRef<Object>& fieldRef)
-        {
-            return fieldRef.GetValue();
-        }
-    };
+        return iterator();
+    }
 
-    template<>
-    struct BoxObject<Details::DereferenceReference<Object>>
+private:
+
+    TCursor m_cursor;
+};
+
+// Query():
+//
+// Begins a native query over a C++ iterable or an iterable Object:
+//
+//     auto threadIds = Query(process.KeyValue(L"Threads"))
+//         .Select([](const Object& thread) { return (ULONG64)thread.KeyValue(L"Id"); })
+//         .Where([](ULONG64 threadId) { return threadId % 4 == 0; })
+//         .Take(10);
+//
+// The source is copied (or moved) into the query and shared by every pass over it.
+//
+template<typename TIterable>
+QueryRange<Details::QuerySourceCursor<std::decay_t<TIterable>>> Query(_In_ TIterable&& source)
+{
+    using TSource = Details::QuerySourceCursor<std::decay_t<TIterable>>;
+    auto spSource = std::make_shared<const std::decay_t<TIterable>>(std::forward<TIterable>(source));
+    return QueryRange<TSource>(TSource(std::move(spSource)));
+}
+
+//**************************************************************************
+// Columnar Snapshots:
+//
+
+// SnapshotColumnType:
+//
+// The storage type of a column of a snapshot.
+//
+enum class SnapshotColumnType : ULONG
+{
+    Int64 = 1,
+    UInt64 = 2,
+    Double = 3,
+    Bool = 4,
+    String = 5      // An index into the dictionary encoded string pool of the snapshot
+};
+
+// SnapshotColumn:
+//
+// The definition of a column written by a SnapshotWriter: a name, a storage type, and a projection which produces the
+// value of the column from each row object.
+//
+class SnapshotColumn
+{
+public:
+
+    SnapshotColumn(_In_ std::wstring name,
+                   _In_ SnapshotColumnType type,
+                   _In_ std::function<Object(const Object&)> projection) :
+        m_name(std::move(name)),
+        m_type(type),
+        m_projection(std::move(projection))
     {
-        static Object Box(_In_ const Details::DereferenceReference<Object>& derefRef)
-        {
-            return derefRef.GetValue();
-        }
-    };
+    }
 
-    template<typename TPack>
-    struct BoxObject<Details::IndexableReference<Object, TPack>>
+    // Key():
+    //
+    // Returns a column whose value is the named key of each row.
+    //
+    static SnapshotColumn Key(_In_ std::wstring keyName, _In_ SnapshotColumnType type)
     {
-        static Object Box(_In_ const Details::IndexableReference<Object, TPack>& indexableRef)
+        std::wstring projectedKey = keyName;
+        return SnapshotColumn(std::move(keyName), type, [projectedKey](_In_ const Object& rowObject)
         {
-            return indexableRef.GetValue();
-        }
-    };
+            return rowObject.KeyValue(projectedKey.c_str());
+        });
+    }
 
-    // String Boxing/Unboxing:
+    // Field():
     //
-    // Specializations of BoxObject<T> for string types.
+    // Returns a column whose value is the named field of each row.
     //
-    template<>
-    struct BoxObject<const wchar_t *>
+    static SnapshotColumn Field(_In_ std::wstring fieldName, _In_ SnapshotColumnType type)
     {
-        static Object Box(_In_z_ const wchar_t *pString)
+        std::wstring projectedField = fieldName;
+        return SnapshotColumn(std::move(fieldName), type, [projectedField](_In_ const Object& rowObject)
         {
-            //
-            // @TODO: It would be nice to have a better mechanism of string creation in DbgModel.  This is a double
-            // alloc.  Wasteful.
-            //
-            BSTR bstrStr = SysAllocString(pString);
-            if (bstrStr == nullptr)
-            {
-                throw std::bad_alloc();
-            }
-            bstr_ptr spStr(bstrStr);
+            return rowObject.FieldValue(projectedField.c_str());
+        });
+    }
 
-            VARIANT vtVal;
-            vtVal.vt = VT_BSTR;
-            vtVal.bstrVal = bstrStr;
-            ComPtr<IModelObject> spString;
-            ClientEx::CheckHr(GetManager()->CreateIntrinsicObject(ObjectIntrinsic, &vtVal, &spString));
-            return Object(std::move(spString));
-        }
+    const std::wstring& GetName() const { return m_name; }
+    SnapshotColumnType GetType() const { return m_type; }
+    Object Project(_In_ const Object& rowObject) const { return m_projection(rowObject); }
+
+private:
+
+    std::wstring m_name;
+    SnapshotColumnType m_type;
+    std::function<Object(const Object&)> m_projection;
+};
+
+namespace Details
+{
+    // Snapshot File Format:
+    //
+    // All offsets are from the start of the file.  All integers are little endian.  Each array starts on an 8 byte
+    // boundary:
+    //
+    //     SnapshotFileHeader
+    //     For each chunk of rows and each column within it:
+    //         The values of the column (as its storage type)
+    //         The validity of each value (one byte per row; zero if the projection failed)
+    //     SnapshotFooter
+    //     SnapshotColumnRecord[ColumnCount]
+    //     SnapshotChunkRecord[ChunkCount]
+    //     SnapshotChunkColumnRecord[ChunkCount * ColumnCount]
+    //     ULONG64[StringCount + 1] (the offset of each string within the string data, in characters)
+    //     wchar_t[StringDataSize] (the string data)
+    //
+    // The header is rewritten with the location of the footer when the snapshot is finished.  A file whose header
+    // has no footer was never finished.
+    //
+    constexpr ULONG SnapshotMagic = 0x534D4244;     // 'DBMS'
+    constexpr ULONG SnapshotVersion = 1;
+
+    struct SnapshotFileHeader
+    {
+        ULONG Magic;
+        ULONG Version;
+        ULONG64 RowCount;
+        ULONG64 FooterOffset;
     };
 
-    template<>
-    struct BoxObject<wchar_t *>
-    {
-        static Object Box(_In_z_ const wchar_t *pString)
-        {
-            return BoxObject<const wchar_t *>::Box(pString);
-        }
+    struct SnapshotFooter
+    {
+        ULONG ColumnCount;
+        ULONG Reserved;
+        ULONG64 ChunkCount;
+        ULONG64 StringCount;
+        ULONG64 StringDataSize;
+        ULONG64 ColumnsOffset;
+        ULONG64 ChunksOffset;
+        ULONG64 ChunkColumnsOffset;
+        ULONG64 StringOffsetsOffset;
+        ULONG64 StringDataOffset;
     };
 
-    template<>
-    struct BoxObject<std::wstring>
+    struct SnapshotColumnRecord
     {
-        static Object Box(_In_ const std::wstring& str)
-        {
-            const wchar_t * pStr = str.c_str();
-            return BoxObject<const wchar_t *>::Box(pStr);
-        }
-
-        static std::wstring Unbox(_In_ const Object& src)
-        {
-            VARIANT vtVal;
-            CheckHr(src->GetIntrinsicValueAs(VT_BSTR, &vtVal));
-            bstr_ptr spvVal(vtVal.bstrVal);
-            return std::wstring(vtVal.bstrVal);
-        }
+        ULONG Type;
+        ULONG NameString;
     };
 
-    template<>
-    struct BoxObject<std::string>
+    struct SnapshotChunkRecord
     {
-        static Object Box(_In_ const std::string& str)
-        {
-            std::wstring wstr = Details::StringUtils::GetWideString(str.c_str());
-            const wchar_t * pStr = wstr.c_str();
-            return BoxObject<const wchar_t *>::Box(pStr);
-        }
+        ULONG64 FirstRow;
+        ULONG64 RowCount;
+    };
 
-        static std::string Unbox(_In_ const Object& src)
-        {
-            VARIANT vtVal;
-            CheckHr(src->GetIntrinsicValueAs(VT_BSTR, &vtVal));
-            bstr_ptr spvVal(vtVal.bstrVal);
-            std::wstring wstrVal(vtVal.bstrVal);
-            std::string strVal = Details::StringUtils::GetNarrowString(wstrVal.c_str());
-            return strVal;
-        }
+    struct SnapshotChunkColumnRecord
+    {
+        ULONG64 ValuesOffset;
+        ULONG64 ValidityOffset;
     };
 
+    // SnapshotStorage:
     //
-    // Enum class Boxing/Unboxing:
-    //
-    // TEnum is an enum class
+    // The C++ type in which the values of each column type are stored.
     //
-    // Example use (make TTD::SequenceId projectable to data model):
-    //     namespace Debugger::DataModel::ClientEx::Boxing
-    //     {
-    //         template <> struct BoxObject<TTD::SequenceId> : UnderlyingTypeBoxObject<TTD::SequenceId> {};
-    //     }
+    template<typename T> struct SnapshotStorage;
+    template<> struct SnapshotStorage<LONG64> { static constexpr SnapshotColumnType ColumnType = SnapshotColumnType::Int64; };
+    template<> struct SnapshotStorage<ULONG64> { static constexpr SnapshotColumnType ColumnType = SnapshotColumnType::UInt64; };
+    template<> struct SnapshotStorage<double> { static constexpr SnapshotColumnType ColumnType = SnapshotColumnType::Double; };
+    template<> struct SnapshotStorage<bool> { static constexpr SnapshotColumnType ColumnType = SnapshotColumnType::Bool; };
+    template<> struct SnapshotStorage<ULONG> { static constexpr SnapshotColumnType ColumnType = SnapshotColumnType::String; };
 
-    template <typename TEnum>
-    struct UnderlyingTypeBoxObject
+    inline size_t GetSnapshotValueSize(_In_ SnapshotColumnType type)
     {
-        static Object Box(_In_ const TEnum& obj)
+        switch(type)
         {
-            return BoxObject<std::underlying_type_t<TEnum>>::Box(static_cast<std::underlying_type_t<TEnum>>(obj));
+            case SnapshotColumnType::Int64:
+            case SnapshotColumnType::UInt64:
+            case SnapshotColumnType::Double:
+                return sizeof(ULONG64);
+
+            case SnapshotColumnType::Bool:
+                return sizeof(bool);
+
+            case SnapshotColumnType::String:
+                return sizeof(ULONG);
         }
 
-        static TEnum Unbox(_In_ const Object& src)
+        throw std::invalid_argument("Unrecognized snapshot column type");
+    }
+
+    // SnapshotHandleCloser:
+    //
+    // A deletion functor which closes a Win32 handle.
+    //
+    struct SnapshotHandleCloser
+    {
+        void operator()(_In_ HANDLE handle)
         {
-            return static_cast<TEnum>(static_cast<std::underlying_type_t<TEnum>>(src));
+            CloseHandle(handle);
         }
     };
 
+    using SnapshotHandle = std::unique_ptr<void, SnapshotHandleCloser>;
+
+    [[noreturn]] inline void ThrowLastError(_In_z_ const char *pMsg)
+    {
+        throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), pMsg);
+    }
+
+    // SnapshotRowRange:
     //
-    // String Resource Boxing/Unboxing:
-    //
-    // ResourceString is pulled upon boxing
-    // DeferredResourceString is boxed into a property which pulls upon GetValue.
+    // A C++ iterable over the rows of a snapshot which produces an object for each row through a function.  Iterators
+    // share the function rather than referring to the range so that they outlive it.
     //
-
-    template<>
-    struct BoxObject<ResourceString>
+    class SnapshotRowRange
     {
-        static Object Box(_In_ const ResourceString& rscString)
+    public:
+
+        class iterator
         {
-            struct LibraryUnloader
-            {
-                void operator()(_In_ void * hModule)
-                {
-                    HMODULE hMod = reinterpret_cast<HMODULE>(hModule);
-                    if (hMod != nullptr)
-                    {
-                        FreeLibrary(hMod);
-                    }
-                }
-            };
+        public:
 
-            using hmodule_ptr = std::unique_ptr<void, LibraryUnloader>;
-            hmodule_ptr spModuleHandle;
+            using value_type = Object;
+            using reference = Object;
+            using pointer = const Object *;
+            using difference_type = size_t;
+            using iterator_category = std::input_iterator_tag;
 
-            HMODULE hModule = rscString.Module;
+            iterator() : m_row(0) { }
 
-            if (hModule == nullptr)
+            iterator(_In_ std::shared_ptr<const std::function<Object(ULONG64)>> spRowFunction, _In_ ULONG64 row) :
+                m_spRowFunction(std::move(spRowFunction)),
+                m_row(row)
             {
-                if (!GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS,
-                                       reinterpret_cast<LPCTSTR>(Box),
-                                       &hModule))
-                {
-                    throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Unable to retrieve resource string");
-                }
-
-                spModuleHandle.reset(hModule);
             }
 
-            std::wstring extractedString;
+            bool operator==(_In_ const iterator& rhs) const { return m_row == rhs.m_row; }
+            bool operator!=(_In_ const iterator& rhs) const { return !operator==(rhs); }
 
-            if (rscString.ResourceType == nullptr)
+            Object operator*() const
             {
-                PWSTR pString;
-                INT result = ::LoadStringW(hModule, rscString.Id, reinterpret_cast<PWSTR>(&pString), 0);
-                if (!result)
-                {
-                    throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Unable to retrieve resource string");
-                }
-
-                extractedString.append(pString, static_cast<size_t>(result));
+                return (*m_spRowFunction)(m_row);
             }
-            else
+
+            iterator& operator++()
             {
-                HRSRC resourceInfo = FindResourceW(hModule, MAKEINTRESOURCEW(rscString.Id), rscString.ResourceType);
+                ++m_row;
+                return *this;
+            }
 
-                if (resourceInfo == NULL)
-                {
-                    throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Unable to retrieve find resource");
-                }
+        private:
 
-                DWORD dwResourceSize = SizeofResource(hModule, resourceInfo);
-                if (dwResourceSize == 0)
-                {
-                    throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Failed to get length of the resource");
-                }
+            std::shared_ptr<const std::function<Object(ULONG64)>> m_spRowFunction;
+            ULONG64 m_row;
+        };
 
-                HGLOBAL resourceHandle = LoadResource(hModule, resourceInfo);
-                if (resourceHandle == NULL)
-                {
-                    throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Failed to load resource for module.");
-                }
+        SnapshotRowRange(_In_ ULONG64 rowCount, _In_ std::function<Object(ULONG64)> rowFunction) :
+            m_rowCount(rowCount),
+            m_spRowFunction(std::make_shared<const std::function<Object(ULONG64)>>(std::move(rowFunction)))
+        {
+        }
 
-                LPWSTR data = static_cast<LPWSTR>(LockResource(resourceHandle));
-                if (data == nullptr)
-                {
-                    throw hr_exception(HRESULT_FROM_WIN32(GetLastError()), "Failed to lock resource");
-                }
+        iterator begin() const { return iterator(m_spRowFunction, 0); }
+        iterator end() const { return iterator(m_spRowFunction, m_rowCount); }
 
-                DWORD cchData = dwResourceSize / sizeof(wchar_t);
+    private:
 
-                // Check for a UTF-16 little endian byte-order mark and skip it if there is one
-                if ((cchData > 0) && (data[0] == 0xfeff))
-                {
-                    data += 1;
-                    cchData -= 1;
+        ULONG64 m_rowCount;
+        std::shared_ptr<const std::function<Object(ULONG64)>> m_spRowFunction;
+    };
+}
 
-                    BSTR resourceString = SysAllocStringLen(data, cchData);
-                    if (resourceString == nullptr)
-                    {
-                        throw hr_exception(E_OUTOFMEMORY, "Failed to allocate string memory for resource");
-                    }
-                    bstr_ptr spResourceString(resourceString);
+// SnapshotWriter:
+//
+// Streams the rows of an iterable into a column oriented snapshot file for later analysis with SnapshotReader:
+//
+//     SnapshotWriter writer(L"threads.snap", { SnapshotColumn::Key(L"Id", SnapshotColumnType::UInt64),
+//                                              SnapshotColumn::Key(L"Name", SnapshotColumnType::String) });
+//     writer.AppendAll(process.KeyValue(L"Threads"));
+//     writer.Finish();
+//
+// Intrinsic columns are stored as typed arrays.  String columns are stored as indices into a pool in which each
+// distinct string appears once.  Rows are buffered in chunks of rowsPerChunk and each chunk is written when it fills,
+// so only the string pool grows with the size of the export.  A value whose projection fails (e.g.: a missing key or
+// unreadable memory) is recorded as invalid rather than ending the export.
+//
+// A writer destroyed without Finish() leaves a file which SnapshotReader rejects.  Once writing to the file fails,
+// the snapshot is abandoned: Append(), AppendAll() and Finish() throw illegal_operation and the header is never
+// pointed at a footer.
+//
+class SnapshotWriter
+{
+public:
 
-                    extractedString = resourceString;
-                }
-                else
-                {
-                    LPSTR stringData = reinterpret_cast<LPSTR>(data);
-                    cchData = dwResourceSize;
+    SnapshotWriter(_In_ const std::wstring& filePath,
+                   _In_ std::vector<SnapshotColumn> columns,
+                   _In_ size_t rowsPerChunk = 65536) :
+        m_columns(std::move(columns)),
+        m_rowsPerChunk(rowsPerChunk == 0 ? 1 : rowsPerChunk),
+        m_buffers(m_columns.size()),
+        m_stagedRow(m_columns.size()),
+        m_offset(0),
+        m_rowCount(0),
+        m_chunkFirstRow(0),
+        m_finished(false),
+        m_failed(false)
+    {
+        if (m_columns.empty())
+        {
+            throw std::invalid_argument("A snapshot must have at least one column");
+        }
+        if (m_columns.size() > static_cast<ULONG>(-1))
+        {
+            throw std::invalid_argument("Too many columns for a snapshot");
+        }
 
-                    std::string strResource(stringData, cchData);
-                    extractedString = Details::StringUtils::GetWideString(strResource.c_str());
-                }
-            }
-            return BoxObject<std::wstring>::Box(extractedString);
+        for (auto&& column : m_columns)
+        {
+            Details::GetSnapshotValueSize(column.GetType());        // Throws for an unrecognized type
+            m_columnNames.push_back(Intern(column.GetName()));
         }
-    };
 
-    template<>
-    struct BoxObject<DeferredResourceString>
-    {
-        static Object Box(_In_ const DeferredResourceString& rscString)
+        HANDLE hFile = CreateFileW(filePath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
         {
-            auto getFunc = [rscString](_In_ const Object& /*instanceObject*/)
-            {
-                ResourceString activePull = rscString;
-                return BoxObject<ResourceString>::Box(activePull);
-            };
+            Details::ThrowLastError("Unable to create snapshot file");
+        }
+        m_file.reset(hFile);
 
-            auto setFunc = [](_In_ const Object& /*instanceObject*/, _In_ const Object& /*value*/)
-            {
-                throw not_implemented();
-            };
+        Details::SnapshotFileHeader header { Details::SnapshotMagic, Details::SnapshotVersion, 0, 0 };
+        Write(&header, sizeof(header));
+    }
 
-            return Details::BoxProperty(getFunc, setFunc);
-        }
-    };
+    SnapshotWriter(_In_ const SnapshotWriter&) =delete;
+    SnapshotWriter& operator=(_In_ const SnapshotWriter&) =delete;
 
-    // Interface Boxing/Unboxing:
+    // Append():
     //
-    // Specializations of BoxObject<T> for known interface pointers.
+    // Projects every column from a row object.  A chunk which the previous row filled is written before the row is
+    // added.  If this throws, no value of the row has been added to any column.
     //
+    void Append(_In_ const Object& rowObject)
+    {
+        ThrowIfUnusable();
+        if (m_rowCount - m_chunkFirstRow == m_rowsPerChunk)
+        {
+            WriteChunk();
+        }
 
-    template<> struct BoxObject<IDebugHostContext *> : public Details::BoxObjectInterface<IDebugHostContext> { };
-    template<> struct BoxObject<IModelMethod *> : public Details::BoxObjectInterface<IModelMethod> { };
-    template<> struct BoxObject<IModelPropertyAccessor *> : public Details::BoxObjectInterface<IModelPropertyAccessor> { };
-    template<> struct BoxObject<IModelKeyReference *> : public Details::BoxObjectInterface<IModelKeyReference> { };
+        for (size_t i = 0; i < m_columns.size(); ++i)
+        {
+            StageValue(i, rowObject);
+        }
 
-    // ComPtr<T>
+        //
+        // Reserve room for the row in every column before adding it to any of them so that adding it cannot fail
+        // part way through.
+        //
+        for (size_t i = 0; i < m_columns.size(); ++i)
+        {
+            ColumnBuffer& buffer = m_buffers[i];
+            ReserveRoom(buffer.Values, m_stagedRow[i].Size);
+            ReserveRoom(buffer.Validity, 1);
+        }
+
+        for (size_t i = 0; i < m_columns.size(); ++i)
+        {
+            ColumnBuffer& buffer = m_buffers[i];
+            const StagedValue& staged = m_stagedRow[i];
+            buffer.Values.insert(buffer.Values.end(), staged.Value, staged.Value + staged.Size);
+            buffer.Validity.push_back(staged.IsValid ? 1 : 0);
+        }
+
+        ++m_rowCount;
+    }
+
+    // AppendAll():
     //
-    // Specializations of BoxObject<T> for ComPtr<Known Interface>
+    // Appends each element of an iterable (an iterable Object or any C++ iterable of objects) as a row.
     //
-
-    template<typename T>
-    struct BoxObject<ComPtr<T>>
+    template<typename TIterable>
+    void AppendAll(_In_ const TIterable& rows)
     {
-        static Object Box(_In_ const ComPtr<T>& cptr)
+        ThrowIfUnusable();
+        for (auto&& rowObject : rows)
         {
-            return BoxObject<T*>::Box(cptr.Get());
+            Append(rowObject);
         }
+    }
 
-        static ComPtr<T> Unbox(_In_ const Object& src)
+    // Finish():
+    //
+    // Writes any partial chunk, the tables which describe the snapshot, and the string pool, and then closes the
+    // file.  Returns the number of rows written.
+    //
+    ULONG64 Finish()
+    {
+        ThrowIfUnusable();
+        try
         {
-            T *pRawInterface = BoxObject<T*>::Unbox(src);
-            return ComPtr<T>(pRawInterface);
+            WriteSnapshotTables();
+        }
+        catch(...)
+        {
+            m_failed = true;
+            throw;
         }
+
+        m_file.reset();
+        m_finished = true;
+        return m_rowCount;
+    }
+
+private:
+
+    struct ColumnBuffer
+    {
+        std::vector<unsigned char> Values;
+        std::vector<unsigned char> Validity;
     };
 
-    // No Operation Boxing/Unboxing
+    // StagedValue:
     //
-    // Specializations of BoxObject<T> for objects and interfaces which are already boxed.
+    // The value of one column of the row being appended, held until every column of the row has been projected.
     //
+    struct StagedValue
+    {
+        unsigned char Value[sizeof(ULONG64)];
+        size_t Size;
+        bool IsValid;
+    };
 
-    template<>
-    struct BoxObject<IModelObject *>
+    void ThrowIfUnusable() const
     {
-        static Object Box(_In_ IModelObject * src)
+        if (m_finished)
         {
-            return Object(src);
+            throw illegal_operation("The snapshot has already been finished");
         }
-
-        static IModelObject *Unbox(_In_ const Object& src)
+        if (m_failed)
         {
-            return src.GetObject();
+            throw illegal_operation("The snapshot was abandoned after a failed write");
         }
-    };
+    }
 
-    template<>
-    struct BoxObject<Object>
+    // WriteSnapshotTables():
+    //
+    // Writes the final chunk, the footer and the tables which follow it, and then points the header at the footer.
+    //
+    void WriteSnapshotTables()
     {
-        static Object Box(_In_ const Object& src)
-        {
-            return src;
-        }
+        WriteChunk();
+        Pad();
 
-        static Object Unbox(_In_ const Object& src)
+        Details::SnapshotFooter footer { };
+        footer.ColumnCount = static_cast<ULONG>(m_columns.size());
+        footer.ChunkCount = m_chunks.size();
+        footer.StringCount = m_strings.size();
+
+        std::vector<ULONG64> stringOffsets;
+        stringOffsets.reserve(m_strings.size() + 1);
+        stringOffsets.push_back(0);
+        for (auto&& str : m_strings)
         {
-            return src;
+            stringOffsets.push_back(stringOffsets.back() + str.size());
         }
-    };
+        footer.StringDataSize = stringOffsets.back();
 
-    template<> struct BoxObject<const Object&> : public BoxObject<Object> { };
+        ULONG64 footerOffset = m_offset;
+        footer.ColumnsOffset = footerOffset + sizeof(footer);
+        footer.ChunksOffset = footer.ColumnsOffset + sizeof(Details::SnapshotColumnRecord) * m_columns.size();
+        footer.ChunkColumnsOffset = footer.ChunksOffset + sizeof(Details::SnapshotChunkRecord) * m_chunks.size();
+        footer.StringOffsetsOffset = footer.ChunkColumnsOffset + sizeof(Details::SnapshotChunkColumnRecord) * m_chunkColumns.size();
+        footer.StringDataOffset = footer.StringOffsetsOffset + sizeof(ULONG64) * stringOffsets.size();
 
-    template<> struct BoxObject<std::nullptr_t>
-    {
-        static Object Box(_In_ std::nullptr_t)
+        Write(&footer, sizeof(footer));
+        for (size_t i = 0; i < m_columns.size(); ++i)
         {
-            return Object();
+            Details::SnapshotColumnRecord columnRecord { static_cast<ULONG>(m_columns[i].GetType()), m_columnNames[i] };
+            Write(&columnRecord, sizeof(columnRecord));
+        }
+        Write(m_chunks.data(), sizeof(Details::SnapshotChunkRecord) * m_chunks.size());
+        Write(m_chunkColumns.data(), sizeof(Details::SnapshotChunkColumnRecord) * m_chunkColumns.size());
+        Write(stringOffsets.data(), sizeof(ULONG64) * stringOffsets.size());
+        for (auto&& str : m_strings)
+        {
+            Write(str.data(), str.size() * sizeof(wchar_t));
         }
 
-        static std::nullptr_t Unbox(_In_ const Object& src)
+        //
+        // Only now is the header pointed at the footer.  Until this point, the file is recognizably incomplete.
+        //
+        LARGE_INTEGER startOfFile { };
+        if (!SetFilePointerEx(m_file.get(), startOfFile, nullptr, FILE_BEGIN))
         {
-            if (src.GetObject() != nullptr)
-            {
-                throw std::invalid_argument("Only an empty object can unbox to nullptr_t");
-            }
-            return nullptr;
+            Details::ThrowLastError("Unable to write snapshot header");
         }
-    };
 
+        Details::SnapshotFileHeader header { Details::SnapshotMagic, Details::SnapshotVersion, m_rowCount, footerOffset };
+        Write(&header, sizeof(header));
+    }
+
+    // StageValue():
     //
-    // Optional Boxing/Unboxing:
+    // Projects one column of a row into the staged row.
     //
-
-    template<typename T>
-    struct BoxObject<std::optional<T>>
+    void StageValue(_In_ size_t columnIndex, _In_ const Object& rowObject)
     {
-        static Object Box(_In_ const std::optional<T>& src)
+        const SnapshotColumn& column = m_columns[columnIndex];
+        StagedValue& staged = m_stagedRow[columnIndex];
+
+        unsigned char value[sizeof(ULONG64)] = { };
+        size_t valueSize = Details::GetSnapshotValueSize(column.GetType());
+        bool isValid = true;
+
+        try
         {
-            if (src.has_value())
-            {
-                return BoxObject<T>::Box(src.value());
-            }
-            else
+            Object columnValue = column.Project(rowObject);
+            switch(column.GetType())
             {
-                return Object::CreateNoValue();
+                case SnapshotColumnType::Int64:
+                    StoreValue(value, columnValue.As<LONG64>());
+                    break;
+
+                case SnapshotColumnType::UInt64:
+                    StoreValue(value, columnValue.As<ULONG64>());
+                    break;
+
+                case SnapshotColumnType::Double:
+                    StoreValue(value, columnValue.As<double>());
+                    break;
+
+                case SnapshotColumnType::Bool:
+                    StoreValue(value, columnValue.As<bool>());
+                    break;
+
+                case SnapshotColumnType::String:
+                    StoreValue(value, Intern(GetStringValue(columnValue)));
+                    break;
             }
         }
+        catch(const std::bad_alloc&)
+        {
+            throw;
+        }
+        catch(const std::exception&)
+        {
+            memset(value, 0, sizeof(value));
+            isValid = false;
+        }
 
-        static Object Box(_Inout_ std::optional<T>&& src)
+        memcpy(staged.Value, value, sizeof(value));
+        staged.Size = valueSize;
+        staged.IsValid = isValid;
+    }
+
+    // ReserveRoom():
+    //
+    // Ensures that count more bytes can be added to a buffer without reallocating it.  The buffer grows
+    // geometrically.
+    //
+    static void ReserveRoom(_Inout_ std::vector<unsigned char>& buffer, _In_ size_t count)
+    {
+        if (buffer.capacity() - buffer.size() < count)
         {
-            if (src.has_value())
-            {
-                return BoxObject<T>::Box(*std::move(src));
-            }
-            else
-            {
-                return Object::CreateNoValue();
-            }
+            buffer.reserve(buffer.size() + (buffer.size() > count ? buffer.size() : count));
         }
+    }
 
-        static std::optional<T> Unbox(_In_ const Object& src)
+    template<typename T>
+    static void StoreValue(_Out_writes_bytes_(sizeof(T)) unsigned char *pValue, _In_ const T& value)
+    {
+        memcpy(pValue, &value, sizeof(T));
+    }
+
+    static std::wstring GetStringValue(_In_ const Object& value)
+    {
+        if (value.GetKind() == ObjectIntrinsic)
         {
-            ModelObjectKind mk;
-            CheckHr(src->GetKind(&mk));
-            if (mk == ObjectNoValue)
-            {
-                return std::nullopt;
-            }
-            else
+            VARIANT vtVal;
+            if (SUCCEEDED(value->GetIntrinsicValue(&vtVal)))
             {
-                return BoxObject<T>::Unbox(src);
+                if (vtVal.vt == VT_BSTR)
+                {
+                    bstr_ptr spVal(vtVal.bstrVal);
+                    return std::wstring(vtVal.bstrVal, SysStringLen(vtVal.bstrVal));
+                }
+                VariantClear(&vtVal);
             }
         }
-    };
+        return value.ToDisplayString();
+    }
 
-    template<>
-    struct BoxObject<HostContext>
+    // Intern():
+    //
+    // Returns the index of a string within the pool, adding it if this is its first appearance.
+    //
+    ULONG Intern(_In_ std::wstring_view str)
     {
-        static Object Box(_In_ const HostContext& src)
+        auto it = m_stringIndex.find(str);
+        if (it != m_stringIndex.end())
         {
-            Object boxedObject = static_cast<IDebugHostContext *>(src);
-            return boxedObject;
+            return it->second;
         }
 
-        static HostContext Unbox(_In_ const Object& src)
+        if (m_strings.size() == static_cast<ULONG>(-1))
         {
-            return src;
+            throw std::range_error("Too many distinct strings for a snapshot");
         }
-    };
 
+        ULONG index = static_cast<ULONG>(m_strings.size());
+        m_strings.emplace_back(str);
+        m_stringIndex.emplace(std::wstring_view(m_strings.back()), index);
+        return index;
+    }
+
+    // WriteChunk():
     //
-    // Deferred container boxing for generators:
+    // Writes the buffered rows as a chunk.  A chunk which is only partly written leaves the tables out of step with
+    // the file, so any failure abandons the snapshot.
     //
-    template<typename TContainer>
-    struct BoxObject<GeneratedIterable<TContainer>>
+    void WriteChunk()
     {
-        //
-        // We have some move only iterables (e.g.: generators).  Deal with boxing them by moving the container
-        // into the projector and requiring that it live for the lifetime of the iterable (via a linkref)
-        //
-        template<typename TContainer>
-        static Object Box(_In_ const GeneratedIterable<TContainer>& src)
+        ULONG64 chunkRows = m_rowCount - m_chunkFirstRow;
+        if (chunkRows == 0)
         {
-            //
-            // genProjectorFunc holds the functor and calls it to produce the iterable for the
-            // BoundIterable.
-            //
-            std::shared_ptr<Details::SpotLinkReference> spSpotRef = std::make_shared<Details::SpotLinkReference>();
-            std::function<TContainer(void)> acquireFunction = src.GetAcquireFunction();
-
-            Details::DataModelReference linkRef = spSpotRef->GetLinkReference();
+            return;
+        }
 
-            auto genProjectorFunc = [heldSpotRef = std::move(spSpotRef),
-                                     acquireFunction = std::move(acquireFunction)](_In_ const Object& /*emptyObject*/) -> TContainer
+        try
+        {
+            for (auto&& buffer : m_buffers)
             {
-                return acquireFunction();
-            };
+                Details::SnapshotChunkColumnRecord chunkColumn;
+                Pad();
+                chunkColumn.ValuesOffset = m_offset;
+                Write(buffer.Values.data(), buffer.Values.size());
+                Pad();
+                chunkColumn.ValidityOffset = m_offset;
+                Write(buffer.Validity.data(), buffer.Validity.size());
+                m_chunkColumns.push_back(chunkColumn);
+
+                buffer.Values.clear();
+                buffer.Validity.clear();
+            }
 
-            using TItem = decltype(*(std::declval<std::decay_t<TContainer>>().begin()));
-            auto itemProjectorFunc = [](_In_ TItem eref) { return eref; };
+            m_chunks.push_back(Details::SnapshotChunkRecord { m_chunkFirstRow, chunkRows });
+        }
+        catch(...)
+        {
+            m_failed = true;
+            throw;
+        }
 
-            //
-            // Create an empty object which represents this container and place and iterable upon it.
-            // @TODO: It might be better performance to create a data model with this and attach.
-            //
-            Object container = Object::Create(HostContext());
+        m_chunkFirstRow = m_rowCount;
+    }
 
-            using TGenProjector = decltype(genProjectorFunc);
-            using TItemProjector = decltype(itemProjectorFunc);
+    void Pad()
+    {
+        static const unsigned char padding[sizeof(ULONG64)] = { };
+        size_t padSize = static_cast<size_t>((sizeof(ULONG64) - (m_offset % sizeof(ULONG64))) % sizeof(ULONG64));
+        Write(padding, padSize);
+    }
 
-            ComPtr<Details::BoundIterable<Details::EmptyBinding, TGenProjector, TItemProjector>> spIterable;
+    void Write(_In_reads_bytes_(size) const void *pData, _In_ size_t size)
+    {
+        const unsigned char *pBytes = static_cast<const unsigned char *>(pData);
+        size_t remaining = size;
+        while (remaining > 0)
+        {
+            DWORD toWrite = (remaining > 0x40000000 ? 0x40000000 : static_cast<DWORD>(remaining));
+            DWORD written = 0;
+            BOOL succeeded = WriteFile(m_file.get(), pBytes, toWrite, &written, nullptr);
+            m_offset += written;
+            if (!succeeded)
+            {
+                m_failed = true;
+                Details::ThrowLastError("Unable to write snapshot file");
+            }
+            if (written != toWrite)
+            {
+                //
+                // A short write which reports success sets no last error.
+                //
+                m_failed = true;
+                throw hr_exception(HRESULT_FROM_WIN32(ERROR_WRITE_FAULT), "Unable to write snapshot file");
+            }
+            pBytes += written;
+            remaining -= written;
+        }
+    }
+
+    std::vector<SnapshotColumn> m_columns;
+    size_t m_rowsPerChunk;
+    std::vector<ColumnBuffer> m_buffers;
+    std::vector<StagedValue> m_stagedRow;
+    std::vector<ULONG> m_columnNames;
+    std::vector<Details::SnapshotChunkRecord> m_chunks;
+    std::vector<Details::SnapshotChunkColumnRecord> m_chunkColumns;
+    std::deque<std::wstring> m_strings;
+    std::unordered_map<std::wstring_view, ULONG> m_stringIndex;
+    Details::SnapshotHandle m_file;
+    ULONG64 m_offset;
+    ULONG64 m_rowCount;
+    ULONG64 m_chunkFirstRow;
+    bool m_finished;
+    bool m_failed;
+};
 
-            // NOTE:
-            //
-            // The construction of the binding will apply it to the object 'container'.  After
-            // the below line, the iterable concept on 'container' is spIterable.
-            //
-            spIterable = Make<Details::BoundIterable<Details::EmptyBinding, TGenProjector, TItemProjector>>(
-                std::move(linkRef), genProjectorFunc, itemProjectorFunc, container
-                );
+// SnapshotReader:
+//
+// Memory maps a snapshot written by SnapshotWriter and re-projects it into the data model without walking the
+// target again.  The values of an intrinsic column within a chunk can be viewed in place (GetChunkValues) or boxed
+// into an indexable array which reads directly from the mapping (GetColumnArray).  GetColumn() and GetRows() box
+// iterables over every row.  The mapping lives as long as the reader or anything produced from it.
+//
+// The values of invalid entries (see SnapshotWriter) read as zero in typed views and as no value in boxed objects.
+//
+class SnapshotReader
+{
+public:
 
-            return container;
+    explicit SnapshotReader(_In_ const std::wstring& filePath) :
+        m_spState(std::make_shared<State>())
+    {
+        HANDLE hFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            Details::ThrowLastError("Unable to open snapshot file");
         }
-    };
+        Details::SnapshotHandle file(hFile);
 
-#ifdef DBGMODELCLIENTEX_NO_GENERATOR_BOXING
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(hFile, &fileSize))
+        {
+            Details::ThrowLastError("Unable to determine the size of the snapshot file");
+        }
 
-    template<typename TGen>
-    struct IsGenerator : public std::false_type { };
+        CheckFormat(static_cast<ULONG64>(fileSize.QuadPart) >= sizeof(Details::SnapshotFileHeader));
+        if (static_cast<ULONG64>(fileSize.QuadPart) > static_cast<SIZE_T>(-1))
+        {
+            throw std::range_error("The snapshot is too large to map");
+        }
 
-    template<typename TGen>
-    struct IsGenerator<std::experimental::generator<TGen>> : public std::true_type { };
+        HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (hMapping == nullptr)
+        {
+            Details::ThrowLastError("Unable to map snapshot file");
+        }
+        Details::SnapshotHandle mapping(hMapping);
 
-    template<typename TGen> constexpr bool IsGenerator_v = IsGenerator<TGen>::value;
+        void *pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+        if (pView == nullptr)
+        {
+            Details::ThrowLastError("Unable to map snapshot file");
+        }
 
-    template<typename TGen>
-    struct BoxObject<std::experimental::generator<TGen>>
+        //
+        // The view remains valid after the file and mapping handles are closed.
+        //
+        m_spState->View = std::shared_ptr<const void>(pView, [](_In_ const void *pMappedView) { UnmapViewOfFile(pMappedView); });
+        m_spState->pBase = static_cast<const unsigned char *>(pView);
+        m_spState->Size = static_cast<ULONG64>(fileSize.QuadPart);
+        Validate();
+    }
+
+    ULONG64 GetRowCount() const { return m_spState->pHeader->RowCount; }
+    size_t GetColumnCount() const { return m_spState->pFooter->ColumnCount; }
+    size_t GetChunkCount() const { return static_cast<size_t>(m_spState->pFooter->ChunkCount); }
+
+    std::wstring_view GetColumnName(_In_ size_t column) const
+    {
+        CheckColumn(column);
+        return GetString(m_spState->pColumns[column].NameString);
+    }
+
+    SnapshotColumnType GetColumnType(_In_ size_t column) const
+    {
+        CheckColumn(column);
+        return static_cast<SnapshotColumnType>(m_spState->pColumns[column].Type);
+    }
+
+    // FindColumn():
+    //
+    // Returns the index of the named column, if there is one.
+    //
+    std::optional<size_t> FindColumn(_In_ std::wstring_view columnName) const
     {
-        static Object Box(_In_ const std::experimental::generator<TGen>& src)
+        for (size_t i = 0; i < GetColumnCount(); ++i)
         {
-            static_assert(!IsGenerator_v<std::experimental::generator<TGen>>, "Boxing of a std::experimental::generator<T> results in an object which can only ever be iterated once!");
-            return Object();
+            if (GetColumnName(i) == columnName)
+            {
+                return i;
+            }
         }
-    };
+        return std::nullopt;
+    }
 
-#endif // DBGMODELCLIENTEX_NO_GENERATOR_BOXING
+    ULONG64 GetChunkFirstRow(_In_ size_t chunk) const
+    {
+        CheckChunk(chunk);
+        return m_spState->pChunks[chunk].FirstRow;
+    }
 
-} // Boxing
+    ULONG64 GetChunkRowCount(_In_ size_t chunk) const
+    {
+        CheckChunk(chunk);
+        return m_spState->pChunks[chunk].RowCount;
+    }
 
-namespace Details
-{
+    // GetString():
     //
-    // char[] and wchar_t[] will box as strings rather than arrays of characters!
+    // Returns a string from the pool of the snapshot.  The view refers to the mapping.
     //
-    template<size_t N> struct BoxObjectArray<char, N> : public Boxing::BoxObject<const char *> { };
-    template<size_t N> struct BoxObjectArray<const char, N> : public Boxing::BoxObject<const char *> { };
-    template<size_t N> struct BoxObjectArray<wchar_t, N> : public Boxing::BoxObject<const wchar_t *> { };
-    template<size_t N> struct BoxObjectArray<const wchar_t, N> : public Boxing::BoxObject<const wchar_t *> { };
+    std::wstring_view GetString(_In_ ULONG stringIndex) const
+    {
+        const Details::SnapshotFooter *pFooter = m_spState->pFooter;
+        if (stringIndex >= pFooter->StringCount)
+        {
+            throw std::range_error("String index is out of range");
+        }
 
-    // BoxSelector:
+        ULONG64 start = m_spState->pStringOffsets[stringIndex];
+        ULONG64 end = m_spState->pStringOffsets[stringIndex + 1];
+        CheckFormat(start <= end && end <= pFooter->StringDataSize);
+        return std::wstring_view(m_spState->pStringData + start, static_cast<size_t>(end - start));
+    }
+
+    // GetChunkValues():
     //
-    // Class which redirects array types to BoxObjectArray if T is an array and to BoxObject<std::decay_t<T>> for non
-    // array types.
+    // Returns a view, in place within the mapping, of the values of a column within a chunk.  T must be the storage
+    // type of the column: LONG64, ULONG64, double, bool, or ULONG (string indices).
     //
-    template<typename T> struct BoxSelector :
-        public std::conditional_t<std::is_array_v<T>,
-                                  typename Details::BoxObjectArray<Details::ArrayTraits_t<T>, Details::ArrayTraits<T>::Size>,
-                                  Boxing::BoxObject<std::decay_t<T>>>
+    template<typename T>
+    SharedArrayView<T> GetChunkValues(_In_ size_t chunk, _In_ size_t column) const
     {
-    };
-} // Boxing
+        if (GetColumnType(column) != Details::SnapshotStorage<T>::ColumnType)
+        {
+            throw std::invalid_argument("Requested type does not match the storage type of the column");
+        }
 
-//*************************************************
-// Direct Boxing and Unboxing Method Calls:
-//
+        const Details::SnapshotChunkColumnRecord& chunkColumn = GetChunkColumn(chunk, column);
+        const T *pValues = reinterpret_cast<const T *>(m_spState->pBase + chunkColumn.ValuesOffset);
+        return SharedArrayView<T>(pValues, static_cast<size_t>(GetChunkRowCount(chunk)), m_spState->View);
+    }
 
-// BoxObject():
-//
-// Takes any object and packs it into a data model object, returning an Object instance.
-//
-// New types can be added to the boxer by adding an explicit template specialization.
-//
-template<typename T>
-Object BoxObject(T&& obj)
-{
+    // GetChunkValidity():
     //
-    // template<typename T> ... T&& can bind T to TX& or TX.  We want the base type.
-    // We do *NOT* want to std::decay_t<T> to get the base because we want to preserve any
-    // array types.  Instead, we effectively want std::remove_cvref_t.  Unfortunately, that
-    // is C++20 and this is a C++17 lib.  Go the verbose route.
+    // Returns a view of the validity of the values of a column within a chunk.  Each entry is zero if the value could
+    // not be produced when the snapshot was written.
     //
-    using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
+    SharedArrayView<unsigned char> GetChunkValidity(_In_ size_t chunk, _In_ size_t column) const
+    {
+        const Details::SnapshotChunkColumnRecord& chunkColumn = GetChunkColumn(chunk, column);
+        return SharedArrayView<unsigned char>(m_spState->pBase + chunkColumn.ValidityOffset,
+                                              static_cast<size_t>(GetChunkRowCount(chunk)),
+                                              m_spState->View);
+    }
 
+    // GetValue():
     //
-    // We do not want to decay arrays in order to box them.  Delegate to a box selector which will specially
-    // handle array types.
+    // Returns the boxed value of a column in a row, or no value if the entry is invalid.
     //
-    using TBox = Details::BoxSelector<TBase>;
-    using TFwd = decltype(std::forward<T>(obj));
-    static_assert(Details::has_box_method_v<TBox, TFwd>, "No BoxObject<T>::Box exists for the given type.  Unable to box.");
-
-    return TBox::Box(std::forward<T>(obj));
-}
-
-// UnboxObject():
-//
-// Takes a data model Object instance and unboxes it into a value of the type T.
-//
-// New types can be added to the unboxer by adding an explicit template specialization.
-//
-template<typename T>
-decltype(auto) UnboxObject(_In_ const Object& src)
-{
-    using TBox = Boxing::BoxObject<T>;
-    static_assert(Details::has_unbox_method_v<TBox>, "No BoxObject<T>::Unbox exists for the given type.  Unable to unbox.");
+    Object GetValue(_In_ ULONG64 row, _In_ size_t column) const
+    {
+        size_t chunk = FindChunk(row);
+        ULONG64 rowInChunk = row - m_spState->pChunks[chunk].FirstRow;
+        const Details::SnapshotChunkColumnRecord& chunkColumn = GetChunkColumn(chunk, column);
+        if (m_spState->pBase[chunkColumn.ValidityOffset + rowInChunk] == 0)
+        {
+            return Object::CreateNoValue();
+        }
 
-    return TBox::Unbox(src);
-};
+        SnapshotColumnType type = GetColumnType(column);
+        const unsigned char *pValue = m_spState->pBase + chunkColumn.ValuesOffset + rowInChunk * Details::GetSnapshotValueSize(type);
+        switch(type)
+        {
+            case SnapshotColumnType::Int64:
+                return BoxObject(LoadValue<LONG64>(pValue));
 
-//**************************************************************************
-// Forward Implementations:
-//
+            case SnapshotColumnType::UInt64:
+                return BoxObject(LoadValue<ULONG64>(pValue));
 
-inline Type Symbol::Type() const
-{
-    ComPtr<IDebugHostType> spType;
-    CheckHr(m_spSymbol->GetType(&spType));
-    return ClientEx::Type(std::move(spType));
-}
+            case SnapshotColumnType::Double:
+                return BoxObject(LoadValue<double>(pValue));
 
-inline Module Symbol::ContainingModule() const
-{
-    ComPtr<IDebugHostModule> spModule;
-    CheckHr(m_spSymbol->GetContainingModule(&spModule));
-    return Module(std::move(spModule));
-}
+            case SnapshotColumnType::Bool:
+                return BoxObject(LoadValue<bool>(pValue));
 
-//**************************************************************************
-// Template Function Implementations:
-//
+            case SnapshotColumnType::String:
+            {
+                std::wstring_view str = GetString(LoadValue<ULONG>(pValue));
+                bstr_ptr spStr(SysAllocStringLen(str.data(), static_cast<UINT>(str.size())));
+                if (spStr == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+                return Boxing::BoxObject<const wchar_t *>::BoxBstr(std::move(spStr));
+            }
+        }
 
-template<typename TStr>
-Type Module::FindType(_In_ TStr&& typeName) const
-{
-    ComPtr<IDebugHostType> spType;
-    CheckHr(AsModule()->FindTypeByName(ClientEx::Details::ExtractString(typeName), &spType));
-    return ClientEx::Type(std::move(spType));
-}
+        throw std::invalid_argument("Unrecognized snapshot column type");
+    }
 
-inline Object Constant::Value() const
-{
-    VARIANT vtValue;
-    CheckHr(AsConstant()->GetValue(&vtValue));
-    ComPtr<IModelObject> spObj;
-    HRESULT hr = GetManager()->CreateIntrinsicObject(ObjectIntrinsic, &vtValue, &spObj);
-    VariantClear(&vtValue);
-    CheckHr(hr);
-    return Object(std::move(spObj));
-}
+    // GetColumnArray():
+    //
+    // Boxes the values of an intrinsic column within a chunk into an iterable and indexable array which reads
+    // directly from the mapping.
+    //
+    Object GetColumnArray(_In_ size_t chunk, _In_ size_t column) const
+    {
+        switch(GetColumnType(column))
+        {
+            case SnapshotColumnType::Int64:
+                return BoxObject(GetChunkValues<LONG64>(chunk, column));
 
-inline Object Field::GetValue() const
-{
-    VARIANT vtValue;
-    CheckHr(AsField()->GetValue(&vtValue));
-    ComPtr<IModelObject> spObj;
-    HRESULT hr = GetManager()->CreateIntrinsicObject(ObjectIntrinsic, &vtValue, &spObj);
-    VariantClear(&vtValue);
-    CheckHr(hr);
-    return Object(std::move(spObj));
-}
+            case SnapshotColumnType::UInt64:
+                return BoxObject(GetChunkValues<ULONG64>(chunk, column));
 
-inline Object Metadata::KeyValue(_In_z_ const wchar_t *keyName) const
-{
-    ComPtr<IModelObject> spValue;
-    CheckHr(m_spKeyStore->GetKeyValue(keyName, &spValue, nullptr));
-    Object value = std::move(spValue);
-    return value;
-}
+            case SnapshotColumnType::Double:
+                return BoxObject(GetChunkValues<double>(chunk, column));
 
-template<typename TArg, typename TEnable>
-Object::Object(TArg&& value)
-{
-    Object assignment = BoxObject(std::forward<TArg>(value));
-    m_spObject.Attach(assignment.Steal());
-}
+            case SnapshotColumnType::Bool:
+                return BoxObject(GetChunkValues<bool>(chunk, column));
 
-template<typename TArg, typename TEnable>
-Object& Object::operator=(TArg&& assignmentValue)
-{
-    Object assignment = BoxObject(std::forward<TArg>(assignmentValue));
-    m_spObject.Attach(assignment.Steal());
-    return *this;
-}
+            default:
+                throw std::invalid_argument("Only intrinsic columns can be boxed as arrays.  Use GetColumn()");
+        }
+    }
 
-template<typename TType>
-TType Object::As() const
-{
-    return UnboxObject<TType>(m_spObject.Get());
-}
+    // GetColumn():
+    //
+    // Boxes an iterable over the values of a column in every row.
+    //
+    Object GetColumn(_In_ size_t column) const
+    {
+        CheckColumn(column);
+        SnapshotReader reader = *this;
+        ULONG64 rowCount = GetRowCount();
+        return BoxObject(GeneratedIterable<Details::SnapshotRowRange>([reader, rowCount, column]()
+        {
+            return Details::SnapshotRowRange(rowCount, [reader, column](_In_ ULONG64 row)
+            {
+                return reader.GetValue(row, column);
+            });
+        }));
+    }
 
-template<typename... TArgs>
-Object Object::Call(_In_ const Object& instance, TArgs&&... callArguments) const
-{
-    Details::ParameterPack pack = Details::PackValues(std::forward<TArgs>(callArguments)...);
+    // GetRows():
+    //
+    // Boxes an iterable over every row.  Each row is an object with a key for each column.
+    //
+    Object GetRows() const
+    {
+        std::vector<std::wstring> columnNames;
+        for (size_t i = 0; i < GetColumnCount(); ++i)
+        {
+            columnNames.push_back(std::wstring(GetColumnName(i)));
+        }
 
-    ComPtr<IModelObject> spObject;
-    HRESULT hr = As<IModelMethod *>()->Call(instance, sizeof...(callArguments), reinterpret_cast<IModelObject **>(pack.get()), &spObject, nullptr);
-    CheckHr(hr, spObject);
+        SnapshotReader reader = *this;
+        ULONG64 rowCount = GetRowCount();
+        auto spColumnNames = std::make_shared<const std::vector<std::wstring>>(std::move(columnNames));
+        return BoxObject(GeneratedIterable<Details::SnapshotRowRange>([reader, rowCount, spColumnNames]()
+        {
+            return Details::SnapshotRowRange(rowCount, [reader, spColumnNames](_In_ ULONG64 row)
+            {
+                Object rowObject = Object::Create(HostContext());
+                for (size_t i = 0; i < spColumnNames->size(); ++i)
+                {
+                    Object columnValue = reader.GetValue(row, i);
+                    CheckHr(rowObject->SetKey((*spColumnNames)[i].c_str(), columnValue, nullptr));
+                }
+                return rowObject;
+            });
+        }));
+    }
 
-    Object result(std::move(spObject));
-    return result;
-}
+private:
 
-template<typename... TArgs>
-Details::IndexableReference<Object, Details::ParameterPack> Object::Index(TArgs&&... indexers) const
-{
-    Details::ParameterPack pack = Details::PackValues(std::forward<TArgs>(indexers)...);
+    struct State
+    {
+        std::shared_ptr<const void> View;
+        const unsigned char *pBase;
+        ULONG64 Size;
+        const Details::SnapshotFileHeader *pHeader;
+        const Details::SnapshotFooter *pFooter;
+        const Details::SnapshotColumnRecord *pColumns;
+        const Details::SnapshotChunkRecord *pChunks;
+        const Details::SnapshotChunkColumnRecord *pChunkColumns;
+        const ULONG64 *pStringOffsets;
+        const wchar_t *pStringData;
+    };
 
-    ComPtr<IIndexableConcept> spIndexable;
-    HRESULT hr = m_spObject->GetConcept(__uuidof(IIndexableConcept), &spIndexable, nullptr);
-    if (FAILED(hr))
+    static void CheckFormat(_In_ bool condition)
     {
-        ClientEx::Type objectType = Type();
-
-        //
-        // If the type is a pointer and the pack size is one and it's a standard pointer (not a C++ reference or other
-        // pseudo-pointer), we can still deal with this as "indexable" through plain old pointer math.
-        //
-        // Create an adapter object that makes it look like any other indexable object to the underlying IndexableReference<>
-        //
-#pragma warning(push)
-#pragma warning(disable: 4127)
-        if (sizeof...(indexers) == 1 && objectType.GetKind() == TypePointer && objectType.GetPointerKind() == PointerStandard)
+        if (!condition)
         {
-            spIndexable = Make<Details::PointerIndexerAdapter>();
-            hr = S_OK;
+            throw std::invalid_argument("The file is not a complete snapshot");
         }
-#pragma warning(pop)
     }
-    CheckHr(hr);
-
-    return Details::IndexableReference<Object, Details::ParameterPack>(sizeof...(indexers), std::move(pack), std::move(spIndexable), GetObject());
-}
-
-template<typename TArg>
-int Object::CompareTo(TArg&& other) const
-{
-    Object otherObj = BoxObject(other);
-    ComPtr<IModelObject> spResult;
-    CheckHr(m_spObject->Compare(otherObj, &spResult));
-    Object resultObj = std::move(spResult);
-    return (int)resultObj;
-}
-
-template<typename TArg>
-bool Object::IsEqualTo(TArg&& other) const
-{
-    Object otherObj = BoxObject(other);
-    if (GetObject() == otherObj.GetObject()) { return true; }
-    if (GetObject() == nullptr || otherObj.GetObject() == nullptr) { return false; }
-    bool isEqual;
-    CheckHr(m_spObject->IsEqualTo(otherObj, &isEqual));
-    return isEqual;
-}
-
-template<typename... TArgs, typename TEnable>
-Metadata::Metadata(_In_ TArgs&&... initializers)
-{
-    SetKeys(std::forward<TArgs>(initializers)...);
-}
 
-template<typename... TArgs, typename TEnable>
-void Metadata::SetKeys(_In_ TArgs&&... initializers)
-{
-    EnsureCreated();
-    Details::KeyFiller<IKeyStore, TArgs...>::Fill(m_spKeyStore.Get(), std::forward<TArgs>(initializers)...);
-}
+    // CheckTable():
+    //
+    // Verifies that count records of recordSize bytes at offset lie within the file and returns them.
+    //
+    const unsigned char *CheckTable(_In_ ULONG64 offset, _In_ ULONG64 count, _In_ ULONG64 recordSize) const
+    {
+        ULONG64 fileSize = m_spState->Size;
+        CheckFormat(offset <= fileSize && offset % sizeof(ULONG64) == 0);
+        CheckFormat(count <= (fileSize - offset) / recordSize);
+        return m_spState->pBase + offset;
+    }
 
-inline Deconstruction Object::Deconstruct()
-{
-    ComPtr<IDeconstructableConcept> spDeconstructable;
-    CheckHr(m_spObject->GetConcept(__uuidof(IDeconstructableConcept), &spDeconstructable, nullptr));
+    void Validate()
+    {
+        State& state = *m_spState;
+        state.pHeader = reinterpret_cast<const Details::SnapshotFileHeader *>(state.pBase);
+        CheckFormat(state.pHeader->Magic == Details::SnapshotMagic &&
+                    state.pHeader->Version == Details::SnapshotVersion &&
+                    state.pHeader->FooterOffset != 0);
 
-    ULONG64 argCount;
-    CheckHr(spDeconstructable->GetConstructorArgumentCount(m_spObject.Get(), &argCount));
+        const Details::SnapshotFooter *pFooter = reinterpret_cast<const Details::SnapshotFooter *>(
+            CheckTable(state.pHeader->FooterOffset, 1, sizeof(Details::SnapshotFooter)));
+        state.pFooter = pFooter;
 
-    BSTR ctorName;
-    CheckHr(spDeconstructable->GetConstructableModelName(m_spObject.Get(), &ctorName));
-    bstr_ptr spCtorName(ctorName);
+        CheckFormat(pFooter->ChunkCount <= static_cast<ULONG64>(-1) / (pFooter->ColumnCount == 0 ? 1 : pFooter->ColumnCount));
+        CheckFormat(pFooter->StringCount < static_cast<ULONG64>(-1));
 
-    std::unique_ptr<Object[]> spArgs(new Object[static_cast<size_t>(argCount)]);
-    CheckHr(spDeconstructable->GetConstructorArguments(m_spObject.Get(), argCount, reinterpret_cast<IModelObject **>(spArgs.get())));
+        state.pColumns = reinterpret_cast<const Details::SnapshotColumnRecord *>(
+            CheckTable(pFooter->ColumnsOffset, pFooter->ColumnCount, sizeof(Details::SnapshotColumnRecord)));
+        state.pChunks = reinterpret_cast<const Details::SnapshotChunkRecord *>(
+            CheckTable(pFooter->ChunksOffset, pFooter->ChunkCount, sizeof(Details::SnapshotChunkRecord)));
+        state.pChunkColumns = reinterpret_cast<const Details::SnapshotChunkColumnRecord *>(
+            CheckTable(pFooter->ChunkColumnsOffset, pFooter->ChunkCount * pFooter->ColumnCount, sizeof(Details::SnapshotChunkColumnRecord)));
+        state.pStringOffsets = reinterpret_cast<const ULONG64 *>(
+            CheckTable(pFooter->StringOffsetsOffset, pFooter->StringCount + 1, sizeof(ULONG64)));
+        state.pStringData = reinterpret_cast<const wchar_t *>(
+            CheckTable(pFooter->StringDataOffset, pFooter->StringDataSize, sizeof(wchar_t)));
 
-    return Deconstruction(ctorName, argCount, reinterpret_cast<IModelObject **>(spArgs.get()));
-}
+        for (ULONG i = 0; i < pFooter->ColumnCount; ++i)
+        {
+            Details::GetSnapshotValueSize(static_cast<SnapshotColumnType>(state.pColumns[i].Type));
+            CheckFormat(state.pColumns[i].NameString < pFooter->StringCount);
+        }
 
-inline Object Object::ConstructInstance(Deconstruction& deconstruction)
-{
-    ComPtr<IConstructableConcept> spConstructable;
-    CheckHr(m_spObject->GetConcept(__uuidof(IConstructableConcept), &spConstructable, nullptr));
+        //
+        // Chunks must cover the rows contiguously and each column of each chunk must lie within the file.
+        //
+        ULONG64 nextRow = 0;
+        for (ULONG64 chunk = 0; chunk < pFooter->ChunkCount; ++chunk)
+        {
+            const Details::SnapshotChunkRecord& chunkRecord = state.pChunks[chunk];
+            CheckFormat(chunkRecord.FirstRow == nextRow && chunkRecord.RowCount > 0);
+            nextRow += chunkRecord.RowCount;
+            CheckFormat(nextRow >= chunkRecord.FirstRow);
+
+            for (ULONG column = 0; column < pFooter->ColumnCount; ++column)
+            {
+                const Details::SnapshotChunkColumnRecord& chunkColumn = state.pChunkColumns[chunk * pFooter->ColumnCount + column];
+                SnapshotColumnType columnType = static_cast<SnapshotColumnType>(state.pColumns[column].Type);
+                ULONG64 valueSize = Details::GetSnapshotValueSize(columnType);
+                const unsigned char *pValues = CheckTable(chunkColumn.ValuesOffset, chunkRecord.RowCount, valueSize);
+                CheckTable(chunkColumn.ValidityOffset, chunkRecord.RowCount, 1);
 
-    const size_t size = static_cast<size_t>(std::distance(deconstruction.begin(), deconstruction.end()));
+                //
+                // Bool values are viewed in place as bool.  Any byte other than zero or one is not a valid bool.
+                //
+                if (columnType == SnapshotColumnType::Bool)
+                {
+                    for (ULONG64 row = 0; row < chunkRecord.RowCount; ++row)
+                    {
+                        CheckFormat(pValues[row] <= 1);
+                    }
+                }
+            }
+        }
+        CheckFormat(nextRow == state.pHeader->RowCount);
+    }
 
-    Details::ParameterPack pack(new Object[size]);
-    size_t i = 0;
-    for (auto&& param : deconstruction)
+    void CheckColumn(_In_ size_t column) const
     {
-        pack[i++] = param;
+        if (column >= GetColumnCount())
+        {
+            throw std::range_error("Column index is out of range");
+        }
     }
 
-    ComPtr<IModelObject> spInstance;
-    CheckHr(spConstructable->CreateInstance(size, reinterpret_cast<IModelObject **>(pack.get()), &spInstance));
-    return Object(std::move(spInstance));
-}
+    void CheckChunk(_In_ size_t chunk) const
+    {
+        if (chunk >= GetChunkCount())
+        {
+            throw std::range_error("Chunk index is out of range");
+        }
+    }
 
-namespace Details
-{
-    template<typename TTuple, size_t i, size_t remaining>
-    void RegularUnpacker<TTuple, i, remaining>::UnpackInto(_In_ size_t packSize,
-                                                           _In_reads_(packSize) IModelObject **ppArgumentPack,
-                                                           TTuple& tuple)
+    const Details::SnapshotChunkColumnRecord& GetChunkColumn(_In_ size_t chunk, _In_ size_t column) const
     {
-        using ArgType = std::tuple_element_t<i, TTuple>;
+        CheckChunk(chunk);
+        CheckColumn(column);
+        return m_spState->pChunkColumns[chunk * GetColumnCount() + column];
+    }
 
-        // As we have already checked the pack size matches the minimum static argument set before
-        // reaching this point, a 0 packSize is a non-supplied argument in the dynamic pack
-        // matching against a std::optional<TOpt> in the argument pack.
-        //
-        // The tuple will have default constructed the std::optional<TOpt>.  Simply not touching
-        // that value will leave it as no value (std::nullopt).  This is exactly the behavior
-        // that we want.
-        //
-        if (i < packSize)
+    // FindChunk():
+    //
+    // Returns the chunk which holds a row.
+    //
+    size_t FindChunk(_In_ ULONG64 row) const
+    {
+        if (row >= GetRowCount())
         {
-            Object obj = ppArgumentPack[i];
-            std::get<i>(tuple) = UnboxObject<ArgType>(obj);
+            throw std::range_error("Row index is out of range");
         }
 
-        Unpacker<TTuple, i + 1, remaining - 1>::UnpackInto(packSize, ppArgumentPack, tuple);
+        const Details::SnapshotChunkRecord *pChunksBegin = m_spState->pChunks;
+        const Details::SnapshotChunkRecord *pChunksEnd = pChunksBegin + GetChunkCount();
+        auto it = std::upper_bound(pChunksBegin, pChunksEnd, row, [](_In_ ULONG64 value, _In_ const Details::SnapshotChunkRecord& chunkRecord)
+        {
+            return value < chunkRecord.FirstRow;
+        });
+        return static_cast<size_t>((it - pChunksBegin) - 1);
     }
-}
+
+    template<typename T>
+    static T LoadValue(_In_reads_bytes_(sizeof(T)) const unsigned char *pValue)
+    {
+        T value;
+        memcpy(&value, pValue, sizeof(T));
+        return value;
+    }
+
+    std::shared_ptr<State> m_spState;
+};
 
 } // ClientEx
 
@@ -8422,9 +17020,10 @@ public:
             throw ClientEx::unexpected_error();
         }
 
+        ClientEx::NamedModelCache& cache = ClientEx::NamedModelCache::Instance();
         ComPtr<IModelObject> spParent;
-        ClientEx::CheckHr(ClientEx::GetManager()->AcquireNamedModel(m_parentModelName.c_str(), &spParent));
-        ClientEx::CheckHr(spParent->AddParentModel(model, nullptr, false));
+        ClientEx::CheckHr(cache.AcquireNamedModel(m_parentModelName.c_str(), &spParent));
+        ClientEx::CheckHr(cache.AttachParentModel(spParent.Get(), model));
     }
 
     void Unapply(_In_ const ClientEx::Object& model)
@@ -8435,9 +17034,10 @@ public:
             return;
         }
 
+        ClientEx::NamedModelCache& cache = ClientEx::NamedModelCache::Instance();
         ComPtr<IModelObject> spParent;
-        ClientEx::AssertHr(ClientEx::GetManager()->AcquireNamedModel(m_parentModelName.c_str(), &spParent));
-        ClientEx::AssertHr(spParent->RemoveParentModel(model));
+        ClientEx::AssertHr(cache.AcquireNamedModel(m_parentModelName.c_str(), &spParent));
+        ClientEx::AssertHr(cache.DetachParentModel(spParent.Get(), model));
     }
 
 private:
@@ -8477,6 +17077,7 @@ public:
         }
 
         ClientEx::CheckHr(ClientEx::GetManager()->RegisterNamedModel(m_modelName.c_str(), model));
+        ClientEx::NamedModelCache::Instance().Update(m_modelName.c_str(), model);
     }
 
     void Unapply(_In_ const ClientEx::Object& model)
@@ -8488,6 +17089,7 @@ public:
         }
 
         ClientEx::AssertHr(ClientEx::GetManager()->UnregisterNamedModel(m_modelName.c_str()));
+        ClientEx::NamedModelCache::Instance().Invalidate(m_modelName.c_str());
     }
 
 #pragma warning(pop)
@@ -8576,7 +17178,10 @@ public:
                                                           m_propertyName.c_str(),
                                                           m_metadata,
                                                           &spNamespace));
-        ClientEx::CheckHr(spNamespace->AddParentModel(model, nullptr, false));
+
+        ClientEx::NamedModelCache& cache = ClientEx::NamedModelCache::Instance();
+        cache.Update(m_namespaceName.c_str(), spNamespace.Get());
+        ClientEx::CheckHr(cache.AttachParentModel(spNamespace.Get(), model));
     }
 
     void Unapply(_In_ const ClientEx::Object& model)
@@ -8587,9 +17192,10 @@ public:
             return;
         }
 
+        ClientEx::NamedModelCache& cache = ClientEx::NamedModelCache::Instance();
         ComPtr<IModelObject> spNamespace;
-        ClientEx::AssertHr(ClientEx::GetManager()->AcquireNamedModel(m_namespaceName.c_str(), &spNamespace));
-        ClientEx::AssertHr(spNamespace->RemoveParentModel(model));
+        ClientEx::AssertHr(cache.AcquireNamedModel(m_namespaceName.c_str(), &spNamespace));
+        ClientEx::AssertHr(cache.DetachParentModel(spNamespace.Get(), model));
     }
 
 private:
@@ -8714,465 +17320,948 @@ public:
                                                                   filter.Get(),
                                                                   &spNamespace,
                                                                   &m_spToken));
-        ClientEx::CheckHr(spNamespace->AddParentModel(model, nullptr, false));
+
+        ClientEx::NamedModelCache& cache = ClientEx::NamedModelCache::Instance();
+        cache.Update(m_namespaceName.c_str(), spNamespace.Get());
+        ClientEx::CheckHr(cache.AttachParentModel(spNamespace.Get(), model));
     }
 
     void Unapply(_In_ const ClientEx::Object& model)
     {
-        if (m_modelName.empty() || m_namespaceName.empty() || m_propertyName.empty())
+        if (m_modelName.empty() || m_namespaceName.empty() || m_propertyName.empty())
+        {
+            ClientEx::AssertCondition(false);
+            return;
+        }
+
+        ClientEx::NamedModelCache& cache = ClientEx::NamedModelCache::Instance();
+        ComPtr<IModelObject> spNamespace;
+        ClientEx::AssertHr(cache.AcquireNamedModel(m_namespaceName.c_str(), &spNamespace));
+        ClientEx::AssertHr(cache.DetachParentModel(spNamespace.Get(), model));
+        if (m_spToken.Get() != nullptr)
+        {
+            ClientEx::AssertHr(m_spToken->RemoveFilter());
+        }
+    }
+
+private:
+
+    std::wstring m_modelName;
+    std::wstring m_namespaceName;
+    std::wstring m_propertyName;
+    std::function< ClientEx::Object(void)> m_createFilter;
+    ComPtr<IFilteredNamespacePropertyToken> m_spToken;
+};
+
+namespace Details
+{
+    //*************************************************
+    // Instance Data Storage Helpers:
+    //
+
+    // 0x21d50b4e, 0x5ed1, 0x4357, 0x9d, 0x3b, 0x25, 0x3b, 0xd8, 0xc4, 0x5e, 0xe7);
+    struct DECLSPEC_UUID("21D50B4E-5ED1-4357-9D3B-253BD8C45EE7") IPrivateTypeQuery : public IUnknown
+    {
+        IFACEMETHOD_(ULONG64, GetTypeHash)() PURE;
+    };
+
+    template<typename TInstance>
+    struct StorageInterface :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IPrivateTypeQuery
+            >
+    {
+        using InstanceData = TInstance;
+
+        virtual TInstance& GetInstance() = 0;
+    };
+
+    template<typename TInstance>
+    struct BasicStorage : ClientEx::Details::PooledObject<BasicStorage<TInstance>, StorageInterface<TInstance>>
+    {
+    public:
+        using InstanceData = TInstance;
+        using StorageData = TInstance;
+
+        BasicStorage(_In_ const TInstance& instance, _In_ ULONG64 typeHash) :
+            m_instance(instance),
+            m_typeHash(typeHash)
+        {
+        }
+
+        BasicStorage(_In_ TInstance&& instance, _In_ ULONG64 typeHash) :
+            m_instance(std::move(instance)),
+            m_typeHash(typeHash)
+        {
+        }
+
+        TInstance& GetInstance() override
+        {
+            return m_instance;
+        }
+
+        //*************************************************
+        // IPrivateTypeQuery:
+        //
+
+        IFACEMETHOD_(ULONG64, GetTypeHash)()
+        {
+            return m_typeHash;
+        }
+
+    private:
+
+        TInstance m_instance;
+        ULONG64 m_typeHash;
+    };
+
+    template<typename TInstance>
+    struct SharedStorage : ClientEx::Details::PooledObject<SharedStorage<TInstance>, StorageInterface<TInstance>>
+    {
+    public:
+        using InstanceData = TInstance;
+        using StorageData = std::shared_ptr<TInstance>;
+
+        SharedStorage(_In_ std::shared_ptr<TInstance> sharedInstance, _In_ ULONG64 typeHash) :
+            m_spSharedInstance(std::move(sharedInstance)),
+            m_typeHash(typeHash)
+        {
+        }
+
+        TInstance& GetInstance()
+        {
+            return *(m_spSharedInstance.get());
+        }
+
+        //*************************************************
+        // IPrivateTypeQuery:
+        //
+
+        IFACEMETHOD_(ULONG64, GetTypeHash)()
+        {
+            return m_typeHash;
+        }
+
+    private:
+
+        std::shared_ptr<TInstance> m_spSharedInstance;
+        ULONG64 m_typeHash;
+    };
+
+    template<typename TInstance>
+    struct UniqueStorage : ClientEx::Details::PooledObject<UniqueStorage<TInstance>, StorageInterface<TInstance>>
+    {
+    public:
+        using InstanceData = TInstance;
+        using StorageData = std::unique_ptr<TInstance>;
+
+        UniqueStorage(_In_ std::unique_ptr<TInstance> uniqueInstance, _In_ ULONG64 typeHash) :
+            m_spUniqueInstance(std::move(uniqueInstance)),
+            m_typeHash(typeHash)
+        {
+        }
+
+        TInstance& GetInstance()
+        {
+            return *(m_spUniqueInstance.get());
+        }
+
+        //*************************************************
+        // IPrivateTypeQuery:
+        //
+
+        IFACEMETHOD_(ULONG64, GetTypeHash)()
+        {
+            return m_typeHash;
+        }
+
+    private:
+
+        std::unique_ptr<TInstance> m_spUniqueInstance;
+        ULONG64 m_typeHash;
+    };
+
+    template<typename TInstance>
+    struct StorageTraits
+    {
+        using StorageType = typename BasicStorage<TInstance>;
+        using InstanceData = TInstance;
+    };
+
+    template<typename TInstance>
+    struct StorageTraits<std::shared_ptr<TInstance>>
+    {
+        using StorageType = typename SharedStorage<TInstance>;
+        using InstanceData = TInstance;
+    };
+
+    template<typename TInstance>
+    struct StorageTraits<std::unique_ptr<TInstance>>
+    {
+        using StorageType = typename UniqueStorage<TInstance>;
+        using InstanceData = TInstance;
+    };
+
+    //*************************************************
+    // Data Models:
+    //
+
+    // DataModelConcept:
+    //
+    // An implementation of the data model concept.
+    //
+    template<typename TClass>
+    class DataModelConcept :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IDataModelConcept
+            >
+    {
+    public:
+
+        typedef const std::wstring& (TClass::*NameMethod)() const;
+
+        DataModelConcept(_In_ TClass *pClass, _In_ NameMethod nameMethod) : m_pClass(pClass), m_nameMethod(nameMethod) { }
+
+        //*************************************************
+        // IDataModelConcept:
+        //
+
+        IFACEMETHOD(InitializeObject)(_In_ IModelObject * /*pModelObject*/,
+                                      _In_opt_ IDebugHostTypeSignature * /*pMatchingTypeSignature*/,
+                                      _In_opt_ IDebugHostSymbolEnumerator * /*pWildcardMatches*/)
         {
-            ClientEx::AssertCondition(false);
-            return;
+            return S_OK;
         }
 
-        ComPtr<IModelObject> spNamespace;
-        ClientEx::AssertHr(ClientEx::GetManager()->AcquireNamedModel(m_namespaceName.c_str(), &spNamespace));
-        ClientEx::AssertHr(spNamespace->RemoveParentModel(model));
-        if (m_spToken.Get() != nullptr)
+        IFACEMETHOD(GetName)(_Out_ BSTR *pModelName)
         {
-            ClientEx::AssertHr(m_spToken->RemoveFilter());
+            *pModelName = nullptr;
+
+            const std::wstring& modelName = (m_pClass->*m_nameMethod)();
+            if (modelName.empty())
+            {
+                return E_NOTIMPL;
+            }
+
+            *pModelName = SysAllocString(modelName.c_str());
+            if (*pModelName == nullptr)
+            {
+                return E_OUTOFMEMORY;
+            }
+
+            return S_OK;
         }
-    }
 
-private:
+    private:
 
-    std::wstring m_modelName;
-    std::wstring m_namespaceName;
-    std::wstring m_propertyName;
-    std::function< ClientEx::Object(void)> m_createFilter;
-    ComPtr<IFilteredNamespacePropertyToken> m_spToken;
-};
+        TClass *m_pClass;
+        NameMethod m_nameMethod;
 
-namespace Details
-{
-    //*************************************************
-    // Instance Data Storage Helpers:
-    //
 
-    // 0x21d50b4e, 0x5ed1, 0x4357, 0x9d, 0x3b, 0x25, 0x3b, 0xd8, 0xc4, 0x5e, 0xe7);
-    struct DECLSPEC_UUID("21D50B4E-5ED1-4357-9D3B-253BD8C45EE7") IPrivateTypeQuery : public IUnknown
-    {
-        IFACEMETHOD_(ULONG64, GetTypeHash)() PURE;
     };
 
-    template<typename TInstance>
-    struct StorageInterface :
+    template<typename TClass, typename TStringProjector>
+    class BoundStringDisplayable :
         public Microsoft::WRL::RuntimeClass<
             Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IPrivateTypeQuery
+            IStringDisplayableConcept
             >
-    {
-        using InstanceData = TInstance;
-
-        virtual TInstance& GetInstance() = 0;
-    };
-
-    template<typename TInstance>
-    struct BasicStorage : StorageInterface<TInstance>
     {
     public:
-        using InstanceData = TInstance;
-        using StorageData = TInstance;
-
-        BasicStorage(_In_ const TInstance& instance, _In_ ULONG64 typeHash) :
-            m_instance(instance),
-            m_typeHash(typeHash)
-        {
-        }
 
-        BasicStorage(_In_ TInstance&& instance, _In_ ULONG64 typeHash) :
-            m_instance(std::move(instance)),
-            m_typeHash(typeHash)
-        {
-        }
+        using StringProjectorFunction = typename ClientEx::Details::FunctorTraits<TStringProjector>::FunctionType;
 
-        TInstance& GetInstance() override
+        BoundStringDisplayable(_In_ TClass *pClass,
+                               _In_ const TStringProjector& stringProjectorFunction)
         {
-            return m_instance;
+            m_pClass = pClass;
+            m_stringProjector = stringProjectorFunction;
+            Apply();
         }
 
         //*************************************************
-        // IPrivateTypeQuery:
+        // IStringDisplayableConcept:
         //
 
-        IFACEMETHOD_(ULONG64, GetTypeHash)()
+        IFACEMETHOD(ToDisplayString)(_In_ IModelObject *pContextObject,
+                                     _In_opt_ IKeyStore *pMetadata,
+                                     _Out_ BSTR *pDisplayString)
         {
-            return m_typeHash;
+            try
+            {
+                ClientEx::Object contextObj = pContextObject;
+                ClientEx::Metadata metadata = pMetadata;
+                auto result = m_stringProjector(contextObj, metadata);
+                *pDisplayString = SysAllocString(ClientEx::Details::ExtractString(result));
+                if (*pDisplayString == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
         }
 
     private:
 
-        TInstance m_instance;
-        ULONG64 m_typeHash;
+        void Apply()
+        {
+            m_pClass->GetObject()->SetConcept(__uuidof(IStringDisplayableConcept), static_cast<IStringDisplayableConcept *>(this), nullptr);
+        }
+
+        TClass *m_pClass;
+        StringProjectorFunction m_stringProjector;
     };
 
-    template<typename TInstance>
-    struct SharedStorage : StorageInterface<TInstance>
+
+    template<typename TClass, typename TConstructableProjector, typename... TArgs>
+    class BoundConstructable :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IConstructableConcept
+            >
     {
     public:
-        using InstanceData = TInstance;
-        using StorageData = std::shared_ptr<TInstance>;
 
-        SharedStorage(_In_ std::shared_ptr<TInstance> sharedInstance, _In_ ULONG64 typeHash) :
-            m_spSharedInstance(std::move(sharedInstance)),
-            m_typeHash(typeHash)
-        {
-        }
+        using ConstructableProjectorFunction = typename ClientEx::Details::FunctorTraits<TConstructableProjector>::FunctionType;
 
-        TInstance& GetInstance()
+        BoundConstructable(_In_ TClass *pClass,
+                           _In_ const TConstructableProjector& constructableProjectorFunction)
         {
-            return *(m_spSharedInstance.get());
+            m_pClass = pClass;
+            m_constructableProjector = constructableProjectorFunction;
+            Apply();
         }
 
         //*************************************************
-        // IPrivateTypeQuery:
+        // IConstructableConcept:
         //
 
-        IFACEMETHOD_(ULONG64, GetTypeHash)()
+        IFACEMETHOD(CreateInstance)(_In_ ULONG64 argCount,
+                                    _In_reads_(argCount) IModelObject **ppArguments,
+                                    _COM_Errorptr_ IModelObject **ppInstance)
         {
-            return m_typeHash;
+            *ppInstance = nullptr;
+
+            try
+            {
+                ClientEx::Object result = ClientEx::Details::LiteralInvokeFunctionFromPack(m_constructableProjector,
+                                                                                           static_cast<size_t>(argCount),
+                                                                                           ppArguments);
+                *ppInstance = result.Detach();
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
         }
 
     private:
 
-        std::shared_ptr<TInstance> m_spSharedInstance;
-        ULONG64 m_typeHash;
+        void Apply()
+        {
+            m_pClass->GetObject()->SetConcept(__uuidof(IConstructableConcept), static_cast<IConstructableConcept *>(this), nullptr);
+        }
+
+        TClass *m_pClass;
+        ConstructableProjectorFunction m_constructableProjector;
     };
 
-    template<typename TInstance>
-    struct UniqueStorage : StorageInterface<TInstance>
+    template<typename TClass, typename TDeconstructableProjector>
+    class BoundDeconstructable :
+        public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
+            IDeconstructableConcept,
+            ClientEx::Details::IStreamingDeconstructableConcept
+            >
     {
     public:
-        using InstanceData = TInstance;
-        using StorageData = std::unique_ptr<TInstance>;
 
-        UniqueStorage(_In_ std::unique_ptr<TInstance> uniqueInstance, _In_ ULONG64 typeHash) :
-            m_spUniqueInstance(std::move(uniqueInstance)),
-            m_typeHash(typeHash)
+        using DeconstructableProjectorFunction = typename ClientEx::Details::FunctorTraits<TDeconstructableProjector>::FunctionType;
+
+        BoundDeconstructable(_In_ TClass *pClass,
+                             _In_z_ const wchar_t *pConstructableModelName,
+                             _In_ const TDeconstructableProjector& deconstructableProjectorFunction)
+        {
+            m_pClass = pClass;
+            m_constructableModelName = pConstructableModelName;
+            m_deconstructableProjector = deconstructableProjectorFunction;
+            Apply();
+        }
+
+        //*************************************************
+        // IDeconstructableConcept:
+        //
+
+        IFACEMETHOD(GetConstructableModelName)(_In_ IModelObject * /*pContextObject*/,
+                                               _Out_ BSTR *pConstructableModelName)
         {
+            *pConstructableModelName = SysAllocString(m_constructableModelName.c_str());
+            if (*pConstructableModelName == nullptr)
+            {
+                return E_OUTOFMEMORY;
+            }
+
+            return S_OK;
         }
 
-        TInstance& GetInstance()
+        IFACEMETHOD(GetConstructorArgumentCount)(_In_ IModelObject *pContextObject,
+                                                 _Out_ ULONG64 *pArgCount)
         {
-            return *(m_spUniqueInstance.get());
+            try
+            {
+                ClientEx::Object contextObject = pContextObject;
+                auto arbitraryArgs = m_deconstructableProjector(contextObject);
+                *pArgCount = std::tuple_size_v<decltype(arbitraryArgs)>;
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
+        }
+
+        IFACEMETHOD(GetConstructorArguments)(_In_ IModelObject *pContextObject,
+                                             _In_ ULONG64 argCount,
+                                             _Out_writes_(argCount) IModelObject **ppConstructorArguments)
+        {
+            try
+            {
+                for (size_t x = 0; x < argCount; ++x)
+                {
+                    ppConstructorArguments[x] = nullptr;
+                }
+
+                ClientEx::Object contextObject = pContextObject;
+                auto arbitraryArgs = m_deconstructableProjector(contextObject);
+                size_t computedArgCount = std::tuple_size_v<decltype(arbitraryArgs)>;
+
+                if (computedArgCount != argCount)
+                {
+                    throw std::invalid_argument("Inappropriate number of output arguments passed to object deconstructor");
+                }
+
+                auto pack = ClientEx::Details::PackTuple(arbitraryArgs);
+
+                for (size_t i = 0; i < argCount; ++i)
+                {
+                    ppConstructorArguments[i] = pack[i].Detach();
+                }
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
         }
 
         //*************************************************
-        // IPrivateTypeQuery:
+        // IStreamingDeconstructableConcept:
         //
 
-        IFACEMETHOD_(ULONG64, GetTypeHash)()
+        IFACEMETHOD(GetConstructorArgumentsInto)(_In_ IModelObject *pContextObject,
+                                                 _In_ ClientEx::Details::IDeconstructionArgumentSink *pSink)
         {
-            return m_typeHash;
+            try
+            {
+                ClientEx::Object contextObject = pContextObject;
+                auto arbitraryArgs = m_deconstructableProjector(contextObject);
+                ClientEx::Details::SinkTuple(pSink, arbitraryArgs);
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+            }
+            return S_OK;
         }
 
     private:
 
-        std::unique_ptr<TInstance> m_spUniqueInstance;
-        ULONG64 m_typeHash;
-    };
+        void Apply()
+        {
+            m_pClass->GetObject()->SetConcept(__uuidof(IDeconstructableConcept), static_cast<IDeconstructableConcept *>(this), nullptr);
+        }
 
-    template<typename TInstance>
-    struct StorageTraits
-    {
-        using StorageType = typename BasicStorage<TInstance>;
-        using InstanceData = TInstance;
-    };
+        TClass *m_pClass;
+        DeconstructableProjectorFunction m_deconstructableProjector;
+        std::wstring m_constructableModelName;
 
-    template<typename TInstance>
-    struct StorageTraits<std::shared_ptr<TInstance>>
-    {
-        using StorageType = typename SharedStorage<TInstance>;
-        using InstanceData = TInstance;
     };
 
-    template<typename TInstance>
-    struct StorageTraits<std::unique_ptr<TInstance>>
+    constexpr ULONG64 GetSigHash(_In_z_ const char *pc)
     {
-        using StorageType = typename UniqueStorage<TInstance>;
-        using InstanceData = TInstance;
+        ULONG64 hash = 2166136261u; // FNV offset basis
+        while(*pc)
+        {
+            hash ^= *pc;
+             hash = hash * 16777619u; // FNV prime
+            ++pc;
+        }
+        return hash;
     };
 
-    //*************************************************
-    // Data Models:
-    //
-
-    // DataModelConcept:
+    // DeferredAccessorTable:
     //
-    // An implementation of the data model concept.
+    // The properties and methods of an ExtensionModel which defers the creation of its accessors (see
+    // ExtensionModel::EnableDeferredAccessors()).  Each entry holds a function which creates the accessor object.  The
+    // accessor is created on first use and kept thereafter.
     //
-    template<typename TClass>
-    class DataModelConcept :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IDataModelConcept
-            >
+    class DeferredAccessorTable
     {
     public:
 
-        typedef const std::wstring& (TClass::*NameMethod)() const;
-
-        DataModelConcept(_In_ TClass *pClass, _In_ NameMethod nameMethod) : m_pClass(pClass), m_nameMethod(nameMethod) { }
-
-        //*************************************************
-        // IDataModelConcept:
+        // Add():
         //
+        // Adds (or replaces) the named entry.
+        //
+        void Add(_In_z_ const wchar_t *name,
+                 _In_ ClientEx::AccessorKind kind,
+                 _In_ const ClientEx::Metadata& metadata,
+                 _In_ std::function<ClientEx::Object(void)> createAccessor)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto it = m_index.find(std::wstring_view(name));
+            if (it != m_index.end())
+            {
+                Entry& entry = m_entries[it->second];
+                entry.Kind = kind;
+                entry.EntryMetadata = metadata;
+                entry.CreateAccessor = std::move(createAccessor);
+                entry.Accessor = ClientEx::Object();
+                entry.PropertyAccessor = nullptr;
+                return;
+            }
 
-        IFACEMETHOD(InitializeObject)(_In_ IModelObject * /*pModelObject*/,
-                                      _In_opt_ IDebugHostTypeSignature * /*pMatchingTypeSignature*/,
-                                      _In_opt_ IDebugHostSymbolEnumerator * /*pWildcardMatches*/)
-        {
-            return S_OK;
+            m_entries.push_back(Entry { name, kind, metadata, std::move(createAccessor), ClientEx::Object(), nullptr });
+            m_index.emplace(std::wstring_view(m_entries.back().Name), m_entries.size() - 1);
         }
 
-        IFACEMETHOD(GetName)(_Out_ BSTR *pModelName)
+        // GetValue():
+        //
+        // Gets the value of the named entry for a given context object: the result of the property getter or the
+        // method object itself.  Returns false if there is no such entry.  If pValue is nullptr, the accessor is not
+        // created.
+        //
+        bool GetValue(_In_opt_ IModelObject *pContextObject,
+                      _In_z_ PCWSTR name,
+                      _Out_opt_ ClientEx::Object *pValue,
+                      _Out_opt_ ClientEx::Metadata *pMetadata)
         {
-            *pModelName = nullptr;
+            if (pValue == nullptr)
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto it = m_index.find(std::wstring_view(name));
+                if (it == m_index.end())
+                {
+                    return false;
+                }
+                if (pMetadata != nullptr)
+                {
+                    *pMetadata = m_entries[it->second].EntryMetadata;
+                }
+                return true;
+            }
 
-            const std::wstring& modelName = (m_pClass->*m_nameMethod)();
-            if (modelName.empty())
+            ClientEx::Object accessor;
+            ComPtr<IModelPropertyAccessor> spPropertyAccessor;
+            ClientEx::Metadata metadata;
+            if (!Materialize(name, &accessor, &spPropertyAccessor, &metadata))
             {
-                return E_NOTIMPL;
+                return false;
             }
 
-            *pModelName = SysAllocString(modelName.c_str());
-            if (*pModelName == nullptr)
+            if (spPropertyAccessor == nullptr)
             {
-                return E_OUTOFMEMORY;
+                *pValue = std::move(accessor);
+            }
+            else
+            {
+                ComPtr<IModelObject> spValue;
+                HRESULT hr = spPropertyAccessor->GetValue(name, pContextObject, &spValue);
+                ClientEx::CheckHr(hr, spValue);
+                *pValue = ClientEx::Object(std::move(spValue));
             }
 
-            return S_OK;
+            if (pMetadata != nullptr)
+            {
+                *pMetadata = std::move(metadata);
+            }
+
+            return true;
         }
 
-    private:
+        // SetValue():
+        //
+        // Sets the value of the named property for a given context object.  Returns false if there is no such entry.
+        //
+        bool SetValue(_In_opt_ IModelObject *pContextObject, _In_z_ PCWSTR name, _In_ IModelObject *pValue)
+        {
+            ClientEx::Object accessor;
+            ComPtr<IModelPropertyAccessor> spPropertyAccessor;
+            if (!Materialize(name, &accessor, &spPropertyAccessor, nullptr))
+            {
+                return false;
+            }
 
-        TClass *m_pClass;
-        NameMethod m_nameMethod;
+            if (spPropertyAccessor == nullptr)
+            {
+                throw ClientEx::not_implemented();
+            }
 
+            ClientEx::CheckHr(spPropertyAccessor->SetValue(name, pContextObject, pValue));
+            return true;
+        }
 
-    };
+        // GetNames():
+        //
+        // Returns the names of every entry in the order they were added.
+        //
+        std::vector<std::wstring> GetNames() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            std::vector<std::wstring> names;
+            names.reserve(m_entries.size());
+            for (auto&& entry : m_entries)
+            {
+                names.push_back(entry.Name);
+            }
+            return names;
+        }
 
-    template<typename TClass, typename TStringProjector>
-    class BoundStringDisplayable :
-        public Microsoft::WRL::RuntimeClass<
-            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IStringDisplayableConcept
-            >
-    {
-    public:
+        // Clear():
+        //
+        // Removes every entry.
+        //
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_index.clear();
+            m_entries.clear();
+        }
 
-        using StringProjectorFunction = typename ClientEx::Details::FunctorTraits<TStringProjector>::FunctionType;
+    private:
 
-        BoundStringDisplayable(_In_ TClass *pClass,
-                               _In_ const TStringProjector& stringProjectorFunction)
+        struct Entry
         {
-            m_pClass = pClass;
-            m_stringProjector = stringProjectorFunction;
-            Apply();
-        }
+            std::wstring Name;
+            ClientEx::AccessorKind Kind;
+            ClientEx::Metadata EntryMetadata;
+            std::function<ClientEx::Object(void)> CreateAccessor;
+            ClientEx::Object Accessor;
+            ComPtr<IModelPropertyAccessor> PropertyAccessor;
+        };
 
-        //*************************************************
-        // IStringDisplayableConcept:
+        // Materialize():
         //
-
-        IFACEMETHOD(ToDisplayString)(_In_ IModelObject *pContextObject,
-                                     _In_opt_ IKeyStore *pMetadata,
-                                     _Out_ BSTR *pDisplayString)
+        // Finds the named entry and creates its accessor if this is the first use.  The accessor is created outside
+        // the lock.  If two threads race on the same entry, the first insertion wins.
+        //
+        bool Materialize(_In_z_ PCWSTR name,
+                         _Out_ ClientEx::Object *pAccessor,
+                         _Out_ ComPtr<IModelPropertyAccessor> *pspPropertyAccessor,
+                         _Out_opt_ ClientEx::Metadata *pMetadata)
         {
-            try
+            std::function<ClientEx::Object(void)> createAccessor;
+            ClientEx::AccessorKind kind;
             {
-                ClientEx::Object contextObj = pContextObject;
-                ClientEx::Metadata metadata = pMetadata;
-                auto result = m_stringProjector(contextObj, metadata);
-                *pDisplayString = SysAllocString(ClientEx::Details::ExtractString(result));
-                if (*pDisplayString == nullptr)
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto it = m_index.find(std::wstring_view(name));
+                if (it == m_index.end())
                 {
-                    throw std::bad_alloc();
+                    return false;
+                }
+
+                Entry& entry = m_entries[it->second];
+                if (pMetadata != nullptr)
+                {
+                    *pMetadata = entry.EntryMetadata;
+                }
+
+                if (entry.Accessor.GetObject() != nullptr)
+                {
+                    *pAccessor = entry.Accessor;
+                    *pspPropertyAccessor = entry.PropertyAccessor;
+                    return true;
                 }
+
+                createAccessor = entry.CreateAccessor;
+                kind = entry.Kind;
             }
-            catch(...)
+
+            ClientEx::Object accessor = createAccessor();
+            ComPtr<IModelPropertyAccessor> spPropertyAccessor;
+            if (kind == ClientEx::AccessorKind::Property)
             {
-                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
+                VARIANT vtAccessor;
+                ClientEx::CheckHr(accessor->GetIntrinsicValue(&vtAccessor));
+                ComPtr<IUnknown> spUnk;
+                spUnk.Attach(vtAccessor.punkVal);
+                ClientEx::CheckHr(spUnk.As(&spPropertyAccessor));
             }
-            return S_OK;
-        }
-
-    private:
 
-        void Apply()
-        {
-            m_pClass->GetObject()->SetConcept(__uuidof(IStringDisplayableConcept), static_cast<IStringDisplayableConcept *>(this), nullptr);
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto it = m_index.find(std::wstring_view(name));
+            if (it != m_index.end())
+            {
+                Entry& entry = m_entries[it->second];
+                if (entry.Accessor.GetObject() == nullptr)
+                {
+                    entry.Accessor = accessor;
+                    entry.PropertyAccessor = spPropertyAccessor;
+                }
+                *pAccessor = entry.Accessor;
+                *pspPropertyAccessor = entry.PropertyAccessor;
+            }
+            else
+            {
+                *pAccessor = std::move(accessor);
+                *pspPropertyAccessor = std::move(spPropertyAccessor);
+            }
+            return true;
         }
 
-        TClass *m_pClass;
-        StringProjectorFunction m_stringProjector;
-    };
+        mutable std::mutex m_lock;
 
+        //
+        // A deque so that the names the index refers to never move.
+        //
+        std::deque<Entry> m_entries;
+        std::unordered_map<std::wstring_view, size_t> m_index;
+    };
 
-    template<typename TClass, typename TConstructableProjector, typename... TArgs>
-    class BoundConstructable :
+    // DeferredKeyEnumerator:
+    //
+    // Enumerates the keys of a DeferredAccessorTable.  The names are captured when the enumerator is created.
+    //
+    class DeferredKeyEnumerator :
         public Microsoft::WRL::RuntimeClass<
             Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IConstructableConcept
+            IKeyEnumerator
             >
     {
     public:
 
-        using ConstructableProjectorFunction = typename ClientEx::Details::FunctorTraits<TConstructableProjector>::FunctionType;
-
-        BoundConstructable(_In_ TClass *pClass,
-                           _In_ const TConstructableProjector& constructableProjectorFunction)
+        DeferredKeyEnumerator(_In_ std::shared_ptr<DeferredAccessorTable> spTable, _In_opt_ IModelObject *pContextObject) :
+            m_spTable(std::move(spTable)),
+            m_spContextObject(pContextObject),
+            m_names(m_spTable->GetNames()),
+            m_pos(0)
         {
-            m_pClass = pClass;
-            m_constructableProjector = constructableProjectorFunction;
-            Apply();
         }
 
         //*************************************************
-        // IConstructableConcept:
+        // IKeyEnumerator:
         //
 
-        IFACEMETHOD(CreateInstance)(_In_ ULONG64 argCount,
-                                    _In_reads_(argCount) IModelObject **ppArguments,
-                                    _COM_Errorptr_ IModelObject **ppInstance)
+        IFACEMETHOD(Reset)()
         {
-            *ppInstance = nullptr;
+            m_pos = 0;
+            return S_OK;
+        }
+
+        IFACEMETHOD(GetNext)(_Out_ BSTR *pKey,
+                             _COM_Outptr_opt_result_maybenull_ IModelObject **ppValue,
+                             _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata)
+        {
+            *pKey = nullptr;
+            if (ppValue != nullptr)
+            {
+                *ppValue = nullptr;
+            }
+            if (ppMetadata != nullptr)
+            {
+                *ppMetadata = nullptr;
+            }
 
             try
             {
-                ClientEx::Object result = ClientEx::Details::LiteralInvokeFunctionFromPack(m_constructableProjector,
-                                                                                           static_cast<size_t>(argCount),
-                                                                                           ppArguments);
-                *ppInstance = result.Detach();
+                while (m_pos < m_names.size())
+                {
+                    const std::wstring& name = m_names[m_pos++];
+
+                    //
+                    // A failure of the getter becomes the value of the key rather than failing the enumeration.
+                    //
+                    ClientEx::Object value;
+                    ClientEx::Metadata metadata;
+                    bool hasKey;
+                    try
+                    {
+                        hasKey = m_spTable->GetValue(m_spContextObject.Get(), name.c_str(), ppValue != nullptr ? &value : nullptr, &metadata);
+                    }
+                    catch(...)
+                    {
+                        hasKey = true;
+                        value = ClientEx::Object::CreateError(std::current_exception());
+                    }
+
+                    if (!hasKey)
+                    {
+                        continue;
+                    }
+
+                    BSTR key = SysAllocStringLen(name.c_str(), static_cast<UINT>(name.size()));
+                    if (key == nullptr)
+                    {
+                        throw std::bad_alloc();
+                    }
+
+                    *pKey = key;
+                    if (ppValue != nullptr)
+                    {
+                        *ppValue = value.Detach();
+                    }
+                    if (ppMetadata != nullptr)
+                    {
+                        *ppMetadata = metadata.Detach();
+                    }
+                    return S_OK;
+                }
             }
             catch(...)
             {
                 return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
             }
-            return S_OK;
+
+            return E_BOUNDS;
         }
 
     private:
 
-        void Apply()
-        {
-            m_pClass->GetObject()->SetConcept(__uuidof(IConstructableConcept), static_cast<IConstructableConcept *>(this), nullptr);
-        }
-
-        TClass *m_pClass;
-        ConstructableProjectorFunction m_constructableProjector;
+        std::shared_ptr<DeferredAccessorTable> m_spTable;
+        ComPtr<IModelObject> m_spContextObject;
+        std::vector<std::wstring> m_names;
+        size_t m_pos;
     };
 
-    template<typename TClass, typename TDeconstructableProjector>
-    class BoundDeconstructable :
+    // DeferredKeyProvider:
+    //
+    // The dynamic key provider which an ExtensionModel with deferred accessors places on its model object.  It
+    // serves every key from the model's DeferredAccessorTable.
+    //
+    class DeferredKeyProvider :
         public Microsoft::WRL::RuntimeClass<
             Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::RuntimeClassType::ClassicCom>,
-            IDeconstructableConcept
+            IDynamicKeyProviderConcept
             >
     {
     public:
 
-        using DeconstructableProjectorFunction = typename ClientEx::Details::FunctorTraits<TDeconstructableProjector>::FunctionType;
-
-        BoundDeconstructable(_In_ TClass *pClass,
-                             _In_z_ const wchar_t *pConstructableModelName,
-                             _In_ const TDeconstructableProjector& deconstructableProjectorFunction)
+        DeferredKeyProvider(_In_ std::shared_ptr<DeferredAccessorTable> spTable,
+                            _In_ ClientEx::Details::DataModelReference linkRef) :
+            m_spTable(std::move(spTable)),
+            m_linkRef(std::move(linkRef))
         {
-            m_pClass = pClass;
-            m_constructableModelName = pConstructableModelName;
-            m_deconstructableProjector = deconstructableProjectorFunction;
-            Apply();
         }
 
         //*************************************************
-        // IDeconstructableConcept:
+        // IDynamicKeyProviderConcept:
         //
 
-        IFACEMETHOD(GetConstructableModelName)(_In_ IModelObject * /*pContextObject*/,
-                                               _Out_ BSTR *pConstructableModelName)
+        IFACEMETHOD(GetKey)(_In_ IModelObject *pContextObject,
+                            _In_ PCWSTR key,
+                            _COM_Outptr_opt_result_maybenull_ IModelObject **ppKeyValue,
+                            _COM_Outptr_opt_result_maybenull_ IKeyStore **ppMetadata,
+                            _Out_opt_ bool *pHasKey)
         {
-            *pConstructableModelName = SysAllocString(m_constructableModelName.c_str());
-            if (*pConstructableModelName == nullptr)
+            if (ppMetadata != nullptr)
             {
-                return E_OUTOFMEMORY;
+                *ppMetadata = nullptr;
+            }
+            if (pHasKey != nullptr)
+            {
+                *pHasKey = false;
+            }
+
+            try
+            {
+                ClientEx::Details::ThrowIfDetached(m_linkRef);
+
+                ClientEx::Object value;
+                ClientEx::Metadata metadata;
+                if (!m_spTable->GetValue(pContextObject, key, ppKeyValue != nullptr ? &value : nullptr, &metadata))
+                {
+                    if (ppKeyValue != nullptr)
+                    {
+                        *ppKeyValue = nullptr;
+                    }
+                    return (pHasKey != nullptr) ? S_OK : E_BOUNDS;
+                }
+
+                if (ppKeyValue != nullptr)
+                {
+                    *ppKeyValue = value.Detach();
+                }
+                if (ppMetadata != nullptr)
+                {
+                    *ppMetadata = metadata.Detach();
+                }
+                if (pHasKey != nullptr)
+                {
+                    *pHasKey = true;
+                }
+            }
+            catch(...)
+            {
+                return ClientEx::Details::Exceptions::ReturnResult(std::current_exception(), ppKeyValue);
             }
 
             return S_OK;
         }
 
-        IFACEMETHOD(GetConstructorArgumentCount)(_In_ IModelObject *pContextObject,
-                                                 _Out_ ULONG64 *pArgCount)
+        IFACEMETHOD(SetKey)(_In_ IModelObject *pContextObject,
+                            _In_ PCWSTR key,
+                            _In_ IModelObject *pKeyValue,
+                            _In_ IKeyStore * /*pMetadata*/)
         {
             try
             {
-                ClientEx::Object contextObject = pContextObject;
-                auto arbitraryArgs = m_deconstructableProjector(contextObject);
-                *pArgCount = std::tuple_size_v<decltype(arbitraryArgs)>;
+                ClientEx::Details::ThrowIfDetached(m_linkRef);
+                if (!m_spTable->SetValue(pContextObject, key, pKeyValue))
+                {
+                    return E_BOUNDS;
+                }
             }
             catch(...)
             {
                 return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
             }
+
             return S_OK;
         }
 
-        IFACEMETHOD(GetConstructorArguments)(_In_ IModelObject *pContextObject,
-                                             _In_ ULONG64 argCount,
-                                             _Out_writes_(argCount) IModelObject **ppConstructorArguments)
+        IFACEMETHOD(EnumerateKeys)(_In_ IModelObject *pContextObject,
+                                   _COM_Outptr_ IKeyEnumerator **ppEnumerator)
         {
+            *ppEnumerator = nullptr;
             try
             {
-                for (size_t x = 0; x < argCount; ++x)
-                {
-                    ppConstructorArguments[x] = nullptr;
-                }
-
-                ClientEx::Object contextObject = pContextObject;
-                auto arbitraryArgs = m_deconstructableProjector(contextObject);
-                size_t computedArgCount = std::tuple_size_v<decltype(arbitraryArgs)>;
-
-                if (computedArgCount != argCount)
-                {
-                    throw std::invalid_argument("Inappropriate number of output arguments passed to object deconstructor");
-                }
-
-                ClientEx::Details::ParameterPack pack = ClientEx::Details::PackTuple(arbitraryArgs);
-
-                for (size_t i = 0; i < argCount; ++i)
+                ClientEx::Details::ThrowIfDetached(m_linkRef);
+                ComPtr<DeferredKeyEnumerator> spEnum = Make<DeferredKeyEnumerator>(m_spTable, pContextObject);
+                if (spEnum == nullptr)
                 {
-                    ppConstructorArguments[i] = pack[i].Detach();
+                    throw std::bad_alloc();
                 }
+                *ppEnumerator = spEnum.Detach();
             }
             catch(...)
             {
                 return ClientEx::Details::Exceptions::ReturnResult(std::current_exception());
             }
+
             return S_OK;
         }
 
     private:
 
-        void Apply()
-        {
-            m_pClass->GetObject()->SetConcept(__uuidof(IDeconstructableConcept), static_cast<IDeconstructableConcept *>(this), nullptr);
-        }
-
-        TClass *m_pClass;
-        DeconstructableProjectorFunction m_deconstructableProjector;
-        std::wstring m_constructableModelName;
-
-    };
-
-    constexpr ULONG64 GetSigHash(_In_z_ const char *pc)
-    {
-        ULONG64 hash = 2166136261u; // FNV offset basis
-        while(*pc)
-        {
-            hash ^= *pc;
-             hash = hash * 16777619u; // FNV prime
-            ++pc;
-        }
-        return hash;
+        std::shared_ptr<DeferredAccessorTable> m_spTable;
+        ClientEx::Details::DataModelReference m_linkRef;
     };
 
     class ExtensionRegistrationListBase
@@ -9423,6 +18512,31 @@ public:
 
 protected:
 
+    // GetAccessorStats():
+    //
+    // Gets the statistics slot for a property or method bound on this data model.  Records are keyed by the
+    // registered name of the model or, absent one, the name of the C++ class.  The record itself is only registered
+    // when the first call through the accessor is recorded.
+    //
+    std::shared_ptr<ClientEx::AccessorStatsSlot> GetAccessorStats(_In_z_ const wchar_t *accessorName, _In_ ClientEx::AccessorKind kind) const
+    {
+        return std::make_shared<ClientEx::AccessorStatsSlot>(GetAccessorModelName(), accessorName, kind);
+    }
+
+    // GetAccessorModelName():
+    //
+    // Gets the model name under which the statistics of accessors bound on this data model are recorded.
+    //
+    std::wstring GetAccessorModelName() const
+    {
+        if (!m_modelName.empty())
+        {
+            return m_modelName;
+        }
+
+        return ClientEx::Details::StringUtils::GetWideString(typeid(*this).name());
+    }
+
     std::wstring m_modelName;
 
 private:
@@ -9511,8 +18625,10 @@ public:
             using TValue = std::invoke_result_t<TGetFunc, ClientEx::Object>;
             static_assert(std::is_invocable_v<TSetFunc, ClientEx::Object, TValue>, "Bound property setter must take (const) Object (&) as first argument");
 
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunction, setFunction);
-            ClientEx::CheckHr(GetObject()->SetKey(propertyName, propertyAccessor, metadata));
+            AddAccessor(propertyName, ClientEx::AccessorKind::Property, metadata, [getFunction, setFunction](_In_ const std::shared_ptr<ClientEx::AccessorStatsSlot>& spStats)
+            {
+                return ClientEx::Details::BoxProperty(getFunction, setFunction, spStats);
+            });
         }
     }
 
@@ -9540,8 +18656,10 @@ public:
             (pDerived->*setClassMethod)(instanceObject, val);
         };
 
-        ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc);
-        ClientEx::CheckHr(GetObject()->SetKey(propertyName, propertyAccessor, metadata));
+        AddAccessor(propertyName, ClientEx::AccessorKind::Property, metadata, [getFunc, setFunc](_In_ const std::shared_ptr<ClientEx::AccessorStatsSlot>& spStats)
+        {
+            return ClientEx::Details::BoxProperty(getFunc, setFunc, spStats);
+        });
     }
 
     template<typename TGetFunc>
@@ -9552,8 +18670,10 @@ public:
         static_assert(std::is_invocable_v<TGetFunc, ClientEx::Object>, "Bound property getter must take (const) Object (&) as first argument");
         if constexpr (std::is_invocable_v<TGetFunc, ClientEx::Object>) // Prevent noise from failure of the assertion above
         {
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunction);
-            ClientEx::CheckHr(GetObject()->SetKey(propertyName, propertyAccessor, metadata));
+            AddAccessor(propertyName, ClientEx::AccessorKind::Property, metadata, [getFunction](_In_ const std::shared_ptr<ClientEx::AccessorStatsSlot>& spStats)
+            {
+                return ClientEx::Details::BoxProperty(getFunction, spStats);
+            });
         }
     }
 
@@ -9572,8 +18692,10 @@ public:
             return (pDerived->*getClassMethod)(instanceObject);
         };
 
-        ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc);
-        ClientEx::CheckHr(GetObject()->SetKey(propertyName, propertyAccessor, metadata));
+        AddAccessor(propertyName, ClientEx::AccessorKind::Property, metadata, [getFunc](_In_ const std::shared_ptr<ClientEx::AccessorStatsSlot>& spStats)
+        {
+            return ClientEx::Details::BoxProperty(getFunc, spStats);
+        });
     }
 
     template<typename TObj, typename TClass, typename TRet>
@@ -9585,6 +18707,63 @@ public:
         AddReadOnlyProperty(propertyName, const_cast<TClass *>(pDerived), reinterpret_cast<TRet(TClass::*)(TObj)>(getClassMethod), metadata);
     }
 
+    // AddCachedReadOnlyProperty():
+    //
+    // Adds a new read-only property whose boxed value is memoized in the given cache per instance object.  This is
+    // intended for properties which are expensive to compute and whose value does not change while the target is
+    // stopped.  See PropertyValueCache for when cached values are dropped.
+    //
+    template<typename TGetFunc>
+    void AddCachedReadOnlyProperty(_In_z_ const wchar_t *propertyName,
+                                   _In_ const TGetFunc& getFunction,    // TValue getFunction([const] Object [&]);
+                                   _In_ const std::shared_ptr<ClientEx::PropertyValueCache>& spCache,
+                                   _In_ const ClientEx::Metadata& metadata = ClientEx::Metadata())
+    {
+        static_assert(std::is_invocable_v<TGetFunc, ClientEx::Object>, "Bound property getter must take (const) Object (&) as first argument");
+        if constexpr (std::is_invocable_v<TGetFunc, ClientEx::Object>) // Prevent noise from failure of the assertion above
+        {
+            ULONG64 propertyId = spCache->CreatePropertyId();
+            auto getFunc = [getFunction, spCache, propertyId](_In_ const ClientEx::Object& instanceObject)
+            {
+                return spCache->GetValue(propertyId, instanceObject, [&]()
+                {
+                    return ClientEx::BoxObject(getFunction(instanceObject));
+                });
+            };
+
+            AddReadOnlyProperty(propertyName, getFunc, metadata);
+        }
+    }
+
+    template<typename TObj, typename TClass, typename TRet>
+    void AddCachedReadOnlyProperty(_In_z_ const wchar_t *propertyName,
+                                   _In_ TClass *pDerived,
+                                   _In_ TRet (TClass::*getClassMethod)(_In_ TObj),
+                                   _In_ const std::shared_ptr<ClientEx::PropertyValueCache>& spCache,
+                                   _In_ const ClientEx::Metadata& metadata = ClientEx::Metadata())
+    {
+        static_assert(Details::is_object_v<TObj>, "Bound property getter must take (const) Object (&) as first argument");
+
+        ClientEx::Details::DataModelReference getLinkRef = GetLinkReference();
+        auto getFunc = [linkRef = std::move(getLinkRef), pDerived, getClassMethod](_In_ const ClientEx::Object& instanceObject)
+        {
+            ClientEx::Details::ThrowIfDetached(linkRef);
+            return (pDerived->*getClassMethod)(instanceObject);
+        };
+
+        AddCachedReadOnlyProperty(propertyName, getFunc, spCache, metadata);
+    }
+
+    template<typename TObj, typename TClass, typename TRet>
+    void AddCachedReadOnlyProperty(_In_z_ const wchar_t *propertyName,
+                                   _In_ const TClass *pDerived,
+                                   _In_ TRet (TClass::*getClassMethod)(_In_ TObj) const,
+                                   _In_ const std::shared_ptr<ClientEx::PropertyValueCache>& spCache,
+                                   _In_ const ClientEx::Metadata& metadata = ClientEx::Metadata())
+    {
+        AddCachedReadOnlyProperty(propertyName, const_cast<TClass *>(pDerived), reinterpret_cast<TRet(TClass::*)(TObj)>(getClassMethod), spCache, metadata);
+    }
+
     // AddMethod():
     //
     // Adds a new method.
@@ -9612,9 +18791,10 @@ public:
                 );
         };
 
-        ClientEx::Object methodObject;
-        methodObject = callDest;
-        ClientEx::CheckHr(GetObject()->SetKey(methodName, methodObject, metadata));
+        AddAccessor(methodName, ClientEx::AccessorKind::Method, metadata, [callDest](_In_ const std::shared_ptr<ClientEx::AccessorStatsSlot>& spStats)
+        {
+            return ClientEx::Details::BoxMethod(callDest, spStats);
+        });
     }
 
     template<typename TObj, typename TClass, typename TRet, typename... TArgs>
@@ -9626,6 +18806,49 @@ public:
         AddMethod(methodName, const_cast<TClass *>(pDerived), reinterpret_cast<TRet (TClass::*)(TObj, TArgs...)>(classMethod), metadata);
     }
 
+    // EnableDeferredAccessors():
+    //
+    // Switches the model to deferred accessors.  Properties and methods added afterward are recorded in a table
+    // rather than each being boxed into its own COM object and set as its own key on the model.  A single dynamic
+    // key provider on the model creates the accessor for a key the first time that key is fetched.  This must be
+    // called before any property or method is added to the model (typically first in the constructor of the derived
+    // class).  If one already has been, this will throw.
+    //
+    void EnableDeferredAccessors()
+    {
+        if (m_spDeferredAccessors != nullptr)
+        {
+            return;
+        }
+
+        if (m_hasEagerAccessors)
+        {
+            throw ClientEx::illegal_operation("EnableDeferredAccessors must be called before any property or method is added");
+        }
+
+        auto spTable = std::make_shared<Details::DeferredAccessorTable>();
+        ComPtr<Details::DeferredKeyProvider> spProvider = Make<Details::DeferredKeyProvider>(spTable, GetLinkReference());
+        if (spProvider == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        ClientEx::CheckHr(GetObject()->SetConcept(__uuidof(IDynamicKeyProviderConcept), static_cast<IDynamicKeyProviderConcept *>(spProvider.Get()), nullptr));
+        m_spDeferredAccessors = std::move(spTable);
+    }
+
+    // ClearDeferredAccessors():
+    //
+    // Removes every deferred property and method from the model in one pass.
+    //
+    void ClearDeferredAccessors()
+    {
+        if (m_spDeferredAccessors != nullptr)
+        {
+            m_spDeferredAccessors->Clear();
+        }
+    }
+
     // AddStringDisplayableFunction():
     //
     // Adds the string displayable implementation on this object to a method of signature const Object&, const Metadata&
@@ -9928,6 +19151,39 @@ public:
 
 private:
 
+    // AddAccessor():
+    //
+    // Adds a property or method whose accessor object is made by createAccessor.  For a model with deferred
+    // accessors, this only records createAccessor in the table.
+    //
+    template<typename TCreateAccessor>
+    void AddAccessor(_In_z_ const wchar_t *accessorName,
+                     _In_ ClientEx::AccessorKind kind,
+                     _In_ const ClientEx::Metadata& metadata,
+                     _In_ TCreateAccessor&& createAccessor)
+    {
+        if (m_spDeferredAccessors != nullptr)
+        {
+            //
+            // The statistics slot is made along with the accessor, so an accessor which is never created has none.
+            // The lambda may outlive this object and so carries the names rather than calling back into it.
+            //
+            m_spDeferredAccessors->Add(accessorName, kind, metadata, [createAccessor = std::forward<TCreateAccessor>(createAccessor),
+                                                                      modelName = GetAccessorModelName(),
+                                                                      name = std::wstring(accessorName),
+                                                                      kind]()
+            {
+                return createAccessor(std::make_shared<ClientEx::AccessorStatsSlot>(modelName, name, kind));
+            });
+        }
+        else
+        {
+            ClientEx::Object accessor = createAccessor(GetAccessorStats(accessorName, kind));
+            ClientEx::CheckHr(GetObject()->SetKey(accessorName, accessor, metadata));
+            m_hasEagerAccessors = true;
+        }
+    }
+
     template<typename... TArgs>
     void CompleteExtensionModelInitialization(_In_ TArgs&&... registrations)
     {
@@ -9950,6 +19206,81 @@ private:
     }
 
     std::unique_ptr<Details::ExtensionRegistrationListBase> m_spRegistrationList;
+    std::shared_ptr<Details::DeferredAccessorTable> m_spDeferredAccessors;
+    bool m_hasEagerAccessors = false;
+};
+
+// ExtensionStatisticsModel:
+//
+// An extension which projects the accessor statistics (see AccessorStatistics) of this module into the data model
+// as Debugger.Utility.ExtensionStats.  Create one alongside the other models of the extension:
+//
+//     dx Debugger.Utility.ExtensionStats.Enable()
+//     dx Debugger.Utility.ExtensionStats.Accessors.OrderByDescending(a => a.TotalMicroseconds)
+//
+class ExtensionStatisticsModel : public ExtensionModel
+{
+public:
+
+    ExtensionStatisticsModel() :
+        ExtensionModel(NamespacePropertyParent(L"Debugger.Models.Utility", L"Debugger.Models.Utility.ExtensionStats", L"ExtensionStats"))
+    {
+        AddReadOnlyProperty(L"IsEnabled", this, &ExtensionStatisticsModel::GetIsEnabled);
+        AddReadOnlyProperty(L"Accessors", this, &ExtensionStatisticsModel::GetAccessors);
+        AddMethod(L"Enable", this, &ExtensionStatisticsModel::Enable);
+        AddMethod(L"Disable", this, &ExtensionStatisticsModel::Disable);
+        AddMethod(L"Reset", this, &ExtensionStatisticsModel::Reset);
+    }
+
+    bool GetIsEnabled(_In_ const ClientEx::Object& /*contextObject*/)
+    {
+        return ClientEx::AccessorStatistics::Instance().IsEnabled();
+    }
+
+    // GetAccessors():
+    //
+    // Returns an object per statistics record.  Latencies are converted to microseconds.
+    //
+    std::vector<ClientEx::Object> GetAccessors(_In_ const ClientEx::Object& /*contextObject*/)
+    {
+        double ticksPerMicrosecond = static_cast<double>(ClientEx::AccessorStatistics::GetTicksPerSecond()) / 1000000.0;
+
+        std::vector<ClientEx::Object> accessors;
+        for (auto const& spStats : ClientEx::AccessorStatistics::Instance().GetRecords())
+        {
+            ULONG64 calls = spStats->Calls.load(std::memory_order_relaxed);
+            double totalMicroseconds = static_cast<double>(spStats->TotalTicks.load(std::memory_order_relaxed)) / ticksPerMicrosecond;
+            double maxMicroseconds = static_cast<double>(spStats->MaxTicks.load(std::memory_order_relaxed)) / ticksPerMicrosecond;
+
+            accessors.push_back(ClientEx::Object::Create(ClientEx::HostContext(),
+                                                         L"Model", spStats->ModelName,
+                                                         L"Name", spStats->AccessorName,
+                                                         L"Kind", spStats->Kind == ClientEx::AccessorKind::Method ? L"Method" : L"Property",
+                                                         L"Calls", calls,
+                                                         L"Exceptions", spStats->Exceptions.load(std::memory_order_relaxed),
+                                                         L"TotalMicroseconds", totalMicroseconds,
+                                                         L"AverageMicroseconds", calls == 0 ? 0.0 : totalMicroseconds / static_cast<double>(calls),
+                                                         L"MaxMicroseconds", maxMicroseconds,
+                                                         L"BytesBoxed", spStats->BytesBoxed.load(std::memory_order_relaxed)));
+        }
+
+        return accessors;
+    }
+
+    void Enable(_In_ const ClientEx::Object& /*contextObject*/)
+    {
+        ClientEx::AccessorStatistics::Instance().Enable(true);
+    }
+
+    void Disable(_In_ const ClientEx::Object& /*contextObject*/)
+    {
+        ClientEx::AccessorStatistics::Instance().Enable(false);
+    }
+
+    void Reset(_In_ const ClientEx::Object& /*contextObject*/)
+    {
+        ClientEx::AccessorStatistics::Instance().Reset();
+    }
 };
 
 //**************************************************************************
@@ -9979,8 +19310,28 @@ public:
         m_typeHash = Details::GetSigHash(__FUNCSIG__);
     }
 
+    // GetStoredInstance():
+    //
+    // Returns the native instance data stored in an instance created by this (or another type equivalent) factory.
+    // Debug builds verify the type of the resolved storage.
+    //
+    // The host reads every key of an instance through a separate call, so consecutive lookups are usually for the
+    // same instance.  The instance most recently resolved and its storage are remembered, and a lookup for that
+    // instance does not go back to the data model.  The references held on both mean that the address cannot be
+    // reused by another instance while it is remembered.  The instance stays alive until another is resolved
+    // or the model is destroyed.
+    //
     InstanceType& GetStoredInstance(_In_ const ClientEx::Object& instanceObject)
     {
+        IModelObject *pInstanceObject = instanceObject.GetObject();
+        {
+            std::lock_guard<std::mutex> lock(m_lastInstanceLock);
+            if (pInstanceObject != nullptr && m_spLastInstance.Get() == pInstanceObject)
+            {
+                return m_pLastStorage->GetInstance();
+            }
+        }
+
         ComPtr<IUnknown> spStorage;
         ClientEx::CheckHr(instanceObject->GetContextForDataModel(GetObject(), &spStorage));
         if (spStorage == nullptr)
@@ -9988,7 +19339,28 @@ public:
             throw std::bad_alloc();
         }
 
-        return (static_cast<Details::StorageInterface<InstanceType> *>(spStorage.Get()))->GetInstance();
+#ifdef _DEBUG
+        ComPtr<Details::IPrivateTypeQuery> spTypeQuery;
+        if (FAILED(spStorage.As(&spTypeQuery)) || spTypeQuery->GetTypeHash() != m_typeHash)
+        {
+            throw std::invalid_argument("Object is not an instance of this typed model");
+        }
+#endif // _DEBUG
+
+        //
+        // The storage is kept alive by the instance object.  Whatever was remembered before is released outside the
+        // lock: releasing the last reference to an instance runs the destructor of its instance data.
+        //
+        auto pStorage = static_cast<Details::StorageInterface<InstanceType> *>(spStorage.Get());
+        ComPtr<IModelObject> spInstanceObject = pInstanceObject;
+        {
+            std::lock_guard<std::mutex> lock(m_lastInstanceLock);
+            m_spLastInstance.Swap(spInstanceObject);
+            m_spLastStorage.Swap(spStorage);
+            m_pLastStorage = pStorage;
+        }
+
+        return pStorage->GetInstance();
     }
 
 protected:
@@ -10001,6 +19373,12 @@ protected:
 private:
 
     ULONG64 m_typeHash;
+
+    // The instance most recently resolved by GetStoredInstance and its storage.
+    std::mutex m_lastInstanceLock;
+    ComPtr<IModelObject> m_spLastInstance;
+    ComPtr<IUnknown> m_spLastStorage;
+    Details::StorageInterface<InstanceType> *m_pLastStorage = nullptr;
 };
 
 template<typename TInstance>
@@ -10112,7 +19490,7 @@ public:
     //
     ClientEx::Object CreateInstance(_In_ const TInstance& instanceData)
     {
-        ComPtr<StorageType> spStorage = Make<StorageType>(instanceData, this->GetTypeHash());
+        ComPtr<StorageType> spStorage = ClientEx::Details::MakePooled<StorageType>(instanceData, this->GetTypeHash());
         if (spStorage == nullptr)
         {
             throw std::bad_alloc();
@@ -10122,7 +19500,7 @@ public:
 
     ClientEx::Object CreateInstance(_In_ TInstance&& instanceData)
     {
-        ComPtr<StorageType> spStorage = Make<StorageType>(std::move(instanceData), this->GetTypeHash());
+        ComPtr<StorageType> spStorage = ClientEx::Details::MakePooled<StorageType>(std::move(instanceData), this->GetTypeHash());
         if (spStorage == nullptr)
         {
             throw std::bad_alloc();
@@ -10133,7 +19511,7 @@ public:
     std::enable_if_t<std::is_same_v<StorageData, TInstance>, ClientEx::Object>
     CreateInstance(_In_ std::shared_ptr<TInstance> instanceData)
     {
-        auto spStorage = Make<Details::SharedStorage<TInstance>>(std::move(instanceData), this->GetTypeHash());
+        auto spStorage = ClientEx::Details::MakePooled<Details::SharedStorage<TInstance>>(std::move(instanceData), this->GetTypeHash());
         if (spStorage == nullptr)
         {
             throw std::bad_alloc();
@@ -10144,7 +19522,7 @@ public:
     std::enable_if_t<std::is_same_v<StorageData, TInstance>, ClientEx::Object>
     CreateInstance(_In_ std::unique_ptr<TInstance> instanceData)
     {
-        auto spStorage = Make<Details::UniqueStorage<TInstance>>(std::move(instanceData), this->GetTypeHash());
+        auto spStorage = ClientEx::Details::MakePooled<Details::UniqueStorage<TInstance>>(std::move(instanceData), this->GetTypeHash());
         if (spStorage == nullptr)
         {
             throw std::bad_alloc();
@@ -10206,7 +19584,7 @@ protected:
                 setFunction(instanceObject, this->GetStoredInstance(instanceObject), val);
             };
 
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc);
+            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
             ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
         }
     }
@@ -10235,7 +19613,7 @@ protected:
             (pDerived->*setClassMethod)(instanceObject, pDerived->GetStoredInstance(instanceObject), val);
         };
 
-        ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc);
+        ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
         ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
     }
 
@@ -10254,7 +19632,7 @@ protected:
                 return getFunction(instanceObject, this->GetStoredInstance(instanceObject));
             };
 
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc);
+            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
             ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
         }
     }
@@ -10274,7 +19652,7 @@ protected:
             return (pDerived->*getClassMethod)(instanceObject, pDerived->GetStoredInstance(instanceObject));
         };
 
-        ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc);
+        ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
         ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
     }
 
@@ -10287,6 +19665,63 @@ protected:
         AddReadOnlyProperty(propertyName, const_cast<TClass *>(pDerived), reinterpret_cast<TRet(TClass::*)(TObj, TData)>(getClassMethod), metadata);
     }
 
+    // AddCachedReadOnlyProperty():
+    //
+    // Adds a new read-only property whose boxed value is memoized in the given cache per instance object.  The stored
+    // instance is only fetched when the value is not cached.  See PropertyValueCache for when cached values are dropped.
+    //
+    template<typename TGetFunc>
+    void AddCachedReadOnlyProperty(_In_z_ const wchar_t *propertyName,
+                                   _In_ const TGetFunc& getFunction,    // TValue getFunction([const] Object [&], [const] TInstance [&]);
+                                   _In_ const std::shared_ptr<ClientEx::PropertyValueCache>& spCache,
+                                   _In_ const ClientEx::Metadata& metadata = ClientEx::Metadata())
+    {
+        static_assert(std::is_invocable_v<TGetFunc, ClientEx::Object, TInstance&>, "Bound property getter must take (const) Object (&) as first argument and the instance type as the second");
+        if constexpr (std::is_invocable_v<TGetFunc, ClientEx::Object, TInstance&>) // Prevent noise from failure of the assertion above
+        {
+            ULONG64 propertyId = spCache->CreatePropertyId();
+            ClientEx::Details::DataModelReference getLinkRef = this->GetLinkReference();
+            auto getFunc = [linkRef = std::move(getLinkRef), this, getFunction, spCache, propertyId](_In_ const ClientEx::Object& instanceObject)
+            {
+                ClientEx::Details::ThrowIfDetached(linkRef);
+                return spCache->GetValue(propertyId, instanceObject, [&]()
+                {
+                    return ClientEx::BoxObject(getFunction(instanceObject, this->GetStoredInstance(instanceObject)));
+                });
+            };
+
+            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
+            ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
+        }
+    }
+
+    template<typename TObj, typename TClass, typename TRet, typename TData>
+    void AddCachedReadOnlyProperty(_In_z_ const wchar_t *propertyName,
+                                   _In_ TClass *pDerived,
+                                   _In_ TRet (TClass::*getClassMethod)(_In_ TObj, _In_ TData),
+                                   _In_ const std::shared_ptr<ClientEx::PropertyValueCache>& spCache,
+                                   _In_ const ClientEx::Metadata& metadata = ClientEx::Metadata())
+    {
+        static_assert(Details::is_object_v<TObj>, "Bound property getter must take (const) Object (&) as first argument");
+
+        auto getFunction = [pDerived, getClassMethod](_In_ const ClientEx::Object& instanceObject, _In_ TInstance& instance)
+        {
+            return (pDerived->*getClassMethod)(instanceObject, instance);
+        };
+
+        AddCachedReadOnlyProperty(propertyName, getFunction, spCache, metadata);
+    }
+
+    template<typename TObj, typename TClass, typename TRet, typename TData>
+    void AddCachedReadOnlyProperty(_In_z_ const wchar_t *propertyName,
+                                   _In_ const TClass *pDerived,
+                                   _In_ TRet (TClass::*getClassMethod)(_In_ TObj, _In_ TData) const,
+                                   _In_ const std::shared_ptr<ClientEx::PropertyValueCache>& spCache,
+                                   _In_ const ClientEx::Metadata& metadata = ClientEx::Metadata())
+    {
+        AddCachedReadOnlyProperty(propertyName, const_cast<TClass *>(pDerived), reinterpret_cast<TRet(TClass::*)(TObj, TData)>(getClassMethod), spCache, metadata);
+    }
+
     // BindProperty():
     //
     // Binds a data model property to a field within the instance data.
@@ -10315,7 +19750,7 @@ protected:
                 data.*bindingPointer = val;
             };
 
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc);
+            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
             ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
         }
     }
@@ -10349,7 +19784,7 @@ protected:
                 (data.*setClassMethod)(val);
             };
 
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc);
+            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, setFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
             ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
         }
     }
@@ -10374,7 +19809,7 @@ protected:
                 return data.*bindingPointer;
             };
 
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc);
+            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
             ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
         }
     }
@@ -10399,7 +19834,7 @@ protected:
                 return (data.*classMethod)();
             };
 
-            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc);
+            ClientEx::Object propertyAccessor = ClientEx::Details::BoxProperty(getFunc, this->GetAccessorStats(propertyName, ClientEx::AccessorKind::Property));
             ClientEx::CheckHr(this->GetObject()->SetKey(propertyName, propertyAccessor, metadata));
         }
     }
@@ -10444,8 +19879,7 @@ protected:
                 );
         };
 
-        ClientEx::Object methodObject;
-        methodObject = callDest;
+        ClientEx::Object methodObject = ClientEx::Details::BoxMethod(callDest, this->GetAccessorStats(methodName, ClientEx::AccessorKind::Method));
         ClientEx::CheckHr(this->GetObject()->SetKey(methodName, methodObject, metadata));
     }
 
@@ -10480,8 +19914,7 @@ protected:
                 );
         };
 
-        ClientEx::Object methodObject;
-        methodObject = callDest;
+        ClientEx::Object methodObject = ClientEx::Details::BoxMethod(callDest, this->GetAccessorStats(methodName, ClientEx::AccessorKind::Method));
         ClientEx::CheckHr(this->GetObject()->SetKey(methodName, methodObject, metadata));
     }
 